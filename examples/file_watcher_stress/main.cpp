@@ -0,0 +1,99 @@
+// Stress check of the file watcher's reloads. More image files than the default thread pool has threads are modified
+//   at once, each reload decoding, compressing & mipmapping its image like TextureCache does; these operations being
+//   themselves parallelized on the same pool, reload tasks must not wait for subtasks queued behind them.
+// The check fails if all the reloads have not been applied within the time limit.
+
+#include "xen2.hpp"
+
+#include <filesystem>
+
+using namespace xen;
+
+namespace {
+
+constexpr uint32_t image_size = 128;
+constexpr std::chrono::seconds time_limit(30);
+
+void save_image(FilePath const& filepath, uint8_t seed)
+{
+    std::vector<uint8_t> values(image_size * image_size * 4);
+
+    for (size_t value_index = 0; value_index < values.size(); ++value_index) {
+        values[value_index] = static_cast<uint8_t>(value_index * seed + (value_index >> 9u));
+    }
+
+    ImageFormat::save(filepath, Image(Vector2ui(image_size), ImageColorspace::RGBA, std::move(values)));
+}
+
+} // namespace
+
+int main()
+{
+    try {
+        std::filesystem::path const directory = std::filesystem::temp_directory_path() / "xen_file_watcher_stress";
+        std::filesystem::create_directories(directory);
+
+        // Several times as many files as there are threads, so that every thread of the pool has a reload to run
+        uint32_t const file_count = get_system_thread_count() * 4 + 1;
+        std::vector<FilePath> filepaths;
+        filepaths.reserve(file_count);
+
+        for (uint32_t file_index = 0; file_index < file_count; ++file_index) {
+            filepaths.emplace_back((directory / ("image_" + std::to_string(file_index) + ".png")).string());
+            save_image(filepaths.back(), 1);
+        }
+
+        std::atomic<uint32_t> reloaded_count = 0;
+        uint32_t applied_count = 0;
+
+        for (FilePath const& filepath : filepaths) {
+            FileWatcher::watch(filepath, [filepath, &reloaded_count, &applied_count]() -> FileWatcher::ApplyFunc {
+                Image const image = ImageFormat::load(filepath);
+                CompressedImage const compressed_image = BcnEncoder::compress(image, BlockCompression::BC1);
+                std::vector<Image> const mipmaps = ImageProcessing::generate_mipmaps(image);
+
+                if (compressed_image.get_mipmaps().empty() || mipmaps.empty()) {
+                    return {};
+                }
+
+                ++reloaded_count;
+                return [&applied_count]() { ++applied_count; };
+            });
+        }
+
+        FileWatcher::enable();
+
+        // Letting the watcher register the files before modifying them
+        xen::sleep(500);
+
+        for (size_t file_index = 0; file_index < filepaths.size(); ++file_index) {
+            save_image(filepaths[file_index], static_cast<uint8_t>(file_index + 2));
+        }
+
+        auto const start_time = std::chrono::steady_clock::now();
+
+        while (applied_count < file_count && std::chrono::steady_clock::now() - start_time < time_limit) {
+            FileWatcher::apply_reloads();
+            xen::sleep(10);
+        }
+
+        FileWatcher::disable();
+        std::filesystem::remove_all(directory);
+
+        if (applied_count < file_count) {
+            Log::verror(
+                "[FileWatcherStress] Only {} reload(s) out of {} have been applied ({} finished)", applied_count,
+                file_count, reloaded_count.load()
+            );
+            return EXIT_FAILURE;
+        }
+
+        Log::vinfo("[FileWatcherStress] All {} reloads have been applied", file_count);
+    }
+    catch (std::exception const& exception) {
+        Log::verror("[FileWatcherStress] Exception occurred: {}", exception.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
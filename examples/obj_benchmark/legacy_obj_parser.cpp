@@ -0,0 +1,244 @@
+#include "legacy_obj_parser.hpp"
+
+#include <data/mesh.hpp>
+#include <utils/filepath.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace xen::LegacyObjParser {
+Mesh parse(FilePath const& filepath)
+{
+    ZoneScopedN("LegacyObjParser::parse");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[LegacyObjParser] Loading OBJ file ('" + filepath + "')...");
+
+    std::ifstream file(filepath, std::ios_base::binary);
+
+    if (!file) {
+        throw std::invalid_argument("Error: Couldn't open the OBJ file '" + filepath + '\'');
+    }
+
+    Mesh mesh;
+    mesh.add_submesh();
+
+    std::vector<Vector3f> positions;
+    std::vector<Vector2f> texcoords;
+    std::vector<Vector3f> normals;
+
+    std::vector<std::vector<int64_t>> pos_indices(1);
+    std::vector<std::vector<int64_t>> texcoords_indices(1);
+    std::vector<std::vector<int64_t>> normals_indices(1);
+
+    while (!file.eof()) {
+        std::string line;
+        file >> line;
+
+        if (line[0] == 'v') {
+            if (line[1] == 'n') { // Normal
+                Vector3f normal_triplet;
+
+                file >> normal_triplet.x >> normal_triplet.y >> normal_triplet.z;
+
+                normals.emplace_back(std::move(normal_triplet));
+            }
+            else if (line[1] == 't') { // Texcoords
+                Vector2f texcoords_triplet;
+
+                file >> texcoords_triplet.x >> texcoords_triplet.y;
+
+                texcoords.emplace_back(std::move(texcoords_triplet));
+            }
+            else { // Position
+                Vector3f position_triplet;
+
+                file >> position_triplet.x >> position_triplet.y >> position_triplet.z;
+
+                positions.emplace_back(std::move(position_triplet));
+            }
+        }
+        else if (line[0] == 'f') { // Faces
+            std::getline(file, line);
+
+            constexpr char delimiter = '/';
+            auto const nb_vertices = static_cast<uint16_t>(std::count(line.cbegin(), line.cend(), ' '));
+            auto const nb_parts =
+                static_cast<uint8_t>(std::count(line.cbegin(), line.cend(), delimiter) / nb_vertices + 1);
+            bool const quad_faces = (nb_vertices == 4);
+
+            std::stringstream indices_stream(line);
+            std::vector<int64_t> part_indices(nb_parts * nb_vertices);
+            std::string vertex;
+
+            for (size_t vert_index = 0; vert_index < nb_vertices; ++vert_index) {
+                indices_stream >> vertex;
+
+                std::stringstream vert_parts(vertex);
+                std::string part;
+                uint8_t part_index = 0;
+
+                while (std::getline(vert_parts, part, delimiter)) {
+                    if (!part.empty()) {
+                        part_indices[part_index * nb_parts + vert_index + (part_index * quad_faces)] = std::stol(part);
+                    }
+
+                    ++part_index;
+                }
+            }
+
+            if (quad_faces) {
+                pos_indices.back().emplace_back(part_indices[0]);
+                pos_indices.back().emplace_back(part_indices[2]);
+                pos_indices.back().emplace_back(part_indices[3]);
+
+                texcoords_indices.back().emplace_back(part_indices[4]);
+                texcoords_indices.back().emplace_back(part_indices[6]);
+                texcoords_indices.back().emplace_back(part_indices[7]);
+
+                normals_indices.back().emplace_back(part_indices[8]);
+                normals_indices.back().emplace_back(part_indices[10]);
+                normals_indices.back().emplace_back(part_indices[11]);
+            }
+
+            pos_indices.back().emplace_back(part_indices[0]);
+            pos_indices.back().emplace_back(part_indices[1]);
+            pos_indices.back().emplace_back(part_indices[2]);
+
+            texcoords_indices.back().emplace_back(part_indices[3 + quad_faces]);
+            texcoords_indices.back().emplace_back(part_indices[4 + quad_faces]);
+            texcoords_indices.back().emplace_back(part_indices[5 + quad_faces]);
+
+            auto const quad_stride = static_cast<uint8_t>(quad_faces * 2);
+
+            normals_indices.back().emplace_back(part_indices[6 + quad_stride]);
+            normals_indices.back().emplace_back(part_indices[7 + quad_stride]);
+            normals_indices.back().emplace_back(part_indices[8 + quad_stride]);
+        }
+        else if (line[0] == 'o' || line[0] == 'g') {
+            if (!pos_indices.front().empty()) {
+                size_t const new_size = pos_indices.size() + 1;
+                pos_indices.resize(new_size);
+                texcoords_indices.resize(new_size);
+                normals_indices.resize(new_size);
+
+                mesh.add_submesh();
+            }
+
+            std::getline(file, line);
+        }
+        else {
+            std::getline(file, line); // Skip the rest of the line
+        }
+    }
+
+    auto const pos_count = static_cast<int64_t>(positions.size());
+    auto const tex_count = static_cast<int64_t>(texcoords.size());
+    auto const norm_count = static_cast<int64_t>(normals.size());
+
+    std::map<std::array<size_t, 3>, uint32_t> indices_map;
+
+    for (size_t submesh_index = 0; submesh_index < mesh.get_submeshes().size(); ++submesh_index) {
+        Submesh& submesh = mesh.get_submeshes()[submesh_index];
+        indices_map.clear();
+
+        for (size_t part_index = 0; part_index < pos_indices[submesh_index].size(); ++part_index) {
+            // Face (vertices indices triplets), containing position/texcoords/normals
+            // vert_indices[i][j] -> vertex i, feature j (j = 0 -> position, j = 1 -> texcoords, j = 2 -> normal)
+            std::array<std::array<size_t, 3>, 3> vert_indices{};
+
+            // First vertex information
+            int64_t temp_index = pos_indices[submesh_index][part_index];
+            vert_indices[0][0] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + pos_count) : static_cast<size_t>(temp_index - 1));
+
+            temp_index = texcoords_indices[submesh_index][part_index];
+            vert_indices[0][1] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + tex_count) : static_cast<size_t>(temp_index - 1));
+
+            temp_index = normals_indices[submesh_index][part_index];
+            vert_indices[0][2] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + norm_count) : static_cast<size_t>(temp_index - 1));
+
+            ++part_index;
+
+            // Second vertex information
+            temp_index = pos_indices[submesh_index][part_index];
+            vert_indices[1][0] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + pos_count) : static_cast<size_t>(temp_index - 1));
+
+            temp_index = texcoords_indices[submesh_index][part_index];
+            vert_indices[1][1] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + tex_count) : static_cast<size_t>(temp_index - 1));
+
+            temp_index = normals_indices[submesh_index][part_index];
+            vert_indices[1][2] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + norm_count) : static_cast<size_t>(temp_index - 1));
+
+            ++part_index;
+
+            // Third vertex information
+            temp_index = pos_indices[submesh_index][part_index];
+            vert_indices[2][0] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + pos_count) : static_cast<size_t>(temp_index - 1));
+
+            temp_index = texcoords_indices[submesh_index][part_index];
+            vert_indices[2][1] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + tex_count) : static_cast<size_t>(temp_index - 1));
+
+            temp_index = normals_indices[submesh_index][part_index];
+            vert_indices[2][2] =
+                (temp_index < 0 ? static_cast<size_t>(temp_index + norm_count) : static_cast<size_t>(temp_index - 1));
+
+            std::array<Vector3f, 3> const face_positions = {
+                positions[vert_indices[0][0]], positions[vert_indices[1][0]], positions[vert_indices[2][0]]
+            };
+
+            std::array<Vector2f, 3> face_texcoords{};
+            if (!texcoords.empty()) {
+                face_texcoords[0] = texcoords[vert_indices[0][1]];
+                face_texcoords[1] = texcoords[vert_indices[1][1]];
+                face_texcoords[2] = texcoords[vert_indices[2][1]];
+            }
+
+            std::array<Vector3f, 3> face_normals{};
+            if (!normals.empty()) {
+                face_normals[0] = normals[vert_indices[0][2]];
+                face_normals[1] = normals[vert_indices[1][2]];
+                face_normals[2] = normals[vert_indices[2][2]];
+            }
+
+            for (uint8_t vert_part_index = 0; vert_part_index < 3; ++vert_part_index) {
+                auto const index_it = indices_map.find(vert_indices[vert_part_index]);
+
+                if (index_it != indices_map.cend()) {
+                    submesh.get_triangle_indices().emplace_back(index_it->second);
+                    continue;
+                }
+
+                Vertex vert{
+                    face_positions[vert_part_index], face_texcoords[vert_part_index], face_normals[vert_part_index]
+                };
+
+                submesh.get_triangle_indices().emplace_back(static_cast<uint32_t>(indices_map.size()));
+                indices_map.emplace(vert_indices[vert_part_index], static_cast<uint32_t>(indices_map.size()));
+                submesh.get_vertices().emplace_back(std::move(vert));
+            }
+        }
+
+        submesh.compute_bounding_box();
+    }
+
+    mesh.compute_tangents();
+
+    Log::vdebug(
+        "[LegacyObjParser] Loaded OBJ file ({} submesh(es), {} vertices, {} triangles)", mesh.get_submeshes().size(),
+        mesh.recover_vertex_count(), mesh.recover_triangle_count()
+    );
+
+    return mesh;
+}
+}
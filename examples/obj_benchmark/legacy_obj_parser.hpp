@@ -0,0 +1,16 @@
+#pragma once
+
+namespace xen {
+class FilePath;
+class Mesh;
+
+/// OBJ parser used before ObjFormat split files into chunks parsed in parallel, kept as a reference to benchmark
+///   against.
+/// \note Only the geometry is loaded; material libraries & usages are ignored.
+namespace LegacyObjParser {
+/// Parses a mesh from an OBJ file, reading it sequentially through a stream.
+/// \param filepath File from which to load the mesh.
+/// \return Loaded mesh, whose tangents have been computed.
+Mesh parse(FilePath const& filepath);
+}
+}
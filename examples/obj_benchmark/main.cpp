@@ -0,0 +1,165 @@
+// Benchmark of the OBJ parser. A grid mesh of the requested amount of triangles (10 million by default, or the amount
+//   given as first argument) is written to a temporary file, which is then parsed both by ObjFormat & by the sequential
+//   parser it replaced. Only the parsing is timed, the graphics resources not being created.
+
+#include "legacy_obj_parser.hpp"
+
+#include "xen2.hpp"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+
+using namespace xen;
+
+namespace {
+
+constexpr uint64_t default_triangle_count = 10'000'000;
+
+template <typename T>
+void append_value(std::string& buffer, T value)
+{
+    std::array<char, 32> chars{};
+    auto const result = std::to_chars(chars.data(), chars.data() + chars.size(), value);
+    buffer.append(chars.data(), result.ptr);
+}
+
+/// Writes a square grid of quads, each made of 2 triangles & all facing the same direction.
+/// \param filepath File to write the grid to.
+/// \param quad_count Amount of quads on each side of the grid.
+void write_grid(FilePath const& filepath, uint32_t quad_count)
+{
+    std::ofstream file(filepath, std::ios_base::binary);
+
+    if (!file) {
+        throw std::invalid_argument("[ObjBenchmark] Cannot write the file '" + filepath + '\'');
+    }
+
+    uint32_t const vertex_count = quad_count + 1;
+    auto const inv_quad_count = 1.f / static_cast<float>(quad_count);
+
+    // Lines are written by blocks, to avoid going through the stream for each value
+    std::string buffer;
+    constexpr size_t flush_size = 1u << 22u;
+
+    auto const flush_if_needed = [&buffer, &file](bool force = false) {
+        if (force || buffer.size() >= flush_size) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    };
+
+    for (uint32_t row = 0; row < vertex_count; ++row) {
+        for (uint32_t column = 0; column < vertex_count; ++column) {
+            float const u = static_cast<float>(column) * inv_quad_count;
+            float const v = static_cast<float>(row) * inv_quad_count;
+
+            buffer += "v ";
+            append_value(buffer, u * 100.f);
+            buffer += " 0 ";
+            append_value(buffer, v * 100.f);
+            buffer += "\nvt ";
+            append_value(buffer, u);
+            buffer += ' ';
+            append_value(buffer, v);
+            buffer += "\nvn 0 1 0\n";
+
+            flush_if_needed();
+        }
+    }
+
+    // OBJ indices start from 1; each vertex has the same position, texcoords & normal indices
+    auto const append_corner = [&buffer](uint64_t index) {
+        buffer += ' ';
+        append_value(buffer, index);
+        buffer += '/';
+        append_value(buffer, index);
+        buffer += '/';
+        append_value(buffer, index);
+    };
+
+    for (uint32_t row = 0; row < quad_count; ++row) {
+        for (uint32_t column = 0; column < quad_count; ++column) {
+            uint64_t const top_left = static_cast<uint64_t>(row) * vertex_count + column + 1;
+            uint64_t const bottom_left = top_left + vertex_count;
+
+            buffer += 'f';
+            append_corner(top_left);
+            append_corner(bottom_left);
+            append_corner(top_left + 1);
+            buffer += "\nf";
+            append_corner(top_left + 1);
+            append_corner(bottom_left);
+            append_corner(bottom_left + 1);
+            buffer += '\n';
+
+            flush_if_needed();
+        }
+    }
+
+    flush_if_needed(true);
+}
+
+template <typename FuncT>
+Mesh time_parsing(std::string_view parser_name, uint64_t file_size, FuncT&& parse)
+{
+    auto const start_time = std::chrono::steady_clock::now();
+    Mesh mesh = parse();
+    std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start_time;
+
+    Log::vinfo(
+        "[ObjBenchmark] {}: {:.3f} s ({:.1f} MB/s; {} vertices, {} triangles)", parser_name, duration.count(),
+        static_cast<double>(file_size) / (1024.0 * 1024.0) / duration.count(), mesh.recover_vertex_count(),
+        mesh.recover_triangle_count()
+    );
+
+    return mesh;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    try {
+        uint64_t const triangle_count = (argc > 1 ? std::stoull(argv[1]) : default_triangle_count);
+        auto const quad_count =
+            static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(triangle_count) / 2.0)));
+
+        std::filesystem::path const directory = std::filesystem::temp_directory_path() / "xen_obj_benchmark";
+        std::filesystem::create_directories(directory);
+        FilePath const filepath = (directory / "grid.obj").string();
+
+        Log::vinfo(
+            "[ObjBenchmark] Writing a grid of {} triangles to '{}'...", 2ull * quad_count * quad_count,
+            filepath.to_utf8()
+        );
+        write_grid(filepath, quad_count);
+
+        uint64_t const file_size = std::filesystem::file_size(directory / "grid.obj");
+
+        // Both parsers must do the same work, the legacy one never optimizing the meshes
+        MeshOptimizer::disable_on_import();
+
+        // Only the mesh is kept, its renderer needing a graphics context to be loaded
+        Mesh const mesh = time_parsing("ObjFormat", file_size, [&filepath]() {
+            return ObjFormat::parse(filepath).first;
+        });
+        Mesh const legacy_mesh = time_parsing("Legacy parser", file_size, [&filepath]() {
+            return LegacyObjParser::parse(filepath);
+        });
+
+        std::filesystem::remove_all(directory);
+
+        if (mesh.recover_vertex_count() != legacy_mesh.recover_vertex_count() ||
+            mesh.recover_triangle_count() != legacy_mesh.recover_triangle_count()) {
+            Log::error("[ObjBenchmark] The parsers' results differ");
+            return EXIT_FAILURE;
+        }
+    }
+    catch (std::exception const& exception) {
+        Log::verror("[ObjBenchmark] Exception occurred: {}", exception.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
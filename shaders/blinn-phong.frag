@@ -1,12 +1,6 @@
-#define MAX_LIGHT_COUNT 100
-
-struct Light {
-  vec4 position;
-  vec4 direction;
-  vec4 color;
-  float energy;
-  float angle;
-};
+#include "lod_fade.glsl"
+#include "motion.glsl"
+#include "shadows.glsl"
 
 struct Material {
   vec3 baseColor;
@@ -29,33 +23,25 @@ in struct MeshInfo {
   mat3 vertTBNMatrix;
 } vertMeshInfo;
 
-layout(std140) uniform uboCameraInfo {
-  mat4 uniViewMat;
-  mat4 uniInvViewMat;
-  mat4 uniProjectionMat;
-  mat4 uniInvProjectionMat;
-  mat4 uniViewProjectionMat;
-  vec3 uniCameraPos;
-};
-
-layout(std140) uniform uboLightsInfo {
-  Light uniLights[MAX_LIGHT_COUNT];
-  uint uniLightCount;
-};
-
 uniform Material uniMaterial;
 
 layout(location = 0) out vec4 fragColor;
 layout(location = 1) out vec3 fragNormal;
 layout(location = 2) out vec4 fragSpecular;
+layout(location = 3) out vec4 fragMotion;
 
 void main() {
+  if (isLodFadedOut())
+    discard;
+
   vec4 baseColor = texture(uniMaterial.baseColorMap, vertMeshInfo.vertTexcoords).rgba;
   float opacity  = texture(uniMaterial.opacityMap, vertMeshInfo.vertTexcoords).r;
   float alpha    = min(baseColor.a, opacity) * uniMaterial.opacity;
 
+#if defined(XEN_ALPHA_TEST)
   if (alpha < 0.1)
-      discard;
+    discard;
+#endif
 
   vec3 color      = baseColor.rgb * uniMaterial.baseColor;
   vec3 specFactor = texture(uniMaterial.specularMap, vertMeshInfo.vertTexcoords).rgb * uniMaterial.specular;
@@ -65,6 +51,8 @@ void main() {
   vec3 diffuse  = vec3(0.0);
   vec3 specular = vec3(0.0);
 
+  vec3 geometricNormal = normalize(vertMeshInfo.vertTBNMatrix[2]);
+
   for (uint lightIndex = 0u; lightIndex < uniLightCount; ++lightIndex) {
     vec3 fullLightDir;
     float attenuation = uniLights[lightIndex].energy;
@@ -80,6 +68,7 @@ void main() {
 
     vec3 lightDir = normalize(fullLightDir);
     vec3 radiance = uniLights[lightIndex].color.rgb * attenuation;
+    radiance     *= computeShadowVisibility(lightIndex, vertMeshInfo.vertPosition, geometricNormal);
 
     // Diffuse
     float lightAngle = max(dot(lightDir, normal), 0.0);
@@ -101,4 +90,6 @@ void main() {
   fragColor    = vec4(finalColor, alpha);
   fragNormal   = normal * 0.5 + 0.5;
   fragSpecular = vec4(specFactor, 1.0 - max(specFactor.x, max(specFactor.y, specFactor.z)));
+
+  fragMotion   = computeMotion();
 }
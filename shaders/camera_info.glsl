@@ -0,0 +1,12 @@
+// Camera's data, shared by every shader reading uboCameraInfo
+
+layout(std140) uniform uboCameraInfo {
+  mat4 uniViewMat;
+  mat4 uniInvViewMat;
+  mat4 uniProjectionMat;
+  mat4 uniInvProjectionMat;
+  mat4 uniViewProjectionMat;
+  vec3 uniCameraPos;
+  mat4 uniPrevViewProjectionMat;
+  vec4 uniJitter; // Current jitter in XY, previous one in ZW
+};
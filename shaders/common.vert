@@ -2,19 +2,18 @@ layout(location = 0) in vec3 vertPosition;
 layout(location = 1) in vec2 vertTexcoords;
 layout(location = 2) in vec3 vertNormal;
 layout(location = 3) in vec3 vertTangent;
+layout(location = 4) in mat4 vertModelMat; // Only used when drawing from the geometry pool
 
-layout(std140) uniform uboCameraInfo {
-  mat4 uniViewMat;
-  mat4 uniInvViewMat;
-  mat4 uniProjectionMat;
-  mat4 uniInvProjectionMat;
-  mat4 uniViewProjectionMat;
-  vec3 uniCameraPos;
-};
+#if defined(XEN_MATERIAL_TABLE)
+layout(location = 8) in uint vertMaterialIndex; // Only used when drawing from the geometry pool
 
-layout(std140) uniform uboModelInfo {
-  mat4 uniModelMat;
-};
+uniform uint uniMaterialIndex;
+
+flat out uint vertMaterialTableIndex;
+#endif
+
+#include "camera_info.glsl"
+#include "model_info.glsl"
 
 out struct MeshInfo {
   vec3 vertPosition;
@@ -22,16 +21,56 @@ out struct MeshInfo {
   mat3 vertTBNMatrix;
 } vertMeshInfo;
 
+// Clip-space positions in the current & previous frames, from which the fragments' motion is computed
+out vec4 vertCurrClipPos;
+out vec4 vertPrevClipPos;
+
+// Quantized normals & tangents are octahedral-encoded, their Z component being 0
+vec3 decodeOctahedral(vec2 encoded) {
+  vec3 direction   = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+  float foldOffset = max(-direction.z, 0.0);
+  direction.xy    += vec2(direction.x >= 0.0 ? -foldOffset : foldOffset, direction.y >= 0.0 ? -foldOffset : foldOffset);
+
+  return normalize(direction);
+}
+
 void main() {
-  vertMeshInfo.vertPosition  = (uniModelMat * vec4(vertPosition, 1.0)).xyz;
+#if defined(XEN_INSTANCING)
+  mat4 modelMat = vertModelMat;
+#else
+  mat4 modelMat = (uniInstancedTransforms ? vertModelMat : uniModelMat);
+#endif
+
+  vertMeshInfo.vertPosition  = (modelMat * vec4(vertPosition, 1.0)).xyz;
   vertMeshInfo.vertTexcoords = vertTexcoords;
 
-  mat3 modelMat = mat3(uniModelMat);
+  mat3 normalMat = mat3(modelMat);
+
+  vec3 vertexTangent = (uniQuantizedVertices ? decodeOctahedral(vertTangent.xy) : vertTangent);
+  vec3 vertexNormal  = (uniQuantizedVertices ? decodeOctahedral(vertNormal.xy) : vertNormal);
 
-  vec3 tangent   = normalize(modelMat * vertTangent);
-  vec3 normal    = normalize(modelMat * vertNormal);
+  vec3 tangent   = normalize(normalMat * vertexTangent);
+  vec3 normal    = normalize(normalMat * vertexNormal);
   vec3 bitangent = cross(normal, tangent);
   vertMeshInfo.vertTBNMatrix = mat3(tangent, bitangent, normal);
 
-  gl_Position = uniViewProjectionMat * (uniModelMat * vec4(vertPosition, 1.0));
+  gl_Position = uniViewProjectionMat * (modelMat * vec4(vertPosition, 1.0));
+
+  // Pooled meshes have no previous transform; only the camera's motion is accounted for
+#if defined(XEN_INSTANCING)
+  mat4 prevModelMat = vertModelMat;
+#else
+  mat4 prevModelMat = (uniInstancedTransforms ? vertModelMat : uniPrevModelMat);
+#endif
+  vertCurrClipPos   = gl_Position;
+  vertPrevClipPos   = uniPrevViewProjectionMat * (prevModelMat * vec4(vertPosition, 1.0));
+
+#if defined(XEN_MATERIAL_TABLE)
+  // Pooled draws may batch several materials, each draw command giving its own material's index
+#if defined(XEN_INSTANCING)
+  vertMaterialTableIndex = vertMaterialIndex;
+#else
+  vertMaterialTableIndex = (uniInstancedTransforms ? vertMaterialIndex : uniMaterialIndex);
+#endif
+#endif
 }
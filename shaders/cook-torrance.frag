@@ -1,13 +1,12 @@
-#define MAX_LIGHT_COUNT 100
-#define PI 3.1415926535897932384626433832795
+#if defined(XEN_MATERIAL_TABLE)
+#extension GL_ARB_bindless_texture : require
+#endif
 
-struct Light {
-  vec4 position;
-  vec4 direction;
-  vec4 color;
-  float energy;
-  float angle;
-};
+#include "lod_fade.glsl"
+#include "motion.glsl"
+#include "shadows.glsl"
+
+#define PI 3.1415926535897932384626433832795
 
 struct Material {
   vec3 baseColor;
@@ -29,25 +28,48 @@ in struct MeshInfo {
   mat3 vertTBNMatrix;
 } vertMeshInfo;
 
-layout(std140) uniform uboCameraInfo {
-  mat4 uniViewMat;
-  mat4 uniInvViewMat;
-  mat4 uniProjectionMat;
-  mat4 uniInvProjectionMat;
-  mat4 uniViewProjectionMat;
-  vec3 uniCameraPos;
+#if defined(XEN_MATERIAL_TABLE)
+// Parameters of all the materials in the material table, the textures being given as bindless handles
+struct MaterialData {
+  vec4 baseColor; // RGB: base color factor
+  vec4 emissive;  // RGB: emissive factor
+  vec4 factors;   // X: metallic factor, Y: roughness factor
+
+  uvec2 baseColorMap;
+  uvec2 emissiveMap;
+  uvec2 normalMap;
+  uvec2 metallicMap;
+  uvec2 roughnessMap;
+  uvec2 ambientMap;
 };
 
-layout(std140) uniform uboLightsInfo {
-  Light uniLights[MAX_LIGHT_COUNT];
-  uint uniLightCount;
+layout(std430, binding = 0) readonly buffer ssboMaterials {
+  MaterialData materials[];
 };
 
+flat in uint vertMaterialTableIndex;
+
+// The index is the same for all the fragments of a draw, keeping the handles dynamically uniform within it
+#define MATERIAL_FACTOR(FACTOR) materials[vertMaterialTableIndex].FACTOR
+#define MATERIAL_MAP(MAP) sampler2D(materials[vertMaterialTableIndex].MAP)
+#define MATERIAL_BASE_COLOR MATERIAL_FACTOR(baseColor).rgb
+#define MATERIAL_EMISSIVE MATERIAL_FACTOR(emissive).rgb
+#define MATERIAL_METALLIC MATERIAL_FACTOR(factors).x
+#define MATERIAL_ROUGHNESS MATERIAL_FACTOR(factors).y
+#else
 uniform Material uniMaterial;
 
+#define MATERIAL_MAP(MAP) uniMaterial.MAP
+#define MATERIAL_BASE_COLOR uniMaterial.baseColor
+#define MATERIAL_EMISSIVE uniMaterial.emissive
+#define MATERIAL_METALLIC uniMaterial.metallicFactor
+#define MATERIAL_ROUGHNESS uniMaterial.roughnessFactor
+#endif
+
 layout(location = 0) out vec4 fragColor;
 layout(location = 1) out vec3 fragNormal;
 layout(location = 2) out vec4 fragSpecular;
+layout(location = 3) out vec4 fragMotion;
 
 // Normal Distribution Function: Trowbridge-Reitz GGX
 float computeNormalDistrib(vec3 normal, vec3 halfVec, float roughness) {
@@ -91,19 +113,28 @@ float computeGeometry(vec3 normal, vec3 viewDir, vec3 lightDir, float roughness)
 }
 
 void main() {
-  vec4 baseColor = texture(uniMaterial.baseColorMap, vertMeshInfo.vertTexcoords).rgba;
+  if (isLodFadedOut())
+    discard;
+
+  vec4 baseColor = texture(MATERIAL_MAP(baseColorMap), vertMeshInfo.vertTexcoords).rgba;
 
+#if defined(XEN_ALPHA_TEST)
   if (baseColor.a < 0.1)
     discard;
+#endif
 
-  vec3 albedo     = baseColor.rgb * uniMaterial.baseColor;
-  float metallic  = texture(uniMaterial.metallicMap, vertMeshInfo.vertTexcoords).r * uniMaterial.metallicFactor;
-  float roughness = texture(uniMaterial.roughnessMap, vertMeshInfo.vertTexcoords).r * uniMaterial.roughnessFactor;
-  float ambOcc    = texture(uniMaterial.ambientMap, vertMeshInfo.vertTexcoords).r;
+  vec3 albedo     = baseColor.rgb * MATERIAL_BASE_COLOR;
+  float metallic  = texture(MATERIAL_MAP(metallicMap), vertMeshInfo.vertTexcoords).r * MATERIAL_METALLIC;
+  float roughness = texture(MATERIAL_MAP(roughnessMap), vertMeshInfo.vertTexcoords).r * MATERIAL_ROUGHNESS;
+  float ambOcc    = texture(MATERIAL_MAP(ambientMap), vertMeshInfo.vertTexcoords).r;
 
-  vec3 normal = texture(uniMaterial.normalMap, vertMeshInfo.vertTexcoords).rgb;
+#if defined(XEN_NORMAL_MAP)
+  vec3 normal = texture(MATERIAL_MAP(normalMap), vertMeshInfo.vertTexcoords).rgb;
   normal      = normalize(normal * 2.0 - 1.0);
   normal      = normalize(vertMeshInfo.vertTBNMatrix * normal);
+#else
+  vec3 normal = normalize(vertMeshInfo.vertTBNMatrix[2]);
+#endif
 
   vec3 viewDir = normalize(uniCameraPos - vertMeshInfo.vertPosition);
 
@@ -114,6 +145,8 @@ void main() {
 
   vec3 lightRadiance = vec3(0.0);
 
+  vec3 geometricNormal = normalize(vertMeshInfo.vertTBNMatrix[2]);
+
   for (uint lightIndex = 0u; lightIndex < uniLightCount; ++lightIndex) {
     vec3 fullLightDir;
     float attenuation = uniLights[lightIndex].energy;
@@ -130,6 +163,7 @@ void main() {
     vec3 lightDir = normalize(fullLightDir);
     vec3 halfDir  = normalize(viewDir + lightDir);
     vec3 radiance = uniLights[lightIndex].color.rgb * attenuation;
+    radiance     *= computeShadowVisibility(lightIndex, vertMeshInfo.vertPosition, geometricNormal);
 
     // Normal distribution (D)
     float normalDistrib = computeNormalDistrib(normal, halfDir, roughness);
@@ -152,7 +186,7 @@ void main() {
   }
 
   vec3 ambient    = vec3(0.02) * albedo * ambOcc;
-  vec3 emissive   = texture(uniMaterial.emissiveMap, vertMeshInfo.vertTexcoords).rgb * uniMaterial.emissive;
+  vec3 emissive   = texture(MATERIAL_MAP(emissiveMap), vertMeshInfo.vertTexcoords).rgb * MATERIAL_EMISSIVE;
   vec3 finalColor = ambient + lightRadiance + emissive;
 
   // Reinhard tone mapping; this is temporary and will be removed later
@@ -163,4 +197,6 @@ void main() {
   fragColor    = vec4(finalColor, baseColor.a);
   fragNormal   = normal * 0.5 + 0.5;
   fragSpecular = vec4(baseReflectivity, roughness);
+
+  fragMotion   = computeMotion();
 }
@@ -1,12 +1,5 @@
-#define MAX_LIGHT_COUNT 100
-
-struct Light {
-  vec4 position;
-  vec4 direction;
-  vec4 color;
-  float energy;
-  float angle;
-};
+#include "camera_info.glsl"
+#include "lights_info.glsl"
 
 struct Material {
   vec3 baseColor;
@@ -29,20 +22,6 @@ in struct MeshInfo {
   mat3 vertTBNMatrix;
 } vertMeshInfo;
 
-layout(std140) uniform uboCameraInfo {
-  mat4 uniViewMat;
-  mat4 uniInvViewMat;
-  mat4 uniProjectionMat;
-  mat4 uniInvProjectionMat;
-  mat4 uniViewProjectionMat;
-  vec3 uniCameraPos;
-};
-
-layout(std140) uniform uboLightsInfo {
-  Light uniLights[MAX_LIGHT_COUNT];
-  uint uniLightCount;
-};
-
 uniform Material uniMaterial;
 
 layout(location = 0) out vec4 fragColor;
@@ -53,8 +32,10 @@ void main() {
   float opacity  = texture(uniMaterial.opacityMap, vertMeshInfo.vertTexcoords).r;
   float alpha    = min(baseColor.a, opacity) * uniMaterial.opacity;
 
+#if defined(XEN_ALPHA_TEST)
   if (alpha < 0.1)
     discard;
+#endif
 
   vec3 normal = vertMeshInfo.vertTBNMatrix[2];
 
@@ -0,0 +1,16 @@
+// Lights of the scene, shared by the materials' shaders
+
+#define MAX_LIGHT_COUNT 100
+
+struct Light {
+  vec4 position;
+  vec4 direction;
+  vec4 color;
+  float energy;
+  float angle;
+};
+
+layout(std140) uniform uboLightsInfo {
+  Light uniLights[MAX_LIGHT_COUNT];
+  uint uniLightCount;
+};
@@ -0,0 +1,14 @@
+// Dithered cross-fade between levels of detail, for fragment shaders
+
+#include "model_info.glsl"
+
+// Cross-fades levels of detail with complementary dithering patterns: a positive fade keeps the fragments below its
+// threshold, a negative one those above its opposite
+bool isLodFadedOut() {
+  const float bayerMatrix[16] = float[](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+
+  ivec2 ditherCoords = ivec2(gl_FragCoord.xy) % 4;
+  float threshold    = (bayerMatrix[ditherCoords.y * 4 + ditherCoords.x] + 0.5) / 16.0;
+
+  return (uniLodFade >= 0.0 ? threshold >= uniLodFade : threshold < -uniLodFade);
+}
@@ -0,0 +1,9 @@
+// Data of the mesh being drawn, shared by the materials' shaders
+
+layout(std140) uniform uboModelInfo {
+  mat4 uniModelMat;
+  float uniLodFade;
+  bool uniQuantizedVertices;
+  bool uniInstancedTransforms;
+  mat4 uniPrevModelMat;
+};
@@ -0,0 +1,15 @@
+// Screen-space motion of the fragments, written by the materials for the temporal reconstruction
+
+#include "camera_info.glsl"
+
+// Clip-space positions in the current & previous frames, output by common.vert
+in vec4 vertCurrClipPos;
+in vec4 vertPrevClipPos;
+
+// Computes the screen-space motion since the previous frame, the jitter excluded; the last component flags it as written
+vec4 computeMotion() {
+  vec2 currNdc = vertCurrClipPos.xy / vertCurrClipPos.w - uniJitter.xy;
+  vec2 prevNdc = vertPrevClipPos.xy / vertPrevClipPos.w - uniJitter.zw;
+
+  return vec4((currNdc - prevNdc) * 0.5, 0.0, 1.0);
+}
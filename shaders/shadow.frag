@@ -0,0 +1,3 @@
+// Depth-only fragment shader; the shadow maps only need the depth, written by the rasterizer
+
+void main() {}
@@ -0,0 +1,10 @@
+// Depth-only vertex shader, projecting the shadow casters from a light's point of view
+
+layout(location = 0) in vec3 vertPosition;
+
+uniform mat4 uniLightViewProjMat;
+uniform mat4 uniModelMat;
+
+void main() {
+  gl_Position = uniLightViewProjMat * (uniModelMat * vec4(vertPosition, 1.0));
+}
@@ -0,0 +1,95 @@
+// Shadows cast by the lights, sampled from the shadow renderer's atlases with percentage-closer filtering
+
+#include "camera_info.glsl"
+#include "lights_info.glsl"
+
+#define MAX_CASCADE_COUNT 4
+#define MAX_LOCAL_SHADOW_TILE_COUNT 48
+
+layout(std140) uniform uboShadowInfo {
+  mat4 uniCascadeMats[MAX_CASCADE_COUNT];
+  mat4 uniLocalShadowMats[MAX_LOCAL_SHADOW_TILE_COUNT];
+  vec4 uniCascadeSplits;                     // View-space depth at which each cascade ends
+  vec4 uniCascadeTexelSizes;                 // World-space size of a texel in each cascade
+  vec4 uniShadowParams;                      // Normal bias in texels, cascade tile UV size, local tile UV size
+  vec4 uniLightShadowInfos[MAX_LIGHT_COUNT]; // First local tile (-1 if none), texel size at a unit distance, is point
+  int uniCascadeLightIndex;
+  uint uniCascadeCount;
+};
+
+uniform sampler2D uniCascadeShadowMap;
+uniform sampler2D uniLocalShadowMap;
+
+// Compares a position with a tile of a shadow atlas, using a 3x3 percentage-closer filter kept within the tile; returns
+//   the fraction of the samples which are lit
+float computeShadowMapVisibility(sampler2D shadowMap, mat4 shadowMat, vec3 position, int tileIndex, float tileUvSize) {
+  vec4 projPos = shadowMat * vec4(position, 1.0);
+
+  if (projPos.w <= 0.0)
+    return 1.0;
+
+  vec3 shadowCoords = projPos.xyz / projPos.w;
+  vec2 tileUv       = shadowCoords.xy * 0.5 + 0.5;
+
+  if (any(lessThan(tileUv, vec2(0.0))) || any(greaterThan(tileUv, vec2(1.0))) || shadowCoords.z > 1.0)
+    return 1.0;
+
+  int tilesPerRow = int(1.0 / tileUvSize + 0.001); // Tiles never overlap the atlas edge, hence the truncation
+  vec2 tileOrigin = vec2(tileIndex % tilesPerRow, tileIndex / tilesPerRow) * tileUvSize;
+  vec2 texelSize  = 1.0 / vec2(textureSize(shadowMap, 0));
+  vec2 minUv      = tileOrigin + texelSize * 0.5;
+  vec2 maxUv      = tileOrigin + tileUvSize - texelSize * 0.5;
+  vec2 atlasUv    = tileOrigin + tileUv * tileUvSize;
+
+  float visibility = 0.0;
+
+  for (int i = -1; i <= 1; ++i) {
+    for (int j = -1; j <= 1; ++j) {
+      float depth = texture(shadowMap, clamp(atlasUv + vec2(i, j) * texelSize, minUv, maxUv)).r;
+      visibility += (shadowCoords.z <= depth ? 1.0 : 0.0);
+    }
+  }
+
+  return visibility / 9.0;
+}
+
+// Computes how much of a light reaches the given position; the position is offset along the geometric normal by the
+//   footprint of a shadow map texel, to avoid self-shadowing
+float computeShadowVisibility(uint lightIndex, vec3 position, vec3 geometricNormal) {
+  if (int(lightIndex) == uniCascadeLightIndex) {
+    float viewDepth = -(uniViewMat * vec4(position, 1.0)).z;
+
+    for (uint cascadeIndex = 0u; cascadeIndex < uniCascadeCount; ++cascadeIndex) {
+      if (viewDepth > uniCascadeSplits[cascadeIndex])
+        continue;
+
+      vec3 offsetPos = position + geometricNormal * (uniCascadeTexelSizes[cascadeIndex] * uniShadowParams.x);
+      return computeShadowMapVisibility(uniCascadeShadowMap, uniCascadeMats[cascadeIndex], offsetPos, int(cascadeIndex), uniShadowParams.y);
+    }
+
+    return 1.0;
+  }
+
+  vec4 shadowInfo = uniLightShadowInfos[lightIndex];
+
+  if (shadowInfo.x < 0.0)
+    return 1.0;
+
+  vec3 lightToPos = position - uniLights[lightIndex].position.xyz;
+  int tileIndex   = int(shadowInfo.x);
+
+  // Point lights have a tile per cube face, ordered as +X, -X, +Y, -Y, +Z & -Z
+  if (shadowInfo.z != 0.0) {
+    vec3 absDir = abs(lightToPos);
+
+    if (absDir.x >= absDir.y && absDir.x >= absDir.z)
+      tileIndex += (lightToPos.x >= 0.0 ? 0 : 1);
+    else if (absDir.y >= absDir.z)
+      tileIndex += (lightToPos.y >= 0.0 ? 2 : 3);
+    else
+      tileIndex += (lightToPos.z >= 0.0 ? 4 : 5);
+  }
+
+  vec3 offsetPos = position + geometricNormal * (shadowInfo.y * length(lightToPos) * uniShadowParams.x);
+  return computeShadowMapVisibility(uniLocalShadowMap, uniLocalShadowMats[tileIndex], offsetPos, tileIndex, uniShadowParams.z);
+}
@@ -6,14 +6,7 @@ struct Buffers {
 
 in vec2 fragTexcoords;
 
-layout(std140) uniform uboCameraInfo {
-  mat4 uniViewMat;
-  mat4 uniInvViewMat;
-  mat4 uniProjectionMat;
-  mat4 uniInvProjectionMat;
-  mat4 uniViewProjectionMat;
-  vec3 uniCameraPos;
-};
+#include "camera_info.glsl"
 
 uniform Buffers uniSceneBuffers;
 
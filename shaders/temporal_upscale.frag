@@ -0,0 +1,84 @@
+// Temporal reconstruction: the current frame, rendered at a lower resolution with a jittered projection, is upscaled by
+//   accumulating it with the previous frames' reprojected result, clamped to the current neighborhood to reject history
+//   which is not valid anymore
+
+in vec2 fragTexcoords;
+
+#include "camera_info.glsl"
+
+uniform sampler2D uniColorBuffer;
+uniform sampler2D uniDepthBuffer;
+uniform sampler2D uniMotionBuffer;
+uniform sampler2D uniHistoryBuffer;
+uniform vec2 uniRenderScale; // Part of the buffers covered by the current frame
+uniform float uniHistoryWeight;
+uniform bool uniZeroToOneDepth;
+
+layout(location = 0) out vec4 fragColor;
+
+vec3 convertRgbToYCoCg(vec3 color) {
+  return vec3(0.25 * color.r + 0.5 * color.g + 0.25 * color.b, 0.5 * color.r - 0.5 * color.b, -0.25 * color.r + 0.5 * color.g - 0.25 * color.b);
+}
+
+vec3 convertYCoCgToRgb(vec3 color) {
+  return vec3(color.x + color.y - color.z, color.x + color.z, color.x - color.y - color.z);
+}
+
+// Recovers the motion of a pixel; surfaces which did not write theirs are considered static, only moving with the camera
+vec2 recoverMotion(ivec2 coords, float depth) {
+  vec4 motion = texelFetch(uniMotionBuffer, coords, 0);
+
+  if (motion.a > 0.5)
+    return motion.xy;
+
+  vec2 currNdc = fragTexcoords * 2.0 - 1.0;
+  vec4 viewPos = uniInvProjectionMat * vec4(currNdc + uniJitter.xy, (uniZeroToOneDepth ? depth : depth * 2.0 - 1.0), 1.0);
+  vec4 prevPos = uniPrevViewProjectionMat * (uniInvViewMat * vec4(viewPos.xyz / viewPos.w, 1.0));
+
+  return (currNdc - (prevPos.xy / prevPos.w - uniJitter.zw)) * 0.5;
+}
+
+void main() {
+  vec2 bufferSize  = vec2(textureSize(uniColorBuffer, 0));
+  ivec2 renderSize = ivec2(bufferSize * uniRenderScale + 0.5);
+
+  // The rendered image being shifted by the jitter, the point actually displayed by this pixel is found by offsetting it
+  vec2 renderCoords  = clamp((fragTexcoords + uniJitter.xy * 0.5) * vec2(renderSize), vec2(0.5), vec2(renderSize) - 0.5);
+  ivec2 centerCoords = ivec2(renderCoords);
+  vec4 currColor     = texture(uniColorBuffer, renderCoords / bufferSize);
+
+  // Color bounds of the neighborhood, & closest depth so that edges are reprojected with the foreground's motion
+  vec3 minColor       = vec3(1e10);
+  vec3 maxColor       = vec3(-1e10);
+  float closestDepth  = 1.0;
+  ivec2 closestCoords = centerCoords;
+
+  for (int i = -1; i <= 1; ++i) {
+    for (int j = -1; j <= 1; ++j) {
+      ivec2 coords = clamp(centerCoords + ivec2(i, j), ivec2(0), renderSize - 1);
+
+      vec3 color = convertRgbToYCoCg(texelFetch(uniColorBuffer, coords, 0).rgb);
+      minColor   = min(minColor, color);
+      maxColor   = max(maxColor, color);
+
+      float depth = texelFetch(uniDepthBuffer, coords, 0).r;
+
+      if (depth < closestDepth) {
+        closestDepth  = depth;
+        closestCoords = coords;
+      }
+    }
+  }
+
+  vec2 historyUv = fragTexcoords - recoverMotion(closestCoords, closestDepth);
+
+  if (uniHistoryWeight <= 0.0 || any(lessThan(historyUv, vec2(0.0))) || any(greaterThan(historyUv, vec2(1.0)))) {
+    fragColor = currColor;
+    return;
+  }
+
+  vec3 historyColor = clamp(convertRgbToYCoCg(texture(uniHistoryBuffer, historyUv).rgb), minColor, maxColor);
+  vec3 resultColor  = mix(convertRgbToYCoCg(currColor.rgb), historyColor, uniHistoryWeight);
+
+  fragColor = vec4(convertYCoCgToRgb(resultColor), currColor.a);
+}
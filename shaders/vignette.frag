@@ -1,22 +1,19 @@
-in vec2 fragTexcoords;
+// Pointwise effect, wrapped into a full fragment shader by RenderPass::generate_pointwise_source()
 
-uniform sampler2D uniBuffer;
-uniform float uniFrameRatio;
-uniform float uniStrength;
-uniform float uniOpacity;
-uniform vec3 uniColor;
+uniform float uniVignetteFrameRatio;
+uniform float uniVignetteStrength;
+uniform float uniVignetteOpacity;
+uniform vec3 uniVignetteColor;
 
-layout(location = 0) out vec4 fragColor;
-
-void main() {
+vec3 applyVignette(vec3 color, vec2 texcoords) {
   // Natural vignetting/illumination falloff, using the cosine fourth law. See:
   // - https://www.shadertoy.com/view/4lSXDm
   // - https://github.com/keijiro/KinoVignette/blob/master/Assets/Kino/Vignette/Shader/Vignette.shader
   // - https://en.wikipedia.org/wiki/Vignetting#Natural_vignetting
   // - https://www.cs.cmu.edu/~sensing-sensors/readings/vignetting.pdf#page=3
 
-  vec2 uv     = (fragTexcoords - 0.5) * vec2(uniFrameRatio, 1.0) * 2.0;
-  float len   = length(uv) * uniStrength;
+  vec2 uv     = (texcoords - 0.5) * vec2(uniVignetteFrameRatio, 1.0) * 2.0;
+  float len   = length(uv) * uniVignetteStrength;
   float sqLen = len * len + 1.0;
   float fade  = 1.0 / (sqLen * sqLen);
 
@@ -24,12 +21,11 @@ void main() {
   // - https://www.shadertoy.com/view/lsKSWR
   // - https://godotshaders.com/shader/color-vignetting/
 
-  //vec2 uv    = fragTexcoords * (1.0 - fragTexcoords);
+  //vec2 uv    = texcoords * (1.0 - texcoords);
   //float fade = uv.x * uv.y * 15.0;
-  //fade       = pow(fade, uniStrength);
+  //fade       = pow(fade, uniVignetteStrength);
 
-  vec3 color      = texture(uniBuffer, fragTexcoords).rgb;
-  vec3 fadedColor = mix(color, uniColor, 1.0 - fade);
+  vec3 fadedColor = mix(color, uniVignetteColor, 1.0 - fade);
 
-  fragColor = vec4(mix(color, fadedColor, uniOpacity), 1.0);
+  return mix(color, fadedColor, uniVignetteOpacity);
 }
@@ -1,5 +1,7 @@
 #include "application.hpp"
 
+#include <utils/file_watcher.hpp>
+
 #include <tracy/Tracy.hpp>
 
 #if defined(XEN_IS_PLATFORM_EMSCRIPTEN)
@@ -30,6 +32,9 @@ bool Application::run_once()
 {
     ZoneScopedN("Application::run_once");
 
+    // Assets reloaded in the background are swapped in before the frame, so that they are never modified while in use
+    FileWatcher::apply_reloads();
+
     auto const current_time = std::chrono::system_clock::now();
     time_info.delta_time = std::chrono::duration<float>(current_time - last_frame_time).count();
     time_info.global_time += time_info.delta_time;
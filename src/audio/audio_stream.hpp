@@ -0,0 +1,44 @@
+#pragma once
+
+#include <audio/audio_data.hpp>
+
+#include <span>
+
+namespace xen {
+/// Source of audio data decoded progressively, chunk by chunk, instead of being entirely loaded into memory.
+/// \note A stream is not thread-safe; it can however be used from any thread, as long as it is by one at a time.
+/// \see StreamedSound
+class AudioStream {
+public:
+    AudioStream() = default;
+    AudioStream(AudioStream const&) = delete;
+    AudioStream(AudioStream&&) noexcept = default;
+
+    AudioStream& operator=(AudioStream const&) = delete;
+    AudioStream& operator=(AudioStream&&) noexcept = default;
+
+    virtual ~AudioStream() = default;
+
+    AudioFormat get_format() const { return format; }
+
+    uint32_t get_frequency() const { return frequency; }
+
+    /// Gets the total number of frames (a sample for every channel) of the stream.
+    /// \return Number of frames.
+    uint64_t get_frame_count() const { return frame_count; }
+
+    /// Decodes the next frames of the stream.
+    /// \param buffer Buffer to decode the frames into. Only whole frames are decoded, up to the buffer's size.
+    /// \return Number of bytes written into the buffer; 0 if the end of the stream has been reached.
+    virtual size_t read(std::span<uint8_t> buffer) = 0;
+
+    /// Moves the decoding position.
+    /// \param frame_index Index of the next frame to be decoded. If past the end, the end of the stream is reached.
+    virtual void seek(uint64_t frame_index) = 0;
+
+protected:
+    AudioFormat format{};
+    uint32_t frequency = 0;
+    uint64_t frame_count = 0;
+};
+}
@@ -2,6 +2,7 @@
 
 #include <audio/listener.hpp>
 #include <audio/sound.hpp>
+#include <audio/streamed_sound.hpp>
 
 #include <math/transform/transform.hpp>
 
@@ -45,7 +46,7 @@ AudioSystem::AudioSystem(std::string const& device_name)
 {
     ZoneScopedN("AudioSystem::AudioSystem");
 
-    register_components<Sound, Listener>();
+    register_components<Sound, StreamedSound, Listener>();
     open_device(device_name);
 
     if (device == nullptr || context == nullptr) {
@@ -157,6 +158,17 @@ bool AudioSystem::update(FrameTimeInfo const&)
             // }
         }
 
+        if (entity->has_component<StreamedSound>()) {
+            auto& streamed_sound = entity->get_component<StreamedSound>();
+
+            if (entity->has_component<Transform>()) {
+                streamed_sound.set_position(entity->get_component<Transform>().get_position());
+            }
+
+            // Queuing the chunks decoded in the background, for the sound to keep being played
+            streamed_sound.update();
+        }
+
         if (entity->has_component<Listener>()) {
 
 #if defined(XEN_CONFIG_DEBUG)
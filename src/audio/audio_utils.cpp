@@ -4,89 +4,359 @@
 
 #include <tracy/Tracy.hpp>
 
+#include <AL/al.h>
+
 namespace xen {
 namespace {
-constexpr int16_t from_little_endian(uint8_t byte1, uint8_t byte2)
+constexpr size_t block_frame_count = 1024; ///< Number of frames converted at once, keeping the samples in cache.
+constexpr size_t block_sample_count = block_frame_count * 2;
+
+enum class SampleType { U8, I16, F32, F64 };
+
+SampleType recover_sample_type(AudioFormat format)
 {
-    return static_cast<int16_t>((byte1 << 0u) | (byte2 << 8u));
+    switch (format) {
+    case AudioFormat::MONO_U8:
+    case AudioFormat::STEREO_U8:
+        return SampleType::U8;
+
+    case AudioFormat::MONO_I16:
+    case AudioFormat::STEREO_I16:
+        return SampleType::I16;
+
+    case AudioFormat::MONO_F32:
+    case AudioFormat::STEREO_F32:
+        return SampleType::F32;
+
+    case AudioFormat::MONO_F64:
+    case AudioFormat::STEREO_F64:
+        return SampleType::F64;
+
+    default:
+        throw std::invalid_argument("[AudioUtils] Unexpected audio format");
+    }
 }
 
-constexpr std::array<uint8_t, 2> to_little_endian16(int16_t val)
+AudioFormat recover_format(SampleType sample_type, uint8_t channel_count)
 {
-    return {static_cast<uint8_t>(val & 0xFFu), static_cast<uint8_t>(val >> 8u)};
+    bool const is_mono = (channel_count == 1);
+
+    switch (sample_type) {
+    case SampleType::U8:
+        return (is_mono ? AudioFormat::MONO_U8 : AudioFormat::STEREO_U8);
+
+    case SampleType::I16:
+        return (is_mono ? AudioFormat::MONO_I16 : AudioFormat::STEREO_I16);
+
+    case SampleType::F32:
+        return (is_mono ? AudioFormat::MONO_F32 : AudioFormat::STEREO_F32);
+
+    case SampleType::F64:
+    default:
+        return (is_mono ? AudioFormat::MONO_F64 : AudioFormat::STEREO_F64);
+    }
 }
 
-constexpr std::array<uint8_t, 2>
-computeMonoI16(std::array<uint8_t, 2> leftSampleBytes, std::array<uint8_t, 2> rightSampleBytes)
+// The conversion loops below are kept branchless & over contiguous samples for the compiler to vectorize them; samples
+//   are copied into properly aligned arrays first, since audio buffers hold raw bytes
+
+void decode_samples(uint8_t const* input, SampleType sample_type, size_t sample_count, float* output)
 {
-    int16_t const leftSample = from_little_endian(leftSampleBytes[0], leftSampleBytes[1]);
-    int16_t const rightSample = from_little_endian(rightSampleBytes[0], rightSampleBytes[1]);
-    auto const mergedSample = static_cast<int32_t>(leftSample) + static_cast<int32_t>(rightSample);
+    switch (sample_type) {
+    case SampleType::U8:
+        for (size_t sample_index = 0; sample_index < sample_count; ++sample_index) {
+            output[sample_index] = (static_cast<float>(input[sample_index]) - 128.f) * (1.f / 128.f);
+        }
+        break;
+
+    case SampleType::I16: {
+        std::array<int16_t, block_sample_count> samples;
+        std::memcpy(samples.data(), input, sample_count * sizeof(int16_t));
+        AudioUtils::convert_i16_to_f32(std::span(samples.data(), sample_count), std::span(output, sample_count));
+        break;
+    }
+
+    case SampleType::F32:
+        std::memcpy(output, input, sample_count * sizeof(float));
+        break;
+
+    case SampleType::F64: {
+        std::array<double, block_sample_count> samples;
+        std::memcpy(samples.data(), input, sample_count * sizeof(double));
 
-    return to_little_endian16(static_cast<int16_t>(mergedSample / 2));
+        for (size_t sample_index = 0; sample_index < sample_count; ++sample_index) {
+            output[sample_index] = static_cast<float>(samples[sample_index]);
+        }
+        break;
+    }
+    }
+}
+
+void encode_samples(float const* input, SampleType sample_type, size_t sample_count, uint8_t* output)
+{
+    switch (sample_type) {
+    case SampleType::U8:
+        for (size_t sample_index = 0; sample_index < sample_count; ++sample_index) {
+            output[sample_index] =
+                static_cast<uint8_t>(std::clamp(input[sample_index] * 128.f + 128.5f, 0.f, 255.f));
+        }
+        break;
+
+    case SampleType::I16: {
+        std::array<int16_t, block_sample_count> samples;
+        AudioUtils::convert_f32_to_i16(std::span(input, sample_count), std::span(samples.data(), sample_count));
+        std::memcpy(output, samples.data(), sample_count * sizeof(int16_t));
+        break;
+    }
+
+    case SampleType::F32:
+        std::memcpy(output, input, sample_count * sizeof(float));
+        break;
+
+    case SampleType::F64: {
+        std::array<double, block_sample_count> samples;
+
+        for (size_t sample_index = 0; sample_index < sample_count; ++sample_index) {
+            samples[sample_index] = static_cast<double>(input[sample_index]);
+        }
+
+        std::memcpy(output, samples.data(), sample_count * sizeof(double));
+        break;
+    }
+    }
 }
 }
 void AudioUtils::convert_to_mono(AudioData& audio_data)
 {
     ZoneScopedN("AudioUtils::convert_to_mono");
 
-    AudioFormat const orig_format = audio_data.format;
-
-    if (orig_format == AudioFormat::MONO_U8 || orig_format == AudioFormat::MONO_I16 ||
-        orig_format == AudioFormat::MONO_F32 || orig_format == AudioFormat::MONO_F64) {
+    if (recover_channel_count(audio_data.format) == 1) {
         return;
     }
 
-    if (orig_format == AudioFormat::STEREO_F32 || orig_format == AudioFormat::STEREO_F64) {
-        throw std::invalid_argument("[AudioUtils] Mono conversion currently unsupported for floating-point formats");
-    }
+    convert_format(audio_data, recover_format(recover_sample_type(audio_data.format), 1));
+}
 
-    uint8_t bytes_per_sample{};
+uint8_t AudioUtils::recover_frame_size(AudioFormat format)
+{
+    switch (format) {
+    case AudioFormat::MONO_U8:
+        return 1;
 
-    switch (orig_format) {
     case AudioFormat::STEREO_U8:
-        bytes_per_sample = 1;
-        audio_data.format = AudioFormat::MONO_U8;
-        break;
+    case AudioFormat::MONO_I16:
+        return 2;
 
     case AudioFormat::STEREO_I16:
-        bytes_per_sample = 2;
-        audio_data.format = AudioFormat::MONO_I16;
-        break;
+    case AudioFormat::MONO_F32:
+        return 4;
 
-        // case AudioFormat::STEREO_F32:
-        //   bytes_per_sample   = 4;
-        //   audio_data.format = AudioFormat::MONO_F32;
-        //   break;
+    case AudioFormat::STEREO_F32:
+    case AudioFormat::MONO_F64:
+        return 8;
 
-        // case AudioFormat::STEREO_F64:
-        //   bytes_per_sample   = 8;
-        //   audio_data.format = AudioFormat::MONO_F64;
-        //   break;
+    case AudioFormat::STEREO_F64:
+        return 16;
 
     default:
-        throw std::invalid_argument("[AudioData] Unexpected format to convert to mono");
+        throw std::invalid_argument("[AudioUtils] Unexpected audio format");
     }
+}
 
-    std::vector<uint8_t> mono_buffer(audio_data.buffer.size() / 2);
+uint8_t AudioUtils::recover_channel_count(AudioFormat format)
+{
+    switch (format) {
+    case AudioFormat::MONO_U8:
+    case AudioFormat::MONO_I16:
+    case AudioFormat::MONO_F32:
+    case AudioFormat::MONO_F64:
+        return 1;
 
-    for (size_t value_index = 0; value_index < audio_data.buffer.size(); value_index += bytes_per_sample * 2) {
-        size_t const mono_index = value_index / 2;
+    case AudioFormat::STEREO_U8:
+    case AudioFormat::STEREO_I16:
+    case AudioFormat::STEREO_F32:
+    case AudioFormat::STEREO_F64:
+        return 2;
 
-        if (bytes_per_sample == 1) {
-            mono_buffer[mono_index] =
-                static_cast<uint8_t>((audio_data.buffer[value_index] + audio_data.buffer[value_index + 1]) / 2);
+    default:
+        throw std::invalid_argument("[AudioUtils] Unexpected audio format");
+    }
+}
+
+void AudioUtils::convert_i16_to_f32(std::span<int16_t const> input, std::span<float> output)
+{
+    for (size_t sample_index = 0; sample_index < input.size(); ++sample_index) {
+        output[sample_index] = static_cast<float>(input[sample_index]) * (1.f / 32768.f);
+    }
+}
+
+void AudioUtils::convert_f32_to_i16(std::span<float const> input, std::span<int16_t> output)
+{
+    for (size_t sample_index = 0; sample_index < input.size(); ++sample_index) {
+        float const sample = std::clamp(input[sample_index] * 32767.f, -32768.f, 32767.f);
+        // Rounding to the nearest integer; the conversion itself truncates toward zero
+        output[sample_index] = static_cast<int16_t>(sample + (sample < 0.f ? -0.5f : 0.5f));
+    }
+}
+
+void AudioUtils::downmix_to_mono(std::span<float const> stereo_samples, std::span<float> mono_samples)
+{
+    for (size_t frame_index = 0; frame_index < stereo_samples.size() / 2; ++frame_index) {
+        mono_samples[frame_index] = (stereo_samples[frame_index * 2] + stereo_samples[frame_index * 2 + 1]) * 0.5f;
+    }
+}
+
+size_t AudioUtils::convert_samples(
+    std::span<uint8_t const> input, AudioFormat input_format, std::span<uint8_t> output, AudioFormat output_format
+)
+{
+    ZoneScopedN("AudioUtils::convert_samples");
+
+    uint8_t const input_frame_size = recover_frame_size(input_format);
+    uint8_t const output_frame_size = recover_frame_size(output_format);
+    size_t const frame_count = input.size() / input_frame_size;
+
+    if (output.size() < frame_count * output_frame_size) {
+        throw std::invalid_argument("[AudioUtils] The output is too small to hold the converted samples");
+    }
+
+    if (input_format == output_format) {
+        std::memcpy(output.data(), input.data(), frame_count * input_frame_size);
+        return frame_count * input_frame_size;
+    }
+
+    SampleType const input_type = recover_sample_type(input_format);
+    SampleType const output_type = recover_sample_type(output_format);
+    uint8_t const input_channel_count = recover_channel_count(input_format);
+    uint8_t const output_channel_count = recover_channel_count(output_format);
+
+    // Samples are converted to floats by blocks, then to the output type after having been remixed if needed
+    std::array<float, block_sample_count> input_samples;
+    std::array<float, block_sample_count> output_samples;
+
+    for (size_t first_frame = 0; first_frame < frame_count; first_frame += block_frame_count) {
+        size_t const block_size = std::min(block_frame_count, frame_count - first_frame);
+
+        decode_samples(
+            input.data() + first_frame * input_frame_size, input_type, block_size * input_channel_count,
+            input_samples.data()
+        );
+
+        float const* converted_samples = input_samples.data();
+
+        if (input_channel_count == 2 && output_channel_count == 1) {
+            downmix_to_mono(std::span(input_samples.data(), block_size * 2), output_samples);
+            converted_samples = output_samples.data();
+        }
+        else if (input_channel_count == 1 && output_channel_count == 2) {
+            for (size_t frame_index = 0; frame_index < block_size; ++frame_index) {
+                output_samples[frame_index * 2] = input_samples[frame_index];
+                output_samples[frame_index * 2 + 1] = input_samples[frame_index];
+            }
+
+            converted_samples = output_samples.data();
         }
-        else if (bytes_per_sample == 2) {
-            std::array<uint8_t, 2> const mono_sample = computeMonoI16(
-                {audio_data.buffer[value_index], audio_data.buffer[value_index + 1]},
-                {audio_data.buffer[value_index + 2], audio_data.buffer[value_index + 3]}
-            );
-            mono_buffer[mono_index] = mono_sample[0];
-            mono_buffer[mono_index + 1] = mono_sample[1];
+
+        encode_samples(
+            converted_samples, output_type, block_size * output_channel_count,
+            output.data() + first_frame * output_frame_size
+        );
+    }
+
+    return frame_count * output_frame_size;
+}
+
+void AudioUtils::convert_format(AudioData& audio_data, AudioFormat format)
+{
+    ZoneScopedN("AudioUtils::convert_format");
+
+    if (audio_data.format == format) {
+        return;
+    }
+
+    std::vector<uint8_t> converted_buffer(
+        audio_data.buffer.size() / recover_frame_size(audio_data.format) * recover_frame_size(format)
+    );
+    convert_samples(audio_data.buffer, audio_data.format, converted_buffer, format);
+
+    audio_data.buffer = std::move(converted_buffer);
+    audio_data.format = format;
+}
+
+void AudioUtils::resample(AudioData& audio_data, uint32_t frequency)
+{
+    ZoneScopedN("AudioUtils::resample");
+
+    if (frequency == 0 || audio_data.frequency == 0) {
+        throw std::invalid_argument("[AudioUtils] The sampling frequencies must be strictly positive");
+    }
+
+    if (audio_data.frequency == frequency || audio_data.buffer.empty()) {
+        audio_data.frequency = frequency;
+        return;
+    }
+
+    uint8_t const channel_count = recover_channel_count(audio_data.format);
+    AudioFormat const float_format = recover_format(SampleType::F32, channel_count);
+
+    std::vector<float> samples(audio_data.buffer.size() / recover_frame_size(audio_data.format) * channel_count);
+    convert_samples(
+        audio_data.buffer, audio_data.format,
+        std::span(reinterpret_cast<uint8_t*>(samples.data()), samples.size() * sizeof(float)), float_format
+    );
+
+    size_t const frame_count = samples.size() / channel_count;
+    size_t const resampled_frame_count =
+        (static_cast<uint64_t>(frame_count) * frequency + audio_data.frequency - 1) / audio_data.frequency;
+    double const step = static_cast<double>(audio_data.frequency) / static_cast<double>(frequency);
+
+    std::vector<float> resampled_samples(resampled_frame_count * channel_count);
+
+    for (size_t frame_index = 0; frame_index < resampled_frame_count; ++frame_index) {
+        double const position = static_cast<double>(frame_index) * step;
+        size_t const prev_frame = std::min(static_cast<size_t>(position), frame_count - 1);
+        size_t const next_frame = std::min(prev_frame + 1, frame_count - 1);
+        auto const coeff = static_cast<float>(position - static_cast<double>(prev_frame));
+
+        for (uint8_t channel_index = 0; channel_index < channel_count; ++channel_index) {
+            float const prev_sample = samples[prev_frame * channel_count + channel_index];
+            float const next_sample = samples[next_frame * channel_count + channel_index];
+
+            resampled_samples[frame_index * channel_count + channel_index] =
+                prev_sample + (next_sample - prev_sample) * coeff;
         }
     }
 
-    audio_data.buffer = std::move(mono_buffer);
+    audio_data.buffer.resize(resampled_frame_count * recover_frame_size(audio_data.format));
+    convert_samples(
+        std::span(
+            reinterpret_cast<uint8_t const*>(resampled_samples.data()), resampled_samples.size() * sizeof(float)
+        ),
+        float_format, audio_data.buffer, audio_data.format
+    );
+    audio_data.frequency = frequency;
+}
+
+AudioFormat AudioUtils::recover_playable_format(AudioFormat format)
+{
+    uint8_t const channel_count = recover_channel_count(format);
+
+    switch (recover_sample_type(format)) {
+    case SampleType::F64:
+        if (alIsExtensionPresent("AL_EXT_double")) {
+            return format;
+        }
+        [[fallthrough]];
+
+    case SampleType::F32:
+        if (alIsExtensionPresent("AL_EXT_float32")) {
+            return recover_format(SampleType::F32, channel_count);
+        }
+
+        return recover_format(SampleType::I16, channel_count);
+
+    default:
+        return format;
+    }
+}
 }
-}
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <span>
+
 namespace xen {
 struct AudioData;
+enum class AudioFormat : int;
 
 namespace AudioUtils {
 
@@ -9,5 +12,59 @@ namespace AudioUtils {
 /// \param audio_data Data to be converted.
 void convert_to_mono(AudioData& audio_data);
 
+/// Recovers the size of a frame (a sample for every channel) in the given format.
+/// \param format Audio format.
+/// \return Size of a frame, in bytes.
+uint8_t recover_frame_size(AudioFormat format);
+
+/// Recovers the number of channels of the given format.
+/// \param format Audio format.
+/// \return Number of channels; 1 for mono formats, 2 for stereo ones.
+uint8_t recover_channel_count(AudioFormat format);
+
+/// Converts 16-bit integer samples to floating-point ones, in the [-1; 1] range.
+/// \param input Samples to be converted.
+/// \param output Converted samples; must be at least as large as the input.
+void convert_i16_to_f32(std::span<int16_t const> input, std::span<float> output);
+
+/// Converts floating-point samples to 16-bit integer ones. Values outside of the [-1; 1] range are clamped.
+/// \param input Samples to be converted.
+/// \param output Converted samples; must be at least as large as the input.
+void convert_f32_to_i16(std::span<float const> input, std::span<int16_t> output);
+
+/// Averages interleaved stereo floating-point samples into mono ones.
+/// \param stereo_samples Interleaved left & right samples.
+/// \param mono_samples Averaged samples; must be at least half as large as the stereo ones.
+void downmix_to_mono(std::span<float const> stereo_samples, std::span<float> mono_samples);
+
+/// Converts whole frames from a format to another, changing both the sample type & the channel count if needed. Stereo
+///   is averaged into mono, and mono is duplicated into stereo.
+/// \param input Frames to be converted.
+/// \param input_format Format of the frames to be converted.
+/// \param output Converted frames; must be large enough to hold as many frames as the input.
+/// \param output_format Format of the converted frames.
+/// \return Number of bytes written into the output.
+size_t convert_samples(
+    std::span<uint8_t const> input, AudioFormat input_format, std::span<uint8_t> output, AudioFormat output_format
+);
+
+/// Converts audio data to another format. Does nothing if the data already has the given format.
+/// \param audio_data Data to be converted.
+/// \param format Format to convert the data to.
+void convert_format(AudioData& audio_data, AudioFormat format);
+
+/// Resamples audio data to another frequency, interpolating linearly between the original frames.
+/// \note No low-pass filtering is applied; aliasing may thus be audible when greatly lowering the frequency.
+/// \param audio_data Data to be resampled.
+/// \param frequency New sampling frequency, in Hz.
+void resample(AudioData& audio_data, uint32_t frequency);
+
+/// Recovers the format closest to the given one that the current audio driver can play. Floating-point formats are
+///   converted to 32-bit floats if the driver supports them, to 16-bit integers otherwise.
+/// \note This requires an audio device to be opened.
+/// \param format Audio format.
+/// \return Playable format, with the same number of channels.
+AudioFormat recover_playable_format(AudioFormat format);
+
+}
 }
-}
\ No newline at end of file
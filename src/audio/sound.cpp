@@ -1,5 +1,6 @@
 #include "sound.hpp"
 
+#include <audio/audio_utils.hpp>
 #include <audio/sound_effect_slot.hpp>
 
 #include <tracy/Tracy.hpp>
@@ -237,16 +238,12 @@ void Sound::load()
     stop();                                // Making sure the sound isn't paused or currently playing
     alSourcei(source_index, AL_BUFFER, 0); // Detaching the previous buffer (if any) from the source
 
-    if ((data.format == AudioFormat::MONO_F32 || data.format == AudioFormat::STEREO_F32) &&
-        !alIsExtensionPresent("AL_EXT_float32")) {
-        Log::error("[Sound] Float audio format is not supported by the audio driver.");
-        return;
-    }
+    // Formats the audio driver cannot play are converted to the closest one it can
+    AudioFormat const playable_format = AudioUtils::recover_playable_format(data.format);
 
-    if ((data.format == AudioFormat::MONO_F64 || data.format == AudioFormat::STEREO_F64) &&
-        !alIsExtensionPresent("AL_EXT_double")) {
-        Log::error("[Sound] Double audio format is not supported by the audio driver.");
-        return;
+    if (playable_format != data.format) {
+        Log::debug("[Sound] Audio format not supported by the audio driver, converting the data...");
+        AudioUtils::convert_format(data, playable_format);
     }
 
     alBufferData(
@@ -0,0 +1,533 @@
+#include "streamed_sound.hpp"
+
+#include <audio/audio_utils.hpp>
+#include <audio/sound_effect_slot.hpp>
+#include <utils/thread_pool.hpp>
+#include <utils/threading.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <AL/al.h>
+#if !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
+#include <AL/efx.h>
+#endif
+
+namespace xen {
+namespace {
+constexpr char const* recover_al_error_str(int error_code)
+{
+    switch (error_code) {
+    case AL_INVALID_NAME:
+        return "Invalid name";
+    case AL_INVALID_ENUM:
+        return "Invalid enum";
+    case AL_INVALID_VALUE:
+        return "Invalid value";
+    case AL_INVALID_OPERATION:
+        return "Invalid operation";
+    case AL_OUT_OF_MEMORY:
+        return "Out of memory";
+    case AL_NO_ERROR:
+        return "No error";
+    default:
+        return "Unknown error";
+    }
+}
+
+inline void check_error(std::string const& error_msg)
+{
+    int const error_code = alGetError();
+
+    if (error_code != AL_NO_ERROR)
+        Log::verror("[OpenAL] {} ({}).", error_msg, recover_al_error_str(error_code));
+}
+
+/// Stream converting the frames decoded by another one to a different format.
+class ConvertedStream final : public AudioStream {
+public:
+    ConvertedStream(std::unique_ptr<AudioStream> stream, AudioFormat format) : stream{std::move(stream)}
+    {
+        this->format = format;
+        frequency = this->stream->get_frequency();
+        frame_count = this->stream->get_frame_count();
+    }
+
+    size_t read(std::span<uint8_t> buffer) override
+    {
+        size_t const frame_count_to_read = buffer.size() / AudioUtils::recover_frame_size(format);
+        input_buffer.resize(frame_count_to_read * AudioUtils::recover_frame_size(stream->get_format()));
+
+        size_t const read_size = stream->read(input_buffer);
+        return AudioUtils::convert_samples(
+            std::span(input_buffer).first(read_size), stream->get_format(), buffer, format
+        );
+    }
+
+    void seek(uint64_t frame_index) override { stream->seek(frame_index); }
+
+private:
+    std::unique_ptr<AudioStream> stream;
+    std::vector<uint8_t> input_buffer;
+};
+}
+
+void StreamedSound::init()
+{
+    ZoneScopedN("StreamedSound::init");
+
+    Log::debug("[StreamedSound] Initializing...");
+
+    alGetError(); // Flushing errors
+
+    destroy();
+
+    alGenSources(1, &source_index.get());
+    check_error("Failed to create a sound source");
+
+    std::array<uint32_t, buffer_count> indices{};
+    alGenBuffers(static_cast<int>(buffer_count), indices.data());
+    check_error("Failed to create the sound buffers");
+
+    for (size_t buffer_index = 0; buffer_index < buffer_count; ++buffer_index) {
+        buffer_indices[buffer_index] = indices[buffer_index];
+    }
+
+    free_buffer_indices.assign(indices.cbegin(), indices.cend());
+
+    if (state->stream != nullptr) {
+        restart_from(0);
+    }
+
+    Log::debug("[StreamedSound] Initialized (source ID: " + std::to_string(source_index) + ")");
+}
+
+void StreamedSound::open(std::unique_ptr<AudioStream> stream)
+{
+    ZoneScopedN("StreamedSound::open");
+
+    should_play = false;
+    restart_from(0);
+
+    // Formats the audio driver cannot play are converted on the fly, as the chunks get decoded
+    AudioFormat const playable_format = AudioUtils::recover_playable_format(stream->get_format());
+
+    if (playable_format != stream->get_format()) {
+        Log::debug("[StreamedSound] Audio format not supported by the audio driver, the stream will be converted");
+        stream = std::make_unique<ConvertedStream>(std::move(stream), playable_format);
+    }
+
+    format = stream->get_format();
+    frequency = stream->get_frequency();
+    frame_count = stream->get_frame_count();
+    frame_size = AudioUtils::recover_frame_size(format);
+
+    bool repeat = false;
+
+    {
+        std::lock_guard<std::mutex> const lock(state->mutex);
+        repeat = state->repeat;
+    }
+
+    // A decoding task may still be using the previous stream; a new state is thus created instead of modifying it
+    state = std::make_shared<StreamState>();
+    state->stream = std::move(stream);
+    state->chunk_size =
+        std::max<size_t>(static_cast<size_t>(static_cast<float>(frequency) * chunk_duration), 1) * frame_size;
+    state->repeat = repeat;
+
+    request_decoding();
+}
+
+void StreamedSound::set_pitch(float pitch) const
+{
+    Log::rt_assert(pitch >= 0.f, "Error: The source's pitch must be positive.");
+
+    alSourcef(source_index, AL_PITCH, pitch);
+    check_error("Failed to set the source's pitch");
+}
+
+float StreamedSound::recover_pitch() const
+{
+    float pitch{};
+
+    alGetSourcef(source_index, AL_PITCH, &pitch);
+    check_error("Failed to recover the source's pitch");
+
+    return pitch;
+}
+
+void StreamedSound::set_gain(float gain) const
+{
+    Log::rt_assert(gain >= 0.f, "Error: The source's gain must be positive.");
+
+    alSourcef(source_index, AL_GAIN, gain);
+    check_error("Failed to set the source's gain");
+}
+
+float StreamedSound::recover_gain() const
+{
+    float gain{};
+
+    alGetSourcef(source_index, AL_GAIN, &gain);
+    check_error("Failed to recover the source's gain");
+
+    return gain;
+}
+
+void StreamedSound::set_position(Vector3f const& position) const
+{
+    alSource3f(source_index, AL_POSITION, position.x, position.y, position.z);
+    check_error("Failed to set the source's position");
+}
+
+Vector3f StreamedSound::recover_position() const
+{
+    Vector3f position;
+
+    alGetSource3f(source_index, AL_POSITION, &position.x, &position.y, &position.z);
+    check_error("Failed to recover the source's position");
+
+    return position;
+}
+
+void StreamedSound::set_velocity(Vector3f const& velocity) const
+{
+    alSource3f(source_index, AL_VELOCITY, velocity.x, velocity.y, velocity.z);
+    check_error("Failed to set the source's velocity");
+}
+
+Vector3f StreamedSound::recover_velocity() const
+{
+    Vector3f velocity;
+
+    alGetSource3f(source_index, AL_VELOCITY, &velocity.x, &velocity.y, &velocity.z);
+    check_error("Failed to recover the source's velocity");
+
+    return velocity;
+}
+
+#if !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
+void StreamedSound::link_slot(SoundEffectSlot const& slot) const
+{
+    alSource3i(source_index, AL_AUXILIARY_SEND_FILTER, static_cast<int>(slot.get_index()), 0, AL_FILTER_NULL);
+    check_error("Failed to link the sound effect slot to the sound");
+}
+
+void StreamedSound::unlink_slot() const
+{
+    alSource3i(source_index, AL_AUXILIARY_SEND_FILTER, 0, 0, AL_FILTER_NULL);
+    check_error("Failed to unlink the sound effect slot from the sound");
+}
+#endif
+
+void StreamedSound::set_repeat(bool repeat)
+{
+    std::lock_guard<std::mutex> const lock(state->mutex);
+
+    state->repeat = repeat;
+
+    // If the stream's end has already been reached, it must now continue from its beginning
+    if (repeat) {
+        state->is_finished = false;
+    }
+}
+
+void StreamedSound::play()
+{
+    ZoneScopedN("StreamedSound::play");
+
+    if (recover_state() == SoundState::PAUSED) {
+        should_play = true;
+        alSourcePlay(source_index);
+        check_error("Failed to resume the sound");
+        return;
+    }
+
+    if (should_play) {
+        return;
+    }
+
+    bool has_ended = false;
+
+    {
+        std::lock_guard<std::mutex> const lock(state->mutex);
+        has_ended = (state->is_finished && state->decoded_chunks.empty());
+    }
+
+    if (has_ended && queued_frame_counts.empty()) {
+        restart_from(0);
+    }
+
+    should_play = true;
+    update();
+}
+
+void StreamedSound::pause()
+{
+    should_play = false;
+
+    alSourcePause(source_index);
+    check_error("Failed to pause the sound");
+}
+
+void StreamedSound::stop()
+{
+    should_play = false;
+    restart_from(0);
+}
+
+void StreamedSound::rewind()
+{
+    seek(0.f);
+}
+
+void StreamedSound::seek(float minutes)
+{
+    ZoneScopedN("StreamedSound::seek");
+
+    restart_from(static_cast<uint64_t>(std::max(minutes, 0.f) * 60.f * static_cast<float>(frequency)));
+
+    if (should_play) {
+        update();
+    }
+}
+
+SoundState StreamedSound::recover_state() const
+{
+    int state{};
+    alGetSourcei(source_index, AL_SOURCE_STATE, &state);
+
+    return static_cast<SoundState>(state);
+}
+
+float StreamedSound::recover_elapsed_time() const
+{
+    if (frequency == 0) {
+        return 0.f;
+    }
+
+    // The sample offset is relative to the first buffer still queued
+    int sample_offset{};
+    alGetSourcei(source_index, AL_SAMPLE_OFFSET, &sample_offset);
+
+    uint64_t frame_index = start_frame + played_frame_count + static_cast<uint64_t>(sample_offset);
+
+    // When repeated, the stream continues from its beginning after its end
+    if (frame_count != 0) {
+        frame_index %= frame_count;
+    }
+
+    return (static_cast<float>(frame_index) / static_cast<float>(frequency) / 60.f);
+}
+
+void StreamedSound::update()
+{
+    ZoneScopedN("StreamedSound::update");
+
+    if (!source_index.is_valid() || state->stream == nullptr) {
+        return;
+    }
+
+    int processed_count{};
+    alGetSourcei(source_index, AL_BUFFERS_PROCESSED, &processed_count);
+
+    for (; processed_count > 0; --processed_count) {
+        uint32_t buffer_index{};
+        alSourceUnqueueBuffers(source_index, 1, &buffer_index);
+        free_buffer_indices.push_back(buffer_index);
+
+        if (!queued_frame_counts.empty()) {
+            played_frame_count += queued_frame_counts.front();
+            queued_frame_counts.pop_front();
+        }
+    }
+
+    check_error("Failed to unqueue the played buffers");
+
+    bool has_ended = false;
+
+    {
+        std::lock_guard<std::mutex> const lock(state->mutex);
+
+        while (!free_buffer_indices.empty() && !state->decoded_chunks.empty()) {
+            std::vector<uint8_t>& chunk = state->decoded_chunks.front();
+            uint32_t const buffer_index = free_buffer_indices.back();
+
+            alBufferData(
+                buffer_index, static_cast<int>(format), chunk.data(), static_cast<int>(chunk.size()),
+                static_cast<int>(frequency)
+            );
+            alSourceQueueBuffers(source_index, 1, &buffer_index);
+
+            free_buffer_indices.pop_back();
+            queued_frame_counts.push_back(chunk.size() / frame_size);
+
+            state->free_chunks.emplace_back(std::move(chunk));
+            state->decoded_chunks.pop_front();
+        }
+
+        has_ended = (state->is_finished && state->decoded_chunks.empty());
+    }
+
+    check_error("Failed to queue the decoded buffers");
+
+    request_decoding();
+
+    // The source stops by itself when it runs out of buffers, either because the decoding did not keep up or because
+    //   the stream's end has been reached
+    if (!should_play || recover_state() == SoundState::PLAYING) {
+        return;
+    }
+
+    if (!queued_frame_counts.empty()) {
+        alSourcePlay(source_index);
+        check_error("Failed to play the sound");
+    }
+    else if (has_ended) {
+        should_play = false;
+    }
+}
+
+void StreamedSound::destroy()
+{
+    ZoneScopedN("StreamedSound::destroy");
+
+    should_play = false;
+    queued_frame_counts.clear();
+    free_buffer_indices.clear();
+
+    if (source_index.is_valid() && alIsSource(source_index)) {
+        alSourceStop(source_index);
+        alDeleteSources(1, &source_index.get());
+        check_error("Failed to delete source");
+    }
+
+    source_index.reset();
+
+    for (auto& buffer_index : buffer_indices) {
+        if (buffer_index.is_valid() && alIsBuffer(buffer_index)) {
+            alDeleteBuffers(1, &buffer_index.get());
+            check_error("Failed to delete buffer");
+        }
+
+        buffer_index.reset();
+    }
+}
+
+void StreamedSound::restart_from(uint64_t frame_index)
+{
+    if (source_index.is_valid()) {
+        alSourceStop(source_index);
+        alSourcei(source_index, AL_BUFFER, 0); // Detaching all the queued buffers
+        check_error("Failed to detach the buffers from the source");
+
+        free_buffer_indices.assign(buffer_indices.cbegin(), buffer_indices.cend());
+    }
+
+    queued_frame_counts.clear();
+    start_frame = (frame_count != 0 ? std::min(frame_index, frame_count) : 0);
+    played_frame_count = 0;
+
+    std::lock_guard<std::mutex> const lock(state->mutex);
+
+    ++state->generation;
+    state->seek_frame = start_frame;
+    state->is_finished = false;
+
+    while (!state->decoded_chunks.empty()) {
+        state->free_chunks.emplace_back(std::move(state->decoded_chunks.front()));
+        state->decoded_chunks.pop_front();
+    }
+}
+
+void StreamedSound::request_decoding()
+{
+    {
+        std::lock_guard<std::mutex> const lock(state->mutex);
+
+        if (state->stream == nullptr || state->is_decoding || state->is_finished ||
+            state->decoded_chunks.size() >= buffer_count) {
+            return;
+        }
+
+        state->is_decoding = true;
+    }
+
+#if defined(XEN_THREADS_AVAILABLE) && !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
+    get_default_thread_pool().add_task([stream_state = state]() { decode_chunks(*stream_state); });
+#else
+    decode_chunks(*state);
+#endif
+}
+
+void StreamedSound::decode_chunks(StreamState& stream_state)
+{
+    ZoneScopedN("StreamedSound::decode_chunks");
+
+    while (true) {
+        std::vector<uint8_t> chunk;
+        std::optional<uint64_t> seek_frame;
+        uint64_t generation{};
+        bool repeat{};
+
+        {
+            std::lock_guard<std::mutex> const lock(stream_state.mutex);
+
+            if (stream_state.is_finished || stream_state.decoded_chunks.size() >= buffer_count) {
+                stream_state.is_decoding = false;
+                return;
+            }
+
+            if (!stream_state.free_chunks.empty()) {
+                chunk = std::move(stream_state.free_chunks.back());
+                stream_state.free_chunks.pop_back();
+            }
+
+            seek_frame = std::exchange(stream_state.seek_frame, std::nullopt);
+            generation = stream_state.generation;
+            repeat = stream_state.repeat;
+        }
+
+        // The stream is only used by the running decoding task, hence outside of the lock
+        chunk.resize(stream_state.chunk_size);
+        size_t chunk_size = 0;
+
+        try {
+            if (seek_frame.has_value()) {
+                stream_state.stream->seek(*seek_frame);
+            }
+
+            chunk_size = stream_state.stream->read(chunk);
+
+            // When repeating, the stream's beginning directly follows its end
+            while (repeat && chunk_size < chunk.size()) {
+                stream_state.stream->seek(0);
+                size_t const read_size = stream_state.stream->read(std::span<uint8_t>(chunk).subspan(chunk_size));
+
+                if (read_size == 0) {
+                    break;
+                }
+
+                chunk_size += read_size;
+            }
+        }
+        catch (std::exception const& exception) {
+            Log::error("[StreamedSound] Failed to decode the stream: " + std::string(exception.what()));
+            chunk_size = 0;
+        }
+
+        chunk.resize(chunk_size);
+
+        std::lock_guard<std::mutex> const lock(stream_state.mutex);
+
+        // Chunks decoded before a seek are discarded
+        if (generation != stream_state.generation || chunk.empty()) {
+            stream_state.is_finished = (generation == stream_state.generation);
+            stream_state.free_chunks.emplace_back(std::move(chunk));
+            continue;
+        }
+
+        stream_state.decoded_chunks.emplace_back(std::move(chunk));
+    }
+}
+}
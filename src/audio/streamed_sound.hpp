@@ -0,0 +1,173 @@
+#pragma once
+
+#include <component.hpp>
+#include <audio/audio_stream.hpp>
+#include <audio/sound.hpp>
+#include <data/owner_value.hpp>
+
+#include <deque>
+#include <mutex>
+
+namespace xen {
+class SoundEffectSlot;
+
+/// Sound decoded progressively from an audio stream, which is never entirely held in memory. Chunks are decoded on a
+///   background thread, then queued by update() into a small ring of buffers played one after the other.
+/// This is meant for long sounds such as music; short ones should be fully loaded with a Sound.
+/// \note The AudioSystem updates all the entities' streamed sounds; others must be updated manually, often enough for
+///   the queued buffers not to run out (that is, more frequently than every buffer_count * chunk_duration seconds).
+class StreamedSound final : public Component {
+public:
+    static constexpr size_t buffer_count = 4;     ///< Number of buffers queued to be played.
+    static constexpr float chunk_duration = 0.25f; ///< Duration of each buffer, in seconds.
+
+    StreamedSound() { init(); }
+    explicit StreamedSound(std::unique_ptr<AudioStream> stream) : StreamedSound() { open(std::move(stream)); }
+    StreamedSound(StreamedSound const&) = delete;
+    StreamedSound(StreamedSound&&) noexcept = default;
+
+    StreamedSound& operator=(StreamedSound const&) = delete;
+    StreamedSound& operator=(StreamedSound&&) noexcept = default;
+
+    ~StreamedSound() override { destroy(); }
+
+    /// Initializes the sound. If a stream has been opened, it is played again from its beginning.
+    /// \note A StreamedSound must be initialized again after opening an audio device.
+    /// \see AudioSystem::open()
+    void init();
+
+    /// Sets the stream to be played, replacing the previous one if any.
+    /// \param stream Stream to be played.
+    void open(std::unique_ptr<AudioStream> stream);
+
+    /// Sets the sound's pitch multiplier.
+    /// \param pitch Sound's pitch multiplier; must be positive. 1 is the default.
+    void set_pitch(float pitch) const;
+
+    /// Recovers the sound's pitch multiplier.
+    /// \return Sound's pitch multiplier.
+    float recover_pitch() const;
+
+    /// Sets the sound's gain (volume).
+    /// \param gain Sound's gain; must be positive. 1 is the default.
+    void set_gain(float gain) const;
+
+    /// Recovers the source's gain (volume).
+    /// \return Source's gain.
+    float recover_gain() const;
+
+    /// Sets the audio source's position.
+    /// \note Note that positional audio will only be effective with sounds having a mono format.
+    /// \param position New source's position.
+    void set_position(Vector3f const& position) const;
+
+    /// Recovers the position of the sound emitter.
+    /// \return Sound's position.
+    Vector3f recover_position() const;
+
+    /// Sets the audio source's velocity.
+    /// \param velocity New source's velocity.
+    void set_velocity(Vector3f const& velocity) const;
+
+    /// Recovers the velocity of the sound emitter.
+    /// \return Sound's velocity.
+    Vector3f recover_velocity() const;
+
+#if !defined(__EMSCRIPTEN__)
+    /// Links a sound effect slot to the current sound.
+    /// \param slot Slot to be linked.
+    void link_slot(SoundEffectSlot const& slot) const;
+
+    /// Unlinks any sound effect slot from the current sound.
+    void unlink_slot() const;
+#endif
+
+    /// Sets the sound's repeat state. The stream is then decoded again from its beginning once its end is reached.
+    /// \param repeat Repeat state; true if the sound should be repeated, false otherwise.
+    void set_repeat(bool repeat);
+
+    /// Plays the sound, starting from its beginning if it has been stopped or has ended.
+    void play();
+
+    /// Pauses the sound.
+    void pause();
+
+    /// Stops the sound, which will be played from its beginning afterward.
+    void stop();
+
+    /// Rewinds the sound, continuing to play it if it was being played.
+    void rewind();
+
+    /// Moves the playback position. Since the stream's decoding position can be changed at will, this does not require
+    ///   decoding the skipped data.
+    /// \param minutes New position from the beginning of the sound, in minutes.
+    void seek(float minutes);
+
+    /// Recovers the current state of the sound.
+    /// \return Sound's state.
+    SoundState recover_state() const;
+
+    /// Checks if the sound is currently being played.
+    /// \return True if the sound is being played, false otherwise.
+    bool is_playing() const { return should_play; }
+
+    /// Checks if the sound is currently paused.
+    /// \return True if the sound is paused, false otherwise.
+    /// \see recover_state()
+    bool is_paused() const { return (recover_state() == SoundState::PAUSED); }
+
+    /// Checks if the sound is currently stopped.
+    /// \return True if the sound is stopped, false otherwise.
+    bool is_stopped() const { return (!should_play && !is_paused()); }
+
+    /// Recovers the amount of minutes the sound has been played so far.
+    /// \return Sound's elapsed time, in minutes.
+    float recover_elapsed_time() const;
+
+    /// Queues the chunks decoded since the last update & starts decoding the next ones if needed.
+    void update();
+
+    /// Destroys the sound.
+    void destroy();
+
+private:
+    /// State shared with the decoding tasks, which may outlive the sound.
+    struct StreamState {
+        std::mutex mutex;
+        std::unique_ptr<AudioStream> stream; ///< Only used by the decoding task while one is running.
+        std::deque<std::vector<uint8_t>> decoded_chunks;
+        std::vector<std::vector<uint8_t>> free_chunks; ///< Chunks already played, reused to avoid reallocating them.
+        std::optional<uint64_t> seek_frame; ///< Frame to continue decoding from, applied by the next decoding.
+        uint64_t generation = 0;            ///< Incremented on each seek, to discard the chunks decoded before.
+        size_t chunk_size = 0;
+        bool is_decoding = false;
+        bool is_finished = false;
+        bool repeat = false;
+    };
+
+    OwnerValue<uint32_t, std::numeric_limits<uint32_t>::max()> source_index{};
+    std::array<OwnerValue<uint32_t, std::numeric_limits<uint32_t>::max()>, buffer_count> buffer_indices{};
+    std::vector<uint32_t> free_buffer_indices;
+    std::deque<uint64_t> queued_frame_counts; ///< Number of frames of each queued buffer, in the order they are played.
+
+    std::shared_ptr<StreamState> state = std::make_shared<StreamState>();
+    AudioFormat format{};
+    uint32_t frequency = 0;
+    uint64_t frame_count = 0;
+    uint8_t frame_size = 0;
+    uint64_t played_frame_count = 0; ///< Number of frames of the buffers fully played since the last seek.
+    uint64_t start_frame = 0;        ///< Frame from which the stream has been played since the last seek.
+    bool should_play = false;
+
+    /// Stops the source, detaching all the buffers from it, and makes the stream continue from the given frame.
+    /// \param frame_index Index of the frame to continue playing from.
+    void restart_from(uint64_t frame_index);
+
+    /// Starts decoding the next chunks on a worker thread, if needed & not already doing so.
+    void request_decoding();
+
+    /// Decodes chunks until enough are ready to be queued or until the stream's end is reached.
+    /// \param stream_state State of the stream to decode the chunks of.
+    static void decode_chunks(StreamState& stream_state);
+};
+}
@@ -0,0 +1,640 @@
+#include "asset_cache.hpp"
+
+#include <data/gltf_format.hpp>
+#include <data/image.hpp>
+#include <data/image_buffer_pool.hpp>
+#include <data/image_format.hpp>
+#include <data/mesh.hpp>
+#include <data/mesh_optimizer.hpp>
+#include <data/obj_format.hpp>
+#include <data/xmesh_format.hpp>
+#include <render/mesh_renderer.hpp>
+#include <utils/file_utils.hpp>
+#include <utils/filepath.hpp>
+#include <utils/hash.hpp>
+#include <utils/mapped_file.hpp>
+#include <utils/str_utils.hpp>
+#include <utils/thread_pool.hpp>
+#include <utils/threading.hpp>
+#include <utils/virtual_file_system.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <condition_variable>
+
+namespace xen::AssetCache {
+namespace {
+/// Version of the cache, to be incremented whenever the manifests' or the cooked images' layout changes so that older
+/// files get ignored.
+constexpr uint32_t cache_version = 1;
+constexpr std::array<char, 4> manifest_magic_number = {'X', 'A', 'S', 'T'};
+constexpr std::array<char, 4> image_magic_number = {'X', 'I', 'M', 'G'};
+
+enum class AssetType : uint8_t { MESH, IMAGE };
+
+struct Dependency {
+    std::string path;
+    uint64_t size = 0;
+    int64_t modification_time = 0;
+    uint64_t content_hash = 0;
+};
+
+struct Manifest {
+    uint64_t key = 0; ///< Hash of the import settings & of the dependencies' content, naming the cooked asset.
+    std::vector<Dependency> dependencies;
+};
+
+struct ImageHeader {
+    std::array<char, 4> magic{};
+    uint32_t version = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t colorspace = 0;
+    uint32_t data_type = 0;
+};
+
+FilePath cache_directory = "cache/assets";
+bool cache_enabled = true;
+
+std::atomic<size_t> hit_count = 0;
+std::atomic<size_t> miss_count = 0;
+std::atomic<size_t> cooked_count = 0;
+
+/// Dependencies of the asset being cooked by the current thread, if any.
+thread_local std::vector<FilePath>* recorded_dependencies = nullptr;
+
+std::mutex background_mutex;
+std::condition_variable background_condition;
+size_t background_task_count = 0;
+
+/// Records the files read by the loaders while alive, the previous recorder being restored on destruction.
+class DependencyRecorder {
+public:
+    explicit DependencyRecorder(FilePath const& source_filepath) : previous_dependencies{recorded_dependencies}
+    {
+        dependencies.emplace_back(source_filepath);
+        recorded_dependencies = &dependencies;
+    }
+
+    DependencyRecorder(DependencyRecorder const&) = delete;
+    DependencyRecorder& operator=(DependencyRecorder const&) = delete;
+
+    ~DependencyRecorder() { recorded_dependencies = previous_dependencies; }
+
+    [[nodiscard]] std::vector<FilePath> const& get_dependencies() const { return dependencies; }
+
+private:
+    std::vector<FilePath> dependencies;
+    std::vector<FilePath>* previous_dependencies;
+};
+
+AssetType recover_asset_type(FilePath const& filepath)
+{
+    std::string const file_extension = StrUtils::to_lower_copy(filepath.recover_extension().to_utf8());
+    return (file_extension == "obj" || file_extension == "gltf" || file_extension == "glb" ? AssetType::MESH :
+                                                                                            AssetType::IMAGE);
+}
+
+/// Computes the hash of the import settings of an asset, which must be part of its key.
+/// \param type Type of the asset.
+/// \param flip_vertically For images, whether they are flipped when loaded.
+/// \return Hash of the settings.
+uint64_t compute_settings_hash(AssetType type, bool flip_vertically)
+{
+    uint64_t hash = Hash::compute_fnv1a(cache_version);
+    hash = Hash::compute_fnv1a(type, hash);
+
+    if (type == AssetType::MESH) {
+        hash = Hash::compute_fnv1a(XmeshFormat::version, hash);
+        hash = Hash::compute_fnv1a(MeshOptimizer::is_enabled_on_import(), hash);
+    }
+    else {
+        hash = Hash::compute_fnv1a(flip_vertically, hash);
+    }
+
+    return hash;
+}
+
+uint64_t compute_file_hash(FilePath const& filepath)
+{
+    ZoneScopedN("[AssetCache]::compute_file_hash");
+
+    MappedFile const file(filepath);
+    return Hash::compute_fnv1a(file.data(), file.size());
+}
+
+Dependency create_dependency(FilePath const& filepath)
+{
+    std::optional<VirtualFileSystem::FileStatus> const status = VirtualFileSystem::recover_status(filepath);
+
+    if (!status.has_value()) {
+        throw std::invalid_argument("[AssetCache] Could not get the status of the dependency '" + filepath + '\'');
+    }
+
+    return Dependency{filepath.to_utf8(), status->size, status->modification_time, compute_file_hash(filepath)};
+}
+
+uint64_t compute_key(uint64_t settings_hash, std::vector<Dependency> const& dependencies)
+{
+    uint64_t key = settings_hash;
+
+    for (Dependency const& dependency : dependencies) {
+        key = Hash::compute_fnv1a(dependency.content_hash, key);
+    }
+
+    return key;
+}
+
+FilePath recover_manifest_path(FilePath const& filepath, uint64_t settings_hash)
+{
+    std::string const source_path =
+        std::filesystem::absolute(std::filesystem::path(filepath.get_path())).lexically_normal().generic_string();
+    uint64_t const hash = Hash::compute_fnv1a(
+        reinterpret_cast<uint8_t const*>(source_path.data()), source_path.size(), settings_hash
+    );
+
+    return cache_directory + ('/' + Hash::to_hex_string(hash) + ".manifest");
+}
+
+FilePath recover_cooked_path(uint64_t key, AssetType type)
+{
+    return cache_directory + ('/' + Hash::to_hex_string(key) + (type == AssetType::MESH ? ".xmesh" : ".ximage"));
+}
+
+template <typename T>
+void write_value(std::vector<uint8_t>& buffer, T const& value)
+{
+    auto const* bytes = reinterpret_cast<uint8_t const*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+class Reader {
+public:
+    explicit Reader(MappedFile const& file) : file{file} {}
+
+    [[nodiscard]] size_t get_offset() const { return offset; }
+
+    template <typename T>
+    T read_value()
+    {
+        T value{};
+        read_bytes(&value, sizeof(T));
+        return value;
+    }
+
+    std::string read_string()
+    {
+        std::string value(read_value<uint32_t>(), '\0');
+        read_bytes(value.data(), value.size());
+        return value;
+    }
+
+    void read_bytes(void* data, size_t data_size)
+    {
+        if (data_size > file.size() - offset) {
+            throw std::runtime_error("[AssetCache] Unexpected end of file");
+        }
+
+        std::memcpy(data, file.data() + offset, data_size);
+        offset += data_size;
+    }
+
+private:
+    MappedFile const& file;
+    size_t offset = 0;
+};
+
+/// Writes a file of the cache, through a temporary file so that a partially written file can never be read.
+/// \param filepath Path to the file to be written.
+/// \param buffer Content of the file.
+void write_file(FilePath const& filepath, std::vector<uint8_t> const& buffer)
+{
+    std::filesystem::create_directories(std::filesystem::path(cache_directory.get_path()));
+
+    // Several threads may cook the same asset, each thus needing its own temporary file
+    FilePath const temp_filepath =
+        filepath + (".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+
+    {
+        std::ofstream file(temp_filepath, std::ios_base::binary);
+        file.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+        if (!file) {
+            throw std::runtime_error("[AssetCache] Failed to write '" + temp_filepath + '\'');
+        }
+    }
+
+    std::filesystem::rename(
+        std::filesystem::path(temp_filepath.get_path()), std::filesystem::path(filepath.get_path())
+    );
+}
+
+std::optional<Manifest> read_manifest(FilePath const& manifest_path)
+{
+    if (!FileUtils::is_readable(manifest_path)) {
+        return std::nullopt;
+    }
+
+    MappedFile const file(manifest_path);
+    Reader reader(file);
+
+    if (reader.read_value<std::array<char, 4>>() != manifest_magic_number ||
+        reader.read_value<uint32_t>() != cache_version) {
+        return std::nullopt;
+    }
+
+    Manifest manifest;
+    manifest.key = reader.read_value<uint64_t>();
+    manifest.dependencies.resize(reader.read_value<uint32_t>());
+
+    for (Dependency& dependency : manifest.dependencies) {
+        dependency.path = reader.read_string();
+        dependency.size = reader.read_value<uint64_t>();
+        dependency.modification_time = reader.read_value<int64_t>();
+        dependency.content_hash = reader.read_value<uint64_t>();
+    }
+
+    return manifest;
+}
+
+void write_manifest(FilePath const& manifest_path, Manifest const& manifest)
+{
+    std::vector<uint8_t> buffer;
+    buffer.insert(buffer.end(), manifest_magic_number.cbegin(), manifest_magic_number.cend());
+    write_value(buffer, cache_version);
+    write_value(buffer, manifest.key);
+    write_value(buffer, static_cast<uint32_t>(manifest.dependencies.size()));
+
+    for (Dependency const& dependency : manifest.dependencies) {
+        write_value(buffer, static_cast<uint32_t>(dependency.path.size()));
+        buffer.insert(buffer.end(), dependency.path.cbegin(), dependency.path.cend());
+        write_value(buffer, dependency.size);
+        write_value(buffer, dependency.modification_time);
+        write_value(buffer, dependency.content_hash);
+    }
+
+    write_file(manifest_path, buffer);
+}
+
+/// Checks if all the dependencies of a manifest are unchanged. Dependencies whose size & modification time are the same
+///   are considered unchanged; others are hashed again, their modification time being updated if their content is
+///   identical.
+/// \param manifest Manifest to be checked.
+/// \param is_refreshed Set to true if a dependency's modification time has been updated.
+/// \return True if the cooked asset is up to date, false otherwise.
+bool validate_manifest(Manifest& manifest, bool& is_refreshed)
+{
+    ZoneScopedN("[AssetCache]::validate_manifest");
+
+    for (Dependency& dependency : manifest.dependencies) {
+        std::optional<VirtualFileSystem::FileStatus> const status = VirtualFileSystem::recover_status(dependency.path);
+
+        if (!status.has_value() || status->size != dependency.size) {
+            return false;
+        }
+
+        if (status->modification_time == dependency.modification_time) {
+            continue;
+        }
+
+        if (compute_file_hash(dependency.path) != dependency.content_hash) {
+            return false;
+        }
+
+        dependency.modification_time = status->modification_time;
+        is_refreshed = true;
+    }
+
+    return true;
+}
+
+/// Recovers the path to the cooked version of an asset if it is up to date.
+/// \param manifest_path Path to the asset's manifest.
+/// \param type Type of the asset.
+/// \return Path to the cooked asset if valid, std::nullopt otherwise.
+std::optional<FilePath> find_cooked_asset(FilePath const& manifest_path, AssetType type)
+{
+    try {
+        std::optional<Manifest> manifest = read_manifest(manifest_path);
+        bool is_refreshed = false;
+
+        if (!manifest.has_value() || !validate_manifest(*manifest, is_refreshed)) {
+            return std::nullopt;
+        }
+
+        FilePath cooked_path = recover_cooked_path(manifest->key, type);
+
+        if (!FileUtils::is_readable(cooked_path)) {
+            return std::nullopt;
+        }
+
+        if (is_refreshed) {
+            write_manifest(manifest_path, *manifest);
+        }
+
+        return cooked_path;
+    }
+    catch (std::exception const& exception) {
+        Log::vwarning(
+            "[AssetCache] Invalid manifest '{}', the asset is cooked again: {}", manifest_path, exception.what()
+        );
+        return std::nullopt;
+    }
+}
+
+/// Creates the manifest of a freshly cooked asset from the dependencies recorded while loading it.
+/// \param dependencies Files the asset depends on.
+/// \param settings_hash Hash of the asset's import settings.
+/// \return Manifest of the asset.
+Manifest create_manifest(std::vector<FilePath> const& dependencies, uint64_t settings_hash)
+{
+    Manifest manifest;
+    manifest.dependencies.reserve(dependencies.size());
+
+    for (FilePath const& dependency : dependencies) {
+        if (FileUtils::is_readable(dependency)) {
+            manifest.dependencies.emplace_back(create_dependency(dependency));
+        }
+    }
+
+    manifest.key = compute_key(settings_hash, manifest.dependencies);
+
+    return manifest;
+}
+
+Image load_cooked_image(FilePath const& cooked_path)
+{
+    ZoneScopedN("[AssetCache]::load_cooked_image");
+
+    MappedFile const file(cooked_path);
+    Reader reader(file);
+
+    auto const header = reader.read_value<ImageHeader>();
+
+    if (header.magic != image_magic_number || header.version != cache_version) {
+        throw std::runtime_error("[AssetCache] '" + cooked_path + "' is not a valid cooked image");
+    }
+
+    Vector2ui const size(header.width, header.height);
+    auto const colorspace = static_cast<ImageColorspace>(header.colorspace);
+    auto const data_type = static_cast<ImageDataType>(header.data_type);
+    size_t const value_count =
+        static_cast<size_t>(size.x) * size.y * Image(colorspace, data_type).get_channel_count();
+
+    // The values are directly read into a pooled buffer, which is then moved into the image
+    if (data_type == ImageDataType::FLOAT) {
+        std::vector<float> values = ImageBufferPool::acquire_floats(value_count);
+        reader.read_bytes(values.data(), value_count * sizeof(float));
+
+        return Image(size, colorspace, std::move(values));
+    }
+
+    std::vector<uint8_t> values = ImageBufferPool::acquire_bytes(value_count);
+    reader.read_bytes(values.data(), value_count);
+
+    return Image(size, colorspace, std::move(values));
+}
+
+void save_cooked_image(FilePath const& cooked_path, Image const& image)
+{
+    ZoneScopedN("[AssetCache]::save_cooked_image");
+
+    ImageHeader header{};
+    header.magic = image_magic_number;
+    header.version = cache_version;
+    header.width = image.get_width();
+    header.height = image.get_height();
+    header.colorspace = static_cast<uint32_t>(image.get_colorspace());
+    header.data_type = static_cast<uint32_t>(image.get_data_type());
+
+    size_t const data_size = static_cast<size_t>(image.get_width()) * image.get_height() * image.get_channel_count() *
+                             (image.get_data_type() == ImageDataType::FLOAT ? sizeof(float) : sizeof(uint8_t));
+
+    std::vector<uint8_t> buffer;
+    buffer.reserve(sizeof(ImageHeader) + data_size);
+    write_value(buffer, header);
+
+    auto const* image_data = static_cast<uint8_t const*>(image.data());
+    buffer.insert(buffer.end(), image_data, image_data + data_size);
+
+    write_file(cooked_path, buffer);
+}
+
+/// Loads an image from its source file & cooks it.
+/// \param filepath Path to the source image.
+/// \param flip_vertically Flip vertically the image when loading.
+/// \param settings_hash Hash of the image's import settings.
+/// \param manifest_path Path to the image's manifest.
+/// \return Loaded image.
+Image cook_image(FilePath const& filepath, bool flip_vertically, uint64_t settings_hash, FilePath const& manifest_path)
+{
+    ZoneScopedN("[AssetCache]::cook_image");
+
+    Image image = ImageFormat::load(filepath, flip_vertically);
+
+    try {
+        Manifest const manifest = create_manifest({filepath}, settings_hash);
+        save_cooked_image(recover_cooked_path(manifest.key, AssetType::IMAGE), image);
+        write_manifest(manifest_path, manifest);
+
+        ++cooked_count;
+    }
+    catch (std::exception const& exception) {
+        Log::vwarning("[AssetCache] Failed to cook the image '{}': {}", filepath, exception.what());
+    }
+
+    return image;
+}
+} // namespace
+
+void set_directory(FilePath const& directory)
+{
+    cache_directory = directory;
+}
+
+FilePath const& get_directory()
+{
+    return cache_directory;
+}
+
+void enable(bool enabled)
+{
+    cache_enabled = enabled;
+}
+
+void disable()
+{
+    enable(false);
+}
+
+bool is_enabled()
+{
+    return cache_enabled;
+}
+
+Statistics get_statistics()
+{
+    return Statistics{hit_count, miss_count, cooked_count};
+}
+
+void reset_statistics()
+{
+    hit_count = 0;
+    miss_count = 0;
+    cooked_count = 0;
+}
+
+void add_dependency(FilePath const& filepath)
+{
+    if (recorded_dependencies == nullptr ||
+        std::find(recorded_dependencies->cbegin(), recorded_dependencies->cend(), filepath) !=
+            recorded_dependencies->cend()) {
+        return;
+    }
+
+    recorded_dependencies->emplace_back(filepath);
+}
+
+std::pair<Mesh, MeshRendererData> load_mesh(FilePath const& filepath)
+{
+    ZoneScopedN("AssetCache::load_mesh");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    std::string const file_extension = StrUtils::to_lower_copy(filepath.recover_extension().to_utf8());
+
+    if (file_extension != "obj" && file_extension != "gltf" && file_extension != "glb") {
+        throw std::invalid_argument("[AssetCache] Unsupported mesh file extension '" + file_extension + '\'');
+    }
+
+    auto const load_source = [&filepath, &file_extension]() {
+        return (file_extension == "obj" ? ObjFormat::load(filepath) : GltfFormat::load(filepath));
+    };
+
+    if (!cache_enabled) {
+        return load_source();
+    }
+
+    uint64_t const settings_hash = compute_settings_hash(AssetType::MESH, false);
+    FilePath const manifest_path = recover_manifest_path(filepath, settings_hash);
+
+    if (std::optional<FilePath> const cooked_path = find_cooked_asset(manifest_path, AssetType::MESH)) {
+        try {
+            std::pair<Mesh, MeshRendererData> loaded_data = XmeshFormat::load(*cooked_path);
+            ++hit_count;
+
+            Log::debug("[AssetCache] Loaded cooked mesh ('" + *cooked_path + "')");
+
+            return loaded_data;
+        }
+        catch (std::exception const& exception) {
+            Log::vwarning("[AssetCache] Invalid cooked mesh, cooking it again: {}", exception.what());
+        }
+    }
+
+    ++miss_count;
+
+    DependencyRecorder recorder(filepath);
+    std::pair<Mesh, MeshRendererData> loaded_data = load_source();
+
+    try {
+        ZoneScopedN("[AssetCache]::cook_mesh");
+
+        Manifest const manifest = create_manifest(recorder.get_dependencies(), settings_hash);
+        XmeshFormat::save(recover_cooked_path(manifest.key, AssetType::MESH), loaded_data.first, &loaded_data.second);
+        write_manifest(manifest_path, manifest);
+
+        ++cooked_count;
+
+        Log::vdebug("[AssetCache] Cooked mesh '{}' ({} dependencies)", filepath, manifest.dependencies.size());
+    }
+    catch (std::exception const& exception) {
+        Log::vwarning("[AssetCache] Failed to cook the mesh '{}': {}", filepath, exception.what());
+    }
+
+    return loaded_data;
+}
+
+Image load_image(FilePath const& filepath, bool flip_vertically)
+{
+    ZoneScopedN("AssetCache::load_image");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    if (!cache_enabled) {
+        return ImageFormat::load(filepath, flip_vertically);
+    }
+
+    uint64_t const settings_hash = compute_settings_hash(AssetType::IMAGE, flip_vertically);
+    FilePath const manifest_path = recover_manifest_path(filepath, settings_hash);
+
+    if (std::optional<FilePath> const cooked_path = find_cooked_asset(manifest_path, AssetType::IMAGE)) {
+        try {
+            Image image = load_cooked_image(*cooked_path);
+            ++hit_count;
+            return image;
+        }
+        catch (std::exception const& exception) {
+            Log::vwarning("[AssetCache] Invalid cooked image, cooking it again: {}", exception.what());
+        }
+    }
+
+    ++miss_count;
+
+    return cook_image(filepath, flip_vertically, settings_hash, manifest_path);
+}
+
+void cook_in_background(std::vector<FilePath> filepaths)
+{
+    ZoneScopedN("AssetCache::cook_in_background");
+
+    if (!cache_enabled) {
+        return;
+    }
+
+    for (FilePath& filepath : filepaths) {
+        {
+            std::lock_guard<std::mutex> const lock(background_mutex);
+            ++background_task_count;
+        }
+
+        auto cook_task = [filepath = std::move(filepath)]() {
+            ZoneScopedN("[AssetCache]::cook_task");
+
+            try {
+                AssetType const type = recover_asset_type(filepath);
+                uint64_t const settings_hash = compute_settings_hash(type, false);
+                FilePath const manifest_path = recover_manifest_path(filepath, settings_hash);
+
+                if (!find_cooked_asset(manifest_path, type).has_value()) {
+                    if (type == AssetType::IMAGE) {
+                        cook_image(filepath, false, settings_hash, manifest_path);
+                    }
+                    else {
+                        Log::debug("[AssetCache] Mesh '" + filepath + "' is outdated; it is cooked on its next load");
+                    }
+                }
+            }
+            catch (std::exception const& exception) {
+                Log::vwarning("[AssetCache] Failed to cook '{}' in the background: {}", filepath, exception.what());
+            }
+
+            std::lock_guard<std::mutex> const lock(background_mutex);
+            --background_task_count;
+            background_condition.notify_all();
+        };
+
+#if defined(XEN_THREADS_AVAILABLE) && !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
+        get_default_thread_pool().add_task(std::move(cook_task));
+#else
+        cook_task();
+#endif
+    }
+}
+
+void wait_for_background_cooking()
+{
+    ZoneScopedN("AssetCache::wait_for_background_cooking");
+
+    std::unique_lock<std::mutex> lock(background_mutex);
+    background_condition.wait(lock, []() { return (background_task_count == 0); });
+}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+namespace xen {
+class FilePath;
+class Image;
+class Mesh;
+class MeshRendererData;
+
+/// Content-addressed asset cache. Source assets are cooked on their first load into formats which are faster to load
+/// (XMESH files for meshes, raw pixels for images) & stored in the cache directory, named after a hash of the content
+/// of all the files they depend on & of the import settings; identical sources thus share their cooked output.
+/// Each source is associated with a manifest listing its dependencies (e.g. OBJ -> MTL -> textures) along with their
+/// size, modification time & content hash. A dependency whose size or modification time has changed is hashed again,
+/// the asset being cooked anew only if its content actually differs.
+/// Meshes loaded by MeshFormat::load() go through the cache while it is enabled.
+namespace AssetCache {
+struct Statistics {
+    size_t hit_count = 0;    ///< Number of loads served by a valid cooked asset.
+    size_t miss_count = 0;   ///< Number of loads for which the asset had to be cooked.
+    size_t cooked_count = 0; ///< Number of assets cooked, either when loading them or in the background.
+};
+
+/// Sets the directory in which cooked assets are stored. It will be created if it does not exist.
+/// \param directory Path to the cache directory.
+void set_directory(FilePath const& directory);
+
+/// Gets the directory in which cooked assets are stored.
+/// \return Path to the cache directory; "cache/assets" by default.
+FilePath const& get_directory();
+
+/// Enables or disables the cache. If disabled, assets are always loaded from their sources.
+/// \param enabled True to cook & load assets from the cache, false otherwise.
+void enable(bool enabled = true);
+
+void disable();
+
+[[nodiscard]] bool is_enabled();
+
+/// Gets the hit & miss statistics since the start or the last reset.
+/// \return Cache statistics.
+[[nodiscard]] Statistics get_statistics();
+
+void reset_statistics();
+
+/// Declares a file read while cooking the current asset, for it to be cooked again when the file changes. Called by
+///   the loaders; does nothing if no asset is being cooked by the calling thread.
+/// \param filepath Path to the dependency.
+void add_dependency(FilePath const& filepath);
+
+/// Loads a mesh from the cache, cooking it from its source file if needed.
+/// \param filepath Path to the source mesh file (OBJ or glTF).
+/// \return Pair containing respectively the mesh's data (vertices & indices) and rendering information (materials,
+/// textures, ...).
+std::pair<Mesh, MeshRendererData> load_mesh(FilePath const& filepath);
+
+/// Loads an image from the cache, cooking it from its source file if needed.
+/// \param filepath Path to the source image file.
+/// \param flip_vertically Flip vertically the image when loading.
+/// \return Loaded image.
+Image load_image(FilePath const& filepath, bool flip_vertically = false);
+
+/// Checks on the default thread pool whether the given assets are up to date, cooking the outdated images in the
+///   background. Meshes cannot be cooked from worker threads, since doing so creates graphics resources; outdated ones
+///   are cooked on their next load.
+/// \param filepaths Paths to the source assets to be checked.
+void cook_in_background(std::vector<FilePath> filepaths);
+
+/// Waits for all the background tasks started by cook_in_background() to be finished.
+void wait_for_background_cooking();
+}
+}
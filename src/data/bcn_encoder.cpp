@@ -0,0 +1,492 @@
+#include "bcn_encoder.hpp"
+
+#include <data/image.hpp>
+#include <data/image_processing.hpp>
+#include <utils/threading.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace xen::BcnEncoder {
+namespace {
+/// 4x4 block of RGBA pixels, stored row by row.
+using PixelBlock = std::array<uint8_t, 16 * 4>;
+
+/// Interpolation weights of BC7's 4-bit indices.
+constexpr std::array<int, 16> bc7_weights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+std::vector<uint8_t> expand_to_rgba(Image const& image)
+{
+    ZoneScopedN("[BcnEncoder]::expand_to_rgba");
+
+    size_t const pixel_count = static_cast<size_t>(image.get_width()) * image.get_height();
+    uint8_t const channel_count = image.get_channel_count();
+    auto const* image_data = static_cast<uint8_t const*>(image.data());
+
+    std::vector<uint8_t> rgba_pixels(pixel_count * 4);
+
+    for (size_t pixel_index = 0; pixel_index < pixel_count; ++pixel_index) {
+        uint8_t const* input = image_data + pixel_index * channel_count;
+        uint8_t* output = rgba_pixels.data() + pixel_index * 4;
+
+        switch (channel_count) {
+        case 1:
+            output[0] = input[0];
+            output[1] = input[0];
+            output[2] = input[0];
+            output[3] = 255;
+            break;
+
+        case 2:
+            output[0] = input[0];
+            output[1] = input[1];
+            output[2] = 0;
+            output[3] = 255;
+            break;
+
+        case 3:
+            output[0] = input[0];
+            output[1] = input[1];
+            output[2] = input[2];
+            output[3] = 255;
+            break;
+
+        default:
+            std::copy_n(input, 4, output);
+            break;
+        }
+    }
+
+    return rgba_pixels;
+}
+
+PixelBlock fetch_block(std::vector<uint8_t> const& rgba_pixels, Vector2ui const& size, uint32_t block_x, uint32_t block_y)
+{
+    PixelBlock block{};
+
+    // Blocks overlapping the image's borders are filled by clamping, repeating the border pixels
+    for (uint32_t row = 0; row < 4; ++row) {
+        size_t const height_index = std::min(block_y * 4 + row, size.y - 1);
+
+        for (uint32_t column = 0; column < 4; ++column) {
+            size_t const width_index = std::min(block_x * 4 + column, size.x - 1);
+            std::copy_n(
+                rgba_pixels.data() + (height_index * size.x + width_index) * 4, 4, block.data() + (row * 4 + column) * 4
+            );
+        }
+    }
+
+    return block;
+}
+
+/// Computes the two endpoints of the segment best fitting the block's pixels, along their principal axis.
+/// \tparam N Number of channels to consider, starting from the red one.
+template <size_t N>
+std::pair<std::array<float, N>, std::array<float, N>> compute_endpoints(PixelBlock const& block)
+{
+    std::array<float, N> mean{};
+
+    for (size_t pixel_index = 0; pixel_index < 16; ++pixel_index) {
+        for (size_t channel_index = 0; channel_index < N; ++channel_index) {
+            mean[channel_index] += static_cast<float>(block[pixel_index * 4 + channel_index]);
+        }
+    }
+
+    for (float& value : mean) {
+        value /= 16.f;
+    }
+
+    std::array<float, N * N> covariance{};
+
+    for (size_t pixel_index = 0; pixel_index < 16; ++pixel_index) {
+        std::array<float, N> diff{};
+
+        for (size_t channel_index = 0; channel_index < N; ++channel_index) {
+            diff[channel_index] = static_cast<float>(block[pixel_index * 4 + channel_index]) - mean[channel_index];
+        }
+
+        for (size_t row = 0; row < N; ++row) {
+            for (size_t column = 0; column < N; ++column) {
+                covariance[row * N + column] += diff[row] * diff[column];
+            }
+        }
+    }
+
+    // Recovering the principal axis by power iteration
+    std::array<float, N> axis{};
+    axis.fill(1.f);
+
+    for (size_t iteration = 0; iteration < 8; ++iteration) {
+        std::array<float, N> next_axis{};
+
+        for (size_t row = 0; row < N; ++row) {
+            for (size_t column = 0; column < N; ++column) {
+                next_axis[row] += covariance[row * N + column] * axis[column];
+            }
+        }
+
+        float max_component = 0.f;
+
+        for (float const value : next_axis) {
+            max_component = std::max(max_component, std::abs(value));
+        }
+
+        if (max_component < std::numeric_limits<float>::epsilon()) {
+            return {mean, mean}; // Uniform block, all pixels have the same value
+        }
+
+        for (size_t channel_index = 0; channel_index < N; ++channel_index) {
+            axis[channel_index] = next_axis[channel_index] / max_component;
+        }
+    }
+
+    float axis_length = 0.f;
+
+    for (float const value : axis) {
+        axis_length += value * value;
+    }
+
+    axis_length = std::sqrt(axis_length);
+
+    for (float& value : axis) {
+        value /= axis_length;
+    }
+
+    float min_projection = std::numeric_limits<float>::max();
+    float max_projection = std::numeric_limits<float>::lowest();
+
+    for (size_t pixel_index = 0; pixel_index < 16; ++pixel_index) {
+        float projection = 0.f;
+
+        for (size_t channel_index = 0; channel_index < N; ++channel_index) {
+            projection +=
+                (static_cast<float>(block[pixel_index * 4 + channel_index]) - mean[channel_index]) * axis[channel_index];
+        }
+
+        min_projection = std::min(min_projection, projection);
+        max_projection = std::max(max_projection, projection);
+    }
+
+    // Slightly insetting the endpoints, which reduces the average error since extreme values are rarely the majority
+    float const inset = (max_projection - min_projection) / 16.f;
+    min_projection += inset;
+    max_projection -= inset;
+
+    std::pair<std::array<float, N>, std::array<float, N>> endpoints;
+
+    for (size_t channel_index = 0; channel_index < N; ++channel_index) {
+        endpoints.first[channel_index] =
+            std::clamp(mean[channel_index] + axis[channel_index] * min_projection, 0.f, 255.f);
+        endpoints.second[channel_index] =
+            std::clamp(mean[channel_index] + axis[channel_index] * max_projection, 0.f, 255.f);
+    }
+
+    return endpoints;
+}
+
+uint16_t pack_rgb565(std::array<float, 3> const& color)
+{
+    auto const red = static_cast<uint16_t>(std::clamp(color[0] * 31.f / 255.f + 0.5f, 0.f, 31.f));
+    auto const green = static_cast<uint16_t>(std::clamp(color[1] * 63.f / 255.f + 0.5f, 0.f, 63.f));
+    auto const blue = static_cast<uint16_t>(std::clamp(color[2] * 31.f / 255.f + 0.5f, 0.f, 31.f));
+
+    return static_cast<uint16_t>((red << 11) | (green << 5) | blue);
+}
+
+std::array<int, 3> unpack_rgb565(uint16_t color)
+{
+    int const red = (color >> 11) & 31;
+    int const green = (color >> 5) & 63;
+    int const blue = color & 31;
+
+    return {(red << 3) | (red >> 2), (green << 2) | (green >> 4), (blue << 3) | (blue >> 2)};
+}
+
+/// Encodes the RGB channels of a block into a BC1 color block (8 bytes).
+void encode_color_block(PixelBlock const& block, uint8_t* output)
+{
+    auto const [min_endpoint, max_endpoint] = compute_endpoints<3>(block);
+
+    uint16_t first_color = pack_rgb565(max_endpoint);
+    uint16_t second_color = pack_rgb565(min_endpoint);
+
+    // The first color must be greater than the second one to use the 4-color mode
+    if (first_color < second_color) {
+        std::swap(first_color, second_color);
+    }
+
+    uint32_t indices = 0;
+
+    if (first_color != second_color) {
+        std::array<std::array<int, 3>, 4> palette{};
+        palette[0] = unpack_rgb565(first_color);
+        palette[1] = unpack_rgb565(second_color);
+
+        for (size_t channel_index = 0; channel_index < 3; ++channel_index) {
+            palette[2][channel_index] = (2 * palette[0][channel_index] + palette[1][channel_index] + 1) / 3;
+            palette[3][channel_index] = (palette[0][channel_index] + 2 * palette[1][channel_index] + 1) / 3;
+        }
+
+        for (size_t pixel_index = 0; pixel_index < 16; ++pixel_index) {
+            uint32_t best_index = 0;
+            int best_error = std::numeric_limits<int>::max();
+
+            for (uint32_t palette_index = 0; palette_index < 4; ++palette_index) {
+                int error = 0;
+
+                for (size_t channel_index = 0; channel_index < 3; ++channel_index) {
+                    int const diff = block[pixel_index * 4 + channel_index] - palette[palette_index][channel_index];
+                    error += diff * diff;
+                }
+
+                if (error < best_error) {
+                    best_error = error;
+                    best_index = palette_index;
+                }
+            }
+
+            indices |= best_index << (pixel_index * 2);
+        }
+    }
+
+    output[0] = static_cast<uint8_t>(first_color & 0xFF);
+    output[1] = static_cast<uint8_t>(first_color >> 8);
+    output[2] = static_cast<uint8_t>(second_color & 0xFF);
+    output[3] = static_cast<uint8_t>(second_color >> 8);
+
+    for (size_t byte_index = 0; byte_index < 4; ++byte_index) {
+        output[4 + byte_index] = static_cast<uint8_t>((indices >> (byte_index * 8)) & 0xFF);
+    }
+}
+
+/// Encodes a single channel of a block into an interpolated 8-value block (8 bytes), as used by BC3's alpha & BC5.
+void encode_channel_block(PixelBlock const& block, size_t channel_index, uint8_t* output)
+{
+    int min_value = 255;
+    int max_value = 0;
+
+    for (size_t pixel_index = 0; pixel_index < 16; ++pixel_index) {
+        int const value = block[pixel_index * 4 + channel_index];
+        min_value = std::min(min_value, value);
+        max_value = std::max(max_value, value);
+    }
+
+    output[0] = static_cast<uint8_t>(max_value);
+    output[1] = static_cast<uint8_t>(min_value);
+
+    uint64_t indices = 0;
+
+    if (max_value != min_value) {
+        // Since the first value is greater than the second one, 6 values are interpolated between them
+        std::array<int, 8> palette{};
+        palette[0] = max_value;
+        palette[1] = min_value;
+
+        for (int palette_index = 2; palette_index < 8; ++palette_index) {
+            palette[palette_index] = ((8 - palette_index) * max_value + (palette_index - 1) * min_value + 3) / 7;
+        }
+
+        for (size_t pixel_index = 0; pixel_index < 16; ++pixel_index) {
+            int const value = block[pixel_index * 4 + channel_index];
+
+            uint64_t best_index = 0;
+            int best_error = std::numeric_limits<int>::max();
+
+            for (uint64_t palette_index = 0; palette_index < 8; ++palette_index) {
+                int const error = std::abs(value - palette[palette_index]);
+
+                if (error < best_error) {
+                    best_error = error;
+                    best_index = palette_index;
+                }
+            }
+
+            indices |= best_index << (pixel_index * 3);
+        }
+    }
+
+    for (size_t byte_index = 0; byte_index < 6; ++byte_index) {
+        output[2 + byte_index] = static_cast<uint8_t>((indices >> (byte_index * 8)) & 0xFF);
+    }
+}
+
+/// Quantizes an endpoint to BC7's mode 6 7-bit components, choosing the shared P-bit giving the lowest error.
+/// \return Quantized 7-bit components & P-bit.
+std::pair<std::array<uint32_t, 4>, uint32_t> quantize_bc7_endpoint(std::array<float, 4> const& endpoint)
+{
+    std::pair<std::array<uint32_t, 4>, uint32_t> best_quantization{};
+    float best_error = std::numeric_limits<float>::max();
+
+    for (uint32_t pbit = 0; pbit < 2; ++pbit) {
+        std::array<uint32_t, 4> quantized{};
+        float error = 0.f;
+
+        for (size_t channel_index = 0; channel_index < 4; ++channel_index) {
+            quantized[channel_index] = static_cast<uint32_t>(
+                std::clamp(std::round((endpoint[channel_index] - static_cast<float>(pbit)) / 2.f), 0.f, 127.f)
+            );
+
+            float const diff =
+                static_cast<float>((quantized[channel_index] << 1) | pbit) - endpoint[channel_index];
+            error += diff * diff;
+        }
+
+        if (error < best_error) {
+            best_error = error;
+            best_quantization = {quantized, pbit};
+        }
+    }
+
+    return best_quantization;
+}
+
+/// Encodes a block in BC7's mode 6 (single subset, RGBA 7-bit endpoints with a P-bit each, 4-bit indices).
+void encode_bc7_block(PixelBlock const& block, uint8_t* output)
+{
+    auto const [min_endpoint, max_endpoint] = compute_endpoints<4>(block);
+
+    auto [first_endpoint, first_pbit] = quantize_bc7_endpoint(min_endpoint);
+    auto [second_endpoint, second_pbit] = quantize_bc7_endpoint(max_endpoint);
+
+    std::array<std::array<int, 4>, 16> palette{};
+
+    for (size_t palette_index = 0; palette_index < 16; ++palette_index) {
+        for (size_t channel_index = 0; channel_index < 4; ++channel_index) {
+            auto const first_value = static_cast<int>((first_endpoint[channel_index] << 1) | first_pbit);
+            auto const second_value = static_cast<int>((second_endpoint[channel_index] << 1) | second_pbit);
+            palette[palette_index][channel_index] = ((64 - bc7_weights[palette_index]) * first_value +
+                                                     bc7_weights[palette_index] * second_value + 32) >>
+                                                    6;
+        }
+    }
+
+    std::array<uint32_t, 16> indices{};
+
+    for (size_t pixel_index = 0; pixel_index < 16; ++pixel_index) {
+        int best_error = std::numeric_limits<int>::max();
+
+        for (uint32_t palette_index = 0; palette_index < 16; ++palette_index) {
+            int error = 0;
+
+            for (size_t channel_index = 0; channel_index < 4; ++channel_index) {
+                int const diff = block[pixel_index * 4 + channel_index] - palette[palette_index][channel_index];
+                error += diff * diff;
+            }
+
+            if (error < best_error) {
+                best_error = error;
+                indices[pixel_index] = palette_index;
+            }
+        }
+    }
+
+    // The first pixel's index is stored without its most significant bit, which must then be 0; if it isn't, the
+    // endpoints are swapped & the indices inverted, the weights being symmetric
+    if (indices[0] >= 8) {
+        std::swap(first_endpoint, second_endpoint);
+        std::swap(first_pbit, second_pbit);
+
+        for (uint32_t& index : indices) {
+            index = 15 - index;
+        }
+    }
+
+    std::fill_n(output, 16, 0);
+    size_t bit_offset = 0;
+
+    auto const write_bits = [output, &bit_offset](uint32_t value, size_t bit_count) {
+        for (size_t bit_index = 0; bit_index < bit_count; ++bit_index, ++bit_offset) {
+            if ((value >> bit_index) & 1u) {
+                output[bit_offset / 8] |= static_cast<uint8_t>(1u << (bit_offset % 8));
+            }
+        }
+    };
+
+    write_bits(1u << 6, 7); // Mode 6
+
+    for (size_t channel_index = 0; channel_index < 4; ++channel_index) {
+        write_bits(first_endpoint[channel_index], 7);
+        write_bits(second_endpoint[channel_index], 7);
+    }
+
+    write_bits(first_pbit, 1);
+    write_bits(second_pbit, 1);
+
+    write_bits(indices[0], 3);
+
+    for (size_t pixel_index = 1; pixel_index < 16; ++pixel_index) {
+        write_bits(indices[pixel_index], 4);
+    }
+}
+
+void encode_block(PixelBlock const& block, BlockCompression compression, uint8_t* output)
+{
+    switch (compression) {
+    case BlockCompression::BC1:
+        encode_color_block(block, output);
+        break;
+
+    case BlockCompression::BC3:
+        encode_channel_block(block, 3, output);
+        encode_color_block(block, output + 8);
+        break;
+
+    case BlockCompression::BC5:
+        encode_channel_block(block, 0, output);
+        encode_channel_block(block, 1, output + 8);
+        break;
+
+    case BlockCompression::BC7:
+        encode_bc7_block(block, output);
+        break;
+    }
+}
+}
+
+CompressedImage compress(Image const& image, BlockCompression compression, bool generate_mipmaps)
+{
+    ZoneScopedN("BcnEncoder::compress");
+
+    if (image.empty()) {
+        throw std::invalid_argument("[BcnEncoder] Cannot compress an empty image.");
+    }
+
+    if (image.get_data_type() != ImageDataType::BYTE) {
+        throw std::invalid_argument("[BcnEncoder] Only images with a byte data type can be block-compressed.");
+    }
+
+    Log::vdebug("[BcnEncoder] Compressing {}x{} image...", image.get_width(), image.get_height());
+
+    CompressedImage compressed_image(image.get_size(), compression, (generate_mipmaps ? 0 : 1));
+    size_t const block_size = CompressedImage::recover_block_size(compression);
+
+    // The levels are downsampled before being expanded, sRGB images being filtered in linear space
+    std::vector<Image> const mipmap_images =
+        (generate_mipmaps ? ImageProcessing::generate_mipmaps(image) : std::vector<Image>());
+
+    for (uint32_t level = 0; level < compressed_image.get_mipmap_count(); ++level) {
+        CompressedMipmap const& mipmap = compressed_image.get_mipmaps()[level];
+        std::vector<uint8_t> const level_pixels = expand_to_rgba(level == 0 ? image : mipmap_images[level - 1]);
+        Vector2ui const& level_size = mipmap.size;
+
+        uint32_t const block_count_x = (level_size.x + 3) / 4;
+        uint32_t const block_count_y = (level_size.y + 3) / 4;
+        uint8_t* const level_data = compressed_image.data() + mipmap.data_offset;
+
+        parallelize(0u, block_count_y, [&](IndexRange const& range) {
+            ZoneScopedN("BcnEncoder::compress");
+
+            for (size_t block_y = range.begin_index; block_y < range.end_index; ++block_y) {
+                for (uint32_t block_x = 0; block_x < block_count_x; ++block_x) {
+                    PixelBlock const block =
+                        fetch_block(level_pixels, level_size, block_x, static_cast<uint32_t>(block_y));
+                    encode_block(block, compression, level_data + (block_y * block_count_x + block_x) * block_size);
+                }
+            }
+        });
+    }
+
+    Log::debug("[BcnEncoder] Compressed image");
+
+    return compressed_image;
+}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <data/compressed_image.hpp>
+
+namespace xen {
+class Image;
+
+namespace BcnEncoder {
+/// Compresses an image into 4x4 blocks, optionally generating & compressing its whole mipmap chain. Blocks are encoded
+/// in parallel on the default thread pool.
+/// \note Gray images are replicated into all three color channels, and gray-alpha images are considered as RG ones.
+/// \note BC7 blocks are all encoded using the single-subset RGBA mode (mode 6).
+/// \param image Image to be compressed. Must have a byte data type.
+/// \param compression Block compression format to encode the image into.
+/// \param generate_mipmaps True to generate & compress all mipmap levels, false to only compress the base level.
+/// \return Compressed image.
+CompressedImage compress(Image const& image, BlockCompression compression, bool generate_mipmaps = true);
+}
+}
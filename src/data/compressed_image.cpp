@@ -0,0 +1,73 @@
+#include "compressed_image.hpp"
+
+#include <bit>
+
+namespace xen {
+CompressedImage::CompressedImage(Vector2ui const& size, BlockCompression compression, uint32_t mipmap_count) :
+    compression{compression}
+{
+    compute_mipmaps(size, (mipmap_count == 0 ? compute_full_mipmap_count(size) : mipmap_count));
+    owned_data.resize(get_data_size());
+}
+
+uint8_t* CompressedImage::data()
+{
+    Log::rt_assert(mapped_file.empty(), "Error: A memory-mapped compressed image cannot be written to.");
+    return owned_data.data();
+}
+
+size_t CompressedImage::get_data_size() const
+{
+    return (mipmaps.empty() ? 0 : mipmaps.back().data_offset + mipmaps.back().data_size);
+}
+
+uint8_t const* CompressedImage::recover_mipmap_data(uint32_t level) const
+{
+    Log::rt_assert(level < mipmaps.size(), "Error: The given mipmap level is invalid.");
+    return data() + mipmaps[level].data_offset;
+}
+
+void CompressedImage::set_mapped_data(
+    MappedFile&& mapped_file, size_t data_offset, Vector2ui const& size, BlockCompression compression,
+    uint32_t mipmap_count
+)
+{
+    this->compression = compression;
+    compute_mipmaps(size, mipmap_count);
+
+    if (data_offset + get_data_size() > mapped_file.size()) {
+        throw std::invalid_argument("[CompressedImage] The mapped file is too small to hold the image's blocks");
+    }
+
+    owned_data.clear();
+    owned_data.shrink_to_fit();
+
+    this->mapped_file = std::move(mapped_file);
+    mapped_data = this->mapped_file.data() + data_offset;
+}
+
+uint32_t CompressedImage::compute_full_mipmap_count(Vector2ui const& size)
+{
+    uint32_t const max_dimension = std::max(size.x, size.y);
+    return static_cast<uint32_t>(std::numeric_limits<uint32_t>::digits - std::countl_zero(max_dimension));
+}
+
+void CompressedImage::compute_mipmaps(Vector2ui const& size, uint32_t mipmap_count)
+{
+    mipmaps.clear();
+    mipmaps.reserve(mipmap_count);
+
+    size_t const block_size = recover_block_size(compression);
+    Vector2ui level_size = size;
+    size_t data_offset = 0;
+
+    for (uint32_t level = 0; level < mipmap_count; ++level) {
+        size_t const data_size =
+            static_cast<size_t>((level_size.x + 3) / 4) * static_cast<size_t>((level_size.y + 3) / 4) * block_size;
+        mipmaps.push_back(CompressedMipmap{level_size, data_offset, data_size});
+
+        data_offset += data_size;
+        level_size = Vector2ui(std::max(level_size.x / 2, 1u), std::max(level_size.y / 2, 1u));
+    }
+}
+}
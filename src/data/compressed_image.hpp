@@ -0,0 +1,105 @@
+#pragma once
+
+#include <utils/mapped_file.hpp>
+
+namespace xen {
+/// Block compression formats, all encoding 4x4 pixel blocks.
+enum class BlockCompression : uint8_t {
+    BC1, ///< RGB, 8 bytes per block (DXT1).
+    BC3, ///< RGBA, 16 bytes per block (DXT5); BC1 color block with an interpolated alpha block.
+    BC5, ///< RG, 16 bytes per block; two interpolated single-channel blocks.
+    BC7  ///< RGBA, 16 bytes per block; higher quality than BC1 & BC3 at the cost of a slower encoding.
+};
+
+/// Mipmap level of a compressed image.
+struct CompressedMipmap {
+    Vector2ui size{};      ///< Size in pixels of the mipmap.
+    size_t data_offset{};  ///< Offset in bytes of the mipmap's blocks from the beginning of the image data.
+    size_t data_size{};    ///< Size in bytes of the mipmap's blocks.
+};
+
+/// Block-compressed image, holding all its mipmap levels contiguously. The data can either be owned by the image or be
+/// directly read from a memory-mapped file.
+class CompressedImage {
+public:
+    CompressedImage() = default;
+    /// Creates a compressed image with allocated (but uninitialized) blocks for the given amount of mipmaps.
+    /// \param size Size in pixels of the base level.
+    /// \param compression Block compression format.
+    /// \param mipmap_count Number of mipmap levels to allocate, including the base level. If 0, the full mipmap chain
+    ///   down to 1x1 will be allocated.
+    CompressedImage(Vector2ui const& size, BlockCompression compression, uint32_t mipmap_count = 1);
+    CompressedImage(CompressedImage const&) = delete;
+    CompressedImage(CompressedImage&&) noexcept = default;
+
+    CompressedImage& operator=(CompressedImage const&) = delete;
+    CompressedImage& operator=(CompressedImage&&) noexcept = default;
+
+    [[nodiscard]] Vector2ui get_size() const { return (mipmaps.empty() ? Vector2ui(0) : mipmaps.front().size); }
+
+    [[nodiscard]] uint32_t get_width() const { return get_size().x; }
+
+    [[nodiscard]] uint32_t get_height() const { return get_size().y; }
+
+    [[nodiscard]] BlockCompression get_compression() const { return compression; }
+
+    [[nodiscard]] std::vector<CompressedMipmap> const& get_mipmaps() const { return mipmaps; }
+
+    [[nodiscard]] uint32_t get_mipmap_count() const { return static_cast<uint32_t>(mipmaps.size()); }
+
+    [[nodiscard]] uint8_t const* data() const { return (mapped_file.empty() ? owned_data.data() : mapped_data); }
+
+    /// Gets the blocks' data to be written to.
+    /// \note The image must own its data, which is not the case if it has been memory-mapped.
+    /// \return Pointer to the beginning of the writable data.
+    uint8_t* data();
+
+    /// Gets the total size in bytes of all mipmaps' blocks.
+    /// \return Size of the image data.
+    [[nodiscard]] size_t get_data_size() const;
+
+    /// Checks if the image doesn't contain data.
+    /// \return True if the image has no data, false otherwise.
+    [[nodiscard]] bool empty() const { return (mipmaps.empty() || data() == nullptr); }
+
+    /// Gets the blocks of the given mipmap level.
+    /// \param level Mipmap level to recover the data of. Must be lower than the mipmap count.
+    /// \return Pointer to the beginning of the level's blocks.
+    [[nodiscard]] uint8_t const* recover_mipmap_data(uint32_t level) const;
+
+    /// Makes the image point to blocks living in a memory-mapped file, which will be kept alive by the image.
+    /// \param mapped_file Memory-mapped file containing the blocks.
+    /// \param data_offset Offset in bytes of the first mipmap's blocks in the file.
+    /// \param size Size in pixels of the base level.
+    /// \param compression Block compression format.
+    /// \param mipmap_count Number of mipmap levels stored in the file, including the base level.
+    void set_mapped_data(
+        MappedFile&& mapped_file, size_t data_offset, Vector2ui const& size, BlockCompression compression,
+        uint32_t mipmap_count
+    );
+
+    /// Gets the size in bytes of a 4x4 block for the given compression format.
+    /// \param compression Compression format to get the block size of.
+    /// \return Size in bytes of a single block.
+    static constexpr size_t recover_block_size(BlockCompression compression)
+    {
+        return (compression == BlockCompression::BC1 ? 8 : 16);
+    }
+
+    /// Computes the number of mipmap levels needed to reach a 1x1 level from the given size.
+    /// \param size Size of the base level.
+    /// \return Number of mipmap levels, including the base level.
+    static uint32_t compute_full_mipmap_count(Vector2ui const& size);
+
+private:
+    BlockCompression compression{};
+    std::vector<CompressedMipmap> mipmaps{};
+
+    std::vector<uint8_t> owned_data{};
+    MappedFile mapped_file{};
+    uint8_t const* mapped_data{};
+
+private:
+    void compute_mipmaps(Vector2ui const& size, uint32_t mipmap_count);
+};
+}
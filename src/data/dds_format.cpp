@@ -0,0 +1,258 @@
+#include "dds_format.hpp"
+
+#include <data/compressed_image.hpp>
+#include <utils/filepath.hpp>
+#include <utils/mapped_file.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace xen::DdsFormat {
+namespace {
+// See: https://learn.microsoft.com/en-us/windows/win32/direct3ddds/dds-header
+
+constexpr uint32_t magic_number = 0x20534444;   // "DDS "
+constexpr size_t header_size = 124;             // Size of DDS_HEADER
+constexpr size_t dx10_header_size = 20;         // Size of DDS_HEADER_DXT10
+constexpr size_t pixel_format_offset = 4 + 72; // Position of DDS_PIXELFORMAT from the beginning of the file
+
+constexpr uint32_t header_flags = 0x1 /* CAPS */ | 0x2 /* HEIGHT */ | 0x4 /* WIDTH */ | 0x1000 /* PIXELFORMAT */ |
+                                  0x20000 /* MIPMAPCOUNT */ | 0x80000 /* LINEARSIZE */;
+constexpr uint32_t pixel_format_fourcc_flag = 0x4;
+/// Maximum width & height of the images, largely above what graphics cards support. This prevents corrupt headers from
+///   overflowing the blocks' dimensions, or from causing huge allocations before the file's size is checked.
+constexpr uint32_t max_dimension = 1u << 16u;
+constexpr uint32_t caps_texture = 0x1000;
+constexpr uint32_t caps_complex = 0x8;
+constexpr uint32_t caps_mipmap = 0x400000;
+
+constexpr uint32_t make_fourcc(char const (&code)[5])
+{
+    return static_cast<uint32_t>(code[0]) | (static_cast<uint32_t>(code[1]) << 8u) |
+           (static_cast<uint32_t>(code[2]) << 16u) | (static_cast<uint32_t>(code[3]) << 24u);
+}
+
+constexpr uint32_t fourcc_dxt1 = make_fourcc("DXT1");
+constexpr uint32_t fourcc_dxt5 = make_fourcc("DXT5");
+constexpr uint32_t fourcc_ati2 = make_fourcc("ATI2");
+constexpr uint32_t fourcc_bc5u = make_fourcc("BC5U");
+constexpr uint32_t fourcc_dx10 = make_fourcc("DX10");
+
+enum DxgiFormat : uint32_t {
+    BC1_UNORM = 71,
+    BC1_UNORM_SRGB = 72,
+    BC3_UNORM = 77,
+    BC3_UNORM_SRGB = 78,
+    BC5_UNORM = 83,
+    BC7_UNORM = 98,
+    BC7_UNORM_SRGB = 99
+};
+
+constexpr uint32_t dx10_dimension_texture_2d = 3;
+
+inline uint32_t read_little_endian32(uint8_t const* data)
+{
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8u) |
+           (static_cast<uint32_t>(data[2]) << 16u) | (static_cast<uint32_t>(data[3]) << 24u);
+}
+
+constexpr std::array<char, 4> to_little_endian32(uint32_t val)
+{
+    return {
+        static_cast<char>(val & 0xFFu), static_cast<char>((val >> 8u) & 0xFFu), static_cast<char>((val >> 16u) & 0xFFu),
+        static_cast<char>(val >> 24u)
+    };
+}
+
+BlockCompression recover_compression(uint32_t fourcc)
+{
+    switch (fourcc) {
+    case fourcc_dxt1:
+        return BlockCompression::BC1;
+
+    case fourcc_dxt5:
+        return BlockCompression::BC3;
+
+    case fourcc_ati2:
+    case fourcc_bc5u:
+        return BlockCompression::BC5;
+
+    default:
+        break;
+    }
+
+    throw std::invalid_argument("[DdsFormat] Unsupported DDS pixel format");
+}
+
+BlockCompression recover_dxgi_compression(uint32_t dxgi_format)
+{
+    switch (dxgi_format) {
+    case BC1_UNORM:
+    case BC1_UNORM_SRGB:
+        return BlockCompression::BC1;
+
+    case BC3_UNORM:
+    case BC3_UNORM_SRGB:
+        return BlockCompression::BC3;
+
+    case BC5_UNORM:
+        return BlockCompression::BC5;
+
+    case BC7_UNORM:
+    case BC7_UNORM_SRGB:
+        return BlockCompression::BC7;
+
+    default:
+        break;
+    }
+
+    throw std::invalid_argument("[DdsFormat] Unsupported DXGI format");
+}
+}
+
+CompressedImage load(FilePath const& filepath)
+{
+    ZoneScopedN("DdsFormat::load");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[DdsFormat] Loading DDS file ('" + filepath + "')...");
+
+    MappedFile file(filepath);
+
+    if (file.size() < 4 + header_size || read_little_endian32(file.data()) != magic_number ||
+        read_little_endian32(file.data() + 4) != header_size) {
+        throw std::runtime_error("[DdsFormat] '" + filepath + "' is not a valid DDS file");
+    }
+
+    uint8_t const* header = file.data() + 4;
+    uint32_t const height = read_little_endian32(header + 8);
+    uint32_t const width = read_little_endian32(header + 12);
+    uint32_t const mipmap_count = std::max(read_little_endian32(header + 24), 1u);
+
+    if (width == 0 || height == 0 || width > max_dimension || height > max_dimension) {
+        throw std::runtime_error(
+            "[DdsFormat] '" + filepath + "' has invalid dimensions (" + std::to_string(width) + 'x' +
+            std::to_string(height) + ')'
+        );
+    }
+
+    if (mipmap_count > CompressedImage::compute_full_mipmap_count(Vector2ui(width, height))) {
+        throw std::runtime_error(
+            "[DdsFormat] '" + filepath + "' has too many mipmaps (" + std::to_string(mipmap_count) + ')'
+        );
+    }
+
+    uint8_t const* pixel_format = file.data() + pixel_format_offset;
+
+    if ((read_little_endian32(pixel_format + 4) & pixel_format_fourcc_flag) == 0) {
+        throw std::runtime_error("[DdsFormat] Only block-compressed DDS files are supported");
+    }
+
+    uint32_t const fourcc = read_little_endian32(pixel_format + 8);
+    size_t data_offset = 4 + header_size;
+    BlockCompression compression{};
+
+    if (fourcc == fourcc_dx10) {
+        if (file.size() < data_offset + dx10_header_size) {
+            throw std::runtime_error("[DdsFormat] '" + filepath + "' is not a valid DDS file");
+        }
+
+        uint8_t const* dx10_header = file.data() + data_offset;
+
+        if (read_little_endian32(dx10_header + 4) != dx10_dimension_texture_2d ||
+            read_little_endian32(dx10_header + 12) > 1) {
+            throw std::runtime_error("[DdsFormat] Only single 2D textures are supported");
+        }
+
+        compression = recover_dxgi_compression(read_little_endian32(dx10_header));
+        data_offset += dx10_header_size;
+    }
+    else {
+        compression = recover_compression(fourcc);
+    }
+
+    CompressedImage image;
+    image.set_mapped_data(std::move(file), data_offset, Vector2ui(width, height), compression, mipmap_count);
+
+    Log::vdebug("[DdsFormat] Loaded DDS file ({}x{}, {} mipmap(s))", width, height, mipmap_count);
+
+    return image;
+}
+
+void save(FilePath const& filepath, CompressedImage const& image)
+{
+    ZoneScopedN("DdsFormat::save");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[DdsFormat] Saving DDS file ('" + filepath + "')...");
+
+    if (image.empty()) {
+        throw std::invalid_argument("[DdsFormat] Cannot save an empty image");
+    }
+
+    std::ofstream file(filepath, std::ios_base::binary);
+
+    if (!file) {
+        throw std::invalid_argument(
+            "[DdsFormat] Unable to create a DDS file as '" + filepath + "'; path to file must exist"
+        );
+    }
+
+    bool const has_mipmaps = (image.get_mipmap_count() > 1);
+
+    std::array<uint32_t, header_size / 4> header{};
+    header[0] = header_size;
+    header[1] = header_flags;
+    header[2] = image.get_height();
+    header[3] = image.get_width();
+    header[4] = static_cast<uint32_t>(image.get_mipmaps().front().data_size);
+    header[6] = image.get_mipmap_count();
+
+    // DDS_PIXELFORMAT, starting at the 19th value
+    header[18] = 32;
+    header[19] = pixel_format_fourcc_flag;
+
+    switch (image.get_compression()) {
+    case BlockCompression::BC1:
+        header[20] = fourcc_dxt1;
+        break;
+
+    case BlockCompression::BC3:
+        header[20] = fourcc_dxt5;
+        break;
+
+    case BlockCompression::BC5:
+        header[20] = fourcc_ati2;
+        break;
+
+    case BlockCompression::BC7:
+        header[20] = fourcc_dx10;
+        break;
+    }
+
+    header[26] = caps_texture | (has_mipmaps ? caps_complex | caps_mipmap : 0);
+
+    file.write(to_little_endian32(magic_number).data(), 4);
+
+    for (uint32_t const value : header) {
+        file.write(to_little_endian32(value).data(), 4);
+    }
+
+    if (image.get_compression() == BlockCompression::BC7) {
+        std::array<uint32_t, dx10_header_size / 4> const dx10_header = {
+            BC7_UNORM, dx10_dimension_texture_2d, 0 /* Misc flags */, 1 /* Array size */, 0 /* Misc flags 2 */
+        };
+
+        for (uint32_t const value : dx10_header) {
+            file.write(to_little_endian32(value).data(), 4);
+        }
+    }
+
+    file.write(reinterpret_cast<char const*>(image.data()), static_cast<std::streamsize>(image.get_data_size()));
+
+    if (!file) {
+        throw std::runtime_error("[DdsFormat] Failed to write the DDS file '" + filepath + '\'');
+    }
+
+    Log::debug("[DdsFormat] Saved DDS file");
+}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace xen {
+class CompressedImage;
+class FilePath;
+
+namespace DdsFormat {
+/// Loads a block-compressed image from a DDS file. The file is memory-mapped, its blocks being directly used by the
+/// returned image without any copy.
+/// \note Only BC1 (DXT1), BC3 (DXT5), BC5 (ATI2/BC5U) & BC7 (DX10 header) 2D textures are supported.
+/// \param filepath File from which to load the image.
+/// \return Loaded compressed image.
+CompressedImage load(FilePath const& filepath);
+
+/// Saves a block-compressed image to a DDS file, along with all its mipmap levels.
+/// \param filepath File to which to save the image.
+/// \param image Compressed image to export data from.
+void save(FilePath const& filepath, CompressedImage const& image);
+}
+}
@@ -1,8 +1,8 @@
 #include <data/fbx_format.hpp>
 #include <data/image.hpp>
-#include <data/image_format.hpp>
 #include <data/mesh.hpp>
 #include <render/mesh_renderer.hpp>
+#include <render/texture_cache.hpp>
 #include <utils/filepath.hpp>
 #include <utils/file_utils.hpp>
 
@@ -26,7 +26,7 @@ load_texture(FilePath const& texture_filepath, Color const& default_color, bool
     }
 
     // Always apply a vertical flip to imported textures, since OpenGL maps them upside down
-    return Texture2D::create(ImageFormat::load(texture_filepath, true), true, should_use_srgb);
+    return TextureCache::load(texture_filepath, should_use_srgb, true);
 }
 
 void load_materials(fbxsdk::FbxScene* scene, std::vector<Material>& materials, FilePath const& filepath)
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace xen {
+struct AudioData;
+class AudioStream;
+class FilePath;
+
+namespace FlacFormat {
+/// Loads audio data from a [FLAC](https://en.wikipedia.org/wiki/FLAC) file.
+/// \note Only mono & stereo files of up to 24 bits per sample are supported. Files of up to 16 bits per sample are
+///   decoded to 8 or 16-bit integer samples, others to floating-point ones.
+/// \param filepath File from which to load the audio.
+/// \return Imported audio data.
+AudioData load(FilePath const& filepath);
+
+/// Opens a [FLAC](https://en.wikipedia.org/wiki/FLAC) file to be streamed. The file is memory-mapped, its frames being
+///   decoded only when needed. Seeking uses the file's seek table if any, decoding the frames from the closest point.
+/// \param filepath File from which to stream the audio.
+/// \return Audio stream over the file.
+/// \see StreamedSound
+std::unique_ptr<AudioStream> open_stream(FilePath const& filepath);
+}
+}
@@ -0,0 +1,764 @@
+#include <data/flac_format.hpp>
+#include <audio/audio_data.hpp>
+#include <audio/audio_stream.hpp>
+#include <audio/audio_utils.hpp>
+#include <utils/filepath.hpp>
+#include <utils/file_utils.hpp>
+#include <utils/mapped_file.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <bit>
+
+namespace xen::FlacFormat {
+namespace {
+constexpr uint8_t max_channel_count = 2;
+constexpr uint8_t max_bits_per_sample = 24;
+constexpr uint8_t max_lpc_order = 32;
+
+struct StreamInfo {
+    uint32_t frequency{};
+    uint8_t channel_count{};
+    uint8_t bits_per_sample{};
+    uint64_t frame_count{}; ///< Total number of frames (a sample for every channel); 0 if unknown.
+};
+
+struct SeekPoint {
+    uint64_t frame_index{};
+    uint64_t offset{}; ///< Offset of the audio frame starting with the point's frame, from the first audio frame.
+};
+
+/// Big-endian bit reader over a span of bytes, failing instead of reading past its end.
+class BitReader {
+public:
+    explicit BitReader(std::span<uint8_t const> bit_data) : data{bit_data} {}
+
+    /// Gets the offset of the current byte; the reader is expected to be aligned to a byte boundary.
+    /// \return Offset of the current byte from the beginning of the data.
+    size_t get_byte_offset() const { return bit_offset / 8; }
+
+    void set_byte_offset(size_t byte_offset)
+    {
+        if (byte_offset > data.size()) {
+            throw std::runtime_error("[FlacLoad] Unexpected end of file");
+        }
+
+        bit_offset = byte_offset * 8;
+    }
+
+    bool is_at_end() const { return (bit_offset >= data.size() * 8); }
+
+    /// Reads an unsigned value.
+    /// \param bit_count Number of bits to read, up to 32.
+    /// \return Value read.
+    uint32_t read_bits(uint8_t bit_count)
+    {
+        if (bit_count == 0) {
+            return 0;
+        }
+
+        check_remaining(bit_count);
+
+        auto const value = static_cast<uint32_t>((peek64() << (bit_offset % 8)) >> (64u - bit_count));
+        bit_offset += bit_count;
+
+        return value;
+    }
+
+    /// Reads a two's complement signed value.
+    /// \param bit_count Number of bits to read, up to 32.
+    /// \return Value read.
+    int32_t read_signed_bits(uint8_t bit_count)
+    {
+        if (bit_count == 0) {
+            return 0;
+        }
+
+        auto const shift = static_cast<uint8_t>(32 - bit_count);
+        return (static_cast<int32_t>(read_bits(bit_count) << shift) >> shift);
+    }
+
+    /// Reads a unary-coded value, that is the number of zero bits preceding the next one bit.
+    /// \return Value read.
+    uint32_t read_unary()
+    {
+        uint32_t zero_count = 0;
+
+        while (true) {
+            check_remaining(1);
+
+            auto const bit_shift = static_cast<uint8_t>(bit_offset % 8);
+            auto const available_bit_count =
+                static_cast<uint32_t>(std::min<size_t>(64u - bit_shift, data.size() * 8 - bit_offset));
+            auto const leading_zero_count = static_cast<uint32_t>(std::countl_zero(peek64() << bit_shift));
+
+            if (leading_zero_count < available_bit_count) {
+                bit_offset += leading_zero_count + 1;
+                return zero_count + leading_zero_count;
+            }
+
+            zero_count += available_bit_count;
+            bit_offset += available_bit_count;
+        }
+    }
+
+    void align_to_byte() { bit_offset = (bit_offset + 7) & ~size_t{7}; }
+
+private:
+    std::span<uint8_t const> data;
+    size_t bit_offset = 0;
+
+    void check_remaining(size_t bit_count) const
+    {
+        if (bit_count > data.size() * 8 - bit_offset) {
+            throw std::runtime_error("[FlacLoad] Unexpected end of file");
+        }
+    }
+
+    /// Gets the 8 bytes starting from the current one, in big-endian order; those past the end of the data are zero.
+    uint64_t peek64() const
+    {
+        size_t const byte_index = bit_offset / 8;
+        uint64_t bits = 0;
+
+        if (byte_index + 8 <= data.size()) {
+            std::memcpy(&bits, data.data() + byte_index, 8);
+
+            if constexpr (std::endian::native == std::endian::little) {
+                bits = std::byteswap(bits);
+            }
+
+            return bits;
+        }
+
+        for (size_t index = byte_index; index < byte_index + 8; ++index) {
+            bits = (bits << 8u) | (index < data.size() ? data[index] : 0u);
+        }
+
+        return bits;
+    }
+};
+
+/// Decoder of the audio frames of a memory-mapped FLAC file. See https://www.rfc-editor.org/rfc/rfc9639.html for the
+///   format's specification.
+/// \note The frames' checksums are not verified.
+class FlacDecoder {
+public:
+    explicit FlacDecoder(MappedFile mapped_file) : file{std::move(mapped_file)}, reader{{file.data(), file.size()}}
+    {
+        load_metadata();
+    }
+
+    StreamInfo const& get_info() const { return info; }
+
+    /// Gets the number of frames of the last decoded audio frame.
+    /// \return Number of frames decoded, which can be recovered with get_sample().
+    uint32_t get_block_size() const { return block_size; }
+
+    /// Gets the index of the first frame of the next audio frame to be decoded.
+    /// \return Index of the next frame.
+    uint64_t get_next_frame_index() const { return next_frame_index; }
+
+    int32_t get_sample(uint8_t channel_index, uint32_t frame_index) const
+    {
+        return channel_samples[channel_index][frame_index];
+    }
+
+    /// Decodes the next audio frame.
+    /// \return True if a frame has been decoded, false if the end of the stream has been reached.
+    bool decode_frame()
+    {
+        ZoneScopedN("FlacDecoder::decode_frame");
+
+        block_size = 0;
+
+        if (reader.is_at_end() || (info.frame_count != 0 && next_frame_index >= info.frame_count)) {
+            return false;
+        }
+
+        // Frame header
+
+        if ((reader.read_bits(16) & 0xFFFEu) != 0xFFF8u) {
+            throw std::runtime_error("[FlacLoad] Invalid frame synchronization code");
+        }
+
+        uint32_t const block_size_code = reader.read_bits(4);
+        uint32_t const frequency_code = reader.read_bits(4);
+        uint32_t const channel_assignment = reader.read_bits(4);
+        uint32_t const sample_size_code = reader.read_bits(3);
+        reader.read_bits(1); // Reserved
+
+        // The frame's or first sample's number is coded like an UTF-8 character; only its length matters there
+        auto const coded_number_length =
+            static_cast<uint8_t>(std::countl_one(static_cast<uint8_t>(reader.read_bits(8))));
+
+        for (uint8_t byte_index = 1; byte_index < coded_number_length; ++byte_index) {
+            reader.read_bits(8);
+        }
+
+        uint32_t const frame_block_size = read_block_size(block_size_code);
+
+        if (frequency_code == 12) {
+            reader.read_bits(8);
+        }
+        else if (frequency_code == 13 || frequency_code == 14) {
+            reader.read_bits(16);
+        }
+        else if (frequency_code == 15) {
+            throw std::runtime_error("[FlacLoad] Invalid frame sampling frequency");
+        }
+
+        uint8_t const bits_per_sample = recover_bits_per_sample(sample_size_code);
+
+        reader.read_bits(8); // Header CRC-8
+
+        uint8_t const channel_count = (channel_assignment < 8 ? static_cast<uint8_t>(channel_assignment + 1) : 2);
+
+        if (channel_assignment > 10 || channel_count != info.channel_count) {
+            throw std::runtime_error("[FlacLoad] Invalid frame channel assignment");
+        }
+
+        // Subframes, one per channel
+
+        for (uint8_t channel_index = 0; channel_index < channel_count; ++channel_index) {
+            std::vector<int32_t>& samples = channel_samples[channel_index];
+
+            if (samples.size() < frame_block_size) {
+                samples.resize(frame_block_size);
+            }
+
+            // Side channels hold the difference between the two others, thus requiring an additional bit
+            bool const is_side_channel = (channel_assignment == 8 && channel_index == 1) ||
+                                         (channel_assignment == 9 && channel_index == 0) ||
+                                         (channel_assignment == 10 && channel_index == 1);
+
+            decode_subframe(
+                std::span(samples).first(frame_block_size),
+                static_cast<uint8_t>(bits_per_sample + (is_side_channel ? 1 : 0))
+            );
+        }
+
+        reader.align_to_byte();
+        reader.read_bits(16); // Frame CRC-16
+
+        decorrelate_channels(channel_assignment, frame_block_size);
+
+        block_size = frame_block_size;
+        next_frame_index += frame_block_size;
+
+        return true;
+    }
+
+    /// Moves to the closest audio frame preceding the given frame. get_next_frame_index() then gives the index of the
+    ///   first frame of the audio frame that will be decoded next.
+    /// \param frame_index Index of the frame to go to.
+    void seek(uint64_t frame_index)
+    {
+        SeekPoint closest_point{};
+
+        for (SeekPoint const& seek_point : seek_points) {
+            if (seek_point.frame_index > frame_index) {
+                break;
+            }
+
+            closest_point = seek_point;
+        }
+
+        reader.set_byte_offset(first_frame_offset + closest_point.offset);
+        next_frame_index = closest_point.frame_index;
+        block_size = 0;
+    }
+
+private:
+    MappedFile file;
+    BitReader reader;
+    StreamInfo info{};
+    std::vector<SeekPoint> seek_points; ///< Seek points from the seek table, sorted by frame index.
+    size_t first_frame_offset = 0;      ///< Offset of the first audio frame from the beginning of the file.
+    std::array<std::vector<int32_t>, max_channel_count> channel_samples;
+    uint32_t block_size = 0;
+    uint64_t next_frame_index = 0;
+
+    uint64_t read_bits64()
+    {
+        uint64_t const high_bits = reader.read_bits(32);
+        return ((high_bits << 32u) | reader.read_bits(32));
+    }
+
+    void load_metadata()
+    {
+        if (reader.read_bits(32) != 0x664C6143 /* 'fLaC' */) {
+            throw std::runtime_error("[FlacLoad] Invalid FLAC signature");
+        }
+
+        bool is_last_block = false;
+
+        while (!is_last_block) {
+            is_last_block = (reader.read_bits(1) == 1);
+            uint32_t const block_type = reader.read_bits(7);
+            uint32_t const block_length = reader.read_bits(24);
+            size_t const block_end = reader.get_byte_offset() + block_length;
+
+            if (block_type == 0) { // Stream information
+                reader.read_bits(16); // Minimum block size
+                reader.read_bits(16); // Maximum block size
+                reader.read_bits(24); // Minimum frame size
+                reader.read_bits(24); // Maximum frame size
+                info.frequency = reader.read_bits(20);
+                info.channel_count = static_cast<uint8_t>(reader.read_bits(3) + 1);
+                info.bits_per_sample = static_cast<uint8_t>(reader.read_bits(5) + 1);
+                info.frame_count = (static_cast<uint64_t>(reader.read_bits(4)) << 32u) | reader.read_bits(32);
+                // The remaining 16 bytes hold a MD5 checksum of the decoded audio, which is not verified
+            }
+            else if (block_type == 3) { // Seek table
+                for (uint32_t point_index = 0; point_index < block_length / 18; ++point_index) {
+                    SeekPoint seek_point{};
+                    seek_point.frame_index = read_bits64();
+                    seek_point.offset = read_bits64();
+                    reader.read_bits(16); // Number of frames in the audio frame
+
+                    // Placeholder points have a frame index with all bits set
+                    if (seek_point.frame_index != std::numeric_limits<uint64_t>::max()) {
+                        seek_points.emplace_back(seek_point);
+                    }
+                }
+            }
+
+            // Other blocks (padding, tags, pictures, ...) are ignored
+            reader.set_byte_offset(block_end);
+        }
+
+        first_frame_offset = reader.get_byte_offset();
+
+        if (info.frequency == 0) {
+            throw std::runtime_error("[FlacLoad] No valid stream information block found");
+        }
+
+        if (info.channel_count > max_channel_count) {
+            throw std::runtime_error("[FlacLoad] Only mono & stereo FLAC files are supported");
+        }
+
+        if (info.bits_per_sample > max_bits_per_sample) {
+            throw std::runtime_error(
+                "[FlacLoad] " + std::to_string(info.bits_per_sample) + " bits FLAC files are unsupported"
+            );
+        }
+
+        std::ranges::sort(seek_points, {}, &SeekPoint::frame_index);
+    }
+
+    uint32_t read_block_size(uint32_t block_size_code)
+    {
+        if (block_size_code == 1) {
+            return 192;
+        }
+
+        if (block_size_code >= 2 && block_size_code <= 5) {
+            return (576u << (block_size_code - 2));
+        }
+
+        if (block_size_code == 6) {
+            return reader.read_bits(8) + 1;
+        }
+
+        if (block_size_code == 7) {
+            return reader.read_bits(16) + 1;
+        }
+
+        if (block_size_code >= 8) {
+            return (256u << (block_size_code - 8));
+        }
+
+        throw std::runtime_error("[FlacLoad] Invalid frame block size");
+    }
+
+    uint8_t recover_bits_per_sample(uint32_t sample_size_code) const
+    {
+        switch (sample_size_code) {
+        case 0:
+            return info.bits_per_sample;
+        case 1:
+            return 8;
+        case 2:
+            return 12;
+        case 4:
+            return 16;
+        case 5:
+            return 20;
+        case 6:
+            return 24;
+        default:
+            throw std::runtime_error("[FlacLoad] Unsupported frame sample size");
+        }
+    }
+
+    void decode_subframe(std::span<int32_t> samples, uint8_t bits_per_sample)
+    {
+        if (reader.read_bits(1) != 0) {
+            throw std::runtime_error("[FlacLoad] Invalid subframe header");
+        }
+
+        uint32_t const subframe_type = reader.read_bits(6);
+
+        // Samples may have been shifted to remove bits which are always zero
+        uint32_t const wasted_bit_count = (reader.read_bits(1) == 1 ? reader.read_unary() + 1 : 0);
+
+        if (wasted_bit_count >= bits_per_sample) {
+            throw std::runtime_error("[FlacLoad] Invalid subframe wasted bits count");
+        }
+
+        bits_per_sample = static_cast<uint8_t>(bits_per_sample - wasted_bit_count);
+
+        if (subframe_type == 0) { // Constant
+            std::ranges::fill(samples, reader.read_signed_bits(bits_per_sample));
+        }
+        else if (subframe_type == 1) { // Verbatim
+            for (int32_t& sample : samples) {
+                sample = reader.read_signed_bits(bits_per_sample);
+            }
+        }
+        else if (subframe_type >= 8 && subframe_type <= 12) {
+            decode_fixed_subframe(samples, bits_per_sample, subframe_type - 8);
+        }
+        else if (subframe_type >= 32) {
+            decode_lpc_subframe(samples, bits_per_sample, subframe_type - 31);
+        }
+        else {
+            throw std::runtime_error("[FlacLoad] Invalid subframe type");
+        }
+
+        if (wasted_bit_count > 0) {
+            for (int32_t& sample : samples) {
+                sample = static_cast<int32_t>(static_cast<uint32_t>(sample) << wasted_bit_count);
+            }
+        }
+    }
+
+    void read_warm_up_samples(std::span<int32_t> samples, uint8_t bits_per_sample, uint32_t order)
+    {
+        if (order > samples.size()) {
+            throw std::runtime_error("[FlacLoad] Invalid subframe predictor order");
+        }
+
+        for (uint32_t sample_index = 0; sample_index < order; ++sample_index) {
+            samples[sample_index] = reader.read_signed_bits(bits_per_sample);
+        }
+    }
+
+    void decode_fixed_subframe(std::span<int32_t> samples, uint8_t bits_per_sample, uint32_t order)
+    {
+        read_warm_up_samples(samples, bits_per_sample, order);
+        decode_residual(samples, order);
+
+        // The residuals are added to the predictions, made from polynomials fitting the previous samples
+        switch (order) {
+        case 1:
+            for (size_t i = 1; i < samples.size(); ++i) {
+                samples[i] += samples[i - 1];
+            }
+            break;
+
+        case 2:
+            for (size_t i = 2; i < samples.size(); ++i) {
+                samples[i] += 2 * samples[i - 1] - samples[i - 2];
+            }
+            break;
+
+        case 3:
+            for (size_t i = 3; i < samples.size(); ++i) {
+                samples[i] += 3 * samples[i - 1] - 3 * samples[i - 2] + samples[i - 3];
+            }
+            break;
+
+        case 4:
+            for (size_t i = 4; i < samples.size(); ++i) {
+                samples[i] += 4 * samples[i - 1] - 6 * samples[i - 2] + 4 * samples[i - 3] - samples[i - 4];
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void decode_lpc_subframe(std::span<int32_t> samples, uint8_t bits_per_sample, uint32_t order)
+    {
+        read_warm_up_samples(samples, bits_per_sample, order);
+
+        uint32_t const precision = reader.read_bits(4) + 1;
+        int32_t const shift = reader.read_signed_bits(5);
+
+        if (precision == 16 || shift < 0) {
+            throw std::runtime_error("[FlacLoad] Invalid subframe predictor coefficients");
+        }
+
+        std::array<int32_t, max_lpc_order> coefficients{};
+
+        for (uint32_t coeff_index = 0; coeff_index < order; ++coeff_index) {
+            coefficients[coeff_index] = reader.read_signed_bits(static_cast<uint8_t>(precision));
+        }
+
+        decode_residual(samples, order);
+
+        for (size_t i = order; i < samples.size(); ++i) {
+            int64_t prediction = 0;
+
+            for (uint32_t coeff_index = 0; coeff_index < order; ++coeff_index) {
+                prediction += static_cast<int64_t>(coefficients[coeff_index]) * samples[i - 1 - coeff_index];
+            }
+
+            samples[i] += static_cast<int32_t>(prediction >> shift);
+        }
+    }
+
+    /// Decodes the Rice-coded residuals of a subframe, following its warm-up samples.
+    /// \param samples Samples of the subframe.
+    /// \param order Order of the subframe's predictor, which is also its number of warm-up samples.
+    void decode_residual(std::span<int32_t> samples, uint32_t order)
+    {
+        uint32_t const coding_method = reader.read_bits(2);
+
+        if (coding_method > 1) {
+            throw std::runtime_error("[FlacLoad] Invalid residual coding method");
+        }
+
+        uint8_t const parameter_bit_count = (coding_method == 0 ? 4 : 5);
+        uint32_t const escape_parameter = (1u << parameter_bit_count) - 1;
+
+        uint32_t const partition_order = reader.read_bits(4);
+        size_t const partition_size = samples.size() >> partition_order;
+
+        if ((partition_size << partition_order) != samples.size() || partition_size < order) {
+            throw std::runtime_error("[FlacLoad] Invalid residual partition order");
+        }
+
+        size_t sample_index = order;
+
+        for (uint32_t partition_index = 0; partition_index < (1u << partition_order); ++partition_index) {
+            size_t const partition_end = partition_size * (partition_index + 1);
+            uint32_t const parameter = reader.read_bits(parameter_bit_count);
+
+            if (parameter == escape_parameter) { // Unencoded residuals
+                auto const bit_count = static_cast<uint8_t>(reader.read_bits(5));
+
+                for (; sample_index < partition_end; ++sample_index) {
+                    samples[sample_index] = reader.read_signed_bits(bit_count);
+                }
+
+                continue;
+            }
+
+            for (; sample_index < partition_end; ++sample_index) {
+                uint32_t const quotient = reader.read_unary();
+                uint32_t const value = (quotient << parameter) | reader.read_bits(static_cast<uint8_t>(parameter));
+
+                // Values are zigzag-encoded: 0, -1, 1, -2, 2, ...
+                samples[sample_index] = static_cast<int32_t>(value >> 1u) ^ -static_cast<int32_t>(value & 1u);
+            }
+        }
+    }
+
+    void decorrelate_channels(uint32_t channel_assignment, uint32_t frame_block_size)
+    {
+        std::vector<int32_t>& first_samples = channel_samples[0];
+        std::vector<int32_t>& second_samples = channel_samples[1];
+
+        switch (channel_assignment) {
+        case 8: // Left & side
+            for (uint32_t i = 0; i < frame_block_size; ++i) {
+                second_samples[i] = first_samples[i] - second_samples[i];
+            }
+            break;
+
+        case 9: // Side & right
+            for (uint32_t i = 0; i < frame_block_size; ++i) {
+                first_samples[i] += second_samples[i];
+            }
+            break;
+
+        case 10: // Mid & side
+            for (uint32_t i = 0; i < frame_block_size; ++i) {
+                int32_t const side = second_samples[i];
+                int32_t const mid = static_cast<int32_t>(static_cast<uint32_t>(first_samples[i]) << 1u) | (side & 1);
+
+                first_samples[i] = (mid + side) >> 1;
+                second_samples[i] = (mid - side) >> 1;
+            }
+            break;
+
+        default: // Independent channels
+            break;
+        }
+    }
+};
+
+AudioFormat recover_format(StreamInfo const& info)
+{
+    bool const is_mono = (info.channel_count == 1);
+
+    if (info.bits_per_sample <= 8) {
+        return (is_mono ? AudioFormat::MONO_U8 : AudioFormat::STEREO_U8);
+    }
+
+    if (info.bits_per_sample <= 16) {
+        return (is_mono ? AudioFormat::MONO_I16 : AudioFormat::STEREO_I16);
+    }
+
+    return (is_mono ? AudioFormat::MONO_F32 : AudioFormat::STEREO_F32);
+}
+
+/// Audio stream decoding a FLAC file's frames from its mapping, as they are requested.
+class FlacStream final : public AudioStream {
+public:
+    explicit FlacStream(MappedFile file) : decoder(std::move(file))
+    {
+        StreamInfo const& info = decoder.get_info();
+
+        format = recover_format(info);
+        frequency = info.frequency;
+        frame_count = info.frame_count;
+        frame_size = AudioUtils::recover_frame_size(format);
+    }
+
+    size_t read(std::span<uint8_t> buffer) override
+    {
+        ZoneScopedN("FlacStream::read");
+
+        size_t const capacity = buffer.size() / frame_size;
+        size_t written_frame_count = 0;
+
+        while (written_frame_count < capacity) {
+            if (block_position >= decoder.get_block_size()) {
+                if (!decoder.decode_frame()) {
+                    break;
+                }
+
+                block_position = 0;
+            }
+
+            auto const copied_frame_count = static_cast<uint32_t>(
+                std::min<size_t>(capacity - written_frame_count, decoder.get_block_size() - block_position)
+            );
+            write_frames(copied_frame_count, buffer.data() + written_frame_count * frame_size);
+
+            block_position += copied_frame_count;
+            written_frame_count += copied_frame_count;
+        }
+
+        return written_frame_count * frame_size;
+    }
+
+    void seek(uint64_t frame_index) override
+    {
+        ZoneScopedN("FlacStream::seek");
+
+        decoder.seek(frame_index);
+        block_position = 0;
+
+        // Audio frames are decoded from the closest seek point until reaching the one containing the requested frame
+        while (decoder.decode_frame()) {
+            if (decoder.get_next_frame_index() > frame_index) {
+                block_position =
+                    static_cast<uint32_t>(frame_index - (decoder.get_next_frame_index() - decoder.get_block_size()));
+                return;
+            }
+        }
+    }
+
+private:
+    FlacDecoder decoder;
+    uint8_t frame_size{};
+    uint32_t block_position = 0; ///< Index of the next frame to be read in the last decoded audio frame.
+
+    /// Writes the next decoded frames into the given buffer, converted to the stream's format.
+    /// \param write_frame_count Number of frames to be written.
+    /// \param output Buffer to write the frames into.
+    void write_frames(uint32_t write_frame_count, uint8_t* output) const
+    {
+        uint8_t const bits_per_sample = decoder.get_info().bits_per_sample;
+        uint8_t const channel_count = decoder.get_info().channel_count;
+
+        for (uint32_t frame_index = block_position; frame_index < block_position + write_frame_count; ++frame_index) {
+            for (uint8_t channel_index = 0; channel_index < channel_count; ++channel_index) {
+                int32_t const sample = decoder.get_sample(channel_index, frame_index);
+
+                if (bits_per_sample <= 8) {
+                    *output = static_cast<uint8_t>((sample << (8 - bits_per_sample)) + 128);
+                    output += 1;
+                }
+                else if (bits_per_sample <= 16) {
+                    auto const value = static_cast<int16_t>(sample << (16 - bits_per_sample));
+                    std::memcpy(output, &value, sizeof(value));
+                    output += sizeof(value);
+                }
+                else {
+                    float const value = static_cast<float>(sample) / static_cast<float>(1u << (bits_per_sample - 1));
+                    std::memcpy(output, &value, sizeof(value));
+                    output += sizeof(value);
+                }
+            }
+        }
+    }
+};
+
+MappedFile map_flac(FilePath const& filepath)
+{
+    if (!FileUtils::is_readable(filepath)) {
+        throw std::invalid_argument("[FlacLoad] Could not open the FLAC file '" + filepath + "'");
+    }
+
+    return MappedFile(filepath);
+}
+} // namespace
+
+AudioData load(FilePath const& filepath)
+{
+    ZoneScopedN("FlacFormat::load");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[FlacLoad] Loading FLAC file ('" + filepath + "')...");
+
+    FlacStream stream(map_flac(filepath));
+
+    AudioData audio_data{};
+    audio_data.format = stream.get_format();
+    audio_data.frequency = stream.get_frequency();
+
+    size_t const frame_size = AudioUtils::recover_frame_size(audio_data.format);
+    audio_data.buffer.resize(std::max<uint64_t>(stream.get_frame_count(), 4096) * frame_size);
+    size_t data_size = 0;
+
+    while (true) {
+        data_size += stream.read(std::span(audio_data.buffer).subspan(data_size));
+
+        // Files which do not give their total number of frames are decoded until their end, growing the buffer
+        if (data_size < audio_data.buffer.size() || stream.get_frame_count() != 0) {
+            break;
+        }
+
+        audio_data.buffer.resize(audio_data.buffer.size() * 2);
+    }
+
+    audio_data.buffer.resize(data_size);
+
+    Log::vdebug("[FlacLoad] Loaded FLAC file ({} frames at {} Hz)", data_size / frame_size, audio_data.frequency);
+
+    return audio_data;
+}
+
+std::unique_ptr<AudioStream> open_stream(FilePath const& filepath)
+{
+    ZoneScopedN("FlacFormat::open_stream");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[FlacLoad] Opening FLAC stream ('" + filepath + "')...");
+
+    auto stream = std::make_unique<FlacStream>(map_flac(filepath));
+
+    Log::vdebug(
+        "[FlacLoad] Opened FLAC stream ({} frames at {} Hz)", stream->get_frame_count(), stream->get_frequency()
+    );
+
+    return stream;
+}
+}
@@ -15,6 +15,13 @@ namespace GltfFormat {
 /// textures, ...).
 std::pair<Mesh, MeshRendererData> load(FilePath const& filepath);
 
+/// Parses a mesh from a glTF or GLB file without creating any graphics resource, which can thus be done from any
+///   thread.
+/// \param filepath File from which to load the mesh.
+/// \return Pair containing respectively the mesh's data and a function loading its materials & creating its rendering
+///   information from it, which must be called from the thread owning the graphics context.
+std::pair<Mesh, std::function<MeshRendererData(Mesh const&)>> parse(FilePath const& filepath);
+
 Rigidbody& create_map_rigidbody_from_mesh(Entity& entity, std::shared_ptr<Mesh> map_mesh);
 }
 }
\ No newline at end of file
@@ -1,12 +1,20 @@
 #include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <data/asset_cache.hpp>
 #include <data/gltf_format.hpp>
 #include <data/image.hpp>
 #include <data/image_format.hpp>
+#include <data/image_processing.hpp>
 #include <data/mesh.hpp>
+#include <data/mesh_optimizer.hpp>
 #include <math/transform/transform.hpp>
 #include <render/mesh_renderer.hpp>
+#include <render/texture_cache.hpp>
 #include <utils/filepath.hpp>
 #include <utils/file_utils.hpp>
+#include <utils/mapped_file.hpp>
+#include <utils/str_utils.hpp>
+#include <utils/threading.hpp>
+#include <utils/virtual_file_system.hpp>
 
 #include "fastgltf/core.hpp"
 #include "fastgltf/math.hpp"
@@ -200,8 +208,7 @@ void load_indices(
     Log::debug("[GltfLoad] Loaded indices");
 }
 
-std::pair<Mesh, MeshRendererData>
-load_meshes(fastgltf::Asset const& asset, std::vector<std::optional<Transform>> const& transforms)
+Mesh load_meshes(fastgltf::Asset const& asset, std::vector<std::optional<Transform>> const& transforms)
 {
     ZoneScopedN("[GltfLoad]::load_meshes");
 
@@ -209,8 +216,8 @@ load_meshes(fastgltf::Asset const& asset, std::vector<std::optional<Transform>>
 
     Log::vdebug("[GltfLoad] Loading {} mesh(es)...", meshes.size());
 
-    Mesh loaded_mesh;
-    MeshRendererData loaded_mesh_renderer;
+    // Each primitive becoming a submesh, they are listed along with the index of the mesh they belong to
+    std::vector<std::pair<size_t, fastgltf::Primitive const*>> primitives;
 
     for (size_t mesh_index = 0; mesh_index < meshes.size(); ++mesh_index) {
         for (fastgltf::Primitive const& primitive : meshes[mesh_index].primitives) {
@@ -218,24 +225,185 @@ load_meshes(fastgltf::Asset const& asset, std::vector<std::optional<Transform>>
                 throw std::invalid_argument("Error: The glTF file requires having indexed geometry.");
             }
 
-            Submesh& submesh = loaded_mesh.add_submesh();
-            SubmeshRenderer& submesh_renderer = loaded_mesh_renderer.add_submesh_renderer();
+            primitives.emplace_back(mesh_index, &primitive);
+        }
+    }
+
+    Mesh loaded_mesh;
+
+    if (primitives.empty()) {
+        return loaded_mesh;
+    }
+
+    loaded_mesh.get_submeshes().resize(primitives.size());
+
+    // The primitives' attributes are extracted in parallel; an exception thrown by a task is rethrown once all are done
+    std::vector<std::exception_ptr> exceptions(primitives.size());
+
+    parallelize(0u, primitives.size(), [&](IndexRange const& range) {
+        for (size_t primitive_index = range.begin_index; primitive_index < range.end_index; ++primitive_index) {
+            ZoneScopedN("[GltfLoad]::load_primitive");
+
+            auto const [mesh_index, primitive] = primitives[primitive_index];
+            Submesh& submesh = loaded_mesh.get_submeshes()[primitive_index];
+
+            try {
+                // Indices must be loaded first as they are needed to compute the tangents if necessary
+                load_indices(asset, asset.accessors[*primitive->indicesAccessor], submesh.get_triangle_indices());
+                load_vertices(asset, *primitive, transforms[mesh_index], submesh);
+
+                if (MeshOptimizer::is_enabled_on_import() && primitive->type == fastgltf::PrimitiveType::Triangles) {
+                    MeshOptimizer::optimize(submesh);
+                }
+            }
+            catch (...) {
+                exceptions[primitive_index] = std::current_exception();
+            }
+        }
+    });
+
+    for (std::exception_ptr const& exception : exceptions) {
+        if (exception != nullptr) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    Log::debug("[GltfLoad] Loaded mesh(es)");
+
+    return loaded_mesh;
+}
+
+/// Sends the geometry of the meshes to the GPU, which must be done from the thread owning the context.
+/// \param asset Asset the meshes have been loaded from.
+/// \param mesh Loaded meshes, holding a submesh for each primitive.
+/// \return Mesh renderer, whose materials remain to be loaded.
+MeshRendererData load_mesh_renderer(fastgltf::Asset const& asset, Mesh const& mesh)
+{
+    ZoneScopedN("[GltfLoad]::load_mesh_renderer");
 
-            // Indices must be loaded first as they are needed to compute the tangents if necessary
-            load_indices(asset, asset.accessors[*primitive.indicesAccessor], submesh.get_triangle_indices());
-            load_vertices(asset, primitive, transforms[mesh_index], submesh);
+    MeshRendererData mesh_renderer;
+    size_t submesh_index = 0;
 
+    for (fastgltf::Mesh const& gltf_mesh : asset.meshes) {
+        for (fastgltf::Primitive const& primitive : gltf_mesh.primitives) {
+            SubmeshRenderer& submesh_renderer = mesh_renderer.add_submesh_renderer();
             submesh_renderer.load(
-                submesh,
+                mesh.get_submeshes()[submesh_index++],
                 (primitive.type == fastgltf::PrimitiveType::Triangles ? RenderMode::TRIANGLE : RenderMode::POINT)
             );
             submesh_renderer.set_material_index(primitive.materialIndex.value_or(0));
         }
     }
 
-    Log::debug("[GltfLoad] Loaded mesh(es)");
+    return mesh_renderer;
+}
+
+/// Maps the buffers stored in external files, which are declared as dependencies of the asset being cooked. The buffers
+///   then reference the mapped files' content, which is thus never copied.
+/// \param buffers Buffers to be loaded.
+/// \param root_filepath Path to the directory containing the glTF file.
+/// \return Mapped files, which must be kept alive as long as the buffers are used.
+std::vector<MappedFile> map_external_buffers(std::vector<fastgltf::Buffer>& buffers, FilePath const& root_filepath)
+{
+    ZoneScopedN("[GltfLoad]::map_external_buffers");
+
+    std::vector<MappedFile> mapped_files;
+
+    for (fastgltf::Buffer& buffer : buffers) {
+        auto const* buffer_uri = std::get_if<fastgltf::sources::URI>(&buffer.data);
+
+        if (buffer_uri == nullptr || !buffer_uri->uri.isLocalPath()) {
+            continue;
+        }
 
-    return {std::move(loaded_mesh), std::move(loaded_mesh_renderer)};
+        FilePath const buffer_filepath = root_filepath + buffer_uri->uri.path();
+        AssetCache::add_dependency(buffer_filepath);
+
+        if (!FileUtils::is_readable(buffer_filepath)) {
+            throw std::invalid_argument("Error: Couldn't open the glTF buffer '" + buffer_filepath + '\'');
+        }
+
+        MappedFile const& mapped_file = mapped_files.emplace_back(buffer_filepath);
+
+        if (buffer_uri->fileByteOffset > mapped_file.size() ||
+            buffer.byteLength > mapped_file.size() - buffer_uri->fileByteOffset) {
+            throw std::invalid_argument("Error: The glTF buffer '" + buffer_filepath + "' is too small");
+        }
+
+        auto const* buffer_bytes = reinterpret_cast<std::byte const*>(mapped_file.data() + buffer_uri->fileByteOffset);
+        buffer.data = fastgltf::sources::ByteView{
+            fastgltf::span<std::byte const>(buffer_bytes, buffer.byteLength), buffer_uri->mimeType
+        };
+    }
+
+    return mapped_files;
+}
+
+/// Recovers the data of a loaded buffer.
+/// \param buffer Buffer to recover the data of.
+/// \return Buffer's data, or an empty span if it has not been loaded.
+std::span<std::byte const> recover_buffer_data(fastgltf::Buffer const& buffer)
+{
+    return std::visit(
+        fastgltf::visitor{
+            [](fastgltf::sources::Array const& data) {
+                return std::span<std::byte const>(data.bytes.data(), data.bytes.size());
+            },
+            [](fastgltf::sources::Vector const& data) {
+                return std::span<std::byte const>(data.bytes.data(), data.bytes.size());
+            },
+            [](fastgltf::sources::ByteView const& data) {
+                return std::span<std::byte const>(data.bytes.data(), data.bytes.size());
+            },
+            [](auto const&) { return std::span<std::byte const>(); }
+        },
+        buffer.data
+    );
+}
+
+std::optional<Image> load_image(
+    fastgltf::Image const& image, std::vector<fastgltf::Buffer> const& buffers,
+    std::vector<fastgltf::BufferView> const& buffer_views, FilePath const& root_filepath
+)
+{
+    ZoneScopedN("[GltfLoad]::load_image");
+
+    auto const load_from_bytes = [](std::span<std::byte const> image_bytes) {
+        auto const* image_data = reinterpret_cast<unsigned char const*>(image_bytes.data());
+        return ImageFormat::load_from_data(image_data, image_bytes.size());
+    };
+
+    return std::visit(
+        fastgltf::visitor{
+            [&root_filepath](fastgltf::sources::URI const& image_path) -> std::optional<Image> {
+                return ImageFormat::load(root_filepath + image_path.uri.path());
+            },
+            [&load_from_bytes](fastgltf::sources::Array const& image_data) -> std::optional<Image> {
+                return load_from_bytes(std::span<std::byte const>(image_data.bytes.data(), image_data.bytes.size()));
+            },
+            [&load_from_bytes](fastgltf::sources::Vector const& image_data) -> std::optional<Image> {
+                return load_from_bytes(std::span<std::byte const>(image_data.bytes.data(), image_data.bytes.size()));
+            },
+            [&buffer_views, &buffers,
+             &load_from_bytes](fastgltf::sources::BufferView const& buffer_view_source) -> std::optional<Image> {
+                fastgltf::BufferView const& image_view = buffer_views[buffer_view_source.bufferViewIndex];
+                std::span<std::byte const> const buffer_data = recover_buffer_data(buffers[image_view.bufferIndex]);
+
+                if (image_view.byteOffset > buffer_data.size() ||
+                    image_view.byteLength > buffer_data.size() - image_view.byteOffset) {
+                    Log::error("[GltfLoad] Cannot find a suitable way of loading an image.");
+                    return std::nullopt;
+                }
+
+                return load_from_bytes(buffer_data.subspan(image_view.byteOffset, image_view.byteLength));
+            },
+            [](auto const&) -> std::optional<Image> {
+                Log::error("[GltfLoad] Cannot find a suitable way of loading an image.");
+                return std::nullopt;
+            }
+        },
+        image.data
+    );
 }
 
 std::vector<std::optional<Image>> load_images(
@@ -247,47 +415,37 @@ std::vector<std::optional<Image>> load_images(
 
     Log::vdebug("[GltfLoad] Loading {} image(s)...", images.size());
 
-    std::vector<std::optional<Image>> loaded_images;
-    loaded_images.reserve(images.size());
+    std::vector<std::optional<Image>> loaded_images(images.size());
 
-    auto const loadFailure = [&loaded_images](auto const&) {
-        Log::error("[GltfLoad] Cannot find a suitable way of loading an image.");
-        loaded_images.emplace_back(std::nullopt);
-    };
+    if (images.empty()) {
+        return loaded_images;
+    }
 
+    // The dependencies are recorded for the thread cooking the asset, hence before decoding the images on other ones
     for (fastgltf::Image const& image : images) {
-        std::visit(
-            fastgltf::visitor{
-                [&loaded_images, &root_filepath](fastgltf::sources::URI const& image_path) {
-                    loaded_images.emplace_back(ImageFormat::load(root_filepath + image_path.uri.path()));
-                },
-                [&loaded_images](fastgltf::sources::Vector const& image_data) {
-                    auto const* image_bytes = reinterpret_cast<unsigned char const*>(image_data.bytes.data());
-                    loaded_images.emplace_back(ImageFormat::load_from_data(image_bytes, image_data.bytes.size()));
-                },
-                [&buffer_views, &buffers, &loaded_images,
-                 &loadFailure](fastgltf::sources::BufferView const& bufferViewSource) {
-                    fastgltf::BufferView const& image_view = buffer_views[bufferViewSource.bufferViewIndex];
-                    fastgltf::Buffer const& image_buffer = buffers[image_view.bufferIndex];
-
-                    std::visit(
-                        fastgltf::visitor{
-                            [&loaded_images, &image_view](fastgltf::sources::Array const& image_data) {
-                                auto const* image_bytes =
-                                    reinterpret_cast<unsigned char const*>(image_data.bytes.data());
-                                loaded_images.emplace_back(ImageFormat::load_from_data(
-                                    image_bytes + image_view.byteOffset, image_view.byteLength
-                                ));
-                            },
-                            loadFailure
-                        },
-                        image_buffer.data
-                    );
-                },
-                loadFailure
-            },
-            image.data
-        );
+        if (auto const* image_path = std::get_if<fastgltf::sources::URI>(&image.data)) {
+            AssetCache::add_dependency(root_filepath + image_path->uri.path());
+        }
+    }
+
+    // The images are decoded in parallel; an exception thrown by a task is rethrown once all are done
+    std::vector<std::exception_ptr> exceptions(images.size());
+
+    parallelize(0u, images.size(), [&](IndexRange const& range) {
+        for (size_t image_index = range.begin_index; image_index < range.end_index; ++image_index) {
+            try {
+                loaded_images[image_index] = load_image(images[image_index], buffers, buffer_views, root_filepath);
+            }
+            catch (...) {
+                exceptions[image_index] = std::current_exception();
+            }
+        }
+    });
+
+    for (std::exception_ptr const& exception : exceptions) {
+        if (exception != nullptr) {
+            std::rethrow_exception(exception);
+        }
     }
 
     Log::debug("[GltfLoad] Loaded image(s)");
@@ -297,56 +455,20 @@ std::vector<std::optional<Image>> load_images(
 
 Image extract_ambient_occlusion_image(Image const& occlusion_image)
 {
-    Image ambient_image(occlusion_image.get_size(), ImageColorspace::GRAY, occlusion_image.get_data_type());
-
-    auto const occlusion_length = occlusion_image.get_width() * occlusion_image.get_height();
-
-    for (size_t i = 0; i < occlusion_length; ++i) {
-        size_t const final_index = i * occlusion_image.get_channel_count();
-
-        // The occlusion is located in the red (1st) channel
-        // See: https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#_material_occlusiontexture
-        if (occlusion_image.get_data_type() == ImageDataType::BYTE)
-            static_cast<uint8_t*>(ambient_image.data())[i] =
-                static_cast<uint8_t const*>(occlusion_image.data())[final_index];
-        else
-            static_cast<float*>(ambient_image.data())[i] =
-                static_cast<float const*>(occlusion_image.data())[final_index];
-    }
-
-    return ambient_image;
+    // The occlusion is located in the red (1st) channel
+    // See: https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#_material_occlusiontexture
+    return ImageProcessing::extract_channel(occlusion_image, 0);
 }
 
 std::pair<Image, Image> extract_metalness_roughness_images(Image const& metal_roughness_image)
 {
-    Image metalness_image(
-        metal_roughness_image.get_size(), ImageColorspace::GRAY, metal_roughness_image.get_data_type()
-    );
-    Image roughness_image(
-        metal_roughness_image.get_size(), ImageColorspace::GRAY, metal_roughness_image.get_data_type()
-    );
-
-    for (size_t i = 0; i < metal_roughness_image.get_width() * metal_roughness_image.get_height(); ++i) {
-        size_t const final_index = i * metal_roughness_image.get_channel_count();
-
-        // The metalness & roughness are located respectively in the blue (3rd) & green (2nd) channels
-        // See:
-        // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#_material_pbrmetallicroughness_metallicroughnesstexture
-        if (metal_roughness_image.get_data_type() == ImageDataType::BYTE) {
-            static_cast<uint8_t*>(metalness_image.data())[i] =
-                static_cast<uint8_t const*>(metal_roughness_image.data())[final_index + 2];
-            static_cast<uint8_t*>(roughness_image.data())[i] =
-                static_cast<uint8_t const*>(metal_roughness_image.data())[final_index + 1];
-        }
-        else {
-            static_cast<float*>(metalness_image.data())[i] =
-                static_cast<float const*>(metal_roughness_image.data())[final_index + 2];
-            static_cast<float*>(roughness_image.data())[i] =
-                static_cast<float const*>(metal_roughness_image.data())[final_index + 1];
-        }
-    }
-
-    return {std::move(metalness_image), std::move(roughness_image)};
+    // The metalness & roughness are located respectively in the blue (3rd) & green (2nd) channels
+    // See:
+    // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#_material_pbrmetallicroughness_metallicroughnesstexture
+    return {
+        ImageProcessing::extract_channel(metal_roughness_image, 2),
+        ImageProcessing::extract_channel(metal_roughness_image, 1)
+    };
 }
 
 Image merge_images(Image const& image1, Image const& image2)
@@ -383,25 +505,18 @@ Image merge_images(Image const& image1, Image const& image2)
              (total_channel_count == 3 ? ImageColorspace::RGB :
                                          (is_srgb ? ImageColorspace::SRGBA : ImageColorspace::RGBA)));
 
-    Image res(image1.get_size(), colorspace, image1.get_data_type());
-
-    for (uint32_t height_index = 0; height_index < image1.get_height(); ++height_index) {
-        for (uint32_t width_index = 0; width_index < image1.get_width(); ++width_index) {
-            for (uint8_t channel_index = 0; channel_index < image1.get_channel_count(); ++channel_index)
-                res.set_byte_value(
-                    width_index, height_index, channel_index,
-                    image1.recover_byte_value(width_index, height_index, channel_index)
-                );
-
-            for (uint8_t channel_index = 0; channel_index < image2.get_channel_count(); ++channel_index)
-                res.set_byte_value(
-                    width_index, height_index, channel_index + image1.get_channel_count(),
-                    image2.recover_byte_value(width_index, height_index, channel_index)
-                );
-        }
+    std::vector<ImageChannel> channels;
+    channels.reserve(total_channel_count);
+
+    for (uint8_t channel_index = 0; channel_index < image1.get_channel_count(); ++channel_index) {
+        channels.push_back(ImageChannel{image1, channel_index});
+    }
+
+    for (uint8_t channel_index = 0; channel_index < image2.get_channel_count(); ++channel_index) {
+        channels.push_back(ImageChannel{image2, channel_index});
     }
 
-    return res;
+    return ImageProcessing::merge_channels(channels, colorspace);
 }
 
 template <template <typename> typename OptionalT, typename TextureInfoT, typename FuncT>
@@ -448,7 +563,7 @@ void load_sheen(
     if (mat_sheen.sheenColorTexture && mat_sheen.sheenRoughnessTexture &&
         mat_sheen.sheenColorTexture->textureIndex == mat_sheen.sheenRoughnessTexture->textureIndex) {
         load_texture(mat_sheen.sheenColorTexture, textures, images, [&material_program](Image const& image) {
-            material_program.set_texture(Texture2D::create(image, true, true), MaterialTexture::Sheen);
+            material_program.set_texture(TextureCache::load(image, true), MaterialTexture::Sheen);
         });
 
         return;
@@ -464,7 +579,7 @@ void load_sheen(
         sheen_roughness_image = std::move(image);
     });
     material_program.set_texture(
-        Texture2D::create(merge_images(sheen_color_image, sheen_roughness_image), true, true), MaterialTexture::Sheen
+        TextureCache::load(merge_images(sheen_color_image, sheen_roughness_image), true), MaterialTexture::Sheen
     );
 }
 
@@ -499,28 +614,28 @@ void load_materials(
         material_program.set_attribute(material.pbrData.roughnessFactor, MaterialAttribute::Roughness);
 
         load_texture(material.pbrData.baseColorTexture, textures, images, [&material_program](Image const& image) {
-            material_program.set_texture(Texture2D::create(image, true, true), MaterialTexture::BaseColor);
+            material_program.set_texture(TextureCache::load(image, true), MaterialTexture::BaseColor);
         });
 
         load_texture(material.emissiveTexture, textures, images, [&material_program](Image const& image) {
-            material_program.set_texture(Texture2D::create(image, true, true), MaterialTexture::Emissive);
+            material_program.set_texture(TextureCache::load(image, true), MaterialTexture::Emissive);
         });
 
         load_texture(material.occlusionTexture, textures, images, [&material_program](Image const& image) {
             Image const ambientOcclusionImg = extract_ambient_occlusion_image(image);
-            material_program.set_texture(Texture2D::create(ambientOcclusionImg), MaterialTexture::Ambient);
+            material_program.set_texture(TextureCache::load(ambientOcclusionImg), MaterialTexture::Ambient);
         });
 
         load_texture(material.normalTexture, textures, images, [&material_program](Image const& image) {
-            material_program.set_texture(Texture2D::create(image), MaterialTexture::Normal);
+            material_program.set_texture(TextureCache::load(image), MaterialTexture::Normal);
         });
 
         load_texture(
             material.pbrData.metallicRoughnessTexture, textures, images,
             [&material_program](Image const& image) {
                 auto const [metalness_image, roughness_image] = extract_metalness_roughness_images(image);
-                material_program.set_texture(Texture2D::create(metalness_image), MaterialTexture::Metallic);
-                material_program.set_texture(Texture2D::create(roughness_image), MaterialTexture::Roughness);
+                material_program.set_texture(TextureCache::load(metalness_image), MaterialTexture::Metallic);
+                material_program.set_texture(TextureCache::load(roughness_image), MaterialTexture::Roughness);
             }
         );
 
@@ -533,12 +648,66 @@ void load_materials(
 
     Log::debug("[GltfLoad] Loaded material(s)");
 }
+
+/// Parsed glTF asset, from which the materials are loaded along with the graphics resources. The file's data & buffers
+///   are kept alongside the asset, which may reference them.
+struct GltfAsset {
+    std::unique_ptr<fastgltf::GltfDataGetter> data;
+    std::vector<MappedFile> mapped_buffers;
+    fastgltf::Asset asset;
+    std::vector<std::optional<Image>> images;
+};
+
+/// Opens a glTF file to be parsed.
+/// \param filepath Path to the file.
+/// \return File's data.
+std::unique_ptr<fastgltf::GltfDataGetter> open_data(FilePath const& filepath)
+{
+    VirtualFileSystem::FileLocation const location = VirtualFileSystem::locate(filepath);
+
+    // Packed files are copied from the archive, the parser requiring padding after the data
+    if (location.is_packed()) {
+        MappedFile const file(filepath);
+        fastgltf::Expected<fastgltf::GltfDataBuffer> data =
+            fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<std::byte const*>(file.data()), file.size());
+
+        if (data.error() != fastgltf::Error::None) {
+            throw std::invalid_argument("Error: Could not load the glTF file.");
+        }
+
+        return std::make_unique<fastgltf::GltfDataBuffer>(std::move(data.get()));
+    }
+
+    FilePath const& disk_path = location.disk_path;
+
+#if defined(FASTGLTF_HAS_MEMORY_MAPPED_FILE)
+    // Binary files are mapped instead of being read, so that their embedded buffer is copied only once. Text files are
+    //   still read, the JSON parser requiring padding after the data
+    if (StrUtils::to_lower_copy(filepath.recover_extension().to_utf8()) == "glb") {
+        fastgltf::Expected<fastgltf::MappedGltfFile> file = fastgltf::MappedGltfFile::FromPath(disk_path.get_path());
+
+        if (file.error() != fastgltf::Error::None) {
+            throw std::invalid_argument("Error: Could not load the glTF file.");
+        }
+
+        return std::make_unique<fastgltf::MappedGltfFile>(std::move(file.get()));
+    }
+#endif
+
+    fastgltf::Expected<fastgltf::GltfDataBuffer> data = fastgltf::GltfDataBuffer::FromPath(disk_path.get_path());
+
+    if (data.error() != fastgltf::Error::None) {
+        throw std::invalid_argument("Error: Could not load the glTF file.");
+    }
+
+    return std::make_unique<fastgltf::GltfDataBuffer>(std::move(data.get()));
+}
 }
 
 namespace GltfFormat {
-std::pair<Mesh, MeshRendererData> load(FilePath const& filepath)
+std::pair<Mesh, std::function<MeshRendererData(Mesh const&)>> parse(FilePath const& filepath)
 {
-    ZoneScopedN("GltfFormat::load");
+    ZoneScopedN("GltfFormat::parse");
     ZoneTextF("Path: %s", filepath.to_utf8().c_str());
 
     Log::debug("[GltfLoad] Loading glTF file ('" + filepath + "')...");
@@ -548,41 +717,59 @@ std::pair<Mesh, MeshRendererData> load(FilePath const& filepath)
             "Error: The glTF file '" + filepath + "' either does not exist or cannot be opened."
         );
 
-    fastgltf::Expected<fastgltf::GltfDataBuffer> data = fastgltf::GltfDataBuffer::FromPath(filepath.get_path());
-
-    if (data.error() != fastgltf::Error::None) {
-        throw std::invalid_argument("Error: Could not load the glTF file.");
-    }
+    auto gltf_asset = std::make_shared<GltfAsset>();
+    gltf_asset->data = open_data(filepath);
 
     FilePath const parent_path = filepath.recover_path_to_file();
 
     constexpr fastgltf::Extensions extensions = fastgltf::Extensions::KHR_materials_sheen;
     fastgltf::Parser parser(extensions);
 
-    fastgltf::Expected<fastgltf::Asset> asset = parser.loadGltf(
-        data.get(), parent_path.get_path(),
-        fastgltf::Options::LoadExternalBuffers | fastgltf::Options::DecomposeNodeMatrices
-    );
+    // External buffers are mapped manually, their paths being otherwise lost once loaded
+    fastgltf::Expected<fastgltf::Asset> asset =
+        parser.loadGltf(*gltf_asset->data, parent_path.get_path(), fastgltf::Options::DecomposeNodeMatrices);
 
     if (asset.error() != fastgltf::Error::None) {
         throw std::invalid_argument("Error: Failed to load glTF: " + fastgltf::getErrorMessage(asset.error()));
     }
 
+    gltf_asset->mapped_buffers = map_external_buffers(asset->buffers, parent_path);
+
     std::vector<std::optional<Transform>> const transforms = load_transforms(asset.get());
-    auto [mesh, mesh_renderer] = load_meshes(asset.get(), transforms);
+    Mesh mesh = load_meshes(asset.get(), transforms);
 
     // auto& ent = world.add_entity_with_component<Transform>();
     // auto& map_rigidbody_component = ent.add_component<Rigidbody>(0.0f, 0.7f);
 
-    std::vector<std::optional<Image>> const images =
-        load_images(asset->images, asset->buffers, asset->bufferViews, parent_path);
-    load_materials(asset->materials, asset->textures, images, mesh_renderer);
+    gltf_asset->images = load_images(asset->images, asset->buffers, asset->bufferViews, parent_path);
+    gltf_asset->asset = std::move(asset.get());
 
-    Log::vdebug(
-        "[GltfLoad] Loaded glTF file ({} submesh(es), {} vertices, {} triangles, {} material(s))",
-        mesh.get_submeshes().size(), mesh.recover_vertex_count(), mesh.recover_triangle_count(),
-        mesh_renderer.get_materials().size()
-    );
+    // The images are decoded, but the textures & shader programs can only be created along with the graphics resources
+    return {
+        std::move(mesh),
+        [gltf_asset = std::move(gltf_asset)](Mesh const& parsed_mesh) {
+            fastgltf::Asset const& loaded_asset = gltf_asset->asset;
+
+            MeshRendererData mesh_renderer = load_mesh_renderer(loaded_asset, parsed_mesh);
+            load_materials(loaded_asset.materials, loaded_asset.textures, gltf_asset->images, mesh_renderer);
+
+            Log::vdebug(
+                "[GltfLoad] Loaded glTF file ({} submesh(es), {} vertices, {} triangles, {} material(s))",
+                parsed_mesh.get_submeshes().size(), parsed_mesh.recover_vertex_count(),
+                parsed_mesh.recover_triangle_count(), mesh_renderer.get_materials().size()
+            );
+
+            return mesh_renderer;
+        }
+    };
+}
+
+std::pair<Mesh, MeshRendererData> load(FilePath const& filepath)
+{
+    ZoneScopedN("GltfFormat::load");
+
+    auto [mesh, load_renderer] = parse(filepath);
+    MeshRendererData mesh_renderer = load_renderer(mesh);
 
     return {std::move(mesh), std::move(mesh_renderer)};
 }
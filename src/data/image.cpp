@@ -1,5 +1,10 @@
 #include "image.hpp"
 
+#include <data/image_buffer_pool.hpp>
+#include <data/image_utils.hpp>
+
+#include <tracy/Tracy.hpp>
+
 namespace xen {
 bool ImageDataB::operator==(ImageData const& image_data) const
 {
@@ -77,6 +82,30 @@ Image::Image(Vector2ui const& size, ImageColorspace colorspace, ImageDataType da
     }
 }
 
+Image::Image(Vector2ui const& size, ImageColorspace colorspace, std::vector<uint8_t> data) :
+    Image(colorspace, ImageDataType::BYTE)
+{
+    this->size = size;
+
+    if (data.size() != static_cast<size_t>(this->size.x) * this->size.y * channel_count) {
+        throw std::invalid_argument("Error: The image's data must hold a value for each channel of every pixel");
+    }
+
+    data_ = ImageDataB::create(std::move(data));
+}
+
+Image::Image(Vector2ui const& size, ImageColorspace colorspace, std::vector<float> data) :
+    Image(colorspace, ImageDataType::FLOAT)
+{
+    this->size = size;
+
+    if (data.size() != static_cast<size_t>(this->size.x) * this->size.y * channel_count) {
+        throw std::invalid_argument("Error: The image's data must hold a value for each channel of every pixel");
+    }
+
+    data_ = ImageDataF::create(std::move(data));
+}
+
 Image::Image(Image const& image) :
     size{image.size}, colorspace{image.colorspace}, data_type{image.data_type}, channel_count{image.channel_count}
 {
@@ -95,6 +124,92 @@ Image::Image(Image const& image) :
     }
 }
 
+std::span<uint8_t const> Image::get_byte_data() const
+{
+    Log::rt_assert(
+        data_type == ImageDataType::BYTE, "Error: Getting byte values requires the image to be of a byte type."
+    );
+
+    if (data_ == nullptr) {
+        return {};
+    }
+
+    return {static_cast<uint8_t const*>(data_->data()), static_cast<size_t>(size.x) * size.y * channel_count};
+}
+
+std::span<uint8_t> Image::get_byte_data()
+{
+    Log::rt_assert(
+        data_type == ImageDataType::BYTE, "Error: Getting byte values requires the image to be of a byte type."
+    );
+
+    if (data_ == nullptr) {
+        return {};
+    }
+
+    return {static_cast<uint8_t*>(data_->data()), static_cast<size_t>(size.x) * size.y * channel_count};
+}
+
+std::span<float const> Image::get_float_data() const
+{
+    Log::rt_assert(
+        data_type == ImageDataType::FLOAT, "Error: Getting float values requires the image to be of a float type."
+    );
+
+    if (data_ == nullptr) {
+        return {};
+    }
+
+    return {static_cast<float const*>(data_->data()), static_cast<size_t>(size.x) * size.y * channel_count};
+}
+
+std::span<float> Image::get_float_data()
+{
+    Log::rt_assert(
+        data_type == ImageDataType::FLOAT, "Error: Getting float values requires the image to be of a float type."
+    );
+
+    if (data_ == nullptr) {
+        return {};
+    }
+
+    return {static_cast<float*>(data_->data()), static_cast<size_t>(size.x) * size.y * channel_count};
+}
+
+std::vector<uint8_t> Image::release_byte_data()
+{
+    Log::rt_assert(
+        data_type == ImageDataType::BYTE, "Error: Releasing byte values requires the image to be of a byte type."
+    );
+
+    if (data_ == nullptr) {
+        return {};
+    }
+
+    std::vector<uint8_t> data = std::move(static_cast<ImageDataB&>(*data_).data_);
+    data_.reset();
+    size = Vector2ui(0);
+
+    return data;
+}
+
+std::vector<float> Image::release_float_data()
+{
+    Log::rt_assert(
+        data_type == ImageDataType::FLOAT, "Error: Releasing float values requires the image to be of a float type."
+    );
+
+    if (data_ == nullptr) {
+        return {};
+    }
+
+    std::vector<float> data = std::move(static_cast<ImageDataF&>(*data_).data_);
+    data_.reset();
+    size = Vector2ui(0);
+
+    return data;
+}
+
 uint8_t Image::recover_byte_value(size_t width_index, size_t height_index, uint8_t channel_index) const
 {
     Log::rt_assert(
@@ -127,6 +242,110 @@ void Image::set_float_value(size_t width_index, size_t height_index, uint8_t cha
     set_value(width_index, height_index, channel_index, val);
 }
 
+void Image::flip_vertically()
+{
+    ZoneScopedN("Image::flip_vertically");
+
+    if (empty()) {
+        return;
+    }
+
+    size_t const value_size = (data_type == ImageDataType::FLOAT ? sizeof(float) : sizeof(uint8_t));
+    size_t const row_size = static_cast<size_t>(size.x) * channel_count * value_size;
+
+    ImageUtils::flip_vertically({static_cast<uint8_t*>(data_->data()), row_size * size.y}, row_size);
+}
+
+void Image::expand_to_rgba()
+{
+    ZoneScopedN("Image::expand_to_rgba");
+
+    if (colorspace == ImageColorspace::RGBA || colorspace == ImageColorspace::SRGBA) {
+        return;
+    }
+
+    if (colorspace != ImageColorspace::RGB && colorspace != ImageColorspace::SRGB) {
+        throw std::invalid_argument("Error: Only RGB & sRGB images can be expanded to RGBA");
+    }
+
+    Vector2ui const image_size = size;
+    size_t const rgba_value_count = static_cast<size_t>(image_size.x) * image_size.y * 4;
+
+    // The new buffer is taken from the pool, to which the previous one is given back
+    if (data_type == ImageDataType::BYTE) {
+        std::vector<uint8_t> rgba_values = ImageBufferPool::acquire_bytes(rgba_value_count);
+        ImageUtils::expand_rgb_to_rgba(get_byte_data(), rgba_values);
+        ImageBufferPool::release(release_byte_data());
+        data_ = ImageDataB::create(std::move(rgba_values));
+    }
+    else {
+        std::vector<float> rgba_values = ImageBufferPool::acquire_floats(rgba_value_count);
+        ImageUtils::expand_rgb_to_rgba(get_float_data(), rgba_values);
+        ImageBufferPool::release(release_float_data());
+        data_ = ImageDataF::create(std::move(rgba_values));
+    }
+
+    size = image_size;
+    colorspace = (colorspace == ImageColorspace::SRGB ? ImageColorspace::SRGBA : ImageColorspace::RGBA);
+    channel_count = 4;
+}
+
+void Image::convert_to_linear()
+{
+    ZoneScopedN("Image::convert_to_linear");
+
+    if (data_type != ImageDataType::BYTE ||
+        (colorspace != ImageColorspace::SRGB && colorspace != ImageColorspace::SRGBA)) {
+        throw std::invalid_argument("Error: Only sRGB(A) images can be converted to linear ones");
+    }
+
+    Vector2ui const image_size = size;
+
+    std::vector<float> linear_values =
+        ImageBufferPool::acquire_floats(static_cast<size_t>(image_size.x) * image_size.y * channel_count);
+    ImageUtils::convert_srgb_to_linear(get_byte_data(), linear_values, channel_count);
+    ImageBufferPool::release(release_byte_data());
+
+    size = image_size;
+    colorspace = (colorspace == ImageColorspace::SRGB ? ImageColorspace::RGB : ImageColorspace::RGBA);
+    data_type = ImageDataType::FLOAT;
+    data_ = ImageDataF::create(std::move(linear_values));
+}
+
+void Image::convert_to_srgb()
+{
+    ZoneScopedN("Image::convert_to_srgb");
+
+    if (data_type != ImageDataType::FLOAT ||
+        (colorspace != ImageColorspace::RGB && colorspace != ImageColorspace::RGBA)) {
+        throw std::invalid_argument("Error: Only linear RGB(A) images with a float data type can be converted to sRGB");
+    }
+
+    Vector2ui const image_size = size;
+
+    std::vector<uint8_t> srgb_values =
+        ImageBufferPool::acquire_bytes(static_cast<size_t>(image_size.x) * image_size.y * channel_count);
+    ImageUtils::convert_linear_to_srgb(get_float_data(), srgb_values, channel_count);
+    ImageBufferPool::release(release_float_data());
+
+    size = image_size;
+    colorspace = (colorspace == ImageColorspace::RGB ? ImageColorspace::SRGB : ImageColorspace::SRGBA);
+    data_type = ImageDataType::BYTE;
+    data_ = ImageDataB::create(std::move(srgb_values));
+}
+
+std::vector<uint16_t> Image::recover_half_data() const
+{
+    ZoneScopedN("Image::recover_half_data");
+
+    std::span<float const> const values = get_float_data();
+
+    std::vector<uint16_t> half_values(values.size());
+    ImageUtils::convert_float_to_half(values, half_values);
+
+    return half_values;
+}
+
 Image& Image::operator=(Image const& image)
 {
     size = image.size;
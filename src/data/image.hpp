@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 namespace xen {
 class FilePath;
 
@@ -57,6 +59,7 @@ struct ImageDataB final : public ImageData {
 
 public:
     explicit ImageDataB(size_t data_size) { resize(data_size); }
+    explicit ImageDataB(std::vector<uint8_t> data) : data_{std::move(data)} {}
 
     ImageDataType get_data_type() const override { return ImageDataType::BYTE; }
 
@@ -90,6 +93,7 @@ struct ImageDataF final : public ImageData {
 
 public:
     explicit ImageDataF(size_t data_size) { resize(data_size); }
+    explicit ImageDataF(std::vector<float> data) : data_{std::move(data)} {}
 
     ImageDataType get_data_type() const override { return ImageDataType::FLOAT; }
 
@@ -129,6 +133,18 @@ public:
 
     Image(Vector2ui const& size, ImageColorspace colorspace, ImageDataType data_type = ImageDataType::BYTE);
 
+    /// Creates an image holding the given values, which are moved into it without being copied.
+    /// \param size Size of the image.
+    /// \param colorspace Colorspace of the image.
+    /// \param data Values of the image; their number must be equal to the width * height * channel count.
+    Image(Vector2ui const& size, ImageColorspace colorspace, std::vector<uint8_t> data);
+
+    /// Creates an image holding the given values, which are moved into it without being copied.
+    /// \param size Size of the image.
+    /// \param colorspace Colorspace of the image.
+    /// \param data Values of the image; their number must be equal to the width * height * channel count.
+    Image(Vector2ui const& size, ImageColorspace colorspace, std::vector<float> data);
+
     Image(Image const& image);
 
     Vector2ui get_size() const { return size; }
@@ -150,6 +166,30 @@ public:
     /// \return True if the image has no data, false otherwise.
     bool empty() const { return (!data_ || data_->empty()); }
 
+    /// Gets all the values of the image, allowing to process them in bulk rather than one by one.
+    /// \note The image must have a byte data type for this function to execute properly.
+    /// \return Values of the image, row by row.
+    std::span<uint8_t const> get_byte_data() const;
+    std::span<uint8_t> get_byte_data();
+
+    /// Gets all the values of the image, allowing to process them in bulk rather than one by one.
+    /// \note The image must have a float data type for this function to execute properly.
+    /// \return Values of the image, row by row.
+    std::span<float const> get_float_data() const;
+    std::span<float> get_float_data();
+
+    /// Takes the values out of the image, which is left empty.
+    /// \note The image must have a byte data type for this function to execute properly.
+    /// \return Values of the image.
+    /// \see ImageBufferPool::release()
+    std::vector<uint8_t> release_byte_data();
+
+    /// Takes the values out of the image, which is left empty.
+    /// \note The image must have a float data type for this function to execute properly.
+    /// \return Values of the image.
+    /// \see ImageBufferPool::release()
+    std::vector<float> release_float_data();
+
     /// Gets a byte value from the image.
     /// \note The image must have a byte data type for this function to execute properly.
     /// \param width_index Width index of the value to be fetched.
@@ -210,6 +250,25 @@ public:
     template <typename T>
     void set_pixel(size_t width_index, size_t height_index, T val);
 
+    /// Flips the image vertically, in place.
+    void flip_vertically();
+
+    /// Adds a fully opaque alpha channel to an RGB or sRGB image, which then becomes RGBA or sRGBA. Does nothing if the
+    ///   image already has an alpha channel.
+    void expand_to_rgba();
+
+    /// Converts an sRGB(A) image, which has a byte data type, to a linear RGB(A) one with a float data type.
+    void convert_to_linear();
+
+    /// Converts a linear RGB(A) image with a float data type to an sRGB(A) one, which has a byte data type.
+    void convert_to_srgb();
+
+    /// Recovers the values of the image as half-precision floating-point values, for example to be uploaded to a
+    ///   16-bit floating-point texture.
+    /// \note The image must have a float data type for this function to execute properly.
+    /// \return Bits of the half-precision values, row by row.
+    std::vector<uint16_t> recover_half_data() const;
+
     /// Checks if the current image is equal to another given one.
     /// Their inner data must be of the same type.
     /// \param image Image to be compared with.
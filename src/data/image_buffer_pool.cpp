@@ -0,0 +1,125 @@
+#include "image_buffer_pool.hpp"
+
+#include <data/image.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace xen::ImageBufferPool {
+namespace {
+std::mutex pool_mutex;
+std::vector<std::vector<uint8_t>> byte_buffers;
+std::vector<std::vector<float>> float_buffers;
+size_t pooled_size = 0;
+size_t max_pooled_size = 64 * 1024 * 1024;
+
+template <typename T>
+std::vector<T> acquire(std::vector<std::vector<T>>& buffers, size_t value_count)
+{
+    std::vector<T> buffer;
+
+    {
+        std::lock_guard<std::mutex> const lock(pool_mutex);
+
+        // Picking the smallest buffer able to hold the values, keeping the larger ones for larger images
+        auto best_buffer_iter = buffers.end();
+
+        for (auto buffer_iter = buffers.begin(); buffer_iter != buffers.end(); ++buffer_iter) {
+            if (buffer_iter->capacity() >= value_count &&
+                (best_buffer_iter == buffers.end() || buffer_iter->capacity() < best_buffer_iter->capacity())) {
+                best_buffer_iter = buffer_iter;
+            }
+        }
+
+        if (best_buffer_iter != buffers.end()) {
+            buffer = std::move(*best_buffer_iter);
+            pooled_size -= buffer.capacity() * sizeof(T);
+
+            *best_buffer_iter = std::move(buffers.back());
+            buffers.pop_back();
+        }
+    }
+
+    // Buffers keep the size of their last use; shrinking one does not touch its values, only growing it initializes
+    // the additional ones
+    buffer.resize(value_count);
+
+    return buffer;
+}
+
+template <typename T>
+void release(std::vector<std::vector<T>>& buffers, std::vector<T>&& buffer)
+{
+    // The buffer is freed on return if it cannot be pooled
+    std::vector<T> released_buffer = std::move(buffer);
+    size_t const buffer_size = released_buffer.capacity() * sizeof(T);
+
+    if (buffer_size == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> const lock(pool_mutex);
+
+    if (pooled_size + buffer_size <= max_pooled_size) {
+        buffers.emplace_back(std::move(released_buffer));
+        pooled_size += buffer_size;
+    }
+}
+}
+
+void set_max_size(size_t byte_count)
+{
+    std::lock_guard<std::mutex> const lock(pool_mutex);
+    max_pooled_size = byte_count;
+}
+
+size_t get_size()
+{
+    std::lock_guard<std::mutex> const lock(pool_mutex);
+    return pooled_size;
+}
+
+std::vector<uint8_t> acquire_bytes(size_t value_count)
+{
+    ZoneScopedN("ImageBufferPool::acquire_bytes");
+    return acquire(byte_buffers, value_count);
+}
+
+std::vector<float> acquire_floats(size_t value_count)
+{
+    ZoneScopedN("ImageBufferPool::acquire_floats");
+    return acquire(float_buffers, value_count);
+}
+
+void release(std::vector<uint8_t>&& buffer)
+{
+    release(byte_buffers, std::move(buffer));
+}
+
+void release(std::vector<float>&& buffer)
+{
+    release(float_buffers, std::move(buffer));
+}
+
+void release(Image&& image)
+{
+    if (image.empty()) {
+        return;
+    }
+
+    if (image.get_data_type() == ImageDataType::BYTE) {
+        release(image.release_byte_data());
+    }
+    else {
+        release(image.release_float_data());
+    }
+}
+
+void clear()
+{
+    std::lock_guard<std::mutex> const lock(pool_mutex);
+
+    byte_buffers.clear();
+    float_buffers.clear();
+    pooled_size = 0;
+}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace xen {
+class Image;
+
+/// Pool of image buffers, reused by the images loaded afterward. A reused buffer only needs to be shrunk, neither being
+///   reallocated nor zero-filled, whereas a new one is entirely zero-initialized before the pixels are copied into it.
+/// Images loaded by ImageFormat take their buffer from the pool; images which are no longer needed once loaded (e.g.
+///   after having been uploaded to the GPU) can give theirs back with release().
+/// \note The pool is thread-safe.
+namespace ImageBufferPool {
+/// Sets the maximum total size of the buffers kept in the pool. Buffers released beyond it are freed.
+/// \param byte_count Maximum size of the pool, in bytes; 64 MiB by default.
+void set_max_size(size_t byte_count);
+
+/// Gets the total size of the buffers currently kept in the pool.
+/// \return Size of the pooled buffers, in bytes.
+[[nodiscard]] size_t get_size();
+
+/// Takes a buffer of bytes from the pool, allocating a new one if none is large enough.
+/// \param value_count Number of values the buffer must hold.
+/// \return Buffer holding exactly the given number of values, which are unspecified if it has been reused.
+std::vector<uint8_t> acquire_bytes(size_t value_count);
+
+/// Takes a buffer of floating-point values from the pool, allocating a new one if none is large enough.
+/// \param value_count Number of values the buffer must hold.
+/// \return Buffer holding exactly the given number of values, which are unspecified if it has been reused.
+std::vector<float> acquire_floats(size_t value_count);
+
+/// Gives a buffer back to the pool, for it to be reused by later acquisitions.
+/// \param buffer Buffer to be released.
+void release(std::vector<uint8_t>&& buffer);
+
+/// Gives a buffer back to the pool, for it to be reused by later acquisitions.
+/// \param buffer Buffer to be released.
+void release(std::vector<float>&& buffer);
+
+/// Gives an image's buffer back to the pool. The image is left empty.
+/// \param image Image to release the buffer of.
+void release(Image&& image);
+
+/// Frees all the pooled buffers.
+void clear();
+}
+}
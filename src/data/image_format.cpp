@@ -1,7 +1,10 @@
 #include "image_format.hpp"
 
 #include <data/image.hpp>
+#include <data/image_buffer_pool.hpp>
+#include <data/image_utils.hpp>
 #include <utils/filepath.hpp>
+#include <utils/mapped_file.hpp>
 #include <utils/str_utils.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -61,21 +64,31 @@ FileFormat recover_file_format(std::string const& file_extension)
 }
 
 Image create_image_from_data(
-    Vector2ui const& size, int channel_count, bool is_hdr, std::unique_ptr<void, ImageDataDeleter> const& data
+    Vector2ui const& size, int channel_count, bool is_hdr, std::unique_ptr<void, ImageDataDeleter> const& data,
+    bool flip_vertically
 )
 {
-    size_t const value_count = size.x * size.y * channel_count;
-
-    Image image(size, recover_colorspace(channel_count), (is_hdr ? ImageDataType::FLOAT : ImageDataType::BYTE));
+    size_t const value_count = static_cast<size_t>(size.x) * size.y * channel_count;
+    size_t const value_size = (is_hdr ? sizeof(float) : sizeof(uint8_t));
+    size_t const row_size = static_cast<size_t>(size.x) * channel_count * value_size;
+    std::span<uint8_t const> const decoded_data(static_cast<uint8_t const*>(data.get()), value_count * value_size);
 
+    // The image's buffer is taken from the pool, avoiding to zero-fill it, then filled in a single pass flipping the
+    // rows if needed, instead of letting stb flip them beforehand
     if (is_hdr) {
-        std::copy_n(static_cast<float*>(data.get()), value_count, static_cast<float*>(image.data()));
-    }
-    else {
-        std::copy_n(static_cast<uint8_t*>(data.get()), value_count, static_cast<uint8_t*>(image.data()));
+        std::vector<float> values = ImageBufferPool::acquire_floats(value_count);
+        ImageUtils::copy_rows(
+            decoded_data, {reinterpret_cast<uint8_t*>(values.data()), value_count * value_size}, row_size,
+            flip_vertically
+        );
+
+        return Image(size, recover_colorspace(channel_count), std::move(values));
     }
 
-    return image;
+    std::vector<uint8_t> values = ImageBufferPool::acquire_bytes(value_count);
+    ImageUtils::copy_rows(decoded_data, values, row_size, flip_vertically);
+
+    return Image(size, recover_colorspace(channel_count), std::move(values));
 }
 }
 
@@ -86,10 +99,11 @@ Image load(FilePath const& filepath, bool flip_vertically)
 
     Log::debug("[ImageFormat] Loading image '" + filepath + "'...");
 
-    std::string const file_str = filepath.to_utf8();
-    bool const is_hdr = (stbi_is_hdr(file_str.c_str()) != 0);
+    // The file is mapped & decoded from memory, so that it can be located through the virtual file system
+    MappedFile const file(filepath);
+    auto const file_size = static_cast<int>(file.size());
 
-    stbi_set_flip_vertically_on_load(flip_vertically);
+    bool const is_hdr = (stbi_is_hdr_from_memory(file.data(), file_size) != 0);
 
     int width{};
     int height{};
@@ -97,23 +111,30 @@ Image load(FilePath const& filepath, bool flip_vertically)
     std::unique_ptr<void, ImageDataDeleter> data;
 
     if (is_hdr) {
-        data.reset(stbi_loadf(file_str.c_str(), &width, &height, &channel_count, 0));
+        data.reset(stbi_loadf_from_memory(file.data(), file_size, &width, &height, &channel_count, 0));
     }
     else {
-        data.reset(stbi_load(file_str.c_str(), &width, &height, &channel_count, 0));
+        data.reset(stbi_load_from_memory(file.data(), file_size, &width, &height, &channel_count, 0));
     }
 
     if (data == nullptr) {
         throw std::invalid_argument("[ImageFormat] Cannot load image '" + filepath + "': " + stbi_failure_reason());
     }
 
-    Image image = create_image_from_data(Vector2ui(width, height), channel_count, is_hdr, data);
+    Image image = create_image_from_data(Vector2ui(width, height), channel_count, is_hdr, data, flip_vertically);
 
     Log::debug("[ImageFormat] Loaded image");
 
     return image;
 }
 
+void load_into(FilePath const& filepath, Image& image, bool flip_vertically)
+{
+    // The loaded image's buffer is taken from the pool, to which the previous one is first given back
+    ImageBufferPool::release(std::move(image));
+    image = load(filepath, flip_vertically);
+}
+
 Image load_from_data(std::vector<uint8_t> const& image_data, bool flip_vertically)
 {
     return load_from_data(image_data.data(), image_data.size(), flip_vertically);
@@ -125,8 +146,6 @@ Image load_from_data(uint8_t const* image_data, size_t data_size, bool flip_vert
 
     Log::debug("[ImageFormat] Loading image from data...");
 
-    stbi_set_flip_vertically_on_load(flip_vertically);
-
     bool const is_hdr = (stbi_is_hdr_from_memory(image_data, static_cast<int>(data_size)) != 0);
 
     int width{};
@@ -145,7 +164,9 @@ Image load_from_data(uint8_t const* image_data, size_t data_size, bool flip_vert
         throw std::invalid_argument("[ImageFormat] Cannot load image from data: " + std::string(stbi_failure_reason()));
     }
 
-    Image image = create_image_from_data(Vector2ui(width, height), static_cast<uint8_t>(channel_count), is_hdr, data);
+    Image image = create_image_from_data(
+        Vector2ui(width, height), static_cast<uint8_t>(channel_count), is_hdr, data, flip_vertically
+    );
 
     Log::debug("[ImageFormat] Loaded image from data");
 
@@ -11,6 +11,14 @@ namespace ImageFormat {
 /// \return Loaded image's data.
 Image load(FilePath const& filepath, bool flip_vertically = false);
 
+/// Loads an image from a file into an existing one, whose buffer is reused if it is large enough to hold the new
+///   image. This allows loading images one after the other without allocating memory for each of them.
+/// \param filepath File from which to load the image.
+/// \param image Image to load the file into; its previous content is discarded.
+/// \param flip_vertically Flip vertically the image when loading.
+/// \see ImageBufferPool
+void load_into(FilePath const& filepath, Image& image, bool flip_vertically = false);
+
 /// Loads an image from a byte array.
 /// \param image_data Data to be loaded as image.
 /// \param flip_vertically Flip vertically the image when loading.
@@ -0,0 +1,754 @@
+#include "image_processing.hpp"
+
+#include <data/image_buffer_pool.hpp>
+#include <data/image_utils.hpp>
+#include <utils/threading.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <numbers>
+
+namespace xen::ImageProcessing {
+namespace {
+/// Minimum number of values a task must process, below which dispatching it to another thread costs more than it saves.
+constexpr size_t min_task_value_count = 16384;
+
+constexpr float kaiser_radius = 3.f;
+constexpr float kaiser_alpha = 4.f;
+
+/// Weights of the input pixels contributing to each resampled one, along a single dimension.
+struct ResamplingWeights {
+    uint32_t tap_count{};         ///< Number of input pixels contributing to each resampled one.
+    std::vector<uint32_t> indices; ///< Indices of the contributing input pixels, tap_count for each resampled one.
+    std::vector<float> weights;    ///< Weights of the contributing input pixels, tap_count for each resampled one.
+};
+
+/// Processes rows in parallel, split into contiguous bands. Small images are processed on the calling thread.
+/// \param row_count Number of rows to be processed.
+/// \param row_value_count Number of values processed for each row, estimating its cost.
+/// \param action Action to be performed, taking a range of rows as boundaries.
+template <typename FuncT>
+void process_rows(size_t row_count, size_t row_value_count, FuncT const& action)
+{
+    if (row_count == 0) {
+        return;
+    }
+
+    size_t const task_count =
+        std::min<size_t>(row_count * row_value_count / min_task_value_count, get_system_thread_count());
+
+    if (task_count <= 1) {
+        action(IndexRange{0, row_count});
+        return;
+    }
+
+    parallelize(0u, row_count, action, static_cast<uint32_t>(task_count));
+}
+
+bool has_srgb_values(Image const& image)
+{
+    return (image.get_data_type() == ImageDataType::BYTE &&
+            (image.get_colorspace() == ImageColorspace::SRGB || image.get_colorspace() == ImageColorspace::SRGBA));
+}
+
+bool has_alpha_channel(Image const& image)
+{
+    return (image.get_colorspace() == ImageColorspace::GRAY_ALPHA || image.get_colorspace() == ImageColorspace::RGBA ||
+            image.get_colorspace() == ImageColorspace::SRGBA);
+}
+
+/// Converts the values of an image to floating-point ones; byte values are normalized, & sRGB ones linearized.
+/// \param image Image to convert the values of.
+/// \param values Converted values; must be as large as the image's values.
+void convert_to_linear(Image const& image, std::span<float> values)
+{
+    ZoneScopedN("[ImageProcessing]::convert_to_linear");
+
+    size_t const row_value_count = static_cast<size_t>(image.get_width()) * image.get_channel_count();
+
+    process_rows(image.get_height(), row_value_count, [&](IndexRange const& range) {
+        size_t const first_value_index = range.begin_index * row_value_count;
+        size_t const value_count = (range.end_index - range.begin_index) * row_value_count;
+        std::span<float> const band_values = values.subspan(first_value_index, value_count);
+
+        if (image.get_data_type() == ImageDataType::FLOAT) {
+            std::span<float const> const image_values = image.get_float_data().subspan(first_value_index, value_count);
+            std::copy(image_values.begin(), image_values.end(), band_values.begin());
+            return;
+        }
+
+        std::span<uint8_t const> const image_values = image.get_byte_data().subspan(first_value_index, value_count);
+
+        if (has_srgb_values(image)) {
+            ImageUtils::convert_srgb_to_linear(image_values, band_values, image.get_channel_count());
+            return;
+        }
+
+        for (size_t value_index = 0; value_index < value_count; ++value_index) {
+            band_values[value_index] = static_cast<float>(image_values[value_index]) / 255.f;
+        }
+    });
+}
+
+/// Converts floating-point values back to the values of an image; byte values are quantized, & sRGB ones delinearized.
+/// \param values Values to be converted.
+/// \param image Image to write the converted values into; its values must be as many as the given ones.
+void convert_from_linear(std::span<float const> values, Image& image)
+{
+    ZoneScopedN("[ImageProcessing]::convert_from_linear");
+
+    size_t const row_value_count = static_cast<size_t>(image.get_width()) * image.get_channel_count();
+
+    process_rows(image.get_height(), row_value_count, [&](IndexRange const& range) {
+        size_t const first_value_index = range.begin_index * row_value_count;
+        size_t const value_count = (range.end_index - range.begin_index) * row_value_count;
+        std::span<float const> const band_values = values.subspan(first_value_index, value_count);
+
+        if (image.get_data_type() == ImageDataType::FLOAT) {
+            std::copy(band_values.begin(), band_values.end(), image.get_float_data().begin() + first_value_index);
+            return;
+        }
+
+        std::span<uint8_t> const image_values = image.get_byte_data().subspan(first_value_index, value_count);
+
+        if (has_srgb_values(image)) {
+            ImageUtils::convert_linear_to_srgb(band_values, image_values, image.get_channel_count());
+            return;
+        }
+
+        for (size_t value_index = 0; value_index < value_count; ++value_index) {
+            float const value = std::clamp(band_values[value_index], 0.f, 1.f);
+            image_values[value_index] = static_cast<uint8_t>(value * 255.f + 0.5f);
+        }
+    });
+}
+
+std::vector<float> recover_linear_values(Image const& image)
+{
+    std::vector<float> values =
+        ImageBufferPool::acquire_floats(static_cast<size_t>(image.get_width()) * image.get_height() *
+                                        image.get_channel_count());
+    convert_to_linear(image, values);
+
+    return values;
+}
+
+Image create_image(
+    std::span<float const> values, Vector2ui const& size, ImageColorspace colorspace, ImageDataType data_type
+)
+{
+    Image image = (data_type == ImageDataType::FLOAT
+                       ? Image(size, colorspace, ImageBufferPool::acquire_floats(values.size()))
+                       : Image(size, colorspace, ImageBufferPool::acquire_bytes(values.size())));
+    convert_from_linear(values, image);
+
+    return image;
+}
+
+/// Computes the modified Bessel function of the first kind & of order 0, from its power series.
+float compute_bessel_i0(float value)
+{
+    float const quarter_squared_value = value * value / 4.f;
+    float result = 1.f;
+    float term = 1.f;
+
+    for (uint32_t term_index = 1; term_index < 32 && term > result * 1e-7f; ++term_index) {
+        term *= quarter_squared_value / static_cast<float>(term_index * term_index);
+        result += term;
+    }
+
+    return result;
+}
+
+float recover_filter_radius(ResamplingFilter filter)
+{
+    switch (filter) {
+    case ResamplingFilter::BOX:
+        return 0.5f;
+
+    case ResamplingFilter::TRIANGLE:
+        return 1.f;
+
+    case ResamplingFilter::KAISER:
+    default:
+        return kaiser_radius;
+    }
+}
+
+float evaluate_filter(ResamplingFilter filter, float distance)
+{
+    distance = std::abs(distance);
+
+    switch (filter) {
+    case ResamplingFilter::BOX:
+        return (distance <= 0.5f ? 1.f : 0.f);
+
+    case ResamplingFilter::TRIANGLE:
+        return std::max(1.f - distance, 0.f);
+
+    case ResamplingFilter::KAISER:
+    default:
+        break;
+    }
+
+    if (distance >= kaiser_radius) {
+        return 0.f;
+    }
+
+    float const scaled_distance = std::numbers::pi_v<float> * distance;
+    float const sinc = (scaled_distance < 1e-6f ? 1.f : std::sin(scaled_distance) / scaled_distance);
+    float const window_ratio = distance / kaiser_radius;
+
+    return sinc * compute_bessel_i0(kaiser_alpha * std::sqrt(1.f - window_ratio * window_ratio)) /
+           compute_bessel_i0(kaiser_alpha);
+}
+
+ResamplingWeights compute_weights(uint32_t size, uint32_t resampled_size, ResamplingFilter filter)
+{
+    float const scale = static_cast<float>(size) / static_cast<float>(resampled_size);
+    // When downsampling, the filter is stretched to cover all the input pixels of each resampled one
+    float const filter_scale = std::max(scale, 1.f);
+    float const support = recover_filter_radius(filter) * filter_scale;
+
+    ResamplingWeights weights;
+    weights.tap_count = static_cast<uint32_t>(std::ceil(support * 2.f)) + 1;
+    weights.indices.resize(static_cast<size_t>(resampled_size) * weights.tap_count);
+    weights.weights.resize(weights.indices.size());
+
+    for (uint32_t resampled_index = 0; resampled_index < resampled_size; ++resampled_index) {
+        float const center = (static_cast<float>(resampled_index) + 0.5f) * scale - 0.5f;
+        auto const first_index = static_cast<int64_t>(std::ceil(center - support));
+        size_t const first_weight_index = static_cast<size_t>(resampled_index) * weights.tap_count;
+
+        float weight_sum = 0.f;
+
+        for (uint32_t tap_index = 0; tap_index < weights.tap_count; ++tap_index) {
+            int64_t const index = first_index + tap_index;
+            float const weight = evaluate_filter(filter, (static_cast<float>(index) - center) / filter_scale);
+
+            // Pixels beyond the borders are clamped to them
+            weights.indices[first_weight_index + tap_index] =
+                static_cast<uint32_t>(std::clamp<int64_t>(index, 0, static_cast<int64_t>(size) - 1));
+            weights.weights[first_weight_index + tap_index] = weight;
+            weight_sum += weight;
+        }
+
+        // The weights are normalized for a uniform image to remain unchanged
+        for (uint32_t tap_index = 0; tap_index < weights.tap_count; ++tap_index) {
+            weights.weights[first_weight_index + tap_index] /= weight_sum;
+        }
+    }
+
+    return weights;
+}
+
+template <uint8_t ChannelCountV>
+void resample_row(float const* row_values, ResamplingWeights const& weights, float* resampled_row_values)
+{
+    size_t const resampled_width = weights.indices.size() / weights.tap_count;
+
+    for (size_t pixel_index = 0; pixel_index < resampled_width; ++pixel_index) {
+        std::array<float, ChannelCountV> pixel{};
+
+        for (uint32_t tap_index = 0; tap_index < weights.tap_count; ++tap_index) {
+            size_t const weight_index = pixel_index * weights.tap_count + tap_index;
+            float const weight = weights.weights[weight_index];
+            float const* input_pixel = row_values + static_cast<size_t>(weights.indices[weight_index]) * ChannelCountV;
+
+            for (uint8_t channel_index = 0; channel_index < ChannelCountV; ++channel_index) {
+                pixel[channel_index] += weight * input_pixel[channel_index];
+            }
+        }
+
+        std::copy(pixel.cbegin(), pixel.cend(), resampled_row_values + pixel_index * ChannelCountV);
+    }
+}
+
+void resample_row(
+    float const* row_values, ResamplingWeights const& weights, uint8_t channel_count, float* resampled_row_values
+)
+{
+    switch (channel_count) {
+    case 1:
+        resample_row<1>(row_values, weights, resampled_row_values);
+        break;
+
+    case 2:
+        resample_row<2>(row_values, weights, resampled_row_values);
+        break;
+
+    case 3:
+        resample_row<3>(row_values, weights, resampled_row_values);
+        break;
+
+    default:
+        resample_row<4>(row_values, weights, resampled_row_values);
+        break;
+    }
+}
+
+std::vector<float> resample(
+    std::span<float const> values, Vector2ui const& size, uint8_t channel_count, Vector2ui const& resampled_size,
+    ResamplingFilter filter
+)
+{
+    ZoneScopedN("[ImageProcessing]::resample");
+
+    ResamplingWeights const horizontal_weights = compute_weights(size.x, resampled_size.x, filter);
+    ResamplingWeights const vertical_weights = compute_weights(size.y, resampled_size.y, filter);
+
+    size_t const row_value_count = static_cast<size_t>(size.x) * channel_count;
+    size_t const resampled_row_value_count = static_cast<size_t>(resampled_size.x) * channel_count;
+
+    std::vector<float> resampled_values = ImageBufferPool::acquire_floats(resampled_row_value_count * resampled_size.y);
+
+    // Each resampled row is first filtered vertically into a full-width row, which is then filtered horizontally. The
+    //   vertical pass only scales & adds whole rows, which is trivially vectorizable
+    process_rows(resampled_size.y, row_value_count * vertical_weights.tap_count, [&](IndexRange const& range) {
+        std::vector<float> row_values(row_value_count);
+
+        for (size_t row_index = range.begin_index; row_index < range.end_index; ++row_index) {
+            std::fill(row_values.begin(), row_values.end(), 0.f);
+
+            for (uint32_t tap_index = 0; tap_index < vertical_weights.tap_count; ++tap_index) {
+                size_t const weight_index = row_index * vertical_weights.tap_count + tap_index;
+                float const weight = vertical_weights.weights[weight_index];
+
+                if (weight == 0.f) {
+                    continue;
+                }
+
+                float const* input_row = values.data() + vertical_weights.indices[weight_index] * row_value_count;
+
+                for (size_t value_index = 0; value_index < row_value_count; ++value_index) {
+                    row_values[value_index] += weight * input_row[value_index];
+                }
+            }
+
+            resample_row(
+                row_values.data(), horizontal_weights, channel_count,
+                resampled_values.data() + row_index * resampled_row_value_count
+            );
+        }
+    });
+
+    return resampled_values;
+}
+
+template <uint8_t ChannelCountV>
+void downsample_box_row(float const* first_row, float const* second_row, float* downsampled_row, size_t width)
+{
+    for (size_t pixel_index = 0; pixel_index < width; ++pixel_index) {
+        size_t const input_index = pixel_index * 2 * ChannelCountV;
+
+        for (uint8_t channel_index = 0; channel_index < ChannelCountV; ++channel_index) {
+            downsampled_row[pixel_index * ChannelCountV + channel_index] =
+                (first_row[input_index + channel_index] + first_row[input_index + ChannelCountV + channel_index] +
+                 second_row[input_index + channel_index] + second_row[input_index + ChannelCountV + channel_index]) *
+                0.25f;
+        }
+    }
+}
+
+void downsample_box_row(
+    float const* first_row, float const* second_row, float* downsampled_row, size_t width, uint8_t channel_count
+)
+{
+    switch (channel_count) {
+    case 1:
+        downsample_box_row<1>(first_row, second_row, downsampled_row, width);
+        break;
+
+    case 2:
+        downsample_box_row<2>(first_row, second_row, downsampled_row, width);
+        break;
+
+    case 3:
+        downsample_box_row<3>(first_row, second_row, downsampled_row, width);
+        break;
+
+    default:
+        downsample_box_row<4>(first_row, second_row, downsampled_row, width);
+        break;
+    }
+}
+
+/// Halves the dimensions of an image by averaging blocks of pixels. Each dimension must either be even or equal to 1,
+///   in which case it is kept as is.
+std::vector<float> downsample_box(
+    std::span<float const> values, Vector2ui const& size, uint8_t channel_count, Vector2ui const& downsampled_size
+)
+{
+    ZoneScopedN("[ImageProcessing]::downsample_box");
+
+    size_t const row_value_count = static_cast<size_t>(size.x) * channel_count;
+    size_t const downsampled_row_value_count = static_cast<size_t>(downsampled_size.x) * channel_count;
+    bool const halve_width = (downsampled_size.x != size.x);
+    size_t const row_step = (downsampled_size.y != size.y ? 2 : 1);
+
+    std::vector<float> downsampled_values =
+        ImageBufferPool::acquire_floats(downsampled_row_value_count * downsampled_size.y);
+
+    process_rows(downsampled_size.y, row_value_count * row_step, [&](IndexRange const& range) {
+        for (size_t row_index = range.begin_index; row_index < range.end_index; ++row_index) {
+            float const* first_row = values.data() + row_index * row_step * row_value_count;
+            float const* second_row = first_row + (row_step - 1) * row_value_count;
+            float* downsampled_row = downsampled_values.data() + row_index * downsampled_row_value_count;
+
+            if (halve_width) {
+                downsample_box_row(first_row, second_row, downsampled_row, downsampled_size.x, channel_count);
+                continue;
+            }
+
+            for (size_t value_index = 0; value_index < row_value_count; ++value_index) {
+                downsampled_row[value_index] = (first_row[value_index] + second_row[value_index]) * 0.5f;
+            }
+        }
+    });
+
+    return downsampled_values;
+}
+
+/// Copies a channel of tightly packed pixels into a channel of other ones. The channel counts being known at compile
+///   time, the loop has constant strides & can be vectorized.
+/// \tparam SourceChannelCountV Number of channels of the source pixels.
+/// \tparam DestinationChannelCountV Number of channels of the destination pixels.
+/// \tparam T Type of the pixels' components.
+/// \param source Source pixels, starting at the channel to be copied.
+/// \param destination Destination pixels, starting at the channel to be written.
+/// \param pixel_count Number of pixels to be copied.
+template <uint8_t SourceChannelCountV, uint8_t DestinationChannelCountV, typename T>
+void copy_channel(T const* source, T* destination, size_t pixel_count)
+{
+    for (size_t pixel_index = 0; pixel_index < pixel_count; ++pixel_index) {
+        destination[pixel_index * DestinationChannelCountV] = source[pixel_index * SourceChannelCountV];
+    }
+}
+
+template <uint8_t SourceChannelCountV, typename T>
+void copy_channel(T const* source, T* destination, uint8_t destination_channel_count, size_t pixel_count)
+{
+    switch (destination_channel_count) {
+    case 1:
+        copy_channel<SourceChannelCountV, 1>(source, destination, pixel_count);
+        break;
+
+    case 2:
+        copy_channel<SourceChannelCountV, 2>(source, destination, pixel_count);
+        break;
+
+    case 3:
+        copy_channel<SourceChannelCountV, 3>(source, destination, pixel_count);
+        break;
+
+    default:
+        copy_channel<SourceChannelCountV, 4>(source, destination, pixel_count);
+        break;
+    }
+}
+
+template <typename T>
+void copy_channel(
+    T const* source, uint8_t source_channel_count, T* destination, uint8_t destination_channel_count, size_t pixel_count
+)
+{
+    switch (source_channel_count) {
+    case 1:
+        copy_channel<1>(source, destination, destination_channel_count, pixel_count);
+        break;
+
+    case 2:
+        copy_channel<2>(source, destination, destination_channel_count, pixel_count);
+        break;
+
+    case 3:
+        copy_channel<3>(source, destination, destination_channel_count, pixel_count);
+        break;
+
+    default:
+        copy_channel<4>(source, destination, destination_channel_count, pixel_count);
+        break;
+    }
+}
+
+template <typename T>
+void copy_channels(std::span<ImageChannel const> channels, Image& destination)
+{
+    size_t const width = destination.get_width();
+    uint8_t const destination_channel_count = destination.get_channel_count();
+    auto* const destination_data = static_cast<T*>(destination.data());
+
+    process_rows(destination.get_height(), width * destination_channel_count, [&](IndexRange const& range) {
+        size_t const first_pixel_index = range.begin_index * width;
+        size_t const pixel_count = (range.end_index - range.begin_index) * width;
+
+        // All channels are copied band by band, for the destination rows to remain in cache
+        for (size_t channel_index = 0; channel_index < channels.size(); ++channel_index) {
+            ImageChannel const& channel = channels[channel_index];
+            uint8_t const source_channel_count = channel.image.get_channel_count();
+
+            copy_channel(
+                static_cast<T const*>(channel.image.data()) + first_pixel_index * source_channel_count + channel.index,
+                source_channel_count,
+                destination_data + first_pixel_index * destination_channel_count + channel_index,
+                destination_channel_count, pixel_count
+            );
+        }
+    });
+}
+
+template <uint8_t ChannelCountV>
+void multiply_colors(std::span<uint8_t> values)
+{
+    for (size_t pixel_index = 0; pixel_index < values.size() / ChannelCountV; ++pixel_index) {
+        uint8_t* const pixel = values.data() + pixel_index * ChannelCountV;
+        uint32_t const alpha = pixel[ChannelCountV - 1];
+
+        for (uint8_t channel_index = 0; channel_index < ChannelCountV - 1; ++channel_index) {
+            pixel[channel_index] = static_cast<uint8_t>((pixel[channel_index] * alpha + 127) / 255);
+        }
+    }
+}
+
+template <uint8_t ChannelCountV>
+void multiply_colors(std::span<float> values)
+{
+    for (size_t pixel_index = 0; pixel_index < values.size() / ChannelCountV; ++pixel_index) {
+        float* const pixel = values.data() + pixel_index * ChannelCountV;
+        float const alpha = pixel[ChannelCountV - 1];
+
+        for (uint8_t channel_index = 0; channel_index < ChannelCountV - 1; ++channel_index) {
+            pixel[channel_index] *= alpha;
+        }
+    }
+}
+
+template <uint8_t ChannelCountV>
+void divide_colors(std::span<uint8_t> values)
+{
+    for (size_t pixel_index = 0; pixel_index < values.size() / ChannelCountV; ++pixel_index) {
+        uint8_t* const pixel = values.data() + pixel_index * ChannelCountV;
+        uint32_t const alpha = pixel[ChannelCountV - 1];
+
+        for (uint8_t channel_index = 0; channel_index < ChannelCountV - 1; ++channel_index) {
+            uint32_t const color = (alpha == 0 ? 0 : (pixel[channel_index] * 255u + alpha / 2) / alpha);
+            pixel[channel_index] = static_cast<uint8_t>(std::min(color, 255u));
+        }
+    }
+}
+
+template <uint8_t ChannelCountV>
+void divide_colors(std::span<float> values)
+{
+    for (size_t pixel_index = 0; pixel_index < values.size() / ChannelCountV; ++pixel_index) {
+        float* const pixel = values.data() + pixel_index * ChannelCountV;
+        float const inverse_alpha = (pixel[ChannelCountV - 1] > 0.f ? 1.f / pixel[ChannelCountV - 1] : 0.f);
+
+        for (uint8_t channel_index = 0; channel_index < ChannelCountV - 1; ++channel_index) {
+            pixel[channel_index] *= inverse_alpha;
+        }
+    }
+}
+
+/// Applies an operation on the values of an image, band by band. sRGB values are linearized beforehand & delinearized
+///   afterward.
+/// \param image Image to process the values of.
+/// \param action Action to be performed, taking a span of either byte or float values.
+template <typename FuncT>
+void process_values(Image& image, FuncT const& action)
+{
+    size_t const row_value_count = static_cast<size_t>(image.get_width()) * image.get_channel_count();
+
+    auto const recover_band = [row_value_count](auto values, IndexRange const& range) {
+        return values.subspan(
+            range.begin_index * row_value_count, (range.end_index - range.begin_index) * row_value_count
+        );
+    };
+
+    if (has_srgb_values(image)) {
+        std::vector<float> linear_values = recover_linear_values(image);
+
+        process_rows(image.get_height(), row_value_count, [&](IndexRange const& range) {
+            action(recover_band(std::span<float>(linear_values), range));
+        });
+
+        convert_from_linear(linear_values, image);
+        ImageBufferPool::release(std::move(linear_values));
+    }
+    else if (image.get_data_type() == ImageDataType::BYTE) {
+        process_rows(image.get_height(), row_value_count, [&](IndexRange const& range) {
+            action(recover_band(image.get_byte_data(), range));
+        });
+    }
+    else {
+        process_rows(image.get_height(), row_value_count, [&](IndexRange const& range) {
+            action(recover_band(image.get_float_data(), range));
+        });
+    }
+}
+}
+
+Image resize(Image const& image, Vector2ui const& size, ResamplingFilter filter)
+{
+    ZoneScopedN("ImageProcessing::resize");
+
+    if (image.empty()) {
+        throw std::invalid_argument("[ImageProcessing] Cannot resize an empty image.");
+    }
+
+    if (size.x == 0 || size.y == 0) {
+        throw std::invalid_argument("[ImageProcessing] The new size of an image must be strictly positive.");
+    }
+
+    if (size == image.get_size()) {
+        return image;
+    }
+
+    std::vector<float> values = recover_linear_values(image);
+    std::vector<float> resized_values = resample(values, image.get_size(), image.get_channel_count(), size, filter);
+    ImageBufferPool::release(std::move(values));
+
+    Image resized_image = create_image(resized_values, size, image.get_colorspace(), image.get_data_type());
+    ImageBufferPool::release(std::move(resized_values));
+
+    return resized_image;
+}
+
+std::vector<Image> generate_mipmaps(Image const& image, ResamplingFilter filter)
+{
+    ZoneScopedN("ImageProcessing::generate_mipmaps");
+
+    if (image.empty()) {
+        throw std::invalid_argument("[ImageProcessing] Cannot generate the mipmaps of an empty image.");
+    }
+
+    Log::vdebug("[ImageProcessing] Generating mipmaps of {}x{} image...", image.get_width(), image.get_height());
+
+    std::vector<Image> mipmaps;
+    mipmaps.reserve(std::bit_width(std::max(image.get_width(), image.get_height())) - 1);
+
+    std::vector<float> level_values = recover_linear_values(image);
+    Vector2ui level_size = image.get_size();
+
+    while (level_size.x > 1 || level_size.y > 1) {
+        Vector2ui const mipmap_size(std::max(level_size.x / 2, 1u), std::max(level_size.y / 2, 1u));
+
+        // Even dimensions are exactly halved by a box filter, which then only averages 2x2 blocks
+        bool const is_exact_box = (filter == ResamplingFilter::BOX && (level_size.x % 2 == 0 || level_size.x == 1) &&
+                                   (level_size.y % 2 == 0 || level_size.y == 1));
+        std::vector<float> mipmap_values =
+            (is_exact_box ? downsample_box(level_values, level_size, image.get_channel_count(), mipmap_size)
+                          : resample(level_values, level_size, image.get_channel_count(), mipmap_size, filter));
+
+        mipmaps.emplace_back(create_image(mipmap_values, mipmap_size, image.get_colorspace(), image.get_data_type()));
+
+        ImageBufferPool::release(std::move(level_values));
+        level_values = std::move(mipmap_values);
+        level_size = mipmap_size;
+    }
+
+    ImageBufferPool::release(std::move(level_values));
+
+    Log::vdebug("[ImageProcessing] Generated {} mipmap(s)", mipmaps.size());
+
+    return mipmaps;
+}
+
+Image extract_channel(Image const& image, uint8_t channel_index)
+{
+    return swizzle(image, std::span<uint8_t const>(&channel_index, 1), ImageColorspace::GRAY);
+}
+
+Image swizzle(Image const& image, std::span<uint8_t const> channel_indices, ImageColorspace colorspace)
+{
+    std::vector<ImageChannel> channels;
+    channels.reserve(channel_indices.size());
+
+    for (uint8_t const channel_index : channel_indices) {
+        channels.push_back(ImageChannel{image, channel_index});
+    }
+
+    return merge_channels(channels, colorspace);
+}
+
+Image merge_channels(std::span<ImageChannel const> channels, ImageColorspace colorspace)
+{
+    ZoneScopedN("ImageProcessing::merge_channels");
+
+    if (channels.empty()) {
+        throw std::invalid_argument("[ImageProcessing] At least one channel is needed to create an image.");
+    }
+
+    Image const& first_image = channels.front().image;
+
+    for (ImageChannel const& channel : channels) {
+        if (channel.image.empty() || channel.image.get_size() != first_image.get_size() ||
+            channel.image.get_data_type() != first_image.get_data_type()) {
+            throw std::invalid_argument(
+                "[ImageProcessing] The images to copy channels from must be non-empty & have the same size & data type."
+            );
+        }
+
+        if (channel.index >= channel.image.get_channel_count()) {
+            throw std::invalid_argument("[ImageProcessing] The channel to be copied does not exist.");
+        }
+    }
+
+    if (Image(colorspace).get_channel_count() != channels.size()) {
+        throw std::invalid_argument("[ImageProcessing] The colorspace must have as many channels as are to be copied.");
+    }
+
+    Vector2ui const size = first_image.get_size();
+    size_t const value_count = static_cast<size_t>(size.x) * size.y * channels.size();
+
+    if (first_image.get_data_type() == ImageDataType::BYTE) {
+        Image merged_image(size, colorspace, ImageBufferPool::acquire_bytes(value_count));
+        copy_channels<uint8_t>(channels, merged_image);
+        return merged_image;
+    }
+
+    Image merged_image(size, colorspace, ImageBufferPool::acquire_floats(value_count));
+    copy_channels<float>(channels, merged_image);
+    return merged_image;
+}
+
+void premultiply_alpha(Image& image)
+{
+    ZoneScopedN("ImageProcessing::premultiply_alpha");
+
+    if (image.empty() || !has_alpha_channel(image)) {
+        return;
+    }
+
+    bool const has_two_channels = (image.get_channel_count() == 2);
+
+    process_values(image, [has_two_channels](auto values) {
+        if (has_two_channels) {
+            multiply_colors<2>(values);
+        }
+        else {
+            multiply_colors<4>(values);
+        }
+    });
+}
+
+void unpremultiply_alpha(Image& image)
+{
+    ZoneScopedN("ImageProcessing::unpremultiply_alpha");
+
+    if (image.empty() || !has_alpha_channel(image)) {
+        return;
+    }
+
+    bool const has_two_channels = (image.get_channel_count() == 2);
+
+    process_values(image, [has_two_channels](auto values) {
+        if (has_two_channels) {
+            divide_colors<2>(values);
+        }
+        else {
+            divide_colors<4>(values);
+        }
+    });
+}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <data/image.hpp>
+
+#include <span>
+
+namespace xen {
+enum class ResamplingFilter {
+    BOX,      ///< Averages the pixels covered by each resampled one. The fastest, & exact when halving dimensions.
+    TRIANGLE, ///< Interpolates linearly between the nearest pixels.
+    KAISER    ///< Kaiser-windowed sinc. The sharpest, at the cost of a slight ringing around strong edges.
+};
+
+/// Channel of an image, from which values are to be copied.
+struct ImageChannel {
+    Image const& image; ///< Image holding the channel.
+    uint8_t index{};    ///< Index of the channel in the image.
+};
+
+/// CPU image processing kernels. Images are processed in bands of rows, distributed across the default thread pool; the
+///   inner loops run over contiguous values with constant strides, for the compiler to vectorize them.
+/// \note Byte images are resampled in floating-point. sRGB ones are resampled in linear space, except for their alpha
+///   channel.
+namespace ImageProcessing {
+/// Resizes an image with a separable filter.
+/// \note Filtering does not weight the colors by the alpha values; premultiply them beforehand to avoid dark halos.
+/// \param image Image to be resized.
+/// \param size New size of the image; both dimensions must be strictly positive.
+/// \param filter Filter to resample the image with.
+/// \return Resized image, with the same colorspace & data type as the original one.
+/// \see premultiply_alpha()
+Image resize(Image const& image, Vector2ui const& size, ResamplingFilter filter = ResamplingFilter::TRIANGLE);
+
+/// Generates the mipmap chain of an image, each level being half the size of the previous one (rounded down) until
+///   reaching 1x1. Every level is computed from the previous one without being quantized in between.
+/// \note Filtering does not weight the colors by the alpha values; premultiply them beforehand to avoid dark halos.
+/// \param image Image to generate the mipmaps of.
+/// \param filter Filter to downsample the levels with.
+/// \return Mipmap levels, from the first one below the given image to the 1x1 one.
+std::vector<Image> generate_mipmaps(Image const& image, ResamplingFilter filter = ResamplingFilter::BOX);
+
+/// Creates a single-channel image from a channel of another one.
+/// \param image Image to extract the channel from.
+/// \param channel_index Index of the channel to be extracted.
+/// \return Gray image holding the channel's values.
+Image extract_channel(Image const& image, uint8_t channel_index);
+
+/// Creates an image from the reordered channels of another one.
+/// \param image Image to reorder the channels of.
+/// \param channel_indices Indices of the image's channels to copy into each channel of the new one, in order. A channel
+///   may be copied multiple times.
+/// \param colorspace Colorspace of the new image; must have as many channels as there are indices.
+/// \return Swizzled image.
+Image swizzle(Image const& image, std::span<uint8_t const> channel_indices, ImageColorspace colorspace);
+
+/// Creates an image from channels of other ones.
+/// \param channels Channels to copy into each channel of the new image, in order. Their images must all have the same
+///   size & data type.
+/// \param colorspace Colorspace of the new image; must have as many channels as are given.
+/// \return Merged image.
+Image merge_channels(std::span<ImageChannel const> channels, ImageColorspace colorspace);
+
+/// Multiplies the colors of an image by its alpha channel. Does nothing if the image has no alpha channel.
+/// \note The colors of sRGB images are multiplied in linear space.
+/// \param image Image to premultiply the colors of.
+void premultiply_alpha(Image& image);
+
+/// Divides the colors of an image by its alpha channel, fully transparent pixels becoming black. Does nothing if the
+///   image has no alpha channel.
+/// \note The colors of sRGB images are divided in linear space.
+/// \param image Image to unpremultiply the colors of.
+void unpremultiply_alpha(Image& image);
+}
+}
@@ -0,0 +1,205 @@
+#include "image_utils.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <bit>
+
+namespace xen::ImageUtils {
+namespace {
+float compute_linear_value(float srgb_value)
+{
+    return (srgb_value <= 0.04045f ? srgb_value / 12.92f : std::pow((srgb_value + 0.055f) / 1.055f, 2.4f));
+}
+
+/// Recovers the linear values of all 8-bit sRGB values.
+std::array<float, 256> const& recover_linear_table()
+{
+    static std::array<float, 256> const linear_table = []() {
+        std::array<float, 256> table{};
+
+        for (size_t srgb_value = 0; srgb_value < table.size(); ++srgb_value) {
+            table[srgb_value] = compute_linear_value(static_cast<float>(srgb_value) / 255.f);
+        }
+
+        return table;
+    }();
+
+    return linear_table;
+}
+
+/// Recovers the linear values halfway between two consecutive 8-bit sRGB values. The number of thresholds below a
+///   linear value gives the sRGB value it is closest to, without having to compute any power.
+std::array<float, 255> const& recover_srgb_thresholds()
+{
+    static std::array<float, 255> const srgb_thresholds = []() {
+        std::array<float, 255> thresholds{};
+
+        for (size_t srgb_value = 0; srgb_value < thresholds.size(); ++srgb_value) {
+            thresholds[srgb_value] = compute_linear_value((static_cast<float>(srgb_value) + 0.5f) / 255.f);
+        }
+
+        return thresholds;
+    }();
+
+    return srgb_thresholds;
+}
+
+constexpr bool is_alpha_channel(uint8_t channel_index, uint8_t channel_count)
+{
+    return ((channel_count == 2 || channel_count == 4) && channel_index == channel_count - 1);
+}
+
+/// Selects a value without branching, which compilers may otherwise do even for conditional expressions.
+constexpr uint32_t select(bool condition, uint32_t true_value, uint32_t false_value)
+{
+    uint32_t const mask = 0u - static_cast<uint32_t>(condition);
+    return ((true_value & mask) | (false_value & ~mask));
+}
+
+uint16_t to_half(float value)
+{
+    uint32_t const bits = std::bit_cast<uint32_t>(value);
+    uint32_t const sign = (bits >> 16u) & 0x8000u;
+    uint32_t const absolute_bits = bits & 0x7FFFFFFFu;
+
+    // Every case is computed & the right one selected afterward, which keeps the loops calling this vectorizable.
+    // See MeshOptimizer::to_half() for the details of each case
+    uint32_t const normal_bits = (absolute_bits - 0x38000000u + 0xFFFu + ((absolute_bits >> 13u) & 1u)) >> 13u;
+    // Adding 0.5 aligns the value's mantissa on units of 2^-24, rounding it to nearest even
+    uint32_t const subnormal_bits = std::bit_cast<uint32_t>(std::bit_cast<float>(absolute_bits) + 0.5f) - 0x3F000000u;
+    uint32_t const special_bits = 0x7C00u | select(absolute_bits > 0x7F800000u, 0x200u, 0u);
+
+    uint32_t half_bits = select(absolute_bits < 0x38800000u, subnormal_bits, normal_bits);
+    half_bits = select(absolute_bits >= 0x477FF000u, 0x7C00u, half_bits);
+    half_bits = select(absolute_bits >= 0x7F800000u, special_bits, half_bits);
+
+    return static_cast<uint16_t>(sign | half_bits);
+}
+}
+
+float from_half(uint16_t value)
+{
+    uint32_t const sign = (value & 0x8000u) << 16u;
+    uint32_t const exponent = (value >> 10u) & 0x1Fu;
+    uint32_t const mantissa = value & 0x3FFu;
+
+    uint32_t const normal_bits = ((exponent + 112u) << 23u) | (mantissa << 13u);
+    uint32_t const subnormal_bits = std::bit_cast<uint32_t>(static_cast<float>(mantissa) * (1.f / 16777216.f));
+    uint32_t const special_bits = 0x7F800000u | (mantissa << 13u);
+
+    uint32_t float_bits = select(exponent == 0, subnormal_bits, normal_bits);
+    float_bits = select(exponent == 31, special_bits, float_bits);
+
+    return std::bit_cast<float>(sign | float_bits);
+}
+
+void flip_vertically(std::span<uint8_t> data, size_t row_size)
+{
+    ZoneScopedN("ImageUtils::flip_vertically");
+
+    size_t const row_count = data.size() / row_size;
+
+    for (size_t row_index = 0; row_index < row_count / 2; ++row_index) {
+        uint8_t* const top_row = data.data() + row_index * row_size;
+        uint8_t* const bottom_row = data.data() + (row_count - row_index - 1) * row_size;
+
+        std::swap_ranges(top_row, top_row + row_size, bottom_row);
+    }
+}
+
+void copy_rows(std::span<uint8_t const> input, std::span<uint8_t> output, size_t row_size, bool flip_vertically)
+{
+    ZoneScopedN("ImageUtils::copy_rows");
+
+    if (!flip_vertically) {
+        std::memcpy(output.data(), input.data(), input.size());
+        return;
+    }
+
+    size_t const row_count = input.size() / row_size;
+
+    for (size_t row_index = 0; row_index < row_count; ++row_index) {
+        std::memcpy(
+            output.data() + (row_count - row_index - 1) * row_size, input.data() + row_index * row_size, row_size
+        );
+    }
+}
+
+void expand_rgb_to_rgba(std::span<uint8_t const> rgb_values, std::span<uint8_t> rgba_values)
+{
+    ZoneScopedN("ImageUtils::expand_rgb_to_rgba");
+
+    for (size_t pixel_index = 0; pixel_index < rgb_values.size() / 3; ++pixel_index) {
+        rgba_values[pixel_index * 4] = rgb_values[pixel_index * 3];
+        rgba_values[pixel_index * 4 + 1] = rgb_values[pixel_index * 3 + 1];
+        rgba_values[pixel_index * 4 + 2] = rgb_values[pixel_index * 3 + 2];
+        rgba_values[pixel_index * 4 + 3] = 255;
+    }
+}
+
+void expand_rgb_to_rgba(std::span<float const> rgb_values, std::span<float> rgba_values)
+{
+    ZoneScopedN("ImageUtils::expand_rgb_to_rgba");
+
+    for (size_t pixel_index = 0; pixel_index < rgb_values.size() / 3; ++pixel_index) {
+        rgba_values[pixel_index * 4] = rgb_values[pixel_index * 3];
+        rgba_values[pixel_index * 4 + 1] = rgb_values[pixel_index * 3 + 1];
+        rgba_values[pixel_index * 4 + 2] = rgb_values[pixel_index * 3 + 2];
+        rgba_values[pixel_index * 4 + 3] = 1.f;
+    }
+}
+
+void convert_srgb_to_linear(std::span<uint8_t const> srgb_values, std::span<float> linear_values, uint8_t channel_count)
+{
+    ZoneScopedN("ImageUtils::convert_srgb_to_linear");
+
+    std::array<float, 256> const& linear_table = recover_linear_table();
+
+    for (size_t value_index = 0; value_index < srgb_values.size(); ++value_index) {
+        uint8_t const srgb_value = srgb_values[value_index];
+        auto const channel_index = static_cast<uint8_t>(value_index % channel_count);
+
+        linear_values[value_index] = (is_alpha_channel(channel_index, channel_count)
+                                          ? static_cast<float>(srgb_value) / 255.f
+                                          : linear_table[srgb_value]);
+    }
+}
+
+void convert_linear_to_srgb(std::span<float const> linear_values, std::span<uint8_t> srgb_values, uint8_t channel_count)
+{
+    ZoneScopedN("ImageUtils::convert_linear_to_srgb");
+
+    std::array<float, 255> const& srgb_thresholds = recover_srgb_thresholds();
+
+    for (size_t value_index = 0; value_index < linear_values.size(); ++value_index) {
+        float const linear_value = linear_values[value_index];
+        auto const channel_index = static_cast<uint8_t>(value_index % channel_count);
+
+        if (is_alpha_channel(channel_index, channel_count)) {
+            srgb_values[value_index] = static_cast<uint8_t>(std::clamp(linear_value, 0.f, 1.f) * 255.f + 0.5f);
+            continue;
+        }
+
+        auto const threshold_iter = std::upper_bound(srgb_thresholds.cbegin(), srgb_thresholds.cend(), linear_value);
+        srgb_values[value_index] = static_cast<uint8_t>(threshold_iter - srgb_thresholds.cbegin());
+    }
+}
+
+void convert_float_to_half(std::span<float const> values, std::span<uint16_t> half_values)
+{
+    ZoneScopedN("ImageUtils::convert_float_to_half");
+
+    for (size_t value_index = 0; value_index < values.size(); ++value_index) {
+        half_values[value_index] = to_half(values[value_index]);
+    }
+}
+
+void convert_half_to_float(std::span<uint16_t const> half_values, std::span<float> values)
+{
+    ZoneScopedN("ImageUtils::convert_half_to_float");
+
+    for (size_t value_index = 0; value_index < half_values.size(); ++value_index) {
+        values[value_index] = from_half(half_values[value_index]);
+    }
+}
+}
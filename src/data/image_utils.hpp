@@ -0,0 +1,68 @@
+#pragma once
+
+#include <span>
+
+namespace xen {
+/// Bulk pixel operations over contiguous image values. They are written as plain loops over spans, branchless whenever
+///   possible, for the compiler to vectorize them.
+/// \see Image
+namespace ImageUtils {
+/// Converts a half-precision floating-point value to single precision.
+/// \note Branchless, so that loops calling it can be vectorized.
+/// \param value Bits of the half-precision value.
+/// \return Converted value.
+float from_half(uint16_t value);
+
+/// Flips rows of values vertically, in place.
+/// \param data Values of all the rows.
+/// \param row_size Size of a row, in bytes.
+void flip_vertically(std::span<uint8_t> data, size_t row_size);
+
+/// Copies rows of values, optionally flipping them vertically at the same time.
+/// \param input Rows to be copied.
+/// \param output Copied rows; must be at least as large as the input.
+/// \param row_size Size of a row, in bytes.
+/// \param flip_vertically True to copy the rows in reverse order, false otherwise.
+void copy_rows(std::span<uint8_t const> input, std::span<uint8_t> output, size_t row_size, bool flip_vertically);
+
+/// Expands RGB values to RGBA ones, the alpha channel being fully opaque.
+/// \param rgb_values RGB values to be expanded.
+/// \param rgba_values Expanded values; must hold 4 values for every 3 RGB ones.
+void expand_rgb_to_rgba(std::span<uint8_t const> rgb_values, std::span<uint8_t> rgba_values);
+
+/// Expands RGB values to RGBA ones, the alpha channel being fully opaque.
+/// \param rgb_values RGB values to be expanded.
+/// \param rgba_values Expanded values; must hold 4 values for every 3 RGB ones.
+void expand_rgb_to_rgba(std::span<float const> rgb_values, std::span<float> rgba_values);
+
+/// Converts sRGB values to linear ones, in the [0; 1] range. With 2 or 4 channels, the last one is considered to be an
+///   alpha channel, which is only normalized.
+/// \param srgb_values sRGB values to be converted.
+/// \param linear_values Linear values; must be at least as large as the sRGB ones.
+/// \param channel_count Number of channels of each pixel.
+void convert_srgb_to_linear(
+    std::span<uint8_t const> srgb_values, std::span<float> linear_values, uint8_t channel_count
+);
+
+/// Converts linear values to sRGB ones, rounding them to the nearest. With 2 or 4 channels, the last one is considered
+///   to be an alpha channel, which is only quantized.
+/// \param linear_values Linear values to be converted; they are clamped to the [0; 1] range.
+/// \param srgb_values sRGB values; must be at least as large as the linear ones.
+/// \param channel_count Number of channels of each pixel.
+void convert_linear_to_srgb(
+    std::span<float const> linear_values, std::span<uint8_t> srgb_values, uint8_t channel_count
+);
+
+/// Converts single-precision floating-point values to half-precision ones, rounding to nearest even.
+/// \param values Values to be converted.
+/// \param half_values Bits of the half-precision values; must be at least as large as the input.
+/// \see MeshOptimizer::to_half()
+void convert_float_to_half(std::span<float const> values, std::span<uint16_t> half_values);
+
+/// Converts half-precision floating-point values to single-precision ones.
+/// \param half_values Bits of the half-precision values to be converted.
+/// \param values Converted values; must be at least as large as the input.
+/// \see from_half()
+void convert_half_to_float(std::span<uint16_t const> half_values, std::span<float> values);
+}
+}
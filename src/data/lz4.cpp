@@ -0,0 +1,227 @@
+#include "lz4.hpp"
+
+#include <tracy/Tracy.hpp>
+
+namespace xen::Lz4 {
+namespace {
+constexpr size_t min_match_size = 4;
+/// The last bytes of a block are always literals.
+constexpr size_t last_literal_count = 5;
+/// The last match must start at least this number of bytes before the end of the block.
+constexpr size_t last_match_distance = 12;
+constexpr size_t max_offset = 65535;
+constexpr uint32_t hash_bit_count = 12;
+
+uint32_t read_uint32(uint8_t const* data)
+{
+    uint32_t value{};
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32_t compute_hash(uint32_t sequence)
+{
+    return ((sequence * 2654435761u) >> (32 - hash_bit_count));
+}
+
+/// Writes a length exceeding what a token's field can hold, as a series of bytes summing up to it.
+/// \param block Block to write the length into.
+/// \param length Remaining length, once the field's maximum value has been subtracted.
+void write_extra_length(std::vector<uint8_t>& block, size_t length)
+{
+    for (; length >= 255; length -= 255) {
+        block.emplace_back(255);
+    }
+
+    block.emplace_back(static_cast<uint8_t>(length));
+}
+
+void write_sequence(
+    std::vector<uint8_t>& block, std::span<uint8_t const> literals, size_t match_offset, size_t match_size
+)
+{
+    size_t const match_length = (match_size == 0 ? 0 : match_size - min_match_size);
+
+    block.emplace_back(
+        static_cast<uint8_t>((std::min<size_t>(literals.size(), 15) << 4u) | std::min<size_t>(match_length, 15))
+    );
+
+    if (literals.size() >= 15) {
+        write_extra_length(block, literals.size() - 15);
+    }
+
+    block.insert(block.end(), literals.begin(), literals.end());
+
+    // The last sequence only holds literals
+    if (match_size == 0) {
+        return;
+    }
+
+    block.emplace_back(static_cast<uint8_t>(match_offset & 255u));
+    block.emplace_back(static_cast<uint8_t>(match_offset >> 8u));
+
+    if (match_length >= 15) {
+        write_extra_length(block, match_length - 15);
+    }
+}
+
+/// Reads a length exceeding what a token's field can hold.
+/// \param block Compressed block.
+/// \param offset Offset of the length's first byte in the block; advanced past its last one.
+/// \return Remaining length.
+size_t read_extra_length(std::span<uint8_t const> block, size_t& offset)
+{
+    size_t length = 0;
+    uint8_t byte{};
+
+    do {
+        if (offset >= block.size()) {
+            throw std::invalid_argument("[Lz4] Unexpected end of block");
+        }
+
+        byte = block[offset++];
+        length += byte;
+    } while (byte == 255);
+
+    return length;
+}
+}
+
+std::vector<uint8_t> compress(std::span<uint8_t const> data)
+{
+    ZoneScopedN("Lz4::compress");
+
+    std::vector<uint8_t> block;
+    block.reserve(compute_max_compressed_size(data.size()));
+
+    size_t literal_start = 0;
+
+    if (data.size() > last_match_distance) {
+        // Positions of the last sequences having each hash, offset by 1 so that 0 marks an empty slot
+        std::vector<uint32_t> positions(1u << hash_bit_count);
+
+        size_t const match_start_limit = data.size() - last_match_distance;
+        size_t const match_end_limit = data.size() - last_literal_count;
+        size_t position = 0;
+
+        while (position < match_start_limit) {
+            uint32_t const sequence = read_uint32(data.data() + position);
+            uint32_t& hashed_position = positions[compute_hash(sequence)];
+            size_t const candidate_position = hashed_position;
+            hashed_position = static_cast<uint32_t>(position + 1);
+
+            if (candidate_position == 0 || position - (candidate_position - 1) > max_offset ||
+                read_uint32(data.data() + candidate_position - 1) != sequence) {
+                ++position;
+                continue;
+            }
+
+            size_t match_position = candidate_position - 1;
+
+            // Extending the match backward over the pending literals
+            while (position > literal_start && match_position > 0 && data[position - 1] == data[match_position - 1]) {
+                --position;
+                --match_position;
+            }
+
+            size_t match_size = min_match_size;
+
+            while (position + match_size < match_end_limit &&
+                   data[position + match_size] == data[match_position + match_size]) {
+                ++match_size;
+            }
+
+            write_sequence(
+                block, data.subspan(literal_start, position - literal_start), position - match_position, match_size
+            );
+
+            position += match_size;
+            literal_start = position;
+        }
+    }
+
+    write_sequence(block, data.subspan(literal_start), 0, 0);
+
+    return block;
+}
+
+void decompress(std::span<uint8_t const> block, std::span<uint8_t> data)
+{
+    ZoneScopedN("Lz4::decompress");
+
+    size_t block_offset = 0;
+    size_t data_offset = 0;
+
+    while (true) {
+        if (block_offset >= block.size()) {
+            throw std::invalid_argument("[Lz4] Unexpected end of block");
+        }
+
+        uint8_t const token = block[block_offset++];
+
+        size_t literal_count = (token >> 4u);
+
+        if (literal_count == 15) {
+            literal_count += read_extra_length(block, block_offset);
+        }
+
+        if (literal_count > block.size() - block_offset || literal_count > data.size() - data_offset) {
+            throw std::invalid_argument("[Lz4] Literals exceeding the block or the decompressed data");
+        }
+
+        if (literal_count > 0) {
+            std::memcpy(data.data() + data_offset, block.data() + block_offset, literal_count);
+        }
+
+        block_offset += literal_count;
+        data_offset += literal_count;
+
+        // The last sequence ends the block right after its literals
+        if (block_offset == block.size()) {
+            break;
+        }
+
+        if (block.size() - block_offset < 2) {
+            throw std::invalid_argument("[Lz4] Unexpected end of block");
+        }
+
+        size_t const match_offset = block[block_offset] | (static_cast<size_t>(block[block_offset + 1]) << 8u);
+        block_offset += 2;
+
+        if (match_offset == 0 || match_offset > data_offset) {
+            throw std::invalid_argument("[Lz4] Invalid match offset");
+        }
+
+        size_t match_size = (token & 15u);
+
+        if (match_size == 15) {
+            match_size += read_extra_length(block, block_offset);
+        }
+
+        match_size += min_match_size;
+
+        if (match_size > data.size() - data_offset) {
+            throw std::invalid_argument("[Lz4] Match exceeding the decompressed data");
+        }
+
+        uint8_t* const output = data.data() + data_offset;
+        uint8_t const* const match = output - match_offset;
+
+        // Matches may overlap the bytes they produce, repeating a pattern shorter than themselves
+        if (match_offset >= match_size) {
+            std::memcpy(output, match, match_size);
+        }
+        else {
+            for (size_t byte_index = 0; byte_index < match_size; ++byte_index) {
+                output[byte_index] = match[byte_index];
+            }
+        }
+
+        data_offset += match_size;
+    }
+
+    if (data_offset != data.size()) {
+        throw std::invalid_argument("[Lz4] The decompressed size does not match the expected one");
+    }
+}
+}
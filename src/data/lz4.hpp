@@ -0,0 +1,29 @@
+#pragma once
+
+#include <span>
+
+namespace xen {
+/// Compression in the LZ4 block format, favoring the decompression speed over the ratio. Blocks are compatible with any
+///   LZ4 implementation, without the frame format's headers & checksums.
+/// \see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+namespace Lz4 {
+/// Computes the size of the largest block that compressing the given number of bytes can produce.
+/// \param data_size Number of bytes to be compressed.
+/// \return Maximum size of the compressed block.
+constexpr size_t compute_max_compressed_size(size_t data_size)
+{
+    return data_size + data_size / 255 + 16;
+}
+
+/// Compresses data into a single block, greedily matching the repeated sequences of at least 4 bytes.
+/// \param data Data to be compressed.
+/// \return Compressed block.
+std::vector<uint8_t> compress(std::span<uint8_t const> data);
+
+/// Decompresses a block.
+/// \param block Compressed block.
+/// \param data Buffer to decompress the block into; must have exactly the block's decompressed size.
+/// \throws std::invalid_argument If the block is malformed or does not match the buffer's size.
+void decompress(std::span<uint8_t const> block, std::span<uint8_t> data);
+}
+}
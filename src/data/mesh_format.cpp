@@ -1,11 +1,15 @@
 #include <data/mesh_format.hpp>
 
+#include <data/asset_cache.hpp>
 #include <data/fbx_format.hpp>
 #include <data/gltf_format.hpp>
 #include <data/mesh.hpp>
 #include <data/obj_format.hpp>
 #include <data/off_format.hpp>
+#include <data/xmesh_format.hpp>
 #include <render/mesh_renderer.hpp>
+#include <utils/file_utils.hpp>
+#include <utils/file_watcher.hpp>
 #include <utils/filepath.hpp>
 #include <utils/str_utils.hpp>
 
@@ -24,22 +28,19 @@ static auto& get_mesh_cache()
     static std::map<std::string, MeshCache> mesh_cache;
     return mesh_cache;
 }
-std::pair<std::shared_ptr<Mesh>, MeshRenderer> load(FilePath const& filepath)
+static std::pair<Mesh, MeshRendererData> load_from_file(FilePath const& filepath)
 {
-    ZoneScopedN("MeshFormat::load");
-    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
-
-    auto& mesh_cache = get_mesh_cache();
-    if (auto it = mesh_cache.find(filepath.to_utf8()); it != mesh_cache.cend()) {
-        return it->second.get_shared();
-    }
-
     std::string const file_extension = StrUtils::to_lower_copy(filepath.recover_extension().to_utf8());
 
     Mesh temp_mesh;
     MeshRendererData temp_mesh_renderer_data;
 
-    if (file_extension == "gltf" || file_extension == "glb") {
+    if ((file_extension == "gltf" || file_extension == "glb" || file_extension == "obj") && AssetCache::is_enabled()) {
+        auto loaded_data = AssetCache::load_mesh(filepath);
+        temp_mesh = std::move(loaded_data.first);
+        temp_mesh_renderer_data = std::move(loaded_data.second);
+    }
+    else if (file_extension == "gltf" || file_extension == "glb") {
         auto loaded_data = GltfFormat::load(filepath);
         temp_mesh = std::move(loaded_data.first);
         temp_mesh_renderer_data = std::move(loaded_data.second);
@@ -49,6 +50,11 @@ std::pair<std::shared_ptr<Mesh>, MeshRenderer> load(FilePath const& filepath)
         temp_mesh = std::move(loaded_data.first);
         temp_mesh_renderer_data = std::move(loaded_data.second);
     }
+    else if (file_extension == "xmesh") {
+        auto loaded_data = XmeshFormat::load(filepath);
+        temp_mesh = std::move(loaded_data.first);
+        temp_mesh_renderer_data = std::move(loaded_data.second);
+    }
     else if (file_extension == "off") {
         //     auto loaded_mesh = OffFormat::load(filepath);
         //     temp_mesh_renderer = MeshRenderer(loaded_mesh);
@@ -65,6 +71,78 @@ std::pair<std::shared_ptr<Mesh>, MeshRenderer> load(FilePath const& filepath)
 #endif
     }
 
+    return {std::move(temp_mesh), std::move(temp_mesh_renderer_data)};
+}
+
+/// Parses a mesh from a file, without creating its graphics resources when its format allows it.
+/// \param filepath Path to the mesh file.
+/// \return Function finishing the loading, to be called from the thread owning the graphics context.
+static std::function<std::pair<Mesh, MeshRendererData>()> parse_file(FilePath const& filepath)
+{
+    std::string const file_extension = StrUtils::to_lower_copy(filepath.recover_extension().to_utf8());
+
+    // Cached assets need the graphics resources to be cooked, & XMESH files are uploaded straight from their mapping;
+    //   both are thus entirely loaded afterward
+    if (AssetCache::is_enabled() || (file_extension != "gltf" && file_extension != "glb" && file_extension != "obj")) {
+        return [filepath]() { return load_from_file(filepath); };
+    }
+
+    // The mesh being move-only, it is shared to be held by the returned function
+    auto parsed_data = std::make_shared<std::pair<Mesh, std::function<MeshRendererData(Mesh const&)>>>(
+        file_extension == "obj" ? ObjFormat::parse(filepath) : GltfFormat::parse(filepath)
+    );
+
+    return [parsed_data = std::move(parsed_data)]() -> std::pair<Mesh, MeshRendererData> {
+        auto& [mesh, load_renderer] = *parsed_data;
+        MeshRendererData mesh_renderer_data = load_renderer(mesh);
+
+        return {std::move(mesh), std::move(mesh_renderer_data)};
+    };
+}
+
+/// Watches a cached mesh's file, reloading the mesh in place when it is modified; all the mesh renderers sharing its
+///   data are thus updated. The file is parsed on the watcher's thread, only the graphics resources being created on
+///   the main thread.
+/// \note Only the mesh's main file is watched, not the files it depends on (e.g. OBJ materials).
+/// \param filepath Path to the mesh file.
+static void watch_mesh(FilePath const& filepath)
+{
+    FileWatcher::watch(filepath, [filepath]() -> FileWatcher::ApplyFunc {
+        if (!FileUtils::is_readable(filepath)) {
+            throw std::invalid_argument("[MeshFormat] The mesh file '" + filepath + "' cannot be read.");
+        }
+
+        std::function<std::pair<Mesh, MeshRendererData>()> create_mesh = parse_file(filepath);
+
+        return [filepath, create_mesh = std::move(create_mesh)]() {
+            ZoneScopedN("[MeshFormat]::reload");
+
+            auto& mesh_cache = get_mesh_cache();
+            auto const cache_iter = mesh_cache.find(filepath.to_utf8());
+
+            if (cache_iter == mesh_cache.end()) {
+                return;
+            }
+
+            auto [mesh, mesh_renderer_data] = create_mesh();
+            *cache_iter->second.mesh = std::move(mesh);
+            *cache_iter->second.mesh_renderer_data = std::move(mesh_renderer_data);
+        };
+    });
+}
+
+std::pair<std::shared_ptr<Mesh>, MeshRenderer> load(FilePath const& filepath)
+{
+    ZoneScopedN("MeshFormat::load");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    auto& mesh_cache = get_mesh_cache();
+    if (auto it = mesh_cache.find(filepath.to_utf8()); it != mesh_cache.cend()) {
+        return it->second.get_shared();
+    }
+
+    auto [temp_mesh, temp_mesh_renderer_data] = load_from_file(filepath);
+
     auto shared_mesh = std::make_shared<Mesh>(std::move(temp_mesh));
 
     auto cached_entry = mesh_cache.emplace(
@@ -75,6 +153,8 @@ std::pair<std::shared_ptr<Mesh>, MeshRenderer> load(FilePath const& filepath)
         }
     );
 
+    watch_mesh(filepath);
+
     return cached_entry.first->second.get_shared();
 }
 
@@ -88,6 +168,9 @@ void save(FilePath const& filepath, Mesh const& mesh, MeshRenderer const* mesh_r
     if (file_extension == "obj") {
         // ObjFormat::save(filepath, mesh, mesh_renderer);
     }
+    else if (file_extension == "xmesh") {
+        XmeshFormat::save(filepath, mesh, (mesh_renderer != nullptr ? mesh_renderer->get_data().get() : nullptr));
+    }
     else {
         throw std::invalid_argument(
             "[MeshFormat] Unsupported mesh file extension '" + file_extension + "' for saving."
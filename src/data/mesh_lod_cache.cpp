@@ -0,0 +1,250 @@
+#include "mesh_lod_cache.hpp"
+
+#include <utils/file_utils.hpp>
+#include <utils/filepath.hpp>
+#include <utils/hash.hpp>
+#include <utils/mapped_file.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <filesystem>
+
+namespace xen::MeshLodCache {
+namespace {
+/// Version of the cached data, to be incremented whenever the simplifier's output or the file layout changes so that
+/// older files get ignored.
+constexpr uint32_t cache_version = 1;
+constexpr std::array<char, 4> magic_number = {'X', 'L', 'O', 'D'};
+constexpr size_t vertex_float_count = 11;
+
+FilePath cache_directory = "cache/meshes";
+bool cache_enabled = true;
+
+uint64_t compute_hash(Mesh const& mesh, std::vector<float> const& ratios)
+{
+    ZoneScopedN("[MeshLodCache]::compute_hash");
+
+    uint64_t hash = Hash::compute_fnv1a(cache_version);
+
+    for (Submesh const& submesh : mesh.get_submeshes()) {
+        for (Vertex const& vertex : submesh.get_vertices()) {
+            std::array<float, vertex_float_count> const values = {
+                vertex.position.x, vertex.position.y, vertex.position.z, vertex.texcoords.x, vertex.texcoords.y,
+                vertex.normal.x,   vertex.normal.y,   vertex.normal.z,   vertex.tangent.x,   vertex.tangent.y,
+                vertex.tangent.z
+            };
+            hash = Hash::compute_fnv1a(values, hash);
+        }
+
+        std::vector<uint32_t> const& indices = submesh.get_triangle_indices();
+        hash = Hash::compute_fnv1a(
+            reinterpret_cast<uint8_t const*>(indices.data()), indices.size() * sizeof(uint32_t), hash
+        );
+        hash = Hash::compute_fnv1a(indices.size(), hash);
+    }
+
+    for (float const ratio : ratios) {
+        hash = Hash::compute_fnv1a(ratio, hash);
+    }
+
+    return hash;
+}
+
+template <typename T>
+void write_value(std::vector<uint8_t>& buffer, T const& value)
+{
+    auto const* bytes = reinterpret_cast<uint8_t const*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+class Reader {
+public:
+    explicit Reader(MappedFile const& file) : file{file} {}
+
+    template <typename T>
+    T read_value()
+    {
+        T value{};
+        read_bytes(&value, sizeof(T));
+        return value;
+    }
+
+    void read_bytes(void* data, size_t data_size)
+    {
+        if (offset + data_size > file.size()) {
+            throw std::runtime_error("[MeshLodCache] Unexpected end of file");
+        }
+
+        std::memcpy(data, file.data() + offset, data_size);
+        offset += data_size;
+    }
+
+private:
+    MappedFile const& file;
+    size_t offset = 0;
+};
+
+std::vector<MeshSimplifier::Level> load_levels(FilePath const& filepath)
+{
+    ZoneScopedN("[MeshLodCache]::load_levels");
+
+    MappedFile const file(filepath);
+    Reader reader(file);
+
+    if (reader.read_value<std::array<char, 4>>() != magic_number || reader.read_value<uint32_t>() != cache_version) {
+        throw std::runtime_error("[MeshLodCache] '" + filepath + "' is not a valid cache file");
+    }
+
+    std::vector<MeshSimplifier::Level> levels;
+    levels.resize(reader.read_value<uint32_t>());
+
+    for (MeshSimplifier::Level& level : levels) {
+        level.error = reader.read_value<float>();
+        level.mesh.get_submeshes().resize(reader.read_value<uint32_t>());
+
+        for (Submesh& submesh : level.mesh.get_submeshes()) {
+            std::vector<Vertex>& vertices = submesh.get_vertices();
+            std::vector<uint32_t>& indices = submesh.get_triangle_indices();
+
+            vertices.resize(reader.read_value<uint32_t>());
+            indices.resize(reader.read_value<uint32_t>());
+
+            for (Vertex& vertex : vertices) {
+                std::array<float, vertex_float_count> values{};
+                reader.read_bytes(values.data(), sizeof(values));
+
+                vertex.position = Vector3f(values[0], values[1], values[2]);
+                vertex.texcoords = Vector2f(values[3], values[4]);
+                vertex.normal = Vector3f(values[5], values[6], values[7]);
+                vertex.tangent = Vector3f(values[8], values[9], values[10]);
+            }
+
+            reader.read_bytes(indices.data(), indices.size() * sizeof(uint32_t));
+
+            if (std::any_of(indices.cbegin(), indices.cend(), [&vertices](uint32_t index) {
+                    return index >= vertices.size();
+                })) {
+                throw std::runtime_error("[MeshLodCache] Invalid vertex index in '" + filepath + '\'');
+            }
+
+            submesh.compute_bounding_box();
+        }
+
+        level.mesh.compute_bounding_box();
+    }
+
+    return levels;
+}
+
+void save_levels(FilePath const& filepath, std::vector<MeshSimplifier::Level> const& levels)
+{
+    ZoneScopedN("[MeshLodCache]::save_levels");
+
+    std::vector<uint8_t> buffer;
+    buffer.insert(buffer.end(), magic_number.cbegin(), magic_number.cend());
+    write_value(buffer, cache_version);
+    write_value(buffer, static_cast<uint32_t>(levels.size()));
+
+    for (MeshSimplifier::Level const& level : levels) {
+        write_value(buffer, level.error);
+        write_value(buffer, static_cast<uint32_t>(level.mesh.get_submeshes().size()));
+
+        for (Submesh const& submesh : level.mesh.get_submeshes()) {
+            write_value(buffer, static_cast<uint32_t>(submesh.get_vertex_count()));
+            write_value(buffer, static_cast<uint32_t>(submesh.get_triangle_index_count()));
+
+            for (Vertex const& vertex : submesh.get_vertices()) {
+                write_value(
+                    buffer,
+                    std::array<float, vertex_float_count>{
+                        vertex.position.x, vertex.position.y, vertex.position.z, vertex.texcoords.x,
+                        vertex.texcoords.y, vertex.normal.x, vertex.normal.y, vertex.normal.z, vertex.tangent.x,
+                        vertex.tangent.y, vertex.tangent.z
+                    }
+                );
+            }
+
+            for (uint32_t const index : submesh.get_triangle_indices()) {
+                write_value(buffer, index);
+            }
+        }
+    }
+
+    try {
+        std::filesystem::create_directories(std::filesystem::path(cache_directory.get_path()));
+
+        // Writing to a temporary file first, so that a partially written file can never be read
+        FilePath const temp_filepath = filepath + ".tmp";
+
+        {
+            std::ofstream file(temp_filepath, std::ios_base::binary);
+            file.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+            if (!file) {
+                throw std::runtime_error("[MeshLodCache] Failed to write '" + temp_filepath + '\'');
+            }
+        }
+
+        std::filesystem::rename(
+            std::filesystem::path(temp_filepath.get_path()), std::filesystem::path(filepath.get_path())
+        );
+    }
+    catch (std::exception const& exception) {
+        Log::vwarning("[MeshLodCache] Failed to save the mesh levels to the cache: {}", exception.what());
+    }
+}
+}
+
+void set_directory(FilePath const& directory)
+{
+    cache_directory = directory;
+}
+
+FilePath const& get_directory()
+{
+    return cache_directory;
+}
+
+void enable(bool enabled)
+{
+    cache_enabled = enabled;
+}
+
+void disable()
+{
+    enable(false);
+}
+
+bool is_enabled()
+{
+    return cache_enabled;
+}
+
+std::vector<MeshSimplifier::Level> generate_levels(Mesh const& mesh, std::vector<float> const& ratios)
+{
+    ZoneScopedN("MeshLodCache::generate_levels");
+
+    if (!cache_enabled) {
+        return MeshSimplifier::generate_levels(mesh, ratios);
+    }
+
+    FilePath const cache_filepath =
+        cache_directory + ('/' + Hash::to_hex_string(compute_hash(mesh, ratios)) + ".xlod");
+
+    if (FileUtils::is_readable(cache_filepath)) {
+        try {
+            std::vector<MeshSimplifier::Level> levels = load_levels(cache_filepath);
+            Log::debug("[MeshLodCache] Found mesh levels in cache ('" + cache_filepath + "')");
+            return levels;
+        }
+        catch (std::exception const& exception) {
+            Log::vwarning("[MeshLodCache] Invalid cached mesh levels, generating them again: {}", exception.what());
+        }
+    }
+
+    std::vector<MeshSimplifier::Level> levels = MeshSimplifier::generate_levels(mesh, ratios);
+    save_levels(cache_filepath, levels);
+
+    return levels;
+}
+}
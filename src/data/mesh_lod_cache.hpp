@@ -0,0 +1,35 @@
+#pragma once
+
+#include <data/mesh_simplifier.hpp>
+
+namespace xen {
+class FilePath;
+
+/// Mesh levels of detail cache. Levels are generated on their first request & saved in the cache directory, named
+/// after a hash of the mesh's content & of the requested ratios; subsequent requests directly load them, without
+/// simplifying the mesh again.
+namespace MeshLodCache {
+/// Sets the directory in which generated levels are stored. It will be created if it does not exist.
+/// \param directory Path to the cache directory.
+void set_directory(FilePath const& directory);
+
+/// Gets the directory in which generated levels are stored.
+/// \return Path to the cache directory; "cache/meshes" by default.
+FilePath const& get_directory();
+
+/// Enables or disables the cache. If disabled, levels are always generated.
+/// \param enabled True to save & load levels from the cache, false otherwise.
+void enable(bool enabled = true);
+
+void disable();
+
+[[nodiscard]] bool is_enabled();
+
+/// Generates simplified versions of a mesh, or loads them from the cache if they have already been generated.
+/// \note The simplification runs on the default thread pool; this must not be called from one of its tasks.
+/// \param mesh Mesh to be simplified.
+/// \param ratios Ratio of triangles to keep for each level, from the most to the least detailed, each in ]0; 1].
+/// \return Generated or loaded levels, in the same order as the ratios.
+std::vector<MeshSimplifier::Level> generate_levels(Mesh const& mesh, std::vector<float> const& ratios);
+}
+}
@@ -0,0 +1,561 @@
+#include "mesh_optimizer.hpp"
+
+#include <data/image_utils.hpp>
+#include <utils/threading.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <bit>
+
+namespace xen::MeshOptimizer {
+namespace {
+bool import_optimization_enabled = false;
+
+constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+/// Cache size used to measure the clusters' efficiency when optimizing overdraw, matching the usual hardware's.
+constexpr size_t overdraw_cache_size = 16;
+
+/// FIFO post-transform vertex cache, as implemented by most GPUs.
+class FifoCache {
+public:
+    explicit FifoCache(size_t vertex_count, size_t cache_size) : cache_size{cache_size}
+    {
+        insertion_times.resize(vertex_count, 0);
+    }
+
+    /// Processes a vertex, adding it to the cache if not already present.
+    /// \param vertex_index Index of the vertex to be processed.
+    /// \return True if the vertex was not present & had to be transformed, false otherwise.
+    bool process(uint32_t vertex_index)
+    {
+        // A vertex is in the cache if fewer than cache_size vertices have been inserted since its own insertion
+        if (insertion_times[vertex_index] != 0 && time - insertion_times[vertex_index] < cache_size) {
+            return false;
+        }
+
+        ++time;
+        insertion_times[vertex_index] = time;
+        return true;
+    }
+
+    void clear() { time += cache_size; }
+
+private:
+    std::vector<size_t> insertion_times{};
+    size_t cache_size = 0;
+    size_t time = 0;
+};
+
+/// Computes the score of a vertex, used to select the next triangle when optimizing the vertex cache.
+/// \param cache_position Position of the vertex in the cache; -1 if not present.
+/// \param remaining_valence Number of triangles using this vertex that have not yet been emitted.
+/// \param cache_size Size of the modeled cache.
+/// \return Vertex score; the higher, the sooner the triangles using it should be emitted.
+float compute_vertex_score(int cache_position, uint32_t remaining_valence, size_t cache_size)
+{
+    constexpr float cache_decay_power = 1.5f;
+    constexpr float last_triangle_score = 0.75f;
+    constexpr float valence_boost_scale = 2.f;
+    constexpr float valence_boost_power = 0.5f;
+
+    if (remaining_valence == 0) {
+        return -1.f;
+    }
+
+    float score = 0.f;
+
+    if (cache_position >= 0 && static_cast<size_t>(cache_position) < cache_size) {
+        // The vertices of the last emitted triangle are given a fixed score, so that the next triangle does not favor
+        // any of its edges, which would make the strip-like traversal go back & forth
+        if (cache_position < 3) {
+            score = last_triangle_score;
+        }
+        else {
+            float const scaler = 1.f / static_cast<float>(cache_size - 3);
+            score = std::pow(1.f - static_cast<float>(cache_position - 3) * scaler, cache_decay_power);
+        }
+    }
+
+    // Vertices used by few remaining triangles are boosted, to get rid of isolated triangles early
+    score += valence_boost_scale * std::pow(static_cast<float>(remaining_valence), -valence_boost_power);
+
+    return score;
+}
+
+/// Computes the centroid & area-weighted normal of a sequence of triangles.
+/// \param vertices Vertices referenced by the triangles.
+/// \param indices Triangle indices.
+/// \param first_triangle Index of the first triangle of the sequence.
+/// \param last_triangle Index past the last triangle of the sequence.
+/// \return Pair containing respectively the area-weighted centroid & the sum of the triangles' unnormalized normals.
+std::pair<Vector3f, Vector3f> compute_cluster_geometry(
+    std::vector<Vertex> const& vertices, std::vector<uint32_t> const& indices, size_t first_triangle,
+    size_t last_triangle
+)
+{
+    Vector3f centroid_sum(0.f);
+    Vector3f normal_sum(0.f);
+    float area_sum = 0.f;
+
+    for (size_t triangle_index = first_triangle; triangle_index < last_triangle; ++triangle_index) {
+        Vector3f const& first_position = vertices[indices[triangle_index * 3]].position;
+        Vector3f const& second_position = vertices[indices[triangle_index * 3 + 1]].position;
+        Vector3f const& third_position = vertices[indices[triangle_index * 3 + 2]].position;
+
+        Vector3f const normal = (second_position - first_position).cross(third_position - first_position);
+        float const area = normal.length();
+
+        centroid_sum += (first_position + second_position + third_position) * (area / 3.f);
+        normal_sum += normal;
+        area_sum += area;
+    }
+
+    return {(area_sum > 0.f ? centroid_sum / area_sum : Vector3f(0.f)), normal_sum};
+}
+}
+
+void enable_on_import(bool enabled)
+{
+    import_optimization_enabled = enabled;
+}
+
+bool is_enabled_on_import()
+{
+    return import_optimization_enabled;
+}
+
+VertexCacheStatistics analyze_vertex_cache(Submesh const& submesh, size_t cache_size)
+{
+    ZoneScopedN("MeshOptimizer::analyze_vertex_cache");
+
+    std::vector<uint32_t> const& indices = submesh.get_triangle_indices();
+
+    VertexCacheStatistics statistics;
+
+    if (indices.empty() || submesh.get_vertex_count() == 0) {
+        return statistics;
+    }
+
+    FifoCache cache(submesh.get_vertex_count(), cache_size);
+
+    for (uint32_t const index : indices) {
+        statistics.transformed_vertex_count += static_cast<size_t>(cache.process(index));
+    }
+
+    statistics.acmr =
+        static_cast<float>(statistics.transformed_vertex_count) / static_cast<float>(indices.size() / 3);
+    statistics.atvr =
+        static_cast<float>(statistics.transformed_vertex_count) / static_cast<float>(submesh.get_vertex_count());
+
+    return statistics;
+}
+
+void optimize_vertex_cache(Submesh& submesh, size_t cache_size)
+{
+    ZoneScopedN("MeshOptimizer::optimize_vertex_cache");
+
+    if (cache_size <= 3) {
+        throw std::invalid_argument("[MeshOptimizer] The vertex cache size must be greater than 3");
+    }
+
+    std::vector<uint32_t>& indices = submesh.get_triangle_indices();
+    size_t const vertex_count = submesh.get_vertex_count();
+    size_t const triangle_count = indices.size() / 3;
+
+    if (triangle_count == 0) {
+        return;
+    }
+
+    // Listing the triangles using each vertex; the first remaining_valences[i] ones of a vertex are yet to be emitted
+    std::vector<uint32_t> remaining_valences(vertex_count, 0);
+
+    for (uint32_t const index : indices) {
+        ++remaining_valences[index];
+    }
+
+    std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+
+    for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
+        adjacency_offsets[vertex_index + 1] = adjacency_offsets[vertex_index] + remaining_valences[vertex_index];
+    }
+
+    std::vector<uint32_t> adjacent_triangles(indices.size());
+    {
+        std::vector<uint32_t> fill_counts(vertex_count, 0);
+
+        for (size_t index_index = 0; index_index < indices.size(); ++index_index) {
+            uint32_t const vertex_index = indices[index_index];
+            adjacent_triangles[adjacency_offsets[vertex_index] + fill_counts[vertex_index]++] =
+                static_cast<uint32_t>(index_index / 3);
+        }
+    }
+
+    std::vector<int> cache_positions(vertex_count, -1);
+    std::vector<float> vertex_scores(vertex_count);
+
+    for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index) {
+        vertex_scores[vertex_index] = compute_vertex_score(-1, remaining_valences[vertex_index], cache_size);
+    }
+
+    std::vector<float> triangle_scores(triangle_count);
+    std::vector<bool> emitted_triangles(triangle_count, false);
+    uint32_t best_triangle = 0;
+
+    for (size_t triangle_index = 0; triangle_index < triangle_count; ++triangle_index) {
+        triangle_scores[triangle_index] = vertex_scores[indices[triangle_index * 3]] +
+                                          vertex_scores[indices[triangle_index * 3 + 1]] +
+                                          vertex_scores[indices[triangle_index * 3 + 2]];
+
+        if (triangle_scores[triangle_index] > triangle_scores[best_triangle]) {
+            best_triangle = static_cast<uint32_t>(triangle_index);
+        }
+    }
+
+    std::vector<uint32_t> optimized_indices;
+    optimized_indices.reserve(indices.size());
+
+    // The cache holds a few more entries than modeled, so that the scores of the vertices being evicted get updated
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> next_cache;
+    cache.reserve(cache_size + 3);
+    next_cache.reserve(cache_size + 3);
+
+    size_t dead_end_cursor = 0;
+
+    for (size_t emitted_count = 0; emitted_count < triangle_count; ++emitted_count) {
+        if (best_triangle == invalid_index) {
+            // No triangle remains around the cached vertices; resuming from the first one not yet emitted
+            while (emitted_triangles[dead_end_cursor]) {
+                ++dead_end_cursor;
+            }
+
+            best_triangle = static_cast<uint32_t>(dead_end_cursor);
+        }
+
+        emitted_triangles[best_triangle] = true;
+        next_cache.clear();
+
+        for (size_t corner_index = 0; corner_index < 3; ++corner_index) {
+            uint32_t const vertex_index = indices[best_triangle * 3 + corner_index];
+            optimized_indices.emplace_back(vertex_index);
+            next_cache.emplace_back(vertex_index);
+
+            // Removing the triangle from the vertex's remaining ones
+            uint32_t const first_adjacency = adjacency_offsets[vertex_index];
+            uint32_t const last_adjacency = first_adjacency + remaining_valences[vertex_index] - 1;
+
+            for (uint32_t adjacency_index = first_adjacency; adjacency_index <= last_adjacency; ++adjacency_index) {
+                if (adjacent_triangles[adjacency_index] == best_triangle) {
+                    std::swap(adjacent_triangles[adjacency_index], adjacent_triangles[last_adjacency]);
+                    break;
+                }
+            }
+
+            --remaining_valences[vertex_index];
+        }
+
+        for (uint32_t const vertex_index : cache) {
+            if (next_cache.size() >= cache_size + 3) {
+                cache_positions[vertex_index] = -1;
+                continue;
+            }
+
+            if (std::find(next_cache.cbegin(), next_cache.cbegin() + 3, vertex_index) == next_cache.cbegin() + 3) {
+                next_cache.emplace_back(vertex_index);
+            }
+        }
+
+        cache.swap(next_cache);
+
+        // Updating the scores of the cached vertices & of their remaining triangles, keeping the best of those
+        for (size_t cache_index = 0; cache_index < cache.size(); ++cache_index) {
+            uint32_t const vertex_index = cache[cache_index];
+            cache_positions[vertex_index] = static_cast<int>(cache_index);
+
+            float const vertex_score =
+                compute_vertex_score(cache_positions[vertex_index], remaining_valences[vertex_index], cache_size);
+            float const score_difference = vertex_score - vertex_scores[vertex_index];
+            vertex_scores[vertex_index] = vertex_score;
+
+            for (uint32_t adjacency_index = adjacency_offsets[vertex_index];
+                 adjacency_index < adjacency_offsets[vertex_index] + remaining_valences[vertex_index];
+                 ++adjacency_index) {
+                triangle_scores[adjacent_triangles[adjacency_index]] += score_difference;
+            }
+        }
+
+        best_triangle = invalid_index;
+        float best_score = -std::numeric_limits<float>::max();
+
+        for (uint32_t const vertex_index : cache) {
+            for (uint32_t adjacency_index = adjacency_offsets[vertex_index];
+                 adjacency_index < adjacency_offsets[vertex_index] + remaining_valences[vertex_index];
+                 ++adjacency_index) {
+                uint32_t const triangle_index = adjacent_triangles[adjacency_index];
+
+                if (triangle_scores[triangle_index] > best_score) {
+                    best_score = triangle_scores[triangle_index];
+                    best_triangle = triangle_index;
+                }
+            }
+        }
+    }
+
+    indices = std::move(optimized_indices);
+}
+
+void optimize_overdraw(Submesh& submesh, float threshold)
+{
+    ZoneScopedN("MeshOptimizer::optimize_overdraw");
+
+    std::vector<Vertex> const& vertices = submesh.get_vertices();
+    std::vector<uint32_t>& indices = submesh.get_triangle_indices();
+    size_t const triangle_count = indices.size() / 3;
+
+    if (triangle_count <= 1) {
+        return;
+    }
+
+    float const max_cluster_acmr = analyze_vertex_cache(submesh, overdraw_cache_size).acmr * threshold;
+
+    // Splitting the triangles into clusters, starting a new one where the cache was already entirely missed, or as soon
+    // as the current cluster has amortized its initial misses enough to be cut without degrading the cache efficiency
+    std::vector<size_t> cluster_offsets;
+    cluster_offsets.emplace_back(0);
+
+    FifoCache cache(vertices.size(), overdraw_cache_size);
+    size_t cluster_miss_count = 0;
+
+    for (size_t triangle_index = 0; triangle_index < triangle_count; ++triangle_index) {
+        size_t miss_count = 0;
+
+        for (size_t corner_index = 0; corner_index < 3; ++corner_index) {
+            miss_count += static_cast<size_t>(cache.process(indices[triangle_index * 3 + corner_index]));
+        }
+
+        size_t const cluster_triangle_count = triangle_index - cluster_offsets.back();
+
+        if (cluster_triangle_count > 0 &&
+            (miss_count == 3 ||
+             static_cast<float>(cluster_miss_count) / static_cast<float>(cluster_triangle_count) <= max_cluster_acmr)) {
+            cluster_offsets.emplace_back(triangle_index);
+            cluster_miss_count = 0;
+
+            // The new cluster may be drawn after any other, hence starting from an empty cache
+            cache.clear();
+            miss_count = 0;
+
+            for (size_t corner_index = 0; corner_index < 3; ++corner_index) {
+                miss_count += static_cast<size_t>(cache.process(indices[triangle_index * 3 + corner_index]));
+            }
+        }
+
+        cluster_miss_count += miss_count;
+    }
+
+    cluster_offsets.emplace_back(triangle_count);
+
+    size_t const cluster_count = cluster_offsets.size() - 1;
+
+    if (cluster_count <= 1) {
+        return;
+    }
+
+    // Clusters facing away from the mesh's center & far from it are likely to hide the others from any point of view
+    Vector3f const mesh_centroid = compute_cluster_geometry(vertices, indices, 0, triangle_count).first;
+
+    std::vector<float> cluster_sort_keys(cluster_count);
+
+    for (size_t cluster_index = 0; cluster_index < cluster_count; ++cluster_index) {
+        auto const [cluster_centroid, cluster_normal] = compute_cluster_geometry(
+            vertices, indices, cluster_offsets[cluster_index], cluster_offsets[cluster_index + 1]
+        );
+        float const normal_length = cluster_normal.length();
+
+        cluster_sort_keys[cluster_index] =
+            (normal_length > 0.f ? (cluster_centroid - mesh_centroid).dot(cluster_normal / normal_length) : 0.f);
+    }
+
+    std::vector<size_t> cluster_order(cluster_count);
+    std::iota(cluster_order.begin(), cluster_order.end(), 0);
+    std::stable_sort(cluster_order.begin(), cluster_order.end(), [&cluster_sort_keys](size_t lhs, size_t rhs) {
+        return (cluster_sort_keys[lhs] > cluster_sort_keys[rhs]);
+    });
+
+    std::vector<uint32_t> optimized_indices;
+    optimized_indices.reserve(indices.size());
+
+    for (size_t const cluster_index : cluster_order) {
+        optimized_indices.insert(
+            optimized_indices.end(), indices.cbegin() + static_cast<std::ptrdiff_t>(cluster_offsets[cluster_index] * 3),
+            indices.cbegin() + static_cast<std::ptrdiff_t>(cluster_offsets[cluster_index + 1] * 3)
+        );
+    }
+
+    indices = std::move(optimized_indices);
+}
+
+void optimize_vertex_fetch(Submesh& submesh)
+{
+    ZoneScopedN("MeshOptimizer::optimize_vertex_fetch");
+
+    std::vector<Vertex>& vertices = submesh.get_vertices();
+
+    std::vector<uint32_t> remapped_indices(vertices.size(), invalid_index);
+    std::vector<Vertex> optimized_vertices;
+    optimized_vertices.reserve(vertices.size());
+
+    auto const remap_indices = [&vertices, &remapped_indices, &optimized_vertices](std::vector<uint32_t>& indices) {
+        for (uint32_t& index : indices) {
+            if (remapped_indices[index] == invalid_index) {
+                remapped_indices[index] = static_cast<uint32_t>(optimized_vertices.size());
+                optimized_vertices.emplace_back(vertices[index]);
+            }
+
+            index = remapped_indices[index];
+        }
+    };
+
+    remap_indices(submesh.get_triangle_indices());
+    remap_indices(submesh.get_line_indices());
+
+    // Vertices referenced by no primitive are kept, as they are still drawn when rendering points
+    for (size_t vertex_index = 0; vertex_index < vertices.size(); ++vertex_index) {
+        if (remapped_indices[vertex_index] == invalid_index) {
+            optimized_vertices.emplace_back(vertices[vertex_index]);
+        }
+    }
+
+    vertices = std::move(optimized_vertices);
+}
+
+OptimizationStatistics optimize(Submesh& submesh)
+{
+    ZoneScopedN("MeshOptimizer::optimize");
+
+    OptimizationStatistics statistics;
+    statistics.before = analyze_vertex_cache(submesh);
+
+    optimize_vertex_cache(submesh);
+    optimize_overdraw(submesh);
+    optimize_vertex_fetch(submesh);
+
+    statistics.after = analyze_vertex_cache(submesh);
+
+    Log::vdebug(
+        "[MeshOptimizer] Optimized submesh ({} vertices, {} triangles; ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f})",
+        submesh.get_vertex_count(), submesh.get_triangle_index_count() / 3, statistics.before.acmr,
+        statistics.after.acmr, statistics.before.atvr, statistics.after.atvr
+    );
+
+    return statistics;
+}
+
+std::vector<OptimizationStatistics> optimize(Mesh& mesh)
+{
+    ZoneScopedN("MeshOptimizer::optimize");
+
+    std::vector<Submesh>& submeshes = mesh.get_submeshes();
+    std::vector<OptimizationStatistics> statistics(submeshes.size());
+
+    parallelize(0u, submeshes.size(), [&submeshes, &statistics](IndexRange const& range) {
+        for (size_t submesh_index = range.begin_index; submesh_index < range.end_index; ++submesh_index) {
+            statistics[submesh_index] = optimize(submeshes[submesh_index]);
+        }
+    });
+
+    return statistics;
+}
+
+uint16_t to_half(float value)
+{
+    uint32_t const bits = std::bit_cast<uint32_t>(value);
+    auto const sign = static_cast<uint16_t>((bits >> 16u) & 0x8000u);
+    uint32_t const absolute_bits = bits & 0x7FFFFFFFu;
+
+    // Infinity & NaN, the latter being kept quiet
+    if (absolute_bits >= 0x7F800000u) {
+        return static_cast<uint16_t>(sign | 0x7C00u | (absolute_bits > 0x7F800000u ? 0x200u : 0u));
+    }
+
+    // Values rounding beyond the largest half (65504) overflow to infinity
+    if (absolute_bits >= 0x477FF000u) {
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+
+    // Values below the smallest normal half (2^-14) become subnormal, their mantissa being expressed in units of 2^-24
+    if (absolute_bits < 0x38800000u) {
+        float const subnormal_mantissa = std::nearbyint(std::bit_cast<float>(absolute_bits) * 16777216.f);
+        return static_cast<uint16_t>(sign | static_cast<uint16_t>(subnormal_mantissa));
+    }
+
+    // Rebiasing the exponent from 127 to 15 & rounding the mantissa to nearest even
+    uint32_t const rounded_bits = absolute_bits - 0x38000000u + 0xFFFu + ((absolute_bits >> 13u) & 1u);
+    return static_cast<uint16_t>(sign | (rounded_bits >> 13u));
+}
+
+float from_half(uint16_t value)
+{
+    return ImageUtils::from_half(value);
+}
+
+std::array<int16_t, 2> encode_octahedral(Vector3f const& direction)
+{
+    float const manhattan_length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+
+    if (manhattan_length <= 0.f) {
+        return {0, 0};
+    }
+
+    // Projecting onto the octahedron, then folding its lower half over the upper one
+    float x = direction.x / manhattan_length;
+    float y = direction.y / manhattan_length;
+
+    if (direction.z < 0.f) {
+        float const folded_x = (1.f - std::abs(y)) * (x >= 0.f ? 1.f : -1.f);
+        float const folded_y = (1.f - std::abs(x)) * (y >= 0.f ? 1.f : -1.f);
+        x = folded_x;
+        y = folded_y;
+    }
+
+    auto const to_snorm = [](float component) {
+        return static_cast<int16_t>(std::round(std::clamp(component, -1.f, 1.f) * 32767.f));
+    };
+
+    return {to_snorm(x), to_snorm(y)};
+}
+
+Vector3f decode_octahedral(std::array<int16_t, 2> const& encoded)
+{
+    float x = std::max(static_cast<float>(encoded[0]) / 32767.f, -1.f);
+    float y = std::max(static_cast<float>(encoded[1]) / 32767.f, -1.f);
+    float const z = 1.f - std::abs(x) - std::abs(y);
+
+    // Unfolding the lower half of the octahedron
+    float const fold_offset = std::max(-z, 0.f);
+    x += (x >= 0.f ? -fold_offset : fold_offset);
+    y += (y >= 0.f ? -fold_offset : fold_offset);
+
+    return Vector3f(x, y, z).normalize();
+}
+
+std::vector<QuantizedVertex> quantize_vertices(std::span<Vertex const> vertices)
+{
+    ZoneScopedN("MeshOptimizer::quantize_vertices");
+
+    std::vector<QuantizedVertex> quantized_vertices(vertices.size());
+
+    for (size_t vertex_index = 0; vertex_index < vertices.size(); ++vertex_index) {
+        Vertex const& vertex = vertices[vertex_index];
+        QuantizedVertex& quantized_vertex = quantized_vertices[vertex_index];
+
+        quantized_vertex.position = vertex.position;
+        quantized_vertex.texcoords = {to_half(vertex.texcoords.x), to_half(vertex.texcoords.y)};
+        quantized_vertex.normal = encode_octahedral(vertex.normal);
+        quantized_vertex.tangent = encode_octahedral(vertex.tangent);
+    }
+
+    return quantized_vertices;
+}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <data/mesh.hpp>
+
+#include <span>
+
+namespace xen {
+/// Compact vertex layout, 24 bytes instead of Vertex's 44: texcoords are stored as half-precision floats, normals &
+/// tangents as octahedral-encoded signed normalized 16-bit integers. Positions are kept in full precision, avoiding any
+/// dequantization transform.
+struct QuantizedVertex {
+    Vector3f position{};
+    std::array<uint16_t, 2> texcoords{};
+    std::array<int16_t, 2> normal{};
+    std::array<int16_t, 2> tangent{};
+};
+
+static_assert(sizeof(QuantizedVertex) == 24, "Error: Quantized vertices must be tightly packed.");
+
+/// Post-import optimizations of a mesh's geometry, reordering its triangles & vertices so that the GPU processes them
+/// faster without modifying the rendered result:
+/// - Vertex cache: triangles are reordered with Forsyth's algorithm ("Linear-Speed Vertex Cache Optimisation") so that
+///   vertices are reused from the post-transform cache as much as possible;
+/// - Overdraw: clusters of the cache-optimized triangles are sorted so that the ones likely to occlude others are drawn
+///   first, as described by Sander et al. in "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw";
+/// - Vertex fetch: vertices are reordered by first use, making their memory accesses as linear as possible.
+namespace MeshOptimizer {
+/// Post-transform vertex cache efficiency of a submesh.
+struct VertexCacheStatistics {
+    size_t transformed_vertex_count = 0; ///< Number of vertices processed by the vertex shader.
+    float acmr = 0.f; ///< Average cache miss ratio: transformed vertices per triangle; 0.5 at best, 3 at worst.
+    float atvr = 0.f; ///< Average transformed vertex ratio: transformed vertices per vertex; 1 at best.
+};
+
+/// Vertex cache efficiency of a submesh before & after its optimization.
+struct OptimizationStatistics {
+    VertexCacheStatistics before{};
+    VertexCacheStatistics after{};
+};
+
+/// Enables the optimization of the meshes' geometry when imported by the mesh loaders.
+/// \param enabled True to optimize imported meshes, false otherwise.
+void enable_on_import(bool enabled = true);
+
+/// Disables the optimization of the meshes' geometry when imported by the mesh loaders.
+inline void disable_on_import() { enable_on_import(false); }
+
+/// Checks if imported meshes are optimized.
+/// \return True if the mesh loaders optimize the meshes they import, false otherwise.
+bool is_enabled_on_import();
+
+/// Simulates a FIFO post-transform vertex cache to measure how efficiently a submesh's triangles reuse their vertices.
+/// \param submesh Submesh to be analyzed.
+/// \param cache_size Number of entries in the simulated cache.
+/// \return Vertex cache statistics of the submesh.
+VertexCacheStatistics analyze_vertex_cache(Submesh const& submesh, size_t cache_size = 16);
+
+/// Reorders a submesh's triangles to maximize the reuse of its vertices from the post-transform cache.
+/// \param submesh Submesh to be optimized.
+/// \param cache_size Number of entries in the modeled cache.
+void optimize_vertex_cache(Submesh& submesh, size_t cache_size = 32);
+
+/// Reorders clusters of a submesh's triangles so that those facing outward & far from its center are drawn first,
+///   reducing overdraw from any point of view. This should be called after optimize_vertex_cache(), whose order is
+///   kept within each cluster.
+/// \param submesh Submesh to be optimized.
+/// \param threshold Maximum cache miss ratio a cluster can reach relatively to the whole submesh's; the higher, the
+///   smaller the clusters & the fewer the overdraw, at the expense of the vertex cache efficiency.
+void optimize_overdraw(Submesh& submesh, float threshold = 1.05f);
+
+/// Reorders a submesh's vertices in the order they are first referenced by its triangles, then by its lines.
+/// \param submesh Submesh to be optimized.
+void optimize_vertex_fetch(Submesh& submesh);
+
+/// Applies all optimizations to a submesh.
+/// \param submesh Submesh to be optimized.
+/// \return Vertex cache statistics of the submesh before & after its optimization.
+OptimizationStatistics optimize(Submesh& submesh);
+
+/// Applies all optimizations to each submesh of a mesh, in parallel on the default thread pool; this call blocks until
+///   all of them are done.
+/// \note As it uses the thread pool itself, this must not be called from one of its tasks.
+/// \param mesh Mesh to be optimized.
+/// \return Vertex cache statistics of each submesh before & after its optimization.
+std::vector<OptimizationStatistics> optimize(Mesh& mesh);
+
+/// Converts a single-precision floating-point value to half precision, rounding to nearest.
+/// \param value Value to be converted.
+/// \return Bits of the half-precision value.
+uint16_t to_half(float value);
+
+/// Converts a half-precision floating-point value to single precision.
+/// \param value Bits of the half-precision value.
+/// \return Converted value.
+float from_half(uint16_t value);
+
+/// Encodes a unit vector with an octahedral mapping, as described by Cigolle et al. in "A Survey of Efficient
+///   Representations for Independent Unit Vectors".
+/// \param direction Unit vector to be encoded.
+/// \return Signed normalized components of the encoded vector.
+std::array<int16_t, 2> encode_octahedral(Vector3f const& direction);
+
+/// Decodes an octahedral-encoded unit vector.
+/// \param encoded Signed normalized components of the encoded vector.
+/// \return Decoded unit vector.
+Vector3f decode_octahedral(std::array<int16_t, 2> const& encoded);
+
+/// Converts vertices to the quantized format.
+/// \param vertices Vertices to be converted.
+/// \return Quantized vertices, in the same order.
+std::vector<QuantizedVertex> quantize_vertices(std::span<Vertex const> vertices);
+}
+}
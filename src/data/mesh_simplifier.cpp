@@ -0,0 +1,406 @@
+#include "mesh_simplifier.hpp"
+
+#include <utils/hash.hpp>
+#include <utils/threading.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace xen::MeshSimplifier {
+namespace {
+/// Symmetric 4x4 matrix accumulating the squared distances to a set of planes.
+struct Quadric {
+    double a2 = 0.0;
+    double ab = 0.0;
+    double ac = 0.0;
+    double ad = 0.0;
+    double b2 = 0.0;
+    double bc = 0.0;
+    double bd = 0.0;
+    double c2 = 0.0;
+    double cd = 0.0;
+    double d2 = 0.0;
+
+    void add_plane(Vector3f const& normal, float distance)
+    {
+        double const a = normal.x;
+        double const b = normal.y;
+        double const c = normal.z;
+        double const d = distance;
+
+        a2 += a * a;
+        ab += a * b;
+        ac += a * c;
+        ad += a * d;
+        b2 += b * b;
+        bc += b * c;
+        bd += b * d;
+        c2 += c * c;
+        cd += c * d;
+        d2 += d * d;
+    }
+
+    Quadric& operator+=(Quadric const& quadric)
+    {
+        a2 += quadric.a2;
+        ab += quadric.ab;
+        ac += quadric.ac;
+        ad += quadric.ad;
+        b2 += quadric.b2;
+        bc += quadric.bc;
+        bd += quadric.bd;
+        c2 += quadric.c2;
+        cd += quadric.cd;
+        d2 += quadric.d2;
+        return *this;
+    }
+
+    Quadric operator+(Quadric const& quadric) const { return Quadric(*this) += quadric; }
+
+    double compute_error(Vector3f const& position) const
+    {
+        double const x = position.x;
+        double const y = position.y;
+        double const z = position.z;
+
+        double const error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x + b2 * y * y +
+                             2.0 * bc * y * z + 2.0 * bd * y + c2 * z * z + 2.0 * cd * z + d2;
+
+        return std::max(error, 0.0);
+    }
+};
+
+struct Collapse {
+    uint32_t source_index;
+    uint32_t target_index;
+    double error;
+};
+
+/// Finds the vertices that cannot be moved: those on a border (an edge used by a single triangle) & those sharing
+/// their position with another vertex, which lie on an attribute seam.
+std::vector<bool> compute_locked_vertices(std::vector<Vertex> const& vertices, std::vector<uint32_t> const& indices)
+{
+    std::vector<bool> locked_vertices(vertices.size(), false);
+
+    std::unordered_map<uint64_t, uint32_t> first_vertex_by_position;
+    first_vertex_by_position.reserve(vertices.size());
+
+    for (uint32_t vertex_index = 0; vertex_index < vertices.size(); ++vertex_index) {
+        Vector3f const& position = vertices[vertex_index].position;
+        std::array<float, 3> const coords = {position.x, position.y, position.z};
+
+        auto const [vertex_it, inserted] =
+            first_vertex_by_position.try_emplace(Hash::compute_fnv1a(coords), vertex_index);
+
+        if (!inserted && vertices[vertex_it->second].position == position) {
+            locked_vertices[vertex_index] = true;
+            locked_vertices[vertex_it->second] = true;
+        }
+    }
+
+    std::unordered_set<uint64_t> directed_edges;
+    directed_edges.reserve(indices.size());
+
+    auto const make_edge_key = [](uint32_t begin_index, uint32_t end_index) {
+        return (static_cast<uint64_t>(begin_index) << 32u) | end_index;
+    };
+
+    for (size_t index = 0; index < indices.size(); index += 3) {
+        for (size_t edge_index = 0; edge_index < 3; ++edge_index) {
+            directed_edges.emplace(make_edge_key(indices[index + edge_index], indices[index + (edge_index + 1) % 3]));
+        }
+    }
+
+    for (size_t index = 0; index < indices.size(); index += 3) {
+        for (size_t edge_index = 0; edge_index < 3; ++edge_index) {
+            uint32_t const begin_index = indices[index + edge_index];
+            uint32_t const end_index = indices[index + (edge_index + 1) % 3];
+
+            if (!directed_edges.contains(make_edge_key(end_index, begin_index))) {
+                locked_vertices[begin_index] = true;
+                locked_vertices[end_index] = true;
+            }
+        }
+    }
+
+    return locked_vertices;
+}
+
+/// Checks if moving a vertex onto another would flip any of the triangles around it.
+bool has_flip(
+    uint32_t source_index, uint32_t target_index, std::vector<Vertex> const& vertices,
+    std::vector<uint32_t> const& indices, std::vector<uint32_t> const& adjacency_offsets,
+    std::vector<uint32_t> const& adjacent_triangles
+)
+{
+    Vector3f const& target_pos = vertices[target_index].position;
+
+    for (uint32_t adjacency_index = adjacency_offsets[source_index];
+         adjacency_index < adjacency_offsets[source_index + 1]; ++adjacency_index) {
+        size_t const triangle_index = adjacent_triangles[adjacency_index] * 3;
+        std::array<uint32_t, 3> const triangle = {
+            indices[triangle_index], indices[triangle_index + 1], indices[triangle_index + 2]
+        };
+
+        // Triangles containing both vertices will collapse & disappear
+        if (triangle[0] == target_index || triangle[1] == target_index || triangle[2] == target_index) {
+            continue;
+        }
+
+        std::array<Vector3f, 3> positions = {
+            vertices[triangle[0]].position, vertices[triangle[1]].position, vertices[triangle[2]].position
+        };
+        Vector3f const old_normal = (positions[1] - positions[0]).cross(positions[2] - positions[0]);
+
+        for (size_t corner_index = 0; corner_index < 3; ++corner_index) {
+            if (triangle[corner_index] == source_index) {
+                positions[corner_index] = target_pos;
+            }
+        }
+
+        Vector3f const new_normal = (positions[1] - positions[0]).cross(positions[2] - positions[0]);
+
+        if (old_normal.dot(new_normal) <= 0.f) {
+            return true;
+        }
+    }
+
+    return false;
+}
+}
+
+Submesh simplify(Submesh const& submesh, size_t target_index_count, float max_error, float* result_error)
+{
+    ZoneScopedN("MeshSimplifier::simplify");
+
+    std::vector<Vertex> const& vertices = submesh.get_vertices();
+    std::vector<uint32_t> indices = submesh.get_triangle_indices();
+
+    target_index_count -= target_index_count % 3;
+
+    std::vector<bool> const locked_vertices = compute_locked_vertices(vertices, indices);
+
+    std::vector<Quadric> quadrics(vertices.size());
+
+    for (size_t index = 0; index < indices.size(); index += 3) {
+        Vector3f const& first_pos = vertices[indices[index]].position;
+        Vector3f const normal =
+            (vertices[indices[index + 1]].position - first_pos).cross(vertices[indices[index + 2]].position - first_pos);
+        float const normal_length = normal.length();
+
+        if (normal_length <= std::numeric_limits<float>::epsilon()) {
+            continue;
+        }
+
+        Vector3f const unit_normal = normal / normal_length;
+        float const distance = -unit_normal.dot(first_pos);
+
+        for (size_t corner_index = 0; corner_index < 3; ++corner_index) {
+            quadrics[indices[index + corner_index]].add_plane(unit_normal, distance);
+        }
+    }
+
+    double const max_quadric_error = static_cast<double>(max_error) * static_cast<double>(max_error);
+    double max_collapse_error = 0.0;
+
+    std::vector<uint32_t> adjacency_offsets(vertices.size() + 1);
+    std::vector<uint32_t> adjacent_triangles;
+    std::vector<Collapse> collapses;
+    std::vector<bool> touched_vertices(vertices.size());
+    std::vector<uint32_t> remap(vertices.size());
+
+    // Collapses are made by passes, each only touching vertices far enough from one another so that they can all be
+    // checked against the same topology
+    while (indices.size() > target_index_count) {
+        // Recovering the triangles around each vertex
+        std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+
+        for (uint32_t const index : indices) {
+            ++adjacency_offsets[index + 1];
+        }
+
+        for (size_t vertex_index = 0; vertex_index < vertices.size(); ++vertex_index) {
+            adjacency_offsets[vertex_index + 1] += adjacency_offsets[vertex_index];
+        }
+
+        adjacent_triangles.resize(indices.size());
+        std::vector<uint32_t> adjacency_fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+
+        for (size_t index = 0; index < indices.size(); ++index) {
+            adjacent_triangles[adjacency_fill[indices[index]]++] = static_cast<uint32_t>(index / 3);
+        }
+
+        collapses.clear();
+
+        for (size_t index = 0; index < indices.size(); index += 3) {
+            for (size_t edge_index = 0; edge_index < 3; ++edge_index) {
+                uint32_t const source_index = indices[index + edge_index];
+                uint32_t const target_index = indices[index + (edge_index + 1) % 3];
+
+                if (locked_vertices[source_index]) {
+                    continue;
+                }
+
+                double const error =
+                    (quadrics[source_index] + quadrics[target_index]).compute_error(vertices[target_index].position);
+
+                if (error <= max_quadric_error) {
+                    collapses.emplace_back(source_index, target_index, error);
+                }
+            }
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](Collapse const& lhs, Collapse const& rhs) {
+            return lhs.error < rhs.error;
+        });
+
+        std::fill(touched_vertices.begin(), touched_vertices.end(), false);
+        std::iota(remap.begin(), remap.end(), 0);
+
+        // Each collapse of an interior edge removes two triangles
+        size_t const triangle_goal = (indices.size() - target_index_count) / 3;
+        size_t removed_triangle_count = 0;
+        size_t collapse_count = 0;
+
+        for (Collapse const& collapse : collapses) {
+            if (removed_triangle_count >= triangle_goal) {
+                break;
+            }
+
+            if (touched_vertices[collapse.source_index] || touched_vertices[collapse.target_index]) {
+                continue;
+            }
+
+            if (has_flip(
+                    collapse.source_index, collapse.target_index, vertices, indices, adjacency_offsets,
+                    adjacent_triangles
+                )) {
+                continue;
+            }
+
+            remap[collapse.source_index] = collapse.target_index;
+            quadrics[collapse.target_index] += quadrics[collapse.source_index];
+            max_collapse_error = std::max(max_collapse_error, collapse.error);
+
+            // The whole neighborhood of the moved vertex is left untouched for the rest of this pass
+            for (uint32_t adjacency_index = adjacency_offsets[collapse.source_index];
+                 adjacency_index < adjacency_offsets[collapse.source_index + 1]; ++adjacency_index) {
+                size_t const triangle_index = adjacent_triangles[adjacency_index] * 3;
+
+                touched_vertices[indices[triangle_index]] = true;
+                touched_vertices[indices[triangle_index + 1]] = true;
+                touched_vertices[indices[triangle_index + 2]] = true;
+            }
+
+            removed_triangle_count += 2;
+            ++collapse_count;
+        }
+
+        if (collapse_count == 0) {
+            break;
+        }
+
+        // Applying the collapses & removing the triangles that became degenerate
+        size_t kept_index_count = 0;
+
+        for (size_t index = 0; index < indices.size(); index += 3) {
+            uint32_t const first_index = remap[indices[index]];
+            uint32_t const second_index = remap[indices[index + 1]];
+            uint32_t const third_index = remap[indices[index + 2]];
+
+            if (first_index == second_index || second_index == third_index || third_index == first_index) {
+                continue;
+            }
+
+            indices[kept_index_count++] = first_index;
+            indices[kept_index_count++] = second_index;
+            indices[kept_index_count++] = third_index;
+        }
+
+        indices.resize(kept_index_count);
+    }
+
+    // Keeping only the vertices that are still referenced
+    Submesh simplified_submesh;
+    std::vector<Vertex>& simplified_vertices = simplified_submesh.get_vertices();
+    std::vector<uint32_t>& simplified_indices = simplified_submesh.get_triangle_indices();
+
+    std::fill(remap.begin(), remap.end(), std::numeric_limits<uint32_t>::max());
+    simplified_indices.reserve(indices.size());
+
+    for (uint32_t const index : indices) {
+        if (remap[index] == std::numeric_limits<uint32_t>::max()) {
+            remap[index] = static_cast<uint32_t>(simplified_vertices.size());
+            simplified_vertices.emplace_back(vertices[index]);
+        }
+
+        simplified_indices.emplace_back(remap[index]);
+    }
+
+    simplified_submesh.compute_bounding_box();
+
+    if (result_error) {
+        *result_error = static_cast<float>(std::sqrt(max_collapse_error));
+    }
+
+    return simplified_submesh;
+}
+
+std::vector<Level> generate_levels(Mesh const& mesh, std::vector<float> const& ratios)
+{
+    ZoneScopedN("MeshSimplifier::generate_levels");
+
+    std::vector<Submesh> const& submeshes = mesh.get_submeshes();
+
+    std::vector<Level> levels;
+    levels.resize(ratios.size());
+
+    for (size_t level_index = 0; level_index < ratios.size(); ++level_index) {
+        if (ratios[level_index] <= 0.f || ratios[level_index] > 1.f) {
+            throw std::invalid_argument("[MeshSimplifier] The ratio of triangles to keep must be in ]0; 1]");
+        }
+
+        levels[level_index].error = 0.f;
+        levels[level_index].mesh.get_submeshes().resize(submeshes.size());
+    }
+
+    if (submeshes.empty() || ratios.empty()) {
+        return levels;
+    }
+
+    Log::vdebug(
+        "[MeshSimplifier] Generating {} level(s) of {} submesh(es)...", ratios.size(), submeshes.size()
+    );
+
+    std::vector<float> errors(ratios.size() * submeshes.size());
+
+    // Each submesh of each level is simplified from the original one independently, allowing them all to run in parallel
+    parallelize(0u, ratios.size() * submeshes.size(), [&](IndexRange const& range) {
+        for (size_t task_index = range.begin_index; task_index < range.end_index; ++task_index) {
+            size_t const level_index = task_index / submeshes.size();
+            size_t const submesh_index = task_index % submeshes.size();
+
+            Submesh const& submesh = submeshes[submesh_index];
+            auto const target_index_count = static_cast<size_t>(
+                static_cast<float>(submesh.get_triangle_index_count()) * ratios[level_index]
+            );
+
+            levels[level_index].mesh.get_submeshes()[submesh_index] =
+                simplify(submesh, target_index_count, std::numeric_limits<float>::max(), &errors[task_index]);
+        }
+    });
+
+    for (size_t level_index = 0; level_index < ratios.size(); ++level_index) {
+        Level& level = levels[level_index];
+
+        for (size_t submesh_index = 0; submesh_index < submeshes.size(); ++submesh_index) {
+            level.error = std::max(level.error, errors[level_index * submeshes.size() + submesh_index]);
+        }
+
+        level.mesh.compute_bounding_box();
+    }
+
+    Log::debug("[MeshSimplifier] Generated levels");
+
+    return levels;
+}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <data/mesh.hpp>
+
+namespace xen {
+/// Mesh simplification through quadric edge collapses, as described by Garland & Heckbert in "Surface Simplification
+/// Using Quadric Error Metrics". Vertices are only ever collapsed onto one of their neighbors, so that no attribute
+/// has to be interpolated; vertices lying on a border or on an attribute seam (several vertices sharing the same
+/// position) are never moved, preserving the mesh's outline & UV islands.
+namespace MeshSimplifier {
+/// Simplified version of a mesh, used as a level of detail.
+struct Level {
+    Mesh mesh;
+    float error; ///< Maximum deviation from the original surface, in the mesh's local space units.
+};
+
+/// Simplifies a submesh's triangles.
+/// \param submesh Submesh to be simplified.
+/// \param target_index_count Number of triangle indices to reach; the result may have more if no further collapse is
+///   possible within the maximum error.
+/// \param max_error Maximum deviation from the original surface that a collapse can introduce.
+/// \param result_error Optional pointer to be filled with the deviation actually introduced.
+/// \return Simplified submesh, only holding the vertices still referenced by its triangles.
+Submesh simplify(
+    Submesh const& submesh, size_t target_index_count, float max_error = std::numeric_limits<float>::max(),
+    float* result_error = nullptr
+);
+
+/// Generates simplified versions of a mesh. Each submesh of each level is simplified in parallel on the default thread
+/// pool; this call blocks until all of them are done.
+/// \note As it uses the thread pool itself, this must not be called from one of its tasks. To generate levels in the
+///   background, call it through launch_async() instead.
+/// \param mesh Mesh to be simplified.
+/// \param ratios Ratio of triangles to keep for each level, from the most to the least detailed, each in ]0; 1].
+/// \return Generated levels, in the same order as the ratios.
+std::vector<Level> generate_levels(Mesh const& mesh, std::vector<float> const& ratios);
+}
+}
@@ -13,6 +13,12 @@ namespace ObjFormat {
 /// textures, ...).
 std::pair<Mesh, MeshRendererData> load(FilePath const& filepath);
 
+/// Parses a mesh from an OBJ file without creating any graphics resource, which can thus be done from any thread.
+/// \param filepath File from which to load the mesh.
+/// \return Pair containing respectively the mesh's data and a function loading its materials & creating its rendering
+///   information from it, which must be called from the thread owning the graphics context.
+std::pair<Mesh, std::function<MeshRendererData(Mesh const&)>> parse(FilePath const& filepath);
+
 /// Saves a mesh to an OBJ file.
 /// \param filepath File to which to save the mesh.
 /// \param mesh Mesh to export data from.
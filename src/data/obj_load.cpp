@@ -1,13 +1,19 @@
+#include <data/asset_cache.hpp>
 #include <data/image.hpp>
-#include <data/image_format.hpp>
 #include <data/mesh.hpp>
+#include <data/mesh_optimizer.hpp>
 #include <data/obj_format.hpp>
 #include <render/mesh_renderer.hpp>
+#include <render/texture_cache.hpp>
 #include <utils/filepath.hpp>
 #include <utils/file_utils.hpp>
+#include <utils/mapped_file.hpp>
+#include <utils/threading.hpp>
 
 #include <tracy/Tracy.hpp>
 
+#include <charconv>
+
 namespace xen::ObjFormat {
 
 namespace {
@@ -17,16 +23,67 @@ load_texture(FilePath const& texture_filepath, Color const& default_color, bool
     ZoneScopedN("[ObjLoad]::load_texture");
     ZoneTextF("Path: %s", texture_filepath.to_utf8().c_str());
 
-    if (!FileUtils::is_readable(texture_filepath)) {
-        Log::warning(
-            "[ObjLoad] Cannot load texture '" + texture_filepath +
-            "'; either the file does not exist or it cannot be opened."
-        );
+    Texture2DPtr texture;
+
+    // The file is not checked beforehand, so that it is opened only once; a failure to read it is thrown instead
+    try {
+        // Always apply a vertical flip to imported textures, since OpenGL maps them upside down
+        texture = TextureCache::load(texture_filepath, should_use_srgb, true);
+    }
+    catch (std::exception const& exception) {
+        Log::vwarning("[ObjLoad] Cannot load texture '{}': {}", texture_filepath.to_utf8(), exception.what());
         return Texture2D::create(default_color);
     }
 
-    // Always apply a vertical flip to imported textures, since OpenGL maps them upside down
-    return Texture2D::create(ImageFormat::load(texture_filepath, true), true, should_use_srgb);
+    AssetCache::add_dependency(texture_filepath);
+
+    return texture;
+}
+
+/// Prepares ahead all the textures referenced by a MTL file, so that they are read & decoded concurrently while the
+///   materials are being created.
+/// \param mtl_content Content of the MTL file.
+/// \param mtl_directory Directory containing the MTL file, to which the textures' paths are relative.
+void prefetch_textures(std::string const& mtl_content, FilePath const& mtl_directory)
+{
+    ZoneScopedN("[ObjLoad]::prefetch_textures");
+
+    std::istringstream content(mtl_content);
+    std::string line;
+
+    while (std::getline(content, line)) {
+        std::istringstream line_stream(line);
+        std::string tag;
+        std::string texture_path;
+        line_stream >> tag >> texture_path;
+
+        // Only the textures actually loaded afterward are prefetched, with the same settings as in load_mtl(); their
+        //   data is otherwise kept in memory. Textures holding colors are in sRGB
+        constexpr std::array<std::pair<std::string_view, bool>, 11> texture_tags = {
+            {{"map_Kd", true},
+             {"map_Ke", true},
+             {"map_Ka", true},
+             {"map_Ks", true},
+             {"map_Pm", false},
+             {"map_Pr", false},
+             {"map_Ps", true},
+             {"map_d", false},
+             {"map_bump", false},
+             {"bump", false},
+             {"norm", false}}
+        };
+
+        auto const tag_iter = std::find_if(texture_tags.cbegin(), texture_tags.cend(), [&tag](auto const& texture_tag) {
+            return (texture_tag.first == tag);
+        });
+
+        if (texture_path.empty() || tag_iter == texture_tags.cend()) {
+            continue;
+        }
+
+        // Errors, such as a missing file, are reported when loading the texture
+        TextureCache::prefetch(mtl_directory + texture_path, tag_iter->second, true);
+    }
 }
 
 inline void load_mtl(
@@ -39,14 +96,20 @@ inline void load_mtl(
 
     Log::debug("[ObjLoad] Loading MTL file ('" + mtl_filepath + "')...");
 
-    std::ifstream file(mtl_filepath, std::ios_base::binary);
+    AssetCache::add_dependency(mtl_filepath);
 
-    if (!file) {
+    if (!FileUtils::is_readable(mtl_filepath)) {
         Log::error("[ObjLoad] Could not open the MTL file '" + mtl_filepath + "'.");
         materials.emplace_back(MaterialType::COOK_TORRANCE);
         return;
     }
 
+    // The file is read through the virtual file system, & can thus be held by a mounted archive
+    std::string const mtl_content = FileUtils::read_file_to_string(mtl_filepath);
+    prefetch_textures(mtl_content, mtl_filepath.recover_path_to_file());
+
+    std::istringstream file(mtl_content, std::ios_base::binary);
+
     Material material;
     MaterialType material_type = MaterialType::BLINN_PHONG;
 
@@ -180,271 +243,594 @@ inline void load_mtl(
 
     Log::debug("[ObjLoad] Loaded MTL file (" + std::to_string(materials.size()) + " material(s) loaded)");
 }
-}
 
-std::pair<Mesh, MeshRendererData> load(FilePath const& filepath)
-{
-    ZoneScopedN("ObjFormat::load");
-    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+/// Marker of a face corner's attribute which has not been given.
+constexpr int32_t absent_index = std::numeric_limits<int32_t>::min();
+
+/// Marker of a resolved attribute index which is absent or invalid.
+constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+/// Minimum size of the chunks the file is split into, so that small files are not needlessly parsed in parallel.
+constexpr size_t min_chunk_size = 1u << 20u;
+
+/// Position, texcoords & normal indices of a face corner, as parsed. Indices are 0-based & absolute, except those
+///   flagged as relative: these have been given negative in the file & are stored relatively to the beginning of the
+///   chunk they have been parsed from (thus being negative if referencing a preceding chunk), so that they can be
+///   resolved once the preceding chunks' counts are known.
+struct ObjCorner {
+    std::array<int32_t, 3> indices;
+    uint8_t relative_mask; ///< Bit i set if indices[i] is relative to the chunk.
+};
+
+enum class ObjCommandType : uint8_t {
+    GROUP,           ///< Object or group [o/g].
+    MATERIAL,        ///< Material usage [usemtl].
+    MATERIAL_LIBRARY ///< Material import [mtllib].
+};
+
+/// Statement changing how the following faces are attributed, located by the number of corners preceding it.
+struct ObjCommand {
+    ObjCommandType type;
+    size_t corner_offset;
+    std::string name;
+};
+
+/// Data parsed from a line-aligned chunk of the file.
+struct ObjChunk {
+    std::vector<Vector3f> positions;
+    std::vector<Vector2f> texcoords;
+    std::vector<Vector3f> normals;
+    std::vector<ObjCorner> corners; ///< Corners of the triangulated faces, 3 per triangle.
+    std::vector<ObjCommand> commands;
+};
+
+/// Range of corners of a chunk, attributed to a submesh.
+struct ObjCornerRange {
+    size_t chunk_index;
+    size_t begin;
+    size_t end;
+};
+
+/// Cursor over a line, parsing its values in place.
+class ObjLineParser {
+public:
+    ObjLineParser(char const* begin, char const* end) : current{begin}, end{end} {}
+
+    [[nodiscard]] bool at_end()
+    {
+        skip_spaces();
+        return (current == end);
+    }
 
-    Log::debug("[ObjLoad] Loading OBJ file ('" + filepath + "')...");
+    float parse_float()
+    {
+        skip_spaces();
+
+        // std::from_chars does not accept an explicit positive sign
+        if (current != end && *current == '+') {
+            ++current;
+        }
 
-    std::ifstream file(filepath, std::ios_base::binary);
+        float value{};
+        auto const [next, error] = std::from_chars(current, end, value);
+        current = (error == std::errc() ? next : skip_value());
 
-    if (!file) {
-        throw std::invalid_argument("Error: Couldn't open the OBJ file '" + filepath + '\'');
+        return value;
     }
 
-    Mesh mesh;
-    MeshRendererData mesh_renderer;
+    /// Parses a face corner, made of a position index optionally followed by texcoords & normal indices (v, v/t, v//n
+    ///   or v/t/n).
+    /// \param counts Number of positions, texcoords & normals parsed so far in the chunk.
+    /// \return Parsed corner.
+    ObjCorner parse_corner(std::array<size_t, 3> const& counts)
+    {
+        skip_spaces();
 
-    mesh.add_submesh();
-    mesh_renderer.add_submesh_renderer();
+        ObjCorner corner{{absent_index, absent_index, absent_index}, 0};
 
-    std::unordered_map<std::string, size_t> material_correspond_indices;
+        for (size_t part_index = 0; part_index < 3 && current != end && !is_space(*current); ++part_index) {
+            if (*current != '/') {
+                int64_t index{};
+                auto const [next, error] = std::from_chars(current, end, index);
 
-    std::vector<Vector3f> positions;
-    std::vector<Vector2f> texcoords;
-    std::vector<Vector3f> normals;
+                if (error == std::errc() && index > 0) {
+                    corner.indices[part_index] = static_cast<int32_t>(index - 1);
+                }
+                else if (error == std::errc() && index < 0) {
+                    corner.indices[part_index] = static_cast<int32_t>(static_cast<int64_t>(counts[part_index]) + index);
+                    corner.relative_mask |= static_cast<uint8_t>(1u << part_index);
+                }
 
-    std::vector<std::vector<int64_t>> pos_indices(1);
-    std::vector<std::vector<int64_t>> texcoords_indices(1);
-    std::vector<std::vector<int64_t>> normals_indices(1);
+                current = (error == std::errc() ? next : current);
+            }
 
-    while (!file.eof()) {
-        std::string line;
-        file >> line;
+            while (current != end && !is_space(*current) && *current != '/') {
+                ++current;
+            }
 
-        if (line[0] == 'v') {
-            if (line[1] == 'n') { // Normal
-                Vector3f normal_triplet;
+            if (current != end && *current == '/') {
+                ++current;
+            }
+        }
 
-                file >> normal_triplet.x >> normal_triplet.y >> normal_triplet.z;
+        skip_value();
 
-                normals.emplace_back(std::move(normal_triplet));
-            }
-            else if (line[1] == 't') { // Texcoords
-                Vector2f texcoords_triplet;
+        return corner;
+    }
 
-                file >> texcoords_triplet.x >> texcoords_triplet.y;
+    std::string_view parse_word()
+    {
+        skip_spaces();
 
-                texcoords.emplace_back(std::move(texcoords_triplet));
-            }
-            else { // Position
-                Vector3f position_triplet;
+        char const* const word_begin = current;
+        skip_value();
 
-                file >> position_triplet.x >> position_triplet.y >> position_triplet.z;
+        return {word_begin, static_cast<size_t>(current - word_begin)};
+    }
 
-                positions.emplace_back(std::move(position_triplet));
-            }
+private:
+    char const* current;
+    char const* end;
+
+    static bool is_space(char character) { return (character == ' ' || character == '\t' || character == '\r'); }
+
+    void skip_spaces()
+    {
+        while (current != end && is_space(*current)) {
+            ++current;
         }
-        else if (line[0] == 'f') { // Faces
-            std::getline(file, line);
+    }
 
-            constexpr char delimiter = '/';
-            auto const nb_vertices = static_cast<uint16_t>(std::count(line.cbegin(), line.cend(), ' '));
-            auto const nb_parts =
-                static_cast<uint8_t>(std::count(line.cbegin(), line.cend(), delimiter) / nb_vertices + 1);
-            bool const quad_faces = (nb_vertices == 4);
+    char const* skip_value()
+    {
+        while (current != end && !is_space(*current)) {
+            ++current;
+        }
 
-            std::stringstream indices_stream(line);
-            std::vector<int64_t> part_indices(nb_parts * nb_vertices);
-            std::string vertex;
+        return current;
+    }
+};
 
-            for (size_t vert_index = 0; vert_index < nb_vertices; ++vert_index) {
-                indices_stream >> vertex;
+/// Parses a line-aligned chunk of an OBJ file.
+/// \param begin Beginning of the chunk.
+/// \param end End of the chunk, either right after a line feed or at the end of the file.
+/// \return Data parsed from the chunk.
+ObjChunk parse_chunk(char const* begin, char const* end)
+{
+    ZoneScopedN("[ObjLoad]::parse_chunk");
 
-                std::stringstream vert_parts(vertex);
-                std::string part;
-                uint8_t part_index = 0;
+    ObjChunk chunk;
+    std::vector<ObjCorner> face_corners;
 
-                while (std::getline(vert_parts, part, delimiter)) {
-                    if (!part.empty()) {
-                        part_indices[part_index * nb_parts + vert_index + (part_index * quad_faces)] = std::stol(part);
-                    }
+    while (begin < end) {
+        char const* line_end = static_cast<char const*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        line_end = (line_end != nullptr ? line_end : end);
 
-                    ++part_index;
-                }
-            }
+        ObjLineParser line(begin, line_end);
+        std::string_view const tag = line.parse_word();
+        begin = (line_end != end ? line_end + 1 : end);
 
-            if (quad_faces) {
-                pos_indices.back().emplace_back(part_indices[0]);
-                pos_indices.back().emplace_back(part_indices[2]);
-                pos_indices.back().emplace_back(part_indices[3]);
+        if (tag == "v") {
+            float const x = line.parse_float();
+            float const y = line.parse_float();
+            float const z = line.parse_float();
+            chunk.positions.emplace_back(x, y, z);
+        }
+        else if (tag == "vt") {
+            float const u = line.parse_float();
+            float const v = line.parse_float();
+            chunk.texcoords.emplace_back(u, v);
+        }
+        else if (tag == "vn") {
+            float const x = line.parse_float();
+            float const y = line.parse_float();
+            float const z = line.parse_float();
+            chunk.normals.emplace_back(x, y, z);
+        }
+        else if (tag == "f") {
+            std::array<size_t, 3> const counts = {
+                chunk.positions.size(), chunk.texcoords.size(), chunk.normals.size()
+            };
 
-                texcoords_indices.back().emplace_back(part_indices[4]);
-                texcoords_indices.back().emplace_back(part_indices[6]);
-                texcoords_indices.back().emplace_back(part_indices[7]);
+            face_corners.clear();
 
-                normals_indices.back().emplace_back(part_indices[8]);
-                normals_indices.back().emplace_back(part_indices[10]);
-                normals_indices.back().emplace_back(part_indices[11]);
+            while (!line.at_end()) {
+                face_corners.emplace_back(line.parse_corner(counts));
             }
 
-            pos_indices.back().emplace_back(part_indices[0]);
-            pos_indices.back().emplace_back(part_indices[1]);
-            pos_indices.back().emplace_back(part_indices[2]);
+            // Polygons are triangulated as fans, which is exact for the convex faces OBJ files are expected to hold
+            for (size_t corner_index = 2; corner_index < face_corners.size(); ++corner_index) {
+                chunk.corners.emplace_back(face_corners.front());
+                chunk.corners.emplace_back(face_corners[corner_index - 1]);
+                chunk.corners.emplace_back(face_corners[corner_index]);
+            }
+        }
+        else if (tag == "o" || tag == "g") {
+            chunk.commands.emplace_back(ObjCommand{ObjCommandType::GROUP, chunk.corners.size(), {}});
+        }
+        else if (tag == "usemtl") {
+            chunk.commands.emplace_back(
+                ObjCommand{ObjCommandType::MATERIAL, chunk.corners.size(), std::string(line.parse_word())}
+            );
+        }
+        else if (tag == "mtllib") {
+            chunk.commands.emplace_back(
+                ObjCommand{ObjCommandType::MATERIAL_LIBRARY, chunk.corners.size(), std::string(line.parse_word())}
+            );
+        }
+    }
 
-            texcoords_indices.back().emplace_back(part_indices[3 + quad_faces]);
-            texcoords_indices.back().emplace_back(part_indices[4 + quad_faces]);
-            texcoords_indices.back().emplace_back(part_indices[5 + quad_faces]);
+    return chunk;
+}
 
-            auto const quad_stride = static_cast<uint8_t>(quad_faces * 2);
+/// Open-addressing hash map associating the attribute indices of the vertices to their index in the submesh.
+class ObjVertexIndexMap {
+public:
+    explicit ObjVertexIndexMap(size_t expected_count)
+    {
+        size_t capacity = 64;
 
-            normals_indices.back().emplace_back(part_indices[6 + quad_stride]);
-            normals_indices.back().emplace_back(part_indices[7 + quad_stride]);
-            normals_indices.back().emplace_back(part_indices[8 + quad_stride]);
+        while (capacity < expected_count * 2) {
+            capacity *= 2;
         }
-        else if (line[0] == 'm') { // Material import (mtllib)
-            std::string mtl_filename;
-            file >> mtl_filename;
 
-            std::string const mtl_filepath = filepath.recover_path_to_file() + mtl_filename;
-            load_mtl(mtl_filepath, mesh_renderer.get_materials(), material_correspond_indices);
+        slots.resize(capacity);
+    }
+
+    /// Finds the index of a vertex, inserting it with the given index if it does not exist yet.
+    /// \param key Position, texcoords & normal indices of the vertex.
+    /// \param index Index of the vertex if inserted.
+    /// \return Index of the vertex & true if it has been inserted, false if it already existed.
+    std::pair<uint32_t, bool> try_emplace(std::array<uint32_t, 3> const& key, uint32_t index)
+    {
+        // The load factor is kept below 0.7, so that probe sequences remain short
+        if ((count + 1) * 10 > slots.size() * 7) {
+            grow();
         }
-        else if (line[0] == 'u') { // Material usage (usemtl)
-            if (material_correspond_indices.empty()) {
-                continue;
-            }
 
-            std::string material_name;
-            file >> material_name;
+        size_t const mask = slots.size() - 1;
 
-            auto const correspond_material = material_correspond_indices.find(material_name);
+        for (size_t slot_index = compute_hash(key) & mask;; slot_index = (slot_index + 1) & mask) {
+            Slot& slot = slots[slot_index];
 
-            if (correspond_material == material_correspond_indices.cend()) {
-                Log::error("[ObjLoad] No corresponding material found with the name '" + material_name + "'.");
+            if (slot.value == invalid_index) {
+                slot.key = key;
+                slot.value = index;
+                ++count;
+                return {index, true};
             }
-            else {
-                mesh_renderer.get_submesh_renderers().back().set_material_index(correspond_material->second);
+
+            if (slot.key == key) {
+                return {slot.value, false};
             }
         }
-        else if (line[0] == 'o' || line[0] == 'g') {
-            if (!pos_indices.front().empty()) {
-                size_t const new_size = pos_indices.size() + 1;
-                pos_indices.resize(new_size);
-                texcoords_indices.resize(new_size);
-                normals_indices.resize(new_size);
+    }
+
+private:
+    struct Slot {
+        std::array<uint32_t, 3> key{};
+        uint32_t value = invalid_index;
+    };
+
+    std::vector<Slot> slots{};
+    size_t count = 0;
+
+    static size_t compute_hash(std::array<uint32_t, 3> const& key)
+    {
+        uint64_t hash = key[0] * 0x9E3779B97F4A7C15ull;
+        hash ^= key[1] * 0xC2B2AE3D27D4EB4Full;
+        hash ^= key[2] * 0x165667B19E3779F9ull;
+
+        return hash ^ (hash >> 29u);
+    }
+
+    void grow()
+    {
+        std::vector<Slot> const previous_slots = std::exchange(slots, std::vector<Slot>(slots.size() * 2));
+        size_t const mask = slots.size() - 1;
 
-                mesh.add_submesh();
-                mesh_renderer.add_submesh_renderer().set_material_index(std::numeric_limits<size_t>::max());
+        for (Slot const& previous_slot : previous_slots) {
+            if (previous_slot.value == invalid_index) {
+                continue;
+            }
+
+            size_t slot_index = compute_hash(previous_slot.key) & mask;
+
+            while (slots[slot_index].value != invalid_index) {
+                slot_index = (slot_index + 1) & mask;
             }
 
-            std::getline(file, line);
+            slots[slot_index] = previous_slot;
+        }
+    }
+};
+
+/// Resolves an attribute index of a face corner into an index in the whole file.
+/// \param corner Parsed corner.
+/// \param part_index Index of the attribute (0 for the position, 1 for the texcoords & 2 for the normal).
+/// \param chunk_offset Number of elements of this attribute preceding the chunk the corner has been parsed from.
+/// \param count Total number of elements of this attribute.
+/// \return Resolved index; invalid_index if the attribute is absent or out of range.
+uint32_t resolve_index(ObjCorner const& corner, size_t part_index, size_t chunk_offset, size_t count)
+{
+    int32_t const index = corner.indices[part_index];
+
+    if (index == absent_index) {
+        return invalid_index;
+    }
+
+    bool const is_relative = ((corner.relative_mask >> part_index) & 1u) != 0;
+    int64_t const resolved_index = index + (is_relative ? static_cast<int64_t>(chunk_offset) : 0);
+
+    if (resolved_index < 0 || static_cast<size_t>(resolved_index) >= count) {
+        return invalid_index;
+    }
+
+    return static_cast<uint32_t>(resolved_index);
+}
+
+/// Materials referenced by an OBJ file, which are loaded along with the graphics resources.
+struct ObjMaterials {
+    std::vector<std::string> material_libraries; ///< Paths to the MTL files, relative to the OBJ file's directory.
+    std::vector<std::string> submesh_materials;  ///< Name of each submesh's material; empty if none is used.
+};
+
+MeshRendererData load_mesh_renderer(Mesh const& mesh, ObjMaterials const& obj_materials, FilePath const& filepath)
+{
+    ZoneScopedN("[ObjLoad]::load_mesh_renderer");
+
+    MeshRendererData mesh_renderer;
+    std::unordered_map<std::string, size_t> material_correspond_indices;
+
+    for (std::string const& material_library : obj_materials.material_libraries) {
+        load_mtl(
+            filepath.recover_path_to_file() + material_library, mesh_renderer.get_materials(),
+            material_correspond_indices
+        );
+    }
+
+    for (size_t submesh_index = 0; submesh_index < obj_materials.submesh_materials.size(); ++submesh_index) {
+        SubmeshRenderer& submesh_renderer = mesh_renderer.add_submesh_renderer();
+
+        // Only the first submesh uses the first material by default
+        if (submesh_index != 0) {
+            submesh_renderer.set_material_index(std::numeric_limits<size_t>::max());
+        }
+
+        std::string const& material_name = obj_materials.submesh_materials[submesh_index];
+
+        if (material_name.empty() || material_correspond_indices.empty()) {
+            continue;
+        }
+
+        auto const correspond_material = material_correspond_indices.find(material_name);
+
+        if (correspond_material == material_correspond_indices.cend()) {
+            Log::error("[ObjLoad] No corresponding material found with the name '" + material_name + "'.");
         }
         else {
-            std::getline(file, line); // Skip the rest of the line
+            submesh_renderer.set_material_index(correspond_material->second);
         }
     }
 
-    auto const pos_count = static_cast<int64_t>(positions.size());
-    auto const tex_count = static_cast<int64_t>(texcoords.size());
-    auto const norm_count = static_cast<int64_t>(normals.size());
+    // Creating the mesh renderer from the mesh's data
+    mesh_renderer.load(mesh);
 
-    std::map<std::array<size_t, 3>, uint32_t> indices_map;
+    Log::vdebug(
+        "[ObjLoad] Loaded OBJ file ({} submesh(es), {} vertices, {} triangles, {} material(s))",
+        mesh.get_submeshes().size(), mesh.recover_vertex_count(), mesh.recover_triangle_count(),
+        mesh_renderer.get_materials().size()
+    );
 
-    for (size_t submesh_index = 0; submesh_index < mesh.get_submeshes().size(); ++submesh_index) {
-        Submesh& submesh = mesh.get_submeshes()[submesh_index];
-        indices_map.clear();
+    return mesh_renderer;
+}
+}
 
-        for (size_t part_index = 0; part_index < pos_indices[submesh_index].size(); ++part_index) {
-            // Face (vertices indices triplets), containing position/texcoords/normals
-            // vert_indices[i][j] -> vertex i, feature j (j = 0 -> position, j = 1 -> texcoords, j = 2 -> normal)
-            std::array<std::array<size_t, 3>, 3> vert_indices{};
+std::pair<Mesh, std::function<MeshRendererData(Mesh const&)>> parse(FilePath const& filepath)
+{
+    ZoneScopedN("ObjFormat::parse");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
 
-            // First vertex information
-            int64_t temp_index = pos_indices[submesh_index][part_index];
-            vert_indices[0][0] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + pos_count) : static_cast<size_t>(temp_index - 1));
+    Log::debug("[ObjLoad] Loading OBJ file ('" + filepath + "')...");
 
-            temp_index = texcoords_indices[submesh_index][part_index];
-            vert_indices[0][1] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + tex_count) : static_cast<size_t>(temp_index - 1));
+    if (!FileUtils::is_readable(filepath)) {
+        throw std::invalid_argument("Error: Couldn't open the OBJ file '" + filepath + '\'');
+    }
 
-            temp_index = normals_indices[submesh_index][part_index];
-            vert_indices[0][2] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + norm_count) : static_cast<size_t>(temp_index - 1));
+    MappedFile const file(filepath);
+    auto const* const file_begin = reinterpret_cast<char const*>(file.data());
+    char const* const file_end = file_begin + file.size();
 
-            ++part_index;
+    // Splitting the file into chunks ending on line boundaries, each being parsed independently
+    std::vector<char const*> chunk_bounds = {file_begin};
 
-            // Second vertex information
-            temp_index = pos_indices[submesh_index][part_index];
-            vert_indices[1][0] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + pos_count) : static_cast<size_t>(temp_index - 1));
+    // Several chunks are given to each thread, so that unevenly dense chunks do not leave threads idle
+    size_t const chunk_size = std::max(file.size() / (get_system_thread_count() * 4), min_chunk_size);
 
-            temp_index = texcoords_indices[submesh_index][part_index];
-            vert_indices[1][1] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + tex_count) : static_cast<size_t>(temp_index - 1));
+    while (chunk_bounds.back() != file_end) {
+        auto const remaining_size = static_cast<size_t>(file_end - chunk_bounds.back());
+        char const* chunk_end = chunk_bounds.back() + std::min(chunk_size, remaining_size);
 
-            temp_index = normals_indices[submesh_index][part_index];
-            vert_indices[1][2] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + norm_count) : static_cast<size_t>(temp_index - 1));
+        if (chunk_end != file_end) {
+            auto const* const line_end = static_cast<char const*>(
+                std::memchr(chunk_end, '\n', static_cast<size_t>(file_end - chunk_end))
+            );
+            chunk_end = (line_end != nullptr ? line_end + 1 : file_end);
+        }
 
-            ++part_index;
+        chunk_bounds.emplace_back(chunk_end);
+    }
 
-            // Third vertex information
-            temp_index = pos_indices[submesh_index][part_index];
-            vert_indices[2][0] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + pos_count) : static_cast<size_t>(temp_index - 1));
+    std::vector<ObjChunk> chunks(chunk_bounds.size() - 1);
 
-            temp_index = texcoords_indices[submesh_index][part_index];
-            vert_indices[2][1] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + tex_count) : static_cast<size_t>(temp_index - 1));
+    if (!chunks.empty()) {
+        ZoneScopedN("[ObjLoad]::parse_chunks");
 
-            temp_index = normals_indices[submesh_index][part_index];
-            vert_indices[2][2] =
-                (temp_index < 0 ? static_cast<size_t>(temp_index + norm_count) : static_cast<size_t>(temp_index - 1));
+        parallelize(0u, chunks.size(), [&chunks, &chunk_bounds](IndexRange const& range) {
+            for (size_t chunk_index = range.begin_index; chunk_index < range.end_index; ++chunk_index) {
+                chunks[chunk_index] = parse_chunk(chunk_bounds[chunk_index], chunk_bounds[chunk_index + 1]);
+            }
+        });
+    }
 
-            std::array<Vector3f, 3> const face_positions = {
-                positions[vert_indices[0][0]], positions[vert_indices[1][0]], positions[vert_indices[2][0]]
-            };
+    // Merging the chunks' attributes, remembering where each chunk's ones start to resolve its relative indices
+    std::vector<Vector3f> positions;
+    std::vector<Vector2f> texcoords;
+    std::vector<Vector3f> normals;
+    std::vector<std::array<size_t, 3>> chunk_offsets;
+    chunk_offsets.reserve(chunks.size());
+
+    for (ObjChunk& chunk : chunks) {
+        chunk_offsets.push_back({positions.size(), texcoords.size(), normals.size()});
+
+        positions.insert(positions.end(), chunk.positions.cbegin(), chunk.positions.cend());
+        texcoords.insert(texcoords.end(), chunk.texcoords.cbegin(), chunk.texcoords.cend());
+        normals.insert(normals.end(), chunk.normals.cbegin(), chunk.normals.cend());
+
+        chunk.positions = {};
+        chunk.texcoords = {};
+        chunk.normals = {};
+    }
 
-            std::array<Vector2f, 3> face_texcoords{};
-            if (!texcoords.empty()) {
-                face_texcoords[0] = texcoords[vert_indices[0][1]];
-                face_texcoords[1] = texcoords[vert_indices[1][1]];
-                face_texcoords[2] = texcoords[vert_indices[2][1]];
+    Mesh mesh;
+    ObjMaterials obj_materials;
+
+    mesh.add_submesh();
+    obj_materials.submesh_materials.emplace_back();
+
+    // Attributing the corners to the submeshes, by applying the chunks' commands in the order they appear in the file
+    std::vector<std::vector<ObjCornerRange>> submesh_ranges(1);
+    bool submesh_has_faces = false;
+
+    auto const add_corners = [&submesh_ranges, &submesh_has_faces](size_t chunk_index, size_t begin, size_t end) {
+        if (begin != end) {
+            submesh_ranges.back().emplace_back(ObjCornerRange{chunk_index, begin, end});
+            submesh_has_faces = true;
+        }
+    };
+
+    for (size_t chunk_index = 0; chunk_index < chunks.size(); ++chunk_index) {
+        ObjChunk const& chunk = chunks[chunk_index];
+        size_t corner_index = 0;
+
+        for (ObjCommand const& command : chunk.commands) {
+            add_corners(chunk_index, corner_index, command.corner_offset);
+            corner_index = command.corner_offset;
+
+            switch (command.type) {
+            case ObjCommandType::GROUP:
+                if (submesh_has_faces) {
+                    mesh.add_submesh();
+                    obj_materials.submesh_materials.emplace_back();
+                    submesh_ranges.emplace_back();
+                    submesh_has_faces = false;
+                }
+
+                break;
+
+            case ObjCommandType::MATERIAL:
+                obj_materials.submesh_materials.back() = command.name;
+                break;
+
+            case ObjCommandType::MATERIAL_LIBRARY:
+                obj_materials.material_libraries.emplace_back(command.name);
+                break;
             }
+        }
 
-            std::array<Vector3f, 3> face_normals{};
-            if (!normals.empty()) {
-                face_normals[0] = normals[vert_indices[0][2]];
-                face_normals[1] = normals[vert_indices[1][2]];
-                face_normals[2] = normals[vert_indices[2][2]];
+        add_corners(chunk_index, corner_index, chunk.corners.size());
+    }
+
+    // Building each submesh's vertices & indices, deduplicating the corners sharing the same attributes
+    std::atomic_bool has_invalid_indices = false;
+
+    parallelize(0u, submesh_ranges.size(), [&](IndexRange const& range) {
+        for (size_t submesh_index = range.begin_index; submesh_index < range.end_index; ++submesh_index) {
+            ZoneScopedN("[ObjLoad]::build_submesh");
+
+            Submesh& submesh = mesh.get_submeshes()[submesh_index];
+            std::vector<ObjCornerRange> const& ranges = submesh_ranges[submesh_index];
+
+            size_t corner_count = 0;
+            for (ObjCornerRange const& corner_range : ranges) {
+                corner_count += corner_range.end - corner_range.begin;
             }
 
-            for (uint8_t vert_part_index = 0; vert_part_index < 3; ++vert_part_index) {
-                auto const index_it = indices_map.find(vert_indices[vert_part_index]);
+            std::vector<uint32_t>& indices = submesh.get_triangle_indices();
+            indices.reserve(corner_count);
 
-                if (index_it != indices_map.cend()) {
-                    submesh.get_triangle_indices().emplace_back(index_it->second);
-                    continue;
-                }
+            // Vertices are usually shared by several triangles, a closed mesh having about twice as many triangles
+            ObjVertexIndexMap vertex_indices(corner_count / 6);
+
+            for (ObjCornerRange const& corner_range : ranges) {
+                std::array<size_t, 3> const& offsets = chunk_offsets[corner_range.chunk_index];
+                std::vector<ObjCorner> const& corners = chunks[corner_range.chunk_index].corners;
+
+                for (size_t corner_index = corner_range.begin; corner_index < corner_range.end; ++corner_index) {
+                    ObjCorner const& corner = corners[corner_index];
+                    std::array<uint32_t, 3> const key = {
+                        resolve_index(corner, 0, offsets[0], positions.size()),
+                        resolve_index(corner, 1, offsets[1], texcoords.size()),
+                        resolve_index(corner, 2, offsets[2], normals.size())
+                    };
+
+                    if (key[0] == invalid_index) {
+                        has_invalid_indices = true;
+                    }
+
+                    auto const [vertex_index, is_new_vertex] =
+                        vertex_indices.try_emplace(key, static_cast<uint32_t>(submesh.get_vertices().size()));
+                    indices.emplace_back(vertex_index);
 
-                Vertex vert{
-                    face_positions[vert_part_index], face_texcoords[vert_part_index], face_normals[vert_part_index]
-                };
+                    if (!is_new_vertex) {
+                        continue;
+                    }
+
+                    Vertex& vertex = submesh.get_vertices().emplace_back();
 
-                submesh.get_triangle_indices().emplace_back(static_cast<uint32_t>(indices_map.size()));
-                indices_map.emplace(vert_indices[vert_part_index], static_cast<uint32_t>(indices_map.size()));
-                submesh.get_vertices().emplace_back(std::move(vert));
+                    if (key[0] != invalid_index) {
+                        vertex.position = positions[key[0]];
+                    }
+                    if (key[1] != invalid_index) {
+                        vertex.texcoords = texcoords[key[1]];
+                    }
+                    if (key[2] != invalid_index) {
+                        vertex.normal = normals[key[2]];
+                    }
+                }
             }
+
+            submesh.compute_bounding_box();
         }
+    });
 
-        submesh.compute_bounding_box();
+    if (has_invalid_indices) {
+        Log::warning("[ObjLoad] Some faces reference nonexistent positions; their vertices are placed at the origin");
     }
 
     mesh.compute_tangents();
 
-    // Creating the mesh renderer from the mesh's data
-    mesh_renderer.load(mesh);
+    // OBJ faces are listed in file order, which rarely suits the vertex cache
+    if (MeshOptimizer::is_enabled_on_import()) {
+        MeshOptimizer::optimize(mesh);
+    }
 
-    Log::vdebug(
-        "[ObjLoad] Loaded OBJ file ({} submesh(es), {} vertices, {} triangles, {} material(s))",
-        mesh.get_submeshes().size(), mesh.recover_vertex_count(), mesh.recover_triangle_count(),
-        mesh_renderer.get_materials().size()
-    );
+    // The materials are loaded along with the graphics resources, as they create textures & shader programs
+    return {
+        std::move(mesh),
+        [obj_materials = std::move(obj_materials), filepath](Mesh const& parsed_mesh) {
+            return load_mesh_renderer(parsed_mesh, obj_materials, filepath);
+        }
+    };
+}
+
+std::pair<Mesh, MeshRendererData> load(FilePath const& filepath)
+{
+    ZoneScopedN("ObjFormat::load");
+
+    auto [mesh, load_renderer] = parse(filepath);
+    MeshRendererData mesh_renderer = load_renderer(mesh);
 
     return {std::move(mesh), std::move(mesh_renderer)};
 }
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #include <data/off_format.hpp>
 #include <data/mesh.hpp>
+#include <utils/file_utils.hpp>
 #include <utils/filepath.hpp>
 
 #include <tracy/Tracy.hpp>
@@ -12,12 +13,13 @@ Mesh load(FilePath const& filepath)
 
     Log::debug("[OffLoad] Loading OFF file ('" + filepath + "')...");
 
-    std::ifstream file(filepath, std::ios_base::binary);
-
-    if (!file) {
+    if (!FileUtils::is_readable(filepath)) {
         throw std::invalid_argument("Error: Could not open the OFF file '" + filepath + '\'');
     }
 
+    // The file is read through the virtual file system, & can thus be held by a mounted archive
+    std::istringstream file(FileUtils::read_file_to_string(filepath), std::ios_base::binary);
+
     Mesh mesh;
     Submesh& submesh = mesh.add_submesh();
 
@@ -52,6 +52,8 @@ public:
 
     AABB const& get_bounding_box() const { return bounding_box; }
 
+    void set_bounding_box(AABB const& bounding_box) { this->bounding_box = bounding_box; }
+
     /// Computes & updates the submesh's bounding box.
     /// \return Submesh's bounding box.
     AABB const& compute_bounding_box();
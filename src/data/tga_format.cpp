@@ -1,6 +1,7 @@
 #include "tga_format.hpp"
 
 #include <data/image.hpp>
+#include <utils/file_utils.hpp>
 #include <utils/filepath.hpp>
 
 #include <tracy/Tracy.hpp>
@@ -13,12 +14,13 @@ Image load(FilePath const& filepath, bool flip_vertically)
 
     Log::debug("[TgaFormat] Loading TGA file ('" + filepath + "')...");
 
-    std::ifstream file(filepath, std::ios_base::binary);
-
-    if (!file) {
+    if (!FileUtils::is_readable(filepath)) {
         throw std::invalid_argument("Error: Could not open the PNG file '" + filepath + "'");
     }
 
+    // The file is read through the virtual file system, & can thus be held by a mounted archive
+    std::istringstream file(FileUtils::read_file_to_string(filepath), std::ios_base::binary);
+
     // Declaring a single array of unsigned char, reused everywhere later
     std::array<uint8_t, 2> bytes{};
 
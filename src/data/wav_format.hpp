@@ -2,6 +2,7 @@
 
 namespace xen {
 struct AudioData;
+class AudioStream;
 class FilePath;
 
 namespace WavFormat {
@@ -10,6 +11,13 @@ namespace WavFormat {
 /// \return Imported audio data.
 AudioData load(FilePath const& filepath);
 
+/// Opens a [WAV](https://en.wikipedia.org/wiki/WAV) file to be streamed. The file is memory-mapped, its samples being
+///   read only when needed.
+/// \param filepath File from which to stream the audio.
+/// \return Audio stream over the file.
+/// \see StreamedSound
+std::unique_ptr<AudioStream> open_stream(FilePath const& filepath);
+
 /// Saves audio data to a [WAV](https://en.wikipedia.org/wiki/WAV) file.
 /// \param filepath File to which to save the sound.
 /// \param data Audio data to export.
@@ -1,6 +1,9 @@
 #include <data/wav_format.hpp>
 #include <audio/audio_data.hpp>
+#include <audio/audio_stream.hpp>
 #include <utils/filepath.hpp>
+#include <utils/file_utils.hpp>
+#include <utils/mapped_file.hpp>
 
 #include <tracy/Tracy.hpp>
 
@@ -26,17 +29,63 @@ struct WavInfo {
     uint16_t bytes_per_block{};
     uint16_t bits_per_sample{};
     uint32_t data_size{};
+    size_t data_offset{}; ///< Offset of the audio data from the beginning of the file.
 };
 
-void load_fmt(std::ifstream& file, WavInfo& info)
-{
-    std::array<uint8_t, 4> bytes{};
+/// Reader over the bytes of a mapped WAV file, failing instead of reading past its end.
+class WavReader {
+public:
+    explicit WavReader(MappedFile const& mapped_file) : file{mapped_file} {}
+
+    size_t get_offset() const { return offset; }
+
+    std::array<uint8_t, 4> read4()
+    {
+        check_remaining(4);
+
+        std::array<uint8_t, 4> bytes{};
+        std::memcpy(bytes.data(), file.data() + offset, 4);
+        offset += 4;
+
+        return bytes;
+    }
+
+    uint32_t read32() { return from_little_endian(read4()); }
+
+    uint16_t read16()
+    {
+        check_remaining(2);
+
+        uint16_t const value = from_little_endian(file.data()[offset], file.data()[offset + 1]);
+        offset += 2;
+
+        return value;
+    }
 
-    file.read(reinterpret_cast<char*>(bytes.data()), 4); // Format block size - 16
-    info.format_block_size = from_little_endian(bytes);
+    /// Skips the given number of bytes; reaching the end of the file is not an error.
+    /// \param byte_count Number of bytes to skip.
+    void skip(size_t byte_count) { offset += std::min(byte_count, file.size() - offset); }
 
-    file.read(reinterpret_cast<char*>(bytes.data()), 2); // Audio format
-    info.audio_format = from_little_endian(bytes[0], bytes[1]);
+    bool is_at_end() const { return (offset >= file.size()); }
+
+private:
+    MappedFile const& file;
+    size_t offset = 0;
+
+    void check_remaining(size_t byte_count) const
+    {
+        if (byte_count > file.size() - offset) {
+            throw std::invalid_argument("[WavLoad] Unexpected end of file");
+        }
+    }
+};
+
+void load_fmt(WavReader& reader, WavInfo& info)
+{
+    info.format_block_size = reader.read32(); // Format block size - 16
+    size_t const format_block_end = reader.get_offset() + info.format_block_size;
+
+    info.audio_format = reader.read16(); // Audio format
     // 0: Unknown
     // 1: PCM (uncompressed)
     // 2: Microsoft ADPCM
@@ -53,8 +102,7 @@ void load_fmt(std::ifstream& file, WavInfo& info)
         Log::warning("[WavLoad] Only WAV files with a PCM format are supported.");
     }
 
-    file.read(reinterpret_cast<char*>(bytes.data()), 2); // Channel count
-    info.channel_count = from_little_endian(bytes[0], bytes[1]);
+    info.channel_count = reader.read16(); // Channel count
     // 1 channel:  mono
     // 2 channels: stereo
     // 3 channels: left, center & right
@@ -62,35 +110,29 @@ void load_fmt(std::ifstream& file, WavInfo& info)
     // 5 channels: left, center, right & surround
     // 6 channels: left, center left, center, center right, right & surround
 
-    file.read(reinterpret_cast<char*>(bytes.data()), 4); // Sampling frequency
-    info.frequency = from_little_endian(bytes);
-
-    file.read(reinterpret_cast<char*>(bytes.data()), 4); // Bytes per second (frequency * bytes per block)
-    info.bytes_per_second = from_little_endian(bytes);
+    info.frequency = reader.read32();        // Sampling frequency
+    info.bytes_per_second = reader.read32(); // Bytes per second (frequency * bytes per block)
+    info.bytes_per_block = reader.read16();  // Bytes per block (bits per sample / 8 * channel count)
+    info.bits_per_sample = reader.read16();  // Bits per sample (bit depth)
 
-    file.read(reinterpret_cast<char*>(bytes.data()), 2); // Bytes per block (bits per sample / 8 * channel count)
-    info.bytes_per_block = from_little_endian(bytes[0], bytes[1]);
-
-    file.read(reinterpret_cast<char*>(bytes.data()), 2); // Bits per sample (bit depth)
-    info.bits_per_sample = from_little_endian(bytes[0], bytes[1]);
+    // Extended format blocks hold additional fields, which are ignored
+    if (format_block_end > reader.get_offset()) {
+        reader.skip(format_block_end - reader.get_offset());
+    }
 }
 
-std::optional<WavInfo> validate_wav(std::ifstream& file)
+std::optional<WavInfo> validate_wav(MappedFile const& file)
 {
     WavInfo info{};
+    WavReader reader(file);
 
-    std::array<uint8_t, 4> bytes{};
-
-    file.read(reinterpret_cast<char*>(bytes.data()), 4); // 'RIFF'
-    if (bytes[0] != 'R' && bytes[1] != 'I' && bytes[2] != 'F' && bytes[3] != 'F') {
+    if (reader.read4() != std::array<uint8_t, 4>{'R', 'I', 'F', 'F'}) {
         return std::nullopt;
     }
 
-    file.read(reinterpret_cast<char*>(bytes.data()), 4); // File size - 8
-    info.file_size = from_little_endian(bytes);          // Values are in little-endian; they must be converted
+    info.file_size = reader.read32(); // File size - 8
 
-    file.read(reinterpret_cast<char*>(bytes.data()), 4); // 'WAVE'
-    if (bytes[0] != 'W' && bytes[1] != 'A' && bytes[2] != 'V' && bytes[3] != 'E') {
+    if (reader.read4() != std::array<uint8_t, 4>{'W', 'A', 'V', 'E'}) {
         return std::nullopt;
     }
 
@@ -99,111 +141,181 @@ std::optional<WavInfo> validate_wav(std::ifstream& file)
     // - https://en.wikipedia.org/wiki/WAV#File_specifications
     // - https://en.wikipedia.org/wiki/Broadcast_Wave_Format#Details
     // - https://stackoverflow.com/a/76137824/3292304
-    while (file) {
-        file.read(reinterpret_cast<char*>(bytes.data()), 4);
+    while (!reader.is_at_end()) {
+        std::array<uint8_t, 4> const chunk_id = reader.read4();
 
-        if (bytes[0] == 'f' && bytes[1] == 'm' && bytes[2] == 't' && bytes[3] == ' ') {
-            load_fmt(file, info);
+        if (chunk_id == std::array<uint8_t, 4>{'f', 'm', 't', ' '}) {
+            load_fmt(reader, info);
             continue;
         }
 
-        if (bytes[0] == 'd' && bytes[1] == 'a' && bytes[2] == 't' && bytes[3] == 'a') {
-            file.read(
-                reinterpret_cast<char*>(bytes.data()), 4
-            ); // Data size (file size - header size (theoretically 44 bytes))
-            info.data_size = from_little_endian(bytes);
+        if (chunk_id == std::array<uint8_t, 4>{'d', 'a', 't', 'a'}) {
+            info.data_size = reader.read32(); // Data size (file size - header size (theoretically 44 bytes))
+            info.data_offset = reader.get_offset();
+
+            // Files being written may have a data size larger than what is actually there
+            info.data_size = static_cast<uint32_t>(std::min<size_t>(info.data_size, file.size() - info.data_offset));
 
             return info;
         }
 
         // Unsupported chunk, skip it
-        file.read(reinterpret_cast<char*>(bytes.data()), 4); // Chunk size
-        file.ignore(from_little_endian(bytes));
+        reader.skip(reader.read32());
     }
 
     throw std::invalid_argument("[WavLoad] No data block found");
 }
-}
-AudioData load(FilePath const& filepath)
-{
-    ZoneScopedN("WavFormat::load");
-    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
-
-    Log::debug("[WavLoad] Loading WAV file ('" + filepath + "')...");
 
-    std::ifstream file(filepath, std::ios_base::binary);
-
-    if (!file) {
-        throw std::invalid_argument("[WavLoad] Could not open the WAV file '" + filepath + "'");
-    }
-
-    std::optional<WavInfo> const info = validate_wav(file);
-
-    if (info == std::nullopt) {
-        throw std::runtime_error("[WavLoad] '" + filepath + "' is not a valid WAV audio file");
-    }
-
-    AudioData audio_data{};
+AudioFormat recover_format(WavInfo const& info)
+{
+    AudioFormat format{};
 
     // Determining the right audio format
-    switch (info->bits_per_sample) {
+    switch (info.bits_per_sample) {
     case 8:
-        if (info->channel_count == 1) {
-            audio_data.format = AudioFormat::MONO_U8;
+        if (info.channel_count == 1) {
+            format = AudioFormat::MONO_U8;
         }
-        else if (info->channel_count == 2) {
-            audio_data.format = AudioFormat::STEREO_U8;
+        else if (info.channel_count == 2) {
+            format = AudioFormat::STEREO_U8;
         }
         break;
 
     case 16:
-        if (info->channel_count == 1) {
-            audio_data.format = AudioFormat::MONO_I16;
+        if (info.channel_count == 1) {
+            format = AudioFormat::MONO_I16;
         }
-        else if (info->channel_count == 2) {
-            audio_data.format = AudioFormat::STEREO_I16;
+        else if (info.channel_count == 2) {
+            format = AudioFormat::STEREO_I16;
         }
         break;
 
     case 32:
-        if (info->channel_count == 1) {
-            audio_data.format = AudioFormat::MONO_F32;
+        if (info.channel_count == 1) {
+            format = AudioFormat::MONO_F32;
         }
-        else if (info->channel_count == 2) {
-            audio_data.format = AudioFormat::STEREO_F32;
+        else if (info.channel_count == 2) {
+            format = AudioFormat::STEREO_F32;
         }
         break;
 
     case 64:
-        if (info->channel_count == 1) {
-            audio_data.format = AudioFormat::MONO_F64;
+        if (info.channel_count == 1) {
+            format = AudioFormat::MONO_F64;
         }
-        else if (info->channel_count == 2) {
-            audio_data.format = AudioFormat::STEREO_F64;
+        else if (info.channel_count == 2) {
+            format = AudioFormat::STEREO_F64;
         }
         break;
 
     default:
         throw std::runtime_error(
-            "[WavLoad] " + std::to_string(info->bits_per_sample) + " bits WAV files are unsupported"
+            "[WavLoad] " + std::to_string(info.bits_per_sample) + " bits WAV files are unsupported"
         );
     }
 
     // If the format is still unassigned, it is invalid
-    if (static_cast<int>(audio_data.format) == 0) {
+    if (static_cast<int>(format) == 0) {
         throw std::runtime_error("[WavLoad] Unsupported WAV channel count");
     }
 
-    audio_data.frequency = static_cast<int>(info->frequency);
+    return format;
+}
+
+MappedFile map_wav(FilePath const& filepath, WavInfo& info)
+{
+    if (!FileUtils::is_readable(filepath)) {
+        throw std::invalid_argument("[WavLoad] Could not open the WAV file '" + filepath + "'");
+    }
+
+    MappedFile file(filepath);
+    std::optional<WavInfo> const validated_info = validate_wav(file);
+
+    if (validated_info == std::nullopt) {
+        throw std::runtime_error("[WavLoad] '" + filepath + "' is not a valid WAV audio file");
+    }
+
+    info = *validated_info;
+
+    return file;
+}
+
+/// Audio stream reading a WAV file's samples directly from its mapping, seeking thus being free.
+class WavStream final : public AudioStream {
+public:
+    WavStream(MappedFile mapped_file, WavInfo const& info) : file{std::move(mapped_file)}, data_offset{info.data_offset}
+    {
+        format = recover_format(info);
+        frequency = info.frequency;
+        frame_size = (info.bits_per_sample / 8u) * info.channel_count;
+        data_size = info.data_size - info.data_size % frame_size;
+        frame_count = data_size / frame_size;
+    }
+
+    size_t read(std::span<uint8_t> buffer) override
+    {
+        ZoneScopedN("WavStream::read");
+
+        size_t const byte_count = std::min(buffer.size() - buffer.size() % frame_size, data_size - read_offset);
+
+        std::memcpy(buffer.data(), file.data() + data_offset + read_offset, byte_count);
+        read_offset += byte_count;
+
+        return byte_count;
+    }
 
-    // Reading the actual audio data from the file
-    audio_data.buffer.resize(info->data_size);
-    file.read(
-        reinterpret_cast<char*>(audio_data.buffer.data()), static_cast<std::streamsize>(audio_data.buffer.size())
+    void seek(uint64_t frame_index) override
+    {
+        read_offset = static_cast<size_t>(std::min<uint64_t>(frame_index * frame_size, data_size));
+    }
+
+private:
+    MappedFile file;
+    size_t data_offset{};
+    size_t data_size{};
+    size_t frame_size{};
+    size_t read_offset = 0;
+};
+} // namespace
+
+AudioData load(FilePath const& filepath)
+{
+    ZoneScopedN("WavFormat::load");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[WavLoad] Loading WAV file ('" + filepath + "')...");
+
+    WavInfo info{};
+    MappedFile const file = map_wav(filepath, info);
+
+    AudioData audio_data{};
+    audio_data.format = recover_format(info);
+    audio_data.frequency = static_cast<int>(info.frequency);
+
+    // Copying the actual audio data from the file
+    audio_data.buffer.assign(
+        file.data() + info.data_offset, file.data() + info.data_offset + static_cast<size_t>(info.data_size)
     );
 
     Log::debug("[WavLoad] Loaded WAV file");
 
     return audio_data;
 }
-}
\ No newline at end of file
+
+std::unique_ptr<AudioStream> open_stream(FilePath const& filepath)
+{
+    ZoneScopedN("WavFormat::open_stream");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[WavLoad] Opening WAV stream ('" + filepath + "')...");
+
+    WavInfo info{};
+    MappedFile file = map_wav(filepath, info);
+
+    auto stream = std::make_unique<WavStream>(std::move(file), info);
+
+    Log::vdebug("[WavLoad] Opened WAV stream ({} frames at {} Hz)", stream->get_frame_count(), info.frequency);
+
+    return stream;
+}
+}
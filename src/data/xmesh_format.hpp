@@ -0,0 +1,61 @@
+#pragma once
+
+namespace xen {
+class FilePath;
+class Mesh;
+class MeshRendererData;
+
+/// Engine-native binary mesh format (.xmesh), holding meshes in the layout they are sent to the graphics card so that
+/// loading them neither parses text nor recomputes tangents or deduplicates vertices. The file is memory-mapped, & the
+/// vertices & indices are uploaded directly from the mapping.
+/// Layout, all values being little-endian:
+/// - A Header;
+/// - An array of SubmeshEntry, one per submesh;
+/// - The materials, each holding its type, its attributes & its textures. Textures made of a single color are stored
+///   as such, others are saved as images next to the file & referenced by their path relative to it;
+/// - The vertices & indices of each submesh, whose offsets are aligned on 16 bytes.
+namespace XmeshFormat {
+/// Version of the format, to be incremented whenever the layout or the Vertex structure changes.
+constexpr uint32_t version = 1;
+constexpr std::array<char, 4> magic_number = {'X', 'M', 'S', 'H'};
+
+struct Header {
+    std::array<char, 4> magic{};
+    uint32_t version = 0;
+    uint32_t vertex_size = 0; ///< Size of a vertex in bytes, which must match the Vertex structure's.
+    uint32_t submesh_count = 0;
+    uint32_t material_count = 0;
+    uint32_t padding = 0;
+    std::array<float, 6> bounding_box{}; ///< Minimum & maximum positions of the whole mesh.
+};
+
+struct SubmeshEntry {
+    uint64_t vertex_offset = 0; ///< Offset of the vertices from the beginning of the file.
+    uint64_t line_index_offset = 0;
+    uint64_t triangle_index_offset = 0;
+    uint32_t vertex_count = 0;
+    uint32_t line_index_count = 0;
+    uint32_t triangle_index_count = 0;
+    uint32_t material_index = 0;         ///< Index of the submesh's material; the maximum value if none.
+    std::array<float, 6> bounding_box{}; ///< Minimum & maximum positions of the submesh.
+};
+
+/// Loads a mesh from an XMESH file.
+/// \param filepath File from which to load the mesh.
+/// \return Pair containing respectively the mesh's data (vertices & indices) and rendering information (materials,
+/// textures, ...).
+std::pair<Mesh, MeshRendererData> load(FilePath const& filepath);
+
+/// Loads only the rendering information of a mesh from an XMESH file, its vertices & indices being sent to the
+///   graphics card straight from the mapped file, without being copied into a mesh.
+/// \param filepath File from which to load the mesh.
+/// \return Rendering information of the mesh.
+MeshRendererData load_renderer(FilePath const& filepath);
+
+/// Saves a mesh to an XMESH file.
+/// \param filepath File to which to save the mesh.
+/// \param mesh Mesh to export data from; its tangents & bounding boxes are expected to have been computed.
+/// \param mesh_renderer Optional mesh renderer to export materials & textures from.
+void save(FilePath const& filepath, Mesh const& mesh, MeshRendererData const* mesh_renderer = nullptr);
+}
+}
@@ -0,0 +1,262 @@
+#include <data/mesh.hpp>
+#include <data/xmesh_format.hpp>
+#include <render/mesh_renderer.hpp>
+#include <render/texture.hpp>
+#include <render/texture_cache.hpp>
+#include <utils/file_utils.hpp>
+#include <utils/filepath.hpp>
+#include <utils/mapped_file.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <span>
+
+namespace xen::XmeshFormat {
+namespace {
+class Reader {
+public:
+    Reader(MappedFile const& file, FilePath const& filepath) : file{file}, filepath{filepath} {}
+
+    template <typename T>
+    T read_value()
+    {
+        check_range(offset, sizeof(T));
+
+        T value{};
+        std::memcpy(&value, file.data() + offset, sizeof(T));
+        offset += sizeof(T);
+
+        return value;
+    }
+
+    std::string read_string()
+    {
+        auto const length = read_value<uint32_t>();
+        check_range(offset, length);
+
+        std::string value(reinterpret_cast<char const*>(file.data() + offset), length);
+        offset += length;
+
+        return value;
+    }
+
+    /// Gets a view over an array of the mapped file, without copying it.
+    /// \tparam T Type of the array's elements.
+    /// \param data_offset Offset of the array from the beginning of the file.
+    /// \param count Number of elements.
+    /// \return View over the array.
+    template <typename T>
+    std::span<T const> view_data(uint64_t data_offset, uint32_t count) const
+    {
+        check_range(data_offset, static_cast<uint64_t>(count) * sizeof(T));
+
+        if (data_offset % alignof(T) != 0) {
+            throw std::runtime_error("[XmeshLoad] Misaligned data in '" + filepath + '\'');
+        }
+
+        return {reinterpret_cast<T const*>(file.data() + data_offset), count};
+    }
+
+private:
+    MappedFile const& file;
+    FilePath const& filepath;
+    size_t offset = 0;
+
+    void check_range(uint64_t data_offset, uint64_t data_size) const
+    {
+        if (data_offset > file.size() || data_size > file.size() - data_offset) {
+            throw std::runtime_error("[XmeshLoad] Unexpected end of file in '" + filepath + '\'');
+        }
+    }
+};
+
+AABB to_aabb(std::array<float, 6> const& bounding_box)
+{
+    return AABB(
+        Vector3f(bounding_box[0], bounding_box[1], bounding_box[2]),
+        Vector3f(bounding_box[3], bounding_box[4], bounding_box[5])
+    );
+}
+
+Material read_material(Reader& reader, FilePath const& filepath)
+{
+    ZoneScopedN("[XmeshLoad]::read_material");
+
+    Material material;
+    RenderShaderProgram& program = material.get_program();
+
+    auto const material_type = static_cast<MaterialType>(reader.read_value<uint32_t>());
+
+    for (auto attribute_count = reader.read_value<uint32_t>(); attribute_count > 0; --attribute_count) {
+        std::string const name = reader.read_string();
+        std::array<float, 4> values{};
+        auto const component_count = reader.read_value<uint32_t>();
+
+        if (component_count != 1 && component_count != 3 && component_count != 4) {
+            throw std::runtime_error("[XmeshLoad] Invalid material attribute in '" + filepath + '\'');
+        }
+
+        for (uint32_t component_index = 0; component_index < component_count; ++component_index) {
+            values[component_index] = reader.read_value<float>();
+        }
+
+        if (component_count == 1) {
+            program.set_attribute(values[0], name);
+        }
+        else if (component_count == 3) {
+            program.set_attribute(Vector3f(values[0], values[1], values[2]), name);
+        }
+        else {
+            program.set_attribute(Vector4f(values[0], values[1], values[2], values[3]), name);
+        }
+    }
+
+    for (auto texture_count = reader.read_value<uint32_t>(); texture_count > 0; --texture_count) {
+        std::string const uniform_name = reader.read_string();
+        bool const is_srgb = (reader.read_value<uint8_t>() != 0);
+
+        if (reader.read_value<uint8_t>() == 0) {
+            auto const color = reader.read_value<std::array<float, 4>>();
+            program.set_texture(Texture2D::create(Color(color[0], color[1], color[2], color[3])), uniform_name);
+            continue;
+        }
+
+        FilePath const texture_filepath = filepath.recover_path_to_file() + reader.read_string();
+
+        if (!FileUtils::is_readable(texture_filepath)) {
+            Log::warning("[XmeshLoad] Cannot load texture '" + texture_filepath + "'; the texture is ignored");
+            continue;
+        }
+
+        program.set_texture(TextureCache::load(texture_filepath, is_srgb), uniform_name);
+    }
+
+    material.load_type(material_type);
+
+    return material;
+}
+
+/// Loads the rendering information of a mapped XMESH file, sending its vertices & indices directly from the mapping.
+/// \param file Mapped file.
+/// \param filepath Path to the file.
+/// \param mesh Mesh to copy the vertices & indices into; may be null.
+/// \return Rendering information of the mesh.
+MeshRendererData load_mapped(MappedFile const& file, FilePath const& filepath, Mesh* mesh)
+{
+    Reader reader(file, filepath);
+    auto const header = reader.read_value<Header>();
+
+    if (header.magic != magic_number) {
+        throw std::runtime_error("[XmeshLoad] '" + filepath + "' is not an XMESH file");
+    }
+
+    if (header.version != version || header.vertex_size != sizeof(Vertex)) {
+        throw std::runtime_error(
+            "[XmeshLoad] '" + filepath + "' has been saved with an incompatible version (" +
+            std::to_string(header.version) + "); it must be exported again"
+        );
+    }
+
+    std::vector<SubmeshEntry> entries(header.submesh_count);
+
+    for (SubmeshEntry& entry : entries) {
+        entry = reader.read_value<SubmeshEntry>();
+    }
+
+    MeshRendererData mesh_renderer;
+
+    for (uint32_t material_index = 0; material_index < header.material_count; ++material_index) {
+        mesh_renderer.add_material(read_material(reader, filepath));
+    }
+
+    if (mesh != nullptr) {
+        mesh->get_submeshes().resize(entries.size());
+        mesh->set_bounding_box(to_aabb(header.bounding_box));
+    }
+
+    for (size_t submesh_index = 0; submesh_index < entries.size(); ++submesh_index) {
+        SubmeshEntry const& entry = entries[submesh_index];
+
+        std::span<Vertex const> const vertices = reader.view_data<Vertex>(entry.vertex_offset, entry.vertex_count);
+        std::span<uint32_t const> const line_indices =
+            reader.view_data<uint32_t>(entry.line_index_offset, entry.line_index_count);
+        std::span<uint32_t const> const triangle_indices =
+            reader.view_data<uint32_t>(entry.triangle_index_offset, entry.triangle_index_count);
+
+        bool const has_invalid_index = std::any_of(
+            triangle_indices.begin(), triangle_indices.end(),
+            [&vertices](uint32_t index) { return (index >= vertices.size()); }
+        );
+
+        if (has_invalid_index) {
+            throw std::runtime_error("[XmeshLoad] Invalid vertex index in '" + filepath + '\'');
+        }
+
+        SubmeshRenderer& submesh_renderer = mesh_renderer.add_submesh_renderer();
+        submesh_renderer.load(
+            vertices, line_indices, triangle_indices, RenderMode::TRIANGLE, mesh_renderer.get_vertex_format()
+        );
+        submesh_renderer.set_material_index(
+            entry.material_index < header.material_count ? entry.material_index : std::numeric_limits<size_t>::max()
+        );
+
+        if (mesh == nullptr) {
+            continue;
+        }
+
+        Submesh& submesh = mesh->get_submeshes()[submesh_index];
+        submesh.get_vertices().assign(vertices.begin(), vertices.end());
+        submesh.get_line_indices().assign(line_indices.begin(), line_indices.end());
+        submesh.get_triangle_indices().assign(triangle_indices.begin(), triangle_indices.end());
+        submesh.set_bounding_box(to_aabb(entry.bounding_box));
+    }
+
+    mesh_renderer.set_bounding_box(to_aabb(header.bounding_box));
+
+    // If no material exists, create a default one
+    if (mesh_renderer.get_materials().empty()) {
+        mesh_renderer.set_material(Material(MaterialType::COOK_TORRANCE));
+    }
+
+    Log::vdebug(
+        "[XmeshLoad] Loaded XMESH file ({} submesh(es), {} material(s))", entries.size(),
+        mesh_renderer.get_materials().size()
+    );
+
+    return mesh_renderer;
+}
+
+MappedFile map_file(FilePath const& filepath)
+{
+    Log::debug("[XmeshLoad] Loading XMESH file ('" + filepath + "')...");
+
+    if (!FileUtils::is_readable(filepath)) {
+        throw std::invalid_argument("Error: Couldn't open the XMESH file '" + filepath + '\'');
+    }
+
+    return MappedFile(filepath);
+}
+} // namespace
+
+std::pair<Mesh, MeshRendererData> load(FilePath const& filepath)
+{
+    ZoneScopedN("XmeshFormat::load");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    MappedFile const file = map_file(filepath);
+
+    Mesh mesh;
+    MeshRendererData mesh_renderer = load_mapped(file, filepath, &mesh);
+
+    return {std::move(mesh), std::move(mesh_renderer)};
+}
+
+MeshRendererData load_renderer(FilePath const& filepath)
+{
+    ZoneScopedN("XmeshFormat::load_renderer");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    MappedFile const file = map_file(filepath);
+    return load_mapped(file, filepath, nullptr);
+}
+}
@@ -0,0 +1,272 @@
+#include <data/image.hpp>
+#include <data/image_format.hpp>
+#include <data/mesh.hpp>
+#include <data/xmesh_format.hpp>
+#include <render/material.hpp>
+#include <render/mesh_renderer.hpp>
+#include <render/renderer.hpp>
+#include <render/texture.hpp>
+#include <utils/filepath.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace xen::XmeshFormat {
+namespace {
+static_assert(sizeof(Vertex) == 11 * sizeof(float), "Error: Vertices must be tightly packed to be saved as is.");
+
+/// Attributes saved with the materials, if they hold a float or a float vector.
+constexpr std::array<char const*, 8> attribute_names = {
+    MaterialAttribute::BaseColor, MaterialAttribute::Emissive, MaterialAttribute::Metallic,
+    MaterialAttribute::Roughness, MaterialAttribute::Sheen,    MaterialAttribute::Ambient,
+    MaterialAttribute::Specular,  MaterialAttribute::Opacity
+};
+
+constexpr size_t data_alignment = 16;
+
+template <typename T>
+void write_value(std::vector<uint8_t>& buffer, T const& value)
+{
+    auto const* bytes = reinterpret_cast<uint8_t const*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void write_string(std::vector<uint8_t>& buffer, std::string const& value)
+{
+    write_value(buffer, static_cast<uint32_t>(value.size()));
+    buffer.insert(buffer.end(), value.cbegin(), value.cend());
+}
+
+template <typename T>
+uint64_t write_data(std::vector<uint8_t>& buffer, std::vector<T> const& values)
+{
+    buffer.resize((buffer.size() + data_alignment - 1) / data_alignment * data_alignment);
+
+    uint64_t const offset = buffer.size();
+    auto const* bytes = reinterpret_cast<uint8_t const*>(values.data());
+    buffer.insert(buffer.end(), bytes, bytes + values.size() * sizeof(T));
+
+    return offset;
+}
+
+/// Computes the bounding box of vertices, the one stored in a submesh possibly not having been computed.
+/// \param vertices Vertices to compute the bounding box of.
+/// \return Bounding box, as the minimum position followed by the maximum one.
+std::array<float, 6> compute_bounding_box(std::vector<Vertex> const& vertices)
+{
+    std::array<float, 6> bounding_box = {
+        std::numeric_limits<float>::max(),    std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::max(),    std::numeric_limits<float>::lowest(),
+        std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()
+    };
+
+    for (Vertex const& vertex : vertices) {
+        bounding_box[0] = std::min(bounding_box[0], vertex.position.x);
+        bounding_box[1] = std::min(bounding_box[1], vertex.position.y);
+        bounding_box[2] = std::min(bounding_box[2], vertex.position.z);
+        bounding_box[3] = std::max(bounding_box[3], vertex.position.x);
+        bounding_box[4] = std::max(bounding_box[4], vertex.position.y);
+        bounding_box[5] = std::max(bounding_box[5], vertex.position.z);
+    }
+
+    return bounding_box;
+}
+
+void write_attributes(std::vector<uint8_t>& buffer, RenderShaderProgram const& program)
+{
+    std::vector<std::pair<std::string, std::vector<float>>> attributes;
+
+    for (char const* attribute_name : attribute_names) {
+        if (program.has_attribute<float>(attribute_name)) {
+            attributes.emplace_back(attribute_name, std::vector<float>{program.get_attribute<float>(attribute_name)});
+        }
+        else if (program.has_attribute<Vector3f>(attribute_name)) {
+            Vector3f const& value = program.get_attribute<Vector3f>(attribute_name);
+            attributes.emplace_back(attribute_name, std::vector<float>{value.x, value.y, value.z});
+        }
+        else if (program.has_attribute<Vector4f>(attribute_name)) {
+            Vector4f const& value = program.get_attribute<Vector4f>(attribute_name);
+            attributes.emplace_back(attribute_name, std::vector<float>{value.x, value.y, value.z, value.w});
+        }
+    }
+
+    write_value(buffer, static_cast<uint32_t>(attributes.size()));
+
+    for (auto const& [name, values] : attributes) {
+        write_string(buffer, name);
+        write_value(buffer, static_cast<uint32_t>(values.size()));
+
+        for (float const value : values) {
+            write_value(buffer, value);
+        }
+    }
+}
+
+/// Writes the textures of a material, saving those which are not made of a single color as images next to the file.
+/// \param buffer Buffer to write the textures' references into.
+/// \param program Program of the material to write the textures of.
+/// \param filepath File the mesh is saved to.
+/// \param texture_paths Paths of the textures already saved, relative to the file, to save each texture only once.
+void write_textures(
+    std::vector<uint8_t>& buffer, RenderShaderProgram const& program, FilePath const& filepath,
+    std::unordered_map<Texture const*, std::string>& texture_paths
+)
+{
+    ZoneScopedN("[XmeshSave]::write_textures");
+
+    std::vector<std::pair<Texture2D const*, std::string const*>> textures;
+
+    for (auto const& [texture, uniform_name] : program.get_textures()) {
+        auto const* texture_2d = dynamic_cast<Texture2D const*>(texture.get());
+
+        if (texture_2d == nullptr || texture_2d->get_width() == 0 || texture_2d->get_height() == 0 ||
+            texture_2d->get_colorspace() == TextureColorspace::INVALID ||
+            texture_2d->get_colorspace() == TextureColorspace::DEPTH) {
+            continue;
+        }
+
+        textures.emplace_back(texture_2d, &uniform_name);
+    }
+
+    write_value(buffer, static_cast<uint32_t>(textures.size()));
+
+    for (auto const& [texture, uniform_name] : textures) {
+        bool const is_srgb = (texture->get_colorspace() == TextureColorspace::SRGB ||
+                              texture->get_colorspace() == TextureColorspace::SRGBA);
+
+        write_string(buffer, *uniform_name);
+        write_value(buffer, static_cast<uint8_t>(is_srgb));
+
+        auto texture_path_it = texture_paths.find(texture);
+
+        // Single-color textures, such as the materials' default ones, are recreated from their color instead of a file
+        if (texture_path_it == texture_paths.cend() && texture->get_width() == 1 && texture->get_height() == 1) {
+            Image const image = texture->recover_image();
+            std::array<float, 4> color = {0.f, 0.f, 0.f, 1.f};
+
+            for (uint8_t channel_index = 0; channel_index < std::min<uint8_t>(image.get_channel_count(), 4);
+                 ++channel_index) {
+                color[channel_index] =
+                    (image.get_data_type() == ImageDataType::FLOAT ?
+                         image.recover_float_value(0, 0, channel_index) :
+                         static_cast<float>(image.recover_byte_value(0, 0, channel_index)) / 255.f);
+            }
+
+            write_value(buffer, static_cast<uint8_t>(0));
+            write_value(buffer, color);
+            continue;
+        }
+
+        if (texture_path_it == texture_paths.cend()) {
+            Image const image = texture->recover_image();
+            std::string const texture_filename =
+                filepath.recover_filename(false).to_utf8() + "_texture" + std::to_string(texture_paths.size()) +
+                (image.get_data_type() == ImageDataType::FLOAT ? ".hdr" : ".png");
+
+            ImageFormat::save(filepath.recover_path_to_file() + texture_filename, image, true);
+            texture_path_it = texture_paths.emplace(texture, texture_filename).first;
+        }
+
+        write_value(buffer, static_cast<uint8_t>(1));
+        write_string(buffer, texture_path_it->second);
+    }
+}
+
+MaterialType recover_material_type(RenderShaderProgram const& program)
+{
+    if (!program.has_texture(MaterialTexture::Metallic) && program.has_texture(MaterialTexture::Specular)) {
+        return MaterialType::BLINN_PHONG;
+    }
+
+    return MaterialType::COOK_TORRANCE;
+}
+} // namespace
+
+void save(FilePath const& filepath, Mesh const& mesh, MeshRendererData const* mesh_renderer)
+{
+    ZoneScopedN("XmeshFormat::save");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[XmeshSave] Saving XMESH file ('" + filepath + "')...");
+
+    std::vector<Submesh> const& submeshes = mesh.get_submeshes();
+
+    Header header{};
+    header.magic = magic_number;
+    header.version = version;
+    header.vertex_size = sizeof(Vertex);
+    header.submesh_count = static_cast<uint32_t>(submeshes.size());
+    header.material_count = static_cast<uint32_t>(mesh_renderer != nullptr ? mesh_renderer->get_materials().size() : 0);
+
+    std::vector<uint8_t> buffer;
+    write_value(buffer, header);
+
+    // The submesh entries are written once the data's offsets are known
+    size_t const entries_offset = buffer.size();
+    buffer.resize(buffer.size() + submeshes.size() * sizeof(SubmeshEntry));
+
+    if (mesh_renderer != nullptr) {
+        std::unordered_map<Texture const*, std::string> texture_paths;
+
+        // The textures' rows are recovered tightly packed, whatever their size
+        int pack_alignment = 4;
+        Renderer::get_parameter(StateParameter::PACK_ALIGNMENT, &pack_alignment);
+        Renderer::set_pixel_storage(PixelStorage::PACK_ALIGNMENT, 1);
+
+        for (Material const& material : mesh_renderer->get_materials()) {
+            RenderShaderProgram const& program = material.get_program();
+
+            write_value(buffer, static_cast<uint32_t>(recover_material_type(program)));
+            write_attributes(buffer, program);
+            write_textures(buffer, program, filepath, texture_paths);
+        }
+
+        Renderer::set_pixel_storage(PixelStorage::PACK_ALIGNMENT, static_cast<uint32_t>(pack_alignment));
+    }
+
+    std::vector<SubmeshEntry> entries(submeshes.size());
+    header.bounding_box = compute_bounding_box({});
+
+    for (size_t submesh_index = 0; submesh_index < submeshes.size(); ++submesh_index) {
+        Submesh const& submesh = submeshes[submesh_index];
+        SubmeshEntry& entry = entries[submesh_index];
+
+        entry.vertex_offset = write_data(buffer, submesh.get_vertices());
+        entry.line_index_offset = write_data(buffer, submesh.get_line_indices());
+        entry.triangle_index_offset = write_data(buffer, submesh.get_triangle_indices());
+        entry.vertex_count = static_cast<uint32_t>(submesh.get_vertex_count());
+        entry.line_index_count = static_cast<uint32_t>(submesh.get_line_index_count());
+        entry.triangle_index_count = static_cast<uint32_t>(submesh.get_triangle_index_count());
+        entry.bounding_box = compute_bounding_box(submesh.get_vertices());
+
+        for (size_t component_index = 0; component_index < 3; ++component_index) {
+            header.bounding_box[component_index] =
+                std::min(header.bounding_box[component_index], entry.bounding_box[component_index]);
+            header.bounding_box[component_index + 3] =
+                std::max(header.bounding_box[component_index + 3], entry.bounding_box[component_index + 3]);
+        }
+
+        size_t material_index = std::numeric_limits<size_t>::max();
+
+        if (mesh_renderer != nullptr && submesh_index < mesh_renderer->get_submesh_renderers().size()) {
+            material_index = mesh_renderer->get_submesh_renderers()[submesh_index].get_material_index();
+        }
+
+        entry.material_index =
+            (material_index < header.material_count ? static_cast<uint32_t>(material_index) :
+                                                      std::numeric_limits<uint32_t>::max());
+    }
+
+    // The header is written again, its bounding box being merged from the submeshes'
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+    std::memcpy(buffer.data() + entries_offset, entries.data(), entries.size() * sizeof(SubmeshEntry));
+
+    std::ofstream file(filepath, std::ios_base::binary);
+    file.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+    if (!file) {
+        throw std::invalid_argument("Error: Unable to write to the XMESH file '" + filepath + '\'');
+    }
+
+    Log::debug("[XmeshSave] Saved XMESH file");
+}
+}
@@ -55,6 +55,18 @@ void Camera::set_projection_type(ProjectionType projection_type)
     compute_inverse_projection();
 }
 
+void Camera::set_jitter(Vector2f const& jitter)
+{
+    if (jitter == this->jitter) {
+        return; // No need to recompute the projection matrix
+    }
+
+    this->jitter = jitter;
+
+    compute_projection();
+    compute_inverse_projection();
+}
+
 Matrix4 const& Camera::compute_view(Transform const& camera_transform)
 {
     ZoneScopedN("Camera::compute_view");
@@ -137,9 +149,17 @@ Matrix4 const& Camera::compute_projection()
     ZoneScopedN("Camera::compute_projection");
 
     if (projection_type == ProjectionType::ORTHOGRAPHIC)
-        return compute_orthographic();
+        compute_orthographic();
+    else
+        compute_perspective();
+
+    // The jitter translates the projected points in normalized device coordinates, hence is scaled by their W
+    for (uint32_t column = 0; column < 4; ++column) {
+        projection[column][0] += jitter.x * projection[column][3];
+        projection[column][1] += jitter.y * projection[column][3];
+    }
 
-    return compute_perspective();
+    return projection;
 }
 
 Matrix4 const& Camera::compute_inverse_projection()
@@ -28,6 +28,7 @@ public:
     Matrix4 const& get_projection() const { return projection; }
     Matrix4 const& get_inverse_projection() const { return inverse_projection; }
     Vector3f const& get_offset() const { return offset_from_parent; }
+    Vector2f const& get_jitter() const { return jitter; }
 
     void set_fov(Radiansf fov);
     void set_orthographic_bound(float bound);
@@ -36,6 +37,12 @@ public:
     void set_target(Vector3f const& target) { this->target = target; }
     void set_offset(Vector3f const& value) { this->offset_from_parent = value; }
 
+    /// Sets the subpixel offset applied to the projection, so that successive frames sample different points of each
+    /// pixel; these samples can then be accumulated by a temporal reconstruction.
+    /// \param jitter Offset in normalized device coordinates; a pixel spans 2 / size.
+    /// \see DynamicResolution
+    void set_jitter(Vector2f const& jitter);
+
     /// Computes the standard "free fly" view matrix.
     /// \param camera_transform Transform component of the camera.
     /// \return Reference to the computed view matrix.
@@ -70,7 +77,8 @@ public:
     Matrix4 const& compute_orthographic();
 
     /// Computes the projection matrix.
-    /// Depending on the projection type, either perspective or orthographic will be computed.
+    /// Depending on the projection type, either perspective or orthographic will be computed. The jitter, if any, is
+    /// then applied.
     /// \return Reference to the computed projection matrix.
     Matrix4 const& compute_projection();
 
@@ -126,5 +134,6 @@ private:
     Matrix4 projection = Matrix4::Identity;
     Matrix4 inverse_projection = Matrix4::Identity;
     Vector3f offset_from_parent = Vector3f(0.f);
+    Vector2f jitter = Vector2f(0.f);
 };
 }
\ No newline at end of file
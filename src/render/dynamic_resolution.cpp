@@ -0,0 +1,365 @@
+#include "dynamic_resolution.hpp"
+
+#include <render/render_pass.hpp>
+#include <render/renderer.hpp>
+#include <utils/hash.hpp>
+
+#include <tracy/Tracy.hpp>
+#include <GL/glew.h> // Needed by TracyOpenGL.hpp
+#include <tracy/TracyOpenGL.hpp>
+
+namespace xen {
+namespace {
+constexpr std::string_view temporal_upscale_source = {
+#include "temporal_upscale.frag.embed"
+};
+
+/// Fraction of the gap with the ideal render scale covered each frame, smoothing the scale's changes.
+constexpr float scale_adaptation_rate = 0.1f;
+
+/// Computes an element of the Halton sequence, giving well-distributed jitter offsets.
+/// \param index Index of the element; must be strictly positive.
+/// \param base Base of the sequence.
+/// \return Element of the sequence, between 0 & 1.
+float compute_halton(uint32_t index, uint32_t base)
+{
+    float result = 0.f;
+    float fraction = 1.f;
+
+    while (index > 0) {
+        fraction /= static_cast<float>(base);
+        result += fraction * static_cast<float>(index % base);
+        index /= base;
+    }
+
+    return result;
+}
+
+/// Sets a single draw buffer to the currently bound framebuffer, so that a blit only writes into one color buffer.
+/// \param buffer_index Index of the color buffer to draw into.
+void set_single_draw_buffer(uint32_t buffer_index)
+{
+    std::vector<DrawBuffer> draw_buffers(buffer_index + 1, DrawBuffer::NONE);
+    draw_buffers[buffer_index] =
+        static_cast<DrawBuffer>(static_cast<uint32_t>(DrawBuffer::COLOR_ATTACHMENT0) + buffer_index);
+    Renderer::set_draw_buffers(static_cast<uint32_t>(draw_buffers.size()), draw_buffers.data());
+}
+
+/// Sets back the draw buffers of a framebuffer, as mapped by the framebuffer itself.
+/// \param framebuffer Framebuffer to restore the draw buffers of, which must be currently bound.
+void restore_draw_buffers(Framebuffer const& framebuffer)
+{
+    std::vector<DrawBuffer> draw_buffers(framebuffer.get_color_buffer_count(), DrawBuffer::NONE);
+
+    for (auto const& [_, buffer_index] : framebuffer.get_color_buffers()) {
+        if (buffer_index >= draw_buffers.size()) {
+            draw_buffers.resize(buffer_index + 1, DrawBuffer::NONE);
+        }
+        draw_buffers[buffer_index] =
+            static_cast<DrawBuffer>(static_cast<uint32_t>(DrawBuffer::COLOR_ATTACHMENT0) + buffer_index);
+    }
+
+    Renderer::set_draw_buffers(static_cast<uint32_t>(draw_buffers.size()), draw_buffers.data());
+    Renderer::set_read_buffer(ReadBuffer::COLOR_ATTACHMENT0);
+}
+
+/// Checks if the depth is stored in [0; 1] as is, which is the case when the render system could set it as clip depth.
+/// \return True if the clip depth is between 0 & 1, false if it is between -1 & 1.
+bool is_zero_to_one_depth()
+{
+#if !defined(USE_OPENGL_ES)
+    return (Renderer::check_version(4, 5) || Renderer::is_extension_supported("GL_ARB_clip_control"));
+#else
+    return false;
+#endif
+}
+} // namespace
+
+DynamicResolution::DynamicResolution()
+{
+    ZoneScopedN("DynamicResolution::DynamicResolution");
+
+    resolve_program.set_shaders(
+        Framebuffer::recover_vertex_shader(), FragmentShader::load_from_source(temporal_upscale_source)
+    );
+
+    resolve_program.use();
+    resolve_program.send_uniform("uniColorBuffer", 0);
+    resolve_program.send_uniform("uniDepthBuffer", 1);
+    resolve_program.send_uniform("uniMotionBuffer", 2);
+    resolve_program.send_uniform("uniHistoryBuffer", 3);
+    resolve_program.send_uniform("uniZeroToOneDepth", is_zero_to_one_depth());
+}
+
+void DynamicResolution::enable(bool enabled)
+{
+    if (enabled == this->enabled) {
+        return;
+    }
+
+    this->enabled = enabled;
+    is_history_valid = false;
+}
+
+void DynamicResolution::set_target_frame_time(float time)
+{
+    Log::rt_assert(time > 0.f, "Error: The dynamic resolution's target frame time must be strictly positive.");
+    target_frame_time = time;
+}
+
+void DynamicResolution::set_scale_range(float min_scale, float max_scale)
+{
+    Log::rt_assert(
+        min_scale > 0.f && min_scale <= max_scale && max_scale <= 1.f,
+        "Error: The dynamic resolution's scale range must be strictly positive, ordered & at most 1."
+    );
+
+    this->min_scale = min_scale;
+    this->max_scale = max_scale;
+    render_scale = std::clamp(render_scale, min_scale, max_scale);
+}
+
+void DynamicResolution::begin_frame(RenderPass& geometry_pass, Vector2ui const& scene_size)
+{
+    ZoneScopedN("DynamicResolution::begin_frame");
+
+    this->scene_size = scene_size;
+
+    if (!enabled) {
+        if (motion_buffer) {
+            geometry_pass.remove_write_texture(motion_buffer);
+            motion_buffer.reset();
+            history_buffers = {};
+            history_framebuffers = {};
+            upscale_framebuffer = Framebuffer();
+            upscale_layout_signature = 0;
+        }
+
+        render_size = scene_size;
+        jitter = Vector2f(0.f);
+        return;
+    }
+
+    if (motion_buffer == nullptr || motion_buffer->get_size() != scene_size) {
+        if (motion_buffer) {
+            geometry_pass.remove_write_texture(motion_buffer);
+        }
+
+        motion_buffer = Texture2D::create(scene_size, TextureColorspace::RGBA, TextureDataType::FLOAT16);
+        motion_buffer->set_filter(TextureFilter::NEAREST);
+        geometry_pass.add_write_color_texture(motion_buffer, motion_buffer_index);
+    }
+
+    update_history_buffers();
+
+    // The scale is brought toward the one which would have given the target time, the cost being roughly proportional
+    //   to the number of pixels; no time is available on the first frames, or if timer queries are unsupported
+    float const frame_time = frame_timer.recover_time();
+
+    if (frame_time > 0.f) {
+        float const ideal_scale = render_scale * std::sqrt(target_frame_time / frame_time);
+        render_scale = std::lerp(render_scale, ideal_scale, scale_adaptation_rate);
+    }
+
+    render_scale = std::clamp(render_scale, min_scale, max_scale);
+    render_size = Vector2ui(
+        std::max(1u, static_cast<uint32_t>(std::round(static_cast<float>(scene_size.x) * render_scale))),
+        std::max(1u, static_cast<uint32_t>(std::round(static_cast<float>(scene_size.y) * render_scale)))
+    );
+
+    // The lower the scale, the more rendered frames are needed to cover each displayed pixel
+    auto const phase_count = static_cast<uint32_t>(std::ceil(8.f / (render_scale * render_scale)));
+    jitter_index = (jitter_index + 1) % phase_count;
+
+    // The offset is made in rendered pixels, & converted in normalized device coordinates
+    jitter = Vector2f(
+        (compute_halton(jitter_index + 1, 2) - 0.5f) * 2.f / static_cast<float>(render_size.x),
+        (compute_halton(jitter_index + 1, 3) - 0.5f) * 2.f / static_cast<float>(render_size.y)
+    );
+
+    frame_timer.start();
+}
+
+void DynamicResolution::begin_geometry() const
+{
+    // The materials which do not write their motion leave it cleared, telling it to be recovered from the depth
+    Renderer::clear_color_buffer(motion_buffer_index, Vector4f(0.f));
+    Renderer::resize_viewport(Vector2ui(0), render_size);
+}
+
+void DynamicResolution::resolve(Framebuffer const& geometry_framebuffer)
+{
+    ZoneScopedN("DynamicResolution::resolve");
+    TracyGpuZone("DynamicResolution::resolve");
+
+    auto const& color_buffers = geometry_framebuffer.get_color_buffers();
+    auto const color_buffer_it = std::find_if(color_buffers.cbegin(), color_buffers.cend(), [](auto const& buffer) {
+        return (buffer.second == 0);
+    });
+
+    Log::rt_assert(
+        color_buffer_it != color_buffers.cend() && geometry_framebuffer.has_depth_buffer(),
+        "Error: Dynamic resolution requires the geometry pass to have a color buffer at index 0 & a depth buffer."
+    );
+
+    Renderer::resize_viewport(Vector2ui(0), scene_size);
+
+    resolve_program.use();
+    resolve_program.send_uniform(
+        "uniRenderScale", Vector2f(
+                              static_cast<float>(render_size.x) / static_cast<float>(scene_size.x),
+                              static_cast<float>(render_size.y) / static_cast<float>(scene_size.y)
+                          )
+    );
+    resolve_program.send_uniform("uniHistoryWeight", (is_history_valid ? history_weight : 0.f));
+
+    Renderer::activate_texture(0);
+    color_buffer_it->first->bind();
+    Renderer::activate_texture(1);
+    geometry_framebuffer.get_depth_buffer().bind();
+    Renderer::activate_texture(2);
+    motion_buffer->bind();
+    Renderer::activate_texture(3);
+    history_buffers[1 - history_index]->bind();
+
+    // The result replaces the colors instead of being blended with them
+    bool const is_blending = Renderer::is_enabled(Capability::BLEND);
+    Renderer::disable(Capability::BLEND);
+
+    Renderer::bind_framebuffer(history_framebuffers[history_index].get_index());
+    history_framebuffers[history_index].display();
+
+    if (is_blending) {
+        Renderer::enable(Capability::BLEND);
+    }
+
+    update_upscale_buffers(geometry_framebuffer);
+    upscale_buffers(geometry_framebuffer);
+
+    Renderer::bind_framebuffer(geometry_framebuffer.get_index());
+
+    history_index = 1 - history_index;
+    is_history_valid = true;
+}
+
+void DynamicResolution::end_frame()
+{
+    if (enabled) {
+        frame_timer.stop();
+    }
+}
+
+void DynamicResolution::update_history_buffers()
+{
+    if (history_buffers[0] && history_buffers[0]->get_size() == scene_size) {
+        return;
+    }
+
+    for (size_t i = 0; i < history_buffers.size(); ++i) {
+        history_buffers[i] = Texture2D::create(scene_size, TextureColorspace::RGBA, TextureDataType::FLOAT16);
+        history_buffers[i]->set_filter(TextureFilter::LINEAR);
+        history_buffers[i]->set_wrapping(TextureWrapping::CLAMP);
+
+        history_framebuffers[i] = Framebuffer();
+        history_framebuffers[i].add_color_buffer(history_buffers[i], 0);
+    }
+
+    is_history_valid = false;
+}
+
+void DynamicResolution::update_upscale_buffers(Framebuffer const& geometry_framebuffer)
+{
+    Texture2D const& depth_buffer = geometry_framebuffer.get_depth_buffer();
+    uint64_t layout_signature = Hash::compute_fnv1a(depth_buffer.get_data_type());
+    layout_signature = Hash::compute_fnv1a(scene_size.x, layout_signature);
+    layout_signature = Hash::compute_fnv1a(scene_size.y, layout_signature);
+
+    for (auto const& [color_buffer, buffer_index] : geometry_framebuffer.get_color_buffers()) {
+        layout_signature = Hash::compute_fnv1a(buffer_index, layout_signature);
+        layout_signature = Hash::compute_fnv1a(color_buffer->get_colorspace(), layout_signature);
+        layout_signature = Hash::compute_fnv1a(color_buffer->get_data_type(), layout_signature);
+    }
+
+    if (layout_signature == upscale_layout_signature) {
+        return;
+    }
+
+    upscale_layout_signature = layout_signature;
+    upscale_framebuffer = Framebuffer();
+    upscale_framebuffer.set_depth_buffer(
+        Texture2D::create(scene_size, TextureColorspace::DEPTH, depth_buffer.get_data_type())
+    );
+
+    for (auto const& [color_buffer, buffer_index] : geometry_framebuffer.get_color_buffers()) {
+        if (buffer_index == 0 || buffer_index == motion_buffer_index) {
+            continue;
+        }
+
+        upscale_framebuffer.add_color_buffer(
+            Texture2D::create(scene_size, color_buffer->get_colorspace(), color_buffer->get_data_type()), buffer_index
+        );
+    }
+}
+
+void DynamicResolution::upscale_buffers(Framebuffer const& geometry_framebuffer) const
+{
+    ZoneScopedN("DynamicResolution::upscale_buffers");
+    TracyGpuZone("DynamicResolution::upscale_buffers");
+
+    auto const render_width = static_cast<int>(render_size.x);
+    auto const render_height = static_cast<int>(render_size.y);
+    auto const scene_width = static_cast<int>(scene_size.x);
+    auto const scene_height = static_cast<int>(scene_size.y);
+
+    // A framebuffer cannot be blitted into itself: each buffer is upscaled into its copy, then copied back. Depth &
+    //   attributes cannot be interpolated, hence the nearest filtering
+    auto const upscale_buffer = [&](MaskType mask, std::optional<uint32_t> buffer_index) {
+        Renderer::bind_framebuffer(geometry_framebuffer.get_index(), FramebufferType::READ_FRAMEBUFFER);
+        Renderer::bind_framebuffer(upscale_framebuffer.get_index(), FramebufferType::DRAW_FRAMEBUFFER);
+
+        if (buffer_index) {
+            auto const read_buffer = static_cast<uint32_t>(ReadBuffer::COLOR_ATTACHMENT0) + *buffer_index;
+            Renderer::set_read_buffer(static_cast<ReadBuffer>(read_buffer));
+            set_single_draw_buffer(*buffer_index);
+        }
+
+        Renderer::blit_framebuffer(
+            0, 0, render_width, render_height, 0, 0, scene_width, scene_height, mask, BlitFilter::NEAREST
+        );
+
+        Renderer::bind_framebuffer(upscale_framebuffer.get_index(), FramebufferType::READ_FRAMEBUFFER);
+        Renderer::bind_framebuffer(geometry_framebuffer.get_index(), FramebufferType::DRAW_FRAMEBUFFER);
+
+        if (buffer_index) {
+            auto const read_buffer = static_cast<uint32_t>(ReadBuffer::COLOR_ATTACHMENT0) + *buffer_index;
+            Renderer::set_read_buffer(static_cast<ReadBuffer>(read_buffer));
+            set_single_draw_buffer(*buffer_index);
+        }
+
+        Renderer::blit_framebuffer(
+            0, 0, scene_width, scene_height, 0, 0, scene_width, scene_height, mask, BlitFilter::NEAREST
+        );
+    };
+
+    upscale_buffer(MaskType::DEPTH, std::nullopt);
+
+    for (auto const& [_, buffer_index] : geometry_framebuffer.get_color_buffers()) {
+        if (buffer_index != 0 && buffer_index != motion_buffer_index) {
+            upscale_buffer(MaskType::COLOR, buffer_index);
+        }
+    }
+
+    // The reconstructed frame is copied as is into the first color buffer
+    Renderer::bind_framebuffer(history_framebuffers[history_index].get_index(), FramebufferType::READ_FRAMEBUFFER);
+    Renderer::bind_framebuffer(geometry_framebuffer.get_index(), FramebufferType::DRAW_FRAMEBUFFER);
+    set_single_draw_buffer(0);
+    Renderer::blit_framebuffer(
+        0, 0, scene_width, scene_height, 0, 0, scene_width, scene_height, MaskType::COLOR, BlitFilter::NEAREST
+    );
+
+    // The geometry pass' draw & read buffers are restored to what they have been mapped with
+    Renderer::bind_framebuffer(geometry_framebuffer.get_index());
+    restore_draw_buffers(geometry_framebuffer);
+    Renderer::unbind_framebuffer();
+}
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <render/platform/framebuffer.hpp>
+#include <render/render_timer.hpp>
+#include <render/shader/shader_program.hpp>
+
+namespace xen {
+class RenderPass;
+
+/// Dynamic resolution, rendering the geometry pass below the scene's resolution & reconstructing it temporally.
+/// - Before each frame, the render scale is adapted from the GPU time of the previous frames to reach a target frame
+///   time, & the camera's projection is jittered by a subpixel offset changing every frame;
+/// - The geometry is rendered in the lower-left part of the geometry pass' buffers. The materials write the motion of
+///   their fragments into an additional buffer of the geometry pass, at index motion_buffer_index; the motion of the
+///   other fragments is reconstructed from the depth, as if they were static;
+/// - A temporal reconstruction pass then accumulates the current frame with the previous result, reprojected along the
+///   motions & clamped to the current colors' neighborhood, into a history buffer at the scene's resolution. This
+///   result replaces the geometry pass' first color buffer, its other buffers being upscaled, so that the following
+///   passes are unaffected.
+/// The geometry pass needs to have a color buffer at index 0 & a depth buffer.
+class DynamicResolution {
+public:
+    static constexpr uint32_t motion_buffer_index = 3;
+
+    DynamicResolution();
+    DynamicResolution(DynamicResolution const&) = delete;
+    DynamicResolution(DynamicResolution&&) noexcept = default;
+
+    DynamicResolution& operator=(DynamicResolution const&) = delete;
+    DynamicResolution& operator=(DynamicResolution&&) noexcept = default;
+
+    [[nodiscard]] bool is_enabled() const { return enabled; }
+
+    /// Gets the scale applied to the scene's resolution to render the current frame.
+    /// \return Render scale, between the minimum & maximum ones.
+    [[nodiscard]] float get_render_scale() const { return render_scale; }
+
+    [[nodiscard]] Vector2ui const& get_render_size() const { return render_size; }
+
+    /// Gets the offset applied to the camera's projection for the current frame.
+    /// \return Jitter in normalized device coordinates; null while disabled.
+    [[nodiscard]] Vector2f const& get_jitter() const { return jitter; }
+
+    [[nodiscard]] float get_target_frame_time() const { return target_frame_time; }
+
+    [[nodiscard]] float get_min_scale() const { return min_scale; }
+
+    [[nodiscard]] float get_max_scale() const { return max_scale; }
+
+    [[nodiscard]] float get_history_weight() const { return history_weight; }
+
+    [[nodiscard]] RenderShaderProgram const& get_program() const { return resolve_program; }
+
+    /// Enables or disables dynamic resolution. While disabled, the geometry pass is rendered at the scene's resolution
+    ///   without jitter.
+    /// \param enabled True to enable dynamic resolution, false otherwise.
+    void enable(bool enabled = true);
+
+    void disable() { enable(false); }
+
+    /// Sets the GPU frame time to be reached by adapting the render scale.
+    /// \param time Target frame time, in milliseconds.
+    void set_target_frame_time(float time);
+
+    /// Sets the range the render scale is kept in; if both are equal, the scale is fixed.
+    /// \param min_scale Minimum render scale; must be strictly positive.
+    /// \param max_scale Maximum render scale; must be greater than or equal to the minimum one, & at most 1.
+    void set_scale_range(float min_scale, float max_scale);
+
+    /// Sets how much the previous frames contribute to the reconstructed one.
+    /// \param weight Weight of the history, between 0 (current frame only) & 1 (history only); higher values give a
+    ///   more stable image, at the cost of more ghosting.
+    void set_history_weight(float weight) { history_weight = std::clamp(weight, 0.f, 1.f); }
+
+    /// Discards the accumulated history, for instance after a camera cut.
+    void reset_history() { is_history_valid = false; }
+
+    /// Adapts the render scale from the latest frame times, then computes the render size & jitter of the upcoming
+    ///   frame & starts measuring its time. The motion buffer is attached to the geometry pass if needed, or detached
+    ///   once disabled.
+    /// \param geometry_pass Geometry pass to be rendered at a lower resolution.
+    /// \param scene_size Resolution of the scene.
+    void begin_frame(RenderPass& geometry_pass, Vector2ui const& scene_size);
+
+    /// Clears the motion buffer & restricts the viewport to the render size.
+    /// \warning The geometry pass' framebuffer must be bound before calling this function.
+    void begin_geometry() const;
+
+    /// Reconstructs the frame at the scene's resolution into the geometry pass' buffers, & restores the viewport.
+    /// \param geometry_framebuffer Framebuffer of the geometry pass, left bound afterward.
+    void resolve(Framebuffer const& geometry_framebuffer);
+
+    /// Stops measuring the frame's time.
+    void end_frame();
+
+private:
+    bool enabled = false;
+    bool is_history_valid = false;
+
+    float target_frame_time = 1000.f / 60.f;
+    float min_scale = 0.5f;
+    float max_scale = 1.f;
+    float render_scale = 1.f;
+    float history_weight = 0.9f;
+
+    Vector2ui scene_size{};
+    Vector2ui render_size{};
+    Vector2f jitter{};
+    uint32_t jitter_index = 0;
+
+    RenderTimer frame_timer{};
+    RenderShaderProgram resolve_program{};
+    Texture2DPtr motion_buffer{};
+
+    std::array<Texture2DPtr, 2> history_buffers{};
+    std::array<Framebuffer, 2> history_framebuffers{};
+    size_t history_index = 0;
+
+    /// Copies of the geometry pass' buffers at the scene's resolution, which the upscaled buffers are blitted into
+    ///   before being blitted back.
+    Framebuffer upscale_framebuffer{};
+    uint64_t upscale_layout_signature = 0;
+
+private:
+    /// Creates the history buffers if they do not have the scene's size.
+    void update_history_buffers();
+
+    /// Creates the copies of the geometry pass' buffers if their formats or sizes have changed.
+    /// \param geometry_framebuffer Framebuffer of the geometry pass.
+    void update_upscale_buffers(Framebuffer const& geometry_framebuffer);
+
+    /// Copies the reconstructed frame into the geometry pass' first color buffer, & upscales its other buffers.
+    /// \param geometry_framebuffer Framebuffer of the geometry pass.
+    void upscale_buffers(Framebuffer const& geometry_framebuffer) const;
+};
+}
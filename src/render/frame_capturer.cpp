@@ -0,0 +1,311 @@
+#include "frame_capturer.hpp"
+
+#include <data/image.hpp>
+#include <data/image_format.hpp>
+#include <utils/thread_pool.hpp>
+#include <utils/threading.hpp>
+
+#include <tracy/Tracy.hpp>
+#include <GL/glew.h> // Needed by TracyOpenGL.hpp
+#include <tracy/TracyOpenGL.hpp>
+
+namespace xen {
+namespace {
+/// Recovers the number of channels of the pixels read with the given format.
+/// \param format Format of the pixels to be read.
+/// \return Number of channels.
+uint8_t recover_channel_count(TextureFormat format)
+{
+    switch (format) {
+    case TextureFormat::RED:
+    case TextureFormat::DEPTH:
+        return 1;
+
+    case TextureFormat::RG:
+        return 2;
+
+    case TextureFormat::RGBA:
+    case TextureFormat::BGRA:
+        return 4;
+
+    default:
+        return 3;
+    }
+}
+
+/// Computes the size in bytes of a frame read with the given format, its rows being tightly packed.
+/// \param frame_size Size of the frame.
+/// \param format Format of the pixels to be read.
+/// \param data_type Type of the pixels' components.
+/// \return Size of the frame's data.
+size_t compute_frame_data_size(Vector2ui const& frame_size, TextureFormat format, PixelDataType data_type)
+{
+    return static_cast<size_t>(frame_size.x) * frame_size.y * recover_channel_count(format) *
+           (data_type == PixelDataType::FLOAT ? sizeof(float) : sizeof(uint8_t));
+}
+
+/// Creates an image able to hold a frame read with the given format.
+/// \param frame_size Size of the frame.
+/// \param format Format of the pixels to be read.
+/// \param data_type Type of the pixels' components.
+/// \return Image of the frame's size.
+Image create_frame_image(Vector2ui const& frame_size, TextureFormat format, PixelDataType data_type)
+{
+    constexpr std::array<ImageColorspace, 4> colorspaces = {
+        ImageColorspace::GRAY, ImageColorspace::GRAY_ALPHA, ImageColorspace::RGB, ImageColorspace::RGBA
+    };
+
+    return Image(
+        frame_size, colorspaces[recover_channel_count(format) - 1],
+        (data_type == PixelDataType::FLOAT ? ImageDataType::FLOAT : ImageDataType::BYTE)
+    );
+}
+
+/// Copies pixels read from the GPU into an image, reversing the order of their rows: frames are read from the bottom
+///   row to the top one.
+/// \param pixels Pixels to be copied, tightly packed.
+/// \param image Image to copy the pixels into.
+void copy_flipped_rows(uint8_t const* pixels, Image& image)
+{
+    size_t const row_size = image.get_width() * image.get_channel_count() *
+                            (image.get_data_type() == ImageDataType::FLOAT ? sizeof(float) : sizeof(uint8_t));
+    auto* const image_data = static_cast<uint8_t*>(image.data());
+
+    for (size_t row_index = 0; row_index < image.get_height(); ++row_index) {
+        std::memcpy(
+            image_data + row_index * row_size, pixels + (image.get_height() - row_index - 1) * row_size, row_size
+        );
+    }
+}
+
+/// Saves an image to a file from a worker thread, or directly if threads are unavailable.
+/// \param filepath File to save the image to.
+/// \param image Image to be saved.
+void save_image(FilePath filepath, Image&& image)
+{
+    auto save_task = [filepath = std::move(filepath), image = std::move(image)]() {
+        ZoneScopedN("FrameCapturer::save_image");
+
+        try {
+            ImageFormat::save(filepath, image);
+        }
+        catch (std::exception const& exception) {
+            Log::error("[FrameCapturer] Failed to save the captured frame: " + std::string(exception.what()));
+        }
+    };
+
+#if defined(XEN_THREADS_AVAILABLE) && !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
+    get_default_thread_pool().add_task(std::move(save_task));
+#else
+    save_task();
+#endif
+}
+} // namespace
+
+FrameCapturer::~FrameCapturer()
+{
+#if !defined(USE_OPENGL_ES)
+    for (CaptureSlot& slot : slots) {
+        if (!slot.buffer.is_valid()) {
+            continue;
+        }
+
+        if (slot.fence != nullptr) {
+            Renderer::delete_fence(slot.fence);
+        }
+
+        Renderer::delete_buffer(slot.buffer);
+    }
+#endif
+}
+
+size_t FrameCapturer::get_pending_capture_count() const
+{
+#if !defined(USE_OPENGL_ES)
+    return requests.size() + pending_slot_count;
+#else
+    return requests.size();
+#endif
+}
+
+void FrameCapturer::capture(FrameCaptureCallback callback, TextureFormat format, PixelDataType data_type)
+{
+    requests.emplace_back(CaptureRequest{std::move(callback), format, data_type});
+}
+
+void FrameCapturer::save(FilePath filepath, TextureFormat format, PixelDataType data_type)
+{
+    capture(
+        [filepath = std::move(filepath)](Image&& image) { save_image(filepath, std::move(image)); }, format, data_type
+    );
+}
+
+void FrameCapturer::enable_continuous_capture(
+    FrameCaptureCallback callback, TextureFormat format, PixelDataType data_type
+)
+{
+    continuous_request = CaptureRequest{std::move(callback), format, data_type};
+    skipped_frame_count = 0;
+}
+
+void FrameCapturer::enable_continuous_saving(FilePath directory, std::string extension)
+{
+    // Each capture's callback is a copy of this one, the frame index thus having to be shared between them
+    enable_continuous_capture([directory = std::move(directory), extension = std::move(extension),
+                               frame_index = std::make_shared<size_t>(0)](Image&& image) {
+        std::string frame_name = std::to_string((*frame_index)++);
+        frame_name.insert(0, 6 - std::min<size_t>(frame_name.size(), 6), '0');
+
+        save_image(directory + ("frame_" + frame_name + '.' + extension), std::move(image));
+    });
+}
+
+void FrameCapturer::disable_continuous_capture()
+{
+    continuous_request.reset();
+}
+
+void FrameCapturer::update(Vector2ui const& frame_size)
+{
+    ZoneScopedN("FrameCapturer::update");
+
+#if !defined(USE_OPENGL_ES)
+    collect_captures(false);
+#endif
+
+    if (continuous_request.has_value() && !capture_frame(frame_size, *continuous_request)) {
+        ++skipped_frame_count;
+    }
+
+    // Requests which cannot be started yet are kept for the following frames, in the order they have been made
+    size_t started_request_count = 0;
+
+    while (started_request_count < requests.size() && capture_frame(frame_size, requests[started_request_count])) {
+        ++started_request_count;
+    }
+
+    requests.erase(requests.begin(), requests.begin() + static_cast<std::ptrdiff_t>(started_request_count));
+}
+
+void FrameCapturer::flush()
+{
+    ZoneScopedN("FrameCapturer::flush");
+
+#if !defined(USE_OPENGL_ES)
+    collect_captures(true);
+#endif
+}
+
+bool FrameCapturer::capture_frame(Vector2ui const& frame_size, CaptureRequest const& request)
+{
+#if !defined(USE_OPENGL_ES)
+    if (pending_slot_count == buffer_ring_size) {
+        return false;
+    }
+#endif
+
+    size_t const frame_data_size = compute_frame_data_size(frame_size, request.format, request.data_type);
+
+    // The rows are read tightly packed, whatever their size
+    int pack_alignment = 4;
+    Renderer::get_parameter(StateParameter::PACK_ALIGNMENT, &pack_alignment);
+    Renderer::set_pixel_storage(PixelStorage::PACK_ALIGNMENT, 1);
+
+#if !defined(USE_OPENGL_ES)
+    TracyGpuZone("FrameCapturer::capture_frame");
+
+    CaptureSlot& slot = slots[next_slot_index];
+
+    if (!slot.buffer.is_valid()) {
+        Renderer::generate_buffer(slot.buffer);
+    }
+
+    Renderer::bind_buffer(BufferType::PIXEL_PACK_BUFFER, slot.buffer);
+
+    if (slot.buffer_size != frame_data_size) {
+        Renderer::send_buffer_data(
+            BufferType::PIXEL_PACK_BUFFER, static_cast<std::ptrdiff_t>(frame_data_size), nullptr,
+            BufferDataUsage::STREAM_READ
+        );
+        slot.buffer_size = frame_data_size;
+    }
+
+    // With a pixel pack buffer bound, the frame is copied into it by the GPU instead of being returned right away
+    Renderer::recover_frame(frame_size, request.format, request.data_type, nullptr);
+    Renderer::unbind_buffer(BufferType::PIXEL_PACK_BUFFER);
+
+    slot.fence = Renderer::insert_fence();
+    slot.frame_size = frame_size;
+    slot.request = request;
+
+    next_slot_index = (next_slot_index + 1) % buffer_ring_size;
+    ++pending_slot_count;
+#else
+    std::vector<uint8_t> pixels(frame_data_size);
+    Renderer::recover_frame(frame_size, request.format, request.data_type, pixels.data());
+
+    Image image = create_frame_image(frame_size, request.format, request.data_type);
+    copy_flipped_rows(pixels.data(), image);
+    request.callback(std::move(image));
+#endif
+
+    Renderer::set_pixel_storage(PixelStorage::PACK_ALIGNMENT, static_cast<uint32_t>(pack_alignment));
+
+    return true;
+}
+
+#if !defined(USE_OPENGL_ES)
+void FrameCapturer::collect_captures(bool wait)
+{
+    while (pending_slot_count > 0) {
+        CaptureSlot& slot = slots[(next_slot_index + buffer_ring_size - pending_slot_count) % buffer_ring_size];
+
+        // When waiting, the fence is checked again every second, so that a lost context does not block forever
+        SyncWaitResult wait_result = SyncWaitResult::TIMEOUT_EXPIRED;
+
+        do {
+            wait_result = Renderer::wait_fence(slot.fence, (wait ? 1'000'000'000 : 0));
+        } while (wait && wait_result == SyncWaitResult::TIMEOUT_EXPIRED);
+
+        if (wait_result == SyncWaitResult::TIMEOUT_EXPIRED) {
+            break;
+        }
+
+        Renderer::delete_fence(slot.fence);
+        slot.fence = nullptr;
+        --pending_slot_count;
+
+        // The request is moved out of the slot, which can be reused by captures started from the callback
+        CaptureRequest const request = std::move(slot.request);
+
+        if (wait_result == SyncWaitResult::WAIT_FAILED) {
+            Log::error("[FrameCapturer] Failed to wait for a captured frame; the capture is discarded");
+            continue;
+        }
+
+        ZoneScopedN("FrameCapturer::collect_captures");
+
+        Image image = create_frame_image(slot.frame_size, request.format, request.data_type);
+
+        Renderer::bind_buffer(BufferType::PIXEL_PACK_BUFFER, slot.buffer);
+        void const* pixels = Renderer::map_buffer_range(
+            BufferType::PIXEL_PACK_BUFFER, 0, static_cast<std::ptrdiff_t>(slot.buffer_size), BufferMapAccess::READ
+        );
+
+        if (pixels != nullptr) {
+            copy_flipped_rows(static_cast<uint8_t const*>(pixels), image);
+        }
+
+        bool const is_valid = (Renderer::unmap_buffer(BufferType::PIXEL_PACK_BUFFER) && pixels != nullptr);
+        Renderer::unbind_buffer(BufferType::PIXEL_PACK_BUFFER);
+
+        if (!is_valid) {
+            Log::error("[FrameCapturer] Failed to read back a captured frame; the capture is discarded");
+            continue;
+        }
+
+        request.callback(std::move(image));
+    }
+}
+#endif
+}
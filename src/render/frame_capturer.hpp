@@ -0,0 +1,126 @@
+#pragma once
+
+#include <data/owner_value.hpp>
+#include <render/renderer.hpp>
+#include <utils/filepath.hpp>
+
+namespace xen {
+class Image;
+
+/// Function receiving a captured frame, whose rows are ordered from top to bottom.
+using FrameCaptureCallback = std::function<void(Image&&)>;
+
+/// FrameCapturer class, reading back the rendered frames without stalling the GPU. Each capture is read into a pixel
+/// pack buffer of a ring, followed by a fence; the buffer is only mapped a few frames later once the fence has been
+/// signaled, & the resulting image is given to the capture's callback. Saving the captured images to files is done
+/// by worker threads, so that the encoding does not delay the following frames either.
+/// Frames can also be captured continuously, each rendered frame being given to a callback or saved to a directory.
+/// \note Asynchronous captures are not available with OpenGL ES, where frames are read back immediately.
+class FrameCapturer {
+public:
+    /// Maximum number of captures awaiting their read back. If the GPU lags further behind, requested captures are
+    ///   delayed to the following frames, while continuous captures skip frames.
+    static constexpr size_t buffer_ring_size = 3;
+
+    FrameCapturer() = default;
+    FrameCapturer(FrameCapturer const&) = delete;
+    FrameCapturer(FrameCapturer&&) noexcept = default;
+
+    FrameCapturer& operator=(FrameCapturer const&) = delete;
+    FrameCapturer& operator=(FrameCapturer&&) noexcept = default;
+
+    ~FrameCapturer();
+
+    [[nodiscard]] bool is_capturing_continuously() const { return continuous_request.has_value(); }
+
+    /// Gets the number of captures which have been requested or read but not given to their callback yet.
+    /// \return Number of pending captures.
+    [[nodiscard]] size_t get_pending_capture_count() const;
+
+    /// Gets the number of frames skipped by the continuous capture since it has been enabled, because all the buffers
+    ///   of the ring were still awaiting their read back.
+    /// \return Number of skipped frames.
+    [[nodiscard]] size_t get_skipped_frame_count() const { return skipped_frame_count; }
+
+    /// Requests the capture of the next rendered frame.
+    /// \param callback Function to be called with the captured image, a few frames later.
+    /// \param format Format of the pixels to be read; DEPTH reads the depth buffer as floating-point values.
+    /// \param data_type Type of the pixels' components.
+    void capture(
+        FrameCaptureCallback callback, TextureFormat format = TextureFormat::RGB,
+        PixelDataType data_type = PixelDataType::UBYTE
+    );
+
+    /// Requests the capture of the next rendered frame, saving it to a file from a worker thread.
+    /// \param filepath File to save the captured image to; its extension determines the image format.
+    /// \param format Format of the pixels to be read; DEPTH reads the depth buffer as floating-point values.
+    /// \param data_type Type of the pixels' components.
+    void save(
+        FilePath filepath, TextureFormat format = TextureFormat::RGB, PixelDataType data_type = PixelDataType::UBYTE
+    );
+
+    /// Enables the continuous capture, capturing every rendered frame until disabled.
+    /// \param callback Function to be called with each captured image, in the order they have been rendered.
+    /// \param format Format of the pixels to be read; DEPTH reads the depth buffer as floating-point values.
+    /// \param data_type Type of the pixels' components.
+    void enable_continuous_capture(
+        FrameCaptureCallback callback, TextureFormat format = TextureFormat::RGB,
+        PixelDataType data_type = PixelDataType::UBYTE
+    );
+
+    /// Enables the continuous capture, saving every rendered frame to a directory from worker threads until disabled.
+    ///   The files are named after the frames' indices, starting from 0 (frame_000000.png, frame_000001.png, ...).
+    /// \param directory Directory to save the captured images to.
+    /// \param extension Extension of the files, which determines the image format.
+    void enable_continuous_saving(FilePath directory, std::string extension = "png");
+
+    /// Disables the continuous capture. The frames already captured are still given to their callback.
+    void disable_continuous_capture();
+
+    /// Gives the read back captures to their callback, then captures the current frame if requested. Must be called
+    ///   once per frame, after the frame has been rendered into the window's back buffer & before buffers are swapped.
+    /// \param frame_size Size of the rendered frame.
+    void update(Vector2ui const& frame_size);
+
+    /// Waits for all the captures in progress to be read back, giving them to their callback.
+    void flush();
+
+private:
+    struct CaptureRequest {
+        FrameCaptureCallback callback;
+        TextureFormat format;
+        PixelDataType data_type;
+    };
+
+#if !defined(USE_OPENGL_ES)
+    struct CaptureSlot {
+        OwnerValue<uint32_t> buffer{};
+        size_t buffer_size = 0;
+        SyncObject fence = nullptr;
+        Vector2ui frame_size{};
+        CaptureRequest request{};
+    };
+
+    std::array<CaptureSlot, buffer_ring_size> slots{};
+    size_t next_slot_index = 0;
+    size_t pending_slot_count = 0;
+#endif
+
+    std::vector<CaptureRequest> requests{};
+    std::optional<CaptureRequest> continuous_request{};
+    size_t skipped_frame_count = 0;
+
+private:
+    /// Reads the current frame & gives it to the request's callback.
+    /// \param frame_size Size of the frame to be read.
+    /// \param request Capture request.
+    /// \return True if the capture has been started, false if no buffer of the ring is available.
+    bool capture_frame(Vector2ui const& frame_size, CaptureRequest const& request);
+
+#if !defined(USE_OPENGL_ES)
+    /// Reads back the captures whose fence has been signaled, from the oldest one & until one is not ready yet.
+    /// \param wait True to wait for every pending capture to be ready, false to never wait.
+    void collect_captures(bool wait);
+#endif
+};
+}
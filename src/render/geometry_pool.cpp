@@ -0,0 +1,450 @@
+#include "geometry_pool.hpp"
+
+#include <data/mesh.hpp>
+#include <render/mesh_renderer.hpp>
+#include <render/renderer.hpp>
+
+#include <tracy/Tracy.hpp>
+#include <GL/glew.h> // Needed by TracyOpenGL.hpp
+#include <tracy/TracyOpenGL.hpp>
+
+namespace xen {
+namespace {
+/// Minimum number of vertices the vertex buffer is allocated with, avoiding frequent reallocations for small meshes.
+constexpr uint32_t min_vertex_capacity = 1u << 16u;
+
+/// Minimum number of indices the index buffer is allocated with.
+constexpr uint32_t min_index_capacity = 1u << 18u;
+
+/// First vertex attribute location of the instanced transforms; a matrix takes 4 consecutive locations.
+constexpr uint32_t transform_attrib_location = 4;
+
+/// Vertex attribute location of the instanced material table indices.
+constexpr uint32_t material_index_attrib_location = 8;
+
+/// Uniform name of a material's index in the material table, set only for the materials added to it.
+constexpr char const* material_index_uniform_name = "uniMaterialIndex";
+}
+
+GeometryPool::~GeometryPool()
+{
+#if !defined(USE_OPENGL_ES)
+    if (!vertex_array.is_valid()) {
+        return;
+    }
+
+    Renderer::delete_vertex_array(vertex_array);
+    Renderer::delete_buffer(vertex_buffer);
+    Renderer::delete_buffer(index_buffer);
+    Renderer::delete_buffer(transform_buffer);
+    Renderer::delete_buffer(material_index_buffer);
+    Renderer::delete_buffer(command_buffer);
+#endif
+}
+
+bool GeometryPool::is_supported()
+{
+#if !defined(USE_OPENGL_ES)
+    return Renderer::check_version(4, 3);
+#else
+    return false;
+#endif
+}
+
+bool GeometryPool::contains(MeshRenderer const& mesh_renderer) const
+{
+    return (find_entry(mesh_renderer) != nullptr);
+}
+
+void GeometryPool::add(MeshRenderer const& mesh_renderer, Mesh const& mesh)
+{
+    ZoneScopedN("GeometryPool::add");
+
+#if !defined(USE_OPENGL_ES)
+    if (!is_supported()) {
+        throw std::runtime_error("[GeometryPool] Multi-draw indirect requires OpenGL 4.3+");
+    }
+
+    std::shared_ptr<MeshRendererData> const data = mesh_renderer.get_data();
+
+    if (data == nullptr) {
+        throw std::invalid_argument("[GeometryPool] The mesh renderer has no data to be pooled");
+    }
+
+    if (data->get_vertex_format() != VertexFormat::FULL) {
+        throw std::invalid_argument("[GeometryPool] Only meshes with full-format vertices can be pooled");
+    }
+
+    std::vector<Submesh> const& submeshes = mesh.get_submeshes();
+    std::vector<SubmeshRenderer> const& submesh_renderers = data->get_submesh_renderers();
+
+    if (submeshes.size() != submesh_renderers.size()) {
+        throw std::invalid_argument("[GeometryPool] The mesh does not match the mesh renderer's submeshes");
+    }
+
+    for (SubmeshRenderer const& submesh_renderer : submesh_renderers) {
+        if (submesh_renderer.get_render_mode() != RenderMode::TRIANGLE) {
+            throw std::invalid_argument("[GeometryPool] Only meshes rendered as triangles can be pooled");
+        }
+    }
+
+    if (find_entry(mesh_renderer) != nullptr) {
+        return;
+    }
+
+    // An entry may remain from destroyed data that had the same address, which can be replaced
+    remove(mesh_renderer);
+
+    if (!vertex_array.is_valid()) {
+        Renderer::generate_vertex_array(vertex_array);
+        Renderer::generate_buffer(transform_buffer);
+        Renderer::generate_buffer(material_index_buffer);
+        Renderer::generate_buffer(command_buffer);
+    }
+
+    Log::vdebug("[GeometryPool] Adding mesh ({} submesh(es))...", submeshes.size());
+
+    Entry entry;
+    entry.data = data;
+    entry.allocations.reserve(submeshes.size());
+
+    for (Submesh const& submesh : submeshes) {
+        GeometryPoolAllocation& allocation = entry.allocations.emplace_back();
+        allocation.vertex_count = static_cast<uint32_t>(submesh.get_vertex_count());
+        allocation.index_count = static_cast<uint32_t>(submesh.get_triangle_index_count());
+        allocation.first_vertex = allocate(free_vertex_ranges, allocation.vertex_count, true);
+        allocation.first_index = allocate(free_index_ranges, allocation.index_count, false);
+
+        // The copy write target is used so as not to modify any vertex array's element buffer
+        Renderer::bind_buffer(BufferType::COPY_WRITE_BUFFER, vertex_buffer);
+        Renderer::send_buffer_sub_data(
+            BufferType::COPY_WRITE_BUFFER, static_cast<std::ptrdiff_t>(allocation.first_vertex * sizeof(Vertex)),
+            static_cast<std::ptrdiff_t>(allocation.vertex_count * sizeof(Vertex)), submesh.get_vertices().data()
+        );
+
+        // Indices are kept relative to their submesh, each command's base vertex offsetting them
+        Renderer::bind_buffer(BufferType::COPY_WRITE_BUFFER, index_buffer);
+        Renderer::send_buffer_sub_data(
+            BufferType::COPY_WRITE_BUFFER, static_cast<std::ptrdiff_t>(allocation.first_index * sizeof(uint32_t)),
+            static_cast<std::ptrdiff_t>(allocation.index_count * sizeof(uint32_t)),
+            submesh.get_triangle_indices().data()
+        );
+    }
+
+    Renderer::unbind_buffer(BufferType::COPY_WRITE_BUFFER);
+
+    entries.emplace(data.get(), std::move(entry));
+
+    Log::debug("[GeometryPool] Added mesh");
+#else
+    static_cast<void>(mesh_renderer);
+    static_cast<void>(mesh);
+    throw std::runtime_error("[GeometryPool] Multi-draw indirect is unavailable with OpenGL ES");
+#endif
+}
+
+void GeometryPool::remove(MeshRenderer const& mesh_renderer)
+{
+    auto const entry_it = entries.find(mesh_renderer.get_data().get());
+
+    if (entry_it == entries.end()) {
+        return;
+    }
+
+    for (GeometryPoolAllocation const& allocation : entry_it->second.allocations) {
+        release(free_vertex_ranges, allocation.first_vertex, allocation.vertex_count);
+        release(free_index_ranges, allocation.first_index, allocation.index_count);
+    }
+
+    entries.erase(entry_it);
+}
+
+bool GeometryPool::record_draw(MeshRenderer const& mesh_renderer, Matrix4 const& transform)
+{
+    if (!enabled) {
+        return false;
+    }
+
+    Entry const* entry = find_entry(mesh_renderer);
+
+    if (entry == nullptr) {
+        return false;
+    }
+
+    std::vector<SubmeshRenderer> const& submesh_renderers = mesh_renderer.get_submesh_renderers();
+    std::vector<Material> const& materials = mesh_renderer.get_materials();
+
+    for (size_t submesh_index = 0; submesh_index < entry->allocations.size(); ++submesh_index) {
+        GeometryPoolAllocation const& allocation = entry->allocations[submesh_index];
+        size_t const material_index = submesh_renderers[submesh_index].get_material_index();
+
+        // Submeshes without a material are drawn with the last bound program, as done by the mesh renderer
+        Material const* material = (material_index < materials.size() ? &materials[material_index] : nullptr);
+
+        // Materials in the material table only differ by their index, & can be drawn with any other using their program
+        bool const is_in_material_table =
+            (material != nullptr && material->get_program().has_attribute<uint32_t>(material_index_uniform_name));
+
+        size_t batch_index = batches.size();
+
+        if (is_in_material_table) {
+            uint32_t const program_index = material->get_program().get_index();
+            batch_index = program_batch_indices.try_emplace(program_index, batch_index).first->second;
+        }
+        else {
+            batch_index = batch_indices.try_emplace(material, batch_index).first->second;
+        }
+
+        if (batch_index == batches.size()) {
+            batches.emplace_back(Batch{material, {}});
+        }
+
+        // Each command has its own instance, selecting both its entity's transform & its material's index
+        auto const instance_index = static_cast<uint32_t>(transforms.size());
+        transforms.emplace_back(transform);
+        material_indices.emplace_back(
+            is_in_material_table ? material->get_program().get_attribute<uint32_t>(material_index_uniform_name) : 0
+        );
+
+        batches[batch_index].commands.emplace_back(DrawElementsIndirectCommand{
+            allocation.index_count, 1, allocation.first_index, static_cast<int32_t>(allocation.first_vertex),
+            instance_index
+        });
+    }
+
+    return true;
+}
+
+void GeometryPool::flush()
+{
+    ZoneScopedN("GeometryPool::flush");
+
+    batch_count = batches.size();
+    command_count = 0;
+
+#if !defined(USE_OPENGL_ES)
+    if (!batches.empty()) {
+        TracyGpuZone("GeometryPool::flush");
+
+        // The batches' commands are laid out one after the other in a single buffer
+        std::vector<size_t> batch_offsets;
+        batch_offsets.reserve(batches.size());
+
+        for (Batch const& batch : batches) {
+            batch_offsets.emplace_back(commands.size());
+            commands.insert(commands.end(), batch.commands.cbegin(), batch.commands.cend());
+        }
+
+        command_count = commands.size();
+
+        // All buffers are reallocated each frame, letting the driver orphan the previous storage instead of waiting
+        Renderer::bind_buffer(BufferType::ARRAY_BUFFER, transform_buffer);
+        Renderer::send_buffer_data(
+            BufferType::ARRAY_BUFFER, static_cast<std::ptrdiff_t>(transforms.size() * sizeof(Matrix4)),
+            transforms.data(), BufferDataUsage::STREAM_DRAW
+        );
+        Renderer::bind_buffer(BufferType::ARRAY_BUFFER, material_index_buffer);
+        Renderer::send_buffer_data(
+            BufferType::ARRAY_BUFFER, static_cast<std::ptrdiff_t>(material_indices.size() * sizeof(uint32_t)),
+            material_indices.data(), BufferDataUsage::STREAM_DRAW
+        );
+        Renderer::unbind_buffer(BufferType::ARRAY_BUFFER);
+
+        Renderer::bind_buffer(BufferType::DRAW_INDIRECT_BUFFER, command_buffer);
+        Renderer::send_buffer_data(
+            BufferType::DRAW_INDIRECT_BUFFER,
+            static_cast<std::ptrdiff_t>(commands.size() * sizeof(DrawElementsIndirectCommand)), commands.data(),
+            BufferDataUsage::STREAM_DRAW
+        );
+
+        Renderer::bind_vertex_array(vertex_array);
+
+        for (size_t batch_index = 0; batch_index < batches.size(); ++batch_index) {
+            if (batches[batch_index].material != nullptr) {
+                batches[batch_index].material->get_program().bind_textures();
+            }
+
+            Renderer::multi_draw_elements_indirect(
+                PrimitiveType::TRIANGLES, ElementDataType::UINT,
+                static_cast<std::ptrdiff_t>(batch_offsets[batch_index] * sizeof(DrawElementsIndirectCommand)),
+                static_cast<uint32_t>(batches[batch_index].commands.size())
+            );
+        }
+
+        Renderer::unbind_vertex_array();
+        Renderer::unbind_buffer(BufferType::DRAW_INDIRECT_BUFFER);
+    }
+#endif
+
+    batches.clear();
+    batch_indices.clear();
+    program_batch_indices.clear();
+    transforms.clear();
+    material_indices.clear();
+    commands.clear();
+}
+
+GeometryPool::Entry const* GeometryPool::find_entry(MeshRenderer const& mesh_renderer) const
+{
+    std::shared_ptr<MeshRendererData> const data = mesh_renderer.get_data();
+
+    if (data == nullptr) {
+        return nullptr;
+    }
+
+    auto const entry_it = entries.find(data.get());
+
+    if (entry_it == entries.cend() || entry_it->second.data.lock() != data) {
+        return nullptr;
+    }
+
+    return &entry_it->second;
+}
+
+uint32_t GeometryPool::allocate(std::vector<FreeRange>& free_ranges, uint32_t count, bool is_vertex_range)
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    while (true) {
+        // First fit, keeping the beginning of the buffers as densely packed as possible
+        for (auto range_it = free_ranges.begin(); range_it != free_ranges.end(); ++range_it) {
+            if (range_it->count < count) {
+                continue;
+            }
+
+            uint32_t const offset = range_it->offset;
+            range_it->offset += count;
+            range_it->count -= count;
+
+            if (range_it->count == 0) {
+                free_ranges.erase(range_it);
+            }
+
+            return offset;
+        }
+
+        uint32_t const capacity = (is_vertex_range ? vertex_capacity : index_capacity);
+        grow_buffer(
+            is_vertex_range,
+            std::max({capacity * 2, capacity + count, (is_vertex_range ? min_vertex_capacity : min_index_capacity)})
+        );
+    }
+}
+
+void GeometryPool::release(std::vector<FreeRange>& free_ranges, uint32_t offset, uint32_t count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    auto const next_it = std::lower_bound(
+        free_ranges.begin(), free_ranges.end(), offset,
+        [](FreeRange const& range, uint32_t range_offset) { return (range.offset < range_offset); }
+    );
+    auto range_it = free_ranges.insert(next_it, FreeRange{offset, count});
+
+    // Merging with the following range, then with the preceding one
+    if (auto const following_it = std::next(range_it);
+        following_it != free_ranges.end() && range_it->offset + range_it->count == following_it->offset) {
+        range_it->count += following_it->count;
+        free_ranges.erase(following_it);
+    }
+
+    if (range_it != free_ranges.begin()) {
+        if (auto const preceding_it = std::prev(range_it); preceding_it->offset + preceding_it->count == offset) {
+            preceding_it->count += range_it->count;
+            free_ranges.erase(range_it);
+        }
+    }
+}
+
+void GeometryPool::grow_buffer(bool is_vertex_buffer, uint32_t capacity)
+{
+    ZoneScopedN("GeometryPool::grow_buffer");
+
+    OwnerValue<uint32_t>& buffer = (is_vertex_buffer ? vertex_buffer : index_buffer);
+    uint32_t& current_capacity = (is_vertex_buffer ? vertex_capacity : index_capacity);
+    size_t const element_size = (is_vertex_buffer ? sizeof(Vertex) : sizeof(uint32_t));
+
+    Log::vdebug(
+        "[GeometryPool] Growing the {} buffer ({} -> {} elements)...", (is_vertex_buffer ? "vertex" : "index"),
+        current_capacity, capacity
+    );
+
+    uint32_t new_buffer{};
+    Renderer::generate_buffer(new_buffer);
+    Renderer::bind_buffer(BufferType::COPY_WRITE_BUFFER, new_buffer);
+    Renderer::send_buffer_data(
+        BufferType::COPY_WRITE_BUFFER, static_cast<std::ptrdiff_t>(capacity * element_size), nullptr,
+        BufferDataUsage::STATIC_DRAW
+    );
+
+    // The existing content is copied on the GPU, without any round trip through the CPU
+    if (buffer.is_valid()) {
+        Renderer::bind_buffer(BufferType::COPY_READ_BUFFER, buffer);
+        Renderer::copy_buffer_sub_data(
+            BufferType::COPY_READ_BUFFER, BufferType::COPY_WRITE_BUFFER, 0, 0,
+            static_cast<std::ptrdiff_t>(current_capacity * element_size)
+        );
+        Renderer::unbind_buffer(BufferType::COPY_READ_BUFFER);
+        Renderer::delete_buffer(buffer);
+    }
+
+    Renderer::unbind_buffer(BufferType::COPY_WRITE_BUFFER);
+
+    buffer = new_buffer;
+
+    release((is_vertex_buffer ? free_vertex_ranges : free_index_ranges), current_capacity, capacity - current_capacity);
+    current_capacity = capacity;
+
+    // The vertex array references the buffers themselves, & must be updated to use the new one
+    setup_vertex_array();
+}
+
+void GeometryPool::setup_vertex_array() const
+{
+    Renderer::bind_vertex_array(vertex_array);
+
+    if (vertex_buffer.is_valid()) {
+        Renderer::bind_buffer(BufferType::ARRAY_BUFFER, vertex_buffer);
+
+        constexpr uint32_t stride = sizeof(Vertex);
+
+        Renderer::set_vertex_attrib(0, AttribDataType::FLOAT, 3, stride, offsetof(Vertex, position));
+        Renderer::enable_vertex_attrib_array(0);
+        Renderer::set_vertex_attrib(1, AttribDataType::FLOAT, 2, stride, offsetof(Vertex, texcoords));
+        Renderer::enable_vertex_attrib_array(1);
+        Renderer::set_vertex_attrib(2, AttribDataType::FLOAT, 3, stride, offsetof(Vertex, normal));
+        Renderer::enable_vertex_attrib_array(2);
+        Renderer::set_vertex_attrib(3, AttribDataType::FLOAT, 3, stride, offsetof(Vertex, tangent));
+        Renderer::enable_vertex_attrib_array(3);
+    }
+
+    // Each draw command's base instance selects its entity's transform, the attributes advancing once per instance
+    Renderer::bind_buffer(BufferType::ARRAY_BUFFER, transform_buffer);
+
+    for (uint32_t column_index = 0; column_index < 4; ++column_index) {
+        uint32_t const location = transform_attrib_location + column_index;
+
+        Renderer::set_vertex_attrib(
+            location, AttribDataType::FLOAT, 4, sizeof(Matrix4), column_index * sizeof(Vector4f)
+        );
+        Renderer::set_vertex_attribDivisor(location, 1);
+        Renderer::enable_vertex_attrib_array(location);
+    }
+
+    Renderer::bind_buffer(BufferType::ARRAY_BUFFER, material_index_buffer);
+    Renderer::set_vertex_attrib_integer(material_index_attrib_location, AttribDataType::UINT, 1, sizeof(uint32_t), 0);
+    Renderer::set_vertex_attribDivisor(material_index_attrib_location, 1);
+    Renderer::enable_vertex_attrib_array(material_index_attrib_location);
+
+    if (index_buffer.is_valid()) {
+        Renderer::bind_buffer(BufferType::ELEMENT_BUFFER, index_buffer);
+    }
+
+    Renderer::unbind_vertex_array();
+    Renderer::unbind_buffer(BufferType::ARRAY_BUFFER);
+}
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <data/owner_value.hpp>
+
+namespace xen {
+class Material;
+class Mesh;
+class MeshRenderer;
+class MeshRendererData;
+
+/// Parameters of an indexed indirect draw, laid out as expected by glMultiDrawElementsIndirect().
+struct DrawElementsIndirectCommand {
+    uint32_t index_count;
+    uint32_t instance_count;
+    uint32_t first_index;
+    int32_t base_vertex;
+    uint32_t base_instance;
+};
+
+/// Range occupied by a submesh in the geometry pool's buffers.
+struct GeometryPoolAllocation {
+    uint32_t first_vertex;
+    uint32_t vertex_count;
+    uint32_t first_index;
+    uint32_t index_count;
+};
+
+/// Geometry pool, suballocating the vertices & indices of static meshes into a single vertex buffer & a single index
+/// buffer shared by all of them. Pooled meshes are drawn without rebinding any buffer: every frame, a draw command is
+/// recorded for each visible submesh, & all commands sharing the same material are issued by a single multi-draw
+/// indirect call. The transforms of the drawn entities are sent as an instanced vertex attribute, selected by each
+/// command's base instance.
+/// Materials added to the material table are batched by program instead: as each command also sends its material's
+/// index in the table as an instanced attribute, the submeshes of all materials sharing a program are drawn at once.
+/// \note Multi-draw indirect requires OpenGL 4.3+; unavailable with OpenGL ES.
+class GeometryPool {
+public:
+    GeometryPool() = default;
+    GeometryPool(GeometryPool const&) = delete;
+    GeometryPool(GeometryPool&&) noexcept = default;
+
+    GeometryPool& operator=(GeometryPool const&) = delete;
+    GeometryPool& operator=(GeometryPool&&) noexcept = default;
+
+    ~GeometryPool();
+
+    /// Checks if the geometry pool can be used, which requires multi-draw indirect.
+    /// \return True if pooled meshes can be drawn, false otherwise.
+    [[nodiscard]] static bool is_supported();
+
+    [[nodiscard]] bool is_enabled() const { return enabled; }
+
+    [[nodiscard]] size_t get_mesh_count() const { return entries.size(); }
+
+    [[nodiscard]] uint32_t get_vertex_capacity() const { return vertex_capacity; }
+
+    [[nodiscard]] uint32_t get_index_capacity() const { return index_capacity; }
+
+    /// Gets the number of multi-draw calls issued during the last flush, one per material or per program for the
+    ///   materials in the material table.
+    /// \return Number of multi-draw calls.
+    [[nodiscard]] size_t get_batch_count() const { return batch_count; }
+
+    /// Gets the number of submesh draws recorded during the last flush.
+    /// \return Number of draw commands.
+    [[nodiscard]] size_t get_command_count() const { return command_count; }
+
+    /// Enables or disables the geometry pool. While disabled, pooled meshes are drawn by their own mesh renderer.
+    /// \param enabled True to enable the geometry pool, false otherwise.
+    void enable(bool enabled = true) { this->enabled = enabled; }
+
+    void disable() { enable(false); }
+
+    /// Checks if a mesh renderer's data has been added to the pool.
+    /// \param mesh_renderer Mesh renderer to be checked.
+    /// \return True if the mesh renderer's submeshes are pooled, false otherwise.
+    [[nodiscard]] bool contains(MeshRenderer const& mesh_renderer) const;
+
+    /// Adds a mesh to the pool, drawn in place of the given mesh renderer. Mesh renderers sharing the same data are
+    /// pooled only once.
+    /// \note The mesh renderer's vertices must have the full format, and its submeshes must be rendered as triangles.
+    /// \param mesh_renderer Mesh renderer whose data the mesh corresponds to.
+    /// \param mesh Mesh whose submeshes are to be added.
+    void add(MeshRenderer const& mesh_renderer, Mesh const& mesh);
+
+    /// Removes a mesh renderer's data from the pool, freeing its ranges to be reused.
+    /// \param mesh_renderer Mesh renderer whose data is to be removed.
+    void remove(MeshRenderer const& mesh_renderer);
+
+    /// Records the draws of a mesh renderer's submeshes, to be issued on the next flush.
+    /// \param mesh_renderer Mesh renderer to be drawn.
+    /// \param transform Transformation matrix of the entity.
+    /// \return True if the mesh renderer is pooled & its draws have been recorded, false if it must be drawn by itself.
+    bool record_draw(MeshRenderer const& mesh_renderer, Matrix4 const& transform);
+
+    /// Issues all the recorded draws, one multi-draw call per material, then clears them.
+    /// \note The model uniform buffer must tell the vertex shader to use the instanced transforms.
+    /// \note The material table must be bound beforehand if any of the materials is in it.
+    void flush();
+
+private:
+    /// Range of consecutive free elements in a buffer.
+    struct FreeRange {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    struct Entry {
+        std::weak_ptr<MeshRendererData> data;
+        std::vector<GeometryPoolAllocation> allocations;
+    };
+
+    struct Batch {
+        Material const* material;
+        std::vector<DrawElementsIndirectCommand> commands;
+    };
+
+    bool enabled = true;
+
+    std::unordered_map<MeshRendererData const*, Entry> entries{};
+
+    OwnerValue<uint32_t> vertex_array{};
+    OwnerValue<uint32_t> vertex_buffer{};
+    OwnerValue<uint32_t> index_buffer{};
+    OwnerValue<uint32_t> transform_buffer{};
+    OwnerValue<uint32_t> material_index_buffer{};
+    OwnerValue<uint32_t> command_buffer{};
+
+    uint32_t vertex_capacity = 0;
+    uint32_t index_capacity = 0;
+    std::vector<FreeRange> free_vertex_ranges{};
+    std::vector<FreeRange> free_index_ranges{};
+
+    std::vector<Batch> batches{};
+    std::unordered_map<Material const*, size_t> batch_indices{};
+    std::unordered_map<uint32_t, size_t> program_batch_indices{};
+    std::vector<Matrix4> transforms{};
+    std::vector<uint32_t> material_indices{};
+    std::vector<DrawElementsIndirectCommand> commands{};
+    size_t batch_count = 0;
+    size_t command_count = 0;
+
+private:
+    /// Finds the entry of a mesh renderer's data, ignoring it if the data it was added for has been destroyed since.
+    /// \param mesh_renderer Mesh renderer whose entry is to be found.
+    /// \return Pointer to the entry if found, null otherwise.
+    Entry const* find_entry(MeshRenderer const& mesh_renderer) const;
+
+    /// Allocates a range of elements, growing the corresponding buffer if no free range is large enough.
+    /// \param free_ranges Free ranges of the buffer, sorted by offset.
+    /// \param count Number of elements to allocate.
+    /// \param is_vertex_range True to allocate vertices, false to allocate indices.
+    /// \return Offset of the allocated range.
+    uint32_t allocate(std::vector<FreeRange>& free_ranges, uint32_t count, bool is_vertex_range);
+
+    /// Frees a range of elements, merging it with its free neighbors.
+    /// \param free_ranges Free ranges of the buffer, sorted by offset.
+    /// \param offset Offset of the range to be freed.
+    /// \param count Number of elements to be freed.
+    static void release(std::vector<FreeRange>& free_ranges, uint32_t offset, uint32_t count);
+
+    /// Reallocates a buffer with a larger capacity, keeping its content.
+    /// \param is_vertex_buffer True to grow the vertex buffer, false to grow the index buffer.
+    /// \param capacity New capacity of the buffer, in elements.
+    void grow_buffer(bool is_vertex_buffer, uint32_t capacity);
+
+    /// Sets up the vertex array, binding the vertex attributes to the current buffers.
+    void setup_vertex_array() const;
+};
+}
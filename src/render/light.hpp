@@ -26,12 +26,17 @@ public:
     constexpr float get_energy() const { return energy; }
     constexpr Color const& get_color() const { return color; }
     constexpr Radiansf get_angle() const { return angle; }
+    /// Checks if the light casts shadows; these are only rendered if the render graph's shadow renderer is enabled.
+    /// \see RenderGraph::get_shadow_renderer()
+    constexpr bool has_shadows() const { return shadows; }
 
     constexpr void set_type(LightType type) { this->type = type; }
     constexpr void set_direction(Vector3f const& direction) { this->direction = direction; }
     constexpr void set_energy(float energy) { this->energy = energy; }
     constexpr void set_color(Color const& color) { this->color = color; }
     constexpr void set_angle(Radiansf angle) { this->angle = angle; }
+    constexpr void enable_shadows(bool enabled = true) { shadows = enabled; }
+    constexpr void disable_shadows() { enable_shadows(false); }
 
 private:
     LightType type{};
@@ -39,6 +44,7 @@ private:
     float energy = 1.f;
     Color color{};
     Radiansf angle = Radiansf(1.f);
+    bool shadows = false;
 };
 
 }
\ No newline at end of file
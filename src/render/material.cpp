@@ -33,10 +33,9 @@ void Material::load_type(MaterialType type)
 
     switch (type) {
     case MaterialType::COOK_TORRANCE:
-        program.set_shaders(
-            VertexShader::load_from_source(vert_shader_source),
-            FragmentShader::load_from_source(cook_torrance_shader_source)
-        );
+        program.set_vertex_shader(VertexShader::load_from_source(vert_shader_source));
+        program.set_fragment_shader(FragmentShader::load_from_source(cook_torrance_shader_source));
+        program.set_permutation(ShaderFeature::NORMAL_MAP | ShaderFeature::ALPHA_TEST);
 
         if (!program.has_attribute(MaterialAttribute::BaseColor)) {
             program.set_attribute(Vector3f(1.f), MaterialAttribute::BaseColor);
@@ -83,10 +82,9 @@ void Material::load_type(MaterialType type)
         break;
 
     case MaterialType::BLINN_PHONG:
-        program.set_shaders(
-            VertexShader::load_from_source(vert_shader_source),
-            FragmentShader::load_from_source(blinn_phong_shader_source)
-        );
+        program.set_vertex_shader(VertexShader::load_from_source(vert_shader_source));
+        program.set_fragment_shader(FragmentShader::load_from_source(blinn_phong_shader_source));
+        program.set_permutation(ShaderFeature::ALPHA_TEST);
 
         if (!program.has_attribute(MaterialAttribute::BaseColor)) {
             program.set_attribute(Vector3f(1.f), MaterialAttribute::BaseColor);
@@ -128,10 +126,9 @@ void Material::load_type(MaterialType type)
         break;
 
     case MaterialType::SINGLE_TEXTURE_2D:
-        program.set_shaders(
-            VertexShader::load_from_source(vert_shader_source),
-            FragmentShader::load_from_source(single_texture_2d_shader_source)
-        );
+        program.set_vertex_shader(VertexShader::load_from_source(vert_shader_source));
+        program.set_fragment_shader(FragmentShader::load_from_source(single_texture_2d_shader_source));
+        program.set_permutation(ShaderFeature::NONE);
 
         if (!program.has_texture(MaterialTexture::BaseColor)) {
             program.set_texture(Texture2D::create(Color::White), MaterialTexture::BaseColor);
@@ -140,10 +137,9 @@ void Material::load_type(MaterialType type)
         break;
 
     case MaterialType::SINGLE_TEXTURE_3D:
-        program.set_shaders(
-            VertexShader::load_from_source(vert_shader_source),
-            FragmentShader::load_from_source(single_texture_3d_shader_source)
-        );
+        program.set_vertex_shader(VertexShader::load_from_source(vert_shader_source));
+        program.set_fragment_shader(FragmentShader::load_from_source(single_texture_3d_shader_source));
+        program.set_permutation(ShaderFeature::NONE);
 
         if (!program.has_texture(MaterialTexture::BaseColor)) {
             program.set_texture(Texture3D::create(Color::White), MaterialTexture::BaseColor);
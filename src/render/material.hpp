@@ -72,7 +72,8 @@ public:
     [[nodiscard]] Material clone() const { return *this; }
 
     /// Loads a predefined material type, setting default shaders & adding all needed attributes & textures if they do
-    /// not exist yet.
+    /// not exist yet. The type's default features are enabled in the shaders, e.g. normal mapping & alpha testing for
+    /// Cook-Torrance; they can be changed afterward with the program's set_permutation().
     /// \param type Material type to apply.
     void load_type(MaterialType type);
 
@@ -0,0 +1,261 @@
+#include "material_table.hpp"
+
+#include <render/material.hpp>
+#include <render/mesh_renderer.hpp>
+#include <render/renderer.hpp>
+#include <render/texture.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace xen {
+namespace {
+/// Uniform name of the material's index in the table, used when the material is not drawn from the geometry pool.
+constexpr char const* material_index_uniform_name = "uniMaterialIndex";
+
+/// Textures referenced by the materials' rows, in the order of their handles.
+constexpr std::array<char const*, 6> texture_names = {
+    MaterialTexture::BaseColor, MaterialTexture::Emissive,  MaterialTexture::Normal,
+    MaterialTexture::Metallic,  MaterialTexture::Roughness, MaterialTexture::Ambient
+};
+
+Vector4f recover_color(RenderShaderProgram const& program, char const* uniform_name, float default_value)
+{
+    if (program.has_attribute<Vector3f>(uniform_name)) {
+        Vector3f const& color = program.get_attribute<Vector3f>(uniform_name);
+        return Vector4f(color.x, color.y, color.z, 1.f);
+    }
+
+    if (program.has_attribute<Vector4f>(uniform_name)) {
+        return program.get_attribute<Vector4f>(uniform_name);
+    }
+
+    return Vector4f(default_value, default_value, default_value, 1.f);
+}
+
+float recover_factor(RenderShaderProgram const& program, char const* uniform_name)
+{
+    return (program.has_attribute<float>(uniform_name) ? program.get_attribute<float>(uniform_name) : 1.f);
+}
+} // namespace
+
+static_assert(sizeof(MaterialData) == 96, "Error: The material data must match the shaders' std430 layout");
+
+MaterialTable::~MaterialTable()
+{
+#if !defined(USE_OPENGL_ES)
+    for (auto const& [texture_index, resident_handle] : resident_handles) {
+        Renderer::make_texture_handle_resident(resident_handle.first, false);
+    }
+
+    if (storage_buffer.is_valid()) {
+        Renderer::delete_buffer(storage_buffer);
+    }
+#endif
+}
+
+bool MaterialTable::is_supported()
+{
+#if !defined(USE_OPENGL_ES)
+    return (Renderer::check_version(4, 3) && Renderer::is_extension_supported("GL_ARB_bindless_texture"));
+#else
+    return false;
+#endif
+}
+
+uint32_t MaterialTable::add(Material& material)
+{
+    ZoneScopedN("MaterialTable::add");
+
+    if (!is_supported()) {
+        throw std::runtime_error("[MaterialTable] The material table requires OpenGL 4.3+ & GL_ARB_bindless_texture");
+    }
+
+    if (auto const index_it = indices.find(&material); index_it != indices.cend()) {
+        return index_it->second;
+    }
+
+    RenderShaderProgram& program = material.get_program();
+
+    for (char const* texture_name : texture_names) {
+        if (!program.has_texture(texture_name)) {
+            throw std::invalid_argument("[MaterialTable] Only Cook-Torrance materials can be added to the table");
+        }
+    }
+
+    uint32_t index{};
+
+    if (!free_indices.empty()) {
+        index = free_indices.back();
+        free_indices.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(materials.size());
+        materials.emplace_back();
+        entries.emplace_back();
+    }
+
+    fill_entry(index, material);
+    indices.emplace(&material, index);
+
+    program.set_attribute(index, material_index_uniform_name);
+    program.set_permutation(program.get_permutation() | ShaderFeature::MATERIAL_TABLE);
+
+    Log::vdebug("[MaterialTable] Added material at index {}", index);
+
+    return index;
+}
+
+void MaterialTable::add(MeshRenderer& mesh_renderer)
+{
+    for (Material& material : mesh_renderer.get_materials()) {
+        add(material);
+    }
+}
+
+void MaterialTable::update(Material const& material)
+{
+    ZoneScopedN("MaterialTable::update");
+
+    auto const index_it = indices.find(&material);
+
+    if (index_it == indices.cend()) {
+        throw std::invalid_argument("[MaterialTable] The material to be updated is not in the table");
+    }
+
+    // The new textures are acquired before the previous ones are released, keeping the handles they share resident
+    Entry previous_entry = std::move(entries[index_it->second]);
+    fill_entry(index_it->second, material);
+    release_entry(previous_entry);
+}
+
+void MaterialTable::remove(Material& material)
+{
+    auto const index_it = indices.find(&material);
+
+    if (index_it == indices.cend()) {
+        return;
+    }
+
+    uint32_t const index = index_it->second;
+
+    release_entry(entries[index]);
+    materials[index] = MaterialData{};
+    free_indices.emplace_back(index);
+    indices.erase(index_it);
+    is_dirty = true;
+
+    RenderShaderProgram& program = material.get_program();
+    program.remove_attribute(material_index_uniform_name);
+    program.set_permutation(program.get_permutation() & ~ShaderFeature::MATERIAL_TABLE);
+}
+
+void MaterialTable::bind()
+{
+#if !defined(USE_OPENGL_ES)
+    if (materials.empty()) {
+        return;
+    }
+
+    if (!storage_buffer.is_valid()) {
+        Renderer::generate_buffer(storage_buffer);
+    }
+
+    if (is_dirty) {
+        ZoneScopedN("MaterialTable::bind");
+
+        auto const data_size = static_cast<std::ptrdiff_t>(materials.size() * sizeof(MaterialData));
+
+        Renderer::bind_buffer(BufferType::SHADER_STORAGE_BUFFER, storage_buffer);
+
+        if (materials.size() > storage_buffer_capacity) {
+            Renderer::send_buffer_data(
+                BufferType::SHADER_STORAGE_BUFFER, data_size, materials.data(), BufferDataUsage::DYNAMIC_DRAW
+            );
+            storage_buffer_capacity = materials.size();
+        }
+        else {
+            Renderer::send_buffer_sub_data(BufferType::SHADER_STORAGE_BUFFER, 0, data_size, materials.data());
+        }
+
+        Renderer::unbind_buffer(BufferType::SHADER_STORAGE_BUFFER);
+
+        is_dirty = false;
+    }
+
+    Renderer::bind_buffer_base(BufferType::SHADER_STORAGE_BUFFER, storage_buffer_binding, storage_buffer);
+#endif
+}
+
+void MaterialTable::fill_entry(uint32_t index, Material const& material)
+{
+    RenderShaderProgram const& program = material.get_program();
+
+    MaterialData& material_data = materials[index];
+    material_data.base_color = recover_color(program, MaterialAttribute::BaseColor, 1.f);
+    material_data.emissive = recover_color(program, MaterialAttribute::Emissive, 0.f);
+    material_data.factors = Vector4f(
+        recover_factor(program, MaterialAttribute::Metallic), recover_factor(program, MaterialAttribute::Roughness),
+        0.f, 0.f
+    );
+
+    Entry& entry = entries[index];
+    entry.material = &material;
+
+    for (size_t texture_index = 0; texture_index < texture_names.size(); ++texture_index) {
+        auto const texture_it = std::find_if(
+            program.get_textures().cbegin(), program.get_textures().cend(),
+            [&texture_index](auto const& texture) { return (texture.second == texture_names[texture_index]); }
+        );
+
+        if (texture_it == program.get_textures().cend()) {
+            throw std::invalid_argument("[MaterialTable] Only Cook-Torrance materials can be added to the table");
+        }
+
+        material_data.texture_handles[texture_index] = acquire_handle(*texture_it->first);
+        entry.textures[texture_index] = texture_it->first;
+    }
+
+    is_dirty = true;
+}
+
+void MaterialTable::release_entry(Entry& entry)
+{
+    for (TexturePtr& texture : entry.textures) {
+        if (texture == nullptr) {
+            continue;
+        }
+
+        auto const handle_it = resident_handles.find(texture->get_index());
+
+        if (handle_it != resident_handles.end() && --handle_it->second.second == 0) {
+#if !defined(USE_OPENGL_ES)
+            Renderer::make_texture_handle_resident(handle_it->second.first, false);
+#endif
+            resident_handles.erase(handle_it);
+        }
+
+        texture.reset();
+    }
+
+    entry.material = nullptr;
+}
+
+uint64_t MaterialTable::acquire_handle(Texture& texture)
+{
+#if !defined(USE_OPENGL_ES)
+    auto [handle_it, is_new_handle] = resident_handles.try_emplace(texture.get_index(), 0, 0);
+
+    if (is_new_handle) {
+        handle_it->second.first = texture.recover_bindless_handle();
+        Renderer::make_texture_handle_resident(handle_it->second.first);
+    }
+
+    ++handle_it->second.second;
+
+    return handle_it->second.first;
+#else
+    static_cast<void>(texture);
+    return 0;
+#endif
+}
+}
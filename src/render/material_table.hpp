@@ -0,0 +1,110 @@
+#pragma once
+
+#include <data/owner_value.hpp>
+
+namespace xen {
+class Material;
+class MeshRenderer;
+using TexturePtr = std::shared_ptr<class Texture>;
+
+/// Parameters of a material in the material table, laid out as expected by the shaders' std430 storage buffer.
+struct MaterialData {
+    Vector4f base_color; ///< Base color factor (RGB).
+    Vector4f emissive;   ///< Emissive factor (RGB).
+    Vector4f factors;    ///< Metallic (X) & roughness (Y) factors.
+    std::array<uint64_t, 6> texture_handles; ///< Bindless handles of the base color, emissive, normal, metallic,
+                                             ///  roughness & ambient occlusion maps.
+};
+
+/// Material table, packing the parameters of Cook-Torrance materials into a single shader storage buffer, their
+/// textures being referenced by bindless handles. Materials added to the table are switched to their material table
+/// permutation: draws then only need to give the material's index, which the geometry pool sends per draw command so
+/// that pooled meshes sharing the same program are drawn by a single multi-draw call whatever their materials.
+/// Materials not in the table keep sending their parameters as uniforms & binding their textures.
+/// \note Requires OpenGL 4.3+ & GL_ARB_bindless_texture; unavailable with OpenGL ES.
+/// \note A texture cannot be modified anymore once one of the materials using it has been added to the table, be it
+///   its parameters, such as its filtering or wrapping, or its data; textures loaded from TextureCache are thus no
+///   longer reloaded when their file is modified.
+class MaterialTable {
+public:
+    /// Binding point of the shader storage buffer holding the materials.
+    static constexpr uint32_t storage_buffer_binding = 0;
+
+    MaterialTable() = default;
+    MaterialTable(MaterialTable const&) = delete;
+    MaterialTable(MaterialTable&&) noexcept = default;
+
+    MaterialTable& operator=(MaterialTable const&) = delete;
+    MaterialTable& operator=(MaterialTable&&) noexcept = default;
+
+    ~MaterialTable();
+
+    /// Checks if the material table can be used, which requires shader storage buffers & bindless textures.
+    /// \return True if materials can be added to the table, false otherwise.
+    [[nodiscard]] static bool is_supported();
+
+    [[nodiscard]] size_t get_material_count() const { return indices.size(); }
+
+    /// Gets the number of distinct textures made resident by the table's materials.
+    /// \return Number of resident texture handles.
+    [[nodiscard]] size_t get_resident_texture_count() const { return resident_handles.size(); }
+
+    [[nodiscard]] bool contains(Material const& material) const { return indices.contains(&material); }
+
+    /// Adds a material to the table, switching its program to the material table permutation.
+    /// \note The material must not be moved while it is in the table, its address identifying it.
+    /// \note If permutation sharing is disabled, the material's attributes must be sent again afterward, which can be
+    ///   done with RenderSystem::update_materials().
+    /// \param material Cook-Torrance material to be added.
+    /// \return Index of the material in the table.
+    uint32_t add(Material& material);
+
+    /// Adds all the materials of a mesh renderer to the table.
+    /// \param mesh_renderer Mesh renderer whose materials are to be added.
+    void add(MeshRenderer& mesh_renderer);
+
+    /// Updates a material's parameters & textures in the table, which must be done after any of them has changed.
+    /// \param material Material to be updated.
+    void update(Material const& material);
+
+    /// Removes a material from the table, switching its program back to its previous permutation.
+    /// \param material Material to be removed.
+    void remove(Material& material);
+
+    /// Sends the modified materials & binds the storage buffer, for the materials to be accessed by the shaders.
+    void bind();
+
+private:
+    struct Entry {
+        Material const* material = nullptr;
+        std::array<TexturePtr, 6> textures{};
+    };
+
+    std::vector<MaterialData> materials{};
+    std::vector<Entry> entries{};
+    std::unordered_map<Material const*, uint32_t> indices{};
+    std::vector<uint32_t> free_indices{};
+
+    /// Resident handles, associated with the index of their texture & the number of entries referencing it.
+    std::unordered_map<uint32_t, std::pair<uint64_t, size_t>> resident_handles{};
+
+    OwnerValue<uint32_t> storage_buffer{};
+    size_t storage_buffer_capacity = 0;
+    bool is_dirty = false;
+
+private:
+    /// Fills a material's row from its program's attributes & textures, making its textures' handles resident.
+    /// \param index Index of the material in the table.
+    /// \param material Material to recover the parameters of.
+    void fill_entry(uint32_t index, Material const& material);
+
+    /// Releases the textures of an entry, making their handles non-resident if no other entry uses them.
+    /// \param entry Entry to be released.
+    void release_entry(Entry& entry);
+
+    /// Recovers the bindless handle of a texture, making it resident if it was not yet.
+    /// \param texture Texture to recover the handle of.
+    /// \return Resident handle of the texture.
+    uint64_t acquire_handle(Texture& texture);
+};
+}
@@ -0,0 +1,87 @@
+#include "mesh_lod.hpp"
+
+#include <render/mesh_renderer.hpp>
+
+#include <tracy/Tracy.hpp>
+#include <GL/glew.h> // Needed by TracyOpenGL.hpp
+#include <tracy/TracyOpenGL.hpp>
+
+namespace xen {
+MeshLod::MeshLod(std::vector<MeshSimplifier::Level> const& levels, VertexFormat vertex_format) :
+    vertex_format{vertex_format}
+{
+    for (MeshSimplifier::Level const& level : levels) {
+        add_level(level.mesh, level.error);
+    }
+}
+
+void MeshLod::add_level(Mesh const& mesh, float error)
+{
+    ZoneScopedN("MeshLod::add_level");
+
+    MeshLodLevel& level = levels.emplace_back();
+    level.error = error;
+    level.submesh_renderers.resize(mesh.get_submeshes().size());
+
+    for (size_t submesh_index = 0; submesh_index < mesh.get_submeshes().size(); ++submesh_index) {
+        level.submesh_renderers[submesh_index].load(
+            mesh.get_submeshes()[submesh_index], RenderMode::TRIANGLE, vertex_format
+        );
+    }
+}
+
+size_t MeshLod::select_level(float pixels_per_unit) const
+{
+    size_t selected_level = 0;
+
+    for (size_t level_index = 0; level_index < levels.size(); ++level_index) {
+        if (levels[level_index].error * pixels_per_unit > error_threshold) {
+            break;
+        }
+
+        selected_level = level_index + 1;
+    }
+
+    return selected_level;
+}
+
+void MeshLod::update(size_t level_index, float delta_time)
+{
+    if (level_index != current_level) {
+        previous_level = current_level;
+        current_level = level_index;
+        fade_progress = (cross_fade_duration > 0.f ? 0.f : 1.f);
+        return;
+    }
+
+    if (fade_progress < 1.f) {
+        fade_progress = std::min(fade_progress + delta_time / cross_fade_duration, 1.f);
+    }
+}
+
+void MeshLod::draw(size_t level_index, MeshRenderer const& mesh_renderer) const
+{
+    ZoneScopedN("MeshLod::draw");
+    TracyGpuZone("MeshLod::draw");
+
+    Log::rt_assert(
+        level_index > 0 && level_index <= levels.size(), "Error: The level index does not reference any existing level."
+    );
+
+    std::vector<SubmeshRenderer> const& base_submesh_renderers = mesh_renderer.get_submesh_renderers();
+    std::vector<Material> const& materials = mesh_renderer.get_materials();
+
+    for (size_t submesh_index = 0; submesh_index < levels[level_index - 1].submesh_renderers.size(); ++submesh_index) {
+        // Submeshes share the material of their original counterpart
+        size_t const material_index = (submesh_index < base_submesh_renderers.size() ?
+                                           base_submesh_renderers[submesh_index].get_material_index() :
+                                           std::numeric_limits<size_t>::max());
+
+        if (material_index < materials.size()) {
+            materials[material_index].get_program().bind_textures();
+        }
+
+        levels[level_index - 1].submesh_renderers[submesh_index].draw();
+    }
+}
+}
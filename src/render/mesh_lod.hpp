@@ -0,0 +1,98 @@
+#pragma once
+
+#include <component.hpp>
+#include <data/mesh_simplifier.hpp>
+#include <render/submesh_renderer.hpp>
+
+namespace xen {
+class MeshRenderer;
+
+/// Simplified version of a mesh renderer's geometry, drawn in its place when far enough.
+struct MeshLodLevel {
+    std::vector<SubmeshRenderer> submesh_renderers;
+    float error; ///< Maximum deviation from the original surface, in the mesh's local space units.
+};
+
+/// Discrete levels of detail of an entity's MeshRenderer. The level drawn is the least detailed one whose geometric
+/// error, once projected on screen, stays below a threshold in pixels; the MeshRenderer itself is the level 0.
+/// Levels can optionally be cross-faded when switching, both being drawn with complementary dithering patterns.
+/// \see MeshSimplifier, MeshLodCache
+class MeshLod final : public Component {
+public:
+    MeshLod() = default;
+
+    /// Creates the levels of detail from simplified meshes.
+    /// \param levels Simplified meshes, from the most to the least detailed. Their submeshes must match the entity's
+    ///   MeshRenderer ones, whose materials they use.
+    /// \param vertex_format Layout of the levels' vertices in the graphics card's memory.
+    explicit MeshLod(
+        std::vector<MeshSimplifier::Level> const& levels, VertexFormat vertex_format = VertexFormat::FULL
+    );
+
+    MeshLod(MeshLod const&) = delete;
+    MeshLod(MeshLod&&) noexcept = default;
+
+    MeshLod& operator=(MeshLod const&) = delete;
+    MeshLod& operator=(MeshLod&&) noexcept = default;
+
+    [[nodiscard]] std::vector<MeshLodLevel> const& get_levels() const { return levels; }
+
+    /// Gets the total number of levels, including the full-detail one.
+    /// \return Number of levels.
+    [[nodiscard]] size_t get_level_count() const { return levels.size() + 1; }
+
+    [[nodiscard]] VertexFormat get_vertex_format() const { return vertex_format; }
+
+    [[nodiscard]] float get_error_threshold() const { return error_threshold; }
+
+    [[nodiscard]] float get_cross_fade_duration() const { return cross_fade_duration; }
+
+    [[nodiscard]] size_t get_current_level() const { return current_level; }
+
+    [[nodiscard]] size_t get_previous_level() const { return previous_level; }
+
+    [[nodiscard]] bool is_cross_fading() const { return (fade_progress < 1.f); }
+
+    /// Gets the cross-fade progression.
+    /// \return Progression of the fade from the previous to the current level, in [0; 1]; 1 if not fading.
+    [[nodiscard]] float get_fade_progress() const { return fade_progress; }
+
+    /// Sets the maximum projected error allowed, in pixels.
+    /// \param error_threshold Error threshold; the higher, the sooner less detailed levels are used.
+    void set_error_threshold(float error_threshold) { this->error_threshold = error_threshold; }
+
+    /// Sets the duration of the cross-fade between levels.
+    /// \param cross_fade_duration Fade duration in seconds; 0 to switch immediately.
+    void set_cross_fade_duration(float cross_fade_duration) { this->cross_fade_duration = cross_fade_duration; }
+
+    /// Adds a level, less detailed than the previous ones.
+    /// \param mesh Simplified mesh to be loaded.
+    /// \param error Maximum deviation of the simplified mesh from the original surface.
+    void add_level(Mesh const& mesh, float error);
+
+    /// Selects the level to be drawn.
+    /// \param pixels_per_unit Number of pixels covered by a world unit at the object's position.
+    /// \return Index of the least detailed level whose projected error stays below the threshold.
+    [[nodiscard]] size_t select_level(float pixels_per_unit) const;
+
+    /// Switches to the given level, starting a cross-fade if enabled, & advances the current one.
+    /// \param level_index Index of the level to be drawn.
+    /// \param delta_time Time elapsed since the last update, in seconds.
+    void update(size_t level_index, float delta_time);
+
+    /// Draws a simplified level.
+    /// \param level_index Index of the level to be drawn; must be strictly positive, level 0 being the MeshRenderer.
+    /// \param mesh_renderer Mesh renderer whose materials are used.
+    void draw(size_t level_index, MeshRenderer const& mesh_renderer) const;
+
+private:
+    std::vector<MeshLodLevel> levels{};
+    VertexFormat vertex_format = VertexFormat::FULL;
+    float error_threshold = 1.f;
+    float cross_fade_duration = 0.f;
+
+    size_t current_level = 0;
+    size_t previous_level = 0;
+    float fade_progress = 1.f;
+};
+}
@@ -43,6 +43,22 @@ public:
     void disable() { enable(false); }
 
     void set_render_mode(RenderMode render_mode, Mesh const& mesh) { m_data->load(mesh, render_mode); }
+
+    [[nodiscard]] VertexFormat get_vertex_format() const { return m_data->get_vertex_format(); }
+
+    /// Changes the layout of the vertices in the graphics card's memory, reloading the mesh with it.
+    /// \param vertex_format Vertex format to be applied.
+    /// \param mesh Mesh to load the vertices from.
+    void set_vertex_format(VertexFormat vertex_format, Mesh const& mesh)
+    {
+        std::vector<SubmeshRenderer> const& submesh_renderers = m_data->get_submesh_renderers();
+        RenderMode const render_mode =
+            (submesh_renderers.empty() ? RenderMode::TRIANGLE : submesh_renderers.front().get_render_mode());
+
+        m_data->set_vertex_format(vertex_format);
+        m_data->load(mesh, render_mode);
+    }
+
     Material& set_material(Material&& material) { return m_data->set_material(std::move(material)); }
     Material& add_material(Material&& material = Material()) { return m_data->add_material(std::move(material)); }
     void remove_material(size_t material_index) { m_data->remove_material(material_index); }
@@ -53,6 +69,9 @@ public:
         return m_data->add_submesh_renderer(std::forward<Args>(args)...);
     }
 
+    [[nodiscard]] bool has_bounding_box() const { return (m_data && m_data->has_bounding_box()); }
+    [[nodiscard]] AABB const& get_bounding_box() const { return m_data->get_bounding_box(); }
+
     [[nodiscard]] bool is_skip_depth() const { return m_data->skip_depth; }
     void set_skip_depth(bool value) { m_data->skip_depth = value; }
 
@@ -63,7 +63,29 @@ void MeshRendererData::load(Mesh const& mesh, RenderMode render_mode)
     submesh_renderers.resize(mesh.get_submeshes().size());
 
     for (size_t submesh_index = 0; submesh_index < mesh.get_submeshes().size(); ++submesh_index) {
-        submesh_renderers[submesh_index].load(mesh.get_submeshes()[submesh_index], render_mode);
+        submesh_renderers[submesh_index].load(mesh.get_submeshes()[submesh_index], render_mode, vertex_format);
+    }
+
+    // The mesh's bounding box may not have been computed; it is recovered from the vertices to be used for culling
+    Vector3f min_pos(std::numeric_limits<float>::max());
+    Vector3f max_pos(std::numeric_limits<float>::lowest());
+
+    for (Submesh const& submesh : mesh.get_submeshes()) {
+        for (Vertex const& vertex : submesh.get_vertices()) {
+            min_pos.x = std::min(min_pos.x, vertex.position.x);
+            min_pos.y = std::min(min_pos.y, vertex.position.y);
+            min_pos.z = std::min(min_pos.z, vertex.position.z);
+
+            max_pos.x = std::max(max_pos.x, vertex.position.x);
+            max_pos.y = std::max(max_pos.y, vertex.position.y);
+            max_pos.z = std::max(max_pos.z, vertex.position.z);
+        }
+    }
+
+    has_bounds = (min_pos.x <= max_pos.x);
+
+    if (has_bounds) {
+        bounding_box = AABB(min_pos, max_pos);
     }
 
     // If no material exists, create a default one
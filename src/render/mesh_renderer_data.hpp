@@ -26,6 +26,29 @@ public:
     [[nodiscard]] std::vector<Material> const& get_materials() const { return materials; }
     [[nodiscard]] std::vector<Material>& get_materials() { return materials; }
 
+    /// Checks if a bounding box is available, which is the case once a mesh has been loaded.
+    /// \return True if the bounding box can be used, false otherwise.
+    [[nodiscard]] bool has_bounding_box() const { return has_bounds; }
+
+    /// Gets the bounding box of the loaded mesh, expressed in the mesh's local space.
+    /// \return Local bounding box.
+    [[nodiscard]] AABB const& get_bounding_box() const { return bounding_box; }
+
+    /// Sets the bounding box of the loaded geometry, which must be done if the submesh renderers have been loaded
+    ///   directly instead of from a mesh.
+    /// \param bounding_box Local bounding box.
+    void set_bounding_box(AABB const& bounding_box)
+    {
+        this->bounding_box = bounding_box;
+        has_bounds = true;
+    }
+
+    [[nodiscard]] VertexFormat get_vertex_format() const { return vertex_format; }
+
+    /// Sets the layout of the vertices in the graphics card's memory, used by the next load() call.
+    /// \param vertex_format Vertex format to be applied.
+    void set_vertex_format(VertexFormat vertex_format) { this->vertex_format = vertex_format; }
+
     template <typename... Args>
     SubmeshRenderer& add_submesh_renderer(Args&&... args)
     {
@@ -45,5 +68,8 @@ public:
 private:
     std::vector<SubmeshRenderer> submesh_renderers;
     std::vector<Material> materials;
+    AABB bounding_box = AABB(Vector3f(0.f), Vector3f(0.f));
+    bool has_bounds = false;
+    VertexFormat vertex_format = VertexFormat::FULL;
 };
 }
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "occlusion_culler.hpp"
+
+#include <data/mesh.hpp>
+#include <render/renderer.hpp>
+#include <render/texture.hpp>
+
+#include <tracy/Tracy.hpp>
+#include <GL/glew.h> // Needed by TracyOpenGL.hpp
+#include <tracy/TracyOpenGL.hpp>
+
+#include <bit>
+
+namespace {
+#if !defined(USE_OPENGL_ES)
+constexpr std::string_view hiz_downsample_source = {
+#include "hiz_downsample.comp.embed"
+};
+
+constexpr std::string_view hiz_cull_source = {
+#include "hiz_cull.comp.embed"
+};
+#endif
+}
+
+namespace xen {
+OcclusionCuller::~OcclusionCuller()
+{
+#if !defined(USE_OPENGL_ES)
+    if (box_buffer.is_valid()) {
+        Renderer::delete_buffer(box_buffer);
+    }
+
+    if (visibility_buffer.is_valid()) {
+        Renderer::delete_buffer(visibility_buffer);
+    }
+#endif
+}
+
+bool OcclusionCuller::is_gpu_culling_supported()
+{
+#if !defined(USE_OPENGL_ES)
+    return Renderer::check_version(4, 3);
+#else
+    return false;
+#endif
+}
+
+void OcclusionCuller::enable(bool enabled)
+{
+    this->enabled = enabled;
+
+    if (!enabled) {
+        candidate_entities.clear();
+        candidate_boxes.clear();
+        tested_entities.clear();
+        occluded_entities.clear();
+        occluders.clear();
+#if !defined(USE_OPENGL_ES)
+        has_pending_results = false;
+#endif
+    }
+}
+
+bool OcclusionCuller::is_occluded(Entity const& entity) const
+{
+    return (enabled && occluded_entities.find(&entity) != occluded_entities.cend());
+}
+
+void OcclusionCuller::begin_frame()
+{
+    candidate_entities.clear();
+    candidate_boxes.clear();
+    occluders.clear();
+
+#if !defined(USE_OPENGL_ES)
+    if (!has_pending_results) {
+        return;
+    }
+
+    ZoneScopedN("OcclusionCuller::begin_frame");
+
+    // The results have been computed during the previous frame; the GPU has most likely finished by now, which avoids
+    // stalling when reading them back
+    visibilities.resize(tested_entities.size());
+
+    Renderer::bind_buffer(BufferType::SHADER_STORAGE_BUFFER, visibility_buffer);
+    Renderer::recover_buffer_sub_data(
+        BufferType::SHADER_STORAGE_BUFFER, 0, static_cast<std::ptrdiff_t>(visibilities.size() * sizeof(uint32_t)),
+        visibilities.data()
+    );
+    Renderer::unbind_buffer(BufferType::SHADER_STORAGE_BUFFER);
+
+    occluded_entities.clear();
+
+    for (size_t entity_index = 0; entity_index < tested_entities.size(); ++entity_index) {
+        if (visibilities[entity_index] == 0) {
+            occluded_entities.emplace(tested_entities[entity_index]);
+        }
+    }
+
+    has_pending_results = false;
+#endif
+}
+
+void OcclusionCuller::add_candidate(Entity const& entity, AABB const& bounding_box)
+{
+    if (!enabled) {
+        return;
+    }
+
+    candidate_entities.emplace_back(&entity);
+    candidate_boxes.emplace_back(bounding_box.get_min_position(), 1.f);
+    candidate_boxes.emplace_back(bounding_box.get_max_position(), 1.f);
+}
+
+void OcclusionCuller::add_occluder(Mesh const& mesh, Matrix4 const& transform)
+{
+    if (!enabled) {
+        return;
+    }
+
+    occluders.emplace_back(&mesh, transform);
+}
+
+void OcclusionCuller::execute(Texture2D const* depth_buffer, Matrix4 const& view_projection)
+{
+    if (!enabled) {
+        return;
+    }
+
+    ZoneScopedN("OcclusionCuller::execute");
+
+#if !defined(USE_OPENGL_ES)
+    if (depth_buffer != nullptr && !is_software_forced && is_gpu_culling_supported()) {
+        execute_gpu(*depth_buffer, view_projection);
+        return;
+    }
+#endif
+
+    execute_software(view_projection);
+}
+
+void OcclusionCuller::execute_software(Matrix4 const& view_projection)
+{
+    ZoneScopedN("OcclusionCuller::execute_software");
+
+    software_buffer.clear();
+    software_buffer.set_view_projection(view_projection);
+
+    for (auto const& [mesh, transform] : occluders) {
+        software_buffer.rasterize_mesh(*mesh, transform);
+    }
+
+    occluded_entities.clear();
+
+    for (size_t entity_index = 0; entity_index < candidate_entities.size(); ++entity_index) {
+        AABB const bounding_box(
+            Vector3f(candidate_boxes[entity_index * 2]), Vector3f(candidate_boxes[entity_index * 2 + 1])
+        );
+
+        if (!software_buffer.is_visible(bounding_box)) {
+            occluded_entities.emplace(candidate_entities[entity_index]);
+        }
+    }
+
+    occluders.clear();
+}
+
+#if !defined(USE_OPENGL_ES)
+void OcclusionCuller::execute_gpu(Texture2D const& depth_buffer, Matrix4 const& view_projection)
+{
+    ZoneScopedN("OcclusionCuller::execute_gpu");
+    TracyGpuZone("Occlusion culling")
+
+        build_depth_pyramid(depth_buffer);
+
+    tested_entities.swap(candidate_entities);
+    occluders.clear();
+
+    if (tested_entities.empty()) {
+        occluded_entities.clear();
+        return;
+    }
+
+    if (!cull_program) {
+        cull_program.emplace(ComputeShader::load_from_source(hiz_cull_source));
+    }
+
+    if (!box_buffer.is_valid()) {
+        Renderer::generate_buffer(box_buffer);
+        Renderer::generate_buffer(visibility_buffer);
+    }
+
+    // The buffers are reallocated each frame, letting the driver orphan the previous storage instead of waiting for it
+    Renderer::bind_buffer(BufferType::SHADER_STORAGE_BUFFER, box_buffer);
+    Renderer::send_buffer_data(
+        BufferType::SHADER_STORAGE_BUFFER, static_cast<std::ptrdiff_t>(candidate_boxes.size() * sizeof(Vector4f)),
+        candidate_boxes.data(), BufferDataUsage::STREAM_DRAW
+    );
+    Renderer::bind_buffer(BufferType::SHADER_STORAGE_BUFFER, visibility_buffer);
+    Renderer::send_buffer_data(
+        BufferType::SHADER_STORAGE_BUFFER, static_cast<std::ptrdiff_t>(tested_entities.size() * sizeof(uint32_t)),
+        nullptr, BufferDataUsage::STREAM_READ
+    );
+    Renderer::unbind_buffer(BufferType::SHADER_STORAGE_BUFFER);
+
+    Renderer::bind_buffer_base(BufferType::SHADER_STORAGE_BUFFER, 0, box_buffer);
+    Renderer::bind_buffer_base(BufferType::SHADER_STORAGE_BUFFER, 1, visibility_buffer);
+
+    cull_program->use();
+    cull_program->send_uniform("uniDepthPyramid", 0);
+    cull_program->send_uniform("uniViewProjection", view_projection);
+    cull_program->send_uniform("uniBoxCount", static_cast<uint32_t>(tested_entities.size()));
+
+    Renderer::activate_texture(0);
+    depth_pyramid->bind();
+
+    Renderer::dispatch_compute(Vector3ui((static_cast<uint32_t>(tested_entities.size()) + 63) / 64, 1, 1));
+    Renderer::set_memory_barrier(BarrierType::SHADER_STORAGE | BarrierType::BUFFER_UPDATE);
+
+    depth_pyramid->unbind();
+
+    has_pending_results = true;
+}
+
+void OcclusionCuller::build_depth_pyramid(Texture2D const& depth_buffer)
+{
+    ZoneScopedN("OcclusionCuller::build_depth_pyramid");
+
+    Vector2ui const size = depth_buffer.get_size();
+    auto const level_count =
+        static_cast<uint32_t>(std::numeric_limits<uint32_t>::digits - std::countl_zero(std::max(size.x, size.y)));
+
+    if (depth_pyramid == nullptr || depth_pyramid->get_size() != size) {
+        depth_pyramid = Texture2D::create(size, TextureColorspace::GRAY, TextureDataType::FLOAT32);
+
+        depth_pyramid->bind();
+
+        for (uint32_t level = 1; level < level_count; ++level) {
+            Renderer::send_image_data_2d(
+                TextureType::TEXTURE_2D, level, TextureInternalFormat::R32F,
+                Vector2ui(std::max(size.x >> level, 1u), std::max(size.y >> level, 1u)), TextureFormat::RED,
+                PixelDataType::FLOAT, nullptr
+            );
+        }
+
+        depth_pyramid->unbind();
+        depth_pyramid->set_filter(TextureFilter::NEAREST, TextureFilter::NEAREST, TextureFilter::NEAREST);
+    }
+
+    if (!downsample_program) {
+        downsample_program.emplace(ComputeShader::load_from_source(hiz_downsample_source));
+    }
+
+    downsample_program->use();
+    downsample_program->send_uniform("uniSourceDepth", 0);
+    Renderer::activate_texture(0);
+
+    for (uint32_t level = 0; level < level_count; ++level) {
+        Vector2ui const level_size(std::max(size.x >> level, 1u), std::max(size.y >> level, 1u));
+
+        // The first level is copied from the depth buffer, each following one being reduced from the previous
+        if (level == 0) {
+            depth_buffer.bind();
+        }
+        else {
+            depth_pyramid->bind();
+        }
+
+        downsample_program->send_uniform("uniSourceLevel", static_cast<int>(level == 0 ? 0 : level - 1));
+        Renderer::bind_image_texture(
+            0, depth_pyramid->get_index(), static_cast<int>(level), false, 0, ImageAccess::WRITE,
+            ImageInternalFormat::R32F
+        );
+
+        Renderer::dispatch_compute(Vector3ui((level_size.x + 7) / 8, (level_size.y + 7) / 8, 1));
+        Renderer::set_memory_barrier(BarrierType::SHADER_IMAGE_ACCESS | BarrierType::TEXTURE_FETCH);
+    }
+
+    depth_pyramid->unbind();
+}
+#endif
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <data/owner_value.hpp>
+#include <render/software_occlusion_buffer.hpp>
+#include <render/shader/shader_program.hpp>
+
+namespace xen {
+class Entity;
+class Mesh;
+
+/// Occlusion culler, hiding the entities which were entirely behind others in the previous frame.
+/// At the end of each geometry pass, the bounding boxes of all the entities that passed frustum culling are tested
+/// against the depth of the frame just rendered; the results are used to filter the next frame's draw list. Entities
+/// hidden this way are still tested every frame, so that they reappear as soon as they become visible again.
+/// With OpenGL 4.3+, the test is made on the GPU against a hierarchical depth buffer (Hi-Z) built from the geometry
+/// pass' depth buffer with a compute shader. Otherwise, the meshes of the drawn entities are rasterized on the CPU in a
+/// low-resolution software depth buffer.
+class OcclusionCuller {
+public:
+    OcclusionCuller() = default;
+    OcclusionCuller(OcclusionCuller const&) = delete;
+    OcclusionCuller(OcclusionCuller&&) noexcept = default;
+
+    OcclusionCuller& operator=(OcclusionCuller const&) = delete;
+    OcclusionCuller& operator=(OcclusionCuller&&) noexcept = default;
+
+    ~OcclusionCuller();
+
+    [[nodiscard]] bool is_enabled() const { return enabled; }
+
+    [[nodiscard]] SoftwareOcclusionBuffer const& get_software_buffer() const { return software_buffer; }
+
+    [[nodiscard]] SoftwareOcclusionBuffer& get_software_buffer() { return software_buffer; }
+
+    /// Gets the hierarchical depth buffer built during the last GPU culling pass.
+    /// \return Depth pyramid texture, each mipmap level holding the farthest depth of the 2x2 texels of the previous; may
+    ///   be null if the GPU path has not been used.
+    [[nodiscard]] Texture2DPtr const& get_depth_pyramid() const { return depth_pyramid; }
+
+    /// Gets the number of entities found occluded, which will be skipped during the current frame.
+    /// \return Number of occluded entities.
+    [[nodiscard]] size_t get_occluded_count() const { return occluded_entities.size(); }
+
+    /// Checks if the GPU path can be used, which requires compute shaders & shader storage buffers.
+    /// \return True if the occlusion can be tested on the GPU, false if the software fallback must be used.
+    [[nodiscard]] static bool is_gpu_culling_supported();
+
+    /// Enables or disables occlusion culling. While disabled, no entity is considered occluded.
+    /// \param enabled True to enable occlusion culling, false otherwise.
+    void enable(bool enabled = true);
+
+    void disable() { enable(false); }
+
+    /// Forces the use of the software fallback, even if the GPU path is supported.
+    /// \param force_software True to always rasterize the occluders on the CPU, false to use the GPU when possible.
+    void force_software(bool force_software = true) { is_software_forced = force_software; }
+
+    /// Checks if an entity has been found entirely occluded during the previous frame.
+    /// \param entity Entity to be checked.
+    /// \return True if the entity can be skipped, false otherwise.
+    [[nodiscard]] bool is_occluded(Entity const& entity) const;
+
+    /// Starts a new frame, recovering the results of the previous one's culling pass if any is pending.
+    void begin_frame();
+
+    /// Adds an entity to be tested at the end of the frame.
+    /// \param entity Entity to be tested.
+    /// \param bounding_box World-space bounding box of the entity.
+    void add_candidate(Entity const& entity, AABB const& bounding_box);
+
+    /// Adds a mesh to be rasterized as an occluder. Only used by the software fallback.
+    /// \param mesh Mesh to be rasterized; must remain valid until the culling pass is executed.
+    /// \param transform Transformation matrix to bring the mesh in world space.
+    void add_occluder(Mesh const& mesh, Matrix4 const& transform);
+
+    /// Tests all the candidates added during the current frame, to be used by the next one.
+    /// \param depth_buffer Depth buffer of the frame's geometry pass; if null, the software fallback is used.
+    /// \param view_projection View-projection matrix with which the frame has been rendered.
+    void execute(Texture2D const* depth_buffer, Matrix4 const& view_projection);
+
+private:
+    bool enabled = false;
+    bool is_software_forced = false;
+
+    std::vector<Entity const*> candidate_entities{};
+    std::vector<Vector4f> candidate_boxes{}; ///< Minimum & maximum positions of each candidate, padded for std430.
+    std::vector<Entity const*> tested_entities{};
+    std::unordered_set<Entity const*> occluded_entities{};
+
+    SoftwareOcclusionBuffer software_buffer{};
+    std::vector<std::pair<Mesh const*, Matrix4>> occluders{};
+
+    Texture2DPtr depth_pyramid{};
+#if !defined(USE_OPENGL_ES)
+    std::optional<ComputeShaderProgram> downsample_program{};
+    std::optional<ComputeShaderProgram> cull_program{};
+    OwnerValue<uint32_t> box_buffer{};
+    OwnerValue<uint32_t> visibility_buffer{};
+    std::vector<uint32_t> visibilities{};
+    bool has_pending_results = false;
+#endif
+
+private:
+    void execute_software(Matrix4 const& view_projection);
+
+#if !defined(USE_OPENGL_ES)
+    void execute_gpu(Texture2D const& depth_buffer, Matrix4 const& view_projection);
+
+    void build_depth_pyramid(Texture2D const& depth_buffer);
+#endif
+};
+}
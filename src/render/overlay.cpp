@@ -196,6 +196,15 @@ OverlayPlotEntry& OverlayPlot::add_entry(std::string name, OverlayPlotType type)
     );
 }
 
+OverlayPlotEntry* OverlayPlot::find_entry(std::string_view name)
+{
+    auto const entry_it = std::ranges::find_if(entries, [name](std::unique_ptr<OverlayPlotEntry> const& entry) {
+        return (entry->name == name);
+    });
+
+    return (entry_it != entries.cend() ? entry_it->get() : nullptr);
+}
+
 OverlayWindow::OverlayWindow(std::string title, Vector2f const& init_size, Vector2f const& init_pos) :
     title{std::move(title)}, current_size{init_size}, current_pos{init_pos}
 {
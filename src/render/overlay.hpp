@@ -405,6 +405,11 @@ public:
 
     OverlayPlotEntry& add_entry(std::string name, OverlayPlotType type = OverlayPlotType::LINE);
 
+    /// Finds an entry of the plot from its name.
+    /// \param name Name of the entry to be found.
+    /// \return Pointer to the entry if found, nullptr otherwise.
+    [[nodiscard]] OverlayPlotEntry* find_entry(std::string_view name);
+
 private:
     std::vector<std::unique_ptr<OverlayPlotEntry>> entries{};
     size_t max_value_count{};
@@ -40,6 +40,11 @@ public:
         return *color_buffers[buffer_index].first;
     }
 
+    [[nodiscard]] std::vector<std::pair<Texture2DPtr, uint32_t>> const& get_color_buffers() const
+    {
+        return color_buffers;
+    }
+
     /// Gives a basic vertex shader, to display the framebuffer.
     /// \return Basic display vertex shader.
     static VertexShader recover_vertex_shader();
@@ -115,6 +115,142 @@ constexpr std::string_view final_source = R"(
     fragColor = vec4(originalColor + blurredColor, 1.0);
   }
 )";
+
+#if !defined(USE_OPENGL_ES)
+// The shader writes exactly 5 downscaled buffers, each work group covering a tile of 32x32 pixels of the first one &
+//  thus 2x2 pixels of the last one
+static_assert(pass_count == 5, "Error: The downscale chain shader must write as many buffers as there are passes.");
+
+constexpr std::string_view downscale_chain_source = R"(
+  layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
+
+  layout(binding = 0) uniform writeonly restrict image2D uniDownscaledBuffer0;
+  layout(binding = 1) uniform writeonly restrict image2D uniDownscaledBuffer1;
+  layout(binding = 2) uniform writeonly restrict image2D uniDownscaledBuffer2;
+  layout(binding = 3) uniform writeonly restrict image2D uniDownscaledBuffer3;
+  layout(binding = 4) uniform writeonly restrict image2D uniDownscaledBuffer4;
+  uniform sampler2D uniThresholdBuffer;
+
+  const vec2 kernelOffsets[13] = vec2[](
+    vec2(-1.0,  1.0), vec2(1.0,  1.0),
+    vec2(-1.0, -1.0), vec2(1.0, -1.0),
+
+    vec2(-2.0,  2.0), vec2(0.0,  2.0), vec2(2.0,  2.0),
+    vec2(-2.0,  0.0), vec2(0.0,  0.0), vec2(2.0,  0.0),
+    vec2(-2.0, -2.0), vec2(0.0, -2.0), vec2(2.0, -2.0)
+  );
+
+  const float kernelWeights[13] = float[](
+    // 4 inner samples: (1 / 4) * 0.5
+    0.125, 0.125,
+    0.125, 0.125,
+
+    // 1 middle & 8 outer samples: (1 / 9) * 0.5
+    0.0555555, 0.0555555, 0.0555555,
+    0.0555555, 0.0555555, 0.0555555,
+    0.0555555, 0.0555555, 0.0555555
+  );
+
+  shared vec3 tileColors[32][32];
+
+  #define STORE_COLOR(image) if (all(lessThan(coords, imageSize(image)))) imageStore(image, coords, vec4(color, 1.0))
+
+  void storeColor(int level, ivec2 coords, vec3 color) {
+    switch (level) {
+      case 0: STORE_COLOR(uniDownscaledBuffer0); break;
+      case 1: STORE_COLOR(uniDownscaledBuffer1); break;
+      case 2: STORE_COLOR(uniDownscaledBuffer2); break;
+      case 3: STORE_COLOR(uniDownscaledBuffer3); break;
+      default: STORE_COLOR(uniDownscaledBuffer4); break;
+    }
+  }
+
+  void main() {
+    ivec2 localCoords = ivec2(gl_LocalInvocationID.xy);
+    ivec2 tileOrigin  = ivec2(gl_WorkGroupID.xy) * 32;
+    vec2 invBufferSize = 1.0 / vec2(imageSize(uniDownscaledBuffer0));
+
+    // Each invocation computes 2x2 pixels of the first level with the same filter as the fragment downscaling
+    for (int y = 0; y < 2; ++y) {
+      for (int x = 0; x < 2; ++x) {
+        ivec2 tileCoords = localCoords * 2 + ivec2(x, y);
+        vec2 fragCoords  = vec2(tileOrigin + tileCoords) + 0.5;
+        vec3 color       = vec3(0.0);
+
+        for (int i = 0; i < 13; ++i)
+          color += textureLod(uniThresholdBuffer, (fragCoords + kernelOffsets[i]) * invBufferSize, 0.0).rgb * kernelWeights[i];
+
+        tileColors[tileCoords.y][tileCoords.x] = color;
+        storeColor(0, tileOrigin + tileCoords, color);
+      }
+    }
+
+    memoryBarrierShared();
+    barrier();
+
+    // Each following level is reduced from the previous one, which stays in shared memory
+    for (int level = 1; level < 5; ++level) {
+      bool isActive = all(lessThan(localCoords, ivec2(32 >> level)));
+      vec3 color    = vec3(0.0);
+
+      if (isActive) {
+        ivec2 prevCoords = localCoords * 2;
+        color = (tileColors[prevCoords.y][prevCoords.x]     + tileColors[prevCoords.y][prevCoords.x + 1] +
+                 tileColors[prevCoords.y + 1][prevCoords.x] + tileColors[prevCoords.y + 1][prevCoords.x + 1]) * 0.25;
+      }
+
+      memoryBarrierShared();
+      barrier();
+
+      if (isActive) {
+        tileColors[localCoords.y][localCoords.x] = color;
+        storeColor(level, (tileOrigin >> level) + localCoords, color);
+      }
+
+      memoryBarrierShared();
+      barrier();
+    }
+  }
+)";
+
+constexpr std::string_view upscale_compute_source = R"(
+  layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+  layout(binding = 0) uniform writeonly restrict image2D uniOutput;
+  uniform sampler2D uniDownscaledBuffer;
+  uniform sampler2D uniPrevUpscaledBuffer;
+  uniform vec2 uniInvBufferSize;
+
+  const vec2 kernelOffsets[9] = vec2[](
+      vec2(-1.0,  1.0), vec2(0.0,  1.0), vec2(1.0,  1.0),
+      vec2(-1.0,  0.0), vec2(0.0,  0.0), vec2(1.0,  0.0),
+      vec2(-1.0, -1.0), vec2(0.0, -1.0), vec2(1.0, -1.0)
+  );
+
+  const float kernelWeights[9] = float[](
+      0.0625, 0.125, 0.0625,
+      0.125,  0.25,  0.125,
+      0.0625, 0.125, 0.0625
+  );
+
+  void main() {
+    ivec2 destCoords = ivec2(gl_GlobalInvocationID.xy);
+
+    if (any(greaterThanEqual(destCoords, imageSize(uniOutput))))
+      return;
+
+    // The taps are bilinearly filtered at non-integer positions of the previous buffer, which the texture cache serves
+    //  better than shared memory would
+    vec2 fragCoords = vec2(destCoords) + 0.5;
+    vec3 color      = textureLod(uniDownscaledBuffer, fragCoords * uniInvBufferSize, 0.0).rgb;
+
+    for (int i = 0; i < 9; ++i)
+      color += textureLod(uniPrevUpscaledBuffer, (fragCoords + kernelOffsets[i]) * uniInvBufferSize, 0.0).rgb * kernelWeights[i];
+
+    imageStore(uniOutput, destCoords, vec4(color, 1.0));
+  }
+)";
+#endif
 }
 
 namespace xen {
@@ -127,8 +263,10 @@ Bloom::Bloom(RenderGraph& render_graph) : RenderProcess(render_graph)
     set_threshold_value(0.75f
     ); // Tone mapping is applied before the bloom, thus no value above 1 exist here. This value will be changed later
 
-    auto const threshold_buffer = Texture2D::create(TextureColorspace::RGB, TextureDataType::FLOAT16);
-    threshold_pass->add_write_color_texture(threshold_buffer, 0);
+    // The intermediate buffers are only used within the process; their storage is provided by the render graph, which
+    //  shares it with other transient textures that are not in use at the same time
+    threshold_buffer = render_graph.create_transient_texture(TextureColorspace::RGB, TextureDataType::FLOAT16);
+    render_graph.add_transient_write_texture(*threshold_pass, threshold_buffer, 0);
 
 #if !defined(USE_OPENGL_ES)
     if (Renderer::check_version(4, 3)) {
@@ -146,7 +284,6 @@ Bloom::Bloom(RenderGraph& render_graph) : RenderProcess(render_graph)
         Renderer::set_label(
             RenderObjectType::FRAMEBUFFER, threshold_pass->get_framebuffer().get_index(), "Bloom threshold framebuffer"
         );
-        Renderer::set_label(RenderObjectType::TEXTURE, threshold_buffer->get_index(), "Bloom threshold buffer");
     }
 #endif
 
@@ -173,13 +310,15 @@ Bloom::Bloom(RenderGraph& render_graph) : RenderProcess(render_graph)
         //      v prevDownscaledBuffer
         //     ...
 
-        downscale_pass.add_read_texture(
-            (downscale_pass_index == 0 ? threshold_buffer : downscale_buffers[downscale_pass_index - 1].lock()),
+        render_graph.add_transient_read_texture(
+            downscale_pass,
+            (downscale_pass_index == 0 ? threshold_buffer : downscale_buffers[downscale_pass_index - 1]),
             "uniPrevDownscaledBuffer"
         );
 
-        auto const downscaled_buffer = Texture2D::create(TextureColorspace::RGB, TextureDataType::FLOAT16);
-        downscale_pass.add_write_color_texture(downscaled_buffer, 0);
+        TransientTextureId const downscaled_buffer =
+            render_graph.create_transient_texture(TextureColorspace::RGB, TextureDataType::FLOAT16);
+        render_graph.add_transient_write_texture(downscale_pass, downscaled_buffer, 0);
 
         downscale_passes[downscale_pass_index] = &downscale_pass;
         downscale_buffers[downscale_pass_index] = downscaled_buffer;
@@ -206,9 +345,6 @@ Bloom::Bloom(RenderGraph& render_graph) : RenderProcess(render_graph)
                 RenderObjectType::FRAMEBUFFER, downscale_pass.get_framebuffer().get_index(),
                 "Bloom downscale framebuffer #" + id_str
             );
-            Renderer::set_label(
-                RenderObjectType::TEXTURE, downscaled_buffer->get_index(), "Bloom downscale buffer #" + id_str
-            );
         }
 #endif
     }
@@ -238,14 +374,18 @@ Bloom::Bloom(RenderGraph& render_graph) : RenderProcess(render_graph)
 
         auto const corresp_downscale_pass_index = pass_count - upscale_pass_index - 2;
 
-        upscale_pass.add_read_texture(downscale_buffers[corresp_downscale_pass_index].lock(), "uniDownscaledBuffer");
-        upscale_pass.add_read_texture(
-            (upscale_pass_index == 0 ? downscale_buffers.back() : upscale_buffers[upscale_pass_index - 1]).lock(),
+        render_graph.add_transient_read_texture(
+            upscale_pass, downscale_buffers[corresp_downscale_pass_index], "uniDownscaledBuffer"
+        );
+        render_graph.add_transient_read_texture(
+            upscale_pass,
+            (upscale_pass_index == 0 ? downscale_buffers.back() : upscale_buffers[upscale_pass_index - 1]),
             "uniPrevUpscaledBuffer"
         );
 
-        auto const upscaled_buffer = Texture2D::create(TextureColorspace::RGB, TextureDataType::FLOAT16);
-        upscale_pass.add_write_color_texture(upscaled_buffer, 0);
+        TransientTextureId const upscaled_buffer =
+            render_graph.create_transient_texture(TextureColorspace::RGB, TextureDataType::FLOAT16);
+        render_graph.add_transient_write_texture(upscale_pass, upscaled_buffer, 0);
 
         upscale_passes[upscale_pass_index] = &upscale_pass;
         upscale_buffers[upscale_pass_index] = upscaled_buffer;
@@ -278,9 +418,6 @@ Bloom::Bloom(RenderGraph& render_graph) : RenderProcess(render_graph)
                 RenderObjectType::FRAMEBUFFER, upscale_pass.get_framebuffer().get_index(),
                 "Bloom upscale framebuffer #" + id_str
             );
-            Renderer::set_label(
-                RenderObjectType::TEXTURE, upscaled_buffer->get_index(), "Bloom upscale buffer #" + id_str
-            );
         }
 #endif
     }
@@ -288,7 +425,7 @@ Bloom::Bloom(RenderGraph& render_graph) : RenderProcess(render_graph)
     final_pass = &render_graph.add_node(FragmentShader::load_from_source(final_source), "Bloom final pass");
 
     final_pass->add_parents(*upscale_passes.back());
-    final_pass->add_read_texture(upscale_buffers.back().lock(), "uniFinalUpscaledBuffer");
+    render_graph.add_transient_read_texture(*final_pass, upscale_buffers.back(), "uniFinalUpscaledBuffer");
 
 #if !defined(USE_OPENGL_ES)
     if (Renderer::check_version(4, 3)) {
@@ -320,8 +457,12 @@ void Bloom::set_state(bool const enabled)
 {
     threshold_pass->enable(enabled);
 
+    // Only the downscaling passes of the selected implementation are executed
     for (RenderPass* downscale_pass : downscale_passes)
-        downscale_pass->enable(enabled);
+        downscale_pass->enable(enabled && !compute_enabled);
+
+    if (downscale_chain_pass != nullptr)
+        downscale_chain_pass->enable(enabled && compute_enabled);
 
     for (RenderPass* upscale_pass : upscale_passes)
         upscale_pass->enable(enabled);
@@ -349,9 +490,19 @@ void Bloom::add_child(RenderProcess& child_process)
     child_process.add_parent(*final_pass);
 }
 
+Texture2D const& Bloom::get_downscale_buffer(size_t buffer_index) const
+{
+    return render_graph.get_transient_texture(downscale_buffers[buffer_index]);
+}
+
+Texture2D const& Bloom::get_upscale_buffer(size_t buffer_index) const
+{
+    return render_graph.get_transient_texture(upscale_buffers[buffer_index]);
+}
+
 void Bloom::resize_buffers(Vector2ui const& size)
 {
-    threshold_pass->resize_write_buffers(size);
+    render_graph.resize_transient_texture(threshold_buffer, size);
     final_pass->resize_write_buffers(size);
 
     auto const downscale_buffers_size = downscale_buffers.size();
@@ -365,10 +516,9 @@ void Bloom::resize_buffers(Vector2ui const& size)
             1.f / static_cast<float>(size_for_downscale.x), 1.f / static_cast<float>(size_for_downscale.y)
         );
 
-        downscale_passes[i]->resize_write_buffers(size_for_downscale);
+        render_graph.resize_transient_texture(downscale_buffers[i], size_for_downscale);
 
-        downscale_passes[i]->get_program().set_attribute(inv_buffer_size, "uniInvBufferSize");
-        downscale_passes[i]->get_program().send_attributes();
+        downscale_passes[i]->send_attribute(inv_buffer_size, "uniInvBufferSize");
 
         if (i >= upscale_passes_size) {
             break;
@@ -376,10 +526,9 @@ void Bloom::resize_buffers(Vector2ui const& size)
 
         auto const corresp_index = downscale_buffers_size - i - 2;
 
-        upscale_passes[corresp_index]->resize_write_buffers(size_for_downscale);
+        render_graph.resize_transient_texture(upscale_buffers[corresp_index], size_for_downscale);
 
-        upscale_passes[corresp_index]->get_program().set_attribute(inv_buffer_size, "uniInvBufferSize");
-        upscale_passes[corresp_index]->get_program().send_attributes();
+        upscale_passes[corresp_index]->send_attribute(inv_buffer_size, "uniInvBufferSize");
     }
 }
 
@@ -387,8 +536,13 @@ float Bloom::recover_elapsed_time() const
 {
     float time = threshold_pass->recover_elapsed_time() + final_pass->recover_elapsed_time();
 
-    for (RenderPass const* pass : downscale_passes) {
-        time += pass->recover_elapsed_time();
+    if (compute_enabled) {
+        time += downscale_chain_pass->recover_elapsed_time();
+    }
+    else {
+        for (RenderPass const* pass : downscale_passes) {
+            time += pass->recover_elapsed_time();
+        }
     }
 
     for (RenderPass const* pass : upscale_passes) {
@@ -398,6 +552,45 @@ float Bloom::recover_elapsed_time() const
     return time;
 }
 
+bool Bloom::has_compute_path() const
+{
+    return RenderPass::is_compute_supported();
+}
+
+void Bloom::set_compute_state(bool enabled)
+{
+#if !defined(USE_OPENGL_ES)
+    if (enabled && !RenderPass::is_compute_supported()) {
+        throw std::runtime_error("Error: Executing a render process with compute shaders requires OpenGL 4.3+");
+    }
+
+    if (enabled && downscale_chain_pass == nullptr) {
+        create_compute_passes();
+    }
+
+    compute_enabled = enabled;
+
+    for (RenderPass* upscale_pass : upscale_passes) {
+        upscale_pass->enable_compute(enabled);
+    }
+
+    // Images can only have 1, 2 or 4 channels; the buffers written by compute shaders need an alpha channel
+    TextureColorspace const colorspace = (enabled ? TextureColorspace::RGBA : TextureColorspace::RGB);
+
+    for (TransientTextureId const downscale_buffer : downscale_buffers) {
+        render_graph.set_transient_texture_format(downscale_buffer, colorspace, TextureDataType::FLOAT16);
+    }
+
+    for (TransientTextureId const upscale_buffer : upscale_buffers) {
+        render_graph.set_transient_texture_format(upscale_buffer, colorspace, TextureDataType::FLOAT16);
+    }
+
+    set_state(is_enabled());
+#else
+    RenderProcess::set_compute_state(enabled);
+#endif
+}
+
 void Bloom::set_input_color_buffer(Texture2DPtr color_buffer)
 {
     resize_buffers(color_buffer->get_size());
@@ -424,4 +617,63 @@ void Bloom::set_threshold_value(float const threshold) const
     threshold_pass->get_program().send_attributes();
 }
 
+void Bloom::create_compute_passes()
+{
+#if !defined(USE_OPENGL_ES)
+    // The pass' render program is never executed, the pass being only executed with compute shaders; it is only there
+    //  for the pass to have a valid program
+    downscale_chain_pass =
+        &render_graph.add_node(FragmentShader::load_from_source(downscale_source), "Bloom downscale chain");
+    downscale_chain_pass->set_compute_program(
+        ComputeShaderProgram(ComputeShader::load_from_source(downscale_chain_source)), Vector2ui(32)
+    );
+    downscale_chain_pass->enable_compute();
+
+    //      ----------
+    //      |        |
+    //      |   T    |
+    //      |        |
+    //      ----------
+    //          |
+    //          v thresholdBuffer
+    //  -----------------
+    //  | D0 D1 D2 ... |
+    //  -----------------
+    //          |
+    //          v downscaledBuffer
+    //         U0 ...
+
+    downscale_chain_pass->add_parents(*threshold_pass);
+    render_graph.add_transient_read_texture(*downscale_chain_pass, threshold_buffer, "uniThresholdBuffer");
+
+    for (size_t buffer_index = 0; buffer_index < downscale_buffers.size(); ++buffer_index) {
+        render_graph.add_transient_write_texture(
+            *downscale_chain_pass, downscale_buffers[buffer_index], static_cast<uint32_t>(buffer_index)
+        );
+    }
+
+    upscale_passes.front()->add_parents(*downscale_chain_pass);
+
+    for (RenderPass* upscale_pass : upscale_passes) {
+        upscale_pass->set_compute_program(
+            ComputeShaderProgram(ComputeShader::load_from_source(upscale_compute_source)), Vector2ui(8)
+        );
+    }
+
+    if (Renderer::check_version(4, 3)) {
+        Renderer::set_label(
+            RenderObjectType::PROGRAM, downscale_chain_pass->get_compute_program().get_index(),
+            "Bloom downscale chain compute program"
+        );
+
+        for (size_t upscale_pass_index = 0; upscale_pass_index < upscale_passes.size(); ++upscale_pass_index) {
+            Renderer::set_label(
+                RenderObjectType::PROGRAM, upscale_passes[upscale_pass_index]->get_compute_program().get_index(),
+                "Bloom upscale compute program #" + std::to_string(upscale_pass_index)
+            );
+        }
+    }
+#endif
+}
+
 }
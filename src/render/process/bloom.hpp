@@ -23,6 +23,17 @@ public:
 
     [[nodiscard]] float recover_elapsed_time() const override;
 
+    [[nodiscard]] bool has_compute_path() const override;
+
+    [[nodiscard]] bool is_compute_enabled() const override { return compute_enabled; }
+
+    /// Selects the implementation of the bloom. With compute shaders, all downscaled buffers are produced by a single
+    ///   dispatch as done by FidelityFX's Single Pass Downsampler: each work group computes a tile of the first one
+    ///   with the same 13-tap filter as the fragment implementation, then reduces it in shared memory into the
+    ///   following ones with a 2x2 box filter. The upscaling passes are executed with compute shaders as well.
+    /// \param enabled True to execute the bloom with compute shaders, false to execute it with fragment shaders.
+    void set_compute_state(bool enabled) override;
+
     [[nodiscard]] RenderPass& get_threshold_pass() { return *threshold_pass; }
 
     [[nodiscard]] size_t get_downscale_pass_count() const { return downscale_passes.size(); }
@@ -34,12 +45,17 @@ public:
 
     [[nodiscard]] RenderPass& get_downscale_pass(size_t pass_index) { return *downscale_passes[pass_index]; }
 
+    /// Gets the pass producing all downscaled buffers at once when executed with compute shaders.
+    /// \note This pass only exists once compute shaders have been enabled.
+    /// \return Pointer to the single-dispatch downscaling pass if it exists, null otherwise.
+    [[nodiscard]] RenderPass* get_downscale_chain_pass() { return downscale_chain_pass; }
+
     [[nodiscard]] size_t get_downscale_buffer_count() const { return downscale_buffers.size(); }
 
-    [[nodiscard]] Texture2D const& get_downscale_buffer(size_t buffer_index) const
-    {
-        return *downscale_buffers[buffer_index].lock();
-    }
+    /// Gets the physical texture backing a downscale buffer, which may be shared with other transient textures.
+    /// \param buffer_index Index of the downscale buffer.
+    /// \return Reference to the buffer's texture.
+    [[nodiscard]] Texture2D const& get_downscale_buffer(size_t buffer_index) const;
 
     [[nodiscard]] size_t get_upscale_pass_count() const { return upscale_passes.size(); }
 
@@ -49,10 +65,10 @@ public:
 
     [[nodiscard]] size_t get_upscale_buffer_count() const { return upscale_buffers.size(); }
 
-    [[nodiscard]] Texture2D const& get_upscale_buffer(size_t buffer_index) const
-    {
-        return *upscale_buffers[buffer_index].lock();
-    }
+    /// Gets the physical texture backing an upscale buffer, which may be shared with other transient textures.
+    /// \param buffer_index Index of the upscale buffer.
+    /// \return Reference to the buffer's texture.
+    [[nodiscard]] Texture2D const& get_upscale_buffer(size_t buffer_index) const;
 
     void set_input_color_buffer(Texture2DPtr color_buffer);
 
@@ -62,13 +78,21 @@ public:
 
 private:
     RenderPass* threshold_pass = nullptr;
+    TransientTextureId threshold_buffer{};
 
     std::vector<RenderPass*> downscale_passes;
-    std::vector<std::weak_ptr<Texture2D>> downscale_buffers;
+    std::vector<TransientTextureId> downscale_buffers;
 
     std::vector<RenderPass*> upscale_passes;
-    std::vector<std::weak_ptr<Texture2D>> upscale_buffers;
+    std::vector<TransientTextureId> upscale_buffers;
 
     RenderPass* final_pass = nullptr;
+
+    bool compute_enabled = false;
+    RenderPass* downscale_chain_pass = nullptr;
+
+private:
+    /// Creates the single-dispatch downscaling pass & the compute programs of the upscaling passes.
+    void create_compute_passes();
 };
 }
\ No newline at end of file
@@ -5,6 +5,10 @@ namespace {
 constexpr std::string_view box_blur_source = {
 #include "box_blur.frag.embed"
 };
+
+constexpr std::string_view box_blur_compute_source = {
+#include "box_blur.comp.embed"
+};
 }
 
 namespace xen {
@@ -22,6 +26,11 @@ void BoxBlur::resize_buffers(Vector2ui const& size)
     pass.get_program().send_attributes();
 }
 
+void BoxBlur::set_compute_state(bool enabled)
+{
+    apply_compute_state(enabled, box_blur_compute_source, Vector2ui(16));
+}
+
 void BoxBlur::set_input_buffer(Texture2DPtr color_buffer)
 {
     resize_buffers(color_buffer->get_size());
@@ -35,7 +44,6 @@ void BoxBlur::set_output_buffer(Texture2DPtr color_buffer)
 
 void BoxBlur::set_strength(uint32_t strength) const
 {
-    pass.get_program().set_attribute(static_cast<int>(strength), "uniKernelSize");
-    pass.get_program().send_attributes();
+    pass.send_attribute(static_cast<int>(strength), "uniKernelSize");
 }
 }
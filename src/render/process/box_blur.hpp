@@ -9,6 +9,13 @@ public:
 
     void resize_buffers(Vector2ui const& size) override;
 
+    [[nodiscard]] bool has_compute_path() const override { return RenderPass::is_compute_supported(); }
+
+    /// Selects the implementation of the blur. The compute one sums each row of the kernel once per tile of 16x16
+    ///   pixels in shared memory; kernels larger than 8 pixels on each side are summed directly.
+    /// \param enabled True to blur with a compute shader, false to blur with a fragment shader.
+    void set_compute_state(bool enabled) override;
+
     void set_input_buffer(Texture2DPtr color_buffer);
 
     void set_output_buffer(Texture2DPtr color_buffer);
@@ -6,6 +6,10 @@ namespace {
 constexpr std::string_view convolution_source = {
 #include "convolution.frag.embed"
 };
+
+constexpr std::string_view convolution_compute_source = {
+#include "convolution.comp.embed"
+};
 }
 
 namespace xen {
@@ -24,6 +28,11 @@ void ConvolutionRenderProcess::resize_buffers(Vector2ui const& size)
     pass.get_program().send_attributes();
 }
 
+void ConvolutionRenderProcess::set_compute_state(bool enabled)
+{
+    apply_compute_state(enabled, convolution_compute_source, Vector2ui(16));
+}
+
 void ConvolutionRenderProcess::set_input_buffer(Texture2DPtr color_buffer)
 {
     resize_buffers(color_buffer->get_size());
@@ -37,9 +46,8 @@ void ConvolutionRenderProcess::set_output_buffer(Texture2DPtr color_buffer)
 
 void ConvolutionRenderProcess::set_kernel(Matrix3 const& kernel) const
 {
-    pass.get_program().set_attribute(kernel, "uniKernel");
+    pass.send_attribute(kernel, "uniKernel");
     // pass.get_program().set_attribute(std::vector<float>(kernel.data(), kernel.data() + 9),
     // "uniKernel");
-    pass.get_program().send_attributes();
 }
 }
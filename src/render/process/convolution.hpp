@@ -9,6 +9,13 @@ public:
 
     void resize_buffers(Vector2ui const& size) override;
 
+    [[nodiscard]] bool has_compute_path() const override { return RenderPass::is_compute_supported(); }
+
+    /// Selects the implementation of the convolution. The compute one fetches each texel once per tile of 16x16 pixels
+    ///   into shared memory, instead of once per kernel element.
+    /// \param enabled True to convolve with a compute shader, false to convolve with a fragment shader.
+    void set_compute_state(bool enabled) override;
+
     void set_input_buffer(Texture2DPtr color_buffer);
 
     void set_output_buffer(Texture2DPtr color_buffer);
@@ -9,7 +9,7 @@ constexpr std::string_view film_grain_source = {
 
 namespace xen {
 FilmGrain::FilmGrain(RenderGraph& render_graph) :
-    MonoPass(render_graph, FragmentShader::load_from_source(film_grain_source), "Film grain")
+    MonoPass(render_graph, RenderPass::PointwiseEffect{std::string(film_grain_source), "applyFilmGrain"}, "Film grain")
 {
     set_strength(0.05f);
 }
@@ -26,7 +26,7 @@ void FilmGrain::set_output_buffer(Texture2DPtr color_buffer)
 
 void FilmGrain::set_strength(float strength) const
 {
-    pass.get_program().set_attribute(strength, "uniStrength");
+    pass.get_program().set_attribute(strength, "uniFilmGrainStrength");
     pass.get_program().send_attributes();
 }
 }
@@ -7,11 +7,16 @@ namespace {
 constexpr std::string_view gaussian_blur_source = {
 #include "gaussian_blur.frag.embed"
 };
+
+constexpr std::string_view gaussian_blur_compute_source = {
+#include "gaussian_blur.comp.embed"
+};
 }
 
 namespace xen {
 GaussianBlur::GaussianBlur(RenderGraph& render_graph) :
-    RenderProcess(render_graph), horizontal_buffer{Texture2D::create()}
+    RenderProcess(render_graph),
+    horizontal_buffer{render_graph.create_transient_texture(TextureColorspace::RGBA, TextureDataType::BYTE)}
 {
     // Two-pass gaussian blur based on:
     //  - https://www.rastergrid.com/blog/2010/09/efficient-gaussian-blur-with-linear-sampling/
@@ -23,6 +28,8 @@ GaussianBlur::GaussianBlur(RenderGraph& render_graph) :
     horizontal_pass->get_program().set_attribute(Vector2f(1.f, 0.f), "uniBlurDirection");
     horizontal_pass->get_program().send_attributes();
 
+    render_graph.add_transient_write_texture(*horizontal_pass, horizontal_buffer, 0);
+
 #if !defined(USE_OPENGL_ES)
     if (Renderer::check_version(4, 3)) {
         Renderer::set_label(
@@ -44,7 +51,7 @@ GaussianBlur::GaussianBlur(RenderGraph& render_graph) :
     vertical_pass->get_program().set_attribute(Vector2f(0.f, 1.f), "uniBlurDirection");
     vertical_pass->get_program().send_attributes();
 
-    vertical_pass->add_read_texture(horizontal_buffer, "uniBuffer");
+    render_graph.add_transient_read_texture(*vertical_pass, horizontal_buffer, "uniBuffer");
 
     vertical_pass->add_parents(*horizontal_pass);
 
@@ -102,7 +109,7 @@ void GaussianBlur::add_child(RenderProcess& child_process)
 
 void GaussianBlur::resize_buffers(Vector2ui const& size)
 {
-    horizontal_buffer->resize(size);
+    render_graph.resize_transient_texture(horizontal_buffer, size);
 
     Vector2f const inv_buffer_size(1.f / static_cast<float>(size.x), 1.f / static_cast<float>(size.y));
 
@@ -113,6 +120,61 @@ void GaussianBlur::resize_buffers(Vector2ui const& size)
     vertical_pass->get_program().send_attributes();
 }
 
+bool GaussianBlur::has_compute_path() const
+{
+    return RenderPass::is_compute_supported();
+}
+
+bool GaussianBlur::is_compute_enabled() const
+{
+    return horizontal_pass->is_compute_enabled();
+}
+
+void GaussianBlur::set_compute_state(bool enabled)
+{
+#if !defined(USE_OPENGL_ES)
+    if (enabled && !RenderPass::is_compute_supported()) {
+        throw std::runtime_error("Error: Executing a render process with compute shaders requires OpenGL 4.3+");
+    }
+
+    if (enabled && !horizontal_pass->has_compute_program()) {
+        // Each work group covers a segment along the blur direction, the groups being laid out as the pixels
+        horizontal_pass->set_compute_program(
+            ComputeShaderProgram(ComputeShader::load_from_source(gaussian_blur_compute_source)), Vector2ui(128, 1)
+        );
+        vertical_pass->set_compute_program(
+            ComputeShaderProgram(ComputeShader::load_from_source(gaussian_blur_compute_source)), Vector2ui(1, 128)
+        );
+
+        if (Renderer::check_version(4, 3)) {
+            Renderer::set_label(
+                RenderObjectType::PROGRAM, horizontal_pass->get_compute_program().get_index(),
+                "Gaussian blur (horizontal) compute program"
+            );
+            Renderer::set_label(
+                RenderObjectType::PROGRAM, vertical_pass->get_compute_program().get_index(),
+                "Gaussian blur (vertical) compute program"
+            );
+        }
+    }
+
+    horizontal_pass->enable_compute(enabled);
+    vertical_pass->enable_compute(enabled);
+    update_horizontal_buffer_format();
+
+    // The output buffer may not be writable as an image, in which case the fragment implementation is kept
+    if (!render_graph.is_valid()) {
+        horizontal_pass->disable_compute();
+        vertical_pass->disable_compute();
+        update_horizontal_buffer_format();
+
+        throw std::runtime_error("Error: The gaussian blur process is invalid with compute shaders");
+    }
+#else
+    RenderProcess::set_compute_state(enabled);
+#endif
+}
+
 float GaussianBlur::recover_elapsed_time() const
 {
     return horizontal_pass->recover_elapsed_time() + vertical_pass->recover_elapsed_time();
@@ -120,14 +182,13 @@ float GaussianBlur::recover_elapsed_time() const
 
 void GaussianBlur::set_input_buffer(Texture2DPtr input_buffer)
 {
-    horizontal_buffer->set_colorspace(input_buffer->get_colorspace(), input_buffer->get_data_type());
     resize_buffers(input_buffer->get_size());
 
     horizontal_pass->clear_read_textures();
     horizontal_pass->add_read_texture(std::move(input_buffer), "uniBuffer");
 
-    horizontal_pass->clear_write_textures();
-    horizontal_pass->add_write_color_texture(horizontal_buffer, 0);
+    // The horizontally blurred buffer is a transient texture, whose storage is provided by the render graph
+    update_horizontal_buffer_format();
 
 #if !defined(USE_OPENGL_ES)
     if (Renderer::check_version(4, 3)) {
@@ -135,9 +196,6 @@ void GaussianBlur::set_input_buffer(Texture2DPtr input_buffer)
             RenderObjectType::FRAMEBUFFER, horizontal_pass->get_framebuffer().get_index(),
             "Gaussian blur (horizontal) framebuffer"
         );
-        Renderer::set_label(
-            RenderObjectType::TEXTURE, horizontal_buffer->get_index(), "Gaussian blurred (horizontal) buffer"
-        );
     }
 #endif
 
@@ -158,4 +216,22 @@ void GaussianBlur::set_output_buffer(Texture2DPtr output_buffer)
         );
 #endif
 }
+
+void GaussianBlur::update_horizontal_buffer_format()
+{
+    if (!horizontal_pass->has_read_texture("uniBuffer")) {
+        return;
+    }
+
+    Texture const& input_buffer = horizontal_pass->get_read_texture("uniBuffer");
+    TextureColorspace colorspace = input_buffer.get_colorspace();
+
+    // Images can only have 1, 2 or 4 channels & a linear colorspace
+    if (horizontal_pass->is_compute_enabled() && colorspace != TextureColorspace::GRAY &&
+        colorspace != TextureColorspace::RG) {
+        colorspace = TextureColorspace::RGBA;
+    }
+
+    render_graph.set_transient_texture_format(horizontal_buffer, colorspace, input_buffer.get_data_type());
+}
 }
@@ -23,6 +23,15 @@ public:
 
     [[nodiscard]] float recover_elapsed_time() const override;
 
+    [[nodiscard]] bool has_compute_path() const override;
+
+    [[nodiscard]] bool is_compute_enabled() const override;
+
+    /// Selects the implementation of the blur. The compute one blurs segments of 128 pixels along each direction, their
+    ///   texels being fetched once into shared memory.
+    /// \param enabled True to blur with compute shaders, false to blur with fragment shaders.
+    void set_compute_state(bool enabled) override;
+
     [[nodiscard]] RenderPass const& getHorizontalPass() const { return *horizontal_pass; }
 
     [[nodiscard]] RenderPass const& getVerticalPass() const { return *vertical_pass; }
@@ -35,6 +44,11 @@ private:
     RenderPass* horizontal_pass{};
     RenderPass* vertical_pass{};
 
-    Texture2DPtr horizontal_buffer{};
+    TransientTextureId horizontal_buffer{};
+
+private:
+    /// Matches the format of the horizontally blurred buffer with the input one's, making it writable as an image when
+    ///   blurring with compute shaders.
+    void update_horizontal_buffer_format();
 };
 }
\ No newline at end of file
@@ -23,6 +23,15 @@ MonoPass::MonoPass(RenderGraph& render_graph, FragmentShader&& frag_shader, std:
 #endif
 }
 
+MonoPass::MonoPass(RenderGraph& render_graph, RenderPass::PointwiseEffect pointwise_effect, std::string pass_name) :
+    MonoPass(
+        render_graph, FragmentShader::load_from_source(RenderPass::generate_pointwise_source({&pointwise_effect})),
+        std::move(pass_name)
+    )
+{
+    pass.set_pointwise_effect(std::move(pointwise_effect));
+}
+
 bool MonoPass::is_enabled() const
 {
     return pass.is_enabled();
@@ -58,6 +67,41 @@ float MonoPass::recover_elapsed_time() const
     return pass.recover_elapsed_time();
 }
 
+void MonoPass::apply_compute_state(
+    bool enabled, [[maybe_unused]] std::string_view compute_source, [[maybe_unused]] Vector2ui const& tile_size
+)
+{
+#if !defined(USE_OPENGL_ES)
+    if (enabled && !RenderPass::is_compute_supported()) {
+        throw std::runtime_error("Error: Executing a render process with compute shaders requires OpenGL 4.3+");
+    }
+
+    if (enabled && !pass.has_compute_program()) {
+        pass.set_compute_program(ComputeShaderProgram(ComputeShader::load_from_source(compute_source)), tile_size);
+
+        if (Renderer::check_version(4, 3)) {
+            Renderer::set_label(
+                RenderObjectType::PROGRAM, pass.get_compute_program().get_index(), pass.get_name() + " compute program"
+            );
+            Renderer::set_label(
+                RenderObjectType::SHADER, pass.get_compute_program().get_shader().get_index(),
+                pass.get_name() + " compute shader"
+            );
+        }
+    }
+
+    pass.enable_compute(enabled);
+
+    // The output buffer may not be writable as an image, in which case the fragment implementation is kept
+    if (!render_graph.is_valid()) {
+        pass.disable_compute();
+        throw std::runtime_error("Error: The '" + pass.get_name() + "' process is invalid with compute shaders");
+    }
+#else
+    RenderProcess::set_compute_state(enabled);
+#endif
+}
+
 void MonoPass::set_input_buffer(Texture2DPtr input_buffer, std::string const& uniform_name)
 {
     pass.add_read_texture(std::move(input_buffer), uniform_name);
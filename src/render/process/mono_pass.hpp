@@ -1,6 +1,7 @@
 #pragma once
 
 #include <render/process/render_process.hpp>
+#include <render/render_pass.hpp>
 
 namespace xen {
 class FragmentShader;
@@ -9,6 +10,13 @@ class MonoPass : public RenderProcess {
 public:
     MonoPass(RenderGraph& render_graph, FragmentShader&& frag_shader, std::string pass_name = {});
 
+    /// Creates a mono pass applying a pointwise effect to its `uniBuffer` input, which can be fused by the render graph
+    /// with other consecutive pointwise effects.
+    /// \param render_graph Render graph to add the pass to.
+    /// \param pointwise_effect Effect applied by the pass.
+    /// \param pass_name Name of the pass.
+    MonoPass(RenderGraph& render_graph, RenderPass::PointwiseEffect pointwise_effect, std::string pass_name = {});
+
     [[nodiscard]] bool is_enabled() const override;
 
     void set_state(bool enabled) override;
@@ -23,7 +31,15 @@ public:
 
     [[nodiscard]] float recover_elapsed_time() const override;
 
+    [[nodiscard]] bool is_compute_enabled() const override { return pass.is_compute_enabled(); }
+
 protected:
+    /// Selects the implementation the pass is executed with, creating its compute program on first use.
+    /// \param enabled True to execute the pass with its compute program, false to execute it with its render program.
+    /// \param compute_source Source of the compute shader, taking the same inputs as the fragment one.
+    /// \param tile_size Number of pixels covered by each work group.
+    void apply_compute_state(bool enabled, std::string_view compute_source, Vector2ui const& tile_size);
+
     void set_input_buffer(Texture2DPtr input_buffer, std::string const& uniform_name);
 
     void set_output_buffer(Texture2DPtr output_buffer, uint32_t index);
@@ -7,6 +7,11 @@ class RenderPass;
 class Texture2D;
 using Texture2DPtr = std::shared_ptr<Texture2D>;
 
+/// Identifier of a transient texture, an intermediate buffer whose storage is provided by the render graph & can be
+/// shared with other transient textures whose lifetimes do not overlap.
+/// \see RenderGraph::create_transient_texture()
+using TransientTextureId = size_t;
+
 /// RenderProcess class, representing a set of render passes with fixed actions; can be derived to implement post
 /// effects.
 class RenderProcess {
@@ -32,10 +37,31 @@ public:
     /// \return Time taken to execute the process.
     virtual float recover_elapsed_time() const { return 0.f; }
 
+    /// Checks if the process can be executed with compute shaders instead of fragment ones.
+    /// \return True if the process has a compute implementation, false otherwise.
+    virtual bool has_compute_path() const { return false; }
+
+    virtual bool is_compute_enabled() const { return false; }
+
+    /// Selects the implementation the process is executed with. Both give the same result up to filtering details;
+    ///   their timings can be compared with recover_elapsed_time() to keep the fastest one on the current hardware.
+    /// \note Compute shaders require OpenGL 4.3+ & are not available with OpenGL ES.
+    /// \param enabled True to execute the process with compute shaders, false to execute it with fragment ones.
+    virtual void set_compute_state(bool enabled)
+    {
+        if (enabled) {
+            throw std::runtime_error("Error: The render process has no compute implementation");
+        }
+    }
+
     void enable() { set_state(true); }
 
     void disable() { set_state(false); }
 
+    void enable_compute() { set_compute_state(true); }
+
+    void disable_compute() { set_compute_state(false); }
+
 protected:
     RenderGraph& render_graph;
 };
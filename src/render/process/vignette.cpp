@@ -9,7 +9,7 @@ constexpr std::string_view vignetteSource = {
 
 namespace xen {
 Vignette::Vignette(RenderGraph& render_graph) :
-    MonoPass(render_graph, FragmentShader::load_from_source(vignetteSource), "Vignette")
+    MonoPass(render_graph, RenderPass::PointwiseEffect{std::string(vignetteSource), "applyVignette"}, "Vignette")
 {
     set_strength(0.25f);
     set_opacity(1.f);
@@ -19,7 +19,7 @@ Vignette::Vignette(RenderGraph& render_graph) :
 void Vignette::resize_buffers(Vector2ui const& size)
 {
     float const frame_ratio = static_cast<float>(size.x) / static_cast<float>(size.y);
-    pass.get_program().set_attribute(frame_ratio, "uniFrameRatio");
+    pass.get_program().set_attribute(frame_ratio, "uniVignetteFrameRatio");
     pass.get_program().send_attributes();
 }
 
@@ -36,19 +36,19 @@ void Vignette::set_output_buffer(Texture2DPtr color_buffer)
 
 void Vignette::set_strength(float strength) const
 {
-    pass.get_program().set_attribute(strength, "uniStrength");
+    pass.get_program().set_attribute(strength, "uniVignetteStrength");
     pass.get_program().send_attributes();
 }
 
 void Vignette::set_opacity(float opacity) const
 {
-    pass.get_program().set_attribute(opacity, "uniOpacity");
+    pass.get_program().set_attribute(opacity, "uniVignetteOpacity");
     pass.get_program().send_attributes();
 }
 
 void Vignette::set_color(Color const& color) const
 {
-    pass.get_program().set_attribute(color, "uniColor");
+    pass.get_program().set_attribute(color, "uniVignetteColor");
     pass.get_program().send_attributes();
 }
 }
\ No newline at end of file
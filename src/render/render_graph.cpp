@@ -3,25 +3,392 @@
 
 // #include <math/transform/transform.hpp>
 #include <render/camera.hpp>
+#include <render/mesh_lod.hpp>
 #include <render/mesh_renderer.hpp>
 #include <render/render_system.hpp>
+#include <render/renderer.hpp>
+#if !defined(XEN_NO_OVERLAY)
+#include <render/overlay.hpp>
+#endif
+#include <utils/hash.hpp>
 
 #include <tracy/Tracy.hpp>
 #include <GL/glew.h> // Needed by TracyOpenGL.hpp
 #include <tracy/TracyOpenGL.hpp>
 
 namespace xen {
+namespace {
+/// Computes the world-space bounding box enclosing a transformed local one.
+/// \param local_box Bounding box in local space.
+/// \param transform Transformation matrix to bring the box in world space.
+/// \return World-space bounding box.
+AABB compute_world_bounding_box(AABB const& local_box, Matrix4 const& transform)
+{
+    Vector3f const center(transform.transform(Vector4f(local_box.compute_centroid(), 1.f)));
+    Vector3f const local_half_extents = local_box.compute_half_extents();
+
+    // Projecting the half extents on each world axis; see "Transforming Axis-Aligned Bounding Boxes", J. Arvo
+    Vector3f half_extents;
+    half_extents.x = std::abs(transform[0][0]) * local_half_extents.x + std::abs(transform[1][0]) * local_half_extents.y +
+                     std::abs(transform[2][0]) * local_half_extents.z;
+    half_extents.y = std::abs(transform[0][1]) * local_half_extents.x + std::abs(transform[1][1]) * local_half_extents.y +
+                     std::abs(transform[2][1]) * local_half_extents.z;
+    half_extents.z = std::abs(transform[0][2]) * local_half_extents.x + std::abs(transform[1][2]) * local_half_extents.y +
+                     std::abs(transform[2][2]) * local_half_extents.z;
+
+    return AABB(center - half_extents, center + half_extents);
+}
+
+/// Computes how many pixels a unit of an entity's local space covers on screen, at its closest point to the camera.
+/// \param bounding_box World-space bounding box of the entity.
+/// \param transform Transformation matrix of the entity.
+/// \param projection Projection matrix of the camera.
+/// \param camera_position World-space position of the camera.
+/// \param viewport_height Height of the viewport, in pixels.
+/// \return Number of pixels per local unit.
+float compute_pixels_per_unit(
+    AABB const& bounding_box, Matrix4 const& transform, Matrix4 const& projection, Vector3f const& camera_position,
+    float viewport_height
+)
+{
+    // The simplification error being expressed in local units, the largest axis scale is taken to stay conservative
+    float const max_scale = std::max({Vector3f(transform[0]).length(), Vector3f(transform[1]).length(),
+                                      Vector3f(transform[2]).length()});
+    float pixels_per_unit = projection[1][1] * viewport_height * 0.5f * max_scale;
+
+    // An orthographic projection does not depend on the distance
+    if (projection[3][3] == 1.f) {
+        return pixels_per_unit;
+    }
+
+    float const distance = (bounding_box.compute_centroid() - camera_position).length() -
+                           bounding_box.compute_half_extents().length();
+    return pixels_per_unit / std::max(distance, 0.01f);
+}
+
+/// Computes the memory occupied by a texture's storage, ignoring any padding the driver may add.
+/// \param texture Texture to compute the size of.
+/// \return Size of the texture, in bytes.
+size_t compute_texture_memory_size(Texture2D const& texture)
+{
+    size_t channel_count = 0;
+
+    switch (texture.get_colorspace()) {
+    case TextureColorspace::GRAY:
+    case TextureColorspace::DEPTH:
+        channel_count = 1;
+        break;
+
+    case TextureColorspace::RG:
+        channel_count = 2;
+        break;
+
+    case TextureColorspace::RGB:
+    case TextureColorspace::SRGB:
+        channel_count = 3;
+        break;
+
+    case TextureColorspace::RGBA:
+    case TextureColorspace::SRGBA:
+        channel_count = 4;
+        break;
+
+    default:
+        break;
+    }
+
+    size_t const channel_size = (texture.get_data_type() == TextureDataType::FLOAT32 ? 4 :
+                                 texture.get_data_type() == TextureDataType::FLOAT16 ? 2 :
+                                                                                      1);
+
+    return static_cast<size_t>(texture.get_size().x) * texture.get_size().y * channel_count * channel_size;
+}
+}
+
 bool RenderGraph::is_valid() const
 {
-    return std::all_of(nodes.cbegin(), nodes.cend(), [](std::unique_ptr<RenderPass> const& render_pass) {
-        return render_pass->is_valid();
-    });
+    bool const are_passes_valid =
+        std::all_of(nodes.cbegin(), nodes.cend(), [](std::unique_ptr<RenderPass> const& render_pass) {
+            return render_pass->is_valid();
+        });
+
+    if (!are_passes_valid) {
+        return false;
+    }
+
+    // Transient textures may not be bound yet, hence being checked separately
+    for (TransientTexture const& transient_texture : transient_textures) {
+        for (auto const& [read_pass, _] : transient_texture.reads) {
+            auto const write_it = std::find_if(
+                transient_texture.writes.cbegin(), transient_texture.writes.cend(),
+                [read_pass = read_pass](auto const& write) { return (write.first == read_pass); }
+            );
+
+            if (write_it != transient_texture.writes.cend()) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool RenderGraph::is_compiled() const
+{
+    return (!needs_compilation && compute_signature() == compiled_signature);
+}
+
+size_t RenderGraph::get_transient_memory_size() const
+{
+    size_t memory_size = 0;
+
+    for (PhysicalTexture const& physical_texture : physical_textures) {
+        memory_size += compute_texture_memory_size(*physical_texture.texture);
+    }
+
+    return memory_size;
+}
+
+Texture2D const& RenderGraph::get_transient_texture(TransientTextureId texture_id) const
+{
+    Log::rt_assert(texture_id < transient_textures.size(), "Error: The transient texture does not exist.");
+    Log::rt_assert(
+        transient_textures[texture_id].bound_texture != nullptr,
+        "Error: The transient texture has not been bound to a physical texture yet."
+    );
+
+    return *transient_textures[texture_id].bound_texture;
+}
+
+std::vector<RenderPassProfile> RenderGraph::get_profile() const
+{
+    std::vector<RenderPassProfile> profile;
+    profile.reserve(execution_order.size() + 1);
+
+    profile.emplace_back(
+        (geometry_pass.get_name().empty() ? "Geometry pass" : geometry_pass.get_name()),
+        geometry_pass.recover_elapsed_time_stats()
+    );
+
+    for (RenderPass const* render_pass : execution_order) {
+        profile.emplace_back(
+            (render_pass->get_name().empty() ? "[Unnamed pass]" : render_pass->get_name()),
+            render_pass->recover_elapsed_time_stats()
+        );
+    }
+
+    return profile;
+}
+
+#if !defined(XEN_NO_OVERLAY)
+void RenderGraph::push_profile(OverlayPlot& plot) const
+{
+    for (RenderPassProfile const& pass_profile : get_profile()) {
+        OverlayPlotEntry* entry = plot.find_entry(pass_profile.name);
+
+        if (entry == nullptr) {
+            entry = &plot.add_entry(pass_profile.name);
+        }
+
+        entry->push(pass_profile.stats.latest);
+    }
+}
+#endif
+
+void RenderGraph::remove_node(RenderPass& render_pass)
+{
+    for (TransientTexture& transient_texture : transient_textures) {
+        std::erase_if(transient_texture.reads, [&render_pass](auto const& read) {
+            return (read.first == &render_pass);
+        });
+        std::erase_if(transient_texture.writes, [&render_pass](auto const& write) {
+            return (write.first == &render_pass);
+        });
+    }
+
+    Graph<RenderPass>::remove_node(render_pass);
+    needs_compilation = true;
+}
+
+TransientTextureId RenderGraph::create_transient_texture(TextureColorspace colorspace, TextureDataType data_type)
+{
+    if (colorspace == TextureColorspace::DEPTH || colorspace == TextureColorspace::INVALID) {
+        throw std::invalid_argument("Error: A transient texture must have a color colorspace");
+    }
+
+    transient_textures.emplace_back(TransientTexture{colorspace, data_type});
+    needs_compilation = true;
+
+    return transient_textures.size() - 1;
+}
+
+void RenderGraph::set_transient_texture_format(
+    TransientTextureId texture_id, TextureColorspace colorspace, TextureDataType data_type
+)
+{
+    Log::rt_assert(texture_id < transient_textures.size(), "Error: The transient texture does not exist.");
+
+    if (colorspace == TextureColorspace::DEPTH || colorspace == TextureColorspace::INVALID) {
+        throw std::invalid_argument("Error: A transient texture must have a color colorspace");
+    }
+
+    TransientTexture& transient_texture = transient_textures[texture_id];
+
+    if (transient_texture.colorspace == colorspace && transient_texture.data_type == data_type) {
+        return;
+    }
+
+    transient_texture.colorspace = colorspace;
+    transient_texture.data_type = data_type;
+    needs_compilation = true;
+}
+
+void RenderGraph::resize_transient_texture(TransientTextureId texture_id, Vector2ui const& size)
+{
+    Log::rt_assert(texture_id < transient_textures.size(), "Error: The transient texture does not exist.");
+
+    if (transient_textures[texture_id].size == size) {
+        return;
+    }
+
+    transient_textures[texture_id].size = size;
+    needs_compilation = true;
+}
+
+void RenderGraph::add_transient_read_texture(
+    RenderPass& render_pass, TransientTextureId texture_id, std::string uniform_name
+)
+{
+    Log::rt_assert(texture_id < transient_textures.size(), "Error: The transient texture does not exist.");
+
+    // A uniform can only be bound to a single texture; any transient texture previously bound to it is replaced
+    for (TransientTexture& transient_texture : transient_textures) {
+        std::erase_if(transient_texture.reads, [&render_pass, &uniform_name](auto const& read) {
+            return (read.first == &render_pass && read.second == uniform_name);
+        });
+    }
+
+    transient_textures[texture_id].reads.emplace_back(&render_pass, std::move(uniform_name));
+    needs_compilation = true;
+}
+
+void RenderGraph::add_transient_write_texture(RenderPass& render_pass, TransientTextureId texture_id, uint32_t index)
+{
+    Log::rt_assert(texture_id < transient_textures.size(), "Error: The transient texture does not exist.");
+
+    transient_textures[texture_id].writes.emplace_back(&render_pass, index);
+    needs_compilation = true;
+}
+
+void RenderGraph::compile()
+{
+    ZoneScopedN("RenderGraph::compile");
+
+    Log::debug("[RenderGraph] Compiling...");
+
+    std::vector<RenderPass*> const sorted_passes = sort_passes();
+
+    // The last pass is the one whose output is displayed, even if it has been disabled
+    last_executed_pass = (sorted_passes.empty() ? &geometry_pass : sorted_passes.back());
+
+    std::unordered_set<Texture const*> physical_texture_set;
+    physical_texture_set.reserve(physical_textures.size());
+
+    for (PhysicalTexture const& physical_texture : physical_textures) {
+        physical_texture_set.emplace(physical_texture.texture.get());
+    }
+
+    std::unordered_map<RenderPass const*, PassResources> pass_resources;
+    pass_resources.reserve(sorted_passes.size());
+
+    for (RenderPass const* render_pass : sorted_passes) {
+        pass_resources.emplace(render_pass, gather_resources(*render_pass, physical_texture_set));
+    }
+
+    // Transient textures are not bound in the passes yet; their usages are added separately
+    for (TransientTextureId texture_id = 0; texture_id < transient_textures.size(); ++texture_id) {
+        for (auto const& [render_pass, uniform_name] : transient_textures[texture_id].reads) {
+            auto const resources_it = pass_resources.find(render_pass);
+
+            if (resources_it != pass_resources.end()) {
+                resources_it->second.sampled_reads.emplace_back(texture_id, uniform_name);
+            }
+        }
+
+        for (auto const& [render_pass, index] : transient_textures[texture_id].writes) {
+            auto const resources_it = pass_resources.find(render_pass);
+
+            if (resources_it == pass_resources.end()) {
+                continue;
+            }
+
+            // Compute passes write their color buffers with image stores
+            if (render_pass->is_compute_enabled()) {
+                resources_it->second.image_writes.emplace_back(texture_id);
+            }
+            else {
+                resources_it->second.attachment_writes.emplace_back(texture_id, index);
+            }
+        }
+    }
+
+    std::vector<RenderPass*> const executed_passes = cull_passes(sorted_passes, pass_resources);
+    culled_pass_count = sorted_passes.size() - executed_passes.size();
+
+    std::unordered_set<TransientTextureId> fused_transient_textures;
+    std::vector<std::vector<RenderPass*>> const pass_groups =
+        group_fusable_passes(executed_passes, pass_resources, fused_transient_textures);
+
+    // The geometry pass comes first, its index being 0; fused passes share the index of their group
+    constexpr size_t culled_pass_index = std::numeric_limits<size_t>::max();
+
+    std::unordered_map<RenderPass const*, size_t> pass_indices;
+    pass_indices.reserve(sorted_passes.size() + 1);
+    pass_indices.emplace(&geometry_pass, 0);
+
+    for (size_t group_index = 0; group_index < pass_groups.size(); ++group_index) {
+        for (RenderPass const* render_pass : pass_groups[group_index]) {
+            pass_indices.emplace(render_pass, group_index + 1);
+        }
+    }
+
+    for (RenderPass const* render_pass : sorted_passes) {
+        pass_indices.emplace(render_pass, culled_pass_index); // Not inserted if already present
+    }
+
+    assign_transient_textures(pass_indices, fused_transient_textures);
+    create_fused_passes(pass_groups);
+
+    execution_order.clear();
+    execution_order.reserve(pass_groups.size());
+
+    size_t fused_pass_index = 0;
+
+    for (std::vector<RenderPass*> const& pass_group : pass_groups) {
+        execution_order.emplace_back(pass_group.size() == 1 ? pass_group.front() :
+                                                              fused_passes[fused_pass_index++].pass.get());
+    }
+
+    compute_barriers(pass_groups, pass_resources);
+
+    compiled_signature = compute_signature();
+    needs_compilation = false;
+
+    Log::vdebug(
+        "[RenderGraph] Compiled ({} pass(es) executed, {} culled, {} fused into {}; {} transient texture(s) backed by "
+        "{} physical texture(s), {} byte(s))",
+        execution_order.size(), culled_pass_count, executed_passes.size() - (pass_groups.size() - fused_passes.size()),
+        fused_passes.size(), transient_textures.size(), physical_textures.size(), get_transient_memory_size()
+    );
 }
 
 void RenderGraph::resize_viewport(Vector2ui const& size)
 {
     ZoneScopedN("RenderGraph::resize_viewport");
 
+    // Physical textures may have been resized along with the framebuffers they are bound to
+    needs_compilation = true;
+
     geometry_pass.resize_write_buffers(size);
 
     for (std::unique_ptr<RenderPass> const& render_pass : nodes) {
@@ -43,10 +410,629 @@ void RenderGraph::update_shaders() const
     }
 }
 
+uint64_t RenderGraph::compute_signature() const
+{
+    uint64_t signature = Hash::compute_fnv1a(nodes.size());
+
+    for (std::unique_ptr<RenderPass> const& render_pass : nodes) {
+        uint8_t const states = static_cast<uint8_t>(render_pass->enabled) |
+                               static_cast<uint8_t>(static_cast<uint8_t>(render_pass->side_effects) << 1u) |
+                               static_cast<uint8_t>(static_cast<uint8_t>(render_pass->is_compute_enabled()) << 2u);
+        signature = Hash::compute_fnv1a(states, signature);
+
+        for (RenderPass const* parent_pass : render_pass->parents) {
+            signature = Hash::compute_fnv1a(parent_pass, signature);
+        }
+
+        RenderShaderProgram const& program = render_pass->program;
+
+        for (size_t texture_index = 0; texture_index < program.get_texture_count(); ++texture_index) {
+            signature = Hash::compute_fnv1a(&program.get_texture(texture_index), signature);
+        }
+
+#if !defined(USE_WEBGL)
+        for (size_t texture_index = 0; texture_index < program.get_image_texture_count(); ++texture_index) {
+            signature = Hash::compute_fnv1a(&program.get_image_texture(texture_index), signature);
+        }
+#endif
+
+#if !defined(USE_OPENGL_ES)
+        if (render_pass->compute_program) {
+            ComputeShaderProgram const& compute_program = *render_pass->compute_program;
+
+            for (size_t texture_index = 0; texture_index < compute_program.get_image_texture_count(); ++texture_index) {
+                signature = Hash::compute_fnv1a(&compute_program.get_image_texture(texture_index), signature);
+            }
+        }
+#endif
+
+        Framebuffer const& framebuffer = render_pass->write_framebuffer;
+
+        if (framebuffer.has_depth_buffer()) {
+            signature = Hash::compute_fnv1a(&framebuffer.get_depth_buffer(), signature);
+        }
+
+        for (auto const& [color_buffer, buffer_index] : framebuffer.get_color_buffers()) {
+            signature = Hash::compute_fnv1a(buffer_index, Hash::compute_fnv1a(color_buffer.get(), signature));
+        }
+    }
+
+    return signature;
+}
+
+std::vector<RenderPass*> RenderGraph::sort_passes() const
+{
+    ZoneScopedN("RenderGraph::sort_passes");
+
+    enum class VisitState : uint8_t { UNVISITED, VISITING, VISITED };
+
+    std::unordered_map<RenderPass const*, VisitState> visit_states;
+    visit_states.reserve(nodes.size() + 1);
+    visit_states.emplace(&geometry_pass, VisitState::VISITED); // The geometry pass is always executed first
+
+    std::vector<RenderPass*> sorted_passes;
+    sorted_passes.reserve(nodes.size());
+
+    // Depth-first traversal, each pass being added after all its parents; the traversal is iterative, each stack entry
+    //  holding the index of the next parent to be visited
+    std::vector<std::pair<RenderPass*, size_t>> visit_stack;
+
+    for (std::unique_ptr<RenderPass> const& render_pass : nodes) {
+        if (visit_states[render_pass.get()] != VisitState::UNVISITED) {
+            continue;
+        }
+
+        visit_states[render_pass.get()] = VisitState::VISITING;
+        visit_stack.emplace_back(render_pass.get(), 0);
+
+        while (!visit_stack.empty()) {
+            auto& [current_pass, parent_index] = visit_stack.back();
+
+            if (parent_index < current_pass->parents.size()) {
+                RenderPass* parent_pass = current_pass->parents[parent_index++];
+                VisitState& parent_state = visit_states[parent_pass];
+
+                if (parent_state == VisitState::VISITING) {
+                    throw std::runtime_error("Error: The render graph contains a cycle");
+                }
+
+                if (parent_state == VisitState::UNVISITED) {
+                    parent_state = VisitState::VISITING;
+                    visit_stack.emplace_back(parent_pass, 0);
+                }
+
+                continue;
+            }
+
+            visit_states[current_pass] = VisitState::VISITED;
+            sorted_passes.emplace_back(current_pass);
+            visit_stack.pop_back();
+        }
+    }
+
+    return sorted_passes;
+}
+
+RenderGraph::PassResources RenderGraph::gather_resources(
+    RenderPass const& render_pass, std::unordered_set<Texture const*> const& physical_textures
+) const
+{
+    PassResources resources;
+
+    for (auto const& [texture, uniform_name] : render_pass.program.get_textures()) {
+        if (!physical_textures.contains(texture.get())) {
+            resources.sampled_reads.emplace_back(texture.get(), uniform_name);
+        }
+    }
+
+#if !defined(USE_WEBGL)
+#if !defined(USE_OPENGL_ES)
+    ShaderProgram const& executed_program =
+        (render_pass.is_compute_enabled() ? static_cast<ShaderProgram const&>(*render_pass.compute_program) :
+                                            static_cast<ShaderProgram const&>(render_pass.program));
+#else
+    ShaderProgram const& executed_program = render_pass.program;
+#endif
+
+    for (size_t texture_index = 0; texture_index < executed_program.get_image_texture_count(); ++texture_index) {
+        Texture const* texture = &executed_program.get_image_texture(texture_index);
+        ImageAccess const access = executed_program.get_image_texture_access(texture_index);
+
+        if (access != ImageAccess::WRITE) {
+            resources.image_reads.emplace_back(texture);
+        }
+
+        if (access != ImageAccess::READ) {
+            resources.image_writes.emplace_back(texture);
+        }
+    }
+#endif
+
+    Framebuffer const& framebuffer = render_pass.write_framebuffer;
+
+    if (framebuffer.has_depth_buffer() && !physical_textures.contains(&framebuffer.get_depth_buffer())) {
+        resources.attachment_writes.emplace_back(&framebuffer.get_depth_buffer(), std::numeric_limits<uint32_t>::max());
+    }
+
+    for (auto const& [color_buffer, buffer_index] : framebuffer.get_color_buffers()) {
+        if (physical_textures.contains(color_buffer.get())) {
+            continue;
+        }
+
+        // Compute passes write their color buffers with image stores
+        if (render_pass.is_compute_enabled()) {
+            resources.image_writes.emplace_back(color_buffer.get());
+        }
+        else {
+            resources.attachment_writes.emplace_back(color_buffer.get(), buffer_index);
+        }
+    }
+
+    return resources;
+}
+
+std::vector<RenderPass*> RenderGraph::cull_passes(
+    std::vector<RenderPass*> const& sorted_passes,
+    std::unordered_map<RenderPass const*, PassResources> const& pass_resources
+) const
+{
+    ZoneScopedN("RenderGraph::cull_passes");
+
+    // Recovering the writers of each resource, by order of execution
+    std::unordered_map<ResourceKey, std::vector<size_t>> resource_writers;
+
+    for (size_t pass_index = 0; pass_index < sorted_passes.size(); ++pass_index) {
+        PassResources const& resources = pass_resources.at(sorted_passes[pass_index]);
+
+        for (auto const& [resource, _] : resources.attachment_writes) {
+            resource_writers[resource].emplace_back(pass_index);
+        }
+
+        for (ResourceKey const& resource : resources.image_writes) {
+            resource_writers[resource].emplace_back(pass_index);
+        }
+    }
+
+    std::unordered_map<RenderPass const*, size_t> pass_indices;
+    pass_indices.reserve(sorted_passes.size());
+
+    for (size_t pass_index = 0; pass_index < sorted_passes.size(); ++pass_index) {
+        pass_indices.emplace(sorted_passes[pass_index], pass_index);
+    }
+
+    // Walking up from the final pass & those with side effects; a disabled pass does not read its inputs, hence not
+    //  making the passes producing them contribute
+    std::vector<bool> contributing_passes(sorted_passes.size(), false);
+    std::vector<size_t> pass_stack;
+
+    auto const mark_contributing = [&](size_t pass_index) {
+        if (!sorted_passes[pass_index]->is_enabled() || contributing_passes[pass_index]) {
+            return;
+        }
+
+        contributing_passes[pass_index] = true;
+        pass_stack.emplace_back(pass_index);
+    };
+
+    if (!sorted_passes.empty()) {
+        mark_contributing(sorted_passes.size() - 1);
+    }
+
+    for (size_t pass_index = 0; pass_index < sorted_passes.size(); ++pass_index) {
+        if (sorted_passes[pass_index]->has_side_effects()) {
+            mark_contributing(pass_index);
+        }
+    }
+
+    while (!pass_stack.empty()) {
+        size_t const pass_index = pass_stack.back();
+        pass_stack.pop_back();
+
+        for (RenderPass const* parent_pass : sorted_passes[pass_index]->parents) {
+            auto const parent_it = pass_indices.find(parent_pass);
+
+            if (parent_it != pass_indices.cend()) {
+                mark_contributing(parent_it->second);
+            }
+        }
+
+        // Only the writers executed beforehand produce what the pass reads
+        auto const mark_writers = [&](ResourceKey const& resource) {
+            auto const writers_it = resource_writers.find(resource);
+
+            if (writers_it == resource_writers.cend()) {
+                return;
+            }
+
+            for (size_t const writer_index : writers_it->second) {
+                if (writer_index < pass_index) {
+                    mark_contributing(writer_index);
+                }
+            }
+        };
+
+        PassResources const& resources = pass_resources.at(sorted_passes[pass_index]);
+
+        for (auto const& [resource, _] : resources.sampled_reads) {
+            mark_writers(resource);
+        }
+
+        for (ResourceKey const& resource : resources.image_reads) {
+            mark_writers(resource);
+        }
+    }
+
+    std::vector<RenderPass*> executed_passes;
+    executed_passes.reserve(sorted_passes.size());
+
+    for (size_t pass_index = 0; pass_index < sorted_passes.size(); ++pass_index) {
+        if (contributing_passes[pass_index]) {
+            executed_passes.emplace_back(sorted_passes[pass_index]);
+        }
+    }
+
+    return executed_passes;
+}
+
+std::vector<std::vector<RenderPass*>> RenderGraph::group_fusable_passes(
+    std::vector<RenderPass*> const& executed_passes,
+    std::unordered_map<RenderPass const*, PassResources> const& pass_resources,
+    std::unordered_set<TransientTextureId>& fused_transient_textures
+) const
+{
+    ZoneScopedN("RenderGraph::group_fusable_passes");
+
+    std::unordered_map<ResourceKey, size_t> reader_counts;
+
+    for (RenderPass const* render_pass : executed_passes) {
+        PassResources const& resources = pass_resources.at(render_pass);
+
+        for (auto const& [resource, _] : resources.sampled_reads) {
+            ++reader_counts[resource];
+        }
+
+        for (ResourceKey const& resource : resources.image_reads) {
+            ++reader_counts[resource];
+        }
+    }
+
+    // A pointwise pass only samples its input buffer & writes a single color buffer
+    auto const is_fusable = [&pass_resources](RenderPass const& render_pass) {
+        if (!render_pass.get_pointwise_effect().has_value()) {
+            return false;
+        }
+
+        PassResources const& resources = pass_resources.at(&render_pass);
+        return (
+            resources.image_reads.empty() && resources.image_writes.empty() && resources.sampled_reads.size() == 1 &&
+            resources.sampled_reads.front().second == "uniBuffer" && resources.attachment_writes.size() == 1 &&
+            resources.attachment_writes.front().second == 0
+        );
+    };
+
+    std::vector<std::vector<RenderPass*>> pass_groups;
+    pass_groups.reserve(executed_passes.size());
+
+    for (RenderPass* render_pass : executed_passes) {
+        if (!pass_groups.empty() && is_fusable(*render_pass)) {
+            RenderPass const& previous_pass = *pass_groups.back().back();
+
+            // The previous pass' output must only be read by the current one, which must read nothing else
+            if (!previous_pass.has_side_effects() && is_fusable(previous_pass)) {
+                ResourceKey const& intermediate_resource =
+                    pass_resources.at(&previous_pass).attachment_writes.front().first;
+
+                if (pass_resources.at(render_pass).sampled_reads.front().first == intermediate_resource &&
+                    reader_counts[intermediate_resource] == 1) {
+                    if (std::holds_alternative<TransientTextureId>(intermediate_resource)) {
+                        fused_transient_textures.emplace(std::get<TransientTextureId>(intermediate_resource));
+                    }
+
+                    pass_groups.back().emplace_back(render_pass);
+                    continue;
+                }
+            }
+        }
+
+        pass_groups.push_back({render_pass});
+    }
+
+    return pass_groups;
+}
+
+void RenderGraph::assign_transient_textures(
+    std::unordered_map<RenderPass const*, size_t> const& pass_indices,
+    std::unordered_set<TransientTextureId> const& fused_transient_textures
+)
+{
+    ZoneScopedN("RenderGraph::assign_transient_textures");
+
+    constexpr size_t culled_pass_index = std::numeric_limits<size_t>::max();
+
+    struct Lifetime {
+        TransientTextureId texture_id;
+        size_t first_use;
+        size_t last_use;
+    };
+
+    std::vector<Lifetime> lifetimes;
+    lifetimes.reserve(transient_textures.size());
+
+    for (TransientTextureId texture_id = 0; texture_id < transient_textures.size(); ++texture_id) {
+        TransientTexture& transient_texture = transient_textures[texture_id];
+
+        // Unbinding all transient textures from their passes beforehand, so that a physical texture reassigned to
+        //  another transient texture written by the same pass does not get removed afterward, & that a texture no
+        //  longer in use is not kept alive by a culled pass
+        if (transient_texture.bound_texture) {
+            for (auto const& [render_pass, _] : transient_texture.writes) {
+                render_pass->remove_write_texture(transient_texture.bound_texture);
+            }
+
+            for (auto const& [render_pass, uniform_name] : transient_texture.reads) {
+                render_pass->remove_read_texture(uniform_name);
+            }
+
+            transient_texture.bound_texture.reset();
+        }
+
+        // The textures only used between fused passes are never written
+        if (fused_transient_textures.contains(texture_id)) {
+            continue;
+        }
+
+        Lifetime lifetime{texture_id, culled_pass_index, 0};
+
+        auto const extend_lifetime = [&pass_indices, &lifetime](RenderPass const* render_pass) {
+            auto const index_it = pass_indices.find(render_pass);
+
+            // A pass outside of the graph may be executed at any time; the texture must then be kept all along
+            if (index_it == pass_indices.cend()) {
+                lifetime.first_use = 0;
+                lifetime.last_use = culled_pass_index - 1;
+                return;
+            }
+
+            if (index_it->second == culled_pass_index) {
+                return;
+            }
+
+            lifetime.first_use = std::min(lifetime.first_use, index_it->second);
+            lifetime.last_use = std::max(lifetime.last_use, index_it->second);
+        };
+
+        for (auto const& [render_pass, _] : transient_texture.writes) {
+            extend_lifetime(render_pass);
+        }
+
+        for (auto const& [render_pass, _] : transient_texture.reads) {
+            extend_lifetime(render_pass);
+        }
+
+        // Textures which are not used by any executed pass need no storage
+        if (lifetime.first_use == culled_pass_index) {
+            continue;
+        }
+
+        lifetimes.emplace_back(lifetime);
+    }
+
+    // Greedily assigning the textures by order of first use to the first compatible physical texture which is not used
+    //  anymore, which minimizes the number of physical textures for each format
+    std::sort(lifetimes.begin(), lifetimes.end(), [](Lifetime const& lhs, Lifetime const& rhs) {
+        return (lhs.first_use < rhs.first_use);
+    });
+
+    std::vector<PhysicalTexture> previous_textures = std::move(physical_textures);
+    physical_textures.clear();
+
+    for (Lifetime const& lifetime : lifetimes) {
+        TransientTexture& transient_texture = transient_textures[lifetime.texture_id];
+
+        auto const is_compatible = [&transient_texture](Texture2D const& texture) {
+            return (
+                texture.get_colorspace() == transient_texture.colorspace &&
+                texture.get_data_type() == transient_texture.data_type && texture.get_size() == transient_texture.size
+            );
+        };
+
+        // A physical texture can only be reused once its last user has been executed; a pass reading a texture while
+        //  writing another cannot use the same physical one for both
+        auto physical_it = std::find_if(
+            physical_textures.begin(), physical_textures.end(), [&](PhysicalTexture const& physical_texture) {
+                return (physical_texture.last_use < lifetime.first_use && is_compatible(*physical_texture.texture));
+            }
+        );
+
+        if (physical_it == physical_textures.end()) {
+            // Recovering a texture from the previous compilation if any is compatible, avoiding a reallocation
+            auto const previous_it =
+                std::find_if(previous_textures.begin(), previous_textures.end(), [&](PhysicalTexture const& previous) {
+                    return is_compatible(*previous.texture);
+                });
+
+            Texture2DPtr texture;
+
+            if (previous_it != previous_textures.end()) {
+                texture = std::move(previous_it->texture);
+                previous_textures.erase(previous_it);
+            }
+            else {
+                texture = Texture2D::create(transient_texture.colorspace, transient_texture.data_type);
+                texture->resize(transient_texture.size);
+            }
+
+            physical_it = physical_textures.insert(physical_textures.end(), PhysicalTexture{std::move(texture), 0});
+
+#if !defined(USE_OPENGL_ES)
+            if (Renderer::check_version(4, 3)) {
+                Renderer::set_label(
+                    RenderObjectType::TEXTURE, physical_it->texture->get_index(),
+                    "Transient texture #" + std::to_string(physical_textures.size() - 1)
+                );
+            }
+#endif
+        }
+
+        physical_it->last_use = lifetime.last_use;
+        transient_texture.bound_texture = physical_it->texture;
+
+        for (auto const& [render_pass, index] : transient_texture.writes) {
+            render_pass->add_write_color_texture(transient_texture.bound_texture, index);
+        }
+
+        for (auto const& [render_pass, uniform_name] : transient_texture.reads) {
+            render_pass->add_read_texture(transient_texture.bound_texture, uniform_name);
+        }
+    }
+}
+
+void RenderGraph::create_fused_passes(std::vector<std::vector<RenderPass*>> const& pass_groups)
+{
+    ZoneScopedN("RenderGraph::create_fused_passes");
+
+    std::vector<FusedPass> previous_fused_passes = std::move(fused_passes);
+    fused_passes.clear();
+
+    for (std::vector<RenderPass*> const& pass_group : pass_groups) {
+        if (pass_group.size() < 2) {
+            continue;
+        }
+
+        std::vector<RenderPass const*> source_passes(pass_group.cbegin(), pass_group.cend());
+
+        auto const previous_it = std::find_if(
+            previous_fused_passes.begin(), previous_fused_passes.end(),
+            [&source_passes](FusedPass const& fused_pass) { return (fused_pass.source_passes == source_passes); }
+        );
+
+        FusedPass& fused_pass = fused_passes.emplace_back();
+
+        if (previous_it != previous_fused_passes.end()) {
+            fused_pass = std::move(*previous_it);
+            previous_fused_passes.erase(previous_it);
+        }
+        else {
+            std::vector<RenderPass::PointwiseEffect const*> pointwise_effects;
+            std::string pass_name;
+
+            for (RenderPass const* source_pass : source_passes) {
+                pointwise_effects.emplace_back(&*source_pass->get_pointwise_effect());
+                pass_name += (pass_name.empty() ? "" : " + ") + source_pass->get_name();
+            }
+
+            Log::debug("[RenderGraph] Fusing passes '" + pass_name + "'...");
+
+            fused_pass.source_passes = std::move(source_passes);
+            fused_pass.pass = std::make_unique<RenderPass>(
+                FragmentShader::load_from_source(RenderPass::generate_pointwise_source(pointwise_effects)),
+                std::move(pass_name)
+            );
+        }
+
+        // The fused pass reads the first pass' input & writes into the last pass' output
+        RenderPass& pass = *fused_pass.pass;
+        pass.clear_read_textures();
+        pass.clear_write_textures();
+
+        for (auto const& [texture, uniform_name] : pass_group.front()->get_program().get_textures()) {
+            pass.add_read_texture(texture, uniform_name);
+        }
+
+        for (auto const& [color_buffer, buffer_index] : pass_group.back()->get_framebuffer().get_color_buffers()) {
+            pass.add_write_color_texture(color_buffer, buffer_index);
+        }
+    }
+}
+
+void RenderGraph::compute_barriers(
+    std::vector<std::vector<RenderPass*>> const& pass_groups,
+    std::unordered_map<RenderPass const*, PassResources> const& pass_resources
+)
+{
+    ZoneScopedN("RenderGraph::compute_barriers");
+
+    execution_barriers.assign(pass_groups.size(), BarrierType{});
+
+    // Transient textures sharing the same physical texture are the same memory; writes to one must be made visible
+    //  before the others are accessed
+    auto const recover_physical_resource = [this](ResourceKey const& resource) -> ResourceKey {
+        if (std::holds_alternative<TransientTextureId>(resource)) {
+            Texture2DPtr const& bound_texture = transient_textures[std::get<TransientTextureId>(resource)].bound_texture;
+
+            if (bound_texture) {
+                return bound_texture.get();
+            }
+        }
+
+        return resource;
+    };
+
+    // Resources written with image stores, associated with the barriers issued since. All of them are considered
+    //  written at first, as they may have been during the previous frame
+    std::unordered_map<ResourceKey, BarrierType> image_written_resources;
+
+    for (std::vector<RenderPass*> const& pass_group : pass_groups) {
+        for (ResourceKey const& resource : pass_resources.at(pass_group.back()).image_writes) {
+            image_written_resources.emplace(recover_physical_resource(resource), BarrierType{});
+        }
+    }
+
+    for (size_t group_index = 0; group_index < pass_groups.size(); ++group_index) {
+        // Fused passes never use image textures; a group reads its first pass' inputs & writes its last pass' outputs
+        PassResources const& read_resources = pass_resources.at(pass_groups[group_index].front());
+        PassResources const& written_resources = pass_resources.at(pass_groups[group_index].back());
+
+        BarrierType& barrier = execution_barriers[group_index];
+
+        auto const require_barrier = [&](ResourceKey const& resource, BarrierType barrier_type) {
+            auto const resource_it = image_written_resources.find(recover_physical_resource(resource));
+
+            if (resource_it != image_written_resources.cend() &&
+                (resource_it->second & barrier_type) != barrier_type) {
+                barrier |= barrier_type;
+            }
+        };
+
+        for (auto const& [resource, _] : read_resources.sampled_reads) {
+            require_barrier(resource, BarrierType::TEXTURE_FETCH);
+        }
+
+        for (ResourceKey const& resource : read_resources.image_reads) {
+            require_barrier(resource, BarrierType::SHADER_IMAGE_ACCESS);
+        }
+
+        for (ResourceKey const& resource : written_resources.image_writes) {
+            require_barrier(resource, BarrierType::SHADER_IMAGE_ACCESS);
+        }
+
+        for (auto const& [resource, _] : written_resources.attachment_writes) {
+            require_barrier(resource, BarrierType::FRAMEBUFFER);
+        }
+
+        // A barrier applies to all the previous writes
+        if (barrier != BarrierType{}) {
+            for (auto& [_, issued_barrier] : image_written_resources) {
+                issued_barrier |= barrier;
+            }
+        }
+
+        for (ResourceKey const& resource : written_resources.image_writes) {
+            image_written_resources[recover_physical_resource(resource)] = BarrierType{};
+        }
+    }
+}
+
 void RenderGraph::execute(RenderSystem& render_system)
 {
     ZoneScopedN("RenderGraph::execute");
 
+    if (!is_compiled()) {
+        compile();
+    }
+
+    execute_shadow_pass(render_system);
+
     {
         ZoneScopedN("Renderer::clear");
         Renderer::clear(MaskType::COLOR | MaskType::DEPTH | MaskType::STENCIL);
@@ -54,19 +1040,81 @@ void RenderGraph::execute(RenderSystem& render_system)
 
     execute_geometry_pass(render_system);
 
-    last_executed_pass = &geometry_pass;
+    // The fused passes' parameters may have been changed on their source passes since the last frame
+    for (FusedPass const& fused_pass : fused_passes) {
+        for (RenderPass const* source_pass : fused_pass.source_passes) {
+            fused_pass.pass->get_program().copy_attributes(source_pass->get_program());
+        }
+
+        fused_pass.pass->get_program().send_attributes();
+    }
 
-    executed_passes.reserve(nodes.size() + 1);
-    executed_passes.emplace(&geometry_pass);
+    for (size_t pass_index = 0; pass_index < execution_order.size(); ++pass_index) {
+        if (execution_barriers[pass_index] != BarrierType{}) {
+            Renderer::set_memory_barrier(execution_barriers[pass_index]);
+        }
 
-    for (std::unique_ptr<RenderPass> const& render_pass : nodes) {
-        execute_pass(render_system, *render_pass);
+        execution_order[pass_index]->execute();
     }
 
-    executed_passes.clear();
     deferred_mesh_renderers.clear();
 }
 
+void RenderGraph::execute_shadow_pass(RenderSystem& render_system)
+{
+    ZoneScopedN("RenderGraph::execute_shadow_pass");
+
+    shadow_renderer.begin_frame();
+
+    if (shadow_renderer.is_enabled()) {
+        // Lights are indexed as in the lights uniform buffer, which holds every enabled light
+        uint32_t light_index = 0;
+
+        for (Entity const* entity : render_system.entities) {
+            if (!entity->is_enabled()) {
+                continue;
+            }
+
+            if (entity->has_component<Light>()) {
+                auto const& light = entity->get_component<Light>();
+
+                if (light.has_shadows()) {
+                    Vector3f const light_position = (light.get_type() == LightType::DIRECTIONAL
+                                                         ? Vector3f(0.f)
+                                                         : entity->get_component<Transform>().get_position());
+                    shadow_renderer.add_light(light, light_position, light_index);
+                }
+
+                ++light_index;
+            }
+
+            if (!entity->has_component<MeshRenderer>() || !entity->has_component<Transform>()) {
+                continue;
+            }
+
+            auto const& mesh_renderer = entity->get_component<MeshRenderer>();
+
+            // Entities drawn on top of everything else are not expected to cast shadows
+            if (!mesh_renderer.is_enabled() || mesh_renderer.is_skip_depth()) {
+                continue;
+            }
+
+            Matrix4 const transform = entity->get_component<Transform>().compute_transform();
+
+            if (mesh_renderer.has_bounding_box()) {
+                AABB const bounding_box = compute_world_bounding_box(mesh_renderer.get_bounding_box(), transform);
+                shadow_renderer.add_caster(mesh_renderer, transform, &bounding_box);
+            }
+            else {
+                shadow_renderer.add_caster(mesh_renderer, transform, nullptr);
+            }
+        }
+    }
+
+    auto const& camera = render_system.camera_entity->get_component<Camera>();
+    shadow_renderer.execute(camera, Vector3f(camera.get_inverse_view()[3]), render_system.get_scene_size());
+}
+
 void RenderGraph::execute_geometry_pass(RenderSystem& render_system)
 {
     ZoneScopedN("RenderGraph::execute_geometry_pass");
@@ -84,17 +1132,39 @@ void RenderGraph::execute_geometry_pass(RenderSystem& render_system)
 
     const Framebuffer& geometry_framebuffer = geometry_pass.write_framebuffer;
 
+    bool const is_upscaled = (dynamic_resolution.is_enabled() && !geometry_framebuffer.empty());
+
     if (!geometry_framebuffer.empty()) {
         geometry_framebuffer.bind();
     }
 
+    if (is_upscaled) {
+        dynamic_resolution.begin_geometry();
+    }
+
     if (render_system.has_cubemap()) {
         render_system.get_cubemap().draw();
     }
 
     render_system.model_ubo.bind();
+    material_table.bind();
+
+    auto const& camera = render_system.camera_entity->get_component<Camera>();
 
-    for (Entity const* entity : render_system.entities) {
+    Frustum frustum;
+    frustum.update(camera.get_view(), camera.get_projection());
+
+    occlusion_culler.begin_frame();
+
+    Vector3f const camera_position(camera.get_inverse_view()[3]);
+    auto const viewport_height = static_cast<float>(
+        is_upscaled ? dynamic_resolution.get_render_size().y : render_system.get_scene_height()
+    );
+
+    // Entities not cross-fading their levels of detail are fully drawn
+    render_system.model_ubo.send_data(1.f, sizeof(Matrix4));
+
+    for (Entity* entity : render_system.entities) {
         if (!entity->is_enabled() || !entity->has_component<MeshRenderer>() || !entity->has_component<Transform>()) {
             continue;
         }
@@ -105,20 +1175,114 @@ void RenderGraph::execute_geometry_pass(RenderSystem& render_system)
             continue;
         }
 
+        Matrix4 const transform = entity->get_component<Transform>().compute_transform();
+        MeshLod* mesh_lod = nullptr;
+
+        if (mesh_renderer.has_bounding_box()) {
+            AABB const bounding_box = compute_world_bounding_box(mesh_renderer.get_bounding_box(), transform);
+
+            if (!frustum.aabb_in(bounding_box)) {
+                continue;
+            }
+
+            // Entities drawn on top of everything else can neither be occluded nor occlude others
+            if (!mesh_renderer.is_skip_depth()) {
+                // Occluded entities are still tested, so that they can be drawn again as soon as they become visible
+                occlusion_culler.add_candidate(*entity, bounding_box);
+
+                if (occlusion_culler.is_occluded(*entity)) {
+                    continue;
+                }
+            }
+
+            // The level of detail is selected only for visible entities, their projected size requiring the bounds
+            if (entity->has_component<MeshLod>()) {
+                mesh_lod = &entity->get_component<MeshLod>();
+                mesh_lod->update(
+                    mesh_lod->select_level(compute_pixels_per_unit(
+                        bounding_box, transform, camera.get_projection(), camera_position, viewport_height
+                    )),
+                    render_system.frame_delta_time
+                );
+            }
+        }
+
         if (!mesh_renderer.is_skip_depth()) {
-            render_system.model_ubo.send_data(entity->get_component<Transform>().compute_transform(), 0);
-            mesh_renderer.draw();
+            if (entity->has_component<Mesh>()) {
+                occlusion_culler.add_occluder(entity->get_component<Mesh>(), transform);
+            }
+
+            // Pooled meshes are drawn all at once after the loop
+            if (mesh_lod == nullptr && geometry_pool.record_draw(mesh_renderer, transform)) {
+                continue;
+            }
+
+            render_system.model_ubo.send_data(transform, 0);
+            render_system.send_vertex_format(mesh_renderer.get_vertex_format());
+
+            if (is_upscaled) {
+                // Entities not drawn on the previous frame are considered static
+                auto const previous_transform_it = previous_transforms.find(entity);
+                render_system.send_previous_transform(
+                    previous_transform_it != previous_transforms.cend() ? previous_transform_it->second : transform
+                );
+                current_transforms.emplace(entity, transform);
+            }
+
+            if (mesh_lod == nullptr) {
+                mesh_renderer.draw();
+                continue;
+            }
+
+            auto const draw_level = [&render_system, &mesh_renderer, mesh_lod](size_t level_index) {
+                if (level_index == 0) {
+                    render_system.send_vertex_format(mesh_renderer.get_vertex_format());
+                    mesh_renderer.draw();
+                }
+                else {
+                    render_system.send_vertex_format(mesh_lod->get_vertex_format());
+                    mesh_lod->draw(level_index, mesh_renderer);
+                }
+            };
+
+            if (!mesh_lod->is_cross_fading()) {
+                draw_level(mesh_lod->get_current_level());
+                continue;
+            }
+
+            // Both levels are drawn with complementary dithering patterns, so that no fragment is covered twice
+            render_system.model_ubo.send_data(-mesh_lod->get_fade_progress(), sizeof(Matrix4));
+            draw_level(mesh_lod->get_previous_level());
+            render_system.model_ubo.send_data(mesh_lod->get_fade_progress(), sizeof(Matrix4));
+            draw_level(mesh_lod->get_current_level());
+            render_system.model_ubo.send_data(1.f, sizeof(Matrix4));
         }
         else {
-            deferred_mesh_renderers.emplace_back(
-                &mesh_renderer, entity->get_component<Transform>().compute_transform()
-            );
+            deferred_mesh_renderers.emplace_back(&mesh_renderer, transform);
         }
     }
+
+    render_system.send_vertex_format(VertexFormat::FULL);
+    render_system.send_instanced_transforms(true);
+    geometry_pool.flush();
+    render_system.send_instanced_transforms(false);
+
     execute_deferred_pass(render_system);
 
+    if (is_upscaled) {
+        dynamic_resolution.resolve(geometry_framebuffer);
+    }
+
+    std::swap(previous_transforms, current_transforms);
+    current_transforms.clear();
+
     geometry_framebuffer.unbind();
 
+    occlusion_culler.execute(
+        (geometry_framebuffer.has_depth_buffer() ? &geometry_framebuffer.get_depth_buffer() : nullptr),
+        camera.get_projection() * camera.get_view()
+    );
+
 #if !defined(USE_OPENGL_ES)
     geometry_pass.timer.stop();
 
@@ -139,24 +1303,10 @@ void RenderGraph::execute_deferred_pass(RenderSystem& render_system)
 
     for (auto const& deferred_mesh : deferred_mesh_renderers) {
         render_system.model_ubo.send_data(deferred_mesh.computed_transform, 0);
+        render_system.send_previous_transform(deferred_mesh.computed_transform);
+        render_system.send_vertex_format(deferred_mesh.mesh_render->get_vertex_format());
         deferred_mesh.mesh_render->draw();
     }
     glDepthRange(0.0, 1.0);
 }
-
-void RenderGraph::execute_pass(RenderSystem& render_system, RenderPass const& render_pass)
-{
-    if (executed_passes.find(&render_pass) != executed_passes.cend()) {
-        return;
-    }
-
-    for (RenderPass const* parent_pass : render_pass.parents) {
-        execute_pass(render_system, *parent_pass);
-    }
-
-    render_pass.execute();
-    last_executed_pass = &render_pass;
-
-    executed_passes.emplace(&render_pass);
 }
-}
\ No newline at end of file
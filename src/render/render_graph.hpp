@@ -2,8 +2,13 @@
 
 #include "render/mesh_renderer.hpp"
 #include <data/graph.hpp>
+#include <render/dynamic_resolution.hpp>
+#include <render/geometry_pool.hpp>
+#include <render/material_table.hpp>
+#include <render/occlusion_culler.hpp>
 #include <render/render_pass.hpp>
 #include <render/process/render_process.hpp>
+#include <render/shadow_renderer.hpp>
 #include <render/shader/shader.hpp>
 
 namespace {
@@ -14,8 +19,26 @@ constexpr std::string_view deferred_shader_source = {
 
 namespace xen {
 class Entity;
+class OverlayPlot;
 class RenderSystem;
+enum class BarrierType : uint32_t;
 
+/// GPU time statistics of a pass executed by a render graph.
+struct RenderPassProfile {
+    std::string name{};
+    RenderTimerStats stats{};
+};
+
+/// Render graph, executing its passes in an order where each one comes after all its parents. The graph is compiled
+/// whenever it changes:
+/// - Passes are sorted once; those which are disabled or do not contribute to the final output (the last pass in that
+///   order) nor to a pass with side effects are culled;
+/// - Consecutive passes applying pointwise effects, each reading only the previous one's output, are fused into one;
+/// - The transient textures read & written by the passes are assigned to a pool of physical textures, transient
+///   textures with the same format & size sharing the same physical one as long as their lifetimes do not overlap;
+/// - Memory barriers are inserted only before the passes accessing textures previously written with image stores, as
+///   compute passes do.
+/// The shadow maps, if enabled, are rendered before the geometry pass.
 class RenderGraph : public Graph<RenderPass> {
     friend RenderSystem;
 
@@ -27,12 +50,110 @@ public:
     RenderGraph& operator=(RenderGraph const&) = delete;
     RenderGraph& operator=(RenderGraph&&) = delete;
 
+    /// Checks that the render graph is valid, that is, if all its passes are valid & none of its transient textures is
+    /// both read & written by the same pass.
+    /// \return True if the render graph is valid, false otherwise.
+    /// \see RenderPass::is_valid()
     [[nodiscard]] bool is_valid() const;
 
+    /// Checks if the render graph has been compiled since its last change.
+    /// \return True if the graph is up to date, false if it will be compiled before its next execution.
+    [[nodiscard]] bool is_compiled() const;
+
+    /// Gets the passes in the order they are executed, as determined by the last compilation.
+    /// \return Sorted render passes, the geometry pass & culled passes excluded; fused passes are replaced by the pass
+    ///   executing them.
+    [[nodiscard]] std::vector<RenderPass const*> const& get_execution_order() const { return execution_order; }
+
+    /// Gets the number of passes which have been culled by the last compilation, either because they are disabled or
+    /// because none of their outputs is used.
+    /// \return Number of culled passes.
+    [[nodiscard]] size_t get_culled_pass_count() const { return culled_pass_count; }
+
+    /// Gets the number of passes executing several fused pointwise passes after the last compilation.
+    /// \return Number of fused passes.
+    [[nodiscard]] size_t get_fused_pass_count() const { return fused_passes.size(); }
+
+    [[nodiscard]] size_t get_transient_texture_count() const { return transient_textures.size(); }
+
+    /// Gets the number of physical textures backing the transient ones after the last compilation.
+    /// \return Number of physical textures.
+    [[nodiscard]] size_t get_physical_texture_count() const { return physical_textures.size(); }
+
+    /// Gets the memory occupied by the physical textures backing the transient ones after the last compilation.
+    /// \return Size of the physical textures, in bytes.
+    [[nodiscard]] size_t get_transient_memory_size() const;
+
+    /// Gets the physical texture currently backing a transient texture.
+    /// \note The returned texture may change on the next compilation, & may be shared with other transient textures.
+    /// \param texture_id Identifier of the transient texture.
+    /// \return Reference to the physical texture.
+    [[nodiscard]] Texture2D const& get_transient_texture(TransientTextureId texture_id) const;
+
+    /// Gets the GPU time statistics of the executed passes over the latest frames. The times are read back without
+    ///   ever waiting for the GPU & are thus a few frames behind.
+    /// \note The times are not available with OpenGL ES and will always be 0.
+    /// \return Profile of the geometry pass, followed by those of the passes in execution order.
+    /// \see get_execution_order()
+    [[nodiscard]] std::vector<RenderPassProfile> get_profile() const;
+
+#if !defined(XEN_NO_OVERLAY)
+    /// Pushes the latest GPU time of each executed pass into an overlay plot, adding an entry to it for every pass not
+    ///   plotted yet; this is meant to be called once per frame.
+    /// \param plot Plot to push the times into.
+    void push_profile(OverlayPlot& plot) const;
+#endif
+
     [[nodiscard]] RenderPass const& get_geometry_pass() const { return geometry_pass; }
 
     [[nodiscard]] RenderPass& get_geometry_pass() { return geometry_pass; }
 
+    [[nodiscard]] OcclusionCuller const& get_occlusion_culler() const { return occlusion_culler; }
+
+    /// Gets the occlusion culler, filtering the entities drawn during the geometry pass. It is disabled by default.
+    /// \return Reference to the occlusion culler.
+    [[nodiscard]] OcclusionCuller& get_occlusion_culler() { return occlusion_culler; }
+
+    [[nodiscard]] GeometryPool const& get_geometry_pool() const { return geometry_pool; }
+
+    /// Gets the geometry pool, whose meshes are drawn with a multi-draw call per material during the geometry pass.
+    /// \return Reference to the geometry pool.
+    [[nodiscard]] GeometryPool& get_geometry_pool() { return geometry_pool; }
+
+    [[nodiscard]] MaterialTable const& get_material_table() const { return material_table; }
+
+    /// Gets the material table, holding the parameters of the materials added to it in a storage buffer bound during
+    ///   the geometry pass.
+    /// \return Reference to the material table.
+    [[nodiscard]] MaterialTable& get_material_table() { return material_table; }
+
+    [[nodiscard]] ShadowRenderer const& get_shadow_renderer() const { return shadow_renderer; }
+
+    /// Gets the shadow renderer, rendering the shadow maps of the lights casting shadows before the geometry pass. It
+    ///   is disabled by default.
+    /// \return Reference to the shadow renderer.
+    /// \see Light::enable_shadows()
+    [[nodiscard]] ShadowRenderer& get_shadow_renderer() { return shadow_renderer; }
+
+    [[nodiscard]] DynamicResolution const& get_dynamic_resolution() const { return dynamic_resolution; }
+
+    /// Gets the dynamic resolution, rendering the geometry pass at a lower resolution adapted to the frame time &
+    ///   reconstructing it temporally. It is disabled by default.
+    /// \return Reference to the dynamic resolution.
+    [[nodiscard]] DynamicResolution& get_dynamic_resolution() { return dynamic_resolution; }
+
+    /// Adds a render pass to the graph.
+    /// \tparam Args Types of the arguments to be forwarded to the render pass' constructor.
+    /// \param args Arguments to be forwarded to the render pass' constructor.
+    /// \return Reference to the newly added render pass.
+    template <typename... Args>
+    RenderPass& add_node(Args&&... args);
+
+    /// Removes a render pass from the graph, after unlinking it from all its parents & children & detaching it from the
+    /// transient textures it uses.
+    /// \param render_pass Render pass to be removed.
+    void remove_node(RenderPass& render_pass);
+
     /// Adds a render process to the graph.
     /// \tparam RenderProcessT Type of the process to add; must be derived from RenderProcess.
     /// \tparam Args Types of the arguments to be forwared to the render process.
@@ -41,6 +162,49 @@ public:
     template <typename RenderProcessT, typename... Args>
     RenderProcessT& add_render_process(Args&&... args);
 
+    /// Creates a transient texture, an intermediate buffer whose storage is managed by the graph. Its physical texture
+    /// is only assigned on the next compilation.
+    /// \param colorspace Colorspace of the texture; must not be a depth one.
+    /// \param data_type Data type of the texture.
+    /// \return Identifier of the new transient texture.
+    TransientTextureId create_transient_texture(TextureColorspace colorspace, TextureDataType data_type);
+
+    /// Changes the format of a transient texture; its physical texture is reassigned on the next compilation.
+    /// \param texture_id Identifier of the transient texture.
+    /// \param colorspace New colorspace of the texture; must not be a depth one.
+    /// \param data_type New data type of the texture.
+    void set_transient_texture_format(
+        TransientTextureId texture_id, TextureColorspace colorspace, TextureDataType data_type
+    );
+
+    /// Resizes a transient texture; its physical texture is reassigned on the next compilation.
+    /// \param texture_id Identifier of the transient texture.
+    /// \param size New size of the texture.
+    void resize_transient_texture(TransientTextureId texture_id, Vector2ui const& size);
+
+    /// Makes a render pass read a transient texture.
+    /// \param render_pass Render pass reading the texture.
+    /// \param texture_id Identifier of the transient texture.
+    /// \param uniform_name Name of the uniform sampler the texture is bound to.
+    void add_transient_read_texture(RenderPass& render_pass, TransientTextureId texture_id, std::string uniform_name);
+
+    /// Makes a render pass write into a transient texture.
+    /// \param render_pass Render pass writing the texture.
+    /// \param texture_id Identifier of the transient texture.
+    /// \param index Buffer's index (location of the shader's output value).
+    void add_transient_write_texture(RenderPass& render_pass, TransientTextureId texture_id, uint32_t index);
+
+    /// Forces the graph to be compiled before its next execution. Adding or removing nodes or transient textures, as
+    /// well as changing the passes' links, textures or states already do so; this must only be called when modifying a
+    /// pass in another way that changes the graph's analysis.
+    void invalidate() { needs_compilation = true; }
+
+    /// Compiles the graph: sorts the passes in execution order, culls & fuses them, computes the lifetime of each
+    /// transient texture & binds them to physical textures, aliasing those with compatible formats whose lifetimes do
+    /// not overlap, then determines the memory barriers to be issued.
+    /// \note This is done automatically on execution when the graph has changed.
+    void compile();
+
     void resize_viewport(Vector2ui const& size);
 
     void update_shaders() const;
@@ -51,18 +215,130 @@ private:
         Matrix4 computed_transform;
     };
 
+    /// Intermediate buffer whose storage is provided by a physical texture of the graph.
+    struct TransientTexture {
+        TextureColorspace colorspace;
+        TextureDataType data_type;
+        Vector2ui size{};
+        std::vector<std::pair<RenderPass*, std::string>> reads{};
+        std::vector<std::pair<RenderPass*, uint32_t>> writes{};
+        Texture2DPtr bound_texture{};
+    };
+
+    /// Texture backing one or several transient textures.
+    struct PhysicalTexture {
+        Texture2DPtr texture;
+        size_t last_use; ///< Index in the execution order of the last pass using the texture.
+    };
+
+    /// Resource accessed by a pass: either a texture given by the user, or a transient texture.
+    using ResourceKey = std::variant<Texture const*, TransientTextureId>;
+
+    /// Resources accessed by a pass, gathered on compilation.
+    struct PassResources {
+        std::vector<std::pair<ResourceKey, std::string>> sampled_reads{};
+        std::vector<ResourceKey> image_reads{};
+        std::vector<ResourceKey> image_writes{};
+        /// Resources written as framebuffer attachments, with their color buffer index; the depth buffer's is the
+        /// maximum value.
+        std::vector<std::pair<ResourceKey, uint32_t>> attachment_writes{};
+    };
+
+    /// Pass generated to execute consecutive pointwise passes at once.
+    struct FusedPass {
+        std::vector<RenderPass const*> source_passes;
+        std::unique_ptr<RenderPass> pass;
+    };
+
     std::vector<DeferredRender> deferred_mesh_renderers;
 
     RenderPass geometry_pass{};
+    OcclusionCuller occlusion_culler{};
+    GeometryPool geometry_pool{};
+    MaterialTable material_table{};
+    ShadowRenderer shadow_renderer{};
+    DynamicResolution dynamic_resolution{};
+    /// Transforms of the entities drawn during the previous & current geometry passes, to compute their motion.
+    std::unordered_map<Entity const*, Matrix4> previous_transforms{};
+    std::unordered_map<Entity const*, Matrix4> current_transforms{};
     std::vector<std::unique_ptr<RenderProcess>> render_processes{};
-    std::unordered_set<RenderPass const*> executed_passes{};
+    std::vector<RenderPass const*> execution_order{};
     RenderPass const* last_executed_pass{};
 
+    bool needs_compilation = true;
+    uint64_t compiled_signature = 0;
+    size_t culled_pass_count = 0;
+    std::vector<BarrierType> execution_barriers{};
+    std::vector<FusedPass> fused_passes{};
+    std::vector<TransientTexture> transient_textures{};
+    std::vector<PhysicalTexture> physical_textures{};
+
 private:
-    /// Executes the render graph, executing all passes starting with the geometry's.
+    /// Computes a signature of the passes' links, textures & states, to detect changes requiring a compilation.
+    /// \return Signature of the graph.
+    uint64_t compute_signature() const;
+
+    /// Sorts the passes so that each one comes after all its parents.
+    /// \return Sorted render passes, the geometry pass excluded.
+    std::vector<RenderPass*> sort_passes() const;
+
+    /// Gathers the resources accessed by a render pass.
+    /// \param render_pass Render pass to gather the resources of.
+    /// \param physical_textures Textures backing transient ones, which are ignored.
+    /// \return Resources accessed by the render pass.
+    PassResources gather_resources(
+        RenderPass const& render_pass, std::unordered_set<Texture const*> const& physical_textures
+    ) const;
+
+    /// Removes the disabled passes & those that contribute neither to the final output nor to a pass with side effects.
+    /// \param sorted_passes Sorted render passes.
+    /// \param pass_resources Resources accessed by each pass.
+    /// \return Passes to be executed, in order.
+    std::vector<RenderPass*> cull_passes(
+        std::vector<RenderPass*> const& sorted_passes,
+        std::unordered_map<RenderPass const*, PassResources> const& pass_resources
+    ) const;
+
+    /// Groups consecutive pointwise passes which can be fused, each one reading only the previous one's output.
+    /// \param executed_passes Passes to be executed, in order.
+    /// \param pass_resources Resources accessed by each pass.
+    /// \param fused_transient_textures Transient textures only used between fused passes, which need no storage.
+    /// \return Groups of passes, in order; groups of a single pass are executed as is.
+    std::vector<std::vector<RenderPass*>> group_fusable_passes(
+        std::vector<RenderPass*> const& executed_passes,
+        std::unordered_map<RenderPass const*, PassResources> const& pass_resources,
+        std::unordered_set<TransientTextureId>& fused_transient_textures
+    ) const;
+
+    /// Binds the transient textures to physical ones, aliasing those whose lifetimes do not overlap.
+    /// \param pass_indices Index in the execution order of each pass; culled passes have the maximum value.
+    /// \param fused_transient_textures Transient textures only used between fused passes, left unbound.
+    void assign_transient_textures(
+        std::unordered_map<RenderPass const*, size_t> const& pass_indices,
+        std::unordered_set<TransientTextureId> const& fused_transient_textures
+    );
+
+    /// Creates the passes executing each group of fused passes, reusing those from the previous compilation if any.
+    /// \param pass_groups Groups of passes, in order.
+    void create_fused_passes(std::vector<std::vector<RenderPass*>> const& pass_groups);
+
+    /// Determines the memory barriers to be issued before each group of passes, needed for the textures previously
+    /// written with image stores, whose writes are not automatically visible.
+    /// \param pass_groups Groups of passes, in order.
+    /// \param pass_resources Resources accessed by each pass.
+    void compute_barriers(
+        std::vector<std::vector<RenderPass*>> const& pass_groups,
+        std::unordered_map<RenderPass const*, PassResources> const& pass_resources
+    );
+
+    /// Executes the render graph, executing all passes starting with the geometry's, compiling it beforehand if needed.
     /// \param render_system Render system executing the render graph.
     void execute(RenderSystem& render_system);
 
+    /// Gathers the lights casting shadows & the shadow casters, then renders the shadow maps.
+    /// \param render_system Render system executing the render graph.
+    void execute_shadow_pass(RenderSystem& render_system);
+
     /// Executes the geometry pass.
     /// \param render_system Render system executing the render graph.
     void execute_geometry_pass(RenderSystem& render_system);
@@ -70,11 +346,6 @@ private:
     /// Executes the geometry pass.
     /// \param render_system Render system executing the render graph.
     void execute_deferred_pass(RenderSystem& render_system);
-
-    /// Executes a render pass, which in turn recursively executes its parents if they have not already been in the
-    /// current frame.
-    /// \param render_pass Render pass to be executed.
-    void execute_pass(RenderSystem& render_system, RenderPass const& render_pass);
 };
 }
 
@@ -1,4 +1,11 @@
 namespace xen {
+template <typename... Args>
+RenderPass& RenderGraph::add_node(Args&&... args)
+{
+    needs_compilation = true;
+    return Graph<RenderPass>::add_node(std::forward<Args>(args)...);
+}
+
 template <typename RenderProcessT, typename... Args>
 RenderProcessT& RenderGraph::add_render_process(Args&&... args)
 {
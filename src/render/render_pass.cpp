@@ -34,15 +34,129 @@ bool RenderPass::is_valid() const
         }
     }
 
+#if !defined(USE_OPENGL_ES)
+    // Images can only have 1, 2 or 4 channels & a linear colorspace; a compute pass cannot write any depth buffer
+    if (compute_enabled) {
+        if (write_framebuffer.has_depth_buffer()) {
+            return false;
+        }
+
+        for (auto const& [color_buffer, _] : write_color_buffers) {
+            TextureColorspace const colorspace = color_buffer->get_colorspace();
+
+            if (colorspace != TextureColorspace::GRAY && colorspace != TextureColorspace::RG &&
+                colorspace != TextureColorspace::RGBA) {
+                return false;
+            }
+        }
+    }
+#endif
+
     return true;
 }
 
+bool RenderPass::is_compute_supported()
+{
+#if !defined(USE_OPENGL_ES)
+    return Renderer::check_version(4, 3);
+#else
+    return false;
+#endif
+}
+
+#if !defined(USE_OPENGL_ES)
+void RenderPass::set_compute_program(ComputeShaderProgram&& compute_program, Vector2ui const& tile_size)
+{
+    Log::rt_assert(tile_size.x > 0 && tile_size.y > 0, "Error: A compute pass' tile size must not be null.");
+
+    this->compute_program = std::make_unique<ComputeShaderProgram>(std::move(compute_program));
+    compute_tile_size = tile_size;
+
+    for (auto const& [texture, uniform_name] : program.get_textures()) {
+        this->compute_program->set_texture(texture, uniform_name);
+    }
+
+    this->compute_program->init_textures();
+    this->compute_program->copy_attributes(program);
+    this->compute_program->send_attributes();
+}
+
+void RenderPass::enable_compute(bool enabled)
+{
+    Log::rt_assert(!enabled || compute_program != nullptr, "Error: The render pass has no compute program.");
+    compute_enabled = enabled;
+}
+#endif
+
+std::string RenderPass::generate_pointwise_source(std::vector<PointwiseEffect const*> const& pointwise_effects)
+{
+    std::string source = "in vec2 fragTexcoords;\n\n"
+                         "uniform sampler2D uniBuffer;\n\n"
+                         "layout(location = 0) out vec4 fragColor;\n";
+
+    for (PointwiseEffect const* pointwise_effect : pointwise_effects) {
+        source += '\n' + pointwise_effect->function_source + '\n';
+    }
+
+    source += "\nvoid main() {\n"
+              "  vec3 color = texture(uniBuffer, fragTexcoords).rgb;\n";
+
+    for (PointwiseEffect const* pointwise_effect : pointwise_effects) {
+        source += "  color = " + pointwise_effect->function_name + "(color, fragTexcoords);\n";
+    }
+
+    source += "  fragColor = vec4(color, 1.0);\n"
+              "}\n";
+
+    return source;
+}
+
 void RenderPass::add_read_texture(TexturePtr texture, std::string const& uniform_name)
 {
+#if !defined(USE_OPENGL_ES)
+    if (compute_program) {
+        compute_program->set_texture(texture, uniform_name);
+        compute_program->init_textures();
+    }
+#endif
+
     program.set_texture(std::move(texture), uniform_name);
     program.init_textures();
 }
 
+void RenderPass::remove_read_texture(Texture const& texture)
+{
+#if !defined(USE_OPENGL_ES)
+    if (compute_program) {
+        compute_program->remove_texture(texture);
+    }
+#endif
+
+    program.remove_texture(texture);
+}
+
+void RenderPass::remove_read_texture(std::string const& uniform_name)
+{
+#if !defined(USE_OPENGL_ES)
+    if (compute_program) {
+        compute_program->remove_texture(uniform_name);
+    }
+#endif
+
+    program.remove_texture(uniform_name);
+}
+
+void RenderPass::clear_read_textures()
+{
+#if !defined(USE_OPENGL_ES)
+    if (compute_program) {
+        compute_program->clear_textures();
+    }
+#endif
+
+    program.clear_textures();
+}
+
 void RenderPass::execute() const
 {
     ZoneScopedN("RenderPass::execute");
@@ -64,14 +178,22 @@ void RenderPass::execute() const
     timer.start();
 #endif
 
-    // Binding the program's textures marks it as used
-    program.bind_textures();
+#if !defined(USE_OPENGL_ES)
+    if (compute_enabled) {
+        execute_compute();
+    }
+    else
+#endif
+    {
+        // Binding the program's textures marks it as used
+        program.bind_textures();
 
-    if (!write_framebuffer.empty()) {
-        write_framebuffer.bind();
+        if (!write_framebuffer.empty()) {
+            write_framebuffer.bind();
+        }
+        write_framebuffer.display();
+        write_framebuffer.unbind();
     }
-    write_framebuffer.display();
-    write_framebuffer.unbind();
 
 #if !defined(USE_OPENGL_ES)
     timer.stop();
@@ -84,4 +206,28 @@ void RenderPass::execute() const
 #endif
 }
 
+#if !defined(USE_OPENGL_ES)
+void RenderPass::execute_compute() const
+{
+    std::vector<std::pair<Texture2DPtr, uint32_t>> const& color_buffers = write_framebuffer.get_color_buffers();
+    Log::rt_assert(!color_buffers.empty(), "Error: A compute pass must have at least one write color buffer.");
+
+    // Binding the program's textures marks it as used
+    compute_program->bind_textures();
+
+    for (auto const& [color_buffer, buffer_index] : color_buffers) {
+        Renderer::bind_image_texture(
+            buffer_index, color_buffer->get_index(), 0, false, 0, ImageAccess::WRITE,
+            ShaderProgram::recover_image_texture_format(*color_buffer)
+        );
+    }
+
+    // The memory barriers needed by the following passes are issued by the render graph
+    Vector2ui const& output_size = color_buffers.front().first->get_size();
+    Renderer::dispatch_compute(Vector3ui(
+        (output_size.x + compute_tile_size.x - 1) / compute_tile_size.x,
+        (output_size.y + compute_tile_size.y - 1) / compute_tile_size.y, 1
+    ));
+}
+#endif
 }
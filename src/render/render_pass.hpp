@@ -12,6 +12,16 @@ namespace xen {
 class RenderPass final : public GraphNode<RenderPass> {
     friend class RenderGraph;
 
+public:
+    /// Color transformation applied independently to each pixel of a pass' input. Consecutive passes applying such
+    /// effects can be fused by the render graph into a single one, avoiding the intermediate buffers' writes & reads.
+    struct PointwiseEffect {
+        /// GLSL source of the effect, declaring its uniforms & its function, whose signature must be
+        /// `vec3 function_name(vec3 color, vec2 texcoords)`. All its identifiers must be unique among all effects.
+        std::string function_source;
+        std::string function_name;
+    };
+
 public:
     RenderPass() = default;
     RenderPass(VertexShader&& vert_shader, FragmentShader&& frag_shader, std::string pass_name = {}) :
@@ -32,12 +42,35 @@ public:
 
     [[nodiscard]] bool is_enabled() const { return enabled; }
 
+    [[nodiscard]] bool has_side_effects() const { return side_effects; }
+
+    /// Checks if the render pass is executed with its compute program instead of its render one.
+    /// \return True if the pass dispatches its compute program, false if it draws with its render program.
+    [[nodiscard]] bool is_compute_enabled() const
+    {
+#if !defined(USE_OPENGL_ES)
+        return compute_enabled;
+#else
+        return false;
+#endif
+    }
+
+    [[nodiscard]] std::optional<PointwiseEffect> const& get_pointwise_effect() const { return pointwise_effect; }
+
     [[nodiscard]] std::string const& get_name() const { return name; }
 
     [[nodiscard]] RenderShaderProgram const& get_program() const { return program; }
 
     [[nodiscard]] RenderShaderProgram& get_program() { return program; }
 
+#if !defined(USE_OPENGL_ES)
+    [[nodiscard]] bool has_compute_program() const { return (compute_program != nullptr); }
+
+    [[nodiscard]] ComputeShaderProgram const& get_compute_program() const { return *compute_program; }
+
+    [[nodiscard]] ComputeShaderProgram& get_compute_program() { return *compute_program; }
+#endif
+
     [[nodiscard]] size_t get_read_texture_count() const { return program.get_texture_count(); }
 
     [[nodiscard]] Texture const& get_read_texture(size_t texture_index) const
@@ -57,7 +90,8 @@ public:
 
     [[nodiscard]] Framebuffer const& get_framebuffer() const { return write_framebuffer; }
 
-    /// Recovers the elapsed time (in milliseconds) of the pass' execution.
+    /// Recovers the elapsed time (in milliseconds) of the pass' execution. The GPU times are read back without waiting
+    ///   for them, & are thus usually a few frames old.
     /// \note This action is not available with OpenGL ES and will always return 0.
     /// \return Time taken to execute the pass.
     [[nodiscard]] float recover_elapsed_time() const
@@ -69,10 +103,62 @@ public:
 #endif
     }
 
+    /// Recovers the statistics of the pass' elapsed times (in milliseconds) over the latest frames.
+    /// \note This action is not available with OpenGL ES and will always return empty statistics.
+    /// \return Statistics of the time taken to execute the pass.
+    /// \see RenderTimer::sample_window_size
+    [[nodiscard]] RenderTimerStats recover_elapsed_time_stats() const
+    {
+#if !defined(USE_OPENGL_ES)
+        return timer.recover_stats();
+#else
+        return {};
+#endif
+    }
+
     void set_name(std::string name) { this->name = std::move(name); }
 
     void set_program(RenderShaderProgram&& program) { this->program = std::move(program); }
 
+    /// Sets an attribute & sends it to the pass' render program, as well as to its compute program if any.
+    /// \tparam T Type of the attribute to set.
+    /// \param attrib_val Attribute to set.
+    /// \param uniform_name Uniform name of the attribute to set.
+    template <typename T>
+    void send_attribute(T&& attrib_val, std::string const& uniform_name)
+    {
+#if !defined(USE_OPENGL_ES)
+        if (compute_program) {
+            compute_program->set_attribute(attrib_val, uniform_name);
+            compute_program->send_attributes();
+        }
+#endif
+
+        program.set_attribute(std::forward<T>(attrib_val), uniform_name);
+        program.send_attributes();
+    }
+
+    /// Checks if compute programs can be executed by render passes, which requires OpenGL 4.3+.
+    /// \return True if compute programs are supported, false otherwise; always false with OpenGL ES.
+    [[nodiscard]] static bool is_compute_supported();
+
+#if !defined(USE_OPENGL_ES)
+    /// Sets a compute program able to execute the pass in place of its render program, taking the same inputs &
+    /// writing the same outputs. The pass' read textures are bound to both programs, thus their sampler uniforms must
+    /// share the same names; its attributes are copied into the compute program. Each write color buffer is bound as a
+    /// write-only image to the unit matching its index.
+    /// \param compute_program Compute program to be set.
+    /// \param tile_size Number of pixels of the first write color buffer covered by each work group.
+    void set_compute_program(ComputeShaderProgram&& compute_program, Vector2ui const& tile_size);
+
+    /// Changes whether the render pass is executed with its compute program or its render one.
+    /// \note A compute program must have been set beforehand for compute to be enabled.
+    /// \param enabled True if the compute program should be executed, false if the render program should be.
+    void enable_compute(bool enabled = true);
+
+    void disable_compute() { enable_compute(false); }
+#endif
+
     /// Changes the render pass' enabled state.
     /// \param enabled True if the render pass should be enabled, false if it should be disabled.
     void enable(bool enabled = true) { this->enabled = enabled; }
@@ -80,17 +166,39 @@ public:
     /// Disables the render pass.
     void disable() { enable(false); }
 
+    /// Marks the render pass as having side effects, that is, writing into buffers used outside of the render graph.
+    /// Such a pass is never culled nor fused, even if none of its outputs contributes to the final image.
+    /// \param side_effects True if the render pass has side effects, false otherwise.
+    void set_side_effects(bool side_effects = true) { this->side_effects = side_effects; }
+
+    /// Declares the per-pixel effect applied by the render pass, allowing it to be fused with consecutive ones. The
+    /// pass' program must be equivalent to the one generated from the effect.
+    /// \param pointwise_effect Effect applied by the render pass.
+    /// \see generate_pointwise_source()
+    void set_pointwise_effect(PointwiseEffect pointwise_effect)
+    {
+        this->pointwise_effect = std::move(pointwise_effect);
+    }
+
+    /// Generates the source of a fragment shader applying one or several pointwise effects in sequence to the texture
+    /// bound to the `uniBuffer` uniform, sampled at the fragment's texcoords.
+    /// \param pointwise_effects Effects to be applied, in order.
+    /// \return Source of the fragment shader.
+    static std::string generate_pointwise_source(std::vector<PointwiseEffect const*> const& pointwise_effects);
+
     /// Checks that the current render pass is valid, that is, if none of its buffer has been defined as both read &
-    /// write.
+    /// write, & if executed with its compute program, if all its write buffers can be bound as images.
     /// \return True if the render pass is valid, false otherwise.
     /// \see RenderGraph::is_valid()
     bool is_valid() const;
 
     void add_read_texture(TexturePtr texture, std::string const& uniform_name);
 
-    void remove_read_texture(Texture const& texture) { program.remove_texture(texture); }
+    void remove_read_texture(Texture const& texture);
+
+    void remove_read_texture(std::string const& uniform_name);
 
-    void clear_read_textures() { program.clear_textures(); }
+    void clear_read_textures();
 
     /// Sets the write depth buffer texture.
     /// \param texture Depth buffer texture to be set; must have a depth colorspace.
@@ -118,12 +226,25 @@ public:
 
 private:
     bool enabled = true;
+    bool side_effects = false;
     std::string name{};
+    std::optional<PointwiseEffect> pointwise_effect{};
     RenderShaderProgram program{};
     Framebuffer write_framebuffer{};
 
 #if !defined(USE_OPENGL_ES)
-    RenderTimer timer{};
+    bool compute_enabled = false;
+    std::unique_ptr<ComputeShaderProgram> compute_program{};
+    Vector2ui compute_tile_size{};
+
+    // Measuring the execution does not alter the pass itself
+    mutable RenderTimer timer{};
+#endif
+
+private:
+#if !defined(USE_OPENGL_ES)
+    /// Dispatches the compute program over the first write color buffer, all of them being bound as images.
+    void execute_compute() const;
 #endif
 };
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <render/light.hpp>
 #include <render/mesh_renderer.hpp>
 #include <render/renderer.hpp>
+#include <utils/file_watcher.hpp>
 #if defined(XEN_USE_XR)
 #include <xr/xr_system.hpp>
 #endif
@@ -28,6 +29,9 @@ void RenderSystem::enable_xr(XrSystem& xr_system)
 {
     this->xr_system = &xr_system;
 
+    // Each eye would be reconstructed from the other's history
+    render_graph.dynamic_resolution.disable();
+
     xr_system.initialize_session();
     resize_viewport(xr_system.get_optimal_view_size());
 }
@@ -53,6 +57,8 @@ bool RenderSystem::update(FrameTimeInfo const& time_info)
     ZoneScopedN("RenderSystem::update");
     TracyGpuZone("RenderSystem::update");
 
+    update_outdated_shaders();
+
     camera_ubo.bind_base(0);
     lights_ubo.bind_base(1);
     time_ubo.bind_base(2);
@@ -70,6 +76,23 @@ bool RenderSystem::update(FrameTimeInfo const& time_info)
         time_ubo.bind_uniform_block(pass_program, "uboTimeInfo", 2);
     }
 
+    // The motion buffer of the dynamic resolution must be attached to the geometry pass before compiling the graph
+    render_graph.dynamic_resolution.begin_frame(render_graph.geometry_pass, size);
+
+    // Compiling the graph beforehand, so that the passes it may generate get their uniform blocks bound as well
+    if (!render_graph.is_compiled()) {
+        render_graph.compile();
+    }
+
+    for (RenderGraph::FusedPass const& fused_pass : render_graph.fused_passes) {
+        RenderShaderProgram const& pass_program = fused_pass.pass->get_program();
+        camera_ubo.bind_uniform_block(pass_program, "uboCameraInfo", 0);
+        lights_ubo.bind_uniform_block(pass_program, "uboLightsInfo", 1);
+        time_ubo.bind_uniform_block(pass_program, "uboTimeInfo", 2);
+    }
+
+    frame_delta_time = time_info.delta_time;
+
     time_ubo.bind();
     time_ubo.send_data(time_info.delta_time, 0);
     time_ubo.send_data(time_info.global_time, sizeof(float));
@@ -81,10 +104,19 @@ bool RenderSystem::update(FrameTimeInfo const& time_info)
     else
 #endif
     {
+        if (camera_entity) {
+            camera_entity->get_component<Camera>().set_jitter(render_graph.dynamic_resolution.get_jitter());
+        }
+
         send_camera_info();
         render_graph.execute(*this);
     }
 
+    render_graph.dynamic_resolution.end_frame();
+
+    // The frame is read back before the window's buffers are swapped, & thus without the overlay
+    frame_capturer.update(size);
+
 #if defined(XEN_CONFIG_DEBUG) && !defined(XEN_SKIP_RENDERER_ERRORS)
     Renderer::print_errors();
 #endif
@@ -146,6 +178,53 @@ void RenderSystem::update_shaders() const
     }
 }
 
+void RenderSystem::update_outdated_shaders()
+{
+    uint64_t const reload_count = FileWatcher::get_reload_count();
+
+    if (reload_count == checked_reload_count) {
+        return;
+    }
+
+    ZoneScopedN("RenderSystem::update_outdated_shaders");
+
+    checked_reload_count = reload_count;
+
+    for (size_t i = 0; i < render_graph.get_node_count(); ++i) {
+        RenderPass& render_pass = render_graph.get_node(i);
+
+        if (render_pass.get_program().has_outdated_shaders()) {
+            render_pass.get_program().update_shaders();
+
+            // Fused passes are generated from the shaders of the passes they execute
+            render_graph.invalidate();
+        }
+
+#if !defined(USE_WEBGL)
+        if (render_pass.has_compute_program() && render_pass.get_compute_program().has_outdated_shaders()) {
+            render_pass.get_compute_program().update_shaders();
+        }
+#endif
+    }
+
+    for (Entity* entity : entities) {
+        if (!entity->has_component<MeshRenderer>()) {
+            continue;
+        }
+
+        auto& mesh_renderer = entity->get_component<MeshRenderer>();
+
+        for (Material& material : mesh_renderer.get_materials()) {
+            if (material.get_program().has_outdated_shaders()) {
+                material.get_program().update_shaders();
+            }
+        }
+
+        // The mesh renderer's materials may also have been replaced by those of a reloaded mesh
+        update_materials(mesh_renderer);
+    }
+}
+
 void RenderSystem::update_materials(MeshRenderer const& mesh_renderer) const
 {
     ZoneScopedN("RenderSystem::update_materials(MeshRenderer)");
@@ -163,6 +242,7 @@ void RenderSystem::update_materials(MeshRenderer const& mesh_renderer) const
         lights_ubo.bind_uniform_block(material_program, "uboLightsInfo", 1);
         time_ubo.bind_uniform_block(material_program, "uboTimeInfo", 2);
         model_ubo.bind_uniform_block(material_program, "uboModelInfo", 3);
+        render_graph.get_shadow_renderer().bind_program(material_program);
     }
 }
 
@@ -207,6 +287,8 @@ void RenderSystem::save_to_image(FilePath const& filepath, TextureFormat format,
 
 void RenderSystem::destroy()
 {
+    frame_capturer.flush();
+
 #if !defined(XEN_NO_WINDOW)
     if (window) {
         window->set_should_close();
@@ -250,6 +332,8 @@ void RenderSystem::init()
     Renderer::enable(Capability::DEPTH_TEST);
     Renderer::enable(Capability::STENCIL_TEST);
 
+    camera_ubo.bind_uniform_block(render_graph.dynamic_resolution.get_program(), "uboCameraInfo", 0);
+
 #if !defined(USE_OPENGL_ES)
     Renderer::enable(Capability::CUBEMAP_SEAMLESS);
 #endif
@@ -276,7 +360,7 @@ void RenderSystem::init(Vector2ui const& scene_size)
     resize_viewport(scene_size);
 }
 
-void RenderSystem::send_camera_info() const
+void RenderSystem::send_camera_info()
 {
     Log::rt_assert(camera_entity != nullptr, "Error: The render system needs a camera to send its info.");
     Log::rt_assert(
@@ -309,7 +393,16 @@ void RenderSystem::send_camera_info() const
 
     send_projection(camera.get_projection());
     send_inverse_projection(camera.get_inverse_projection());
-    send_view_projection(camera.get_projection() * camera.get_view());
+
+    Matrix4 const view_projection = camera.get_projection() * camera.get_view();
+    send_view_projection(view_projection);
+    send_previous_view_projection(previous_view_projection);
+
+    Vector2f const& jitter = camera.get_jitter();
+    send_jitters(Vector4f(jitter.x, jitter.y, previous_jitter.x, previous_jitter.y));
+
+    previous_view_projection = view_projection;
+    previous_jitter = jitter;
 }
 
 void RenderSystem::update_light(Entity const& entity, uint32_t light_index) const
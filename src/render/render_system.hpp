@@ -2,6 +2,7 @@
 
 #include <system.hpp>
 #include <render/cubemap.hpp>
+#include <render/frame_capturer.hpp>
 #include <render/renderer.hpp>
 #include <render/render_graph.hpp>
 #include <render/platform/uniform_buffer.hpp>
@@ -79,6 +80,12 @@ public:
 
     RenderGraph& get_render_graph() { return render_graph; }
 
+    FrameCapturer const& get_frame_capturer() const { return frame_capturer; }
+
+    /// Gets the frame capturer, reading back the rendered frames asynchronously at the end of each update.
+    /// \return Reference to the frame capturer.
+    FrameCapturer& get_frame_capturer() { return frame_capturer; }
+
     bool has_cubemap() const { return cubemap.has_value(); }
 
     Cubemap const& get_cubemap() const
@@ -112,6 +119,11 @@ public:
 
     void update_shaders() const;
 
+    /// Updates the shaders of the programs, whether of passes or materials, having some of them reloaded by the file
+    ///   watcher. Called on every update, only checking the programs once new reloads have been applied.
+    /// \see FileWatcher
+    void update_outdated_shaders();
+
     void update_materials(MeshRenderer const& mesh_renderer) const;
 
     void update_materials() const;
@@ -120,6 +132,7 @@ public:
     /// \warning The pixel storage pack & unpack alignments should be set to 1 in order to recover actual pixels.
     /// \see Renderer::set_pixel_storage()
     /// \warning Retrieving an image from the GPU is slow; use this function with caution.
+    /// \see get_frame_capturer() to save frames without waiting for the GPU.
     void save_to_image(
         FilePath const& filepath, TextureFormat format = TextureFormat::RGB,
         PixelDataType data_type = PixelDataType::UBYTE
@@ -141,11 +154,19 @@ private:
 
     Entity* camera_entity{};
     RenderGraph render_graph;
-    UniformBuffer camera_ubo = UniformBuffer(sizeof(Matrix4) * 5 + sizeof(Vector4f), UniformBufferUsage::DYNAMIC);
+    FrameCapturer frame_capturer{};
+    UniformBuffer camera_ubo = UniformBuffer(sizeof(Matrix4) * 6 + sizeof(Vector4f) * 2, UniformBufferUsage::DYNAMIC);
     UniformBuffer lights_ubo =
         UniformBuffer(sizeof(Vector4f) * 4 * 100 + sizeof(Vector4ui), UniformBufferUsage::DYNAMIC);
     UniformBuffer time_ubo = UniformBuffer(sizeof(float) * 2, UniformBufferUsage::STREAM);
-    UniformBuffer model_ubo = UniformBuffer(sizeof(Matrix4), UniformBufferUsage::STREAM);
+    UniformBuffer model_ubo = UniformBuffer(sizeof(Matrix4) * 2 + sizeof(Vector4f), UniformBufferUsage::STREAM);
+    float frame_delta_time = 0.f;
+    /// Number of reloads applied by the file watcher when the outdated shaders have last been checked for.
+    uint64_t checked_reload_count = 0;
+
+    /// Camera's view-projection matrix & jitter of the previous frame, from which the motion vectors are computed.
+    Matrix4 previous_view_projection{};
+    Vector2f previous_jitter{};
 
     std::optional<Cubemap> cubemap{};
 
@@ -158,7 +179,7 @@ private:
 
     void init(Vector2ui const& scene_size);
 
-    void send_camera_info() const;
+    void send_camera_info();
 
     void send_view(Matrix4 const& view) const { camera_ubo.send_data(view, 0); }
 
@@ -181,6 +202,46 @@ private:
         camera_ubo.send_data(camera_pos, sizeof(Matrix4) * 5);
     }
 
+    void send_previous_view_projection(Matrix4 const& view_projection) const
+    {
+        camera_ubo.send_data(view_projection, sizeof(Matrix4) * 5 + sizeof(Vector4f));
+    }
+
+    /// Sends the camera's projection jitters, used to remove it from the motion vectors.
+    /// \warning The camera UBO needs to be bound before calling this function.
+    /// \param jitters Current jitter in XY, previous one in ZW.
+    void send_jitters(Vector4f const& jitters) const
+    {
+        camera_ubo.send_data(jitters, sizeof(Matrix4) * 6 + sizeof(Vector4f));
+    }
+
+    /// Tells the vertex shader whether the next mesh's vertices are quantized.
+    /// \warning The model UBO needs to be bound before calling this function.
+    /// \param vertex_format Vertex format of the mesh about to be drawn.
+    void send_vertex_format(VertexFormat vertex_format) const
+    {
+        model_ubo.send_data(
+            static_cast<uint32_t>(vertex_format == VertexFormat::QUANTIZED), sizeof(Matrix4) + sizeof(float)
+        );
+    }
+
+    /// Tells the vertex shader whether the transforms are to be read from the instanced vertex attribute instead of
+    /// the model UBO, as done when drawing from the geometry pool.
+    /// \warning The model UBO needs to be bound before calling this function.
+    /// \param instanced True to use the instanced transforms, false to use the model UBO's.
+    void send_instanced_transforms(bool instanced) const
+    {
+        model_ubo.send_data(static_cast<uint32_t>(instanced), sizeof(Matrix4) + sizeof(float) * 2);
+    }
+
+    /// Sends the transform the next mesh had during the previous frame, from which its motion vectors are computed.
+    /// \warning The model UBO needs to be bound before calling this function.
+    /// \param transform Previous transformation matrix of the mesh.
+    void send_previous_transform(Matrix4 const& transform) const
+    {
+        model_ubo.send_data(transform, sizeof(Matrix4) + sizeof(Vector4f));
+    }
+
     /// Updates a single light, sending its data to the GPU.
     /// \warning The lights UBO needs to be bound before calling this function.
     /// \note If resetting a removed light or updating one not yet known by the application, call update_lights()
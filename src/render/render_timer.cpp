@@ -8,40 +8,123 @@ namespace xen {
 RenderTimer::RenderTimer()
 {
 #if !defined(USE_OPENGL_ES)
-    Renderer::generate_query(index);
+    for (auto& query_index : query_indices) {
+        Renderer::generate_query(query_index);
+    }
+
+    samples.reserve(sample_window_size);
 #endif
 }
 
-void RenderTimer::start() const
+void RenderTimer::start()
 {
 #if !defined(USE_OPENGL_ES)
-    Renderer::begin_query(QueryType::TIME_ELAPSED, index);
+    collect_results();
+
+    // Every query of the ring is still awaiting its result; waiting for it would stall the pipeline, this measure is
+    //  skipped instead
+    measuring = (pending_query_count < query_ring_size);
+
+    if (measuring) {
+        Renderer::record_query_timestamp(query_indices[next_query_slot * 2]);
+    }
 #endif
 }
 
-void RenderTimer::stop() const
+void RenderTimer::stop()
 {
 #if !defined(USE_OPENGL_ES)
-    Renderer::end_query(QueryType::TIME_ELAPSED);
+    if (!measuring) {
+        return;
+    }
+
+    Renderer::record_query_timestamp(query_indices[next_query_slot * 2 + 1]);
+
+    next_query_slot = (next_query_slot + 1) % query_ring_size;
+    ++pending_query_count;
+    measuring = false;
 #endif
 }
 
 float RenderTimer::recover_time() const
 {
 #if !defined(USE_OPENGL_ES)
-    int64_t time{};
-    Renderer::recover_query_result(index, time);
-
-    return (static_cast<float>(time) / 1'000'000.f);
+    return latest_time;
 #else
     return 0;
 #endif
 }
 
+RenderTimerStats RenderTimer::recover_stats() const
+{
+    RenderTimerStats stats{};
+
+#if !defined(USE_OPENGL_ES)
+    if (samples.empty()) {
+        return stats;
+    }
+
+    std::vector<float> sorted_samples = samples;
+    std::ranges::sort(sorted_samples);
+
+    stats.latest = latest_time;
+    stats.min = sorted_samples.front();
+    stats.average = std::accumulate(sorted_samples.cbegin(), sorted_samples.cend(), 0.f) /
+                    static_cast<float>(sorted_samples.size());
+    stats.p99 = sorted_samples[(sorted_samples.size() * 99 + 99) / 100 - 1];
+    stats.sample_count = sorted_samples.size();
+#endif
+
+    return stats;
+}
+
+void RenderTimer::clear_samples()
+{
+#if !defined(USE_OPENGL_ES)
+    samples.clear();
+    next_sample_index = 0;
+#endif
+}
+
 RenderTimer::~RenderTimer()
 {
 #if !defined(USE_OPENGL_ES)
-    Renderer::delete_query(index);
+    for (auto& query_index : query_indices) {
+        if (query_index.is_valid()) {
+            Renderer::delete_query(query_index);
+        }
+    }
+#endif
+}
+
+#if !defined(USE_OPENGL_ES)
+void RenderTimer::collect_results()
+{
+    while (pending_query_count > 0) {
+        size_t const oldest_slot = (next_query_slot + query_ring_size - pending_query_count) % query_ring_size;
+
+        // The timestamps are recorded in order; the stop one being available implies that the start one is as well
+        if (!Renderer::is_query_result_available(query_indices[oldest_slot * 2 + 1])) {
+            break;
+        }
+
+        uint64_t start_time{};
+        uint64_t stop_time{};
+        Renderer::recover_query_result(query_indices[oldest_slot * 2], start_time);
+        Renderer::recover_query_result(query_indices[oldest_slot * 2 + 1], stop_time);
+
+        latest_time = static_cast<float>(stop_time - start_time) / 1'000'000.f;
+
+        if (samples.size() < sample_window_size) {
+            samples.emplace_back(latest_time);
+        }
+        else {
+            samples[next_sample_index] = latest_time;
+        }
+
+        next_sample_index = (next_sample_index + 1) % sample_window_size;
+        --pending_query_count;
+    }
+}
 #endif
 }
-}
\ No newline at end of file
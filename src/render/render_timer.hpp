@@ -3,8 +3,25 @@
 #include <data/owner_value.hpp>
 
 namespace xen {
+/// Statistics of the times measured by a RenderTimer over its rolling window, in milliseconds.
+struct RenderTimerStats {
+    float latest{};
+    float min{};
+    float average{};
+    float p99{};
+    size_t sample_count{};
+};
+
+/// RenderTimer class, measuring the GPU time taken by the commands issued between start() & stop() with a pair of
+/// timestamp queries. The queries are cycled through a ring, so that each measure is only read back a few frames later
+/// once the GPU has executed it, without ever waiting for the results; the measures are kept over a rolling window.
 class RenderTimer {
 public:
+    /// Maximum number of measures awaiting their results. If the GPU lags further behind, new measures are skipped.
+    static constexpr size_t query_ring_size = 4;
+    /// Number of measures from which the statistics are computed.
+    static constexpr size_t sample_window_size = 128;
+
     RenderTimer();
     RenderTimer(RenderTimer const&) = delete;
     RenderTimer(RenderTimer&&) noexcept = default;
@@ -14,24 +31,45 @@ public:
 
     ~RenderTimer();
 
-    /// Starts the time measure.
+    /// Starts the time measure, reading back beforehand the results of the previous measures which are available.
     /// \note This action is not available with OpenGL ES and will do nothing.
-    void start() const;
+    void start();
 
     /// Stops the time measure.
     /// \note This action is not available with OpenGL ES and will do nothing.
-    void stop() const;
+    void stop();
 
-    /// Recovers the elapsed time (in milliseconds) of the latest measure.
-    /// \warning The measure must be stopped for the actual time to be available.
-    /// \see stop()
+    /// Recovers the elapsed time (in milliseconds) of the latest measure whose result has been read back, usually made
+    ///   a few frames ago; this never waits for the GPU.
     /// \note This action is not available with OpenGL ES and will always return 0.
     /// \return Elapsed time in milliseconds.
     [[nodiscard]] float recover_time() const;
 
+    /// Recovers the statistics of the measures read back over the rolling window.
+    /// \note This action is not available with OpenGL ES and will always return empty statistics.
+    /// \return Statistics of the elapsed times, in milliseconds.
+    [[nodiscard]] RenderTimerStats recover_stats() const;
+
+    /// Discards the measures read back so far, for the statistics to only cover the upcoming ones.
+    void clear_samples();
+
+private:
+#if !defined(USE_OPENGL_ES)
+    /// Pairs of start & stop timestamp queries, one per slot in the ring.
+    std::array<OwnerValue<uint32_t, std::numeric_limits<uint32_t>::max()>, query_ring_size * 2> query_indices{};
+    size_t next_query_slot = 0;
+    size_t pending_query_count = 0;
+    bool measuring = false;
+
+    std::vector<float> samples{};
+    size_t next_sample_index = 0;
+    float latest_time = 0.f;
+#endif
+
 private:
 #if !defined(USE_OPENGL_ES)
-    OwnerValue<uint32_t, std::numeric_limits<uint32_t>::max()> index{};
+    /// Reads back the results of the pending measures, from the oldest one & until one is not available yet.
+    void collect_results();
 #endif
 };
-}
\ No newline at end of file
+}
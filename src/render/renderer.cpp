@@ -168,6 +168,14 @@ void Renderer::init()
     recover_default_framebuffer_color_format();
     recover_default_framebuffer_depth_format();
 
+#if !defined(USE_WEBGL)
+    // Letting the driver use as many threads as it wants to compile shaders & link programs
+    if (is_extension_supported("GL_KHR_parallel_shader_compile")) {
+        glMaxShaderCompilerThreadsKHR(std::numeric_limits<uint32_t>::max());
+        parallel_shader_compilation = true;
+    }
+#endif
+
 #if !defined(XEN_IS_PLATFORM_MAC) &&                                                                                   \
     !defined(USE_OPENGL_ES                                                                                             \
     ) // Setting the debug message callback provokes a crash on macOS & isn't available on OpenGL ES
@@ -353,6 +361,15 @@ void Renderer::clear(MaskType mask)
     print_conditional_errors();
 }
 
+void Renderer::clear_color_buffer(uint32_t draw_buffer_index, Vector4f const& values)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    glClearBufferfv(GL_COLOR, static_cast<int>(draw_buffer_index), &values[0]);
+
+    print_conditional_errors();
+}
+
 void Renderer::set_depth_function(DepthStencilFunction func)
 {
     Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
@@ -364,6 +381,15 @@ void Renderer::set_depth_function(DepthStencilFunction func)
     print_conditional_errors();
 }
 
+void Renderer::set_polygon_offset(float factor, float units)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    glPolygonOffset(factor, units);
+
+    print_conditional_errors();
+}
+
 void Renderer::set_stencil_function(DepthStencilFunction func, int ref, uint32_t mask, FaceOrientation orientation)
 {
     Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
@@ -538,6 +564,19 @@ void Renderer::set_vertex_attrib(
     print_conditional_errors();
 }
 
+void Renderer::set_vertex_attrib_integer(
+    uint32_t index, AttribDataType data_type, uint8_t size, uint32_t stride, uint32_t offset
+)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    glVertexAttribIPointer(
+        index, size, static_cast<uint32_t>(data_type), static_cast<int>(stride), reinterpret_cast<void const*>(offset)
+    );
+
+    print_conditional_errors();
+}
+
 void Renderer::set_vertex_attribDivisor(uint32_t index, uint32_t divisor)
 {
     Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
@@ -612,6 +651,87 @@ void Renderer::send_buffer_sub_data(BufferType type, std::ptrdiff_t offset, std:
     print_conditional_errors();
 }
 
+void Renderer::copy_buffer_sub_data(
+    BufferType read_type, BufferType write_type, std::ptrdiff_t read_offset, std::ptrdiff_t write_offset,
+    std::ptrdiff_t data_size
+)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    glCopyBufferSubData(
+        static_cast<uint32_t>(read_type), static_cast<uint32_t>(write_type), read_offset, write_offset, data_size
+    );
+
+    print_conditional_errors();
+}
+
+#if !defined(USE_OPENGL_ES)
+void Renderer::recover_buffer_sub_data(BufferType type, std::ptrdiff_t offset, std::ptrdiff_t data_size, void* data)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    TracyGpuZone("Renderer::recover_buffer_sub_data")
+
+        glGetBufferSubData(static_cast<uint32_t>(type), offset, data_size, data);
+
+    print_conditional_errors();
+}
+
+void* Renderer::map_buffer_range(BufferType type, std::ptrdiff_t offset, std::ptrdiff_t length, BufferMapAccess access)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    void* const data = glMapBufferRange(static_cast<uint32_t>(type), offset, length, static_cast<uint32_t>(access));
+
+    print_conditional_errors();
+
+    return data;
+}
+
+bool Renderer::unmap_buffer(BufferType type)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    bool const is_valid = (glUnmapBuffer(static_cast<uint32_t>(type)) == GL_TRUE);
+
+    print_conditional_errors();
+
+    return is_valid;
+}
+
+SyncObject Renderer::insert_fence()
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    SyncObject const fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    print_conditional_errors();
+
+    return fence;
+}
+
+SyncWaitResult Renderer::wait_fence(SyncObject fence, uint64_t timeout)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    // The commands are flushed, so that the fence is guaranteed to be signaled eventually
+    uint32_t const result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+
+    print_conditional_errors();
+
+    return static_cast<SyncWaitResult>(result);
+}
+
+void Renderer::delete_fence(SyncObject fence)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    glDeleteSync(fence);
+
+    print_conditional_errors();
+}
+#endif
+
 void Renderer::delete_buffers(uint32_t count, uint32_t* indices)
 {
     Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
@@ -811,6 +931,23 @@ void Renderer::send_image_data_2d(
     print_conditional_errors();
 }
 
+void Renderer::send_compressed_image_data_2d(
+    TextureType type, uint32_t mipmap_level, TextureInternalFormat internal_format, Vector2ui const& size,
+    size_t data_size, void const* data
+)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    TracyGpuZone("Renderer::send_compressed_image_data_2d")
+
+        glCompressedTexImage2D(
+            static_cast<uint32_t>(type), static_cast<int>(mipmap_level), static_cast<uint32_t>(internal_format),
+            static_cast<int>(size.x), static_cast<int>(size.y), 0, static_cast<int>(data_size), data
+        );
+
+    print_conditional_errors();
+}
+
 void Renderer::send_image_sub_data_2d(
     TextureType type, uint32_t mipmap_level, Vector2ui const& offset, Vector2ui const& size, TextureFormat format,
     PixelDataType data_type, void const* data
@@ -964,6 +1101,39 @@ void Renderer::generate_mipmap(uint32_t texture_index)
 
     print_conditional_errors();
 }
+
+uint64_t Renderer::recover_texture_handle(uint32_t texture_index)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+    Log::rt_assert(
+        is_extension_supported("GL_ARB_bindless_texture"),
+        "Error: GL_ARB_bindless_texture is needed to recover a texture handle"
+    );
+
+    uint64_t const handle = glGetTextureHandleARB(texture_index);
+
+    print_conditional_errors();
+
+    return handle;
+}
+
+void Renderer::make_texture_handle_resident(uint64_t handle, bool resident)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+    Log::rt_assert(
+        is_extension_supported("GL_ARB_bindless_texture"),
+        "Error: GL_ARB_bindless_texture is needed to make a texture handle resident"
+    );
+
+    if (resident) {
+        glMakeTextureHandleResidentARB(handle);
+    }
+    else {
+        glMakeTextureHandleNonResidentARB(handle);
+    }
+
+    print_conditional_errors();
+}
 #endif
 
 void Renderer::delete_textures(uint32_t count, uint32_t* indices)
@@ -986,6 +1156,17 @@ void Renderer::resize_viewport(Vector2ui const& position, Vector2ui const& size)
     print_conditional_errors();
 }
 
+void Renderer::set_scissor(Vector2ui const& position, Vector2ui const& size)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    glScissor(
+        static_cast<int>(position.x), static_cast<int>(position.y), static_cast<int>(size.x), static_cast<int>(size.y)
+    );
+
+    print_conditional_errors();
+}
+
 uint32_t Renderer::create_program()
 {
     Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
@@ -1047,6 +1228,97 @@ std::vector<uint32_t> Renderer::recover_attached_shaders(uint32_t program_index)
     return shader_indices;
 }
 
+bool Renderer::is_program_link_completed(uint32_t index)
+{
+#if !defined(USE_WEBGL)
+    if (parallel_shader_compilation) {
+        int completion_status{};
+        get_program_parameter(index, ProgramParameter::COMPLETION_STATUS, &completion_status);
+
+        return (completion_status == GL_TRUE);
+    }
+#else
+    static_cast<void>(index);
+#endif
+
+    return true;
+}
+
+bool Renderer::check_program_link(uint32_t index)
+{
+    if (is_program_linked(index)) {
+        return true;
+    }
+
+    // With parallel compilation, the shaders' errors have not been checked when compiling them
+    if (parallel_shader_compilation) {
+        for (uint32_t const shader_index : recover_attached_shaders(index)) {
+            if (is_shader_compiled(shader_index)) {
+                continue;
+            }
+
+            char info_log[512];
+
+            glGetShaderInfoLog(shader_index, static_cast<int>(std::size(info_log)), nullptr, info_log);
+            Log::verror("Shader compilation failed (ID {}): {}", shader_index, info_log);
+        }
+    }
+
+    char info_log[512];
+
+    glGetProgramInfoLog(index, static_cast<int>(std::size(info_log)), nullptr, info_log);
+    Log::verror("Shader program link failed (ID {}) {}", index, info_log);
+
+    print_conditional_errors();
+
+    return false;
+}
+
+#if !defined(USE_WEBGL)
+void Renderer::set_program_parameter(uint32_t index, ProgramParameter parameter, int value)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    glProgramParameteri(index, static_cast<uint32_t>(parameter), value);
+
+    print_conditional_errors();
+}
+
+std::vector<uint8_t> Renderer::recover_program_binary(uint32_t index, uint32_t& format)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    int binary_length{};
+    get_program_parameter(index, ProgramParameter::PROGRAM_BINARY_LENGTH, &binary_length);
+
+    if (binary_length <= 0) {
+        return {};
+    }
+
+    std::vector<uint8_t> binary(static_cast<size_t>(binary_length));
+
+    int recovered_length{};
+    glGetProgramBinary(index, binary_length, &recovered_length, &format, binary.data());
+    binary.resize(static_cast<size_t>(recovered_length));
+
+    print_conditional_errors();
+
+    return binary;
+}
+
+void Renderer::send_program_binary(uint32_t index, uint32_t format, void const* binary, int length)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    TracyGpuZone("Renderer::send_program_binary")
+
+        glProgramBinary(index, format, binary, length);
+
+    // An invalid binary is not an error, the program having to be linked from its sources instead
+    static_cast<void>(recover_errors());
+}
+#endif
+
 void Renderer::link_program(uint32_t index)
 {
     Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
@@ -1055,11 +1327,9 @@ void Renderer::link_program(uint32_t index)
 
         glLinkProgram(index);
 
-    if (!is_program_linked(index)) {
-        char info_log[512];
-
-        glGetProgramInfoLog(index, static_cast<int>(std::size(info_log)), nullptr, info_log);
-        Log::verror("Shader program link failed (ID {}) {}", index, info_log);
+    // Checking the status waits for the link to be completed, which must be left to the caller when made in parallel
+    if (!parallel_shader_compilation) {
+        check_program_link(index);
     }
 
     print_conditional_errors();
@@ -1187,7 +1457,7 @@ void Renderer::compile_shader(uint32_t index)
 
         glCompileShader(index);
 
-    if (!is_shader_compiled(index)) {
+    if (!parallel_shader_compilation && !is_shader_compiled(index)) {
         char info_log[512];
 
         glGetShaderInfoLog(index, static_cast<int>(std::size(info_log)), nullptr, info_log);
@@ -1767,6 +2037,24 @@ void Renderer::draw_elements_instanced(
     print_conditional_errors();
 }
 
+#if !defined(USE_OPENGL_ES)
+void Renderer::multi_draw_elements_indirect(
+    PrimitiveType type, ElementDataType data_type, std::ptrdiff_t commands_offset, uint32_t draw_count, uint32_t stride
+)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    TracyGpuZone("Renderer::multi_draw_elements_indirect")
+
+        glMultiDrawElementsIndirect(
+            static_cast<uint32_t>(type), static_cast<uint32_t>(data_type),
+            reinterpret_cast<void const*>(commands_offset), static_cast<int>(draw_count), static_cast<int>(stride)
+        );
+
+    print_conditional_errors();
+}
+#endif
+
 void Renderer::dispatch_compute(Vector3ui group_content)
 {
     Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
@@ -1866,6 +2154,27 @@ void Renderer::recover_query_result(uint32_t index, uint64_t& result)
 
     print_conditional_errors();
 }
+
+void Renderer::record_query_timestamp(uint32_t index)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    glQueryCounter(index, GL_TIMESTAMP);
+
+    print_conditional_errors();
+}
+
+bool Renderer::is_query_result_available(uint32_t index)
+{
+    Log::rt_assert(is_initialized(), "Error: The Renderer must be initialized before calling its functions.");
+
+    uint32_t available{};
+    glGetQueryObjectuiv(index, GL_QUERY_RESULT_AVAILABLE, &available);
+
+    print_conditional_errors();
+
+    return (available == GL_TRUE);
+}
 #endif
 
 void Renderer::delete_queries(uint32_t count, uint32_t* indices)
@@ -10,6 +10,8 @@
 #define USE_OPENGL_ES
 #endif
 
+struct __GLsync; // Opaque fence type, as declared by OpenGL
+
 namespace xen {
 enum class Capability : uint32_t {
     CULL = 2884 /* GL_CULL_FACE      */,   ///<
@@ -65,6 +67,9 @@ enum class StateParameter : uint32_t {
     MAJOR_VERSION = 33307 /* GL_MAJOR_VERSION  */,   ///< OpenGL major version (in the form major.minor).
     MINOR_VERSION = 33308 /* GL_MINOR_VERSION  */,   ///< OpenGL minor version (in the form major.minor).
     EXTENSION_COUNT = 33309 /* GL_NUM_EXTENSIONS */, ///< Number of extensions supported for the current context.
+#if !defined(USE_WEBGL)
+    PROGRAM_BINARY_FORMAT_COUNT = 34814 /* GL_NUM_PROGRAM_BINARY_FORMATS */, ///< Number of program binary formats.
+#endif
 
     ACTIVE_TEXTURE = 34016 /* GL_ACTIVE_TEXTURE  */,  ///< Currently active texture.
     CURRENT_PROGRAM = 35725 /* GL_CURRENT_PROGRAM */, ///< Currently used program.
@@ -258,7 +263,15 @@ enum class AttribDataType : uint32_t {
 enum class BufferType : uint32_t {
     ARRAY_BUFFER = 34962 /* GL_ARRAY_BUFFER         */,   ///<
     ELEMENT_BUFFER = 34963 /* GL_ELEMENT_ARRAY_BUFFER */, ///<
-    UNIFORM_BUFFER = 35345 /* GL_UNIFORM_BUFFER       */  ///<
+    UNIFORM_BUFFER = 35345 /* GL_UNIFORM_BUFFER       */, ///<
+    COPY_READ_BUFFER = 36662 /* GL_COPY_READ_BUFFER     */, ///<
+    COPY_WRITE_BUFFER = 36663 /* GL_COPY_WRITE_BUFFER    */, ///<
+    PIXEL_PACK_BUFFER = 35051 /* GL_PIXEL_PACK_BUFFER    */, ///<
+    PIXEL_UNPACK_BUFFER = 35052 /* GL_PIXEL_UNPACK_BUFFER  */, ///<
+#if !defined(USE_WEBGL)
+    DRAW_INDIRECT_BUFFER = 36671 /* GL_DRAW_INDIRECT_BUFFER */, ///<
+    SHADER_STORAGE_BUFFER = 37074 /* GL_SHADER_STORAGE_BUFFER */ ///<
+#endif
 };
 
 enum class BufferDataUsage : uint32_t {
@@ -275,6 +288,25 @@ enum class BufferDataUsage : uint32_t {
     DYNAMIC_COPY = 35050 /* GL_DYNAMIC_COPY */  ///<
 };
 
+enum class BufferMapAccess : uint32_t {
+    READ = 1 /* GL_MAP_READ_BIT */,                           ///< The mapped range can be read.
+    WRITE = 2 /* GL_MAP_WRITE_BIT */,                         ///< The mapped range can be written.
+    INVALIDATE_RANGE = 4 /* GL_MAP_INVALIDATE_RANGE_BIT */,   ///< The previous content of the range can be discarded.
+    INVALIDATE_BUFFER = 8 /* GL_MAP_INVALIDATE_BUFFER_BIT */, ///< The previous content of the buffer can be discarded.
+    UNSYNCHRONIZED = 32 /* GL_MAP_UNSYNCHRONIZED_BIT */       ///< Pending operations on the buffer are not waited for.
+};
+MAKE_ENUM_FLAG(BufferMapAccess)
+
+enum class SyncWaitResult : uint32_t {
+    ALREADY_SIGNALED = 37146 /* GL_ALREADY_SIGNALED    */,    ///< The fence was signaled before the wait.
+    TIMEOUT_EXPIRED = 37147 /* GL_TIMEOUT_EXPIRED     */,     ///< The fence has not been signaled within the timeout.
+    CONDITION_SATISFIED = 37148 /* GL_CONDITION_SATISFIED */, ///< The fence has been signaled during the wait.
+    WAIT_FAILED = 37149 /* GL_WAIT_FAILED         */          ///< An error occurred.
+};
+
+/// Fence object, as returned by Renderer::insert_fence().
+using SyncObject = ::__GLsync*;
+
 enum class TextureType : uint32_t {
 #if !defined(USE_OPENGL_ES)
     TEXTURE_1D = 3552 /* GL_TEXTURE_1D                  */, ///<
@@ -426,7 +458,16 @@ enum class TextureInternalFormat : uint32_t {
     DEPTH24_STENCIL8 = 35056 /* GL_DEPTH24_STENCIL8   */, ///<
     DEPTH32 = 33191 /* GL_DEPTH_COMPONENT32  */,          ///<
     DEPTH32F = 36012 /* GL_DEPTH_COMPONENT32F */,         ///<
-    DEPTH32F_STENCIL8 = 36013 /* GL_DEPTH32F_STENCIL8  */ ///<
+    DEPTH32F_STENCIL8 = 36013 /* GL_DEPTH32F_STENCIL8  */, ///<
+
+    // Compressed formats
+    BC1 = 33777 /* GL_COMPRESSED_RGBA_S3TC_DXT1_EXT       */,         ///<
+    BC1_SRGB = 35917 /* GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT */,    ///<
+    BC3 = 33779 /* GL_COMPRESSED_RGBA_S3TC_DXT5_EXT       */,         ///<
+    BC3_SRGB = 35919 /* GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT */,    ///<
+    BC5 = 36285 /* GL_COMPRESSED_RG_RGTC2                 */,         ///<
+    BC7 = 36492 /* GL_COMPRESSED_RGBA_BPTC_UNORM          */,         ///<
+    BC7_SRGB = 36493 /* GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM    */     ///<
 };
 
 enum class PixelDataType : uint32_t {
@@ -526,7 +567,12 @@ enum class ProgramParameter : uint32_t {
     TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH = 35958 /* GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH */, ///<
     GEOMETRY_VERTICES_OUT = 35094 /* GL_GEOMETRY_VERTICES_OUT                 */,                 ///<
     GEOMETRY_INPUT_TYPE = 35095 /* GL_GEOMETRY_INPUT_TYPE                   */,                   ///<
-    GEOMETRY_OUTPUT_TYPE = 35096 /* GL_GEOMETRY_OUTPUT_TYPE                  */                   ///<
+    GEOMETRY_OUTPUT_TYPE = 35096 /* GL_GEOMETRY_OUTPUT_TYPE                  */,                  ///<
+#if !defined(USE_WEBGL)
+    PROGRAM_BINARY_LENGTH = 34625 /* GL_PROGRAM_BINARY_LENGTH                 */,                 ///<
+    PROGRAM_BINARY_RETRIEVABLE_HINT = 33367 /* GL_PROGRAM_BINARY_RETRIEVABLE_HINT       */,       ///<
+    COMPLETION_STATUS = 37297 /* GL_COMPLETION_STATUS_KHR                 */                  ///<
+#endif
 };
 
 enum class ShaderType : uint32_t {
@@ -992,6 +1038,11 @@ public:
         return (extensions.find(extension) != extensions.cend());
     }
 
+    /// Checks if shaders are compiled & programs linked in background threads of the driver, as allowed by the
+    ///   GL_KHR_parallel_shader_compile extension. If so, compiling & linking do not wait for their completion.
+    /// \return True if parallel shader compilation is enabled, false otherwise.
+    static bool is_parallel_shader_compilation_enabled() { return parallel_shader_compilation; }
+
     static TextureInternalFormat get_default_framebuffer_color_format() { return default_framebuffer_color; }
 
     static TextureInternalFormat get_default_framebuffer_depth_format() { return default_framebuffer_depth; }
@@ -1032,8 +1083,18 @@ public:
 
     static void clear(MaskType mask);
 
+    /// Clears a single color buffer of the currently bound framebuffer, leaving the others untouched.
+    /// \param draw_buffer_index Index of the draw buffer to be cleared.
+    /// \param values Values to fill the buffer with.
+    static void clear_color_buffer(uint32_t draw_buffer_index, Vector4f const& values);
+
     static void set_depth_function(DepthStencilFunction func);
 
+    /// Sets the offset applied to the depth of the rasterized polygons, when Capability::POLYGON_OFFSET_FILL is enabled.
+    /// \param factor Factor scaling the polygon's maximum depth slope.
+    /// \param units Constant offset, in multiples of the smallest resolvable depth difference.
+    static void set_polygon_offset(float factor, float units);
+
     /// Sets the function to evaluate for stencil testing.
     /// \param func Function to be evaluated.
     /// \param ref Reference value to compare the stencil with.
@@ -1075,6 +1136,15 @@ public:
     static void set_vertex_attrib(
         uint32_t index, AttribDataType data_type, uint8_t size, uint32_t stride, uint32_t offset, bool normalize = false
     );
+    /// Specifies an integer vertex attribute, whose values are not converted to floating-point.
+    /// \param index Index of the attribute.
+    /// \param data_type Type of the attribute's components; must be an integer type.
+    /// \param size Number of components of the attribute.
+    /// \param stride Byte offset between consecutive attributes.
+    /// \param offset Byte offset of the first attribute in the currently bound array buffer.
+    static void set_vertex_attrib_integer(
+        uint32_t index, AttribDataType data_type, uint8_t size, uint32_t stride, uint32_t offset
+    );
     static void set_vertex_attribDivisor(uint32_t index, uint32_t divisor);
     static void delete_vertex_arrays(uint32_t count, uint32_t* indices);
     static void delete_vertex_array(uint32_t& index) { delete_vertex_arrays(1, &index); }
@@ -1099,6 +1169,50 @@ public:
     {
         send_buffer_sub_data(type, offset, sizeof(T), &data);
     }
+    /// Copies data between the buffers currently bound to two targets.
+    /// \param read_type Type of the buffer to copy the data from.
+    /// \param write_type Type of the buffer to copy the data to.
+    /// \param read_offset Offset in bytes from which to start reading the source buffer.
+    /// \param write_offset Offset in bytes from which to start writing the destination buffer.
+    /// \param data_size Number of bytes to be copied.
+    static void copy_buffer_sub_data(
+        BufferType read_type, BufferType write_type, std::ptrdiff_t read_offset, std::ptrdiff_t write_offset,
+        std::ptrdiff_t data_size
+    );
+#if !defined(USE_OPENGL_ES)
+    /// Retrieves data from the currently bound buffer.
+    /// \note This waits for all the commands writing to the buffer to be completed; reading a buffer filled during the
+    ///   previous frame usually avoids stalling the pipeline.
+    /// \param type Type of the buffer to recover the data from.
+    /// \param offset Offset in bytes from which to start reading the buffer.
+    /// \param data_size Number of bytes to be read.
+    /// \param data Data to be filled; must be at least data_size bytes long.
+    static void recover_buffer_sub_data(BufferType type, std::ptrdiff_t offset, std::ptrdiff_t data_size, void* data);
+    /// Maps a range of the currently bound buffer into client memory.
+    /// \note The range must be unmapped with unmap_buffer() before the buffer is used again by the GPU.
+    /// \param type Type of the buffer to be mapped.
+    /// \param offset Offset in bytes of the range to be mapped.
+    /// \param length Number of bytes to be mapped.
+    /// \param access Access to the mapped range.
+    /// \return Pointer to the mapped range; null if the mapping failed.
+    static void* map_buffer_range(
+        BufferType type, std::ptrdiff_t offset, std::ptrdiff_t length, BufferMapAccess access
+    );
+    /// Unmaps the currently bound buffer.
+    /// \param type Type of the buffer to be unmapped.
+    /// \return True if the buffer's content remained valid while it was mapped, false if it has been corrupted & must
+    ///   be sent or read again.
+    static bool unmap_buffer(BufferType type);
+    /// Inserts a fence in the command stream, signaled once all the previous commands have been executed by the GPU.
+    /// \return Fence object, to be deleted with delete_fence().
+    static SyncObject insert_fence();
+    /// Waits for a fence to be signaled.
+    /// \param fence Fence to wait for.
+    /// \param timeout Maximum waiting time, in nanoseconds; 0 only checks the fence's state without waiting.
+    /// \return Result of the wait; the fence has been signaled if either ALREADY_SIGNALED or CONDITION_SATISFIED.
+    static SyncWaitResult wait_fence(SyncObject fence, uint64_t timeout = 0);
+    static void delete_fence(SyncObject fence);
+#endif
     static void delete_buffers(uint32_t count, uint32_t* indices);
     template <size_t N>
     static void delete_buffers(uint32_t (&indices)[N])
@@ -1225,6 +1339,17 @@ public:
         TextureType type, uint32_t mipmap_level, TextureInternalFormat internal_format, Vector2ui const& size,
         TextureFormat format, PixelDataType data_type, void const* data
     );
+    /// Sends the block-compressed image's data corresponding to the currently bound 2D texture.
+    /// \param type Type of the texture.
+    /// \param mipmap_level Mipmap (level of detail) of the texture. 0 is the most detailed.
+    /// \param internal_format Compressed image internal format.
+    /// \param size Image size.
+    /// \param data_size Size in bytes of the compressed data.
+    /// \param data Compressed data to be sent.
+    static void send_compressed_image_data_2d(
+        TextureType type, uint32_t mipmap_level, TextureInternalFormat internal_format, Vector2ui const& size,
+        size_t data_size, void const* data
+    );
     /// Sends the image's sub-data corresponding to the currently bound 2D texture.
     /// \param type Type of the texture.
     /// \param mipmap_level Mipmap (level of detail) of the texture. 0 is the most detailed.
@@ -1290,6 +1415,16 @@ public:
     /// \note Requires OpenGL 4.5+.
     /// \param texture_index Index of the texture to generate mipmaps for.
     static void generate_mipmap(uint32_t texture_index);
+    /// Recovers the bindless handle of a texture, through which shaders can sample it without it being bound.
+    /// \note Requires GL_ARB_bindless_texture. The texture's parameters cannot be changed once a handle exists.
+    /// \param texture_index Index of the texture to recover the handle of.
+    /// \return Handle of the texture.
+    static uint64_t recover_texture_handle(uint32_t texture_index);
+    /// Makes a bindless texture handle resident, or non-resident; only resident handles can be used by shaders.
+    /// \note Requires GL_ARB_bindless_texture.
+    /// \param handle Handle of the texture.
+    /// \param resident True to make the handle resident, false to make it non-resident.
+    static void make_texture_handle_resident(uint64_t handle, bool resident = true);
 #endif
     static void delete_textures(uint32_t count, uint32_t* indices);
     template <size_t N>
@@ -1299,9 +1434,43 @@ public:
     }
     static void delete_texture(uint32_t& index) { delete_textures(1, &index); }
     static void resize_viewport(Vector2ui const& position, Vector2ui const& size);
+    /// Sets the area outside of which fragments are discarded, when Capability::SCISSOR_TEST is enabled. The scissor
+    ///   test also applies to clears.
+    /// \param position Lower-left corner of the area.
+    /// \param size Size of the area.
+    static void set_scissor(Vector2ui const& position, Vector2ui const& size);
     static uint32_t create_program();
     static void get_program_parameter(uint32_t index, ProgramParameter parameter, int* parameters);
     static bool is_program_linked(uint32_t index);
+    /// Checks if a program's link has completed, whether successfully or not. With parallel shader compilation, the
+    ///   shaders' compilation & the program's link run in the background, & this check does not wait for them.
+    /// \param index Index of the program to be checked.
+    /// \return True if the link has completed; always true without parallel shader compilation.
+    static bool is_program_link_completed(uint32_t index);
+    /// Checks if a program has been successfully linked, logging its link errors & its shaders' compilation ones
+    ///   otherwise. This waits for the link to be completed.
+    /// \param index Index of the program to be checked.
+    /// \return True if the program is linked, false otherwise.
+    static bool check_program_link(uint32_t index);
+#if !defined(USE_WEBGL)
+    /// Sets a parameter of a program, to be taken into account on its next link.
+    /// \param index Index of the program to set the parameter to.
+    /// \param parameter Parameter to be set; only ProgramParameter::PROGRAM_BINARY_RETRIEVABLE_HINT is accepted.
+    /// \param value Value to be set.
+    static void set_program_parameter(uint32_t index, ProgramParameter parameter, int value);
+    /// Recovers the binary of a linked program, which can be sent back as is to a program on the same driver.
+    /// \param index Index of the program to recover the binary from.
+    /// \param format Format of the recovered binary.
+    /// \return Program's binary; empty if it could not be recovered.
+    static std::vector<uint8_t> recover_program_binary(uint32_t index, uint32_t& format);
+    /// Replaces a program's executable with a binary previously recovered from another program. The driver may reject
+    ///   the binary, for instance after having been updated, in which case the program is left unlinked.
+    /// \param index Index of the program to send the binary to.
+    /// \param format Format of the binary.
+    /// \param binary Binary's data.
+    /// \param length Binary's length, in bytes.
+    static void send_program_binary(uint32_t index, uint32_t format, void const* binary, int length);
+#endif
     static uint32_t recover_active_uniform_count(uint32_t program_index);
     static std::vector<uint32_t> recover_attached_shaders(uint32_t program_index);
     static void link_program(uint32_t index);
@@ -1563,6 +1732,19 @@ public:
     {
         draw_elements_instanced(type, primitive_count, ElementDataType::UINT, nullptr, instance_count);
     }
+#if !defined(USE_OPENGL_ES)
+    /// Issues several indexed draws at once, their parameters being read from the bound draw indirect buffer.
+    /// \note Requires OpenGL 4.3+.
+    /// \param type Type of the primitives to be drawn.
+    /// \param data_type Type of the indices in the bound element buffer.
+    /// \param commands_offset Offset in bytes of the first command in the draw indirect buffer.
+    /// \param draw_count Number of commands to be read.
+    /// \param stride Offset in bytes between two commands; 0 if they are tightly packed.
+    static void multi_draw_elements_indirect(
+        PrimitiveType type, ElementDataType data_type, std::ptrdiff_t commands_offset, uint32_t draw_count,
+        uint32_t stride = 0
+    );
+#endif
 
     static void dispatch_compute(Vector3ui group_content = Vector3ui(1));
 
@@ -1588,6 +1770,15 @@ public:
     static void recover_query_result(uint32_t index, int64_t& result);
 
     static void recover_query_result(uint32_t index, uint64_t& result);
+
+    /// Records the GPU time into a query once all the previously issued commands have been executed.
+    /// \param index Index of the query to record the timestamp into.
+    static void record_query_timestamp(uint32_t index);
+
+    /// Checks if the result of a query is available, that is, if it can be recovered without waiting for the GPU.
+    /// \param index Index of the query to be checked.
+    /// \return True if the query's result is available, false otherwise.
+    static bool is_query_result_available(uint32_t index);
 #endif
     static void delete_queries(uint32_t count, uint32_t* indices);
 
@@ -1654,6 +1845,7 @@ private:
     }
 
     static inline bool initialized = false;
+    static inline bool parallel_shader_compilation = false;
 
     static inline int major_version{};
     static inline int minor_version{};
@@ -0,0 +1,212 @@
+#include "program_cache.hpp"
+
+#include <render/renderer.hpp>
+#include <utils/file_utils.hpp>
+#include <utils/filepath.hpp>
+#include <utils/hash.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+namespace xen::ProgramCache {
+namespace {
+/// Version of the cached data, to be incremented whenever the files' layout changes so that older files get ignored.
+constexpr uint64_t cache_version = 1;
+
+FilePath cache_directory = "cache/programs";
+bool cache_enabled = true;
+
+/// Computes a hash identifying the current driver, whose updates invalidate the binaries.
+/// \return Hash of the driver's vendor, renderer & version.
+uint64_t compute_driver_hash()
+{
+    static uint64_t const driver_hash = []() {
+        std::string const driver_string = Renderer::get_context_info(ContextInfo::VENDOR) + '\n' +
+                                          Renderer::get_context_info(ContextInfo::RENDERER) + '\n' +
+                                          Renderer::get_context_info(ContextInfo::VERSION);
+        return Hash::compute_fnv1a(reinterpret_cast<uint8_t const*>(driver_string.data()), driver_string.size());
+    }();
+
+    return driver_hash;
+}
+
+FilePath recover_cache_filepath(uint64_t key)
+{
+    return cache_directory + ('/' + Hash::to_hex_string(key) + ".bin");
+}
+} // namespace
+
+void set_directory(FilePath const& directory)
+{
+    cache_directory = directory;
+}
+
+FilePath const& get_directory()
+{
+    return cache_directory;
+}
+
+void enable(bool enabled)
+{
+    cache_enabled = enabled;
+}
+
+void disable()
+{
+    enable(false);
+}
+
+bool is_enabled()
+{
+    return cache_enabled;
+}
+
+bool is_supported()
+{
+#if !defined(USE_WEBGL)
+#if !defined(USE_OPENGL_ES)
+    if (!Renderer::check_version(4, 1) && !Renderer::is_extension_supported("GL_ARB_get_program_binary")) {
+        return false;
+    }
+#endif
+
+    static bool const has_binary_formats = []() {
+        int format_count{};
+        Renderer::get_parameter(StateParameter::PROGRAM_BINARY_FORMAT_COUNT, &format_count);
+        return (format_count > 0);
+    }();
+
+    return has_binary_formats;
+#else
+    return false;
+#endif
+}
+
+uint64_t compute_key(uint32_t program_index)
+{
+    ZoneScopedN("ProgramCache::compute_key");
+
+    // The shaders are hashed in a fixed order, their attachment one not being guaranteed
+    std::vector<std::pair<ShaderType, uint64_t>> shader_hashes;
+
+    for (uint32_t const shader_index : Renderer::recover_attached_shaders(program_index)) {
+        std::string const source = Renderer::recover_shader_source(shader_index);
+
+        if (source.empty()) {
+            return 0;
+        }
+
+        shader_hashes.emplace_back(
+            Renderer::recover_shader_type(shader_index),
+            Hash::compute_fnv1a(reinterpret_cast<uint8_t const*>(source.data()), source.size())
+        );
+    }
+
+    if (shader_hashes.empty()) {
+        return 0;
+    }
+
+    std::sort(shader_hashes.begin(), shader_hashes.end());
+
+    uint64_t key = Hash::compute_fnv1a(cache_version, compute_driver_hash());
+
+    for (auto const& [shader_type, source_hash] : shader_hashes) {
+        key = Hash::compute_fnv1a(source_hash, Hash::compute_fnv1a(shader_type, key));
+    }
+
+    return key;
+}
+
+bool load(uint32_t program_index, uint64_t key)
+{
+#if !defined(USE_WEBGL)
+    ZoneScopedN("ProgramCache::load");
+
+    if (!cache_enabled || key == 0 || !is_supported()) {
+        return false;
+    }
+
+    FilePath const cache_filepath = recover_cache_filepath(key);
+
+    if (!FileUtils::is_readable(cache_filepath)) {
+        return false;
+    }
+
+    std::vector<uint8_t> const file_content = FileUtils::read_file_to_array(cache_filepath);
+
+    if (file_content.size() <= sizeof(uint32_t)) {
+        return false;
+    }
+
+    uint32_t format{};
+    std::memcpy(&format, file_content.data(), sizeof(uint32_t));
+
+    Renderer::send_program_binary(
+        program_index, format, file_content.data() + sizeof(uint32_t),
+        static_cast<int>(file_content.size() - sizeof(uint32_t))
+    );
+
+    if (!Renderer::is_program_linked(program_index)) {
+        Log::debug("[ProgramCache] Cached program binary rejected by the driver ('" + cache_filepath + "')");
+        return false;
+    }
+
+    Log::debug("[ProgramCache] Found program binary in cache ('" + cache_filepath + "')");
+    return true;
+#else
+    static_cast<void>(program_index);
+    static_cast<void>(key);
+    return false;
+#endif
+}
+
+void save(uint32_t program_index, uint64_t key)
+{
+#if !defined(USE_WEBGL)
+    ZoneScopedN("ProgramCache::save");
+
+    if (!cache_enabled || key == 0 || !is_supported()) {
+        return;
+    }
+
+    uint32_t format{};
+    std::vector<uint8_t> const binary = Renderer::recover_program_binary(program_index, format);
+
+    if (binary.empty()) {
+        return;
+    }
+
+    FilePath const cache_filepath = recover_cache_filepath(key);
+
+    try {
+        std::filesystem::create_directories(std::filesystem::path(cache_directory.get_path()));
+
+        // Writing to a temporary file first, so that a partially written file can never be read
+        FilePath const temp_filepath = cache_filepath + ".tmp";
+
+        {
+            std::ofstream file(temp_filepath, std::ios_base::binary | std::ios_base::trunc);
+
+            if (!file) {
+                throw std::runtime_error("Unable to open the file '" + temp_filepath + "'");
+            }
+
+            file.write(reinterpret_cast<char const*>(&format), sizeof(uint32_t));
+            file.write(reinterpret_cast<char const*>(binary.data()), static_cast<std::streamsize>(binary.size()));
+        }
+
+        std::filesystem::rename(
+            std::filesystem::path(temp_filepath.get_path()), std::filesystem::path(cache_filepath.get_path())
+        );
+    }
+    catch (std::exception const& exception) {
+        Log::vwarning("[ProgramCache] Failed to save the program binary to the cache: {}", exception.what());
+    }
+#else
+    static_cast<void>(program_index);
+    static_cast<void>(key);
+#endif
+}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace xen {
+class FilePath;
+
+/// Shader program binary cache. Once linked from their sources, programs' binaries are saved in the cache directory,
+/// named after a hash of their shaders' sources & of the driver; subsequent links of the same sources directly send
+/// the binary back to the driver, skipping both the shaders' compilation & the program's link.
+/// Binaries are only valid for the driver they have been recovered from: they are ignored once it changes, & the
+/// driver may also reject them, in which case the program is linked from its sources & its binary saved again.
+namespace ProgramCache {
+/// Sets the directory in which program binaries are stored. It will be created if it does not exist.
+/// \param directory Path to the cache directory.
+void set_directory(FilePath const& directory);
+
+/// Gets the directory in which program binaries are stored.
+/// \return Path to the cache directory; "cache/programs" by default.
+FilePath const& get_directory();
+
+/// Enables or disables the program cache. If disabled, all programs are linked from their sources.
+/// \param enabled True to cache programs' binaries, false otherwise.
+void enable(bool enabled = true);
+
+void disable();
+
+[[nodiscard]] bool is_enabled();
+
+/// Checks if the driver allows recovering programs' binaries.
+/// \return True if program binaries can be cached, false otherwise.
+[[nodiscard]] bool is_supported();
+
+/// Computes the key identifying a program's binary, from the sources of its attached shaders & the current driver.
+/// \param program_index Index of the program to compute the key of.
+/// \return Program's key; 0 if the program has no shader with a source.
+[[nodiscard]] uint64_t compute_key(uint32_t program_index);
+
+/// Replaces a program's executable with its cached binary, if any.
+/// \param program_index Index of the program to be loaded.
+/// \param key Key of the program, as computed by compute_key().
+/// \return True if a binary has been found & accepted by the driver, the program then being linked; false otherwise.
+bool load(uint32_t program_index, uint64_t key);
+
+/// Saves a linked program's binary into the cache.
+/// \param program_index Index of the program to be saved; should have been linked with its binary set as retrievable.
+/// \param key Key of the program, as computed by compute_key().
+void save(uint32_t program_index, uint64_t key);
+}
+}
@@ -1,12 +1,50 @@
 #include "shader.hpp"
 
 #include <render/renderer.hpp>
+#include <render/shader/shader_preprocessor.hpp>
 #include <utils/file_utils.hpp>
+#include <utils/file_watcher.hpp>
 #include <utils/str_utils.hpp>
 
 #include <tracy/Tracy.hpp>
 
 namespace xen {
+namespace {
+struct ReloadedSource {
+    uint32_t version = 0;
+    std::string source;
+};
+
+std::mutex sources_mutex;
+/// Sources of the watched shader files, by path. A source is only held once its file has been reloaded; the shaders
+///   which have not loaded it yet are then outdated.
+std::unordered_map<std::string, ReloadedSource> reloaded_sources;
+
+void watch_source(FilePath const& filepath)
+{
+    {
+        std::lock_guard<std::mutex> const lock(sources_mutex);
+
+        if (!reloaded_sources.try_emplace(filepath.to_utf8()).second) {
+            return;
+        }
+    }
+
+    FileWatcher::watch(filepath, [filepath]() -> FileWatcher::ApplyFunc {
+        auto source = std::make_shared<std::string>(FileUtils::read_file_to_string(filepath));
+
+        // The shaders using this file are then reloaded by their programs' owners, being compiled on the main thread
+        return [filepath, source = std::move(source)]() {
+            std::lock_guard<std::mutex> const lock(sources_mutex);
+
+            ReloadedSource& reloaded_source = reloaded_sources[filepath.to_utf8()];
+            ++reloaded_source.version;
+            reloaded_source.source = std::move(*source);
+        };
+    });
+}
+}
+
 void Shader::import(FilePath filepath)
 {
     path = std::move(filepath);
@@ -20,10 +58,41 @@ void Shader::load() const
     }
 
     Log::debug("[Shader] Loading (ID: " + std::to_string(index) + ", path " + path + ")...");
-    load_source(FileUtils::read_file_to_string(path));
+
+    watch_source(path);
+
+    std::string source;
+
+    {
+        std::lock_guard<std::mutex> const lock(sources_mutex);
+
+        // A source more recent than the one last loaded has been reloaded by the file watcher; it is up-to-date with
+        // the file, which does not need to be read again
+        ReloadedSource const& reloaded_source = reloaded_sources[path.to_utf8()];
+
+        if (reloaded_source.version != loaded_version) {
+            source = reloaded_source.source;
+            loaded_version = reloaded_source.version;
+        }
+    }
+
+    load_source(source.empty() ? FileUtils::read_file_to_string(path) : source);
+
     Log::debug("[Shader] Loaded");
 }
 
+bool Shader::is_outdated() const
+{
+    if (path.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> const lock(sources_mutex);
+
+    auto const source_iter = reloaded_sources.find(path.to_utf8());
+    return (source_iter != reloaded_sources.end() && source_iter->second.version != loaded_version);
+}
+
 void Shader::compile() const
 {
     Log::debug("[Shader] Compiling (ID: " + std::to_string(index) + ")...");
@@ -36,14 +105,29 @@ bool Shader::is_compiled() const
     return Renderer::is_shader_compiled(index);
 }
 
+void Shader::set_defines(std::vector<std::string> defines)
+{
+    this->defines = std::move(defines);
+
+    if (!raw_source.empty()) {
+        process_source();
+    }
+}
+
 void Shader::load_source(std::string const& source) const
 {
-    ZoneScopedN("Shader::load_source");
+    raw_source = source;
+    process_source();
+}
+
+void Shader::process_source() const
+{
+    ZoneScopedN("Shader::process_source");
 
     Log::debug("[Shader] Loading source (ID: " + std::to_string(index) + ")...");
 
     // Removing spaces in front so that we can directly check the header tags
-    std::string shader_source = StrUtils::trim_left_copy(source);
+    std::string shader_source = StrUtils::trim_left_copy(raw_source);
 
     // If the #version tag is missing, add it with the current version
     if (!shader_source.starts_with("#version")) {
@@ -60,7 +144,11 @@ void Shader::load_source(std::string const& source) const
         shader_source = header + "\n#line 0\n" + shader_source;
     }
 
-    Renderer::send_shader_source(index, shader_source);
+    // Includes not registered are searched next to the shader's file, if any
+    Renderer::send_shader_source(
+        index,
+        ShaderPreprocessor::process(shader_source, defines, (path.empty() ? FilePath() : path.recover_path_to_file()))
+    );
 
     Log::debug("[Shader] Loaded source");
 }
@@ -97,11 +185,13 @@ VertexShader VertexShader::clone() const
 {
     VertexShader res;
 
+    res.defines = defines;
+
     if (!path.empty()) {
         res.import(path);
     }
     else {
-        res.load_source(Renderer::recover_shader_source(index));
+        res.load_source(raw_source);
     }
 
     return res;
@@ -126,11 +216,13 @@ TessellationControlShader TessellationControlShader::clone() const
 {
     TessellationControlShader res;
 
+    res.defines = defines;
+
     if (!path.empty()) {
         res.import(path);
     }
     else {
-        res.load_source(Renderer::recover_shader_source(index));
+        res.load_source(raw_source);
     }
 
     return res;
@@ -154,11 +246,13 @@ TessellationEvaluationShader TessellationEvaluationShader::clone() const
 {
     TessellationEvaluationShader res;
 
+    res.defines = defines;
+
     if (!path.empty()) {
         res.import(path);
     }
     else {
-        res.load_source(Renderer::recover_shader_source(index));
+        res.load_source(raw_source);
     }
 
     return res;
@@ -182,11 +276,13 @@ GeometryShader GeometryShader::clone() const
 {
     GeometryShader res;
 
+    res.defines = defines;
+
     if (!path.empty()) {
         res.import(path);
     }
     else {
-        res.load_source(Renderer::recover_shader_source(index));
+        res.load_source(raw_source);
     }
 
     return res;
@@ -211,11 +307,13 @@ FragmentShader FragmentShader::clone() const
 {
     FragmentShader res;
 
+    res.defines = defines;
+
     if (!path.empty()) {
         res.import(path);
     }
     else {
-        res.load_source(Renderer::recover_shader_source(index));
+        res.load_source(raw_source);
     }
 
     return res;
@@ -240,11 +338,13 @@ ComputeShader ComputeShader::clone() const
 {
     ComputeShader res;
 
+    res.defines = defines;
+
     if (!path.empty()) {
         res.import(path);
     }
     else {
-        res.load_source(Renderer::recover_shader_source(index));
+        res.load_source(raw_source);
     }
 
     return res;
@@ -22,15 +22,29 @@ public:
 
     [[nodiscard]] bool is_compiled() const;
 
+    [[nodiscard]] std::vector<std::string> const& get_defines() const { return defines; }
+
+    /// Checks if the shader's file has been modified & reloaded by the file watcher since the shader has last been
+    ///   loaded. Calling load() then gives it the reloaded source.
+    /// \return True if the shader is outdated, false otherwise.
+    /// \see FileWatcher
+    [[nodiscard]] bool is_outdated() const;
+
     void import(FilePath filepath);
 
     /// Reloads the shader file. The shader must have been previously imported from a file for this function to load
-    /// anything.
+    /// anything. The file is watched afterward, being reloaded in the background when modified.
     /// \see import()
     void load() const;
 
     void compile() const;
 
+    /// Sets the preprocessor symbols defined at the top of the shader's source, & loads its source again with them. The
+    ///   shader needs to be compiled again for them to be applied.
+    /// \param defines Symbols to be defined, optionally followed by a value (e.g. "MAX_COUNT 4").
+    /// \see ShaderPreprocessor::process()
+    void set_defines(std::vector<std::string> defines);
+
     void destroy();
 
 protected:
@@ -38,9 +52,18 @@ protected:
 
     void load_source(std::string const& source) const;
 
+    /// Preprocesses the shader's raw source with its defines & includes, & sends the result to the driver.
+    void process_source() const;
+
 protected:
     OwnerValue<uint32_t> index{};
     FilePath path{};
+    std::vector<std::string> defines{};
+    /// Source the shader has last been loaded from, before being preprocessed; kept so that it can be processed again
+    ///   with other defines.
+    mutable std::string raw_source{};
+    /// Version of the shader's file that has last been loaded, incremented every time the file watcher reloads it.
+    mutable uint32_t loaded_version = 0;
 };
 
 class VertexShader final : public Shader {
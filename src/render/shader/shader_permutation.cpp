@@ -0,0 +1,116 @@
+#include "shader_permutation.hpp"
+
+#include <render/shader/program_cache.hpp>
+#include <render/shader/shader_program.hpp>
+#include <utils/hash.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace xen::ShaderPermutation {
+namespace {
+constexpr std::array<std::pair<ShaderFeature, std::string_view>, 4> feature_defines = {
+    {{ShaderFeature::NORMAL_MAP, "XEN_NORMAL_MAP"},
+     {ShaderFeature::ALPHA_TEST, "XEN_ALPHA_TEST"},
+     {ShaderFeature::INSTANCING, "XEN_INSTANCING"},
+     {ShaderFeature::MATERIAL_TABLE, "XEN_MATERIAL_TABLE"}}
+};
+
+bool sharing_enabled = true;
+
+/// Programs shared between the programs of the same permutation, identified by the key of their shaders' sources.
+///   They are only weakly referenced, so that a shared program is destroyed once no program uses it anymore.
+std::unordered_map<uint64_t, std::weak_ptr<RenderShaderProgram const>> shared_programs;
+} // namespace
+
+std::vector<std::string> recover_defines(ShaderFeature permutation)
+{
+    std::vector<std::string> defines;
+
+    for (uint32_t bit_index = 0; bit_index < 32; ++bit_index) {
+        auto const feature = static_cast<ShaderFeature>(1u << bit_index);
+
+        if ((permutation & feature) == ShaderFeature::NONE) {
+            continue;
+        }
+
+        auto const feature_it = std::find_if(
+            feature_defines.cbegin(), feature_defines.cend(),
+            [feature](auto const& feature_define) { return (feature_define.first == feature); }
+        );
+
+        defines.emplace_back(
+            feature_it != feature_defines.cend() ? std::string(feature_it->second) :
+                                                   "XEN_FEATURE_" + std::to_string(bit_index)
+        );
+    }
+
+    return defines;
+}
+
+void enable_sharing(bool enabled)
+{
+    sharing_enabled = enabled;
+}
+
+void disable_sharing()
+{
+    enable_sharing(false);
+}
+
+bool is_sharing_enabled()
+{
+    return sharing_enabled;
+}
+
+std::shared_ptr<RenderShaderProgram const> recover_shared_program(RenderShaderProgram const& program)
+{
+    ZoneScopedN("ShaderPermutation::recover_shared_program");
+
+    // The key identifies the shaders' preprocessed sources, thus including the permutation's defines
+    uint64_t const key = ProgramCache::compute_key(program.get_index());
+
+    if (key == 0) {
+        return nullptr;
+    }
+
+    if (auto const shared_program_it = shared_programs.find(key); shared_program_it != shared_programs.cend()) {
+        if (std::shared_ptr<RenderShaderProgram const> shared_program = shared_program_it->second.lock()) {
+            return shared_program;
+        }
+    }
+
+    std::erase_if(shared_programs, [](auto const& shared_program) { return shared_program.second.expired(); });
+
+    auto shared_program = std::make_shared<RenderShaderProgram>();
+    shared_program->set_vertex_shader(program.get_vertex_shader().clone());
+#if !defined(USE_OPENGL_ES)
+    if (program.has_tessellation_control_shader()) {
+        shared_program->set_tessellation_control_shader(program.get_tessellation_control_shader().clone());
+    }
+    if (program.has_tessellation_evaluation_shader()) {
+        shared_program->set_tessellation_evaluation_shader(program.get_tessellation_evaluation_shader().clone());
+    }
+    if (program.has_geometry_shader()) {
+        shared_program->set_geometry_shader(program.get_geometry_shader().clone());
+    }
+#endif
+    shared_program->set_fragment_shader(program.get_fragment_shader().clone());
+    shared_program->link();
+
+    Log::debug(
+        "[ShaderPermutation] Linked shared program (ID: " + std::to_string(shared_program->get_index()) +
+        ", key: " + Hash::to_hex_string(key) + ")"
+    );
+
+    shared_programs.insert_or_assign(key, shared_program);
+
+    return shared_program;
+}
+
+size_t get_shared_program_count()
+{
+    return static_cast<size_t>(std::count_if(shared_programs.cbegin(), shared_programs.cend(), [](auto const& element) {
+        return !element.second.expired();
+    }));
+}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <utils/enum_utils.hpp>
+
+namespace xen {
+class RenderShaderProgram;
+
+/// Features which can be toggled in a program's shaders; each one enabled defines its preprocessor symbol, given in
+///   comment. A combination of features is a program's permutation key.
+enum class ShaderFeature : uint32_t {
+    NONE = 0,
+    NORMAL_MAP = 1,    ///< XEN_NORMAL_MAP: normals are perturbed by the material's normal map.
+    ALPHA_TEST = 2,    ///< XEN_ALPHA_TEST: fragments whose opacity is below a threshold are discarded.
+    INSTANCING = 4,    ///< XEN_INSTANCING: models' transforms are always read from the per-instance vertex attribute.
+    MATERIAL_TABLE = 8 ///< XEN_MATERIAL_TABLE: materials & their bindless textures are read from the material table.
+};
+MAKE_ENUM_FLAG(ShaderFeature)
+
+/// Shader permutations, compiling a program's shaders with the symbols of its features defined.
+/// When sharing is enabled, the programs having the same shaders & permutation key share a single program object,
+/// linked once & kept in a cache for as long as any program uses it; their attributes & textures remain their own,
+/// being sent again each time their textures are bound.
+namespace ShaderPermutation {
+/// Recovers the preprocessor symbols to be defined for a permutation key. Bits not matching any feature define
+///   XEN_FEATURE_<bit index>, so that applications can add their own features.
+/// \param permutation Permutation key.
+/// \return Symbols to be defined.
+[[nodiscard]] std::vector<std::string> recover_defines(ShaderFeature permutation);
+
+/// Enables or disables the sharing of program objects between programs of the same permutation. Only applies to the
+///   programs linked afterward.
+/// \param enabled True to share programs, false otherwise.
+void enable_sharing(bool enabled = true);
+
+void disable_sharing();
+
+[[nodiscard]] bool is_sharing_enabled();
+
+/// Recovers the program shared by all programs having the same shaders as the given one, linking it if none exists.
+/// \param program Program to recover the shared program of; its shaders must be attached to its own program object.
+/// \return Shared program; null if the program has no shader with a source.
+[[nodiscard]] std::shared_ptr<RenderShaderProgram const> recover_shared_program(RenderShaderProgram const& program);
+
+/// Gets the number of shared programs currently in use.
+/// \return Number of distinct permutations linked.
+[[nodiscard]] size_t get_shared_program_count();
+}
+}
@@ -0,0 +1,223 @@
+#include "shader_preprocessor.hpp"
+
+#include <utils/file_utils.hpp>
+#include <utils/filepath.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <charconv>
+#include <unordered_set>
+
+namespace xen::ShaderPreprocessor {
+namespace {
+constexpr std::string_view camera_info_source = {
+#include "camera_info.glsl.embed"
+};
+
+constexpr std::string_view model_info_source = {
+#include "model_info.glsl.embed"
+};
+
+constexpr std::string_view lights_info_source = {
+#include "lights_info.glsl.embed"
+};
+
+constexpr std::string_view shadows_source = {
+#include "shadows.glsl.embed"
+};
+
+constexpr std::string_view lod_fade_source = {
+#include "lod_fade.glsl.embed"
+};
+
+constexpr std::string_view motion_source = {
+#include "motion.glsl.embed"
+};
+
+std::unordered_map<std::string, std::string>& get_includes()
+{
+    static std::unordered_map<std::string, std::string> includes = {
+        {"camera_info.glsl", std::string(camera_info_source)}, {"model_info.glsl", std::string(model_info_source)},
+        {"lights_info.glsl", std::string(lights_info_source)}, {"shadows.glsl", std::string(shadows_source)},
+        {"lod_fade.glsl", std::string(lod_fade_source)},       {"motion.glsl", std::string(motion_source)}
+    };
+
+    return includes;
+}
+
+/// Recovers the name given to an include directive.
+/// \param line Line to be checked.
+/// \return Name of the include; empty if the line is not an include directive.
+std::string_view recover_include_name(std::string_view line)
+{
+    size_t const directive_pos = line.find_first_not_of(" \t");
+
+    if (directive_pos == std::string_view::npos || line.compare(directive_pos, 8, "#include") != 0) {
+        return {};
+    }
+
+    size_t const name_start = line.find('"', directive_pos + 8);
+    size_t const name_end = (name_start != std::string_view::npos ? line.find('"', name_start + 1) : name_start);
+
+    if (name_end == std::string_view::npos) {
+        return {};
+    }
+
+    return line.substr(name_start + 1, name_end - name_start - 1);
+}
+
+/// Recovers the line number set by a #line directive.
+/// \param line Line to be checked.
+/// \return Number of the line following the directive; empty if the line is not a #line directive.
+std::optional<size_t> recover_line_directive(std::string_view line)
+{
+    size_t const directive_pos = line.find_first_not_of(" \t");
+
+    if (directive_pos == std::string_view::npos || line.compare(directive_pos, 5, "#line") != 0) {
+        return std::nullopt;
+    }
+
+    size_t const number_pos = line.find_first_not_of(" \t", directive_pos + 5);
+
+    if (number_pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    size_t line_number{};
+    std::string_view const number = line.substr(number_pos);
+
+    if (std::from_chars(number.data(), number.data() + number.size(), line_number).ec != std::errc()) {
+        return std::nullopt;
+    }
+
+    return line_number;
+}
+
+struct ProcessingState {
+    std::unordered_set<std::string> included_names{};
+    size_t source_count = 1;
+    std::string result{};
+};
+
+/// Appends a source to the processed one, recursively replacing its include directives by their sources.
+/// \param source Source to be appended.
+/// \param source_index Source string number of the source, used in the #line directives following its includes.
+/// \param line_number Number of the source's first line.
+/// \param directory Directory in which the source's unregistered includes are searched.
+/// \param state Current processing state.
+void process_includes(
+    std::string_view source, size_t source_index, size_t line_number, FilePath const& directory,
+    ProcessingState& state
+)
+{
+    size_t line_start = 0;
+
+    while (line_start < source.size()) {
+        size_t line_end = source.find('\n', line_start);
+
+        if (line_end == std::string_view::npos) {
+            line_end = source.size();
+        }
+
+        std::string_view const line = source.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+
+        if (std::optional<size_t> const directive_number = recover_line_directive(line)) {
+            state.result += line;
+            state.result += '\n';
+            line_number = *directive_number;
+            continue;
+        }
+
+        std::string const include_name(recover_include_name(line));
+
+        if (include_name.empty()) {
+            state.result += line;
+            state.result += '\n';
+            ++line_number;
+            continue;
+        }
+
+        ++line_number;
+
+        // Already included sources are replaced by an empty line, keeping the following lines' numbers
+        if (!state.included_names.emplace(include_name).second) {
+            state.result += '\n';
+            continue;
+        }
+
+        std::string include_source;
+        FilePath include_directory = directory;
+
+        if (auto const include_it = get_includes().find(include_name); include_it != get_includes().cend()) {
+            include_source = include_it->second;
+        }
+        else if (!directory.empty() && FileUtils::is_readable(directory + include_name)) {
+            FilePath const include_path = directory + include_name;
+            include_source = FileUtils::read_file_to_string(include_path);
+            include_directory = include_path.recover_path_to_file();
+        }
+        else {
+            // The directive is kept, so that the shader's compilation fails at this line
+            Log::error("[ShaderPreprocessor] The include '" + include_name + "' could not be found");
+            state.result += line;
+            state.result += '\n';
+            continue;
+        }
+
+        size_t const include_index = state.source_count++;
+
+        state.result += "#line 1 " + std::to_string(include_index) + '\n';
+        process_includes(include_source, include_index, 1, include_directory, state);
+        state.result += "#line " + std::to_string(line_number) + ' ' + std::to_string(source_index) + '\n';
+    }
+}
+} // namespace
+
+void register_include(std::string name, std::string source)
+{
+    get_includes().insert_or_assign(std::move(name), std::move(source));
+}
+
+void unregister_include(std::string const& name)
+{
+    get_includes().erase(name);
+}
+
+bool has_include(std::string const& name)
+{
+    return get_includes().contains(name);
+}
+
+std::string process(std::string const& source, std::vector<std::string> const& defines, FilePath const& directory)
+{
+    ZoneScopedN("ShaderPreprocessor::process");
+
+    ProcessingState state;
+    state.result.reserve(source.size());
+
+    std::string_view remaining_source = source;
+    size_t first_line_number = 1;
+
+    if (!defines.empty()) {
+        // The defines must follow the #version directive, which has to come first
+        size_t const version_end = (source.starts_with("#version") ? source.find('\n') : std::string::npos);
+
+        if (version_end != std::string::npos) {
+            state.result.append(source, 0, version_end + 1);
+            remaining_source.remove_prefix(version_end + 1);
+            first_line_number = 2;
+        }
+
+        for (std::string const& define : defines) {
+            state.result += "#define " + define + '\n';
+        }
+
+        state.result += "#line " + std::to_string(first_line_number) + " 0\n";
+    }
+
+    process_includes(remaining_source, 0, first_line_number, directory, state);
+
+    return std::move(state.result);
+}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace xen {
+class FilePath;
+
+/// Shader source preprocessor, applied to every shader's source before it is sent to the driver.
+/// - Lines of the form '#include "name"' are replaced by the source of the given include. Includes are searched among
+///   the registered ones first, which by default hold the engine's shared shader code (camera_info.glsl,
+///   model_info.glsl, lights_info.glsl, shadows.glsl, lod_fade.glsl & motion.glsl), then relative to the file of the
+///   shader including them. An include is only inserted once per shader, so that includes can depend on each other;
+/// - Each include is given its own source string number in #line directives, so that compilation errors point to the
+///   right file & line: the shader itself is 0, its includes are numbered in the order they are inserted;
+/// - Defines are inserted right after the #version directive.
+namespace ShaderPreprocessor {
+/// Registers an include, which shaders can then insert by name. Replaces any include already registered with this name.
+/// \param name Name of the include, as written in the include directives.
+/// \param source Source of the include.
+void register_include(std::string name, std::string source);
+
+void unregister_include(std::string const& name);
+
+[[nodiscard]] bool has_include(std::string const& name);
+
+/// Processes a shader's source, resolving its includes & inserting the given defines.
+/// \param source Source to be processed.
+/// \param defines Preprocessor symbols to be defined, optionally followed by a value (e.g. "MAX_COUNT 4").
+/// \param directory Directory in which the includes which are not registered are searched; if empty, only registered
+///   includes can be found.
+/// \return Processed source.
+[[nodiscard]] std::string process(
+    std::string const& source, std::vector<std::string> const& defines, FilePath const& directory
+);
+}
+}
@@ -1,6 +1,7 @@
 #include "shader_program.hpp"
 
 #include <render/renderer.hpp>
+#include <render/shader/program_cache.hpp>
 
 #include <tracy/Tracy.hpp>
 
@@ -14,8 +15,11 @@ inline void check_program_used([[maybe_unused]] ShaderProgram const& program)
     }
 #endif
 }
+}
+
+ShaderProgram::ShaderProgram() : index{Renderer::create_program()} {}
 
-ImageInternalFormat recover_image_texture_format(Texture const& texture)
+ImageInternalFormat ShaderProgram::recover_image_texture_format(Texture const& texture)
 {
     TextureColorspace const colorspace = texture.get_colorspace();
     TextureDataType const data_type = texture.get_data_type();
@@ -56,9 +60,6 @@ ImageInternalFormat recover_image_texture_format(Texture const& texture)
 
     throw std::invalid_argument("[ShaderProgram] The given image texture is not supported");
 }
-}
-
-ShaderProgram::ShaderProgram() : index{Renderer::create_program()} {}
 
 bool ShaderProgram::has_attribute(std::string const& uniform_name) const
 {
@@ -136,6 +137,13 @@ void ShaderProgram::set_texture(TexturePtr texture, const std::string& uniform_n
     }
 }
 
+void ShaderProgram::copy_attributes(ShaderProgram const& program)
+{
+    for (auto const& [uniform_name, attribute] : program.attributes) {
+        std::visit([this, &name = uniform_name](auto const& value) { set_attribute(value, name); }, attribute.value);
+    }
+}
+
 #if !defined(USE_WEBGL)
 void ShaderProgram::set_image_texture(TexturePtr texture, const std::string& uniform_name, ImageTextureUsage usage)
 {
@@ -187,17 +195,49 @@ void ShaderProgram::link()
 
     Log::debug("[ShaderProgram] Linking (ID: " + std::to_string(index) + ")...");
 
+    binary_key = (ProgramCache::is_enabled() && ProgramCache::is_supported() ? ProgramCache::compute_key(index) : 0);
+
+    if (binary_key != 0 && ProgramCache::load(index, binary_key)) {
+        binary_key = 0;
+        is_link_pending = false;
+        update_attributes_locations();
+
+        Log::debug("[ShaderProgram] Linked from cache");
+        return;
+    }
+
+    // The shaders are only compiled when the program could not be loaded from the cache
+    compile_shaders();
+
+#if !defined(USE_WEBGL)
+    if (binary_key != 0) {
+        Renderer::set_program_parameter(index, ProgramParameter::PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
+    }
+#endif
+
     Renderer::link_program(index);
-    update_attributes_locations();
+    is_link_pending = true;
 
-    Log::debug("[ShaderProgram] Linked");
+    // With parallel compilation, the link runs in the background & is only waited for once the program is needed
+    if (!Renderer::is_parallel_shader_compilation_enabled()) {
+        finish_link();
+    }
 }
 
 bool ShaderProgram::is_linked() const
 {
+    if (is_link_pending) {
+        finish_link();
+    }
+
     return Renderer::is_program_linked(index);
 }
 
+bool ShaderProgram::is_link_completed() const
+{
+    return (!is_link_pending || Renderer::is_program_link_completed(index));
+}
+
 void ShaderProgram::update_shaders()
 {
     ZoneScopedN("ShaderProgram::update_shaders");
@@ -205,7 +245,6 @@ void ShaderProgram::update_shaders()
     Log::debug("[ShaderProgram] Updating shaders...");
 
     load_shaders();
-    compile_shaders();
     link();
     send_attributes();
     init_textures();
@@ -218,6 +257,10 @@ void ShaderProgram::update_shaders()
 
 void ShaderProgram::use() const
 {
+    if (is_link_pending) {
+        finish_link();
+    }
+
     Renderer::use_program(index);
 }
 
@@ -280,6 +323,11 @@ void ShaderProgram::bind_textures() const
 {
     ZoneScopedN("ShaderProgram::bind_textures");
 
+    if (shared_program != nullptr) {
+        send_attributes();
+        init_textures();
+    }
+
     use();
 
     uint32_t texture_index = 0;
@@ -371,6 +419,10 @@ void ShaderProgram::remove_image_texture(std::string const& uniform_name)
 
 int ShaderProgram::recover_uniform_location(const std::string& uniform_name) const
 {
+    if (is_link_pending) {
+        finish_link();
+    }
+
     return Renderer::recover_uniform_location(index, uniform_name.c_str());
 }
 
@@ -492,7 +544,8 @@ ShaderProgram::~ShaderProgram()
 {
     ZoneScopedN("ShaderProgram::~ShaderProgram");
 
-    if (!index.is_valid()) {
+    // A shared program object is destroyed along with the last program owning it
+    if (!index.is_valid() || shared_program != nullptr) {
         return;
     }
 
@@ -501,12 +554,41 @@ ShaderProgram::~ShaderProgram()
     Log::debug("[ShaderProgram] Destroyed");
 }
 
-void ShaderProgram::update_attributes_locations()
+void ShaderProgram::finish_link() const
+{
+    ZoneScopedN("ShaderProgram::finish_link");
+
+    is_link_pending = false;
+
+    // The shared program checks its own link
+    if (shared_program != nullptr) {
+        static_cast<void>(shared_program->is_linked());
+        update_attributes_locations();
+        return;
+    }
+
+    // Without parallel compilation, the link's result has already been checked when linking
+    bool const is_successful = (Renderer::is_parallel_shader_compilation_enabled() ?
+                                    Renderer::check_program_link(index) :
+                                    Renderer::is_program_linked(index));
+
+    update_attributes_locations();
+
+    if (is_successful && binary_key != 0) {
+        ProgramCache::save(index, binary_key);
+    }
+
+    binary_key = 0;
+
+    Log::debug("[ShaderProgram] Linked (ID: " + std::to_string(index) + ")");
+}
+
+void ShaderProgram::update_attributes_locations() const
 {
     ZoneScopedN("ShaderProgram::update_attributes_locations");
 
-    for (auto& [name, attrib] : attributes) {
-        attrib.location = recover_uniform_location(name);
+    for (auto const& [name, attrib] : attributes) {
+        attrib.location = Renderer::recover_uniform_location(index, name.c_str());
     }
 }
 
@@ -517,12 +599,13 @@ void RenderShaderProgram::set_vertex_shader(VertexShader&& vert_shader)
         ", path: " + vert_shader.get_path() + ")"
     );
 
+    release_shared_program();
+
     if (Renderer::is_shader_attached(index, this->vert_shader.get_index())) {
         Renderer::detach_shader(index, this->vert_shader.get_index());
     }
 
     this->vert_shader = std::move(vert_shader);
-    this->vert_shader.compile();
 
     Renderer::attach_shader(index, this->vert_shader.get_index());
 }
@@ -535,12 +618,13 @@ void RenderShaderProgram::set_tessellation_control_shader(TessellationControlSha
         std::to_string(tess_ctrl_shader.get_index()) + ", path: " + tess_ctrl_shader.get_path() + ")"
     );
 
+    release_shared_program();
+
     if (this->tess_ctrl_shader && Renderer::is_shader_attached(index, this->tess_ctrl_shader->get_index())) {
         Renderer::detach_shader(index, this->tess_ctrl_shader->get_index());
     }
 
     this->tess_ctrl_shader = std::move(tess_ctrl_shader);
-    this->tess_ctrl_shader->compile();
 
     Renderer::attach_shader(index, this->tess_ctrl_shader->get_index());
 }
@@ -552,12 +636,13 @@ void RenderShaderProgram::set_tessellation_evaluation_shader(TessellationEvaluat
         std::to_string(tess_eval_shader.get_index()) + ", path: " + tess_eval_shader.get_path() + ")"
     );
 
+    release_shared_program();
+
     if (this->tess_eval_shader && Renderer::is_shader_attached(index, this->tess_eval_shader->get_index())) {
         Renderer::detach_shader(index, this->tess_eval_shader->get_index());
     }
 
     this->tess_eval_shader = std::move(tess_eval_shader);
-    this->tess_eval_shader->compile();
 
     Renderer::attach_shader(index, this->tess_eval_shader->get_index());
 }
@@ -569,12 +654,13 @@ void RenderShaderProgram::set_geometry_shader(GeometryShader&& geom_shader)
         ", path: " + geom_shader.get_path() + ")"
     );
 
+    release_shared_program();
+
     if (this->geom_shader && Renderer::is_shader_attached(index, this->geom_shader->get_index())) {
         Renderer::detach_shader(index, this->geom_shader->get_index());
     }
 
     this->geom_shader = std::move(geom_shader);
-    this->geom_shader->compile();
 
     Renderer::attach_shader(index, this->geom_shader->get_index());
 }
@@ -587,12 +673,13 @@ void RenderShaderProgram::set_fragment_shader(FragmentShader&& frag_shader)
         ", path: " + frag_shader.get_path() + ")"
     );
 
+    release_shared_program();
+
     if (Renderer::is_shader_attached(index, this->frag_shader.get_index())) {
         Renderer::detach_shader(index, this->frag_shader.get_index());
     }
 
     this->frag_shader = std::move(frag_shader);
-    this->frag_shader.compile();
 
     Renderer::attach_shader(index, this->frag_shader.get_index());
 }
@@ -660,6 +747,8 @@ RenderShaderProgram RenderShaderProgram::clone() const
 #endif
     program.set_fragment_shader(frag_shader.clone());
 
+    program.permutation = permutation;
+    program.has_permutation = has_permutation;
     program.link();
 
     program.attributes = attributes;
@@ -677,6 +766,66 @@ RenderShaderProgram RenderShaderProgram::clone() const
     return program;
 }
 
+void RenderShaderProgram::set_permutation(ShaderFeature permutation)
+{
+    ZoneScopedN("RenderShaderProgram::set_permutation");
+
+    this->permutation = permutation;
+    has_permutation = true;
+
+    std::vector<std::string> defines = ShaderPermutation::recover_defines(permutation);
+
+    vert_shader.set_defines(defines);
+#if !defined(USE_OPENGL_ES)
+    if (tess_ctrl_shader) {
+        tess_ctrl_shader->set_defines(defines);
+    }
+    if (tess_eval_shader) {
+        tess_eval_shader->set_defines(defines);
+    }
+    if (geom_shader) {
+        geom_shader->set_defines(defines);
+    }
+#endif
+    frag_shader.set_defines(std::move(defines));
+
+    link();
+}
+
+void RenderShaderProgram::link()
+{
+    // The program's own object is needed both to link it & to identify its shaders
+    release_shared_program();
+
+    if (!has_permutation || !ShaderPermutation::is_sharing_enabled()) {
+        ShaderProgram::link();
+        return;
+    }
+
+    std::shared_ptr<RenderShaderProgram const> program = ShaderPermutation::recover_shared_program(*this);
+
+    if (program == nullptr) {
+        ShaderProgram::link();
+        return;
+    }
+
+    Log::debug(
+        "[RenderShaderProgram] Sharing program (ID: " + std::to_string(index) +
+        ", shared ID: " + std::to_string(program->get_index()) + ")"
+    );
+
+    Renderer::delete_program(index);
+    index = program->get_index();
+    shared_program = std::move(program);
+
+    binary_key = 0;
+    is_link_pending = true;
+
+    if (!Renderer::is_parallel_shader_compilation_enabled()) {
+        finish_link();
+    }
+}
+
 void RenderShaderProgram::load_shaders() const
 {
     ZoneScopedN("RenderShaderProgram::load_shaders");
@@ -723,10 +872,52 @@ void RenderShaderProgram::compile_shaders() const
     Log::debug("[RenderShaderProgram] Compiled shaders");
 }
 
+bool RenderShaderProgram::has_outdated_shaders() const
+{
+#if !defined(USE_OPENGL_ES)
+    if ((tess_ctrl_shader && tess_ctrl_shader->is_outdated()) ||
+        (tess_eval_shader && tess_eval_shader->is_outdated()) || (geom_shader && geom_shader->is_outdated())) {
+        return true;
+    }
+#endif
+
+    return (vert_shader.is_outdated() || frag_shader.is_outdated());
+}
+
+void RenderShaderProgram::release_shared_program()
+{
+    if (shared_program == nullptr) {
+        return;
+    }
+
+    shared_program.reset();
+    index = Renderer::create_program();
+
+    if (vert_shader.is_valid()) {
+        Renderer::attach_shader(index, vert_shader.get_index());
+    }
+#if !defined(USE_OPENGL_ES)
+    if (tess_ctrl_shader) {
+        Renderer::attach_shader(index, tess_ctrl_shader->get_index());
+    }
+    if (tess_eval_shader) {
+        Renderer::attach_shader(index, tess_eval_shader->get_index());
+    }
+    if (geom_shader) {
+        Renderer::attach_shader(index, geom_shader->get_index());
+    }
+#endif
+    if (frag_shader.is_valid()) {
+        Renderer::attach_shader(index, frag_shader.get_index());
+    }
+}
+
 void RenderShaderProgram::destroy_vertex_shader()
 {
     ZoneScopedN("RenderShaderProgram::destroy_vertex_shader");
 
+    release_shared_program();
+
     Renderer::detach_shader(index, vert_shader.get_index());
     vert_shader.destroy();
 }
@@ -736,6 +927,8 @@ void RenderShaderProgram::destroy_tessellation_control_shader()
 {
     ZoneScopedN("RenderShaderProgram::destroy_tessellation_control_shader");
 
+    release_shared_program();
+
     if (!tess_ctrl_shader) {
         return;
     }
@@ -749,6 +942,8 @@ void RenderShaderProgram::destroy_tessellation_evaluation_shader()
 {
     ZoneScopedN("RenderShaderProgram::destroy_tessellation_evaluation_shader");
 
+    release_shared_program();
+
     if (!tess_eval_shader) {
         return;
     }
@@ -762,6 +957,8 @@ void RenderShaderProgram::destroy_geometry_shader()
 {
     ZoneScopedN("RenderShaderProgram::destroy_geometry_shader");
 
+    release_shared_program();
+
     if (!geom_shader) {
         return;
     }
@@ -776,6 +973,8 @@ void RenderShaderProgram::destroy_fragment_shader()
 {
     ZoneScopedN("RenderShaderProgram::destroy_fragment_shader");
 
+    release_shared_program();
+
     Renderer::detach_shader(index, frag_shader.get_index());
     frag_shader.destroy();
 }
@@ -788,14 +987,13 @@ void ComputeShaderProgram::set_shader(ComputeShader&& comp_shader)
         ", path: " + comp_shader.get_path() + ")"
     );
 
-    if (Renderer::is_shader_attached(index, comp_shader.get_index())) {
-        Renderer::detach_shader(index, comp_shader.get_index());
+    if (Renderer::is_shader_attached(index, this->comp_shader.get_index())) {
+        Renderer::detach_shader(index, this->comp_shader.get_index());
     }
 
-    comp_shader = std::move(comp_shader);
-    comp_shader.compile();
+    this->comp_shader = std::move(comp_shader);
 
-    Renderer::attach_shader(index, comp_shader.get_index());
+    Renderer::attach_shader(index, this->comp_shader.get_index());
 
     link();
 }
@@ -2,6 +2,7 @@
 
 #include <data/owner_value.hpp>
 #include <render/shader/shader.hpp>
+#include <render/shader/shader_permutation.hpp>
 #include <render/texture.hpp>
 
 #if !defined(USE_WEBGL) && defined(EMSCRIPTEN)
@@ -33,6 +34,16 @@ public:
 
     [[nodiscard]] uint32_t get_index() const { return index; }
 
+    /// Checks if the program uses a program object shared with other programs, instead of its own.
+    /// \return True if the program object is shared, false otherwise.
+    /// \see ShaderPermutation
+    [[nodiscard]] bool is_shared() const { return (shared_program != nullptr); }
+
+    /// Recovers the format with which a texture is bound as an image, matching its colorspace & data type.
+    /// \param texture Texture to recover the image format of.
+    /// \return Internal format of the image.
+    [[nodiscard]] static ImageInternalFormat recover_image_texture_format(Texture const& texture);
+
     /// Checks if an attribute has been set with the given uniform name.
     /// \param uniform_name Uniform name to be checked.
     /// \return True if an attribute exists with the given name, false otherwise.
@@ -88,6 +99,11 @@ public:
     [[nodiscard]] Texture const& get_image_texture(size_t index) const { return *image_textures[index].first; }
 
     [[nodiscard]] Texture const& get_image_texture(std::string const& uniform_name) const;
+
+    [[nodiscard]] ImageAccess get_image_texture_access(size_t index) const
+    {
+        return image_textures[index].second.access;
+    }
 #endif
 
     /// Sets an attribute to be sent to the shaders. If the uniform name already exists, replaces the attribute's value.
@@ -97,6 +113,11 @@ public:
     template <typename T>
     void set_attribute(T&& attrib_val, std::string const& uniform_name);
 
+    /// Copies the values of all attributes of another program, replacing those with the same uniform names.
+    /// \note The attributes are not sent; you may want to call send_attributes() afterward.
+    /// \param program Program to copy the attributes from.
+    void copy_attributes(ShaderProgram const& program);
+
     /// Sets a texture to be bound to the shaders. If the uniform name already exists, replaces the texture.
     /// \param texture Texture to set.
     /// \param uniform_name Uniform name to bind the texture to.
@@ -119,16 +140,32 @@ public:
     /// Compiles all the shaders contained by the program.
     virtual void compile_shaders() const = 0;
 
-    /// Links the program to the graphics card.
+    /// Checks if any shader contained by the program has been reloaded by the file watcher since it has last been
+    ///   loaded; the program then needs its shaders to be updated.
+    /// \return True if at least one shader is outdated, false otherwise.
+    /// \see update_shaders(), Shader::is_outdated()
+    [[nodiscard]] virtual bool has_outdated_shaders() const = 0;
+
+    /// Links the program to the graphics card. If the program cache holds a binary for the program's shaders, it is
+    ///   directly loaded; otherwise, the shaders are compiled & the program linked, its binary being then cached.
     /// \note Linking a program resets all its attributes' values and textures' bindings;
     ///   you may want to call send_attributes(), init_textures() & init_image_textures() afterward.
-    void link();
+    /// \note With parallel shader compilation, this does not wait for the link to be completed; it is only waited for
+    ///   once the program is needed, for instance when used or when recovering a uniform location.
+    /// \see ProgramCache, Renderer::is_parallel_shader_compilation_enabled()
+    virtual void link();
 
-    /// Checks if the program has been successfully linked.
+    /// Checks if the program has been successfully linked, waiting for its link to be completed.
     /// \return True if the program is linked, false otherwise.
     bool is_linked() const;
 
-    /// Loads & compiles all the shaders contained by the program, links it and initializes its attributes & textures.
+    /// Checks if the program's link has completed, whether successfully or not, without waiting for it. This allows
+    ///   linking many programs at once & polling them, instead of waiting for each link in turn.
+    /// \return True if the link has completed, false if it is still running in the background.
+    bool is_link_completed() const;
+
+    /// Loads all the shaders contained by the program, links it (compiling the shaders if needed) and initializes
+    ///   its attributes & textures.
     void update_shaders();
 
     /// Marks the program as used.
@@ -150,7 +187,8 @@ public:
     /// Sets the program's textures' binding points.
     void init_textures() const;
 
-    /// Binds the program's textures.
+    /// Binds the program's textures. If the program object is shared, its attributes & textures' binding points are
+    ///   sent again beforehand, the object holding those of the program sharing it that has last been bound.
     void bind_textures() const;
 
     /// Removes all textures associated with the given texture.
@@ -489,7 +527,7 @@ public:
 
 protected:
     struct Attribute {
-        int location = -1;
+        mutable int location = -1;
         std::variant<
             int, uint32_t, float, Vector2i, Vector3i, Vector4i, Vector2ui, Vector3ui, Vector4ui, Vector2f, Vector3f,
             Vector4f, Matrix2, Matrix3, Matrix4, Color, std::vector<int>, std::vector<uint32_t>, std::vector<float>>
@@ -503,6 +541,13 @@ protected:
     };
 
     OwnerValue<uint32_t> index{};
+    /// Key of the program in the program cache, for its binary to be saved once its link is completed; 0 if it is not
+    ///   to be saved.
+    mutable uint64_t binary_key = 0;
+    mutable bool is_link_pending = false;
+    /// Program whose object is used instead of this program's own, index then being a copy of its index; null if the
+    ///   program uses its own object.
+    std::shared_ptr<ShaderProgram const> shared_program{};
 
     std::unordered_map<std::string, Attribute> attributes{};
     std::vector<std::pair<TexturePtr, std::string>> textures{};
@@ -510,9 +555,12 @@ protected:
     std::vector<std::pair<TexturePtr, ImageTextureAttachment>> image_textures{};
 #endif
 
+    /// Waits for the program's link to be completed, checks its result & saves its binary into the program cache.
+    void finish_link() const;
+
 private:
     /// Updates all attributes' uniform locations.
-    void update_attributes_locations();
+    void update_attributes_locations() const;
 };
 
 class RenderShaderProgram final : public ShaderProgram {
@@ -553,6 +601,8 @@ public:
 #endif
     const FragmentShader& get_fragment_shader() const { return frag_shader; }
 
+    [[nodiscard]] ShaderFeature get_permutation() const { return permutation; }
+
     void set_vertex_shader(VertexShader&& vert_shader);
 
 #if !defined(USE_OPENGL_ES)
@@ -580,14 +630,28 @@ public:
     );
 #endif
 
+    /// Sets the program's permutation, defining the symbols of the given features in all its shaders, & links it again.
+    ///   If permutation sharing is enabled, the program then uses the object shared by all programs having the same
+    ///   shaders & permutation.
+    /// \param permutation Features to be enabled.
+    /// \see ShaderPermutation
+    void set_permutation(ShaderFeature permutation);
+
     RenderShaderProgram clone() const;
 
+    /// Links the program. If it has been given a permutation & sharing is enabled, the object shared by the programs
+    ///   having the same shaders is used instead of its own, being linked only if no such program exists yet.
+    /// \see ShaderProgram::link()
+    void link() override;
+
     /// Loads all the shaders contained by the program.
     void load_shaders() const override;
 
     /// Compiles all the shaders contained by the program.
     void compile_shaders() const override;
 
+    [[nodiscard]] bool has_outdated_shaders() const override;
+
     /// Destroys the vertex shader, detaching it from the program & deleting it.
     void destroy_vertex_shader();
 
@@ -610,6 +674,13 @@ private:
     std::optional<GeometryShader> geom_shader{};
 #endif
     FragmentShader frag_shader{};
+
+    ShaderFeature permutation = ShaderFeature::NONE;
+    bool has_permutation = false;
+
+private:
+    /// Stops using the shared program object, if any, creating the program's own & attaching its shaders to it.
+    void release_shared_program();
 };
 
 #if !defined(USE_WEBGL)
@@ -633,6 +704,8 @@ public:
     /// Compiles the compute shader contained by the program.
     void compile_shaders() const override;
 
+    [[nodiscard]] bool has_outdated_shaders() const override { return comp_shader.is_outdated(); }
+
     void execute(Vector3ui group_content = Vector3ui(1)) const;
 
     /// Destroys the compute shader, detaching it from the program & deleting it.
@@ -23,7 +23,8 @@ void ShaderProgram::set_attribute(T&& attrib_val, std::string const& uniform_nam
         attr_it->second.value = std::forward<T>(attrib_val);
     }
     else {
-        int const location_index = (is_linked() ? recover_uniform_location(uniform_name) : -1);
+        // A pending link is not waited for, the locations being updated once it is completed
+        int const location_index = (!is_link_pending && is_linked() ? recover_uniform_location(uniform_name) : -1);
         attributes.emplace(uniform_name, Attribute{location_index, std::forward<T>(attrib_val)});
     }
 }
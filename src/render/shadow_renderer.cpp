@@ -0,0 +1,584 @@
+#include "shadow_renderer.hpp"
+
+#include <physics/frustum.hpp>
+#include <render/camera.hpp>
+#include <render/mesh_renderer.hpp>
+#include <render/renderer.hpp>
+#include <utils/hash.hpp>
+
+#include <tracy/Tracy.hpp>
+#include <GL/glew.h> // Needed by TracyOpenGL.hpp
+#include <tracy/TracyOpenGL.hpp>
+
+namespace xen {
+namespace {
+constexpr std::string_view shadow_vert_source = {
+#include "shadow.vert.embed"
+};
+
+constexpr std::string_view shadow_frag_source = {
+#include "shadow.frag.embed"
+};
+
+// Offsets of the shadow uniform buffer's fields, laid out following the std140 rules
+constexpr uint32_t cascade_matrices_offset = 0;
+constexpr uint32_t local_matrices_offset =
+    cascade_matrices_offset + sizeof(Matrix4) * ShadowRenderer::max_cascade_count;
+constexpr uint32_t cascade_splits_offset =
+    local_matrices_offset + sizeof(Matrix4) * ShadowRenderer::max_local_tile_count;
+constexpr uint32_t cascade_texel_sizes_offset = cascade_splits_offset + sizeof(Vector4f);
+constexpr uint32_t parameters_offset = cascade_texel_sizes_offset + sizeof(Vector4f);
+constexpr uint32_t light_infos_offset = parameters_offset + sizeof(Vector4f);
+constexpr uint32_t cascade_light_index_offset = light_infos_offset + sizeof(Vector4f) * ShadowRenderer::max_light_count;
+constexpr uint32_t cascade_count_offset = cascade_light_index_offset + sizeof(int);
+constexpr uint32_t uniform_buffer_size = cascade_light_index_offset + sizeof(Vector4f);
+
+constexpr uint32_t min_local_tile_resolution = 64;
+constexpr float max_spot_fov = 170.f * std::numbers::pi_v<float> / 180.f;
+
+/// Directions of the faces of a point light's cube, in the order expected by the materials.
+std::array<Vector3f, 6> const cube_face_directions = {
+    Vector3f(1.f, 0.f, 0.f), Vector3f(-1.f, 0.f, 0.f), Vector3f(0.f, 1.f, 0.f),
+    Vector3f(0.f, -1.f, 0.f), Vector3f(0.f, 0.f, 1.f), Vector3f(0.f, 0.f, -1.f)
+};
+
+/// Computes an orthographic projection matrix giving a depth between 0 & 1, as the lights' perspective ones.
+/// \param half_extent Half the width & height of the projected volume.
+/// \param near Near plane's distance.
+/// \param far Far plane's distance.
+/// \return Orthographic projection matrix.
+Matrix4 compute_orthographic_projection(float half_extent, float near, float far)
+{
+    Matrix4 projection(0.f);
+    projection[0][0] = 1.f / half_extent;
+    projection[1][1] = 1.f / half_extent;
+    projection[2][2] = -1.f / (far - near);
+    projection[3][2] = -near / (far - near);
+    projection[3][3] = 1.f;
+    return projection;
+}
+
+/// Computes the matrix bringing the lights' clip-space depth, between 0 & 1, to the one actually stored in the maps.
+/// \return Depth remapping matrix.
+Matrix4 compute_depth_remap()
+{
+    Matrix4 remap;
+
+#if !defined(USE_OPENGL_ES)
+    // The render system sets a [0; 1] clip depth when supported, in which case the depth is stored as is
+    if (Renderer::check_version(4, 5) || Renderer::is_extension_supported("GL_ARB_clip_control")) {
+        return remap;
+    }
+#endif
+
+    // Otherwise, the depth is considered to be in [-1; 1] & brought to [0; 1] by the depth range
+    remap[2][2] = 0.5f;
+    remap[3][2] = 0.5f;
+    return remap;
+}
+
+/// Hashes the values of a matrix.
+/// \param matrix Matrix to be hashed.
+/// \param seed Hash to be combined with.
+/// \return Hash of the matrix.
+uint64_t compute_matrix_hash(Matrix4 const& matrix, uint64_t seed = Hash::fnv1a_offset_basis)
+{
+    return Hash::compute_fnv1a(reinterpret_cast<uint8_t const*>(&matrix[0][0]), sizeof(Matrix4), seed);
+}
+
+/// Chooses an up vector which is not collinear with the given direction.
+/// \param direction Normalized direction to look at.
+/// \return Up vector.
+Vector3f compute_up_vector(Vector3f const& direction)
+{
+    return (std::abs(direction.y) > 0.99f ? Vector3f::Forward : Vector3f::Up);
+}
+} // namespace
+
+ShadowRenderer::ShadowRenderer() : shadow_ubo(uniform_buffer_size, UniformBufferUsage::DYNAMIC)
+{
+    ZoneScopedN("ShadowRenderer::ShadowRenderer");
+
+    depth_program.set_shaders(
+        VertexShader::load_from_source(shadow_vert_source), FragmentShader::load_from_source(shadow_frag_source)
+    );
+    view_projection_location = depth_program.recover_uniform_location("uniLightViewProjMat");
+    model_matrix_location = depth_program.recover_uniform_location("uniModelMat");
+
+    send_empty_data();
+}
+
+void ShadowRenderer::enable(bool enabled)
+{
+    if (enabled == this->enabled) {
+        return;
+    }
+
+    this->enabled = enabled;
+
+    if (enabled) {
+        // The maps may have been left outdated while disabled
+        invalidate_cache();
+    }
+    else {
+        needs_reset = true;
+        begin_frame();
+    }
+}
+
+void ShadowRenderer::set_cascade_count(uint32_t cascade_count)
+{
+    Log::rt_assert(
+        cascade_count >= 1 && cascade_count <= max_cascade_count,
+        "Error: The shadow cascade count must be between 1 & " + std::to_string(max_cascade_count) + '.'
+    );
+
+    this->cascade_count = cascade_count;
+    invalidate_cache();
+}
+
+void ShadowRenderer::set_cascade_resolution(uint32_t resolution)
+{
+    Log::rt_assert(resolution > 0, "Error: The shadow cascade resolution must be strictly positive.");
+
+    cascade_resolution = resolution;
+    invalidate_cache();
+}
+
+void ShadowRenderer::set_local_atlas_resolution(uint32_t resolution)
+{
+    Log::rt_assert(
+        resolution >= min_local_tile_resolution,
+        "Error: The local shadow atlas resolution must be at least " + std::to_string(min_local_tile_resolution) + '.'
+    );
+
+    local_atlas_resolution = resolution;
+    invalidate_cache();
+}
+
+void ShadowRenderer::set_local_range(float near, float far)
+{
+    Log::rt_assert(near > 0.f && near < far, "Error: The local shadow range must be positive & non-empty.");
+
+    local_near = near;
+    local_far = far;
+    invalidate_cache();
+}
+
+void ShadowRenderer::invalidate_cache()
+{
+    cascade_signatures.fill(0);
+    local_signatures.fill(0);
+}
+
+void ShadowRenderer::bind_program(ShaderProgram const& program) const
+{
+    program.use();
+    program.send_uniform("uniCascadeShadowMap", static_cast<int>(cascade_map_texture_unit));
+    program.send_uniform("uniLocalShadowMap", static_cast<int>(local_map_texture_unit));
+    shadow_ubo.bind_uniform_block(program, "uboShadowInfo", uniform_buffer_binding);
+}
+
+void ShadowRenderer::begin_frame()
+{
+    lights.clear();
+    casters.clear();
+}
+
+void ShadowRenderer::add_light(Light const& light, Vector3f const& position, uint32_t light_index)
+{
+    if (light_index >= max_light_count) {
+        return;
+    }
+
+    lights.emplace_back(ShadowLight{
+        .type = light.get_type(),
+        .position = position,
+        .direction = light.get_direction().normalize(),
+        .angle = light.get_angle(),
+        .light_index = light_index
+    });
+}
+
+void ShadowRenderer::add_caster(MeshRenderer const& mesh_renderer, Matrix4 const& transform, AABB const* bounding_box)
+{
+    casters.emplace_back(ShadowCaster{
+        .mesh_renderer = &mesh_renderer,
+        .transform = transform,
+        .bounding_box = (bounding_box ? std::optional<AABB>(*bounding_box) : std::nullopt)
+    });
+}
+
+void ShadowRenderer::execute(Camera const& camera, Vector3f const& camera_position, Vector2ui const& viewport_size)
+{
+    ZoneScopedN("ShadowRenderer::execute");
+
+    // The buffer is bound on every frame, since other uniform buffers may have taken its binding point
+    shadow_ubo.bind_base(uniform_buffer_binding);
+    rendered_map_count = 0;
+
+    if (!enabled) {
+        if (needs_reset) {
+            send_empty_data();
+            needs_reset = false;
+        }
+
+        return;
+    }
+
+    TracyGpuZone("ShadowRenderer::execute")
+
+    update_atlases();
+
+    Matrix4 const depth_remap = compute_depth_remap();
+
+    std::array<Vector4f, max_light_count> light_infos{};
+    light_infos.fill(Vector4f(-1.f, 0.f, 0.f, 0.f));
+
+    int cascade_light_index = -1;
+    Vector4f split_distances;
+    Vector4f texel_sizes;
+
+    shadow_ubo.bind();
+
+    depth_program.use();
+    Renderer::enable(Capability::SCISSOR_TEST);
+    Renderer::enable(Capability::POLYGON_OFFSET_FILL);
+    Renderer::set_polygon_offset(2.f, 4.f);
+
+    // Cascades, only for the first directional light
+
+    auto const cascade_light_iter = std::find_if(lights.cbegin(), lights.cend(), [](ShadowLight const& light) {
+        return light.type == LightType::DIRECTIONAL;
+    });
+
+    if (cascade_light_iter != lights.cend()) {
+        ZoneScopedN("ShadowRenderer::execute::cascades");
+
+        std::vector<ShadowView> const cascade_views =
+            compute_cascade_views(*cascade_light_iter, camera, camera_position, split_distances, texel_sizes);
+
+        Renderer::bind_framebuffer(cascade_framebuffer.get_index());
+
+        for (size_t cascade_index = 0; cascade_index < cascade_views.size(); ++cascade_index) {
+            ShadowView const& cascade_view = cascade_views[cascade_index];
+
+            render_view(cascade_view, cascade_signatures[cascade_index]);
+            shadow_ubo.send_data(
+                depth_remap * cascade_view.view_projection,
+                cascade_matrices_offset + static_cast<uint32_t>(sizeof(Matrix4) * cascade_index)
+            );
+        }
+
+        cascade_light_index = static_cast<int>(cascade_light_iter->light_index);
+    }
+
+    // Local tiles; their resolution is halved until they all fit in the atlas
+
+    uint32_t required_tile_count = 0;
+
+    for (ShadowLight const& light : lights) {
+        if (light.type != LightType::DIRECTIONAL) {
+            required_tile_count += (light.type == LightType::POINT ? 6 : 1);
+        }
+    }
+
+    applied_local_tile_resolution =
+        std::clamp(local_tile_resolution, min_local_tile_resolution, local_atlas_resolution);
+
+    while (applied_local_tile_resolution > min_local_tile_resolution) {
+        uint32_t const tiles_per_row = local_atlas_resolution / applied_local_tile_resolution;
+
+        if (tiles_per_row * tiles_per_row >= std::min(required_tile_count, max_local_tile_count)) {
+            break;
+        }
+
+        applied_local_tile_resolution /= 2;
+    }
+
+    uint32_t const local_tiles_per_row = local_atlas_resolution / applied_local_tile_resolution;
+    uint32_t const local_tile_capacity = std::min(local_tiles_per_row * local_tiles_per_row, max_local_tile_count);
+
+    if (required_tile_count > 0) {
+        ZoneScopedN("ShadowRenderer::execute::local");
+
+        Renderer::bind_framebuffer(local_framebuffer.get_index());
+
+        uint32_t tile_index = 0;
+
+        for (ShadowLight const& light : lights) {
+            if (light.type == LightType::DIRECTIONAL) {
+                continue;
+            }
+
+            bool const is_point = (light.type == LightType::POINT);
+            uint32_t const face_count = (is_point ? 6 : 1);
+
+            // Lights which do not fit anymore do not cast shadows; a following spot light may still fit
+            if (tile_index + face_count > local_tile_capacity) {
+                continue;
+            }
+
+            float const fov =
+                (is_point ? std::numbers::pi_v<float> / 2
+                          : std::clamp(light.angle.value * 2.f, std::numbers::pi_v<float> / 180.f, max_spot_fov));
+            Matrix4 const projection = Matrix4::perspective_matrix(fov, 1.f, local_near, local_far);
+
+            for (uint32_t face_index = 0; face_index < face_count; ++face_index) {
+                uint32_t const face_tile_index = tile_index + face_index;
+                Vector3f const& direction = (is_point ? cube_face_directions[face_index] : light.direction);
+
+                ShadowView const face_view{
+                    .view_projection = projection * Matrix4::look_at(light.position, light.position + direction,
+                                                                     compute_up_vector(direction)),
+                    .tile_position = Vector2ui((face_tile_index % local_tiles_per_row) * applied_local_tile_resolution,
+                                               (face_tile_index / local_tiles_per_row) * applied_local_tile_resolution),
+                    .tile_resolution = applied_local_tile_resolution
+                };
+
+                render_view(face_view, local_signatures[face_tile_index]);
+                shadow_ubo.send_data(
+                    depth_remap * face_view.view_projection,
+                    local_matrices_offset + static_cast<uint32_t>(sizeof(Matrix4)) * face_tile_index
+                );
+            }
+
+            // World-space size of a texel at a unit distance from the light, used to scale the normal offset
+            float const texel_scale = 2.f * std::tan(fov * 0.5f) / static_cast<float>(applied_local_tile_resolution);
+            light_infos[light.light_index] =
+                Vector4f(static_cast<float>(tile_index), texel_scale, (is_point ? 1.f : 0.f), 0.f);
+
+            tile_index += face_count;
+        }
+    }
+
+    Renderer::disable(Capability::POLYGON_OFFSET_FILL);
+    Renderer::disable(Capability::SCISSOR_TEST);
+    Renderer::unbind_framebuffer();
+    Renderer::resize_viewport(Vector2ui(0), viewport_size);
+
+    uint32_t const cascade_tiles_per_row = (cascade_count > 1 ? 2 : 1);
+
+    shadow_ubo.send_data(split_distances, cascade_splits_offset);
+    shadow_ubo.send_data(texel_sizes, cascade_texel_sizes_offset);
+    shadow_ubo.send_data(
+        Vector4f(normal_bias, 1.f / static_cast<float>(cascade_tiles_per_row),
+                 static_cast<float>(applied_local_tile_resolution) / static_cast<float>(local_atlas_resolution), 0.f),
+        parameters_offset
+    );
+    shadow_ubo.send_data(light_infos, light_infos_offset);
+    shadow_ubo.send_data(cascade_light_index, cascade_light_index_offset);
+    shadow_ubo.send_data(cascade_light_index >= 0 ? cascade_count : 0u, cascade_count_offset);
+
+    Renderer::activate_texture(cascade_map_texture_unit);
+    cascade_atlas->bind();
+    Renderer::activate_texture(local_map_texture_unit);
+    local_atlas->bind();
+    Renderer::activate_texture(0);
+}
+
+void ShadowRenderer::update_atlases()
+{
+    // Depth-only framebuffers have neither a draw nor a read buffer
+    auto const attach_atlas = [](Framebuffer& framebuffer, Texture2DPtr const& atlas) {
+        framebuffer.set_depth_buffer(atlas);
+
+        Renderer::bind_framebuffer(framebuffer.get_index());
+        DrawBuffer draw_buffers[] = {DrawBuffer::NONE};
+        Renderer::set_draw_buffers(draw_buffers);
+        Renderer::set_read_buffer(ReadBuffer::NONE);
+        Renderer::unbind_framebuffer();
+    };
+
+    auto const create_atlas = [](Vector2ui const& size) {
+        Texture2DPtr atlas = Texture2D::create(size, TextureColorspace::DEPTH);
+        atlas->set_filter(TextureFilter::NEAREST);
+        atlas->set_wrapping(TextureWrapping::CLAMP);
+        return atlas;
+    };
+
+    Vector2ui const cascade_atlas_size(cascade_resolution * (cascade_count > 1 ? 2 : 1));
+
+    if (cascade_atlas == nullptr || cascade_atlas->get_size() != cascade_atlas_size) {
+        cascade_atlas = create_atlas(cascade_atlas_size);
+        attach_atlas(cascade_framebuffer, cascade_atlas);
+        cascade_signatures.fill(0);
+    }
+
+    Vector2ui const local_atlas_size(local_atlas_resolution);
+
+    if (local_atlas == nullptr || local_atlas->get_size() != local_atlas_size) {
+        local_atlas = create_atlas(local_atlas_size);
+        attach_atlas(local_framebuffer, local_atlas);
+        local_signatures.fill(0);
+    }
+}
+
+std::vector<ShadowRenderer::ShadowView> ShadowRenderer::compute_cascade_views(
+    ShadowLight const& light, Camera const& camera, Vector3f const& camera_position, Vector4f& split_distances,
+    Vector4f& texel_sizes
+) const
+{
+    ZoneScopedN("ShadowRenderer::compute_cascade_views");
+
+    // Corners of the camera's frustum on its near & far planes
+
+    std::array<Vector3f, 4> near_corners;
+    std::array<Vector3f, 4> far_corners;
+    constexpr std::array<Vector2f, 4> ndc_corners = {
+        Vector2f(-1.f, -1.f), Vector2f(1.f, -1.f), Vector2f(-1.f, 1.f), Vector2f(1.f, 1.f)
+    };
+
+    for (size_t corner_index = 0; corner_index < ndc_corners.size(); ++corner_index) {
+        near_corners[corner_index] = camera.unproject(Vector3f(ndc_corners[corner_index], -1.f));
+        far_corners[corner_index] = camera.unproject(Vector3f(ndc_corners[corner_index], 1.f));
+    }
+
+    Vector3f const camera_forward = -Vector3f(camera.get_inverse_view()[2]).normalize();
+    float const near_depth =
+        std::max(((near_corners[0] + near_corners[3]) * 0.5f - camera_position).dot(camera_forward), 0.001f);
+    float const far_depth = ((far_corners[0] + far_corners[3]) * 0.5f - camera_position).dot(camera_forward);
+    float const shadow_depth = std::max(std::min(far_depth, shadow_distance), near_depth + 0.001f);
+
+    // Frustum corners at the given depth along the camera's forward direction
+    auto const compute_slice_corners = [&](float depth, auto& corners) {
+        float const ratio = (depth - near_depth) / (far_depth - near_depth);
+
+        for (size_t corner_index = 0; corner_index < near_corners.size(); ++corner_index) {
+            corners[corner_index] = near_corners[corner_index].lerp(far_corners[corner_index], ratio);
+        }
+    };
+
+    // Rotation-only view matrix of the light, in which the cascades are snapped
+    Vector3f const light_up = compute_up_vector(light.direction);
+    Matrix4 const light_rotation = Matrix4::look_at(Vector3f(0.f), light.direction, light_up);
+    Matrix4 const inverse_light_rotation = light_rotation.transpose();
+
+    std::vector<ShadowView> cascade_views;
+    cascade_views.reserve(cascade_count);
+
+    float slice_start = near_depth;
+    uint32_t const tiles_per_row = (cascade_count > 1 ? 2 : 1);
+
+    for (uint32_t cascade_index = 0; cascade_index < cascade_count; ++cascade_index) {
+        // Practical split scheme, blending uniform & logarithmic splits
+        float const ratio = static_cast<float>(cascade_index + 1) / static_cast<float>(cascade_count);
+        float const uniform_split = near_depth + (shadow_depth - near_depth) * ratio;
+        float const log_split = near_depth * std::pow(shadow_depth / near_depth, ratio);
+        float const slice_end = std::lerp(uniform_split, log_split, cascade_split_weight);
+
+        std::array<Vector3f, 8> slice_corners;
+        std::array<Vector3f, 4> start_corners;
+        std::array<Vector3f, 4> end_corners;
+        compute_slice_corners(slice_start, start_corners);
+        compute_slice_corners(slice_end, end_corners);
+        std::copy(start_corners.cbegin(), start_corners.cend(), slice_corners.begin());
+        std::copy(end_corners.cbegin(), end_corners.cend(), slice_corners.begin() + 4);
+
+        // A bounding sphere keeps the cascade's extent constant as the camera rotates, avoiding shimmering edges
+        Vector3f center(0.f);
+
+        for (Vector3f const& corner : slice_corners) {
+            center += corner;
+        }
+
+        center /= static_cast<float>(slice_corners.size());
+
+        float radius = 0.f;
+
+        for (Vector3f const& corner : slice_corners) {
+            radius = std::max(radius, (corner - center).length());
+        }
+
+        radius = std::ceil(radius * 16.f) / 16.f;
+
+        // Static cascades are enlarged & only moved by a quarter of their radius, so that they stay in place while the
+        //   camera moves within that margin; the others are snapped to their texels
+        bool const is_static = (cascade_index >= static_cascade_index);
+        float const snap_step = (is_static ? radius * 0.25f : 2.f * radius / static_cast<float>(cascade_resolution));
+        float const half_extent = (is_static ? radius + snap_step : radius);
+
+        Vector3f light_space_center(light_rotation.transform(Vector4f(center, 1.f)));
+        light_space_center.x = std::floor(light_space_center.x / snap_step) * snap_step;
+        light_space_center.y = std::floor(light_space_center.y / snap_step) * snap_step;
+        light_space_center.z = std::floor(light_space_center.z / snap_step) * snap_step;
+        Vector3f const snapped_center(inverse_light_rotation.transform(Vector4f(light_space_center, 1.f)));
+
+        // The projection is extended toward the light, to include casters located outside of the camera's frustum
+        float const caster_margin = shadow_distance;
+        Vector3f const eye = snapped_center - light.direction * (half_extent + caster_margin);
+        Matrix4 const view = Matrix4::look_at(eye, snapped_center, light_up);
+        Matrix4 const projection = compute_orthographic_projection(half_extent, 0.f, 2.f * half_extent + caster_margin);
+
+        cascade_views.emplace_back(ShadowView{
+            .view_projection = projection * view,
+            .tile_position = Vector2ui((cascade_index % tiles_per_row) * cascade_resolution,
+                                       (cascade_index / tiles_per_row) * cascade_resolution),
+            .tile_resolution = cascade_resolution
+        });
+
+        split_distances[cascade_index] = slice_end;
+        texel_sizes[cascade_index] = 2.f * half_extent / static_cast<float>(cascade_resolution);
+
+        slice_start = slice_end;
+    }
+
+    return cascade_views;
+}
+
+void ShadowRenderer::render_view(ShadowView const& shadow_view, uint64_t& signature)
+{
+    Frustum frustum;
+    frustum.update(Matrix4(), shadow_view.view_projection);
+
+    uint64_t new_signature = compute_matrix_hash(shadow_view.view_projection);
+    new_signature = Hash::compute_fnv1a(shadow_view.tile_position.x, new_signature);
+    new_signature = Hash::compute_fnv1a(shadow_view.tile_position.y, new_signature);
+    new_signature = Hash::compute_fnv1a(shadow_view.tile_resolution, new_signature);
+
+    visible_casters.clear();
+
+    for (ShadowCaster const& caster : casters) {
+        if (caster.bounding_box && !frustum.aabb_in(*caster.bounding_box)) {
+            continue;
+        }
+
+        visible_casters.emplace_back(&caster);
+        new_signature = Hash::compute_fnv1a(caster.mesh_renderer, new_signature);
+        new_signature = compute_matrix_hash(caster.transform, new_signature);
+    }
+
+    if (new_signature == signature) {
+        return;
+    }
+
+    signature = new_signature;
+    ++rendered_map_count;
+
+    Vector2ui const tile_size(shadow_view.tile_resolution);
+    Renderer::resize_viewport(shadow_view.tile_position, tile_size);
+    Renderer::set_scissor(shadow_view.tile_position, tile_size);
+    Renderer::clear(MaskType::DEPTH);
+
+    depth_program.send_uniform(view_projection_location, shadow_view.view_projection);
+
+    for (ShadowCaster const* caster : visible_casters) {
+        depth_program.send_uniform(model_matrix_location, caster->transform);
+
+        for (SubmeshRenderer const& submesh_renderer : caster->mesh_renderer->get_submesh_renderers()) {
+            submesh_renderer.draw();
+        }
+    }
+}
+
+void ShadowRenderer::send_empty_data() const
+{
+    std::array<Vector4f, max_light_count> light_infos{};
+    light_infos.fill(Vector4f(-1.f, 0.f, 0.f, 0.f));
+
+    shadow_ubo.bind();
+    shadow_ubo.send_data(light_infos, light_infos_offset);
+    shadow_ubo.send_data(-1, cascade_light_index_offset);
+    shadow_ubo.send_data(0u, cascade_count_offset);
+}
+}
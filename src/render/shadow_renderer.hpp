@@ -0,0 +1,224 @@
+#pragma once
+
+#include <render/light.hpp>
+#include <render/platform/framebuffer.hpp>
+#include <render/platform/uniform_buffer.hpp>
+#include <render/shader/shader_program.hpp>
+#include <utils/shape.hpp>
+
+namespace xen {
+class Camera;
+class MeshRenderer;
+
+/// Shadow renderer, drawing the depth of the shadow casters from the lights' points of view before the geometry pass.
+/// - The first directional light casting shadows gets cascaded shadow maps: the camera's frustum, up to the shadow
+///   distance, is split into cascades, each covered by an orthographic projection & packed in a cascade atlas;
+/// - Other lights casting shadows get tiles of a local atlas: one per spot light, six per point light (one per cube
+///   face). Tiles are shrunk to fit the atlas when there are too many of them;
+/// - The casters are gathered once per frame & culled against each cascade & tile;
+/// - A cascade or tile is only rendered again when its projection or one of its casters has changed. Cascades from
+///   the static one onward are moreover only refitted when the camera moves by an eighth of their extent, so that
+///   far cascades are not rendered again while only the camera moves.
+/// The materials sample the atlases with percentage-closer filtering, through the shadow uniform buffer & the
+/// reserved texture units.
+class ShadowRenderer {
+public:
+    static constexpr uint32_t max_cascade_count = 4;
+    static constexpr uint32_t max_local_tile_count = 48;
+    static constexpr uint32_t max_light_count = 100;
+    static constexpr uint32_t uniform_buffer_binding = 4;
+    static constexpr uint32_t cascade_map_texture_unit = 14;
+    static constexpr uint32_t local_map_texture_unit = 15;
+
+    ShadowRenderer();
+    ShadowRenderer(ShadowRenderer const&) = delete;
+    ShadowRenderer(ShadowRenderer&&) noexcept = default;
+
+    ShadowRenderer& operator=(ShadowRenderer const&) = delete;
+    ShadowRenderer& operator=(ShadowRenderer&&) noexcept = default;
+
+    [[nodiscard]] bool is_enabled() const { return enabled; }
+
+    [[nodiscard]] uint32_t get_cascade_count() const { return cascade_count; }
+
+    [[nodiscard]] uint32_t get_cascade_resolution() const { return cascade_resolution; }
+
+    [[nodiscard]] uint32_t get_static_cascade_index() const { return static_cascade_index; }
+
+    [[nodiscard]] float get_shadow_distance() const { return shadow_distance; }
+
+    [[nodiscard]] uint32_t get_local_atlas_resolution() const { return local_atlas_resolution; }
+
+    [[nodiscard]] uint32_t get_local_tile_resolution() const { return local_tile_resolution; }
+
+    /// Gets the resolution the local tiles have been rendered with during the last frame, which may be lower than the
+    /// requested one if they did not all fit in the atlas.
+    /// \return Resolution of the local tiles, in pixels.
+    [[nodiscard]] uint32_t get_applied_local_tile_resolution() const { return applied_local_tile_resolution; }
+
+    /// Gets the number of cascades & local tiles rendered during the last frame, the others having been kept from the
+    /// previous frames.
+    /// \return Number of rendered shadow maps.
+    [[nodiscard]] size_t get_rendered_map_count() const { return rendered_map_count; }
+
+    [[nodiscard]] Texture2DPtr const& get_cascade_atlas() const { return cascade_atlas; }
+
+    [[nodiscard]] Texture2DPtr const& get_local_atlas() const { return local_atlas; }
+
+    /// Enables or disables the shadows. While disabled, no light casts shadows.
+    /// \param enabled True to enable the shadows, false otherwise.
+    void enable(bool enabled = true);
+
+    void disable() { enable(false); }
+
+    /// Sets the number of cascades covering the camera's frustum.
+    /// \param cascade_count Number of cascades; must be between 1 & max_cascade_count.
+    void set_cascade_count(uint32_t cascade_count);
+
+    /// Sets the resolution of each cascade's shadow map.
+    /// \param resolution Width & height of a cascade, in pixels.
+    void set_cascade_resolution(uint32_t resolution);
+
+    /// Sets the index of the first cascade considered static, only refitted in coarse steps as the camera moves.
+    /// \param cascade_index Index of the first static cascade; if greater than or equal to the cascade count, all
+    ///   cascades follow the camera closely.
+    void set_static_cascade_index(uint32_t cascade_index) { static_cascade_index = cascade_index; }
+
+    /// Sets the distance from the camera up to which directional shadows are rendered.
+    /// \param distance Distance covered by the cascades.
+    void set_shadow_distance(float distance) { shadow_distance = distance; }
+
+    /// Sets how the cascades are split along the camera's frustum.
+    /// \param weight Weight between a uniform split (0) & a logarithmic one (1), the latter giving more resolution
+    ///   close to the camera.
+    void set_cascade_split_weight(float weight) { cascade_split_weight = std::clamp(weight, 0.f, 1.f); }
+
+    /// Sets the resolution of the atlas holding the shadow maps of the point & spot lights.
+    /// \param resolution Width & height of the atlas, in pixels.
+    void set_local_atlas_resolution(uint32_t resolution);
+
+    /// Sets the resolution requested for each tile of the local atlas.
+    /// \param resolution Width & height of a tile, in pixels; halved as many times as needed for all tiles to fit.
+    void set_local_tile_resolution(uint32_t resolution) { local_tile_resolution = resolution; }
+
+    /// Sets the near & far planes of the point & spot lights' projections.
+    /// \param near Distance to the light below which casters are ignored.
+    /// \param far Distance to the light beyond which receivers are not shadowed.
+    void set_local_range(float near, float far);
+
+    /// Sets the offset applied to the receivers along their normal before being compared with the shadow maps.
+    /// \param bias Offset, in texels of the shadow map sampled.
+    void set_normal_bias(float bias) { normal_bias = bias; }
+
+    /// Forces every cascade & tile to be rendered again on the next frame.
+    void invalidate_cache();
+
+    /// Sends the shadow maps' texture units to a program & binds it to the shadow uniform buffer.
+    /// \param program Program to be bound; must be one sampling the shadows, like the materials' ones.
+    void bind_program(ShaderProgram const& program) const;
+
+    /// Starts a new frame, discarding the lights & casters of the previous one.
+    void begin_frame();
+
+    /// Adds a light casting shadows for the current frame.
+    /// \param light Light to be added.
+    /// \param position World-space position of the light; ignored for a directional light.
+    /// \param light_index Index of the light in the lights uniform buffer.
+    void add_light(Light const& light, Vector3f const& position, uint32_t light_index);
+
+    /// Adds a shadow caster for the current frame.
+    /// \param mesh_renderer Mesh renderer of the caster; must remain valid until the shadows are rendered.
+    /// \param transform Transformation matrix to bring the mesh in world space.
+    /// \param bounding_box World-space bounding box of the caster; if null, it is never culled.
+    void add_caster(MeshRenderer const& mesh_renderer, Matrix4 const& transform, AABB const* bounding_box);
+
+    /// Renders the shadow maps which need to be, updates the shadow uniform buffer & binds the atlases to their
+    /// reserved texture units.
+    /// \param camera Camera from which the scene is rendered.
+    /// \param camera_position World-space position of the camera.
+    /// \param viewport_size Size of the viewport, restored once the shadow maps are rendered.
+    void execute(Camera const& camera, Vector3f const& camera_position, Vector2ui const& viewport_size);
+
+private:
+    struct ShadowLight {
+        LightType type{};
+        Vector3f position{};
+        Vector3f direction{};
+        Radiansf angle = Radiansf(0.f);
+        uint32_t light_index{};
+    };
+
+    struct ShadowCaster {
+        MeshRenderer const* mesh_renderer{};
+        Matrix4 transform{};
+        std::optional<AABB> bounding_box{};
+    };
+
+    /// Projection of a cascade or local tile, rendered into its atlas.
+    struct ShadowView {
+        Matrix4 view_projection{};
+        Vector2ui tile_position{};
+        uint32_t tile_resolution{};
+    };
+
+    bool enabled = false;
+    bool needs_reset = false;
+
+    uint32_t cascade_count = 3;
+    uint32_t cascade_resolution = shadowmaresolution_x_default;
+    uint32_t static_cascade_index = 2;
+    float shadow_distance = shadowmap_far_plane_default;
+    float cascade_split_weight = 0.75f;
+
+    uint32_t local_atlas_resolution = 4096;
+    uint32_t local_tile_resolution = 512;
+    uint32_t applied_local_tile_resolution = 0;
+    float local_near = shadowmap_near_plane_default;
+    float local_far = shadowmap_far_plane_default;
+
+    float normal_bias = 1.5f;
+
+    std::vector<ShadowLight> lights{};
+    std::vector<ShadowCaster> casters{};
+    std::vector<ShadowCaster const*> visible_casters{};
+
+    RenderShaderProgram depth_program{};
+    int view_projection_location = -1;
+    int model_matrix_location = -1;
+    UniformBuffer shadow_ubo;
+    Texture2DPtr cascade_atlas{};
+    Texture2DPtr local_atlas{};
+    Framebuffer cascade_framebuffer{};
+    Framebuffer local_framebuffer{};
+
+    /// Signatures of the projection & casters each cascade & local tile has last been rendered with.
+    std::array<uint64_t, max_cascade_count> cascade_signatures{};
+    std::array<uint64_t, max_local_tile_count> local_signatures{};
+    size_t rendered_map_count = 0;
+
+private:
+    /// Creates the atlases & their framebuffers if they do not exist or do not have the required size.
+    void update_atlases();
+
+    /// Computes the projections of the cascades covering the camera's frustum.
+    /// \param light Directional light casting the shadows.
+    /// \param camera Camera from which the scene is rendered.
+    /// \param camera_position World-space position of the camera.
+    /// \param split_distances Distances from the camera at which each cascade ends.
+    /// \param texel_sizes World-space size of a texel in each cascade.
+    /// \return Projection of each cascade.
+    std::vector<ShadowView> compute_cascade_views(
+        ShadowLight const& light, Camera const& camera, Vector3f const& camera_position, Vector4f& split_distances,
+        Vector4f& texel_sizes
+    ) const;
+
+    /// Renders the casters visible from a view into its tile of the currently bound atlas, unless its signature has not
+    /// changed.
+    /// \param shadow_view View to be rendered.
+    /// \param signature Signature the view has last been rendered with, updated if rendered again.
+    void render_view(ShadowView const& shadow_view, uint64_t& signature);
+
+    /// Sends the data telling the materials that no light casts shadows.
+    void send_empty_data() const;
+};
+}
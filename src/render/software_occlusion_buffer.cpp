@@ -0,0 +1,202 @@
+#include "software_occlusion_buffer.hpp"
+
+#include <data/mesh.hpp>
+
+#include <tracy/Tracy.hpp>
+
+namespace xen {
+namespace {
+constexpr float min_clip_w = 1e-5f;
+
+struct ScreenVertex {
+    float x;
+    float y;
+    float depth;
+};
+
+/// Converts a clip-space position to a screen-space one.
+/// \return Position in screen space, or an empty optional if the position is behind the near plane.
+std::optional<ScreenVertex> compute_screen_vertex(Vector4f const& clip_pos, Vector2ui const& size)
+{
+    if (clip_pos.w <= min_clip_w || clip_pos.z < -clip_pos.w) {
+        return std::nullopt;
+    }
+
+    float const inv_w = 1.f / clip_pos.w;
+
+    return ScreenVertex{
+        (clip_pos.x * inv_w * 0.5f + 0.5f) * static_cast<float>(size.x),
+        (clip_pos.y * inv_w * 0.5f + 0.5f) * static_cast<float>(size.y), clip_pos.z * inv_w * 0.5f + 0.5f
+    };
+}
+
+constexpr float compute_edge(ScreenVertex const& begin, ScreenVertex const& end, float x, float y)
+{
+    return (end.x - begin.x) * (y - begin.y) - (end.y - begin.y) * (x - begin.x);
+}
+
+void rasterize(
+    ScreenVertex const& first_vert, ScreenVertex const& second_vert, ScreenVertex const& third_vert,
+    Vector2ui const& size, std::vector<float>& depths
+)
+{
+    float const area = compute_edge(first_vert, second_vert, third_vert.x, third_vert.y);
+
+    if (std::abs(area) < std::numeric_limits<float>::epsilon()) {
+        return;
+    }
+
+    float const min_x = std::min({first_vert.x, second_vert.x, third_vert.x});
+    float const max_x = std::max({first_vert.x, second_vert.x, third_vert.x});
+    float const min_y = std::min({first_vert.y, second_vert.y, third_vert.y});
+    float const max_y = std::max({first_vert.y, second_vert.y, third_vert.y});
+
+    if (max_x < 0.f || max_y < 0.f || min_x >= static_cast<float>(size.x) || min_y >= static_cast<float>(size.y)) {
+        return;
+    }
+
+    auto const begin_x = static_cast<uint32_t>(std::max(min_x, 0.f));
+    auto const begin_y = static_cast<uint32_t>(std::max(min_y, 0.f));
+    uint32_t const end_x = std::min(static_cast<uint32_t>(max_x) + 1, size.x);
+    uint32_t const end_y = std::min(static_cast<uint32_t>(max_y) + 1, size.y);
+
+    // Triangles are rasterized regardless of their winding; the weights' signs are normalized by the area's
+    float const inv_area = 1.f / area;
+
+    for (uint32_t y = begin_y; y < end_y; ++y) {
+        float const pixel_y = static_cast<float>(y) + 0.5f;
+
+        for (uint32_t x = begin_x; x < end_x; ++x) {
+            float const pixel_x = static_cast<float>(x) + 0.5f;
+
+            float const first_weight = compute_edge(second_vert, third_vert, pixel_x, pixel_y) * inv_area;
+            float const second_weight = compute_edge(third_vert, first_vert, pixel_x, pixel_y) * inv_area;
+            float const third_weight = compute_edge(first_vert, second_vert, pixel_x, pixel_y) * inv_area;
+
+            if (first_weight < 0.f || second_weight < 0.f || third_weight < 0.f) {
+                continue;
+            }
+
+            float const depth = first_weight * first_vert.depth + second_weight * second_vert.depth +
+                                third_weight * third_vert.depth;
+            float& stored_depth = depths[y * size.x + x];
+            stored_depth = std::min(stored_depth, depth);
+        }
+    }
+}
+}
+
+void SoftwareOcclusionBuffer::resize(Vector2ui const& size)
+{
+    this->size = size;
+    depths.resize(static_cast<size_t>(size.x) * size.y);
+
+    clear();
+}
+
+void SoftwareOcclusionBuffer::clear()
+{
+    std::fill(depths.begin(), depths.end(), 1.f);
+}
+
+void SoftwareOcclusionBuffer::rasterize_triangle(
+    Vector3f const& first_pos, Vector3f const& second_pos, Vector3f const& third_pos
+)
+{
+    std::optional<ScreenVertex> const first_vert =
+        compute_screen_vertex(view_projection.transform(Vector4f(first_pos, 1.f)), size);
+    std::optional<ScreenVertex> const second_vert =
+        compute_screen_vertex(view_projection.transform(Vector4f(second_pos, 1.f)), size);
+    std::optional<ScreenVertex> const third_vert =
+        compute_screen_vertex(view_projection.transform(Vector4f(third_pos, 1.f)), size);
+
+    if (!first_vert || !second_vert || !third_vert) {
+        return;
+    }
+
+    rasterize(*first_vert, *second_vert, *third_vert, size, depths);
+}
+
+void SoftwareOcclusionBuffer::rasterize_mesh(Mesh const& mesh, Matrix4 const& transform)
+{
+    ZoneScopedN("SoftwareOcclusionBuffer::rasterize_mesh");
+
+    Matrix4 const mvp = view_projection * transform;
+    std::vector<std::optional<ScreenVertex>> screen_vertices;
+
+    for (Submesh const& submesh : mesh.get_submeshes()) {
+        std::vector<Vertex> const& vertices = submesh.get_vertices();
+        std::vector<uint32_t> const& indices = submesh.get_triangle_indices();
+
+        // Vertices are projected only once, as they are usually shared by several triangles
+        screen_vertices.resize(vertices.size());
+
+        for (size_t vertex_index = 0; vertex_index < vertices.size(); ++vertex_index) {
+            screen_vertices[vertex_index] =
+                compute_screen_vertex(mvp.transform(Vector4f(vertices[vertex_index].position, 1.f)), size);
+        }
+
+        for (size_t index = 0; index + 2 < indices.size(); index += 3) {
+            std::optional<ScreenVertex> const& first_vert = screen_vertices[indices[index]];
+            std::optional<ScreenVertex> const& second_vert = screen_vertices[indices[index + 1]];
+            std::optional<ScreenVertex> const& third_vert = screen_vertices[indices[index + 2]];
+
+            if (!first_vert || !second_vert || !third_vert) {
+                continue;
+            }
+
+            rasterize(*first_vert, *second_vert, *third_vert, size, depths);
+        }
+    }
+}
+
+bool SoftwareOcclusionBuffer::is_visible(AABB const& box) const
+{
+    Vector3f const& min_pos = box.get_min_position();
+    Vector3f const& max_pos = box.get_max_position();
+
+    float min_x = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float min_y = std::numeric_limits<float>::max();
+    float max_y = std::numeric_limits<float>::lowest();
+    float min_depth = std::numeric_limits<float>::max();
+
+    for (uint8_t corner_index = 0; corner_index < 8; ++corner_index) {
+        Vector3f const corner(
+            (corner_index & 1u) ? max_pos.x : min_pos.x, (corner_index & 2u) ? max_pos.y : min_pos.y,
+            (corner_index & 4u) ? max_pos.z : min_pos.z
+        );
+        std::optional<ScreenVertex> const screen_corner =
+            compute_screen_vertex(view_projection.transform(Vector4f(corner, 1.f)), size);
+
+        if (!screen_corner) {
+            return true;
+        }
+
+        min_x = std::min(min_x, screen_corner->x);
+        max_x = std::max(max_x, screen_corner->x);
+        min_y = std::min(min_y, screen_corner->y);
+        max_y = std::max(max_y, screen_corner->y);
+        min_depth = std::min(min_depth, screen_corner->depth);
+    }
+
+    if (max_x < 0.f || max_y < 0.f || min_x >= static_cast<float>(size.x) || min_y >= static_cast<float>(size.y)) {
+        return true;
+    }
+
+    auto const begin_x = static_cast<uint32_t>(std::max(min_x, 0.f));
+    auto const begin_y = static_cast<uint32_t>(std::max(min_y, 0.f));
+    uint32_t const end_x = std::min(static_cast<uint32_t>(max_x) + 1, size.x);
+    uint32_t const end_y = std::min(static_cast<uint32_t>(max_y) + 1, size.y);
+
+    for (uint32_t y = begin_y; y < end_y; ++y) {
+        for (uint32_t x = begin_x; x < end_x; ++x) {
+            if (min_depth <= depths[y * size.x + x]) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <utils/shape.hpp>
+
+namespace xen {
+class Mesh;
+
+/// Low-resolution depth buffer rasterized on the CPU, used to test bounding boxes against occluders without requiring
+/// any graphics context. Depths are stored in the [0; 1] range, 1 being the far plane.
+class SoftwareOcclusionBuffer {
+public:
+    explicit SoftwareOcclusionBuffer(Vector2ui const& size = Vector2ui(256, 128)) { resize(size); }
+
+    [[nodiscard]] Vector2ui const& get_size() const { return size; }
+
+    [[nodiscard]] uint32_t get_width() const { return size.x; }
+
+    [[nodiscard]] uint32_t get_height() const { return size.y; }
+
+    [[nodiscard]] Matrix4 const& get_view_projection() const { return view_projection; }
+
+    [[nodiscard]] std::vector<float> const& get_depths() const { return depths; }
+
+    [[nodiscard]] float get_depth(uint32_t x, uint32_t y) const { return depths[y * size.x + x]; }
+
+    /// Resizes the buffer, clearing its content.
+    /// \param size New buffer size.
+    void resize(Vector2ui const& size);
+
+    /// Sets the matrix with which to project the world-space positions given to the buffer. Does not clear it.
+    /// \param view_projection View-projection matrix.
+    void set_view_projection(Matrix4 const& view_projection) { this->view_projection = view_projection; }
+
+    /// Resets all the depths to the far plane.
+    void clear();
+
+    /// Rasterizes a world-space occluder triangle, keeping the nearest depths.
+    /// \note Triangles crossing the near plane are ignored; this can only make the buffer less occluding.
+    /// \param first_pos First vertex position.
+    /// \param second_pos Second vertex position.
+    /// \param third_pos Third vertex position.
+    void rasterize_triangle(Vector3f const& first_pos, Vector3f const& second_pos, Vector3f const& third_pos);
+
+    /// Rasterizes all the triangles of a mesh as occluders.
+    /// \param mesh Mesh to be rasterized.
+    /// \param transform Transformation matrix to bring the mesh's vertices in world space.
+    void rasterize_mesh(Mesh const& mesh, Matrix4 const& transform);
+
+    /// Checks if a world-space bounding box is at least partially visible, that is not entirely hidden behind the
+    /// occluders rasterized so far. Boxes crossing the near plane or lying outside the buffer are considered visible.
+    /// \param box Bounding box to be tested.
+    /// \return True if the box may be visible, false if it is guaranteed to be occluded.
+    [[nodiscard]] bool is_visible(AABB const& box) const;
+
+private:
+    Vector2ui size{};
+    Matrix4 view_projection = Matrix4::Identity;
+    std::vector<float> depths{};
+};
+}
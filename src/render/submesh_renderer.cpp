@@ -1,5 +1,6 @@
 #include "submesh_renderer.hpp"
 
+#include <data/mesh_optimizer.hpp>
 #include <render/renderer.hpp>
 
 #include <tracy/Tracy.hpp>
@@ -11,6 +12,12 @@ void SubmeshRenderer::set_render_mode(RenderMode render_mode, Submesh const& sub
 {
     ZoneScopedN("SubmeshRenderer::set_render_mode");
 
+    apply_render_mode(render_mode);
+    load_indices(submesh.get_line_indices(), submesh.get_triangle_indices());
+}
+
+void SubmeshRenderer::apply_render_mode(RenderMode render_mode)
+{
     this->render_mode = render_mode;
 
     switch (render_mode) {
@@ -41,8 +48,6 @@ void SubmeshRenderer::set_render_mode(RenderMode render_mode, Submesh const& sub
         break;
 #endif
     }
-
-    load_indices(submesh);
 }
 
 SubmeshRenderer SubmeshRenderer::clone() const
@@ -50,18 +55,39 @@ SubmeshRenderer SubmeshRenderer::clone() const
     SubmeshRenderer submesh_renderer;
 
     submesh_renderer.render_mode = render_mode;
+    submesh_renderer.vertex_format = vertex_format;
     submesh_renderer.render_func = render_func;
     submesh_renderer.material_index = material_index;
 
     return submesh_renderer;
 }
 
-void SubmeshRenderer::load(Submesh const& submesh, RenderMode render_mode)
+void SubmeshRenderer::load(Submesh const& submesh, RenderMode render_mode, VertexFormat vertex_format)
+{
+    load(
+        submesh.get_vertices(), submesh.get_line_indices(), submesh.get_triangle_indices(), render_mode,
+        vertex_format
+    );
+}
+
+void SubmeshRenderer::load(
+    std::span<Vertex const> vertices, std::span<uint32_t const> line_indices,
+    std::span<uint32_t const> triangle_indices, RenderMode render_mode, VertexFormat vertex_format
+)
 {
     ZoneScopedN("SubmeshRenderer::load");
 
-    load_vertices(submesh);
-    set_render_mode(render_mode, submesh);
+    this->vertex_format = vertex_format;
+
+    if (vertex_format == VertexFormat::QUANTIZED) {
+        load_quantized_vertices(vertices);
+    }
+    else {
+        load_vertices(vertices);
+    }
+
+    apply_render_mode(render_mode);
+    load_indices(line_indices, triangle_indices);
 }
 
 void SubmeshRenderer::draw() const
@@ -75,7 +101,7 @@ void SubmeshRenderer::draw() const
     render_func(vbo, ibo);
 }
 
-void SubmeshRenderer::load_vertices(Submesh const& submesh)
+void SubmeshRenderer::load_vertices(std::span<Vertex const> vertices)
 {
     ZoneScopedN("SubmeshRenderer::load_vertices");
 
@@ -84,16 +110,14 @@ void SubmeshRenderer::load_vertices(Submesh const& submesh)
     vao.bind();
     vbo.bind();
 
-    std::vector<Vertex> const& vertices = submesh.get_vertices();
-
     Renderer::send_buffer_data(
-        BufferType::ARRAY_BUFFER, static_cast<std::ptrdiff_t>(sizeof(vertices.front()) * vertices.size()),
+        BufferType::ARRAY_BUFFER, static_cast<std::ptrdiff_t>(vertices.size_bytes()),
         vertices.data(), BufferDataUsage::STATIC_DRAW
     );
 
     vbo.vertex_count = static_cast<uint32_t>(vertices.size());
 
-    constexpr uint8_t stride = sizeof(vertices.front());
+    constexpr uint8_t stride = sizeof(Vertex);
 
     // Position
     Renderer::set_vertex_attrib(
@@ -103,7 +127,7 @@ void SubmeshRenderer::load_vertices(Submesh const& submesh)
     Renderer::enable_vertex_attrib_array(0);
 
     // Texcoords
-    constexpr size_t texcoords_offset = sizeof(vertices.front().position);
+    constexpr size_t texcoords_offset = offsetof(Vertex, texcoords);
     Renderer::set_vertex_attrib(
         1, AttribDataType::FLOAT, 2, // vec2
         stride, texcoords_offset
@@ -111,7 +135,7 @@ void SubmeshRenderer::load_vertices(Submesh const& submesh)
     Renderer::enable_vertex_attrib_array(1);
 
     // Normal
-    constexpr size_t normal_offset = texcoords_offset + sizeof(vertices.front().texcoords);
+    constexpr size_t normal_offset = offsetof(Vertex, normal);
     Renderer::set_vertex_attrib(
         2, AttribDataType::FLOAT, 3, // vec3
         stride, normal_offset
@@ -119,7 +143,7 @@ void SubmeshRenderer::load_vertices(Submesh const& submesh)
     Renderer::enable_vertex_attrib_array(2);
 
     // Tangent
-    constexpr size_t tangent_offset = normal_offset + sizeof(vertices.front().normal);
+    constexpr size_t tangent_offset = offsetof(Vertex, tangent);
     Renderer::set_vertex_attrib(
         3, AttribDataType::FLOAT, 3, // vec3
         stride, tangent_offset
@@ -132,7 +156,63 @@ void SubmeshRenderer::load_vertices(Submesh const& submesh)
     Log::vdebug("[SubmeshRenderer] Loaded submesh vertices ({} vertices loaded)", vertices.size());
 }
 
-void SubmeshRenderer::load_indices(Submesh const& submesh)
+void SubmeshRenderer::load_quantized_vertices(std::span<Vertex const> vertices)
+{
+    ZoneScopedN("SubmeshRenderer::load_quantized_vertices");
+
+    Log::debug("[SubmeshRenderer] Loading quantized submesh vertices...");
+
+    vao.bind();
+    vbo.bind();
+
+    std::vector<QuantizedVertex> const quantized_vertices = MeshOptimizer::quantize_vertices(vertices);
+
+    Renderer::send_buffer_data(
+        BufferType::ARRAY_BUFFER, static_cast<std::ptrdiff_t>(sizeof(QuantizedVertex) * quantized_vertices.size()),
+        quantized_vertices.data(), BufferDataUsage::STATIC_DRAW
+    );
+
+    vbo.vertex_count = static_cast<uint32_t>(quantized_vertices.size());
+
+    constexpr uint8_t stride = sizeof(QuantizedVertex);
+
+    // Position
+    Renderer::set_vertex_attrib(
+        0, AttribDataType::FLOAT, 3, // vec3
+        stride, offsetof(QuantizedVertex, position)
+    );
+    Renderer::enable_vertex_attrib_array(0);
+
+    // Texcoords
+    Renderer::set_vertex_attrib(
+        1, AttribDataType::HALF_FLOAT, 2, // vec2
+        stride, offsetof(QuantizedVertex, texcoords)
+    );
+    Renderer::enable_vertex_attrib_array(1);
+
+    // Normal, octahedral-encoded; the shader receives it as a vec3 whose Z component is 0
+    Renderer::set_vertex_attrib(
+        2, AttribDataType::SHORT, 2, // vec2
+        stride, offsetof(QuantizedVertex, normal), true
+    );
+    Renderer::enable_vertex_attrib_array(2);
+
+    // Tangent, octahedral-encoded
+    Renderer::set_vertex_attrib(
+        3, AttribDataType::SHORT, 2, // vec2
+        stride, offsetof(QuantizedVertex, tangent), true
+    );
+    Renderer::enable_vertex_attrib_array(3);
+
+    vbo.unbind();
+    vao.unbind();
+
+    Log::vdebug(
+        "[SubmeshRenderer] Loaded quantized submesh vertices ({} vertices loaded)", quantized_vertices.size()
+    );
+}
+
+void SubmeshRenderer::load_indices(std::span<uint32_t const> line_indices, std::span<uint32_t const> triangle_indices)
 {
     ZoneScopedN("SubmeshRenderer::load_indices");
 
@@ -142,16 +222,15 @@ void SubmeshRenderer::load_indices(Submesh const& submesh)
     ibo.bind();
 
     // Mapping the indices to lines' if asked, and triangles' otherwise
-    std::vector<uint32_t> const& indices =
-        (render_mode == RenderMode::LINE ? submesh.get_line_indices() : submesh.get_triangle_indices());
+    std::span<uint32_t const> const indices = (render_mode == RenderMode::LINE ? line_indices : triangle_indices);
 
     Renderer::send_buffer_data(
-        BufferType::ELEMENT_BUFFER, static_cast<std::ptrdiff_t>(sizeof(indices.front()) * indices.size()),
-        indices.data(), BufferDataUsage::STATIC_DRAW
+        BufferType::ELEMENT_BUFFER, static_cast<std::ptrdiff_t>(indices.size_bytes()), indices.data(),
+        BufferDataUsage::STATIC_DRAW
     );
 
-    ibo.line_index_count = static_cast<uint32_t>(submesh.get_line_index_count());
-    ibo.triangle_index_count = static_cast<uint32_t>(submesh.get_triangle_index_count());
+    ibo.line_index_count = static_cast<uint32_t>(line_indices.size());
+    ibo.triangle_index_count = static_cast<uint32_t>(triangle_indices.size());
 
     ibo.unbind();
     vao.unbind();
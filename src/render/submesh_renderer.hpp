@@ -3,6 +3,8 @@
 #include <data/submesh.hpp>
 #include <render/graphic_objects.hpp>
 
+#include <span>
+
 namespace xen {
 enum class RenderMode : uint32_t {
     POINT,    ///< Renders the submesh as points.
@@ -13,16 +15,26 @@ enum class RenderMode : uint32_t {
 #endif
 };
 
+enum class VertexFormat : uint32_t {
+    FULL,     ///< Uploads the vertices as is, with full-precision attributes.
+    QUANTIZED ///< Uploads the vertices as QuantizedVertex; requires the vertex shader to decode the normals & tangents.
+};
+
 class SubmeshRenderer {
 public:
     SubmeshRenderer() = default;
-    explicit SubmeshRenderer(Submesh const& submesh, RenderMode render_mode = RenderMode::TRIANGLE)
+    explicit SubmeshRenderer(
+        Submesh const& submesh, RenderMode render_mode = RenderMode::TRIANGLE,
+        VertexFormat vertex_format = VertexFormat::FULL
+    )
     {
-        load(submesh, render_mode);
+        load(submesh, render_mode, vertex_format);
     }
 
     RenderMode get_render_mode() const { return render_mode; }
 
+    VertexFormat get_vertex_format() const { return vertex_format; }
+
     size_t get_material_index() const { return material_index; }
 
     /// Sets a specific mode to render the submesh into.
@@ -41,7 +53,24 @@ public:
     /// Loads the submesh's data (vertices & indices) onto the graphics card.
     /// \param submesh Submesh to load the data from.
     /// \param render_mode Primitive type to render the submesh with.
-    void load(Submesh const& submesh, RenderMode render_mode = RenderMode::TRIANGLE);
+    /// \param vertex_format Layout of the vertices in the graphics card's memory.
+    void load(
+        Submesh const& submesh, RenderMode render_mode = RenderMode::TRIANGLE,
+        VertexFormat vertex_format = VertexFormat::FULL
+    );
+
+    /// Loads vertices & indices onto the graphics card directly from memory which is not owned by a submesh, such as a
+    ///   memory-mapped file; no intermediate copy is made unless the vertices are to be quantized.
+    /// \param vertices Vertices to be loaded.
+    /// \param line_indices Indices of the lines, only loaded if rendering lines.
+    /// \param triangle_indices Indices of the triangles.
+    /// \param render_mode Primitive type to render the submesh with.
+    /// \param vertex_format Layout of the vertices in the graphics card's memory.
+    void load(
+        std::span<Vertex const> vertices, std::span<uint32_t const> line_indices,
+        std::span<uint32_t const> triangle_indices, RenderMode render_mode = RenderMode::TRIANGLE,
+        VertexFormat vertex_format = VertexFormat::FULL
+    );
 
     /// Draws the submesh in the scene.
     void draw() const;
@@ -52,13 +81,18 @@ private:
     IndexBuffer ibo;
 
     RenderMode render_mode = RenderMode::TRIANGLE;
+    VertexFormat vertex_format = VertexFormat::FULL;
     std::function<void(VertexBuffer const&, IndexBuffer const&)> render_func{};
 
     size_t material_index = 0;
 
 private:
-    void load_vertices(Submesh const& submesh);
+    void apply_render_mode(RenderMode render_mode);
+
+    void load_vertices(std::span<Vertex const> vertices);
+
+    void load_quantized_vertices(std::span<Vertex const> vertices);
 
-    void load_indices(Submesh const& submesh);
+    void load_indices(std::span<uint32_t const> line_indices, std::span<uint32_t const> triangle_indices);
 };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "texture.hpp"
 
+#include <data/compressed_image.hpp>
 #include <data/image.hpp>
 #if defined(USE_OPENGL_ES)
 #include <render/platform/framebuffer.hpp>
@@ -159,6 +160,42 @@ inline TextureColorspace recover_colorspace(ImageColorspace image_colorspace, bo
 
     return texture_colorspace;
 }
+
+inline TextureInternalFormat recover_compressed_internal_format(BlockCompression compression, bool should_use_srgb)
+{
+    switch (compression) {
+    case BlockCompression::BC1:
+        return (should_use_srgb ? TextureInternalFormat::BC1_SRGB : TextureInternalFormat::BC1);
+
+    case BlockCompression::BC3:
+        return (should_use_srgb ? TextureInternalFormat::BC3_SRGB : TextureInternalFormat::BC3);
+
+    case BlockCompression::BC5:
+        return TextureInternalFormat::BC5;
+
+    case BlockCompression::BC7:
+        return (should_use_srgb ? TextureInternalFormat::BC7_SRGB : TextureInternalFormat::BC7);
+    }
+
+    throw std::invalid_argument("[Texture] Invalid block compression to recover the internal format from");
+}
+
+inline TextureColorspace recover_colorspace(BlockCompression compression, bool should_use_srgb)
+{
+    switch (compression) {
+    case BlockCompression::BC1:
+        return (should_use_srgb ? TextureColorspace::SRGB : TextureColorspace::RGB);
+
+    case BlockCompression::BC3:
+    case BlockCompression::BC7:
+        return (should_use_srgb ? TextureColorspace::SRGBA : TextureColorspace::RGBA);
+
+    case BlockCompression::BC5:
+        return TextureColorspace::RG;
+    }
+
+    throw std::invalid_argument("[Texture] Invalid block compression to recover the colorspace from");
+}
 }
 
 void Texture::bind() const
@@ -204,6 +241,14 @@ void Texture::set_wrapping(TextureWrapping wrapping) const
     unbind();
 }
 
+#if !defined(USE_OPENGL_ES)
+uint64_t Texture::recover_bindless_handle()
+{
+    has_handle = true;
+    return Renderer::recover_texture_handle(index);
+}
+#endif
+
 void Texture::set_colorspace(TextureColorspace colorspace)
 {
     set_colorspace(
@@ -259,7 +304,7 @@ Texture::Texture(TextureType type) : type{type}
     set_wrapping(TextureWrapping::CLAMP);
 }
 
-void Texture::set_loaded_parameters(bool create_mipmaps) const
+void Texture::set_loaded_parameters(bool create_mipmaps, bool has_mipmaps) const
 {
     ZoneScopedN("Texture::set_loaded_parameters");
 
@@ -273,7 +318,10 @@ void Texture::set_loaded_parameters(bool create_mipmaps) const
         );
     }
 
-    if (create_mipmaps
+    if (has_mipmaps) {
+        set_filter(TextureFilter::LINEAR, TextureFilter::LINEAR, TextureFilter::LINEAR);
+    }
+    else if (create_mipmaps
 #if defined(USE_WEBGL)
         // WebGL doesn't seem to support mipmap generation for sRGB textures
         && colorspace != TextureColorspace::SRGB && colorspace != TextureColorspace::SRGBA
@@ -422,6 +470,37 @@ void Texture2D::load(Image const& image, bool create_mipmaps, bool should_use_sr
     set_loaded_parameters(create_mipmaps);
 }
 
+void Texture2D::load(CompressedImage const& image, bool should_use_srgb)
+{
+    ZoneScopedN("Texture2D::load(CompressedImage)");
+
+    if (image.empty()) {
+        // Image not found, defaulting texture to pure white
+        fill(Color::White);
+        return;
+    }
+
+    size = image.get_size();
+    colorspace = recover_colorspace(image.get_compression(), should_use_srgb);
+    data_type = TextureDataType::BYTE;
+
+    TextureInternalFormat const internal_format =
+        recover_compressed_internal_format(image.get_compression(), should_use_srgb);
+
+    bind();
+
+    for (uint32_t level = 0; level < image.get_mipmap_count(); ++level) {
+        CompressedMipmap const& mipmap = image.get_mipmaps()[level];
+        Renderer::send_compressed_image_data_2d(
+            TextureType::TEXTURE_2D, level, internal_format, mipmap.size, mipmap.data_size,
+            image.recover_mipmap_data(level)
+        );
+    }
+
+    // Mipmaps can only be filtered if the whole chain is available, a partial one leaving the texture incomplete
+    set_loaded_parameters(false, image.get_mipmap_count() == CompressedImage::compute_full_mipmap_count(size));
+}
+
 void Texture2D::fill(Color const& color)
 {
     ZoneScopedN("Texture2D::fill");
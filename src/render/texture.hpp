@@ -4,6 +4,7 @@
 
 namespace xen {
 class Color;
+class CompressedImage;
 class Image;
 using TexturePtr = std::shared_ptr<class Texture>;
 #if !defined(USE_OPENGL_ES)
@@ -38,6 +39,18 @@ public:
 
     [[nodiscard]] TextureDataType get_data_type() const { return data_type; }
 
+    /// Checks if a bindless handle has been recovered for the texture, which then cannot be modified anymore.
+    /// \return True if the texture has a bindless handle, false otherwise.
+    [[nodiscard]] bool has_bindless_handle() const { return has_handle; }
+
+#if !defined(USE_OPENGL_ES)
+    /// Recovers the texture's bindless handle, through which shaders can sample it without it being bound.
+    /// \note Requires GL_ARB_bindless_texture. The texture becomes immutable once it has a handle: neither its data nor
+    ///   its parameters can be changed afterward.
+    /// \return Handle of the texture.
+    uint64_t recover_bindless_handle();
+#endif
+
     /// Binds the current texture.
     void bind() const;
 
@@ -69,13 +82,17 @@ protected:
     TextureColorspace colorspace = TextureColorspace::INVALID;
     TextureDataType data_type{};
 
+    bool has_handle = false;
+
 protected:
     explicit Texture(TextureType type);
 
     /// Assigns default parameters after image loading. Must be called after having loaded the images' data in order to
     /// properly create the mipmaps.
     /// \param create_mipmaps True to generate texture mipmaps, false otherwise.
-    void set_loaded_parameters(bool create_mipmaps) const;
+    /// \param has_mipmaps True if all mipmap levels have already been sent, in which case they are not generated but
+    ///   only used for filtering.
+    void set_loaded_parameters(bool create_mipmaps, bool has_mipmaps = false) const;
 
     /// Generates mipmaps for the current texture.
     void generate_mipmaps() const;
@@ -143,6 +160,11 @@ public:
         load(image, create_mipmaps, should_use_srgb);
     }
 
+    explicit Texture2D(CompressedImage const& image, bool should_use_srgb = false) : Texture2D()
+    {
+        load(image, should_use_srgb);
+    }
+
     /// Constructs a plain colored texture. 
     /// \param color Color to fill the texture with.
     /// \param width Width of the texture to create.
@@ -172,6 +194,12 @@ public:
     /// \param should_use_srgb True to set an sRGB(A) colorspace if the image has an RGB(A) one, false to keep it as is.
     void load(Image const& image, bool create_mipmaps = true, bool should_use_srgb = false);
 
+    /// Loads the block-compressed image's data onto the graphics card, along with all its mipmap levels.
+    /// \note The graphics card must support the image's compression format.
+    /// \param image Compressed image to load the data from.
+    /// \param should_use_srgb True to interpret the color channels as sRGB, false to keep them linear.
+    void load(CompressedImage const& image, bool should_use_srgb = false);
+
     /// Fills the texture with a single color.
     /// \param color Color to fill the texture with.
     void fill(Color const& color);
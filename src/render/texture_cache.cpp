@@ -0,0 +1,499 @@
+#include "texture_cache.hpp"
+
+#include <data/bcn_encoder.hpp>
+#include <data/dds_format.hpp>
+#include <data/image.hpp>
+#include <data/image_buffer_pool.hpp>
+#include <data/image_format.hpp>
+#include <render/renderer.hpp>
+#include <render/texture.hpp>
+#include <utils/file_utils.hpp>
+#include <utils/file_watcher.hpp>
+#include <utils/filepath.hpp>
+#include <utils/hash.hpp>
+#include <utils/thread_pool.hpp>
+#include <utils/threading.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <tuple>
+
+namespace xen::TextureCache {
+namespace {
+/// Version of the cached data, to be incremented whenever the encoder's output changes so that older files get ignored.
+constexpr uint64_t cache_version = 2;
+
+FilePath cache_directory = "cache/textures";
+bool cache_enabled = true;
+
+std::optional<BlockCompression> recover_compression(Image const& image, bool should_use_srgb)
+{
+    if (image.get_data_type() != ImageDataType::BYTE) {
+        return std::nullopt;
+    }
+
+    switch (image.get_channel_count()) {
+    case 2:
+        if (is_supported(BlockCompression::BC5)) {
+            return BlockCompression::BC5;
+        }
+        break;
+
+    case 1:
+    case 3:
+        if (is_supported(BlockCompression::BC7, should_use_srgb)) {
+            return BlockCompression::BC7;
+        }
+        if (is_supported(BlockCompression::BC1, should_use_srgb)) {
+            return BlockCompression::BC1;
+        }
+        break;
+
+    case 4:
+        if (is_supported(BlockCompression::BC7, should_use_srgb)) {
+            return BlockCompression::BC7;
+        }
+        if (is_supported(BlockCompression::BC3, should_use_srgb)) {
+            return BlockCompression::BC3;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return std::nullopt;
+}
+
+/// Gives an sRGB(A) colorspace to an RGB(A) image whose colors are to be interpreted as sRGB, so that its mipmaps are
+///   generated in linear space when compressing it. Loaders never produce sRGB images, the colorspace being otherwise
+///   only known from the texture's usage.
+/// \note Gray images are left as is, no sRGB colorspace existing for them.
+/// \param image Image to be converted.
+/// \return Image holding the same values, with an sRGB(A) colorspace if applicable.
+Image convert_to_srgb_colorspace(Image image)
+{
+    if (image.get_data_type() != ImageDataType::BYTE ||
+        (image.get_colorspace() != ImageColorspace::RGB && image.get_colorspace() != ImageColorspace::RGBA)) {
+        return image;
+    }
+
+    ImageColorspace const colorspace =
+        (image.get_colorspace() == ImageColorspace::RGB ? ImageColorspace::SRGB : ImageColorspace::SRGBA);
+    Vector2ui const size = image.get_size();
+
+    return Image(size, colorspace, image.release_byte_data());
+}
+
+void save_to_cache(FilePath const& cache_filepath, CompressedImage const& image)
+{
+    ZoneScopedN("[TextureCache]::save_to_cache");
+
+    try {
+        std::filesystem::create_directories(std::filesystem::path(cache_directory.get_path()));
+
+        // Writing to a temporary file first, so that a partially written file can never be read
+        FilePath const temp_filepath = cache_filepath + ".tmp";
+        DdsFormat::save(temp_filepath, image);
+        std::filesystem::rename(
+            std::filesystem::path(temp_filepath.get_path()), std::filesystem::path(cache_filepath.get_path())
+        );
+    }
+    catch (std::exception const& exception) {
+        Log::vwarning("[TextureCache] Failed to save the compressed texture to the cache: {}", exception.what());
+    }
+}
+
+/// Recovers the path to the cached file of a texture.
+/// \param hash Hash identifying the texture's source.
+/// \param should_use_srgb True if the texture is to be interpreted as sRGB, which changes both its compression format
+///   & its mipmaps, false otherwise.
+/// \return Path to the cached file.
+FilePath recover_cache_filepath(uint64_t hash, bool should_use_srgb)
+{
+    hash = Hash::compute_fnv1a(should_use_srgb, hash);
+    hash = Hash::compute_fnv1a(cache_version, hash);
+    return cache_directory + ('/' + Hash::to_hex_string(hash) + ".dds");
+}
+
+/// Loads a compressed texture from the cache, if it is there & usable.
+/// \param cache_filepath Path to the cached file.
+/// \param should_use_srgb True if the texture is to be interpreted as sRGB, false otherwise.
+/// \return Compressed image if found in the cache, nothing otherwise.
+std::optional<CompressedImage> load_from_cache(FilePath const& cache_filepath, bool should_use_srgb)
+{
+    if (!FileUtils::is_readable(cache_filepath)) {
+        return std::nullopt;
+    }
+
+    try {
+        CompressedImage compressed_image = DdsFormat::load(cache_filepath);
+
+        // The cached texture may have been compressed with a format unsupported by the current graphics card
+        if (is_supported(compressed_image.get_compression(), should_use_srgb)) {
+            Log::debug("[TextureCache] Found compressed texture in cache ('" + cache_filepath + "')");
+            return compressed_image;
+        }
+    }
+    catch (std::exception const& exception) {
+        Log::vwarning("[TextureCache] Invalid cached texture, compressing it again: {}", exception.what());
+    }
+
+    return std::nullopt;
+}
+
+template <typename ImageLoaderT>
+Texture2DPtr load_cached(uint64_t hash, bool should_use_srgb, ImageLoaderT const& load_image)
+{
+    FilePath const cache_filepath = recover_cache_filepath(hash, should_use_srgb);
+
+    if (std::optional<CompressedImage> const compressed_image = load_from_cache(cache_filepath, should_use_srgb)) {
+        return Texture2D::create(*compressed_image, should_use_srgb);
+    }
+
+    decltype(auto) image = load_image();
+    std::optional<BlockCompression> const compression = recover_compression(image, should_use_srgb);
+
+    Texture2DPtr texture;
+
+    if (image.empty() || !compression.has_value()) {
+        texture = Texture2D::create(image, true, should_use_srgb);
+    }
+    else {
+        // The image is copied to be interpreted as sRGB, as it may be used elsewhere
+        CompressedImage const compressed_image =
+            (should_use_srgb ? BcnEncoder::compress(convert_to_srgb_colorspace(image), *compression)
+                             : BcnEncoder::compress(image, *compression));
+        save_to_cache(cache_filepath, compressed_image);
+
+        texture = Texture2D::create(compressed_image, should_use_srgb);
+    }
+
+    // Images loaded for the texture only are no longer needed, their buffer being reusable by the next loads
+    if constexpr (!std::is_reference_v<decltype(image)>) {
+        ImageBufferPool::release(std::move(image));
+    }
+
+    return texture;
+}
+
+/// Data of a texture loaded from an image file, ready to be sent to the graphics card.
+struct TextureData {
+    std::optional<CompressedImage> compressed_image; ///< Compressed blocks, if the image could be compressed.
+    Image image;                                     ///< Uncompressed image otherwise.
+};
+
+/// Decodes an image file, compressing the image if it is not already in the cache. Does not access the graphics card,
+///   & can thus be called from any thread.
+/// \param file_content Encoded content of the image file.
+/// \param should_use_srgb True to interpret the color channels as sRGB, false to keep them linear.
+/// \param flip_vertically Flip vertically the image when loading.
+/// \return Texture's data.
+TextureData load_texture_data(std::vector<uint8_t> const& file_content, bool should_use_srgb, bool flip_vertically)
+{
+    ZoneScopedN("[TextureCache]::load_texture_data");
+
+    if (!cache_enabled) {
+        return {std::nullopt, ImageFormat::load_from_data(file_content, flip_vertically)};
+    }
+
+    // The cached file is identified by the source's encoded content rather than by its path, so that modified files
+    // are compressed again & that identical files shared between assets are only compressed once
+    uint64_t const hash =
+        Hash::compute_fnv1a(flip_vertically, Hash::compute_fnv1a(file_content.data(), file_content.size()));
+    FilePath const cache_filepath = recover_cache_filepath(hash, should_use_srgb);
+
+    if (std::optional<CompressedImage> compressed_image = load_from_cache(cache_filepath, should_use_srgb)) {
+        return {std::move(compressed_image), Image()};
+    }
+
+    Image image = ImageFormat::load_from_data(file_content, flip_vertically);
+    std::optional<BlockCompression> const compression = recover_compression(image, should_use_srgb);
+
+    if (image.empty() || !compression.has_value()) {
+        return {std::nullopt, std::move(image)};
+    }
+
+    if (should_use_srgb) {
+        image = convert_to_srgb_colorspace(std::move(image));
+    }
+
+    CompressedImage compressed_image = BcnEncoder::compress(image, *compression);
+    save_to_cache(cache_filepath, compressed_image);
+    ImageBufferPool::release(std::move(image));
+
+    return {std::move(compressed_image), Image()};
+}
+
+struct WatchedTexture {
+    std::weak_ptr<Texture2D> texture;
+    bool should_use_srgb{};
+    bool flip_vertically{};
+};
+
+/// Path to an image file & the settings its texture is loaded with.
+using PrefetchKey = std::tuple<std::string, bool, bool>;
+
+std::mutex prefetched_textures_mutex;
+/// Data of the textures being prepared ahead, to be taken when loading them.
+std::map<PrefetchKey, std::future<TextureData>> prefetched_textures;
+
+std::mutex watched_textures_mutex;
+/// Textures loaded from each watched file, to be reloaded when it is modified.
+std::unordered_map<std::string, std::vector<WatchedTexture>> watched_textures;
+
+/// Decodes a modified image file for all the textures loaded from it, once per distinct set of loading settings.
+/// \param filepath Path to the modified image file.
+/// \return Function sending the reloaded data to the textures, to be executed on the main thread.
+FileWatcher::ApplyFunc reload_textures(FilePath const& filepath)
+{
+    ZoneScopedN("[TextureCache]::reload_textures");
+
+    struct TextureReload {
+        std::vector<TextureData> texture_data;
+        std::vector<std::pair<WatchedTexture, size_t>> textures; ///< Textures & the index of their data.
+    };
+
+    auto reload = std::make_shared<TextureReload>();
+
+    {
+        std::lock_guard<std::mutex> const lock(watched_textures_mutex);
+
+        for (WatchedTexture const& watched_texture : watched_textures[filepath.to_utf8()]) {
+            if (!watched_texture.texture.expired()) {
+                reload->textures.emplace_back(watched_texture, 0);
+            }
+        }
+    }
+
+    if (reload->textures.empty()) {
+        return {};
+    }
+
+    std::vector<uint8_t> const file_content = FileUtils::read_file_to_array(filepath);
+    std::vector<std::pair<bool, bool>> texture_settings;
+
+    for (auto& [watched_texture, data_index] : reload->textures) {
+        std::pair<bool, bool> const settings(watched_texture.should_use_srgb, watched_texture.flip_vertically);
+        auto const settings_iter = std::find(texture_settings.cbegin(), texture_settings.cend(), settings);
+        data_index = static_cast<size_t>(settings_iter - texture_settings.cbegin());
+
+        if (settings_iter == texture_settings.cend()) {
+            texture_settings.emplace_back(settings);
+            reload->texture_data.emplace_back(load_texture_data(file_content, settings.first, settings.second));
+        }
+    }
+
+    return [reload, filepath]() {
+        ZoneScopedN("[TextureCache]::apply_reload");
+
+        for (auto const& [watched_texture, data_index] : reload->textures) {
+            Texture2DPtr const texture = watched_texture.texture.lock();
+
+            if (texture == nullptr) {
+                continue;
+            }
+
+            // A texture's storage cannot be changed anymore once it has a bindless handle
+            if (texture->has_bindless_handle()) {
+                Log::vwarning(
+                    "[TextureCache] Cannot reload the texture from '{}' while it has a bindless handle",
+                    filepath.to_utf8()
+                );
+                continue;
+            }
+
+            TextureData const& texture_data = reload->texture_data[data_index];
+
+            if (texture_data.compressed_image.has_value()) {
+                texture->load(*texture_data.compressed_image, watched_texture.should_use_srgb);
+            }
+            else {
+                texture->load(texture_data.image, true, watched_texture.should_use_srgb);
+            }
+        }
+
+        for (TextureData& texture_data : reload->texture_data) {
+            ImageBufferPool::release(std::move(texture_data.image));
+        }
+    };
+}
+
+/// Recovers the data of a texture loaded from an image file, taking it from the prefetched textures if it has been
+///   prepared ahead.
+/// \param filepath Path to the image file.
+/// \param should_use_srgb True to interpret the color channels as sRGB, false to keep them linear.
+/// \param flip_vertically Flip vertically the image when loading.
+/// \return Texture's data.
+TextureData recover_texture_data(FilePath const& filepath, bool should_use_srgb, bool flip_vertically)
+{
+    std::future<TextureData> prefetched_texture;
+
+    {
+        std::lock_guard<std::mutex> const lock(prefetched_textures_mutex);
+
+        auto const texture_iter =
+            prefetched_textures.find(PrefetchKey(filepath.to_utf8(), should_use_srgb, flip_vertically));
+
+        if (texture_iter != prefetched_textures.end()) {
+            prefetched_texture = std::move(texture_iter->second);
+            prefetched_textures.erase(texture_iter);
+        }
+    }
+
+    // The errors met while prefetching are rethrown here, as if the texture was loaded right now
+    if (prefetched_texture.valid()) {
+        return prefetched_texture.get();
+    }
+
+    return load_texture_data(FileUtils::read_file_to_array(filepath), should_use_srgb, flip_vertically);
+}
+
+void watch_texture(FilePath const& filepath, Texture2DPtr const& texture, bool should_use_srgb, bool flip_vertically)
+{
+    std::lock_guard<std::mutex> const lock(watched_textures_mutex);
+
+    auto const [textures_iter, is_new_file] = watched_textures.try_emplace(filepath.to_utf8());
+    std::erase_if(textures_iter->second, [](WatchedTexture const& watched_texture) {
+        return watched_texture.texture.expired();
+    });
+    textures_iter->second.emplace_back(WatchedTexture{texture, should_use_srgb, flip_vertically});
+
+    if (is_new_file) {
+        FileWatcher::watch(filepath, [filepath]() { return reload_textures(filepath); });
+    }
+}
+}
+
+void set_directory(FilePath const& directory)
+{
+    cache_directory = directory;
+}
+
+FilePath const& get_directory()
+{
+    return cache_directory;
+}
+
+void enable(bool enabled)
+{
+    cache_enabled = enabled;
+}
+
+void disable()
+{
+    enable(false);
+}
+
+bool is_enabled()
+{
+    return cache_enabled;
+}
+
+bool is_supported(BlockCompression compression, bool should_use_srgb)
+{
+    switch (compression) {
+    case BlockCompression::BC1:
+    case BlockCompression::BC3:
+#if !defined(USE_OPENGL_ES)
+        return Renderer::is_extension_supported("GL_EXT_texture_compression_s3tc") &&
+               (!should_use_srgb || Renderer::is_extension_supported("GL_EXT_texture_sRGB"));
+#else
+        return (Renderer::is_extension_supported("GL_EXT_texture_compression_s3tc") ||
+                Renderer::is_extension_supported("GL_WEBGL_compressed_texture_s3tc")) &&
+               (!should_use_srgb || Renderer::is_extension_supported("GL_EXT_texture_compression_s3tc_srgb") ||
+                Renderer::is_extension_supported("GL_WEBGL_compressed_texture_s3tc_srgb"));
+#endif
+
+    case BlockCompression::BC5:
+#if !defined(USE_OPENGL_ES)
+        return Renderer::check_version(3, 0) || Renderer::is_extension_supported("GL_ARB_texture_compression_rgtc");
+#else
+        return Renderer::is_extension_supported("GL_EXT_texture_compression_rgtc");
+#endif
+
+    case BlockCompression::BC7:
+#if !defined(USE_OPENGL_ES)
+        return Renderer::check_version(4, 2) || Renderer::is_extension_supported("GL_ARB_texture_compression_bptc");
+#else
+        return Renderer::is_extension_supported("GL_EXT_texture_compression_bptc");
+#endif
+    }
+
+    return false;
+}
+
+Texture2DPtr load(FilePath const& filepath, bool should_use_srgb, bool flip_vertically)
+{
+    ZoneScopedN("TextureCache::load(FilePath)");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    TextureData texture_data = recover_texture_data(filepath, should_use_srgb, flip_vertically);
+
+    Texture2DPtr texture =
+        (texture_data.compressed_image.has_value() ? Texture2D::create(*texture_data.compressed_image, should_use_srgb)
+                                                   : Texture2D::create(texture_data.image, true, should_use_srgb));
+    ImageBufferPool::release(std::move(texture_data.image));
+
+    // The texture is reloaded in place whenever its file is modified, being updated for all its users
+    watch_texture(filepath, texture, should_use_srgb, flip_vertically);
+
+    return texture;
+}
+
+void prefetch(FilePath const& filepath, bool should_use_srgb, bool flip_vertically)
+{
+#if defined(XEN_THREADS_AVAILABLE) && !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
+    ZoneScopedN("TextureCache::prefetch");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    std::lock_guard<std::mutex> const lock(prefetched_textures_mutex);
+
+    auto const [texture_iter, is_new_texture] =
+        prefetched_textures.try_emplace(PrefetchKey(filepath.to_utf8(), should_use_srgb, flip_vertically));
+
+    if (!is_new_texture) {
+        return;
+    }
+
+    auto promise = std::make_shared<std::promise<TextureData>>();
+    texture_iter->second = promise->get_future();
+
+    get_default_thread_pool().add_task([promise, filepath, should_use_srgb, flip_vertically]() {
+        // Tasks must not throw; any exception is transmitted to the future instead
+        try {
+            promise->set_value(
+                load_texture_data(FileUtils::read_file_to_array(filepath), should_use_srgb, flip_vertically)
+            );
+        }
+        catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+#else
+    static_cast<void>(filepath);
+    static_cast<void>(should_use_srgb);
+    static_cast<void>(flip_vertically);
+#endif
+}
+
+Texture2DPtr load(Image const& image, bool should_use_srgb)
+{
+    ZoneScopedN("TextureCache::load(Image)");
+
+    if (!cache_enabled || image.empty() || image.get_data_type() != ImageDataType::BYTE) {
+        return Texture2D::create(image, true, should_use_srgb);
+    }
+
+    size_t const data_size = static_cast<size_t>(image.get_width()) * image.get_height() * image.get_channel_count();
+
+    uint64_t hash = Hash::compute_fnv1a(static_cast<uint8_t const*>(image.data()), data_size);
+    hash = Hash::compute_fnv1a(image.get_width(), hash);
+    hash = Hash::compute_fnv1a(image.get_height(), hash);
+    hash = Hash::compute_fnv1a(image.get_channel_count(), hash);
+
+    return load_cached(hash, should_use_srgb, [&image]() -> Image const& { return image; });
+}
+}
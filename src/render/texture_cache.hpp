@@ -0,0 +1,64 @@
+#pragma once
+
+namespace xen {
+class FilePath;
+class Image;
+enum class BlockCompression : uint8_t;
+using Texture2DPtr = std::shared_ptr<class Texture2D>;
+
+/// Block-compressed texture cache. Images are compressed on their first load & saved as DDS files in the cache
+/// directory, named after a hash of their content; subsequent loads directly memory-map the compressed blocks & send
+/// them to the graphics card, without decoding nor compressing the source image again.
+/// Images that cannot be compressed (floating-point ones, or if the graphics card does not support any suitable
+/// format) are loaded as regular uncompressed textures.
+namespace TextureCache {
+/// Sets the directory in which compressed textures are stored. It will be created if it does not exist.
+/// \param directory Path to the cache directory.
+void set_directory(FilePath const& directory);
+
+/// Gets the directory in which compressed textures are stored.
+/// \return Path to the cache directory; "cache/textures" by default.
+FilePath const& get_directory();
+
+/// Enables or disables texture compression. If disabled, all textures are loaded uncompressed.
+/// \param enabled True to compress & cache textures, false otherwise.
+void enable(bool enabled = true);
+
+void disable();
+
+[[nodiscard]] bool is_enabled();
+
+/// Checks if the graphics card supports the given compression format.
+/// \param compression Compression format to be checked.
+/// \param should_use_srgb True to check for the sRGB variant of the format, false otherwise.
+/// \return True if textures with the given format can be created, false otherwise.
+[[nodiscard]] bool is_supported(BlockCompression compression, bool should_use_srgb = false);
+
+/// Loads a texture from an image file, compressing it if it is not already in the cache.
+/// \note The file is watched afterward, the texture being reloaded in place when it is modified, unless it has a
+///   bindless handle (e.g. once used by a MaterialTable) which makes it immutable.
+/// \see FileWatcher
+/// \param filepath Path to the image file to be loaded.
+/// \param should_use_srgb True to interpret the color channels as sRGB, false to keep them linear.
+/// \param flip_vertically Flip vertically the image when loading.
+/// \return Loaded texture.
+Texture2DPtr load(FilePath const& filepath, bool should_use_srgb = false, bool flip_vertically = true);
+
+/// Starts preparing a texture in the background, to be loaded later with load() & the same settings. The image file
+///   is read & either found in the cache or decoded & compressed, so that prefetching all the textures about to be
+///   loaded prepares them concurrently, while the textures are created one by one.
+/// \note A prefetched texture should always be loaded afterward; its data is otherwise kept in memory.
+/// \note Errors met while preparing the texture, such as a missing file, are thrown by load().
+/// \note If threads are unavailable or using Emscripten, this does nothing.
+/// \param filepath Path to the image file to be loaded.
+/// \param should_use_srgb True to interpret the color channels as sRGB, false to keep them linear.
+/// \param flip_vertically Flip vertically the image when loading.
+void prefetch(FilePath const& filepath, bool should_use_srgb = false, bool flip_vertically = true);
+
+/// Loads a texture from an image, compressing it if it is not already in the cache.
+/// \param image Image to be loaded.
+/// \param should_use_srgb True to interpret the color channels as sRGB, false to keep them linear.
+/// \return Loaded texture.
+Texture2DPtr load(Image const& image, bool should_use_srgb = false);
+}
+}
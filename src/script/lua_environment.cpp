@@ -1,6 +1,7 @@
 #include <entity.hpp>
 #include <script/lua_environment.hpp>
 #include <script/lua_wrapper.hpp>
+#include <utils/file_utils.hpp>
 #include <utils/filepath.hpp>
 
 #define SOL_ALL_SAFETIES_ON 1
@@ -51,10 +52,12 @@ bool LuaEnvironment::execute_from_file(FilePath const& filepath) const
 
     Log::debug("[LuaEnvironment] Executing code from file ('" + filepath + "')...");
 
+    // The file is read through the virtual file system, & can thus be held by a mounted archive
     try {
-        LuaWrapper::get_state().script_file(filepath.to_utf8(), *environment);
+        std::string const code = FileUtils::read_file_to_string(filepath);
+        LuaWrapper::get_state().script(code, *environment, '@' + filepath.to_utf8());
     }
-    catch (sol::error const& err) {
+    catch (std::exception const& err) {
         Log::error("[LuaEnvironment] Error executing code from file: '{}'.", err.what());
         return false;
     }
@@ -4,6 +4,9 @@
 #if defined(XEN_USE_FBX)
 #include <data/fbx_format.hpp>
 #endif
+#if defined(XEN_USE_AUDIO)
+#include <data/flac_format.hpp>
+#endif
 #include <data/gltf_format.hpp>
 #include <data/image.hpp>
 #include <data/image_format.hpp>
@@ -15,6 +18,7 @@
 #if defined(XEN_USE_AUDIO)
 #include <data/wav_format.hpp>
 #endif
+#include <data/xmesh_format.hpp>
 #include <render/mesh_renderer.hpp>
 #include <script/lua_wrapper.hpp>
 #include <utils/filepath.hpp>
@@ -42,6 +46,13 @@ void LuaWrapper::register_file_format_types()
     }
 #endif
 
+#if defined(XEN_USE_AUDIO)
+    {
+        sol::table flacFormat = state["FlacFormat"].get_or_create<sol::table>();
+        flacFormat["load"] = &FlacFormat::load;
+    }
+#endif
+
     {
         // sol::table gltfFormat = state["GltfFormat"].get_or_create<sol::table>();
         // gltfFormat["load"] = &GltfFormat::load;
@@ -102,6 +113,15 @@ void LuaWrapper::register_file_format_types()
         wavFormat["save"] = &WavFormat::save;
     }
 #endif
+
+    {
+        sol::table xmeshFormat = state["XmeshFormat"].get_or_create<sol::table>();
+        xmeshFormat["load"] = &XmeshFormat::load;
+        xmeshFormat["save"] = sol::overload(
+            [](FilePath const& p, Mesh const& m) { XmeshFormat::save(p, m); },
+            PickOverload<FilePath const&, Mesh const&, MeshRendererData const*>(&XmeshFormat::save)
+        );
+    }
 }
 
 }
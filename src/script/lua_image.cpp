@@ -1,4 +1,5 @@
 #include <data/image.hpp>
+#include <data/image_processing.hpp>
 
 #include <script/lua_wrapper.hpp>
 #include <utils/type_utils.hpp>
@@ -42,6 +43,10 @@ void LuaWrapper::register_image_types()
         image["set_float_value"] = &Image::set_float_value;
         image["set_byte_pixel"] = PickOverload<size_t, size_t, uint8_t>(&Image::set_pixel<uint8_t>);
         image["set_float_pixel"] = PickOverload<size_t, size_t, float>(&Image::set_pixel<float>);
+        image["flip_vertically"] = &Image::flip_vertically;
+        image["expand_to_rgba"] = &Image::expand_to_rgba;
+        image["convert_to_linear"] = &Image::convert_to_linear;
+        image["convert_to_srgb"] = &Image::convert_to_srgb;
         // image["setVector2ubPixel"] = PickOverload<size_t, size_t, Vector2ub const&>(&Image::set_pixel<uint8_t, 2>);
         // image["setVector3ubPixel"] = PickOverload<size_t, size_t, Vector3ub const&>(&Image::set_pixel<uint8_t, 3>);
         // image["setVector4ubPixel"] = PickOverload<size_t, size_t, Vector4ub const&>(&Image::set_pixel<uint8_t, 4>);
@@ -62,5 +67,27 @@ void LuaWrapper::register_image_types()
             "ImageDataType", {{"BYTE", ImageDataType::BYTE}, {"FLOAT", ImageDataType::FLOAT}}
         );
     }
+
+    {
+        sol::table imageProcessing = state["ImageProcessing"].get_or_create<sol::table>();
+        imageProcessing["resize"] = sol::overload(
+            [](Image const& i, Vector2ui const& s) { return ImageProcessing::resize(i, s); }, &ImageProcessing::resize
+        );
+        imageProcessing["generate_mipmaps"] = sol::overload(
+            [](Image const& i) { return ImageProcessing::generate_mipmaps(i); }, &ImageProcessing::generate_mipmaps
+        );
+        imageProcessing["extract_channel"] = &ImageProcessing::extract_channel;
+        imageProcessing["swizzle"] = [](Image const& i, std::vector<uint8_t> const& c, ImageColorspace s) {
+            return ImageProcessing::swizzle(i, c, s);
+        };
+        imageProcessing["premultiply_alpha"] = &ImageProcessing::premultiply_alpha;
+        imageProcessing["unpremultiply_alpha"] = &ImageProcessing::unpremultiply_alpha;
+
+        state.new_enum<ResamplingFilter>(
+            "ResamplingFilter", {{"BOX", ResamplingFilter::BOX},
+                                 {"TRIANGLE", ResamplingFilter::TRIANGLE},
+                                 {"KAISER", ResamplingFilter::KAISER}}
+        );
+    }
 }
 }
\ No newline at end of file
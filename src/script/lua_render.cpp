@@ -147,6 +147,7 @@ void LuaWrapper::register_render_types()
         light["energy"] = sol::property(&Light::get_energy, &Light::set_energy);
         light["color"] = sol::property(&Light::get_color, &Light::set_color);
         light["angle"] = sol::property(&Light::get_angle, &Light::set_angle);
+        light["shadows"] = sol::property(&Light::has_shadows, &Light::enable_shadows);
 
         state.new_enum<LightType>(
             "LightType",
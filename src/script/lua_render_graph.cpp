@@ -25,6 +25,25 @@ void LuaWrapper::register_render_graph_types()
 {
     sol::state& state = get_state();
 
+    {
+        sol::usertype<RenderTimerStats> render_timer_stats = state.new_usertype<RenderTimerStats>(
+            "RenderTimerStats", sol::constructors<RenderTimerStats()>()
+        );
+        render_timer_stats["latest"] = &RenderTimerStats::latest;
+        render_timer_stats["min"] = &RenderTimerStats::min;
+        render_timer_stats["average"] = &RenderTimerStats::average;
+        render_timer_stats["p99"] = &RenderTimerStats::p99;
+        render_timer_stats["sample_count"] = &RenderTimerStats::sample_count;
+    }
+
+    {
+        sol::usertype<RenderPassProfile> render_pass_profile = state.new_usertype<RenderPassProfile>(
+            "RenderPassProfile", sol::constructors<RenderPassProfile()>()
+        );
+        render_pass_profile["name"] = &RenderPassProfile::name;
+        render_pass_profile["stats"] = &RenderPassProfile::stats;
+    }
+
     {
         sol::usertype<RenderGraph> render_graph = state.new_usertype<RenderGraph>(
             "RenderGraph", sol::constructors<RenderGraph()>(), sol::base_classes, sol::bases<Graph<RenderPass>>()
@@ -38,6 +57,18 @@ void LuaWrapper::register_render_graph_types()
         render_graph["remove_node"] = &RenderGraph::remove_node;
 
         render_graph["is_valid"] = &RenderGraph::is_valid;
+        render_graph["is_compiled"] = &RenderGraph::is_compiled;
+        render_graph["get_culled_pass_count"] = &RenderGraph::get_culled_pass_count;
+        render_graph["get_fused_pass_count"] = &RenderGraph::get_fused_pass_count;
+        render_graph["get_transient_texture_count"] = &RenderGraph::get_transient_texture_count;
+        render_graph["get_physical_texture_count"] = &RenderGraph::get_physical_texture_count;
+        render_graph["get_transient_memory_size"] = &RenderGraph::get_transient_memory_size;
+        render_graph["invalidate"] = &RenderGraph::invalidate;
+        render_graph["compile"] = &RenderGraph::compile;
+        render_graph["get_profile"] = &RenderGraph::get_profile;
+#if !defined(XEN_NO_OVERLAY)
+        render_graph["push_profile"] = &RenderGraph::push_profile;
+#endif
         render_graph["get_geometry_pass"] = PickNonConstOverload<>(&RenderGraph::get_geometry_pass);
         render_graph["addBloom"] = &RenderGraph::add_render_process<Bloom>;
         render_graph["addBoxBlur"] = &RenderGraph::add_render_process<BoxBlur>;
@@ -83,6 +114,9 @@ void LuaWrapper::register_render_graph_types()
         };
 
         render_pass["is_enabled"] = &RenderPass::is_enabled;
+        render_pass["has_side_effects"] = &RenderPass::has_side_effects;
+        render_pass["is_compute_enabled"] = &RenderPass::is_compute_enabled;
+        render_pass["is_compute_supported"] = &RenderPass::is_compute_supported;
         render_pass["get_name"] = &RenderPass::get_name;
         render_pass["get_program"] = PickNonConstOverload<>(&RenderPass::get_program);
         render_pass["get_read_texture_count"] = &RenderPass::get_read_texture_count;
@@ -93,11 +127,15 @@ void LuaWrapper::register_render_graph_types()
         render_pass["has_read_texture"] = &RenderPass::has_read_texture;
         render_pass["get_framebuffer"] = [](RenderPass const& p) { return &p.get_framebuffer(); };
         render_pass["recover_elapsed_time"] = &RenderPass::recover_elapsed_time;
+        render_pass["recover_elapsed_time_stats"] = &RenderPass::recover_elapsed_time_stats;
         render_pass["set_name"] = &RenderPass::set_name;
         render_pass["set_program"] = [](RenderPass& p, RenderShaderProgram& sp) { p.set_program(std::move(sp)); };
         render_pass["enable"] =
             sol::overload([](RenderPass& p) { p.enable(); }, PickOverload<bool>(&RenderPass::enable));
         render_pass["disable"] = &RenderPass::disable;
+        render_pass["set_side_effects"] = sol::overload(
+            [](RenderPass& p) { p.set_side_effects(); }, PickOverload<bool>(&RenderPass::set_side_effects)
+        );
         render_pass["is_valid"] = &RenderPass::is_valid;
         render_pass["add_read_texture"] = sol::overload(
 #if !defined(USE_OPENGL_ES)
@@ -106,7 +144,10 @@ void LuaWrapper::register_render_graph_types()
             [](RenderPass& p, Texture2DPtr t, const std::string& n) { p.add_read_texture(std::move(t), n); },
             [](RenderPass& p, Texture3DPtr t, const std::string& n) { p.add_read_texture(std::move(t), n); }
         );
-        render_pass["remove_read_texture"] = &RenderPass::remove_read_texture;
+        render_pass["remove_read_texture"] = sol::overload(
+            PickOverload<Texture const&>(&RenderPass::remove_read_texture),
+            PickOverload<std::string const&>(&RenderPass::remove_read_texture)
+        );
         render_pass["clear_read_textures"] = &RenderPass::clear_read_textures;
         render_pass["set_write_depth_texture"] = &RenderPass::set_write_depth_texture;
         render_pass["add_write_color_texture"] = &RenderPass::add_write_color_texture;
@@ -125,6 +166,7 @@ void LuaWrapper::register_render_graph_types()
             bloom_render["get_threshold_pass"] = &Bloom::get_threshold_pass;
             bloom_render["get_downscale_pass_count"] = &Bloom::get_downscale_pass_count;
             bloom_render["get_downscale_pass"] = PickNonConstOverload<size_t>(&Bloom::get_downscale_pass);
+            bloom_render["get_downscale_chain_pass"] = &Bloom::get_downscale_chain_pass;
             bloom_render["get_downscale_buffer_count"] = &Bloom::get_downscale_buffer_count;
             bloom_render["get_downscale_buffer"] = [](Bloom& b, size_t i) { return &b.get_downscale_buffer(i); };
             bloom_render["get_upscale_pass_count"] = &Bloom::get_upscale_pass_count;
@@ -205,6 +247,11 @@ void LuaWrapper::register_render_graph_types()
             );
             render_process["resize_buffers"] = &RenderProcess::resize_buffers;
             render_process["recover_elapsed_time"] = &RenderProcess::recover_elapsed_time;
+            render_process["has_compute_path"] = &RenderProcess::has_compute_path;
+            render_process["is_compute_enabled"] = &RenderProcess::is_compute_enabled;
+            render_process["set_compute_state"] = &RenderProcess::set_compute_state;
+            render_process["enable_compute"] = &RenderProcess::enable_compute;
+            render_process["disable_compute"] = &RenderProcess::disable_compute;
         }
 
         {
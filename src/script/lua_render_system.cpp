@@ -64,6 +64,24 @@ void LuaWrapper::register_render_system_types()
             PickOverload<FilePath const&, TextureFormat, PixelDataType>(&RenderSystem::save_to_image)
         );
         render_system["remove_cubemap"] = &RenderSystem::remove_cubemap;
+        render_system["get_frame_capturer"] = PickNonConstOverload<>(&RenderSystem::get_frame_capturer);
+
+        sol::usertype<FrameCapturer> frame_capturer =
+            state.new_usertype<FrameCapturer>("FrameCapturer", sol::no_constructor);
+        frame_capturer["is_capturing_continuously"] = &FrameCapturer::is_capturing_continuously;
+        frame_capturer["get_pending_capture_count"] = &FrameCapturer::get_pending_capture_count;
+        frame_capturer["get_skipped_frame_count"] = &FrameCapturer::get_skipped_frame_count;
+        frame_capturer["save"] = sol::overload(
+            [](FrameCapturer& c, FilePath const& p) { c.save(p); },
+            [](FrameCapturer& c, FilePath const& p, TextureFormat f) { c.save(p, f); },
+            [](FrameCapturer& c, FilePath const& p, TextureFormat f, PixelDataType t) { c.save(p, f, t); }
+        );
+        frame_capturer["enable_continuous_saving"] = sol::overload(
+            [](FrameCapturer& c, FilePath const& d) { c.enable_continuous_saving(d); },
+            [](FrameCapturer& c, FilePath const& d, std::string const& e) { c.enable_continuous_saving(d, e); }
+        );
+        frame_capturer["disable_continuous_capture"] = &FrameCapturer::disable_continuous_capture;
+        frame_capturer["flush"] = &FrameCapturer::flush;
 
         state.new_enum<TextureFormat>(
             "TextureFormat", {{"RED", TextureFormat::RED},
@@ -4,6 +4,7 @@
 #include <script/lua_wrapper.hpp>
 #include <utils/filepath.hpp>
 #include <utils/file_utils.hpp>
+#include <utils/file_watcher.hpp>
 
 #define SOL_SAFE_GETTER 0 // Allowing implicit conversion to bool
 #include "sol/sol.hpp"
@@ -11,6 +12,51 @@
 #include <tracy/Tracy.hpp>
 
 namespace xen {
+namespace {
+struct ReloadedCode {
+    uint32_t version = 0;
+    std::string code;
+};
+
+std::mutex codes_mutex;
+/// Code of the watched script files, by path. A code is only held once its file has been reloaded; the scripts which
+///   have not loaded it yet are then outdated.
+std::unordered_map<std::string, ReloadedCode> reloaded_codes;
+
+void watch_code(FilePath const& filepath)
+{
+    {
+        std::lock_guard<std::mutex> const lock(codes_mutex);
+
+        if (!reloaded_codes.try_emplace(filepath.to_utf8()).second) {
+            return;
+        }
+    }
+
+    FileWatcher::watch(filepath, [filepath]() -> FileWatcher::ApplyFunc {
+        auto code = std::make_shared<std::string>(FileUtils::read_file_to_string(filepath));
+
+        // The code is only compiled in a separate state, to check its syntax without executing anything; a script
+        // being edited thus keeps running until its file is valid again
+        sol::state syntax_state;
+        sol::load_result const chunk = syntax_state.load(*code);
+
+        if (!chunk.valid()) {
+            sol::error const error = chunk;
+            throw std::invalid_argument("[LuaScript] Invalid script: " + std::string(error.what()));
+        }
+
+        return [filepath, code = std::move(code)]() {
+            std::lock_guard<std::mutex> const lock(codes_mutex);
+
+            ReloadedCode& reloaded_code = reloaded_codes[filepath.to_utf8()];
+            ++reloaded_code.version;
+            reloaded_code.code = std::move(*code);
+        };
+    });
+}
+}
+
 LuaScript::LuaScript(std::string const& code)
 {
     Log::debug("[LuaScript] Creating script...");
@@ -53,10 +99,58 @@ void LuaScript::load_code_from_file(FilePath const& filepath)
     ZoneTextF("Path: %s", filepath.to_utf8().c_str());
 
     Log::debug("[LuaScript] Loading code from file ('" + filepath + "')...");
+
     load_code(FileUtils::read_file_to_string(filepath));
+
+    code_path = filepath.to_utf8();
+    watch_code(filepath);
+
+    {
+        std::lock_guard<std::mutex> const lock(codes_mutex);
+        loaded_version = reloaded_codes[code_path].version;
+    }
+
     Log::debug("[LuaScript] Loaded code from file");
 }
 
+bool LuaScript::is_outdated() const
+{
+    if (code_path.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> const lock(codes_mutex);
+
+    auto const code_iter = reloaded_codes.find(code_path);
+    return (code_iter != reloaded_codes.end() && code_iter->second.version != loaded_version);
+}
+
+bool LuaScript::update_code()
+{
+    std::string code;
+
+    {
+        std::lock_guard<std::mutex> const lock(codes_mutex);
+
+        auto const code_iter = reloaded_codes.find(code_path);
+
+        if (code_path.empty() || code_iter == reloaded_codes.end() || code_iter->second.version == loaded_version) {
+            return false;
+        }
+
+        code = code_iter->second.code;
+        loaded_version = code_iter->second.version;
+    }
+
+    ZoneScopedN("LuaScript::update_code");
+
+    Log::debug("[LuaScript] Updating code from file ('" + code_path + "')...");
+    load_code(code);
+    Log::debug("[LuaScript] Updated code from file");
+
+    return true;
+}
+
 bool LuaScript::update(FrameTimeInfo const& time_info) const
 {
     ZoneScopedN("LuaScript::update");
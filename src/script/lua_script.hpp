@@ -22,12 +22,26 @@ public:
     /// \param code Code to be loaded.
     void load_code(std::string const& code);
 
-    /// Loads a script from a file.
+    /// Loads a script from a file. The file is watched afterward, its code being reloaded in the background when it is
+    ///   modified; the script system then loads it into the script.
     /// \note The script must contain a function named update().
     /// \note This clears the script's environment, effectively unregistering all existing symbols.
     /// \param filepath Path to the script to be loaded.
+    /// \see update_code()
     void load_code_from_file(FilePath const& filepath);
 
+    /// Checks if the script's file has been modified & reloaded by the file watcher since the script has last been
+    ///   loaded from it.
+    /// \return True if the script is outdated, false otherwise.
+    /// \see FileWatcher
+    [[nodiscard]] bool is_outdated() const;
+
+    /// Loads the code reloaded from the script's file, if the script is outdated.
+    /// \note This clears the script's environment, effectively unregistering all existing symbols.
+    /// \return True if the code has been loaded, false if the script was up-to-date.
+    /// \see is_outdated()
+    bool update_code();
+
     /// Registers an entity to a variable, making it accessible from the script.
     /// \param entity Entity to be registered.
     /// \param name Name of the variable to bind the entity to.
@@ -43,6 +57,10 @@ public:
 
 private:
     LuaEnvironment environment{};
+    /// Path to the file the script has last been loaded from, if any.
+    std::string code_path{};
+    /// Version of the script's file that has last been loaded, incremented every time the file watcher reloads it.
+    uint32_t loaded_version = 0;
 
 private:
     /// Executes the script's setup function. Does nothing if none exists.
@@ -61,6 +61,8 @@ void LuaWrapper::register_shader_types()
         shader["load"] = &Shader::load;
         shader["compile"] = &Shader::compile;
         shader["is_compiled"] = &Shader::is_compiled;
+        shader["get_defines"] = &Shader::get_defines;
+        shader["set_defines"] = &Shader::set_defines;
         shader["destroy"] = &Shader::destroy;
     }
 
@@ -91,6 +91,8 @@ void LuaWrapper::register_shader_program_types()
                FragmentShader& f) { p.set_shaders(std::move(v), std::move(tc), std::move(te), std::move(f)); }
 #endif
         );
+        render_shader_program["get_permutation"] = &RenderShaderProgram::get_permutation;
+        render_shader_program["set_permutation"] = &RenderShaderProgram::set_permutation;
         render_shader_program["clone"] = &RenderShaderProgram::clone;
         render_shader_program["destroy_vertex_shader"] = &RenderShaderProgram::destroy_vertex_shader;
 #if !defined(USE_OPENGL_ES)
@@ -103,6 +105,14 @@ void LuaWrapper::register_shader_program_types()
         render_shader_program["destroy_fragment_shader"] = &RenderShaderProgram::destroy_fragment_shader;
     }
 
+    {
+        sol::table shader_feature = state["ShaderFeature"].get_or_create<sol::table>();
+        shader_feature["NONE"] = ShaderFeature::NONE;
+        shader_feature["NORMAL_MAP"] = ShaderFeature::NORMAL_MAP;
+        shader_feature["ALPHA_TEST"] = ShaderFeature::ALPHA_TEST;
+        shader_feature["INSTANCING"] = ShaderFeature::INSTANCING;
+    }
+
     {
         sol::table image_texture_usage = state["ImageTextureUsage"].get_or_create<sol::table>();
         image_texture_usage["READ"] = ImageTextureUsage::READ;
@@ -111,6 +121,7 @@ void LuaWrapper::register_shader_program_types()
 
         sol::usertype<ShaderProgram> shader_program =
             state.new_usertype<ShaderProgram>("ShaderProgram", sol::no_constructor);
+        shader_program["is_shared"] = &ShaderProgram::is_shared;
         shader_program["has_attribute"] = [](ShaderProgram const& p, std::string const& n) {
             return p.has_attribute(n);
         };
@@ -180,6 +191,7 @@ void LuaWrapper::register_shader_program_types()
         shader_program["compile_shaders"] = &ShaderProgram::compile_shaders;
         shader_program["link"] = &ShaderProgram::link;
         shader_program["is_linked"] = &ShaderProgram::is_linked;
+        shader_program["is_link_completed"] = &ShaderProgram::is_link_completed;
         shader_program["update_shaders"] = &ShaderProgram::update_shaders;
         shader_program["use"] = &ShaderProgram::use;
         shader_program["is_used"] = &ShaderProgram::is_used;
@@ -10,6 +10,7 @@
 #include <utils/trigger_volume.hpp>
 #include <utils/type_utils.hpp>
 #include <utils/str_utils.hpp>
+#include <utils/virtual_file_system.hpp>
 
 #define SOL_ALL_SAFETIES_ON 1
 #include "sol/sol.hpp"
@@ -51,6 +52,15 @@ void LuaWrapper::register_utils_types()
         fileUtils["read_file_to_string"] = &FileUtils::read_file_to_string;
     }
 
+    {
+        sol::table virtualFileSystem = state["VirtualFileSystem"].get_or_create<sol::table>();
+        virtualFileSystem["mount"] = &VirtualFileSystem::mount;
+        virtualFileSystem["mount_pack"] = &VirtualFileSystem::mount_pack;
+        virtualFileSystem["unmount"] = &VirtualFileSystem::unmount;
+        virtualFileSystem["unmount_all"] = &VirtualFileSystem::unmount_all;
+        virtualFileSystem["resolve_path"] = &VirtualFileSystem::resolve_path;
+    }
+
     {
         // sol::table logger = state["Log"].get_or_create<sol::table>();
         // logger["error"] = &Log::error;
@@ -1,5 +1,6 @@
 #include "lua_wrapper.hpp"
 
+#include <utils/file_utils.hpp>
 #include <utils/filepath.hpp>
 
 #define SOL_ALL_SAFETIES_ON 1
@@ -90,10 +91,11 @@ bool LuaWrapper::execute_from_file(FilePath const& filepath)
 
     Log::debug("[LuaWrapper] Executing code from file ('" + filepath + "')...");
 
+    // The file is read through the virtual file system, & can thus be held by a mounted archive
     try {
-        get_state().script_file(filepath.to_utf8());
+        get_state().script(FileUtils::read_file_to_string(filepath), '@' + filepath.to_utf8());
     }
-    catch (sol::error const& err) {
+    catch (std::exception const& err) {
         Log::verror("[LuaWrapper] Error executing code from file: '{}.", err.what());
         return false;
     }
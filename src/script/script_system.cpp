@@ -1,6 +1,7 @@
 #include "script_system.hpp"
 
 #include <script/lua_script.hpp>
+#include <utils/file_watcher.hpp>
 
 #include <tracy/Tracy.hpp>
 
@@ -18,6 +19,8 @@ bool ScriptSystem::update(FrameTimeInfo const& time_info)
 
     ZoneScopedN("ScriptSystem::update");
 
+    update_outdated_scripts();
+
     bool res = true;
 
     for (Entity const* entity : entities) {
@@ -27,6 +30,28 @@ bool ScriptSystem::update(FrameTimeInfo const& time_info)
     return res;
 }
 
+void ScriptSystem::update_outdated_scripts()
+{
+    uint64_t const reload_count = FileWatcher::get_reload_count();
+
+    if (reload_count == checked_reload_count) {
+        return;
+    }
+
+    ZoneScopedN("ScriptSystem::update_outdated_scripts");
+
+    checked_reload_count = reload_count;
+
+    for (Entity* entity : entities) {
+        try {
+            entity->get_component<LuaScript>().update_code();
+        }
+        catch (std::exception const& exception) {
+            Log::vwarning("[ScriptSystem] Failed to update a script's code: {}", exception.what());
+        }
+    }
+}
+
 void ScriptSystem::link_entity(EntityPtr const& entity)
 {
     System::link_entity(entity);
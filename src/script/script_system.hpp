@@ -11,6 +11,15 @@ public:
     bool update(FrameTimeInfo const& time_info) override;
 
 private:
+    /// Number of reloads applied by the file watcher when the outdated scripts have last been checked for.
+    uint64_t checked_reload_count = 0;
+
+private:
+    /// Loads the code of the scripts whose file has been reloaded by the file watcher. A script failing to be loaded is
+    ///   reported, without stopping the others from being updated.
+    /// \see FileWatcher
+    void update_outdated_scripts();
+
     /// Links the entity to the system, registering the entity to the script and calling the script's setup function.
     /// \param entity Entity to be linked.
     void link_entity(EntityPtr const& entity) override;
@@ -1,6 +1,8 @@
 #include "file_utils.hpp"
 
 #include <utils/filepath.hpp>
+#include <utils/threading.hpp>
+#include <utils/virtual_file_system.hpp>
 
 #include <tracy/Tracy.hpp>
 
@@ -12,7 +14,20 @@ T read_file(FilePath const& filepath)
     ZoneScopedN("[FileUtils]::read_file");
     ZoneTextF("Path: %s", filepath.to_utf8().c_str());
 
-    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    VirtualFileSystem::FileLocation const location = VirtualFileSystem::locate(filepath);
+
+    // Packed files are directly read from the mapped archive, without opening any file
+    if (location.is_packed()) {
+        T file_content;
+        file_content.resize(static_cast<size_t>(location.entry->size));
+        location.pack->read_entry(
+            *location.entry, {reinterpret_cast<uint8_t*>(file_content.data()), file_content.size()}
+        );
+
+        return file_content;
+    }
+
+    std::ifstream file(location.disk_path, std::ios::binary | std::ios::ate);
 
     if (!file) {
         throw std::runtime_error("[FileUtils] Could not open the file '" + filepath + '\'');
@@ -40,7 +55,8 @@ T read_file(FilePath const& filepath)
 
 bool is_readable(FilePath const& filepath)
 {
-    return std::ifstream(filepath).good();
+    VirtualFileSystem::FileLocation const location = VirtualFileSystem::locate(filepath);
+    return (location.is_packed() || std::ifstream(location.disk_path).good());
 }
 
 std::vector<unsigned char> read_file_to_array(FilePath const& filepath)
@@ -56,4 +72,37 @@ std::string read_file_to_string(FilePath const& filepath)
     ZoneTextF("Path: %s", filepath.to_utf8().c_str());
     return read_file<std::string>(filepath);
 }
-}
\ No newline at end of file
+
+std::future<std::vector<uint8_t>> read_file_to_array_async(FilePath const& filepath)
+{
+    ZoneScopedN("FileUtils::read_file_to_array_async");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+    std::future<std::vector<uint8_t>> future = promise->get_future();
+
+    auto const read = [promise, filepath]() {
+        // Tasks must not throw; any exception is transmitted to the future instead
+        try {
+            promise->set_value(read_file<std::vector<uint8_t>>(filepath));
+        }
+        catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    };
+
+#if defined(XEN_THREADS_AVAILABLE) && !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
+    ThreadPool& thread_pool = get_default_thread_pool();
+
+    // Waiting from a task of the pool for the ones queued behind it could block all its threads forever
+    if (!thread_pool.is_current_thread_worker()) {
+        thread_pool.add_task(read);
+        return future;
+    }
+#endif
+
+    read();
+
+    return future;
+}
+}
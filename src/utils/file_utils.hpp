@@ -1,9 +1,12 @@
 #pragma once
 
+#include <future>
+
 namespace xen {
 
 class FilePath;
 
+/// Files are read through the VirtualFileSystem, & can thus be located in mounted directories or pack archives.
 namespace FileUtils {
 
 /// Checks if a file is readable (exists and can be opened).
@@ -22,5 +25,13 @@ std::vector<uint8_t> read_file_to_array(FilePath const& filepath);
 /// \param filepath Path to the file to read.
 /// \return Content of the file.
 std::string read_file_to_string(FilePath const& filepath);
+
+/// Reads a whole file into a byte array, in a task queued on the default thread pool. Many small files can thus be read
+///   concurrently, instead of waiting for each one in turn.
+/// \note If threads are unavailable, using Emscripten or if called from a task of the default thread pool, the file is
+///   read synchronously.
+/// \param filepath Path to the file to read.
+/// \return A std::future holding the content of the file, or the exception thrown while reading it.
+std::future<std::vector<uint8_t>> read_file_to_array_async(FilePath const& filepath);
 }
 }
\ No newline at end of file
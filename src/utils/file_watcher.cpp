@@ -0,0 +1,427 @@
+#include "file_watcher.hpp"
+
+#include <utils/filepath.hpp>
+#include <utils/threading.hpp>
+#include <utils/virtual_file_system.hpp>
+
+#if defined(XEN_IS_PLATFORM_LINUX)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <tracy/Tracy.hpp>
+
+#include <condition_variable>
+#include <filesystem>
+#include <optional>
+
+namespace xen::FileWatcher {
+namespace {
+using namespace std::chrono_literals;
+
+/// Interval between two checks of the files' modification time, when they cannot be watched with inotify.
+constexpr std::chrono::milliseconds polling_interval = 250ms;
+
+/// Time during which a file must not have been modified anymore before being reloaded. Saving a file often produces
+///   several successive events (creation, writes, renaming, ...), which must only trigger a single reload.
+constexpr std::chrono::milliseconds debounce_delay = 50ms;
+
+struct Watch {
+    FilePath filepath;
+    std::string canonical_path;
+    ReloadFunc reload;
+    uint64_t generation = 0;
+    std::filesystem::file_time_type last_write_time{};
+};
+
+struct PendingReload {
+    uint64_t watch_id{};
+    uint64_t generation{};
+    ApplyFunc apply;
+};
+
+struct WatcherThread {
+    std::thread thread;
+    std::mutex stop_mutex;
+    std::condition_variable stop_cond_var;
+    bool should_stop = false;
+
+    ~WatcherThread() { stop(); }
+
+    /// Waits for the given duration, unless the thread is asked to stop in the meantime.
+    /// \param duration Time to wait for.
+    /// \return True if the thread should stop, false otherwise.
+    bool wait_for(std::chrono::milliseconds duration)
+    {
+        std::unique_lock<std::mutex> lock(stop_mutex);
+        return stop_cond_var.wait_for(lock, duration, [this]() { return should_stop; });
+    }
+
+    bool is_stopping()
+    {
+        std::lock_guard<std::mutex> const lock(stop_mutex);
+        return should_stop;
+    }
+
+    void stop()
+    {
+        if (!thread.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> const lock(stop_mutex);
+            should_stop = true;
+        }
+
+        stop_cond_var.notify_all();
+        thread.join();
+    }
+};
+
+std::mutex watches_mutex;
+std::unordered_map<uint64_t, Watch> watches;
+uint64_t next_watch_id = 1;
+bool watches_changed = false;
+std::vector<PendingReload> pending_reloads;
+std::atomic<uint64_t> reload_count = 0;
+WatcherThread watcher_thread;
+
+std::string recover_canonical_path(FilePath const& filepath)
+{
+    std::error_code error;
+    std::filesystem::path canonical_path = std::filesystem::weakly_canonical(filepath.get_path(), error);
+
+    if (error) {
+        canonical_path = std::filesystem::absolute(filepath.get_path(), error);
+    }
+
+    return canonical_path.string();
+}
+
+std::filesystem::file_time_type recover_last_write_time(std::string const& path)
+{
+    std::error_code error;
+    std::filesystem::file_time_type const last_write_time = std::filesystem::last_write_time(path, error);
+    return (error ? std::filesystem::file_time_type{} : last_write_time);
+}
+
+/// Starts reloading the asset of a watch on the default thread pool; the reload will be applied at the next call to
+///   apply_reloads(), provided that no other one has been started for this watch in the meantime.
+/// \note The watches' mutex must be locked by the caller.
+/// \param watch_id Identifier of the watch.
+/// \param watch Watch to be reloaded.
+void start_reload(uint64_t watch_id, Watch& watch)
+{
+    Log::vdebug("[FileWatcher] '{}' has been modified, reloading...", watch.filepath.to_utf8());
+
+    uint64_t const generation = ++watch.generation;
+
+    get_default_thread_pool().add_task([watch_id, generation, reload = watch.reload, filepath = watch.filepath]() {
+        ZoneScopedN("[FileWatcher]::reload");
+
+        ApplyFunc apply;
+
+        try {
+            apply = reload();
+        }
+        catch (std::exception const& exception) {
+            Log::vwarning("[FileWatcher] Failed to reload '{}': {}", filepath.to_utf8(), exception.what());
+            return;
+        }
+
+        std::lock_guard<std::mutex> const lock(watches_mutex);
+        pending_reloads.emplace_back(PendingReload{watch_id, generation, std::move(apply)});
+    });
+}
+
+/// Starts reloading every watch of a file.
+/// \param canonical_path Canonical path to the modified file.
+void start_reloads(std::string const& canonical_path)
+{
+    std::lock_guard<std::mutex> const lock(watches_mutex);
+
+    for (auto& [watch_id, watch] : watches) {
+        if (watch.canonical_path == canonical_path) {
+            start_reload(watch_id, watch);
+        }
+    }
+}
+
+void poll_files()
+{
+    Log::debug("[FileWatcher] Watching files by polling their modification time");
+
+    while (!watcher_thread.wait_for(polling_interval)) {
+        ZoneScopedN("[FileWatcher]::poll_files");
+
+        std::lock_guard<std::mutex> const lock(watches_mutex);
+
+        for (auto& [watch_id, watch] : watches) {
+            std::filesystem::file_time_type const last_write_time = recover_last_write_time(watch.canonical_path);
+
+            // A file which does not exist (anymore) is reloaded once it is (re)created
+            if (last_write_time == watch.last_write_time || last_write_time == std::filesystem::file_time_type{}) {
+                continue;
+            }
+
+            watch.last_write_time = last_write_time;
+            start_reload(watch_id, watch);
+        }
+    }
+}
+
+#if defined(XEN_IS_PLATFORM_LINUX)
+/// Watches the directories containing the watched files with inotify; watching the directories instead of the files
+///   themselves allows detecting files replaced by renaming, as many editors save them.
+/// \param inotify_fd File descriptor of the inotify instance; closed once the thread stops.
+void watch_directories(int inotify_fd)
+{
+    Log::debug("[FileWatcher] Watching files with inotify");
+
+    std::unordered_map<std::string, int> directory_descriptors;
+    std::unordered_map<int, std::string> watched_directories;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> modified_files;
+
+    // Events are variable-sized, the buffer holding at least one event with the longest possible name
+    alignas(inotify_event) std::array<char, 4096> event_buffer{};
+
+    while (!watcher_thread.is_stopping()) {
+        std::optional<std::unordered_set<std::string>> directories;
+
+        {
+            std::lock_guard<std::mutex> const lock(watches_mutex);
+
+            if (std::exchange(watches_changed, false)) {
+                directories.emplace();
+
+                for (auto const& [watch_id, watch] : watches) {
+                    directories->emplace(std::filesystem::path(watch.canonical_path).parent_path().string());
+                }
+            }
+        }
+
+        if (directories) {
+            ZoneScopedN("[FileWatcher]::update_directories");
+
+            for (auto directory_iter = directory_descriptors.begin(); directory_iter != directory_descriptors.end();) {
+                if (directories->contains(directory_iter->first)) {
+                    ++directory_iter;
+                    continue;
+                }
+
+                inotify_rm_watch(inotify_fd, directory_iter->second);
+                watched_directories.erase(directory_iter->second);
+                directory_iter = directory_descriptors.erase(directory_iter);
+            }
+
+            for (std::string const& directory : *directories) {
+                if (directory_descriptors.contains(directory)) {
+                    continue;
+                }
+
+                int const descriptor =
+                    inotify_add_watch(inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+
+                if (descriptor < 0) {
+                    Log::vwarning("[FileWatcher] Failed to watch the directory '{}'", directory);
+                    continue;
+                }
+
+                directory_descriptors.emplace(directory, descriptor);
+                watched_directories.emplace(descriptor, directory);
+            }
+        }
+
+        pollfd poll_fd{inotify_fd, POLLIN, 0};
+
+        if (poll(&poll_fd, 1, 100) > 0 && (poll_fd.revents & POLLIN)) {
+            ssize_t const byte_count = read(inotify_fd, event_buffer.data(), event_buffer.size());
+            auto const now = std::chrono::steady_clock::now();
+
+            for (ssize_t event_offset = 0; event_offset < byte_count;) {
+                auto const* event = reinterpret_cast<inotify_event const*>(event_buffer.data() + event_offset);
+                event_offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                auto const directory_iter = watched_directories.find(event->wd);
+
+                if (event->len == 0 || directory_iter == watched_directories.end()) {
+                    continue;
+                }
+
+                modified_files[(std::filesystem::path(directory_iter->second) / event->name).string()] = now;
+            }
+        }
+
+        auto const now = std::chrono::steady_clock::now();
+
+        for (auto file_iter = modified_files.begin(); file_iter != modified_files.end();) {
+            if (now - file_iter->second < debounce_delay) {
+                ++file_iter;
+                continue;
+            }
+
+            start_reloads(file_iter->first);
+            file_iter = modified_files.erase(file_iter);
+        }
+    }
+
+    close(inotify_fd);
+}
+#endif
+}
+
+void enable(bool enabled)
+{
+    if (!enabled) {
+        disable();
+        return;
+    }
+
+#if defined(XEN_THREADS_AVAILABLE) && !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
+    if (watcher_thread.thread.joinable()) {
+        return;
+    }
+
+    ZoneScopedN("FileWatcher::enable");
+
+    Log::debug("[FileWatcher] Enabling...");
+
+    {
+        std::lock_guard<std::mutex> const lock(watches_mutex);
+
+        // The modification times are checked anew, ignoring the modifications made while disabled
+        for (auto& [watch_id, watch] : watches) {
+            watch.last_write_time = recover_last_write_time(watch.canonical_path);
+        }
+
+        watches_changed = true;
+    }
+
+    watcher_thread.should_stop = false;
+
+#if defined(XEN_IS_PLATFORM_LINUX)
+    int const inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (inotify_fd >= 0) {
+        watcher_thread.thread = std::thread(watch_directories, inotify_fd);
+    }
+    else {
+        Log::warning("[FileWatcher] Failed to initialize inotify; falling back to polling");
+        watcher_thread.thread = std::thread(poll_files);
+    }
+#else
+    watcher_thread.thread = std::thread(poll_files);
+#endif
+
+    Log::debug("[FileWatcher] Enabled");
+#else
+    Log::warning("[FileWatcher] Files cannot be watched on this platform");
+#endif
+}
+
+void disable()
+{
+    if (!watcher_thread.thread.joinable()) {
+        return;
+    }
+
+    ZoneScopedN("FileWatcher::disable");
+
+    watcher_thread.stop();
+
+    Log::debug("[FileWatcher] Disabled");
+}
+
+bool is_enabled()
+{
+    return watcher_thread.thread.joinable();
+}
+
+uint64_t watch(FilePath const& filepath, ReloadFunc reload)
+{
+    ZoneScopedN("FileWatcher::watch");
+
+    if (!reload) {
+        throw std::invalid_argument("[FileWatcher] The reload function of a watch cannot be empty.");
+    }
+
+    // The file found on disk through the virtual file system is watched; files held by archives are never modified
+    Watch watch{filepath, recover_canonical_path(VirtualFileSystem::resolve_path(filepath)), std::move(reload)};
+    watch.last_write_time = recover_last_write_time(watch.canonical_path);
+
+    std::lock_guard<std::mutex> const lock(watches_mutex);
+
+    uint64_t const watch_id = next_watch_id++;
+    watches.emplace(watch_id, std::move(watch));
+    watches_changed = true;
+
+    return watch_id;
+}
+
+void unwatch(uint64_t watch_id)
+{
+    std::lock_guard<std::mutex> const lock(watches_mutex);
+
+    if (watches.erase(watch_id) != 0) {
+        watches_changed = true;
+    }
+}
+
+void apply_reloads()
+{
+    std::vector<PendingReload> reloads;
+
+    {
+        std::lock_guard<std::mutex> const lock(watches_mutex);
+
+        if (pending_reloads.empty()) {
+            return;
+        }
+
+        reloads = std::move(pending_reloads);
+        pending_reloads.clear();
+    }
+
+    ZoneScopedN("FileWatcher::apply_reloads");
+
+    for (PendingReload& reload : reloads) {
+        FilePath filepath;
+
+        {
+            std::lock_guard<std::mutex> const lock(watches_mutex);
+
+            // The reload is discarded if its watch has been removed, or if a more recent one has been started
+            auto const watch_iter = watches.find(reload.watch_id);
+
+            if (watch_iter == watches.end() || watch_iter->second.generation != reload.generation) {
+                continue;
+            }
+
+            filepath = watch_iter->second.filepath;
+        }
+
+        if (reload.apply) {
+            try {
+                reload.apply();
+            }
+            catch (std::exception const& exception) {
+                Log::vwarning(
+                    "[FileWatcher] Failed to apply the reload of '{}': {}", filepath.to_utf8(), exception.what()
+                );
+                continue;
+            }
+        }
+
+        ++reload_count;
+
+        Log::vdebug("[FileWatcher] Reloaded '{}'", filepath.to_utf8());
+    }
+}
+
+uint64_t get_reload_count()
+{
+    return reload_count;
+}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+
+namespace xen {
+class FilePath;
+
+/// File watching service, reloading assets whenever their files are modified. A reload happens in two steps: the
+///   function given when watching a file is executed on the default thread pool, where the file can be read & decoded;
+///   the function it returns is then executed on the main thread at the next frame boundary, to swap the reloaded asset
+///   in (e.g. sending it to the graphics card).
+/// Files are watched with inotify on Linux, & by polling their modification time on other platforms.
+/// \note Watching is disabled by default. It is unavailable without threads, & on Emscripten.
+/// \see Application::run_once()
+namespace FileWatcher {
+/// Function swapping a reloaded asset in, executed on the main thread. May be empty if there is nothing to swap.
+using ApplyFunc = std::function<void()>;
+
+/// Function reloading an asset from its modified file, executed on a worker thread. Any exception it throws is logged,
+///   the asset being left unchanged.
+using ReloadFunc = std::function<ApplyFunc()>;
+
+/// Starts or stops watching the files. Files can be registered either way, their changes only being detected while
+///   enabled.
+/// \param enabled True to watch the registered files, false otherwise.
+void enable(bool enabled = true);
+
+void disable();
+
+[[nodiscard]] bool is_enabled();
+
+/// Registers a file to be watched.
+/// \note A reload started while another one of the same watch is running supersedes it; only the latest is applied.
+/// \param filepath Path to the file to be watched. It does not have to exist yet; if located in a mounted directory,
+///   the file on disk is watched.
+/// \param reload Function reloading the asset, called every time the file has been modified.
+/// \return Identifier of the watch, to be given to unwatch().
+uint64_t watch(FilePath const& filepath, ReloadFunc reload);
+
+/// Stops watching a file. Reloads of this watch that are still running or pending are discarded.
+/// \param watch_id Identifier of the watch, returned by watch().
+void unwatch(uint64_t watch_id);
+
+/// Executes on the calling thread the functions swapping in the assets reloaded since the last call. Called at the
+///   beginning of each frame by the application.
+void apply_reloads();
+
+/// Gets the number of reloads applied so far. This allows systems to cheaply check, every frame, whether they have to
+///   look for reloaded assets.
+/// \return Number of applied reloads.
+[[nodiscard]] uint64_t get_reload_count();
+}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+namespace xen::Hash {
+constexpr uint64_t fnv1a_offset_basis = 14695981039346656037ull;
+constexpr uint64_t fnv1a_prime = 1099511628211ull;
+
+/// Computes a 64-bit FNV-1a hash of the given bytes.
+/// \param data Bytes to be hashed.
+/// \param data_size Number of bytes to be hashed.
+/// \param seed Initial hash value; can be given a previous result to hash several chunks as a whole.
+/// \return Hash of the bytes.
+constexpr uint64_t compute_fnv1a(uint8_t const* data, size_t data_size, uint64_t seed = fnv1a_offset_basis)
+{
+    uint64_t hash = seed;
+
+    for (size_t byte_index = 0; byte_index < data_size; ++byte_index) {
+        hash ^= data[byte_index];
+        hash *= fnv1a_prime;
+    }
+
+    return hash;
+}
+
+/// Computes a 64-bit FNV-1a hash of the given value's bytes.
+/// \tparam T Type of the value to be hashed. Must be trivially copyable.
+/// \param value Value to be hashed.
+/// \param seed Initial hash value; can be given a previous result to hash several values as a whole.
+/// \return Hash of the value.
+template <typename T>
+uint64_t compute_fnv1a(T const& value, uint64_t seed = fnv1a_offset_basis)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Error: Only trivially copyable values can be hashed bytewise.");
+    return compute_fnv1a(reinterpret_cast<uint8_t const*>(&value), sizeof(T), seed);
+}
+
+/// Converts a hash to a fixed-length hexadecimal string, usable as a file name.
+/// \param hash Hash to be converted.
+/// \return 16-character hexadecimal representation of the hash.
+inline std::string to_hex_string(uint64_t hash)
+{
+    constexpr std::string_view hex_digits = "0123456789abcdef";
+
+    std::string hex_string(16, '0');
+
+    for (size_t digit_index = 0; digit_index < 16; ++digit_index) {
+        hex_string[15 - digit_index] = hex_digits[(hash >> (digit_index * 4)) & 0xF];
+    }
+
+    return hex_string;
+}
+}
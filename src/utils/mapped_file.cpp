@@ -0,0 +1,175 @@
+#include "mapped_file.hpp"
+
+#include <utils/filepath.hpp>
+#include <utils/virtual_file_system.hpp>
+
+#if defined(XEN_IS_PLATFORM_WINDOWS)
+#if defined(XEN_IS_COMPILER_MSVC)
+struct IUnknown; // Workaround for "combaseapi.h(229): error C2187: syntax error: 'identifier' was unexpected here" when
+                 // using /permissive-
+#endif
+
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <tracy/Tracy.hpp>
+
+namespace xen {
+MappedFile& MappedFile::operator=(MappedFile&& mapped_file) noexcept
+{
+    if (this == &mapped_file) {
+        return *this;
+    }
+
+    close();
+
+    mapped_data = std::exchange(mapped_file.mapped_data, nullptr);
+    mapped_size = std::exchange(mapped_file.mapped_size, 0);
+    data_owner = std::move(mapped_file.data_owner);
+#if defined(XEN_IS_PLATFORM_WINDOWS)
+    file_handle = std::exchange(mapped_file.file_handle, nullptr);
+    mapping_handle = std::exchange(mapped_file.mapping_handle, nullptr);
+#endif
+
+    return *this;
+}
+
+void MappedFile::open(FilePath const& filepath)
+{
+    ZoneScopedN("MappedFile::open");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    close();
+
+    VirtualFileSystem::FileLocation location = VirtualFileSystem::locate(filepath);
+
+    if (location.is_packed()) {
+        PackFile::Entry const& entry = *location.entry;
+
+        // Uncompressed entries are viewed in place, the archive being kept mapped as long as they are
+        if (entry.compression == PackCompression::NONE) {
+            std::span<uint8_t const> const stored_data = location.pack->get_stored_data(entry);
+            *this = MappedFile(stored_data, std::move(location.pack));
+            return;
+        }
+
+        auto content = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(entry.size));
+        location.pack->read_entry(entry, *content);
+
+        std::span<uint8_t const> const content_data(*content);
+        *this = MappedFile(content_data, std::move(content));
+        return;
+    }
+
+    FilePath const& disk_path = location.disk_path;
+
+#if defined(XEN_IS_PLATFORM_WINDOWS)
+    file_handle = CreateFileW(
+        disk_path.to_wide().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        file_handle = nullptr;
+        throw std::runtime_error("[MappedFile] Could not open the file '" + filepath + '\'');
+    }
+
+    LARGE_INTEGER file_size{};
+
+    if (!GetFileSizeEx(file_handle, &file_size)) {
+        close();
+        throw std::runtime_error("[MappedFile] Failed to get the size of the file '" + filepath + '\'');
+    }
+
+    if (file_size.QuadPart == 0) {
+        return; // Empty files cannot be mapped; the object is simply left empty
+    }
+
+    mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping_handle == nullptr) {
+        close();
+        throw std::runtime_error("[MappedFile] Failed to map the file '" + filepath + '\'');
+    }
+
+    mapped_data = static_cast<uint8_t const*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+    if (mapped_data == nullptr) {
+        close();
+        throw std::runtime_error("[MappedFile] Failed to map the file '" + filepath + '\'');
+    }
+
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+#else
+    int const file_descriptor = ::open(disk_path.to_utf8().c_str(), O_RDONLY);
+
+    if (file_descriptor == -1) {
+        throw std::runtime_error("[MappedFile] Could not open the file '" + filepath + '\'');
+    }
+
+    struct stat file_stats {};
+
+    if (fstat(file_descriptor, &file_stats) == -1) {
+        ::close(file_descriptor);
+        throw std::runtime_error("[MappedFile] Failed to get the size of the file '" + filepath + '\'');
+    }
+
+    if (file_stats.st_size == 0) {
+        ::close(file_descriptor);
+        return; // Empty files cannot be mapped; the object is simply left empty
+    }
+
+    void* const mapping =
+        mmap(nullptr, static_cast<size_t>(file_stats.st_size), PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+
+    // The mapping remains valid after the file descriptor has been closed
+    ::close(file_descriptor);
+
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("[MappedFile] Failed to map the file '" + filepath + '\'');
+    }
+
+    mapped_data = static_cast<uint8_t const*>(mapping);
+    mapped_size = static_cast<size_t>(file_stats.st_size);
+#endif
+}
+
+void MappedFile::close()
+{
+    if (data_owner != nullptr) {
+        // Views have nothing to unmap; the data is released along with its owner if no other view uses it
+        data_owner.reset();
+        mapped_data = nullptr;
+        mapped_size = 0;
+        return;
+    }
+
+#if defined(XEN_IS_PLATFORM_WINDOWS)
+    if (mapped_data != nullptr) {
+        UnmapViewOfFile(mapped_data);
+    }
+
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+        mapping_handle = nullptr;
+    }
+
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+        file_handle = nullptr;
+    }
+#else
+    if (mapped_data != nullptr) {
+        munmap(const_cast<uint8_t*>(mapped_data), mapped_size);
+    }
+#endif
+
+    mapped_data = nullptr;
+    mapped_size = 0;
+}
+}
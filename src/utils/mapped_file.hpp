@@ -0,0 +1,57 @@
+#pragma once
+
+#include <span>
+
+namespace xen {
+class FilePath;
+
+/// Read-only memory-mapped file. The file's content is directly accessible through data() as long as the object lives,
+/// without being copied into an intermediate buffer.
+/// Files are located through the VirtualFileSystem; those held by a pack archive are views on the archive's mapping,
+///   or on their decompressed content.
+class MappedFile {
+public:
+    MappedFile() = default;
+    /// Maps the given file into memory.
+    /// \param filepath Path to the file to be mapped.
+    explicit MappedFile(FilePath const& filepath) { open(filepath); }
+    /// Creates a view on data already in memory, which is kept alive by the given owner as long as the view exists.
+    /// \param data Data to be viewed.
+    /// \param data_owner Object owning the data.
+    MappedFile(std::span<uint8_t const> data, std::shared_ptr<void const> data_owner)
+        : mapped_data{data.data()}, mapped_size{data.size()}, data_owner{std::move(data_owner)} {}
+    MappedFile(MappedFile const&) = delete;
+    MappedFile(MappedFile&& mapped_file) noexcept { *this = std::move(mapped_file); }
+
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile&& mapped_file) noexcept;
+
+    ~MappedFile() { close(); }
+
+    [[nodiscard]] uint8_t const* data() const { return mapped_data; }
+
+    [[nodiscard]] size_t size() const { return mapped_size; }
+
+    /// Checks if the file is mapped and has content.
+    /// \return True if no data is mapped, false otherwise.
+    [[nodiscard]] bool empty() const { return (mapped_size == 0); }
+
+    /// Maps the given file into memory, unmapping any previously mapped one.
+    /// \param filepath Path to the file to be mapped.
+    void open(FilePath const& filepath);
+
+    /// Unmaps the current file, if any, or releases the viewed data.
+    void close();
+
+private:
+    uint8_t const* mapped_data{};
+    size_t mapped_size{};
+    /// Owner of the viewed data, if not mapped by this object.
+    std::shared_ptr<void const> data_owner{};
+
+#if defined(XEN_IS_PLATFORM_WINDOWS)
+    void* file_handle{};
+    void* mapping_handle{};
+#endif
+};
+}
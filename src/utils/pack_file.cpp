@@ -0,0 +1,289 @@
+#include "pack_file.hpp"
+
+#include <data/lz4.hpp>
+#include <utils/file_utils.hpp>
+#include <utils/filepath.hpp>
+#include <utils/threading.hpp>
+
+#include <tracy/Tracy.hpp>
+
+#include <filesystem>
+
+namespace xen {
+namespace {
+constexpr std::array<char, 4> pack_magic = {'X', 'P', 'A', 'K'};
+constexpr size_t entry_alignment = 64;
+/// Highest ratio LZ4 can reach between decompressed & compressed data, bounding the size of an LZ4 entry.
+constexpr uint64_t max_lz4_ratio = 255;
+
+struct Header {
+    std::array<char, 4> magic{};
+    uint32_t version{};
+    uint64_t entry_count{};
+    uint64_t index_offset{};
+    uint64_t index_size{};
+};
+
+template <typename T>
+void write_value(std::vector<uint8_t>& buffer, T const& value)
+{
+    auto const* bytes = reinterpret_cast<uint8_t const*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+class Reader {
+public:
+    explicit Reader(std::span<uint8_t const> file_data) : data{file_data} {}
+
+    template <typename T>
+    T read_value()
+    {
+        T value{};
+        read_bytes(&value, sizeof(T));
+        return value;
+    }
+
+    std::string read_string()
+    {
+        std::string value(read_value<uint32_t>(), '\0');
+        read_bytes(value.data(), value.size());
+        return value;
+    }
+
+    void read_bytes(void* bytes, size_t byte_count)
+    {
+        if (byte_count > data.size() - offset) {
+            throw std::invalid_argument("[PackFile] Unexpected end of file");
+        }
+
+        std::memcpy(bytes, data.data() + offset, byte_count);
+        offset += byte_count;
+    }
+
+private:
+    std::span<uint8_t const> data;
+    size_t offset = 0;
+};
+
+struct PackedFile {
+    std::string path;
+    std::vector<uint8_t> data;
+    PackFile::Entry entry;
+};
+
+/// Reads a file to be stored in an archive, compressing it if asked to & if doing so saves at least an eighth of its
+///   size; small or already compressed files (e.g. PNG images) are otherwise not worth decompressing when loaded.
+/// \param filepath Path to the file to be read.
+/// \param compression Compression to be applied.
+/// \param packed_file File to be stored.
+void pack_file(FilePath const& filepath, PackCompression compression, PackedFile& packed_file)
+{
+    ZoneScopedN("[PackFile]::pack_file");
+
+    packed_file.data = FileUtils::read_file_to_array(filepath);
+    packed_file.entry.size = packed_file.data.size();
+    packed_file.entry.compression = PackCompression::NONE;
+
+    if (compression != PackCompression::LZ4) {
+        return;
+    }
+
+    std::vector<uint8_t> block = Lz4::compress(packed_file.data);
+
+    if (block.size() < packed_file.data.size() - packed_file.data.size() / 8) {
+        packed_file.data = std::move(block);
+        packed_file.entry.compression = PackCompression::LZ4;
+    }
+}
+}
+
+void PackFile::open(FilePath const& filepath)
+{
+    ZoneScopedN("PackFile::open");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[PackFile] Opening '" + filepath + "'...");
+
+    entries.clear();
+    file.open(filepath);
+
+    // The archive is closed if it turns out to be invalid
+    try {
+        Reader header_reader({file.data(), file.size()});
+        auto const header = header_reader.read_value<Header>();
+
+        if (header.magic != pack_magic) {
+            throw std::invalid_argument("[PackFile] '" + filepath + "' is not a pack file");
+        }
+
+        if (header.version != version) {
+            throw std::invalid_argument(
+                "[PackFile] '" + filepath + "' has an unsupported version (" + std::to_string(header.version) + ')'
+            );
+        }
+
+        if (header.index_offset > file.size() || header.index_size > file.size() - header.index_offset) {
+            throw std::invalid_argument("[PackFile] '" + filepath + "' has an invalid index");
+        }
+
+        Reader index_reader({file.data() + header.index_offset, static_cast<size_t>(header.index_size)});
+        entries.reserve(static_cast<size_t>(header.entry_count));
+
+        for (uint64_t entry_index = 0; entry_index < header.entry_count; ++entry_index) {
+            std::string path = index_reader.read_string();
+
+            Entry entry;
+            entry.offset = index_reader.read_value<uint64_t>();
+            entry.stored_size = index_reader.read_value<uint64_t>();
+            entry.size = index_reader.read_value<uint64_t>();
+            entry.compression = index_reader.read_value<PackCompression>();
+
+            if (entry.offset > header.index_offset || entry.stored_size > header.index_offset - entry.offset ||
+                entry.compression > PackCompression::LZ4 ||
+                (entry.compression == PackCompression::NONE && entry.size != entry.stored_size) ||
+                (entry.compression == PackCompression::LZ4 && entry.size > entry.stored_size * max_lz4_ratio)) {
+                throw std::invalid_argument("[PackFile] '" + filepath + "' has an invalid entry ('" + path + "')");
+            }
+
+            entries.emplace(std::move(path), entry);
+        }
+    }
+    catch (...) {
+        entries.clear();
+        file.close();
+        throw;
+    }
+
+    Log::vdebug("[PackFile] Opened ({} entries)", entries.size());
+}
+
+PackFile::Entry const* PackFile::find_entry(std::string const& path) const
+{
+    auto const entry_iter = entries.find(path);
+    return (entry_iter != entries.cend() ? &entry_iter->second : nullptr);
+}
+
+std::span<uint8_t const> PackFile::get_stored_data(Entry const& entry) const
+{
+    return {file.data() + entry.offset, static_cast<size_t>(entry.stored_size)};
+}
+
+void PackFile::read_entry(Entry const& entry, std::span<uint8_t> data) const
+{
+    ZoneScopedN("PackFile::read_entry");
+
+    if (data.size() != entry.size) {
+        throw std::invalid_argument("[PackFile] The buffer to read an entry into must have the entry's size");
+    }
+
+    std::span<uint8_t const> const stored_data = get_stored_data(entry);
+
+    switch (entry.compression) {
+    case PackCompression::NONE:
+        if (stored_data.size() != data.size()) {
+            throw std::invalid_argument("[PackFile] The stored size of an uncompressed entry must be its size");
+        }
+
+        if (!data.empty()) {
+            std::memcpy(data.data(), stored_data.data(), stored_data.size());
+        }
+
+        break;
+
+    case PackCompression::LZ4:
+        Lz4::decompress(stored_data, data);
+        break;
+    }
+}
+
+void PackFile::create(FilePath const& filepath, FilePath const& directory, PackCompression compression)
+{
+    ZoneScopedN("PackFile::create");
+    ZoneTextF("Path: %s", filepath.to_utf8().c_str());
+
+    Log::debug("[PackFile] Creating '" + filepath + "' from the directory '" + directory + "'...");
+
+    std::filesystem::path const directory_path(directory.get_path());
+    std::vector<std::filesystem::path> file_paths;
+
+    for (std::filesystem::directory_entry const& directory_entry :
+         std::filesystem::recursive_directory_iterator(directory_path)) {
+        if (directory_entry.is_regular_file()) {
+            file_paths.emplace_back(directory_entry.path());
+        }
+    }
+
+    // Sorting the files makes the archive's content deterministic, & keeps files of the same directory close together
+    std::sort(file_paths.begin(), file_paths.end());
+
+    std::vector<PackedFile> packed_files(file_paths.size());
+    std::vector<std::exception_ptr> exceptions(file_paths.size());
+
+    for (size_t file_index = 0; file_index < file_paths.size(); ++file_index) {
+        packed_files[file_index].path = file_paths[file_index].lexically_relative(directory_path).generic_string();
+    }
+
+    if (!file_paths.empty()) {
+        parallelize(
+            0u, file_paths.size(),
+            [&file_paths, &packed_files, &exceptions, compression](IndexRange const& range) {
+                for (size_t file_index = range.begin_index; file_index < range.end_index; ++file_index) {
+                    // Tasks must not throw; the first exception is rethrown once all files have been packed
+                    try {
+                        pack_file(file_paths[file_index].native(), compression, packed_files[file_index]);
+                    }
+                    catch (...) {
+                        exceptions[file_index] = std::current_exception();
+                    }
+                }
+            },
+            static_cast<uint32_t>(std::min<size_t>(file_paths.size(), get_system_thread_count()))
+        );
+    }
+
+    for (std::exception_ptr const& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    std::vector<uint8_t> buffer;
+    buffer.resize(sizeof(Header));
+
+    for (PackedFile& packed_file : packed_files) {
+        buffer.resize((buffer.size() + entry_alignment - 1) / entry_alignment * entry_alignment);
+
+        packed_file.entry.offset = buffer.size();
+        packed_file.entry.stored_size = packed_file.data.size();
+        buffer.insert(buffer.end(), packed_file.data.begin(), packed_file.data.end());
+
+        // The file's data is no longer needed once copied
+        packed_file.data = {};
+    }
+
+    Header header{pack_magic, version, packed_files.size(), buffer.size(), 0};
+
+    for (PackedFile const& packed_file : packed_files) {
+        write_value(buffer, static_cast<uint32_t>(packed_file.path.size()));
+        buffer.insert(buffer.end(), packed_file.path.begin(), packed_file.path.end());
+        write_value(buffer, packed_file.entry.offset);
+        write_value(buffer, packed_file.entry.stored_size);
+        write_value(buffer, packed_file.entry.size);
+        write_value(buffer, packed_file.entry.compression);
+    }
+
+    header.index_size = buffer.size() - header.index_offset;
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+
+    {
+        std::ofstream file(filepath, std::ios_base::binary);
+        file.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+        if (!file) {
+            throw std::runtime_error("[PackFile] Failed to write '" + filepath + '\'');
+        }
+    }
+
+    Log::vdebug("[PackFile] Created ({} entries, {} bytes)", packed_files.size(), buffer.size());
+}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <utils/mapped_file.hpp>
+
+#include <span>
+
+namespace xen {
+class FilePath;
+
+enum class PackCompression : uint8_t {
+    NONE = 0, ///< Entries are stored as is, & can be accessed in place.
+    LZ4       ///< Entries are compressed in the LZ4 block format, unless doing so does not save enough space.
+};
+
+/// Read-only archive holding many files, to avoid opening each of them separately. The archive is memory-mapped, &
+///   its index read once when opened.
+/// The file starts with a header, followed by the entries' data, each one aligned on 64 bytes so that it can be
+///   accessed in place, & ends with the index of the entries, giving their path, position, size & compression.
+/// \see VirtualFileSystem::mount_pack()
+class PackFile {
+public:
+    /// Position & size of a file held by the archive.
+    struct Entry {
+        uint64_t offset{};      ///< Offset of the entry's data from the beginning of the archive.
+        uint64_t stored_size{}; ///< Size of the data stored in the archive, which may be compressed.
+        uint64_t size{};        ///< Size of the original file.
+        PackCompression compression = PackCompression::NONE;
+    };
+
+    static constexpr uint32_t version = 1;
+
+    PackFile() = default;
+    /// Opens an archive.
+    /// \param filepath Path to the archive to be opened.
+    explicit PackFile(FilePath const& filepath) { open(filepath); }
+
+    [[nodiscard]] size_t get_entry_count() const { return entries.size(); }
+
+    [[nodiscard]] std::unordered_map<std::string, Entry> const& get_entries() const { return entries; }
+
+    /// Opens an archive, closing the previously opened one if any.
+    /// \param filepath Path to the archive to be opened.
+    /// \throws std::invalid_argument If the file is not a valid archive.
+    void open(FilePath const& filepath);
+
+    /// Finds an entry.
+    /// \param path Path of the entry relative to the archive's root, with forward slashes as separators.
+    /// \return Entry if found, nullptr otherwise.
+    [[nodiscard]] Entry const* find_entry(std::string const& path) const;
+
+    /// Gets the data of an entry as stored in the archive, which is the entry's content itself if not compressed.
+    /// \param entry Entry to get the data of.
+    /// \return Stored data, directly pointing into the mapped archive.
+    [[nodiscard]] std::span<uint8_t const> get_stored_data(Entry const& entry) const;
+
+    /// Reads the content of an entry, decompressing it if needed.
+    /// \param entry Entry to be read.
+    /// \param data Buffer to read the entry into; must have the entry's size.
+    void read_entry(Entry const& entry, std::span<uint8_t> data) const;
+
+    /// Creates an archive holding all the files of a directory & its subdirectories. Files are compressed in parallel
+    ///   on the default thread pool.
+    /// \param filepath Path to the archive to be created.
+    /// \param directory Directory whose files are to be stored; their paths in the archive are relative to it.
+    /// \param compression Compression to be applied to the entries.
+    static void create(
+        FilePath const& filepath, FilePath const& directory, PackCompression compression = PackCompression::LZ4
+    );
+
+private:
+    MappedFile file{};
+    std::unordered_map<std::string, Entry> entries{};
+};
+}
@@ -6,6 +6,11 @@
 #include <tracy/Tracy.hpp>
 
 namespace xen {
+namespace {
+/// Pool owning the current thread, if any.
+thread_local ThreadPool const* current_thread_pool = nullptr;
+}
+
 ThreadPool::ThreadPool() : ThreadPool(get_system_thread_count()) {}
 
 ThreadPool::ThreadPool(uint32_t thread_count)
@@ -28,6 +33,8 @@ ThreadPool::ThreadPool(uint32_t thread_count)
             tracy::SetThreadName(thread_name.c_str());
 #endif
 
+            current_thread_pool = this;
+
             std::function<void()> task;
 
             while (true) {
@@ -51,6 +58,11 @@ ThreadPool::ThreadPool(uint32_t thread_count)
     Log::debug("[ThreadPool] Initialized");
 }
 
+bool ThreadPool::is_current_thread_worker() const
+{
+    return (current_thread_pool == this);
+}
+
 void ThreadPool::add_task(std::function<void()> task)
 {
     {
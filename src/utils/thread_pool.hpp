@@ -20,6 +20,11 @@ public:
 
     void add_task(std::function<void()> task);
 
+    /// Checks if the current thread is one of the pool's. A task waiting for other tasks of the same pool may block
+    ///   forever if all the threads are doing the same, & should thus run them itself instead.
+    /// \return True if called from a task executed by the pool, false otherwise.
+    [[nodiscard]] bool is_current_thread_worker() const;
+
 private:
     std::vector<std::thread> threads{};
     bool should_stop = false;
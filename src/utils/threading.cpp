@@ -18,6 +18,15 @@ void parallelize(std::function<void()> const& action, uint32_t task_count)
 #if !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
     ThreadPool& thread_pool = get_default_thread_pool();
 
+    // Waiting from a task of the pool for the ones queued behind it could block all its threads forever
+    if (thread_pool.is_current_thread_worker()) {
+        for (uint32_t task_index = 0; task_index < task_count; ++task_index) {
+            action();
+        }
+
+        return;
+    }
+
     std::vector<std::promise<void>> promises;
     promises.resize(task_count);
 
@@ -45,6 +54,15 @@ void parallelize(std::initializer_list<std::function<void()>> actions)
 #if !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
     ThreadPool& thread_pool = get_default_thread_pool();
 
+    // Waiting from a task of the pool for the ones queued behind it could block all its threads forever
+    if (thread_pool.is_current_thread_worker()) {
+        for (std::function<void()> const& action : actions) {
+            action();
+        }
+
+        return;
+    }
+
     std::vector<std::promise<void>> promises;
     promises.resize(actions.size());
 
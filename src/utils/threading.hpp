@@ -68,18 +68,21 @@ template <typename FuncT, typename... Args, typename ResultT = std::invoke_resul
 
 /// Calls a function in parallel.
 /// \note If using Emscripten this call will be synchronous, threads being unsupported with it for now.
+/// \note If called from a task of the default thread pool, this call will be synchronous as well.
 /// \param action Action to be performed in parallel.
 /// \param task_count Amount of tasks to start.
 void parallelize(std::function<void()> const& action, uint32_t task_count = get_system_thread_count());
 
 /// Calls the given functions in parallel.
 /// \note If using Emscripten this call will be synchronous, threads being unsupported with it for now.
+/// \note If called from a task of the default thread pool, this call will be synchronous as well.
 /// \param actions Actions to be performed in parallel.
 void parallelize(std::initializer_list<std::function<void()>> actions);
 
 /// Calls a function in parallel over an index range.
 /// The given index range is automatically split, providing a separate start/past-the-end index sub-range to each task.
 /// \note If using Emscripten this call will be synchronous, threads being unsupported with it for now.
+/// \note If called from a task of the default thread pool, this call will be synchronous as well.
 /// \tparam BegIndexT Type of the begin index.
 /// \tparam EndIndexT Type of the end index.
 /// \tparam FuncT Type of the action to be executed.
@@ -98,6 +101,7 @@ void parallelize(
 /// The given iterator range is automatically split, providing a separate start/past-the-end iterator sub-range to each
 /// task.
 /// \note If using Emscripten this call will be synchronous, threads being unsupported with it for now.
+/// \note If called from a task of the default thread pool, this call will be synchronous as well.
 /// \tparam IterT Type of the iterators.
 /// \tparam FuncT Type of the action to be executed.
 /// \param begin Begin iterator of the whole range. Must be lower than the end iterator.
@@ -112,6 +116,7 @@ void parallelize(IterT begin, IterT end, FuncT const& action, uint32_t task_coun
 /// task.
 /// \note The container must either be a constant-size C array, or have public begin() & end() functions.
 /// \note If using Emscripten this call will be synchronous, threads being unsupported with it for now.
+/// \note If called from a task of the default thread pool, this call will be synchronous as well.
 /// \tparam ContainerT Type of the collection to iterate over.
 /// \tparam FuncT Type of the action to be executed.
 /// \param collection Collection to iterate over in parallel.
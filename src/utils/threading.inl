@@ -31,6 +31,12 @@ void parallelize(BegIndexT begin_index, EndIndexT end_index, FuncT const& action
 #if !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
     ThreadPool& thread_pool = get_default_thread_pool();
 
+    // Waiting from a task of the pool for the ones queued behind it could block all its threads forever
+    if (thread_pool.is_current_thread_worker()) {
+        action(IndexRange{static_cast<size_t>(begin_index), static_cast<size_t>(end_index)});
+        return;
+    }
+
     auto const total_range_count = static_cast<size_t>(end_index) - static_cast<size_t>(begin_index);
     size_t const max_task_count = std::min(static_cast<size_t>(task_count), total_range_count);
 
@@ -88,6 +94,12 @@ void parallelize(IterT begin, IterT end, FuncT const& action, uint32_t task_coun
 #if !defined(XEN_IS_PLATFORM_EMSCRIPTEN)
     ThreadPool& thread_pool = get_default_thread_pool();
 
+    // Waiting from a task of the pool for the ones queued behind it could block all its threads forever
+    if (thread_pool.is_current_thread_worker()) {
+        action(IterRange<IterT>(begin, end));
+        return;
+    }
+
     size_t const max_task_count = std::min(static_cast<size_t>(task_count), static_cast<size_t>(total_range_count));
 
     size_t const per_task_range_count = static_cast<size_t>(total_range_count) / max_task_count;
@@ -0,0 +1,204 @@
+#include "virtual_file_system.hpp"
+
+#include <tracy/Tracy.hpp>
+
+#include <filesystem>
+#include <optional>
+
+namespace xen::VirtualFileSystem {
+namespace {
+struct Mount {
+    std::string point;                    ///< Normalized virtual path, without trailing separator.
+    std::string directory;                ///< Normalized path to the mounted directory, if not an archive.
+    std::shared_ptr<PackFile const> pack; ///< Mounted archive, if any.
+    int64_t pack_modification_time{};
+};
+
+std::mutex mounts_mutex;
+/// Mounted directories & archives, in mounting order. The list is replaced as a whole when modified, lookups thus only
+///   having to copy the pointer to the current one, without holding the lock while searching.
+std::shared_ptr<std::vector<Mount> const> mounts = std::make_shared<std::vector<Mount> const>();
+
+std::shared_ptr<std::vector<Mount> const> recover_mounts()
+{
+    std::lock_guard<std::mutex> const lock(mounts_mutex);
+    return mounts;
+}
+
+template <typename FuncT>
+void update_mounts(FuncT&& update)
+{
+    std::lock_guard<std::mutex> const lock(mounts_mutex);
+
+    auto updated_mounts = std::make_shared<std::vector<Mount>>(*mounts);
+    update(*updated_mounts);
+    mounts = std::move(updated_mounts);
+}
+
+std::string normalize_path(FilePath const& filepath)
+{
+    std::string path = std::filesystem::path(filepath.get_path()).lexically_normal().generic_string();
+
+    if (path == ".") {
+        path.clear();
+    }
+
+    while (path.size() > 1 && path.back() == '/') {
+        path.pop_back();
+    }
+
+    return path;
+}
+
+/// Recovers the path of a file relative to a mount point.
+/// \param path Normalized path of the file.
+/// \param mount_point Normalized mount point.
+/// \return Relative path of the file, or std::nullopt if the file is not located under the mount point.
+std::optional<std::string_view> recover_relative_path(std::string_view path, std::string_view mount_point)
+{
+    if (mount_point.empty()) {
+        return path;
+    }
+
+    if (!path.starts_with(mount_point) || (path.size() > mount_point.size() && path[mount_point.size()] != '/')) {
+        return std::nullopt;
+    }
+
+    return path.substr(std::min(mount_point.size() + 1, path.size()));
+}
+
+bool exists_on_disk(FilePath const& filepath)
+{
+    std::error_code error;
+    return std::filesystem::exists(std::filesystem::path(filepath.get_path()), error);
+}
+}
+
+void mount(FilePath const& mount_point, FilePath const& directory)
+{
+    ZoneScopedN("VirtualFileSystem::mount");
+
+    Log::debug("[VirtualFileSystem] Mounting the directory '" + directory + "' at '" + mount_point + "'...");
+
+    std::error_code error;
+
+    if (!std::filesystem::is_directory(std::filesystem::path(directory.get_path()), error)) {
+        throw std::invalid_argument("[VirtualFileSystem] '" + directory + "' is not a directory");
+    }
+
+    update_mounts([&mount_point, &directory](std::vector<Mount>& mount_list) {
+        mount_list.emplace_back(Mount{normalize_path(mount_point), normalize_path(directory), nullptr, 0});
+    });
+
+    Log::debug("[VirtualFileSystem] Mounted the directory");
+}
+
+void mount_pack(FilePath const& mount_point, FilePath const& pack_filepath)
+{
+    ZoneScopedN("VirtualFileSystem::mount_pack");
+
+    Log::debug("[VirtualFileSystem] Mounting the pack '" + pack_filepath + "' at '" + mount_point + "'...");
+
+    // The archive is opened before locking, since it may itself be located through the current mounts
+    auto pack = std::make_shared<PackFile const>(pack_filepath);
+    std::optional<FileStatus> const pack_status = recover_status(pack_filepath);
+
+    update_mounts([&mount_point, &pack, &pack_status](std::vector<Mount>& mount_list) {
+        mount_list.emplace_back(
+            Mount{normalize_path(mount_point), {}, std::move(pack), (pack_status ? pack_status->modification_time : 0)}
+        );
+    });
+
+    Log::debug("[VirtualFileSystem] Mounted the pack");
+}
+
+void unmount(FilePath const& mount_point)
+{
+    ZoneScopedN("VirtualFileSystem::unmount");
+
+    update_mounts([point = normalize_path(mount_point)](std::vector<Mount>& mount_list) {
+        std::erase_if(mount_list, [&point](Mount const& mount) { return (mount.point == point); });
+    });
+}
+
+void unmount_all()
+{
+    update_mounts([](std::vector<Mount>& mount_list) { mount_list.clear(); });
+}
+
+FileLocation locate(FilePath const& filepath)
+{
+    std::shared_ptr<std::vector<Mount> const> const mount_list = recover_mounts();
+
+    if (mount_list->empty()) {
+        return FileLocation{filepath};
+    }
+
+    ZoneScopedN("VirtualFileSystem::locate");
+
+    std::string const path = normalize_path(filepath);
+
+    for (auto mount_iter = mount_list->crbegin(); mount_iter != mount_list->crend(); ++mount_iter) {
+        std::optional<std::string_view> const relative_path = recover_relative_path(path, mount_iter->point);
+
+        if (!relative_path.has_value()) {
+            continue;
+        }
+
+        if (mount_iter->pack != nullptr) {
+            if (PackFile::Entry const* entry = mount_iter->pack->find_entry(std::string(*relative_path))) {
+                return FileLocation{filepath, mount_iter->pack, entry};
+            }
+
+            continue;
+        }
+
+        std::string const& directory = mount_iter->directory;
+        FilePath disk_path = (directory.empty() ? std::string(*relative_path)
+                                                : directory + '/' + std::string(*relative_path));
+
+        if (exists_on_disk(disk_path)) {
+            return FileLocation{std::move(disk_path)};
+        }
+    }
+
+    return FileLocation{filepath};
+}
+
+FilePath resolve_path(FilePath const& filepath)
+{
+    return locate(filepath).disk_path;
+}
+
+std::optional<FileStatus> recover_status(FilePath const& filepath)
+{
+    FileLocation const location = locate(filepath);
+
+    if (location.is_packed()) {
+        auto const mount_list = recover_mounts();
+        auto const mount_iter = std::find_if(mount_list->cbegin(), mount_list->cend(), [&location](Mount const& mount) {
+            return (mount.pack == location.pack);
+        });
+        int64_t const modification_time = (mount_iter != mount_list->cend() ? mount_iter->pack_modification_time : 0);
+
+        return FileStatus{location.entry->size, modification_time};
+    }
+
+    std::filesystem::path const path(location.disk_path.get_path());
+    std::error_code error;
+
+    uint64_t const size = std::filesystem::file_size(path, error);
+
+    if (error) {
+        return std::nullopt;
+    }
+
+    int64_t const modification_time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+    if (error) {
+        return std::nullopt;
+    }
+
+    return FileStatus{size, modification_time};
+}
+}
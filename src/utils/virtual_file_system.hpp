@@ -0,0 +1,64 @@
+#pragma once
+
+#include <utils/filepath.hpp>
+#include <utils/pack_file.hpp>
+
+namespace xen {
+/// Virtual file system, through which all files are read. Directories & pack archives can be mounted at virtual paths,
+///   files being searched in the most recently mounted ones first; a file found in none of them is read from its path
+///   as is, so that nothing changes as long as nothing is mounted.
+/// Files held by archives are read directly from the mapped archive, instead of being opened one by one.
+/// \note Mounted files are read-only; files are always written to their path on disk.
+/// \see FileUtils, MappedFile, PackFile
+namespace VirtualFileSystem {
+/// Location of a file, either on disk or in a mounted archive.
+struct FileLocation {
+    FilePath disk_path;                   ///< Path to the file on disk; the original one if held by an archive.
+    std::shared_ptr<PackFile const> pack; ///< Archive holding the file, if any.
+    PackFile::Entry const* entry{};       ///< Entry of the file in its archive, if any.
+
+    [[nodiscard]] bool is_packed() const { return (pack != nullptr); }
+};
+
+/// Size & modification time of a file.
+struct FileStatus {
+    uint64_t size{};
+    int64_t modification_time{}; ///< Modification time of the file, or of its archive if it is held by one.
+};
+
+/// Mounts a directory, whose files become readable as if they were located under the mount point.
+/// \param mount_point Virtual path of the directory (e.g. "assets"); an empty path mounts it at the root.
+/// \param directory Directory to be mounted.
+/// \throws std::invalid_argument If the directory does not exist.
+void mount(FilePath const& mount_point, FilePath const& directory);
+
+/// Mounts a pack archive, whose files become readable as if they were located under the mount point. The archive
+///   remains mapped until unmounted.
+/// \param mount_point Virtual path of the archive's root (e.g. "assets"); an empty path mounts it at the root.
+/// \param pack_filepath Path to the archive to be mounted.
+/// \throws std::invalid_argument If the file is not a valid archive.
+void mount_pack(FilePath const& mount_point, FilePath const& pack_filepath);
+
+/// Unmounts all the directories & archives mounted at the given virtual path.
+/// \note Files already opened from an archive remain valid, the archive only being closed once they all are.
+/// \param mount_point Virtual path to be unmounted.
+void unmount(FilePath const& mount_point);
+
+void unmount_all();
+
+/// Finds the location of a file, searching the mounted directories & archives in reverse mounting order.
+/// \param filepath Virtual path of the file.
+/// \return Location of the file; its original path on disk if not found in any mount.
+FileLocation locate(FilePath const& filepath);
+
+/// Recovers the path on disk of a file.
+/// \param filepath Virtual path of the file.
+/// \return Path to the file on disk; the original path if the file is held by an archive or found in no mount.
+FilePath resolve_path(FilePath const& filepath);
+
+/// Recovers the size & modification time of a file.
+/// \param filepath Virtual path of the file.
+/// \return Status of the file, or std::nullopt if it does not exist.
+std::optional<FileStatus> recover_status(FilePath const& filepath);
+}
+}
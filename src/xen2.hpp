@@ -7,6 +7,7 @@
 #include "world.hpp"
 #include "animation/skeleton.hpp"
 #include "audio/audio_data.hpp"
+#include "audio/audio_stream.hpp"
 #include "audio/audio_system.hpp"
 #include "audio/audio_utils.hpp"
 #include "audio/listener.hpp"
@@ -14,22 +15,36 @@
 #include "audio/sound.hpp"
 #include "audio/sound_effect.hpp"
 #include "audio/sound_effect_slot.hpp"
+#include "audio/streamed_sound.hpp"
+#include "data/asset_cache.hpp"
+#include "data/bcn_encoder.hpp"
 #include "data/bitset.hpp"
 #include "data/bvh.hpp"
 #include "data/bvh_system.hpp"
 #include "data/bvh_format.hpp"
+#include "data/compressed_image.hpp"
+#include "data/dds_format.hpp"
+#include "data/flac_format.hpp"
 #include "data/gltf_format.hpp"
 #include "data/graph.hpp"
 #include "data/image.hpp"
+#include "data/image_buffer_pool.hpp"
 #include "data/image_format.hpp"
+#include "data/image_processing.hpp"
+#include "data/image_utils.hpp"
+#include "data/lz4.hpp"
 #include "data/mesh.hpp"
 #include "data/mesh_distance_field.hpp"
 #include "data/mesh_format.hpp"
+#include "data/mesh_lod_cache.hpp"
+#include "data/mesh_optimizer.hpp"
+#include "data/mesh_simplifier.hpp"
 #include "data/obj_format.hpp"
 #include "data/off_format.hpp"
 #include "data/submesh.hpp"
 #include "data/tga_format.hpp"
 #include "data/wav_format.hpp"
+#include "data/xmesh_format.hpp"
 #include "math/angle.hpp"
 #include "math/perlin_noise.hpp"
 // #include "physics/collider.hpp"
@@ -42,14 +57,20 @@
 #include "render/process/chromatic_aberration.hpp"
 #include "render/process/convolution.hpp"
 #include "render/cubemap.hpp"
+#include "render/dynamic_resolution.hpp"
+#include "render/frame_capturer.hpp"
 #include "render/process/film_grain.hpp"
 #include "render/platform/framebuffer.hpp"
 #include "render/process/gaussian_blur.hpp"
+#include "render/geometry_pool.hpp"
 #include "render/graphic_objects.hpp"
 #include "render/light.hpp"
 #include "render/material.hpp"
+#include "render/material_table.hpp"
+#include "render/mesh_lod.hpp"
 #include "render/mesh_renderer.hpp"
 #include "render/process/mono_pass.hpp"
+#include "render/occlusion_culler.hpp"
 #include "render/overlay.hpp"
 #include "render/process/pixelization.hpp"
 #include "render/renderer.hpp"
@@ -58,18 +79,28 @@
 #include "render/process/render_process.hpp"
 #include "render/render_system.hpp"
 #include "render/process/ssr.hpp"
+#include "render/shader/program_cache.hpp"
 #include "render/shader/shader.hpp"
+#include "render/shader/shader_permutation.hpp"
+#include "render/shader/shader_preprocessor.hpp"
 #include "render/shader/shader_program.hpp"
+#include "render/shadow_renderer.hpp"
 #include "render/process/sobel_filter.hpp"
+#include "render/software_occlusion_buffer.hpp"
 #include "render/submesh_renderer.hpp"
 #include "render/texture.hpp"
+#include "render/texture_cache.hpp"
 #include "render/platform/uniform_buffer.hpp"
 #include "render/process/vignette.hpp"
 #include "render/window.hpp"
 #include "utils/enum_utils.hpp"
 #include "utils/filepath.hpp"
 #include "utils/file_utils.hpp"
+#include "utils/file_watcher.hpp"
+#include "utils/hash.hpp"
 #include "utils/input.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/pack_file.hpp"
 #include "utils/plugin.hpp"
 #include "utils/ray.hpp"
 #include "utils/shape.hpp"
@@ -79,6 +110,7 @@
 #include "utils/trigger_system.hpp"
 #include "utils/trigger_volume.hpp"
 #include "utils/type_utils.hpp"
+#include "utils/virtual_file_system.hpp"
 #include "xr/xr_context.hpp"
 #include "xr/xr_session.hpp"
 #include "xr/xr_system.hpp"
\ No newline at end of file